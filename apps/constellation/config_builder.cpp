@@ -298,6 +298,7 @@ Constellation::Config BuildConstellationConfig(Settings const &settings)
   cfg.max_peers             = settings.max_peers.value();
   cfg.transient_peers       = settings.transient_peers.value();
   cfg.block_interval_ms     = settings.block_interval.value();
+  cfg.block_pipeline_depth  = settings.block_pipeline_depth.value();
   cfg.aeon_period           = settings.aeon_period.value();
   cfg.max_cabinet_size      = settings.max_cabinet_size.value();
   cfg.stake_delay_period    = settings.stake_delay_period.value();
@@ -36,6 +36,7 @@ const uint32_t DEFAULT_NUM_EXECUTORS      = DEFAULT_NUM_LANES;
 const uint16_t DEFAULT_PORT               = 8000;
 const uint16_t DEFAULT_MESSENGER_PORT     = 9010;
 const uint32_t DEFAULT_BLOCK_INTERVAL     = 0;  // milliseconds - zero means no mining
+const uint32_t DEFAULT_PIPELINE_DEPTH     = 4;
 const uint32_t DEFAULT_CABINET_SIZE       = 10;
 const uint32_t DEFAULT_STAKE_DELAY_PERIOD = 5;
 const uint32_t DEFAULT_AEON_PERIOD        = 25;
@@ -53,6 +54,7 @@ Settings::Settings()
   : num_lanes             {*this, "lanes",                   DEFAULT_NUM_LANES,            "Number of lanes to be used"}
   , num_slices            {*this, "slices",                  DEFAULT_NUM_SLICES,           "Number of slices to be used"}
   , block_interval        {*this, "block-interval",          DEFAULT_BLOCK_INTERVAL,       "Block interval in milliseconds"}
+  , block_pipeline_depth  {*this, "block-pipeline-depth",    DEFAULT_PIPELINE_DEPTH,       "Number of upcoming blocks to prepare while synchronising (zero disables)"}
   , standalone            {*this, "standalone",              false,                        "Whether the network should run in standalone mode"}
   , private_network       {*this, "private-network",         false,                        "Whether the network should run as part of a private network"}
   , initial_address       {*this, "initial-address",         "",                           "The initial address where all funds can be found for a standalone node"}
@@ -49,6 +49,7 @@ public:
   settings::Setting<uint32_t> num_lanes;
   settings::Setting<uint32_t> num_slices;
   settings::Setting<uint32_t> block_interval;
+  settings::Setting<uint32_t> block_pipeline_depth;
   /// @}
 
   /// @name Network Mode
@@ -389,7 +389,8 @@ bool TransactionSerializer::Serialize(Transaction const &tx)
 
 bool TransactionSerializer::Deserialize(Transaction &tx) const
 {
-  serializers::MsgPackSerializer buffer{serial_data_};
+  // decode directly from the serial data, all the extracted byte arrays share its memory
+  auto buffer = serializers::MsgPackSerializer::View(serial_data_);
 
   std::size_t const payload_start = buffer.tell();
 
@@ -592,6 +592,7 @@ bool Constellation::OnBringUpExternalNetwork(
       cfg_.log2_num_lanes, cfg_.num_slices, consensus_,
       std::make_unique<ledger::SynergeticExecutionManager>(
           dag_, 1u, [this]() { return std::make_shared<ledger::SynergeticExecutor>(*storage_); }));
+  block_coordinator_->SetPipelineDepth(cfg_.block_pipeline_depth);
 
   tx_processor_ = std::make_unique<ledger::TransactionProcessor>(
       dag_, *storage_, *block_packer_, tx_status_cache_, cfg_.processor_threads);
@@ -1082,6 +1083,7 @@ std::ostream &operator<<(std::ostream &stream, Constellation::Config const &conf
   stream << "Max Peers............: " << config.max_peers << '\n';
   stream << "Transient Peers......: " << config.transient_peers << '\n';
   stream << "Block Internal.......: " << config.block_interval_ms << "ms\n";
+  stream << "Block Pipeline Depth.: " << config.block_pipeline_depth << '\n';
   stream << "Max Cabinet Size.....: " << config.max_cabinet_size << '\n';
   stream << "Stake Delay Period...: " << config.stake_delay_period << '\n';
   stream << "Aeon Period..........: " << config.aeon_period << '\n';
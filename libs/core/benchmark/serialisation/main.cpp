@@ -143,6 +143,58 @@ Result BenchmarkSingle(Args... args)
   return ret;
 }
 
+template <typename T>
+double BenchmarkCountedSerialization(T const &data)
+{
+  high_resolution_clock::time_point t1 = high_resolution_clock::now();
+
+  SizeCounter counter;
+  counter << data;
+
+  MsgPackSerializer buffer;
+  buffer.Reserve(counter.size());
+  buffer << data;
+
+  high_resolution_clock::time_point t2 = high_resolution_clock::now();
+  return duration_cast<duration<double>>(t2 - t1).count();
+}
+
+template <typename T>
+double BenchmarkUncountedSerialization(T const &data)
+{
+  high_resolution_clock::time_point t1 = high_resolution_clock::now();
+
+  MsgPackSerializer buffer;
+  buffer << data;
+
+  high_resolution_clock::time_point t2 = high_resolution_clock::now();
+  return duration_cast<duration<double>>(t2 - t1).count();
+}
+
+double BenchmarkBoundedAppend(std::size_t count)
+{
+  high_resolution_clock::time_point t1 = high_resolution_clock::now();
+
+  MsgPackSerializer buffer;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    buffer.Append(uint64_t{i}, uint32_t(i), (i & 1u) == 0, double(i));
+  }
+
+  high_resolution_clock::time_point t2 = high_resolution_clock::now();
+  return duration_cast<duration<double>>(t2 - t1).count();
+}
+
+#define SIZING_BENCHMARK(type)                                              \
+  {                                                                         \
+    type data;                                                              \
+    PopulateData(data);                                                     \
+    std::cout << std::setw(type_width) << #type;                            \
+    std::cout << std::setw(width) << BenchmarkCountedSerialization(data);   \
+    std::cout << std::setw(width) << BenchmarkUncountedSerialization(data); \
+    std::cout << std::endl;                                                 \
+  }
+
 #define SINGLE_BENCHMARK(serializer, type)                      \
   result = BenchmarkSingle<serializer, type>();                 \
   std::cout << std::setw(type_width) << #type;                  \
@@ -187,5 +239,20 @@ int main()
   SINGLE_BENCHMARK(MsgPackSerializer, std::vector<ConstByteArray>);
   SINGLE_BENCHMARK(MsgPackSerializer, std::vector<std::string>);
 
+  std::cout << std::endl;
+
+  std::cout << std::setw(type_width) << "Type";
+  std::cout << std::setw(width) << "Counted";
+  std::cout << std::setw(width) << "Growth" << std::endl;
+
+  SIZING_BENCHMARK(std::vector<uint32_t>);
+  SIZING_BENCHMARK(std::vector<uint64_t>);
+  SIZING_BENCHMARK(std::vector<ByteArray>);
+  SIZING_BENCHMARK(std::vector<std::string>);
+
+  std::cout << std::endl;
+  std::cout << std::setw(type_width) << "Bounded Append (1M records)";
+  std::cout << std::setw(width) << BenchmarkBoundedAppend(1000000) << std::endl;
+
   return 0;
 }
@@ -0,0 +1,106 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/serializers/base_types.hpp"
+
+#include <cstdint>
+
+namespace fetch {
+namespace core {
+
+enum class CompressionCodec : uint8_t
+{
+  NONE = 0,
+  LZ   = 1,
+};
+
+using CompressionCodecMask = uint8_t;
+
+constexpr CompressionCodecMask ToCodecMask(CompressionCodec codec)
+{
+  return static_cast<CompressionCodecMask>(1u << static_cast<uint8_t>(codec));
+}
+
+/// The set of codecs that this node is able to decode
+constexpr CompressionCodecMask SUPPORTED_COMPRESSION_CODECS =
+    ToCodecMask(CompressionCodec::NONE) | ToCodecMask(CompressionCodec::LZ);
+
+/**
+ * A self describing (optionally) compressed block of data
+ */
+struct CompressedPayload
+{
+  CompressionCodec           codec{CompressionCodec::NONE};
+  uint64_t                   dictionary_id{0};  ///< The identifier of the dictionary used (if any)
+  uint64_t                   raw_size{0};       ///< The size of the payload once decompressed
+  byte_array::ConstByteArray data{};
+};
+
+uint64_t          CompressionDictionaryId(byte_array::ConstByteArray const &dictionary);
+CompressedPayload Compress(byte_array::ConstByteArray const &raw, CompressionCodecMask accepted,
+                           byte_array::ConstByteArray const &dictionary = {});
+bool              Decompress(CompressedPayload const &payload, byte_array::ConstByteArray &raw,
+                             byte_array::ConstByteArray const &dictionary = {});
+
+}  // namespace core
+
+namespace serializers {
+
+template <typename D>
+struct MapSerializer<core::CompressedPayload, D>
+{
+public:
+  using Type       = core::CompressedPayload;
+  using DriverType = D;
+
+  static constexpr uint8_t CODEC         = 1;
+  static constexpr uint8_t DICTIONARY_ID = 2;
+  static constexpr uint8_t RAW_SIZE      = 3;
+  static constexpr uint8_t DATA          = 4;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &payload)
+  {
+    auto map = map_constructor(4);
+
+    auto const codec = static_cast<uint8_t>(payload.codec);
+
+    map.Append(CODEC, codec);
+    map.Append(DICTIONARY_ID, payload.dictionary_id);
+    map.Append(RAW_SIZE, payload.raw_size);
+    map.Append(DATA, payload.data);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &payload)
+  {
+    uint8_t codec{0};
+
+    map.ExpectKeyGetValue(CODEC, codec);
+    map.ExpectKeyGetValue(DICTIONARY_ID, payload.dictionary_id);
+    map.ExpectKeyGetValue(RAW_SIZE, payload.raw_size);
+    map.ExpectKeyGetValue(DATA, payload.data);
+
+    payload.codec = static_cast<core::CompressionCodec>(codec);
+  }
+};
+
+}  // namespace serializers
+}  // namespace fetch
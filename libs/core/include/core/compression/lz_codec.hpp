@@ -0,0 +1,60 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+
+#include <cstdint>
+
+namespace fetch {
+namespace core {
+
+/**
+ * A small, fast LZ77 block codec in the style of LZ4.
+ *
+ * The compressed stream is a series of sequences. Each sequence starts with a token byte whose high
+ * nibble is the literal length and low nibble is the match length (minus the minimum match). A
+ * nibble value of 15 signals that the length continues in subsequent bytes (each 255 byte adds 255
+ * and the first byte smaller than 255 terminates the length). The token is followed by the literal
+ * bytes and then a 16-bit little endian back reference offset. The final sequence of the stream
+ * only contains literals.
+ *
+ * An optional dictionary can be supplied which is logically prepended to the input. Back references
+ * are allowed to point into the dictionary, which allows small payloads with a predictable
+ * structure (i.e. batches of transactions) to compress well. The same dictionary must be supplied
+ * to both the compression and decompression.
+ */
+class LzCodec
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+
+  static constexpr std::size_t MIN_MATCH  = 4;
+  static constexpr std::size_t MAX_OFFSET = 0xFFFF;
+
+  static ConstByteArray Compress(ConstByteArray const &input,
+                                 ConstByteArray const &dictionary = ConstByteArray{});
+  static bool           Decompress(ConstByteArray const &input, std::size_t raw_size,
+                                   ConstByteArray &      output,
+                                   ConstByteArray const &dictionary = ConstByteArray{});
+
+  static std::size_t CompressBound(std::size_t input_size);
+};
+
+}  // namespace core
+}  // namespace fetch
@@ -555,7 +555,9 @@ public:
       size = static_cast<uint32_t>(opcode & TypeCodes::FIXED_VAL_MASK2);
     }
 
-    byte_array::ByteArray arr;
+    // only a mutable target needs to be read as a mutable (and so never shared) array
+    typename std::conditional<std::is_same<Type, byte_array::ByteArray>::value,
+                              byte_array::ByteArray, byte_array::ConstByteArray>::type arr;
     interface.ReadByteArray(arr, size);
     val = static_cast<Type>(arr);
   }
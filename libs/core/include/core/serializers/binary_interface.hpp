@@ -17,6 +17,8 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
 #include "core/serializers/exception.hpp"
 
 #include <cstdint>
@@ -199,6 +201,28 @@ public:
     serializer_.ReadBytes(arr, size);
   }
 
+  void ReadByteArray(byte_array::ConstByteArray &b, uint64_t size)
+  {
+    pos_ += size;
+    if (pos_ > size_)
+    {
+      throw SerializableException(
+          std::string("tried to deserialise more fields in map than there exists."));
+    }
+    serializer_.ReadByteArray(b, size);
+  }
+
+  void ReadByteArray(byte_array::ByteArray &b, uint64_t size)
+  {
+    pos_ += size;
+    if (pos_ > size_)
+    {
+      throw SerializableException(
+          std::string("tried to deserialise more fields in map than there exists."));
+    }
+    serializer_.ReadByteArray(b, size);
+  }
+
   uint64_t size() const
   {
     return size_;
@@ -29,6 +29,7 @@
 #include "core/serializers/main_serializer_definition.hpp"
 #include "core/serializers/map_interface.hpp"
 #include "core/serializers/pair_interface.hpp"
+#include "core/serializers/serialized_size.hpp"
 #include "vectorise/platform.hpp"
 
 #include <stdexcept>
@@ -431,17 +432,14 @@ MsgPackSerializer &MsgPackSerializer::Unpack(T &val)
 template <typename... ARGS>
 MsgPackSerializer &MsgPackSerializer::Append(ARGS const &... args)
 {
-  auto size_count_guard = sizeCounterGuardFactory(size_counter_);
-  if (size_count_guard.is_unreserved())
-  {
-    size_counter_.Allocate(size());
-    size_counter_.seek(tell());
+  using SizeBound = CombinedSizeBound<ARGS...>;
 
-    size_counter_.Append(args...);
-    if (size() < size_counter_.size())
-    {
-      Reserve(size_counter_.size() - size());
-    }
+  // when the encoded size of all the arguments is known at compile time the buffer can be reserved
+  // up front, otherwise the geometric growth in Allocate takes care of it
+  if (SizeBound::IS_BOUNDED)
+  {
+    uint64_t const bound = SizeBound::VALUE;
+    GrowCapacity(size() + bound);
   }
 
   AppendInternal(args...);
@@ -59,7 +59,12 @@ public:
   using PairDeserializer = interfaces::PairDeserializer<MsgPackSerializer>;
   /// @}
 
-  MsgPackSerializer()                         = default;
+  MsgPackSerializer() = default;
+
+  /**
+   * @brief Moving takes over the buffer without copying it, a moved view stays a view of the
+   * same input.
+   */
   MsgPackSerializer(MsgPackSerializer &&from) = default;
   MsgPackSerializer &operator=(MsgPackSerializer &&from) = default;
 
@@ -78,6 +83,21 @@ public:
   explicit MsgPackSerializer(byte_array::ByteArray s);
   MsgPackSerializer(MsgPackSerializer const &from);
 
+  /**
+   * @brief Constructing a read-only view of an IMMUTABLE ConstByteArray.
+   *
+   * NO copy of the input is made. Byte arrays decoded as ConstByteArray are
+   * sub-arrays sharing the memory of @ref s, which keeps the whole input alive
+   * for as long as any of them exist. The content of @ref s must therefore not
+   * be modified (e.g. through another ByteArray referencing the same memory)
+   * while the view or any of these values are in use. Values decoded as
+   * mutable ByteArray are deep copied, so they can never modify the input.
+   * Should the serializer be written to, the content is deep copied first.
+   *
+   * @param s Input buffer to deserialize from
+   */
+  static MsgPackSerializer View(byte_array::ConstByteArray const &s);
+
   MsgPackSerializer &operator=(MsgPackSerializer const &from);
 
   SerializerTypes GetNextType() const
@@ -115,6 +135,7 @@ public:
   void ReadBytes(uint8_t *arr, uint64_t const &size);
 
   void ReadByteArray(byte_array::ConstByteArray &b, uint64_t const &size);
+  void ReadByteArray(byte_array::ByteArray &b, uint64_t const &size);
   void SkipBytes(uint64_t const &size);
 
   template <typename T>
@@ -205,10 +226,12 @@ private:
   template <typename T, typename... ARGS>
   void AppendInternal(T const &arg, ARGS const &... args);
   void AppendInternal();
+  void DetachView();
+  void GrowCapacity(uint64_t const &required);
 
-  ByteArray   data_;
-  uint64_t    pos_ = 0;
-  SizeCounter size_counter_;
+  ByteArray data_;
+  uint64_t  pos_ = 0;
+  bool      view_{false};
 };
 
 }  // namespace serializers
@@ -0,0 +1,140 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace fetch {
+namespace serializers {
+
+/**
+ * Compute the encoded size of a container (array, map) header for a given number of elements
+ *
+ * @param count The number of elements in the container
+ * @return The number of bytes used to encode the header
+ */
+constexpr uint64_t ContainerHeaderSize(uint64_t count)
+{
+  return (count < 16u) ? 1u : ((count < (1ull << 16u)) ? 3u : 5u);
+}
+
+/**
+ * Compile time upper bound for the encoded size of a type.
+ *
+ * Types which have a bounded encoded size can be reserved in a serializer without running them
+ * through a SizeCounter first. By default types are considered unbounded. Types with a fixed map
+ * layout can opt in by specialising this trait, typically in terms of MapLayoutSizeBound.
+ *
+ * @tparam T The type being serialized
+ */
+template <typename T, typename = void>
+struct SerializedSizeBound
+{
+  static constexpr bool     IS_BOUNDED = false;
+  static constexpr uint64_t VALUE      = 0;
+};
+
+template <typename T>
+struct SerializedSizeBound<T, std::enable_if_t<std::is_integral<T>::value &&
+                                               !std::is_same<T, bool>::value>>
+{
+  static constexpr bool     IS_BOUNDED = true;
+  static constexpr uint64_t VALUE      = sizeof(uint8_t) + sizeof(T);
+};
+
+template <>
+struct SerializedSizeBound<bool>
+{
+  static constexpr bool     IS_BOUNDED = true;
+  static constexpr uint64_t VALUE      = sizeof(uint8_t);
+};
+
+template <typename T>
+struct SerializedSizeBound<T, std::enable_if_t<std::is_floating_point<T>::value>>
+{
+  static constexpr bool     IS_BOUNDED = true;
+  static constexpr uint64_t VALUE      = sizeof(uint8_t) + sizeof(T);
+};
+
+template <typename V, std::size_t N>
+struct SerializedSizeBound<std::array<V, N>>
+{
+  static constexpr bool     IS_BOUNDED = SerializedSizeBound<V>::IS_BOUNDED;
+  static constexpr uint64_t VALUE = ContainerHeaderSize(N) + (N * SerializedSizeBound<V>::VALUE);
+};
+
+/**
+ * Size bound of a map with a fixed set of fields keyed by integer constants
+ *
+ * @tparam Key The type of the keys of the map
+ * @tparam Fields The types of each of the values of the map
+ */
+template <typename Key, typename... Fields>
+struct MapLayoutSizeBound;
+
+template <typename Key>
+struct MapLayoutSizeBound<Key>
+{
+  static constexpr bool     IS_BOUNDED  = SerializedSizeBound<Key>::IS_BOUNDED;
+  static constexpr uint64_t NUM_FIELDS  = 0;
+  static constexpr uint64_t FIELDS_SIZE = 0;
+  static constexpr uint64_t VALUE       = ContainerHeaderSize(0);
+};
+
+template <typename Key, typename Field, typename... Fields>
+struct MapLayoutSizeBound<Key, Field, Fields...>
+{
+  using Remaining = MapLayoutSizeBound<Key, Fields...>;
+
+  static constexpr bool IS_BOUNDED =
+      SerializedSizeBound<Field>::IS_BOUNDED && Remaining::IS_BOUNDED;
+  static constexpr uint64_t NUM_FIELDS = Remaining::NUM_FIELDS + 1;
+  static constexpr uint64_t FIELDS_SIZE =
+      SerializedSizeBound<Key>::VALUE + SerializedSizeBound<Field>::VALUE + Remaining::FIELDS_SIZE;
+  static constexpr uint64_t VALUE = ContainerHeaderSize(NUM_FIELDS) + FIELDS_SIZE;
+};
+
+/**
+ * Combined size bound for a sequence of types, as used when appending several values in one call
+ *
+ * @tparam Args The types being serialized
+ */
+template <typename... Args>
+struct CombinedSizeBound;
+
+template <>
+struct CombinedSizeBound<>
+{
+  static constexpr bool     IS_BOUNDED = true;
+  static constexpr uint64_t VALUE      = 0;
+};
+
+template <typename T, typename... Args>
+struct CombinedSizeBound<T, Args...>
+{
+  static constexpr bool IS_BOUNDED =
+      SerializedSizeBound<T>::IS_BOUNDED && CombinedSizeBound<Args...>::IS_BOUNDED;
+  static constexpr uint64_t VALUE =
+      SerializedSizeBound<T>::VALUE + CombinedSizeBound<Args...>::VALUE;
+};
+
+}  // namespace serializers
+}  // namespace fetch
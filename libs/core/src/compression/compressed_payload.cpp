@@ -0,0 +1,137 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/compression/compressed_payload.hpp"
+#include "core/compression/lz_codec.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace fetch {
+namespace core {
+namespace {
+
+using byte_array::ConstByteArray;
+
+// payloads smaller than this are not worth the overhead of compressing
+constexpr std::size_t MIN_COMPRESSION_SIZE = 64;
+
+bool IsAccepted(CompressionCodecMask accepted, CompressionCodec codec)
+{
+  return (accepted & ToCodecMask(codec)) != 0;
+}
+
+}  // namespace
+
+/**
+ * Compute the identifier for a compression dictionary
+ *
+ * The identifier is used by the receiving side to ensure that it is decompressing with the same
+ * dictionary that the sender used.
+ *
+ * @param dictionary The dictionary contents
+ * @return The identifier for the dictionary (zero for the empty dictionary)
+ */
+uint64_t CompressionDictionaryId(ConstByteArray const &dictionary)
+{
+  if (dictionary.empty())
+  {
+    return 0;
+  }
+
+  // FNV-1a
+  uint64_t hash = 0xcbf29ce484222325ull;
+  for (std::size_t i = 0; i < dictionary.size(); ++i)
+  {
+    hash ^= dictionary[i];
+    hash *= 0x100000001b3ull;
+  }
+
+  return hash;
+}
+
+/**
+ * Compress a raw buffer with the best codec acceptable to the receiver
+ *
+ * In the case where the receiver does not accept any available codec, or the compressed data would
+ * not be any smaller, the payload is sent uncompressed.
+ *
+ * @param raw The data to be compressed
+ * @param accepted The set of codecs that the receiver will accept
+ * @param dictionary The (optional) dictionary to be used
+ * @return The generated payload
+ */
+CompressedPayload Compress(ConstByteArray const &raw, CompressionCodecMask accepted,
+                           ConstByteArray const &dictionary)
+{
+  CompressedPayload payload{};
+  payload.raw_size = raw.size();
+  payload.data     = raw;
+
+  if (IsAccepted(accepted, CompressionCodec::LZ) && (raw.size() >= MIN_COMPRESSION_SIZE))
+  {
+    auto compressed = LzCodec::Compress(raw, dictionary);
+
+    if (compressed.size() < raw.size())
+    {
+      payload.codec         = CompressionCodec::LZ;
+      payload.dictionary_id = CompressionDictionaryId(dictionary);
+      payload.data          = std::move(compressed);
+    }
+  }
+
+  return payload;
+}
+
+/**
+ * Decompress a payload
+ *
+ * @param payload The payload to be decompressed
+ * @param raw The output decompressed data
+ * @param dictionary The dictionary to be used
+ * @return true if successful, otherwise false
+ */
+bool Decompress(CompressedPayload const &payload, ConstByteArray &raw,
+                ConstByteArray const &dictionary)
+{
+  bool success{false};
+
+  switch (payload.codec)
+  {
+  case CompressionCodec::NONE:
+    if (payload.data.size() == payload.raw_size)
+    {
+      raw     = payload.data;
+      success = true;
+    }
+    break;
+
+  case CompressionCodec::LZ:
+    if (payload.dictionary_id == CompressionDictionaryId(dictionary))
+    {
+      success = LzCodec::Decompress(payload.data, payload.raw_size, raw, dictionary);
+    }
+    break;
+  }
+
+  return success;
+}
+
+}  // namespace core
+}  // namespace fetch
@@ -0,0 +1,300 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/compression/lz_codec.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace fetch {
+namespace core {
+namespace {
+
+using byte_array::ByteArray;
+using byte_array::ConstByteArray;
+
+constexpr std::size_t HASH_BITS     = 12;
+constexpr std::size_t HASH_SIZE     = 1u << HASH_BITS;
+constexpr std::size_t LAST_LITERALS = 5;
+constexpr std::size_t RUN_MASK      = 15;
+constexpr std::size_t MAX_EXPANSION = 255;
+constexpr std::size_t NO_POSITION   = std::numeric_limits<std::size_t>::max();
+
+uint32_t Read32(uint8_t const *data)
+{
+  uint32_t value{0};
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+std::size_t Hash(uint32_t value)
+{
+  return static_cast<std::size_t>((value * 2654435761u) >> (32u - HASH_BITS));
+}
+
+void WriteLength(uint8_t *&out, std::size_t length)
+{
+  while (length >= 255u)
+  {
+    *out++ = 255u;
+    length -= 255u;
+  }
+
+  *out++ = static_cast<uint8_t>(length);
+}
+
+bool ReadLength(uint8_t const *in, std::size_t in_size, std::size_t &in_pos, std::size_t &length)
+{
+  uint8_t value{0};
+  do
+  {
+    if (in_pos >= in_size)
+    {
+      return false;
+    }
+
+    value = in[in_pos++];
+    length += value;
+  } while (value == 255u);
+
+  return true;
+}
+
+void WriteLiterals(uint8_t *&out, uint8_t *token, uint8_t const *literals, std::size_t length)
+{
+  *token = static_cast<uint8_t>(std::min(length, RUN_MASK) << 4u);
+  if (length >= RUN_MASK)
+  {
+    WriteLength(out, length - RUN_MASK);
+  }
+
+  std::memcpy(out, literals, length);
+  out += length;
+}
+
+}  // namespace
+
+/**
+ * Compress the input buffer
+ *
+ * @param input The data to be compressed
+ * @param dictionary The (optional) dictionary to seed back references with
+ * @return The compressed stream
+ */
+ConstByteArray LzCodec::Compress(ConstByteArray const &input, ConstByteArray const &dictionary)
+{
+  // build the complete window, the dictionary logically preceding the input
+  std::vector<uint8_t> window(dictionary.size() + input.size());
+  std::copy(dictionary.pointer(), dictionary.pointer() + dictionary.size(), window.begin());
+  std::copy(input.pointer(), input.pointer() + input.size(),
+            window.begin() + static_cast<std::ptrdiff_t>(dictionary.size()));
+
+  uint8_t const *   base  = window.data();
+  std::size_t const start = dictionary.size();
+  std::size_t const end   = window.size();
+  std::size_t const limit = (input.size() > LAST_LITERALS) ? end - LAST_LITERALS : start;
+
+  // seed the hash table with the dictionary contents
+  std::vector<std::size_t> table(HASH_SIZE, NO_POSITION);
+  for (std::size_t pos = 0; pos + MIN_MATCH <= start; ++pos)
+  {
+    table[Hash(Read32(base + pos))] = pos;
+  }
+
+  ByteArray output;
+  output.Resize(CompressBound(input.size()));
+
+  uint8_t *   out    = output.pointer();
+  std::size_t anchor = start;
+  std::size_t pos    = start;
+
+  while (pos + MIN_MATCH <= limit)
+  {
+    uint32_t const sequence  = Read32(base + pos);
+    std::size_t &  slot      = table[Hash(sequence)];
+    std::size_t    candidate = slot;
+    slot                     = pos;
+
+    if ((candidate == NO_POSITION) || ((pos - candidate) > MAX_OFFSET) ||
+        (Read32(base + candidate) != sequence))
+    {
+      ++pos;
+      continue;
+    }
+
+    // extend the match as far as possible
+    std::size_t length = MIN_MATCH;
+    while ((pos + length < limit) && (base[candidate + length] == base[pos + length]))
+    {
+      ++length;
+    }
+
+    // emit the literals and the match
+    uint8_t *token = out++;
+    WriteLiterals(out, token, base + anchor, pos - anchor);
+
+    std::size_t const offset = pos - candidate;
+    *out++                   = static_cast<uint8_t>(offset & 0xFFu);
+    *out++                   = static_cast<uint8_t>(offset >> 8u);
+
+    std::size_t const match_code = length - MIN_MATCH;
+    *token |= static_cast<uint8_t>(std::min(match_code, RUN_MASK));
+    if (match_code >= RUN_MASK)
+    {
+      WriteLength(out, match_code - RUN_MASK);
+    }
+
+    pos += length;
+    anchor = pos;
+
+    // index the tail of the match so that repeated runs are picked up quickly
+    if (pos + MIN_MATCH <= limit)
+    {
+      table[Hash(Read32(base + pos - 2))] = pos - 2;
+    }
+  }
+
+  // the final sequence only contains the remaining literals
+  uint8_t *token = out++;
+  WriteLiterals(out, token, base + anchor, end - anchor);
+
+  output.Resize(static_cast<std::size_t>(out - output.pointer()));
+
+  return {output};
+}
+
+/**
+ * Decompress a previously compressed stream
+ *
+ * @param input The compressed stream
+ * @param raw_size The expected size of the decompressed data
+ * @param output The output decompressed data
+ * @param dictionary The dictionary that was used to compress the stream
+ * @return true if successful, otherwise false
+ */
+bool LzCodec::Decompress(ConstByteArray const &input, std::size_t raw_size, ConstByteArray &output,
+                         ConstByteArray const &dictionary)
+{
+  // guard against implausible sizes before allocating anything
+  if (raw_size > (input.size() * MAX_EXPANSION))
+  {
+    return false;
+  }
+
+  ByteArray window;
+  window.Resize(dictionary.size() + raw_size);
+  if (!dictionary.empty())
+  {
+    std::memcpy(window.pointer(), dictionary.pointer(), dictionary.size());
+  }
+
+  uint8_t *         out      = window.pointer();
+  std::size_t       out_pos  = dictionary.size();
+  std::size_t const out_size = window.size();
+  uint8_t const *   in       = input.pointer();
+  std::size_t       in_pos   = 0;
+  std::size_t const in_size  = input.size();
+
+  while (in_pos < in_size)
+  {
+    uint8_t const token = in[in_pos++];
+
+    // copy the literals
+    std::size_t literal_length = token >> 4u;
+    if ((literal_length == RUN_MASK) && !ReadLength(in, in_size, in_pos, literal_length))
+    {
+      return false;
+    }
+
+    if ((literal_length > (in_size - in_pos)) || (literal_length > (out_size - out_pos)))
+    {
+      return false;
+    }
+
+    std::memcpy(out + out_pos, in + in_pos, literal_length);
+    in_pos += literal_length;
+    out_pos += literal_length;
+
+    // the final sequence does not have a match
+    if (in_pos == in_size)
+    {
+      break;
+    }
+
+    // copy the match
+    if ((in_size - in_pos) < 2u)
+    {
+      return false;
+    }
+
+    std::size_t const offset = static_cast<std::size_t>(in[in_pos]) |
+                               (static_cast<std::size_t>(in[in_pos + 1]) << 8u);
+    in_pos += 2;
+
+    if ((offset == 0) || (offset > out_pos))
+    {
+      return false;
+    }
+
+    std::size_t match_length = token & RUN_MASK;
+    if ((match_length == RUN_MASK) && !ReadLength(in, in_size, in_pos, match_length))
+    {
+      return false;
+    }
+    match_length += MIN_MATCH;
+
+    if (match_length > (out_size - out_pos))
+    {
+      return false;
+    }
+
+    // matches are allowed to overlap the output, so this must be copied in order
+    for (std::size_t i = 0; i < match_length; ++i, ++out_pos)
+    {
+      out[out_pos] = out[out_pos - offset];
+    }
+  }
+
+  if (out_pos != out_size)
+  {
+    return false;
+  }
+
+  output = window.SubArray(dictionary.size(), raw_size);
+
+  return true;
+}
+
+/**
+ * Determine the maximum size of the compressed stream for a given input size
+ *
+ * @param input_size The size of the input
+ * @return The worst case size of the compressed stream
+ */
+std::size_t LzCodec::CompressBound(std::size_t input_size)
+{
+  return input_size + (input_size / 255u) + 16u;
+}
+
+}  // namespace core
+}  // namespace fetch
@@ -25,6 +25,7 @@
 #include "core/serializers/main_serializer.hpp"
 #include "vectorise/platform.hpp"
 
+#include <algorithm>
 #include <type_traits>
 
 namespace fetch {
@@ -37,7 +38,6 @@ MsgPackSerializer::MsgPackSerializer(byte_array::ByteArray s)
 MsgPackSerializer::MsgPackSerializer(MsgPackSerializer const &from)
   : data_{from.data_.Copy()}
   , pos_{from.pos_}
-  , size_counter_{from.size_counter_}
 {}
 
 MsgPackSerializer &MsgPackSerializer::operator=(MsgPackSerializer const &from)
@@ -46,6 +46,15 @@ MsgPackSerializer &MsgPackSerializer::operator=(MsgPackSerializer const &from)
   return *this;
 }
 
+MsgPackSerializer MsgPackSerializer::View(byte_array::ConstByteArray const &s)
+{
+  MsgPackSerializer serializer{};
+  serializer.data_.FromByteArray(s, 0, s.size());
+  serializer.view_ = true;
+
+  return serializer;
+}
+
 void MsgPackSerializer::WriteNil()
 {
   Allocate(sizeof(uint8_t));
@@ -54,12 +63,14 @@ void MsgPackSerializer::WriteNil()
 
 void MsgPackSerializer::Allocate(uint64_t const &delta)
 {
+  GrowCapacity(data_.size() + delta);
   Resize(delta, ResizeParadigm::RELATIVE);
 }
 
 void MsgPackSerializer::Resize(uint64_t const &size, ResizeParadigm const &resize_paradigm,
                                bool const zero_reserved_space)
 {
+  DetachView();
   data_.Resize(size, resize_paradigm, zero_reserved_space);
 
   switch (resize_paradigm)
@@ -109,17 +120,20 @@ MsgPackSerializer::PairDeserializer MsgPackSerializer::NewPairDeserializer()
 void MsgPackSerializer::Reserve(uint64_t const &size, ResizeParadigm const &resize_paradigm,
                                 bool const zero_reserved_space)
 {
+  DetachView();
   data_.Reserve(size, resize_paradigm, zero_reserved_space);
 }
 
 void MsgPackSerializer::WriteBytes(uint8_t const *arr, uint64_t const &size)
 {
+  DetachView();
   data_.WriteBytes(arr, size, pos_);
   pos_ += size;
 }
 
 void MsgPackSerializer::WriteByte(uint8_t const &val)
 {
+  DetachView();
   data_.WriteBytes(&val, 1, pos_);
   ++pos_;
 }
@@ -152,6 +166,25 @@ void MsgPackSerializer::ReadByteArray(byte_array::ConstByteArray &b, uint64_t co
   pos_ += size;
 }
 
+void MsgPackSerializer::ReadByteArray(byte_array::ByteArray &b, uint64_t const &size)
+{
+  if (size + pos_ > data_.size())
+  {
+    throw std::runtime_error("Attempted read exceeds buffer size.");
+  }
+
+  // a mutable array decoded from a view must not be able to modify the caller's input
+  if (view_)
+  {
+    b = data_.SubArray(pos_, size).Copy();
+  }
+  else
+  {
+    b = data_.SubArray(pos_, size);
+  }
+  pos_ += size;
+}
+
 void MsgPackSerializer::SkipBytes(uint64_t const &size)
 {
   pos_ += size;
@@ -190,5 +223,36 @@ byte_array::ByteArray const &MsgPackSerializer::data() const
 void MsgPackSerializer::AppendInternal()
 {}
 
+/**
+ * Ensure the buffer has capacity for at least the required number of bytes.
+ *
+ * The capacity is grown geometrically so that serializing a sequence of values, whose total size
+ * was not computed up front, only reallocates a logarithmic number of times.
+ *
+ * @param required The required capacity in bytes
+ */
+void MsgPackSerializer::GrowCapacity(uint64_t const &required)
+{
+  DetachView();
+
+  uint64_t const capacity = data_.capacity();
+  if (required > capacity)
+  {
+    data_.Reserve(std::max(required, capacity * 2), ResizeParadigm::ABSOLUTE);
+  }
+}
+
+/**
+ * Take a private copy of the viewed buffer so that it can be safely modified
+ */
+void MsgPackSerializer::DetachView()
+{
+  if (view_)
+  {
+    data_ = data_.Copy();
+    view_ = false;
+  }
+}
+
 }  // namespace serializers
 }  // namespace fetch
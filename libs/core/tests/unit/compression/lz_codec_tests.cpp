@@ -0,0 +1,186 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/compression/compressed_payload.hpp"
+#include "core/compression/lz_codec.hpp"
+#include "core/serializers/main_serializer.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+
+namespace {
+
+using fetch::byte_array::ByteArray;
+using fetch::byte_array::ConstByteArray;
+using fetch::core::CompressedPayload;
+using fetch::core::CompressionCodec;
+using fetch::core::LzCodec;
+using fetch::core::SUPPORTED_COMPRESSION_CODECS;
+using fetch::core::ToCodecMask;
+using fetch::serializers::MsgPackSerializer;
+
+ConstByteArray GenerateRandom(std::size_t size, uint32_t seed)
+{
+  std::mt19937 rng{seed};
+
+  ByteArray data;
+  data.Resize(size);
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    data[i] = static_cast<uint8_t>(rng());
+  }
+
+  return {data};
+}
+
+ConstByteArray GenerateRepetitive(std::size_t size)
+{
+  std::string const pattern{"fetch.token transfer "};
+
+  ByteArray data;
+  data.Resize(size);
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    data[i] = static_cast<uint8_t>(pattern[i % pattern.size()]);
+  }
+
+  return {data};
+}
+
+void ExpectRoundTrip(ConstByteArray const &input, ConstByteArray const &dictionary = {})
+{
+  auto const compressed = LzCodec::Compress(input, dictionary);
+  EXPECT_LE(compressed.size(), LzCodec::CompressBound(input.size()));
+
+  ConstByteArray output;
+  ASSERT_TRUE(LzCodec::Decompress(compressed, input.size(), output, dictionary));
+  EXPECT_EQ(input, output);
+}
+
+TEST(LzCodecTests, CheckRoundTripOfSmallInputs)
+{
+  for (std::size_t size = 0; size < 32; ++size)
+  {
+    ExpectRoundTrip(GenerateRepetitive(size));
+    ExpectRoundTrip(GenerateRandom(size, static_cast<uint32_t>(size)));
+  }
+}
+
+TEST(LzCodecTests, CheckRoundTripOfLargeInputs)
+{
+  ExpectRoundTrip(GenerateRandom(100000, 42));
+  ExpectRoundTrip(GenerateRepetitive(100000));
+  ExpectRoundTrip(ConstByteArray{std::string(70000, 'a')});
+}
+
+TEST(LzCodecTests, CheckRepetitiveInputIsCompressed)
+{
+  auto const input      = GenerateRepetitive(10000);
+  auto const compressed = LzCodec::Compress(input);
+
+  EXPECT_LT(compressed.size() * 10, input.size());
+}
+
+TEST(LzCodecTests, CheckDictionaryImprovesCompression)
+{
+  auto const dictionary = GenerateRandom(512, 7);
+  auto const input      = dictionary.SubArray(100, 200);
+
+  auto const without = LzCodec::Compress(input);
+  auto const with    = LzCodec::Compress(input, dictionary);
+
+  EXPECT_LT(with.size(), without.size());
+  ExpectRoundTrip(input, dictionary);
+}
+
+TEST(LzCodecTests, CheckCorruptStreamsAreRejected)
+{
+  auto const input      = GenerateRepetitive(1000);
+  auto const compressed = LzCodec::Compress(input);
+
+  ConstByteArray output;
+
+  // wrong sizes
+  EXPECT_FALSE(LzCodec::Decompress(compressed, input.size() - 1, output));
+  EXPECT_FALSE(LzCodec::Decompress(compressed, input.size() + 1, output));
+
+  // truncated stream
+  EXPECT_FALSE(LzCodec::Decompress(compressed.SubArray(0, compressed.size() / 2), input.size(),
+                                   output));
+
+  // back reference before the start of the stream
+  ByteArray invalid;
+  invalid.Resize(4);
+  invalid[0] = 0x10;  // 1 literal and a minimum length match
+  invalid[1] = 'a';
+  invalid[2] = 0x02;  // offset 2 (only 1 byte available)
+  invalid[3] = 0x00;
+  EXPECT_FALSE(LzCodec::Decompress(invalid, 5, output));
+
+  // implausible expansion
+  EXPECT_FALSE(LzCodec::Decompress(compressed, compressed.size() * 1000, output));
+}
+
+TEST(CompressedPayloadTests, CheckPayloadRoundTripsThroughSerializer)
+{
+  auto const dictionary = GenerateRandom(256, 3);
+  auto const raw        = GenerateRepetitive(4096);
+
+  auto const payload = fetch::core::Compress(raw, SUPPORTED_COMPRESSION_CODECS, dictionary);
+  EXPECT_EQ(CompressionCodec::LZ, payload.codec);
+  EXPECT_EQ(raw.size(), payload.raw_size);
+
+  MsgPackSerializer serializer;
+  serializer << payload;
+  serializer.seek(0);
+
+  CompressedPayload recovered;
+  serializer >> recovered;
+
+  ConstByteArray output;
+  ASSERT_TRUE(fetch::core::Decompress(recovered, output, dictionary));
+  EXPECT_EQ(raw, output);
+
+  // a mismatched dictionary must be detected
+  EXPECT_FALSE(fetch::core::Decompress(recovered, output));
+}
+
+TEST(CompressedPayloadTests, CheckUncompressedFallback)
+{
+  auto const raw = GenerateRepetitive(4096);
+
+  // the receiver does not accept any codecs
+  auto payload = fetch::core::Compress(raw, ToCodecMask(CompressionCodec::NONE));
+  EXPECT_EQ(CompressionCodec::NONE, payload.codec);
+  EXPECT_EQ(raw, payload.data);
+
+  // incompressible data
+  payload = fetch::core::Compress(GenerateRandom(4096, 9), SUPPORTED_COMPRESSION_CODECS);
+  EXPECT_EQ(CompressionCodec::NONE, payload.codec);
+
+  ConstByteArray output;
+  EXPECT_TRUE(fetch::core::Decompress(payload, output));
+  EXPECT_EQ(payload.data, output);
+}
+
+}  // namespace
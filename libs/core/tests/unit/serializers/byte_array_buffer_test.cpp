@@ -304,5 +304,72 @@ TEST_F(MsgPackSerializerTest, test_stream_absolute_resize_with_preexisting_offse
   EXPECT_EQ(small_size, stream.tell());
 }
 
+TEST_F(MsgPackSerializerTest, test_view_deserialisation_shares_input_memory)
+{
+  MsgPackSerializer stream;
+  stream << byte_array::ConstByteArray{"a reasonably long byte array to be referenced"}
+         << std::string{"string"};
+
+  byte_array::ConstByteArray const input{stream.data()};
+
+  // Production code under test
+  auto view = MsgPackSerializer::View(input);
+
+  byte_array::ConstByteArray decoded;
+  std::string                decoded_string;
+  view >> decoded >> decoded_string;
+
+  // Expectations
+  EXPECT_EQ(decoded, "a reasonably long byte array to be referenced");
+  EXPECT_EQ(decoded_string, "string");
+  auto const *decoded_pointer = static_cast<byte_array::ConstByteArray const &>(decoded).pointer();
+  EXPECT_GE(decoded_pointer, input.pointer());
+  EXPECT_LT(decoded_pointer, input.pointer() + input.size());
+}
+
+TEST_F(MsgPackSerializerTest, test_view_deserialisation_copies_mutable_byte_arrays)
+{
+  MsgPackSerializer stream;
+  stream << byte_array::ConstByteArray{"a mutable byte array must not reference the input"};
+
+  byte_array::ConstByteArray const input{stream.data().Copy()};
+  byte_array::ConstByteArray const original{input.Copy()};
+
+  // Production code under test
+  auto view = MsgPackSerializer::View(input);
+  auto moved{std::move(view)};
+
+  byte_array::ByteArray decoded;
+  moved >> decoded;
+  decoded[0] = 'A';
+
+  // Expectations
+  EXPECT_EQ(decoded, "A mutable byte array must not reference the input");
+  EXPECT_EQ(input, original);
+  EXPECT_EQ(moved.data().pointer(), input.pointer());
+}
+
+TEST_F(MsgPackSerializerTest, test_view_is_detached_before_being_modified)
+{
+  MsgPackSerializer stream;
+  stream << uint64_t{42};
+
+  byte_array::ConstByteArray const input{stream.data().Copy()};
+  byte_array::ConstByteArray const original{input.Copy()};
+
+  // Production code under test
+  auto view = MsgPackSerializer::View(input);
+  view << uint64_t{7};
+
+  // Expectations
+  EXPECT_EQ(input, original);
+  EXPECT_NE(view.data().pointer(), input.pointer());
+
+  uint64_t value{0};
+  view.seek(0);
+  view >> value;
+  EXPECT_EQ(7, value);
+}
+
 }  // namespace serializers
 }  // namespace fetch
@@ -0,0 +1,175 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+#include "core/serializers/counter.hpp"
+#include "core/serializers/main_serializer.hpp"
+#include "core/serializers/serialized_size.hpp"
+
+#include "gtest/gtest.h"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace fetch {
+namespace serializers {
+namespace {
+
+struct FixedLayout
+{
+  uint64_t value{0};
+  bool     flag{false};
+};
+
+}  // namespace
+
+template <>
+struct SerializedSizeBound<FixedLayout> : MapLayoutSizeBound<uint8_t, uint64_t, bool>
+{
+};
+
+template <typename D>
+struct MapSerializer<FixedLayout, D>
+{
+public:
+  using Type       = FixedLayout;
+  using DriverType = D;
+
+  static uint8_t const VALUE = 1;
+  static uint8_t const FLAG  = 2;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &input)
+  {
+    auto map = map_constructor(2);
+    map.Append(VALUE, input.value);
+    map.Append(FLAG, input.flag);
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &output)
+  {
+    map.ExpectKeyGetValue(VALUE, output.value);
+    map.ExpectKeyGetValue(FLAG, output.flag);
+  }
+};
+
+namespace {
+
+template <typename T>
+uint64_t Bound()
+{
+  return SerializedSizeBound<T>::VALUE;
+}
+
+template <typename T>
+uint64_t CountedSize(T const &value)
+{
+  SizeCounter counter;
+  counter << value;
+  return counter.size();
+}
+
+TEST(SerializedSizeTests, BoundedTypes)
+{
+  static_assert(SerializedSizeBound<uint8_t>::IS_BOUNDED, "");
+  static_assert(SerializedSizeBound<int64_t>::IS_BOUNDED, "");
+  static_assert(SerializedSizeBound<bool>::IS_BOUNDED, "");
+  static_assert(SerializedSizeBound<double>::IS_BOUNDED, "");
+  static_assert(SerializedSizeBound<std::array<uint32_t, 20>>::IS_BOUNDED, "");
+  static_assert(SerializedSizeBound<FixedLayout>::IS_BOUNDED, "");
+
+  static_assert(!SerializedSizeBound<std::string>::IS_BOUNDED, "");
+  static_assert(!SerializedSizeBound<std::array<std::string, 2>>::IS_BOUNDED, "");
+  static_assert(!CombinedSizeBound<uint64_t, std::string>::IS_BOUNDED, "");
+}
+
+TEST(SerializedSizeTests, BoundIsNeverExceeded)
+{
+  EXPECT_EQ(CountedSize(std::numeric_limits<uint64_t>::max()), Bound<uint64_t>());
+  EXPECT_EQ(CountedSize(std::numeric_limits<int32_t>::min()), Bound<int32_t>());
+  EXPECT_EQ(CountedSize(true), Bound<bool>());
+  EXPECT_EQ(CountedSize(1.0), Bound<double>());
+  EXPECT_EQ(CountedSize(1.0f), Bound<float>());
+
+  std::array<uint64_t, 20> array{};
+  array.fill(std::numeric_limits<uint64_t>::max());
+  EXPECT_EQ(CountedSize(array), Bound<decltype(array)>());
+
+  FixedLayout layout{std::numeric_limits<uint64_t>::max(), true};
+  EXPECT_LE(CountedSize(layout), Bound<FixedLayout>());
+
+  FixedLayout small{};
+  EXPECT_LE(CountedSize(small), Bound<FixedLayout>());
+}
+
+TEST(SerializedSizeTests, AppendWithBoundedTypesReservesOnce)
+{
+  MsgPackSerializer serializer;
+  serializer.Append(uint64_t{1} << 40u, true, 3.0, FixedLayout{42, true});
+
+  uint64_t const bound = CombinedSizeBound<uint64_t, bool, double, FixedLayout>::VALUE;
+  EXPECT_LE(serializer.size(), bound);
+  EXPECT_EQ(serializer.capacity(), bound);
+
+  uint64_t    value{0};
+  bool        flag{false};
+  double      real{0};
+  FixedLayout layout{};
+
+  serializer.seek(0);
+  serializer >> value >> flag >> real >> layout;
+
+  EXPECT_EQ(value, uint64_t{1} << 40u);
+  EXPECT_TRUE(flag);
+  EXPECT_EQ(real, 3.0);
+  EXPECT_EQ(layout.value, 42);
+  EXPECT_TRUE(layout.flag);
+}
+
+TEST(SerializedSizeTests, AllocateGrowsGeometrically)
+{
+  MsgPackSerializer serializer;
+
+  uint64_t reallocations{0};
+  uint64_t capacity{serializer.capacity()};
+  for (uint64_t i = 0; i < 1000; ++i)
+  {
+    serializer << std::string{"some unbounded value"};
+
+    if (serializer.capacity() != capacity)
+    {
+      capacity = serializer.capacity();
+      ++reallocations;
+    }
+  }
+
+  EXPECT_LT(reallocations, 20);
+
+  serializer.seek(0);
+  for (uint64_t i = 0; i < 1000; ++i)
+  {
+    std::string value;
+    serializer >> value;
+    EXPECT_EQ(value, "some unbounded value");
+  }
+}
+
+}  // namespace
+}  // namespace serializers
+}  // namespace fetch
@@ -139,6 +139,11 @@ class BlockSinkInterface;
  *                                  │                  │────────────────────────────────┘
  *                                  └──────────────────┘
  *
+ * When catching up on a long series of blocks the coordinator also maintains a lookahead window of
+ * the blocks which follow the current one on the heaviest chain. While the current block is waiting
+ * for transactions or being executed, the transactions of the blocks in this window are checked and
+ * any which are missing are requested from peers. The window is discarded as soon as it no longer
+ * extends the current block, for example after a fork switch.
  */
 class BlockCoordinator
 {
@@ -179,6 +184,8 @@ public:
   using StateMachine         = core::StateMachine<State>;
   using SynergeticExecMgrPtr = std::unique_ptr<SynergeticExecutionManagerInterface>;
 
+  static constexpr std::size_t DEFAULT_PIPELINE_DEPTH = 4;
+
   static char const *ToString(State state);
 
   // Construction / Destruction
@@ -223,6 +230,11 @@ public:
     });
   }
 
+  void SetPipelineDepth(std::size_t depth)
+  {
+    pipeline_depth_ = depth;
+  }
+
   bool IsSynced() const
   {
     return last_executed_block_.Apply([this](auto const &last_executed_block_hash) -> bool {
@@ -244,7 +256,18 @@ private:
     ERROR
   };
 
-  static constexpr uint64_t COMMON_PATH_TO_ANCESTOR_LENGTH_LIMIT = 5000;
+  static constexpr uint64_t    COMMON_PATH_TO_ANCESTOR_LENGTH_LIMIT = 5000;
+  static constexpr std::size_t MAX_LOOKAHEAD_TX_CHECKS              = 100;
+
+  struct LookaheadBlock
+  {
+    BlockPtr  block;                         ///< The upcoming block
+    DigestSet unchecked_txs{};               ///< The transactions which are still to be checked
+    DigestSet missing_txs{};                 ///< The transactions which were not present
+    bool      requested_missing_txs{false};  ///< Flag to signal the missing txs were requested
+
+    explicit LookaheadBlock(BlockPtr b);
+  };
 
   using NextBlockPtr      = std::unique_ptr<Block>;
   using PendingBlocks     = std::deque<BlockPtr>;
@@ -259,6 +282,7 @@ private:
   using FutureTimepoint   = fetch::core::FutureTimepoint;
   using DeadlineTimer     = fetch::moment::DeadlineTimer;
   using SynExecStatus     = SynergeticExecutionManagerInterface::ExecStatus;
+  using Lookahead         = std::deque<LookaheadBlock>;
 
   /// @name Monitor State
   /// @{
@@ -292,6 +316,14 @@ private:
   bool RevertToBlock(Block const &block);
   void Panic();
 
+  /// @name Pipelining
+  /// @{
+  void     AdvanceLookahead();
+  void     ResetLookahead();
+  BlockPtr LookupUpcomingBlock(Block const &block) const;
+  bool     ConsumeLookahead();
+  /// @}
+
   static char const *ToString(ExecutionStatus state);
 
   /// @name External Components
@@ -337,6 +369,12 @@ private:
   bool have_asked_for_missing_txs_{};
   /// @}
 
+  /// @name Pipelining
+  /// @{
+  std::size_t pipeline_depth_{DEFAULT_PIPELINE_DEPTH};  ///< The max number of lookahead blocks
+  Lookahead   lookahead_{};  ///< The upcoming blocks being prepared for execution
+  /// @}
+
   /// @name Synergetic Contracts
   /// @{
   SynergeticExecMgrPtr synergetic_exec_mgr_;
@@ -369,6 +407,10 @@ private:
   telemetry::CounterPtr         remove_block_total_;
   telemetry::CounterPtr         panic_block_total_;
   telemetry::CounterPtr         panic_search_total_;
+  telemetry::CounterPtr         lookahead_block_total_;
+  telemetry::CounterPtr         lookahead_hit_total_;
+  telemetry::CounterPtr         lookahead_rollback_total_;
+  telemetry::CounterPtr         lookahead_request_tx_total_;
   telemetry::HistogramPtr       tx_sync_times_;
   telemetry::GaugePtr<uint64_t> current_block_num_;
   telemetry::GaugePtr<uint64_t> next_block_num_;
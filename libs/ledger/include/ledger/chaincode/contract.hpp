@@ -157,8 +157,6 @@ private:
 
   std::unique_ptr<ContractContext> context_{};
 
-  static constexpr std::size_t DEFAULT_BUFFER_SIZE = 512;
-
   /// @name Dispatch Maps - built on construction
   /// @{
   InitialiseHandler     init_handler_{};
@@ -241,33 +239,17 @@ bool Contract::GetStateRecord(T &record, chain::Address const &address)
 template <typename T>
 bool Contract::GetStateRecord(T &record, ConstByteArray const &key)
 {
-  using fetch::byte_array::ByteArray;
-
   bool success{false};
 
-  ByteArray buffer;
-  buffer.Resize(std::size_t{DEFAULT_BUFFER_SIZE});  // initial guess, can be tuned over time
-
-  uint64_t buffer_length = buffer.size();
-  auto     status        = state().Read(std::string{key}, buffer.pointer(), buffer_length);
-
-  // in rare cases the initial buffer might be too small in this case we need to reallocate and then
-  // re-query
-  if (vm::IoObserverInterface::Status::BUFFER_TOO_SMALL == status)
-  {
-    // reallocate the buffer
-    buffer.Resize(buffer_length);
-
-    // retry the read
-    status = state().Read(std::string{key}, buffer.pointer(), buffer_length);
-  }
+  ConstByteArray buffer;
+  auto const     status = state().ReadBuffer(std::string{key}, buffer);
 
   switch (status)
   {
   case vm::IoObserverInterface::Status::OK:
   {
-    // adapt the buffer for deserialization
-    serializers::MsgPackSerializer adapter{buffer};
+    // deserialize directly from the buffer returned by the state
+    auto adapter = serializers::MsgPackSerializer::View(buffer);
     adapter >> record;
 
     success = true;
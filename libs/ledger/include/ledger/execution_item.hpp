@@ -17,12 +17,16 @@
 //
 //------------------------------------------------------------------------------
 
+#include "chain/transaction.hpp"
 #include "core/bitvector.hpp"
+#include "core/mutex.hpp"
 #include "ledger/executor_interface.hpp"
+#include "ledger/storage_unit/storage_unit_interface.hpp"
 #include "logging/logging.hpp"
 
 #include <atomic>
 #include <cstdint>
+#include <exception>
 #include <future>
 #include <memory>
 #include <utility>
@@ -33,11 +37,12 @@ namespace ledger {
 class ExecutionItem
 {
 public:
-  using LaneIndex  = uint32_t;
-  using BlockIndex = ExecutorInterface::BlockIndex;
-  using SliceIndex = ExecutorInterface::SliceIndex;
-  using Status     = ExecutorInterface::Status;
-  using Result     = ExecutorInterface::Result;
+  using LaneIndex      = uint32_t;
+  using BlockIndex     = ExecutorInterface::BlockIndex;
+  using SliceIndex     = ExecutorInterface::SliceIndex;
+  using Status         = ExecutorInterface::Status;
+  using Result         = ExecutorInterface::Result;
+  using TransactionPtr = ExecutorInterface::TransactionPtr;
 
   static constexpr char const *LOGGING_NAME = "ExecutionItem";
 
@@ -53,8 +58,10 @@ public:
   BitVector const &shards() const;
   Result const &   result() const;
   TokenAmount      fee() const;
+  bool             is_prefetched() const;
   /// @}
 
+  bool Prefetch(StorageUnitInterface &storage);
   void Execute(ExecutorInterface &executor);
   void AggregateStakeUpdates(StakeUpdateEvents &events);
 
@@ -71,6 +78,13 @@ private:
   BitVector   shards_;
   Result      result_;
   TokenAmount fee_{0};
+
+  /// @name Prefetch State
+  /// @{
+  mutable Mutex  lock_;           ///< guards `transaction_` and `started_`
+  TransactionPtr transaction_{};  ///< The transaction if it has been prefetched
+  bool           started_{false};  ///< Flag to signal that execution has started
+  /// @}
 };
 
 inline ExecutionItem::ExecutionItem(Digest digest, BlockIndex block, SliceIndex slice,
@@ -101,11 +115,65 @@ inline uint64_t ExecutionItem::fee() const
   return fee_;
 }
 
+inline bool ExecutionItem::is_prefetched() const
+{
+  FETCH_LOCK(lock_);
+  return static_cast<bool>(transaction_);
+}
+
+/**
+ * Retrieve the transaction from storage ahead of its execution. This is intended to be called from
+ * a background context while previous slices are being executed.
+ *
+ * @param storage The storage unit from which the transaction is retrieved
+ * @return true if the transaction is now available, otherwise false
+ */
+inline bool ExecutionItem::Prefetch(StorageUnitInterface &storage)
+{
+  {
+    FETCH_LOCK(lock_);
+
+    // there is nothing to be gained if the execution has already started
+    if (started_ || transaction_)
+    {
+      return static_cast<bool>(transaction_);
+    }
+  }
+
+  auto tx      = std::make_shared<chain::Transaction>();
+  bool success = false;
+
+  try
+  {
+    success = storage.GetTransaction(digest_, *tx);
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Exception thrown while prefetching transaction: ", ex.what());
+  }
+
+  if (success)
+  {
+    FETCH_LOCK(lock_);
+    transaction_ = std::move(tx);
+  }
+
+  return success;
+}
+
 inline void ExecutionItem::Execute(ExecutorInterface &executor)
 {
+  TransactionPtr tx{};
+
+  {
+    FETCH_LOCK(lock_);
+    started_ = true;
+    tx       = transaction_;
+  }
+
   try
   {
-    result_ = executor.Execute(digest_, block_, slice_, shards_);
+    result_ = executor.ExecutePrefetched(digest_, tx, block_, slice_, shards_);
     fee_ += result_.fee;
   }
   catch (std::exception const &ex)
@@ -87,7 +87,7 @@ private:
     std::size_t remaining{0};
   };
 
-  using ExecutionItemPtr  = std::unique_ptr<ExecutionItem>;
+  using ExecutionItemPtr  = std::shared_ptr<ExecutionItem>;
   using ExecutionItemList = std::vector<ExecutionItemPtr>;
   using ExecutionPlan     = std::vector<ExecutionItemList>;
   using ThreadPool        = fetch::network::ThreadPool;
@@ -138,6 +138,7 @@ private:
   Waitable<Counters> counters_{};
 
   ThreadPool thread_pool_;
+  ThreadPool prefetch_pool_;
   ThreadPtr  monitor_thread_;
 
   TransactionStatusPtr tx_status_cache_;  ///< Ref to the tx status cache
@@ -147,11 +148,15 @@ private:
   CounterPtr   slices_executed_count_;
   CounterPtr   fees_settled_count_;
   CounterPtr   blocks_completed_count_;
+  CounterPtr   tx_prefetched_count_;
+  CounterPtr   tx_prefetch_miss_count_;
   HistogramPtr execution_duration_;
 
   void MonitorThreadEntrypoint();
 
   bool PlanExecution(Block const &block);
+  void SchedulePrefetch();
+  void PrefetchExecution(ExecutionItem &item);
   void DispatchExecution(ExecutionItem &item);
 };
 
@@ -25,6 +25,7 @@
 #include "ledger/chaincode/token_contract.hpp"
 #include "ledger/executor_interface.hpp"
 #include "ledger/fees/fee_manager.hpp"
+#include "ledger/resource_address_cache.hpp"
 #include "ledger/storage_unit/storage_unit_interface.hpp"
 #include "ledger/transaction_validator.hpp"
 #include "telemetry/telemetry.hpp"
@@ -63,22 +64,25 @@ public:
                  BitVector const &shards) override;
   void   SettleFees(chain::Address const &miner, BlockIndex block, TokenAmount amount,
                     uint32_t log2_num_lanes, StakeUpdateEvents const &stake_updates) override;
+  Result ExecutePrefetched(Digest const &digest, TransactionPtr const &tx, BlockIndex block,
+                           SliceIndex slice, BitVector const &shards) override;
   /// @}
 
 private:
-  using TransactionPtr          = chain::TransactionPtr;
   using CachedStorageAdapterPtr = std::shared_ptr<CachedStorageAdapter>;
 
   bool RetrieveTransaction(Digest const &digest);
+  void PrefetchState();
   bool ValidationChecks(Result &result);
   bool ExecuteTransactionContract(Result &result);
   bool ProcessTransfers(Result &result);
 
   /// @name Resources
   /// @{
-  StorageUnitPtr storage_;             ///< The collection of resources
-  ChainCodeCache chain_code_cache_{};  //< The factory to create new chain code instances
-  TokenContract  token_contract_{};
+  StorageUnitPtr       storage_;             ///< The collection of resources
+  ChainCodeCache       chain_code_cache_{};  //< The factory to create new chain code instances
+  TokenContract        token_contract_{};
+  ResourceAddressCache address_cache_{};     ///< The interned state addresses
   /// @}
 
   /// @name Per Execution State
@@ -96,6 +100,7 @@ private:
 
   telemetry::HistogramPtr overall_duration_;
   telemetry::HistogramPtr tx_retrieve_duration_;
+  telemetry::HistogramPtr state_prefetch_duration_;
   telemetry::HistogramPtr validation_checks_duration_;
   telemetry::HistogramPtr contract_execution_duration_;
   telemetry::HistogramPtr transfers_duration_;
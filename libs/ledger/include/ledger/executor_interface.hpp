@@ -17,7 +17,10 @@
 //
 //------------------------------------------------------------------------------
 
+#include "chain/tx_declaration.hpp"
 #include "core/digest.hpp"
+#include "core/macros.hpp"
+#include "core/serializers/serialized_size.hpp"
 #include "ledger/consensus/stake_update_event.hpp"
 #include "ledger/execution_result.hpp"
 
@@ -36,12 +39,13 @@ namespace ledger {
 class ExecutorInterface
 {
 public:
-  using BlockIndex  = uint64_t;
-  using SliceIndex  = uint64_t;
-  using LaneIndex   = uint32_t;
-  using TokenAmount = uint64_t;
-  using Status      = ContractExecutionStatus;
-  using Result      = ContractExecutionResult;
+  using BlockIndex     = uint64_t;
+  using SliceIndex     = uint64_t;
+  using LaneIndex      = uint32_t;
+  using TokenAmount    = uint64_t;
+  using Status         = ContractExecutionStatus;
+  using Result         = ContractExecutionResult;
+  using TransactionPtr = chain::TransactionPtr;
 
   // Construction / Destruction
   ExecutorInterface()          = default;
@@ -54,8 +58,33 @@ public:
   virtual void   SettleFees(chain::Address const &miner, BlockIndex block, TokenAmount amount,
                             uint32_t log2_num_lanes, StakeUpdateEvents const &stake_updates) = 0;
   /// @}
+
+  virtual Result ExecutePrefetched(Digest const &digest, TransactionPtr const &tx,
+                                   BlockIndex block, SliceIndex slice, BitVector const &shards);
 };
 
+/**
+ * Executes a transaction which might have already been retrieved from storage. Executors which are
+ * able to make use of the prefetched transaction should override this method, by default the
+ * transaction is looked up again.
+ *
+ * @param digest The transaction digest to be executed
+ * @param tx The prefetched transaction (can be null if it was not available)
+ * @param block The current block index
+ * @param slice The current slice index
+ * @param shards The bit vector outlining the shards in use by this transaction
+ * @return The status code for the operation
+ */
+inline ExecutorInterface::Result ExecutorInterface::ExecutePrefetched(Digest const &        digest,
+                                                                      TransactionPtr const &tx,
+                                                                      BlockIndex            block,
+                                                                      SliceIndex            slice,
+                                                                      BitVector const &     shards)
+{
+  FETCH_UNUSED(tx);
+  return Execute(digest, block, slice, shards);
+}
+
 }  // namespace ledger
 
 namespace serializers {
@@ -113,5 +142,15 @@ public:
     map.ExpectKeyGetValue(FEE, result.fee);
   }
 };
+
+/// The status is encoded as an int32_t, followed by the charge, charge rate and fee
+template <>
+struct SerializedSizeBound<ledger::ExecutorInterface::Result>
+  : MapLayoutSizeBound<uint8_t, int32_t, ledger::ExecutorInterface::TokenAmount,
+                       ledger::ExecutorInterface::TokenAmount,
+                       ledger::ExecutorInterface::TokenAmount>
+{
+};
+
 }  // namespace serializers
 }  // namespace fetch
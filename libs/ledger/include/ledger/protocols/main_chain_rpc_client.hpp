@@ -18,6 +18,7 @@
 //------------------------------------------------------------------------------
 
 #include "ledger/protocols/main_chain_rpc_client_interface.hpp"
+#include "ledger/protocols/rpc_compression.hpp"
 #include "muddle/rpc/client.hpp"
 
 namespace fetch {
@@ -48,7 +49,8 @@ public:
 private:
   using RpcClient = muddle::rpc::Client;
 
-  RpcClient rpc_client_;
+  RpcCompressionNegotiator compression_;
+  RpcClient                rpc_client_;
 };
 
 }  // namespace ledger
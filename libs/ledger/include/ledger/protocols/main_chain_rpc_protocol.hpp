@@ -21,6 +21,7 @@
 #include "core/service_ids.hpp"
 #include "ledger/chain/main_chain.hpp"
 #include "ledger/chain/time_travelogue.hpp"
+#include "ledger/protocols/rpc_compression.hpp"
 #include "network/service/protocol.hpp"
 
 namespace fetch {
@@ -34,15 +35,18 @@ public:
 
   enum
   {
-    TIME_TRAVEL      = 2,
-    COMMON_SUB_CHAIN = 3
+    TIME_TRAVEL            = 2,
+    COMMON_SUB_CHAIN       = 3,
+    TIME_TRAVEL_COMPRESSED = 4
   };
 
   explicit MainChainProtocol(MainChain &chain)
     : chain_(chain)
+    , compressor_{"ledger_main_chain_rpc_time_travel", byte_array::ConstByteArray{}}
   {
     Expose(COMMON_SUB_CHAIN, this, &MainChainProtocol::GetCommonSubChain);
     Expose(TIME_TRAVEL, this, &MainChainProtocol::TimeTravel);
+    Expose(TIME_TRAVEL_COMPRESSED, this, &MainChainProtocol::TimeTravelCompressed);
   }
 
   Blocks GetCommonSubChain(Digest start, Digest last_seen, uint64_t limit)
@@ -63,8 +67,14 @@ public:
     return chain_.TimeTravel(std::move(start));
   }
 
+  core::CompressedPayload TimeTravelCompressed(Digest start, core::CompressionCodecMask accepted)
+  {
+    return compressor_.Encode(TimeTravel(std::move(start)), accepted);
+  }
+
 private:
-  MainChain &chain_;
+  MainChain &           chain_;
+  RpcResponseCompressor compressor_;
 };
 
 }  // namespace ledger
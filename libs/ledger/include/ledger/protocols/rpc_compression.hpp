@@ -0,0 +1,176 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/compression/compressed_payload.hpp"
+#include "core/mutex.hpp"
+#include "core/serializers/main_serializer.hpp"
+#include "muddle/address.hpp"
+#include "network/service/promise.hpp"
+#include "telemetry/telemetry.hpp"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Server side helper which encodes RPC responses as (optionally) compressed payloads and records
+ * the effectiveness of the compression through telemetry.
+ */
+class RpcResponseCompressor
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+  using CodecMask      = core::CompressionCodecMask;
+  using Labels         = std::unordered_map<std::string, std::string>;
+
+  // Construction / Destruction
+  RpcResponseCompressor(std::string const &prefix, ConstByteArray dictionary,
+                        Labels const &labels = Labels{});
+  RpcResponseCompressor(RpcResponseCompressor const &) = delete;
+  RpcResponseCompressor(RpcResponseCompressor &&)      = delete;
+  ~RpcResponseCompressor()                             = default;
+
+  template <typename T>
+  core::CompressedPayload Encode(T const &value, CodecMask accepted);
+  core::CompressedPayload EncodeRaw(ConstByteArray const &raw, CodecMask accepted);
+
+  // Operators
+  RpcResponseCompressor &operator=(RpcResponseCompressor const &) = delete;
+  RpcResponseCompressor &operator=(RpcResponseCompressor &&) = delete;
+
+private:
+  ConstByteArray const dictionary_;
+
+  // telemetry
+  telemetry::CounterPtr   raw_bytes_total_;
+  telemetry::CounterPtr   compressed_bytes_total_;
+  telemetry::HistogramPtr ratios_;
+  telemetry::HistogramPtr durations_;
+};
+
+/**
+ * Serialise and encode a response
+ *
+ * @tparam T The type of the response
+ * @param value The response
+ * @param accepted The set of codecs the caller is able to decode
+ * @return The encoded payload
+ */
+template <typename T>
+core::CompressedPayload RpcResponseCompressor::Encode(T const &value, CodecMask accepted)
+{
+  serializers::MsgPackSerializer serializer;
+  serializer << value;
+
+  return EncodeRaw(serializer.data(), accepted);
+}
+
+/**
+ * Client side helper which tracks the peers which are unable to serve an optional RPC call.
+ *
+ * Peers which predate the call reject it as an unknown member, once this has been observed for a
+ * peer the caller should fall back to the older calls.
+ */
+class RpcSupportTracker
+{
+public:
+  using Address = muddle::Address;
+  using Promise = service::Promise;
+
+  static constexpr char const *LOGGING_NAME = "RpcSupportTracker";
+
+  // Construction / Destruction
+  RpcSupportTracker(std::string const &prefix, std::string feature);
+  RpcSupportTracker(RpcSupportTracker const &) = delete;
+  RpcSupportTracker(RpcSupportTracker &&)      = delete;
+  ~RpcSupportTracker()                         = default;
+
+  bool IsSupported(Address const &peer) const;
+  void Monitor(Address const &peer, Promise const &promise);
+
+  // Operators
+  RpcSupportTracker &operator=(RpcSupportTracker const &) = delete;
+  RpcSupportTracker &operator=(RpcSupportTracker &&) = delete;
+
+private:
+  struct LegacyPeers
+  {
+    Mutex                       lock;
+    std::unordered_set<Address> peers;
+  };
+
+  using LegacyPeersPtr = std::shared_ptr<LegacyPeers>;
+
+  std::string const feature_;
+  LegacyPeersPtr    legacy_peers_{std::make_shared<LegacyPeers>()};
+
+  // telemetry
+  telemetry::CounterPtr fallback_total_;
+};
+
+/**
+ * Client side helper which tracks the peers which are able to serve compressed responses and
+ * decodes the responses from the peers that can.
+ *
+ * Compression is negotiated per request: the caller advertises the codecs it can decode and the
+ * serving peer selects one (possibly none). Peers which predate the compressed RPC calls reject
+ * them as unknown members, once this has been observed for a peer the caller should fall back to
+ * the original uncompressed calls.
+ */
+class RpcCompressionNegotiator
+{
+public:
+  using ConstByteArray = byte_array::ConstByteArray;
+  using CodecMask      = core::CompressionCodecMask;
+  using Address        = muddle::Address;
+  using Promise        = service::Promise;
+  using Decoder        = service::details::PromiseImplementation::Decoder;
+
+  static constexpr char const *LOGGING_NAME = "RpcCompressionNegotiator";
+
+  // Construction / Destruction
+  RpcCompressionNegotiator(std::string const &prefix, ConstByteArray dictionary);
+  RpcCompressionNegotiator(RpcCompressionNegotiator const &) = delete;
+  RpcCompressionNegotiator(RpcCompressionNegotiator &&)      = delete;
+  ~RpcCompressionNegotiator()                                = default;
+
+  bool      IsSupported(Address const &peer) const;
+  CodecMask accepted_codecs() const;
+  Decoder   CreateDecoder() const;
+  void      Monitor(Address const &peer, Promise const &promise);
+
+  // Operators
+  RpcCompressionNegotiator &operator=(RpcCompressionNegotiator const &) = delete;
+  RpcCompressionNegotiator &operator=(RpcCompressionNegotiator &&) = delete;
+
+private:
+  ConstByteArray const dictionary_;
+  RpcSupportTracker    support_;
+
+  // telemetry
+  telemetry::HistogramPtr durations_;
+};
+
+}  // namespace ledger
+}  // namespace fetch
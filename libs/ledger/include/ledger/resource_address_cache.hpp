@@ -0,0 +1,69 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "storage/resource_mapper.hpp"
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Interns the resource addresses which are generated for scoped state keys. Generating an address
+ * involves building the scoped key and hashing it, which is comparatively expensive for contracts
+ * that access the same small set of keys many times. The cache is bounded and is simply cleared
+ * when it becomes full.
+ */
+class ResourceAddressCache
+{
+public:
+  using ConstByteArray  = byte_array::ConstByteArray;
+  using ResourceAddress = storage::ResourceAddress;
+
+  static constexpr std::size_t DEFAULT_MAX_ENTRIES = 4096;
+
+  // Construction / Destruction
+  explicit ResourceAddressCache(std::size_t max_entries = DEFAULT_MAX_ENTRIES);
+  ResourceAddressCache(ResourceAddressCache const &) = delete;
+  ResourceAddressCache(ResourceAddressCache &&)      = delete;
+  ~ResourceAddressCache()                            = default;
+
+  ResourceAddress const &Lookup(ConstByteArray const &scope, std::string const &key);
+  void                   Clear();
+
+  std::size_t size() const;
+
+  // Operators
+  ResourceAddressCache &operator=(ResourceAddressCache const &) = delete;
+  ResourceAddressCache &operator=(ResourceAddressCache &&) = delete;
+
+private:
+  using KeyMap   = std::unordered_map<std::string, ResourceAddress>;
+  using ScopeMap = std::unordered_map<ConstByteArray, KeyMap>;
+
+  std::size_t const max_entries_;
+  std::size_t       num_entries_{0};
+  ScopeMap          scopes_{};
+};
+
+}  // namespace ledger
+}  // namespace fetch
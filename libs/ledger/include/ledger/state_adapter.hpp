@@ -17,6 +17,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include "ledger/resource_address_cache.hpp"
 #include "ledger/storage_unit/storage_unit_interface.hpp"
 #include "vm/io_observer_interface.hpp"
 
@@ -34,6 +35,10 @@ namespace ledger {
 
 /**
  * Adapter between the VM IO interface and the main ledger state database.
+ *
+ * A longer lived address cache (for example one per executor) can be provided so that the resource
+ * addresses generated for the state keys are reused between transactions. Without a cache the
+ * addresses are generated on each access.
  */
 class StateAdapter : public vm::IoObserverInterface
 {
@@ -52,11 +57,13 @@ public:
 
   // Construction / Destruction
   StateAdapter(StorageInterface &storage, ConstByteArray scope);
+  StateAdapter(StorageInterface &storage, ConstByteArray scope, ResourceAddressCache &cache);
   ~StateAdapter() override = default;
 
   /// @name Io Observer Interface
   /// @{
   Status Read(std::string const &key, void *data, uint64_t &size) override;
+  Status ReadBuffer(std::string const &key, ConstByteArray &data) override;
   Status Write(std::string const &key, void const *data, uint64_t size) override;
   Status Exists(std::string const &key) override;
   /// @}
@@ -65,14 +72,22 @@ public:
   void PopContext();
 
 protected:
-  ConstByteArray CurrentScope() const;
+  using ResourceAddress = storage::ResourceAddress;
+
+  ConstByteArray const & CurrentScope() const;
+  ResourceAddress const &LookupAddress(std::string const &key);
 
   // Protected construction
-  StateAdapter(StorageInterface &storage, ConstByteArray scope, Mode mode);
+  StateAdapter(StorageInterface &storage, ConstByteArray scope, Mode mode,
+               ResourceAddressCache *cache = nullptr);
 
   StorageInterface &          storage_;
   std::vector<ConstByteArray> scope_;
   Mode const                  mode_;
+
+private:
+  ResourceAddressCache *address_cache_;
+  ResourceAddress       last_address_{};
 };
 
 }  // namespace ledger
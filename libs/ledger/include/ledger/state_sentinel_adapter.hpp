@@ -38,11 +38,14 @@ public:
 
   // Construction / Destruction
   StateSentinelAdapter(StorageInterface &storage, ConstByteArray scope, BitVector const &shards);
+  StateSentinelAdapter(StorageInterface &storage, ConstByteArray scope, BitVector const &shards,
+                       ResourceAddressCache &cache);
   ~StateSentinelAdapter() override;
 
   /// @name IO Observer Interface
   /// @{
   Status Read(std::string const &key, void *data, uint64_t &size) override;
+  Status ReadBuffer(std::string const &key, ConstByteArray &data) override;
   Status Write(std::string const &key, void const *data, uint64_t size) override;
   Status Exists(std::string const &key) override;
   /// @}
@@ -55,7 +58,10 @@ public:
   /// @}
 
 private:
-  bool IsAllowedResource(std::string const &key) const;
+  StateSentinelAdapter(StorageInterface &storage, ConstByteArray scope, BitVector const &shards,
+                       ResourceAddressCache *cache);
+
+  bool IsAllowedResource(std::string const &key);
 
   /// @name Shard Limits
   /// @{
@@ -40,6 +40,7 @@ public:
   explicit CachedStorageAdapter(StorageInterface &storage);
   ~CachedStorageAdapter() override;
 
+  void Prefetch(Addresses const &keys);
   void Flush();
   void Clear();
 
@@ -60,8 +61,9 @@ private:
     bool       flushed{false};
 
     CacheEntry() = default;
-    explicit CacheEntry(StateValue v)
+    explicit CacheEntry(StateValue v, bool f = false)
       : value{std::move(v)}
+      , flushed{f}
     {}
   };
 
@@ -0,0 +1,142 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/const_byte_array.hpp"
+#include "core/digest.hpp"
+#include "core/serializers/base_types.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * An invertible bloom lookup table (IBLT) over transaction digests used for set reconciliation.
+ *
+ * Each side of the reconciliation inserts its set of digests into a table of the same size. When
+ * one table is subtracted from the other, the digests common to both sets cancel out and the
+ * (small) symmetric difference can be recovered by repeatedly peeling cells which contain a single
+ * digest. The size of the table only needs to be proportional to the expected difference, not the
+ * size of the sets themselves.
+ */
+class InvertibleBloomLookupTable
+{
+public:
+  static constexpr std::size_t NUM_HASHES  = 3;
+  static constexpr std::size_t DIGEST_SIZE = 32;
+  static constexpr std::size_t CELL_SIZE   = sizeof(int32_t) + DIGEST_SIZE + sizeof(uint64_t);
+  static constexpr std::size_t MIN_CELLS   = 20 * NUM_HASHES;
+  static constexpr std::size_t MAX_CELLS   = 20000 * NUM_HASHES;
+  static constexpr int32_t     MAX_COUNT   = 1 << 24;  ///< Largest magnitude of a cell count
+
+  // Construction / Destruction
+  InvertibleBloomLookupTable() = default;
+  explicit InvertibleBloomLookupTable(std::size_t num_cells);
+  InvertibleBloomLookupTable(InvertibleBloomLookupTable const &)     = default;
+  InvertibleBloomLookupTable(InvertibleBloomLookupTable &&) noexcept = default;
+  ~InvertibleBloomLookupTable()                                      = default;
+
+  static std::size_t CellsForDifference(std::size_t expected_difference);
+
+  /// @name Accessors
+  /// @{
+  std::size_t size() const;
+  bool        empty() const;
+  /// @}
+
+  /// @name Set Operations
+  /// @{
+  bool Insert(Digest const &digest);
+  bool Subtract(InvertibleBloomLookupTable const &other);
+  bool Decode(DigestSet &local_only, DigestSet &remote_only) const;
+  /// @}
+
+  /// @name Wire Format
+  /// @{
+  byte_array::ConstByteArray ToBytes() const;
+  bool                       FromBytes(byte_array::ConstByteArray const &encoded);
+  /// @}
+
+  // Operators
+  InvertibleBloomLookupTable &operator=(InvertibleBloomLookupTable const &) = default;
+  InvertibleBloomLookupTable &operator=(InvertibleBloomLookupTable &&) noexcept = default;
+
+private:
+  using KeySum = std::array<uint8_t, DIGEST_SIZE>;
+
+  struct Cell
+  {
+    int32_t  count{0};
+    KeySum   key_sum{};
+    uint64_t hash_sum{0};
+
+    bool IsEmpty() const;
+    bool IsPure() const;
+    bool CanToggle(int32_t delta) const;
+    void Toggle(KeySum const &key, uint64_t hash, int32_t delta);
+  };
+
+  using Cells = std::vector<Cell>;
+
+  bool        Toggle(KeySum const &key, int32_t delta);
+  std::size_t CellIndex(KeySum const &key, std::size_t hash_index) const;
+
+  static uint64_t CheckHash(KeySum const &key);
+
+  Cells cells_{};
+};
+
+}  // namespace ledger
+
+namespace serializers {
+
+template <typename D>
+struct MapSerializer<ledger::InvertibleBloomLookupTable, D>
+{
+public:
+  using Type       = ledger::InvertibleBloomLookupTable;
+  using DriverType = D;
+
+  static constexpr uint8_t CELLS = 1;
+
+  template <typename Constructor>
+  static void Serialize(Constructor &map_constructor, Type const &table)
+  {
+    auto map = map_constructor(1);
+    map.Append(CELLS, table.ToBytes());
+  }
+
+  template <typename MapDeserializer>
+  static void Deserialize(MapDeserializer &map, Type &table)
+  {
+    byte_array::ConstByteArray encoded;
+    map.ExpectKeyGetValue(CELLS, encoded);
+
+    if (!table.FromBytes(encoded))
+    {
+      throw SerializableException(std::string{"Invalid invertible bloom lookup table"});
+    }
+  }
+};
+
+}  // namespace serializers
+}  // namespace fetch
@@ -35,6 +35,7 @@
 
 #include <array>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <exception>
@@ -74,6 +75,9 @@ public:
   Document Get(ResourceAddress const &key) const override;
   void     Set(ResourceAddress const &key, StateValue const &value) override;
 
+  Documents GetBatch(Addresses const &keys) const override;
+  void      SetBatch(Addresses const &keys, StateValues const &values) override;
+
   void Reset() override;
 
   // state hash functions
@@ -96,11 +100,14 @@ private:
   using AddressList          = std::vector<muddle::Address>;
   using MerkleTree           = crypto::MerkleTree;
   using PermanentMerkleStack = fetch::storage::ObjectStack<crypto::MerkleTree>;
+  using KeyIndices           = std::vector<std::size_t>;
+  using LaneKeyIndices       = std::vector<KeyIndices>;
 
   Address const &LookupAddress(ShardIndex shard) const;
   Address const &LookupAddress(storage::ResourceID const &resource) const;
 
-  bool HashInStack(Hash const &hash, uint64_t index);
+  bool           HashInStack(Hash const &hash, uint64_t index);
+  LaneKeyIndices GroupByLane(Addresses const &keys) const;
 
   /// @name Client Information
   /// @{
@@ -23,6 +23,9 @@
 #include "storage/document.hpp"
 #include "storage/resource_mapper.hpp"
 
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
 #include <vector>
 
 namespace fetch {
@@ -43,6 +46,9 @@ public:
   using StateValue      = byte_array::ConstByteArray;
   using ShardIndex      = uint32_t;
   using Keys            = std::vector<storage::ResourceID>;
+  using Addresses       = std::vector<ResourceAddress>;
+  using Documents       = std::vector<Document>;
+  using StateValues     = std::vector<StateValue>;
 
   // Construction / Destruction
   StorageInterface()          = default;
@@ -57,8 +63,52 @@ public:
   virtual bool     Unlock(ShardIndex shard)                                 = 0;
   virtual void     Reset()                                                  = 0;
   /// @}
+
+  /// @name Batched State Interface
+  /// @{
+  virtual Documents GetBatch(Addresses const &keys) const;
+  virtual void      SetBatch(Addresses const &keys, StateValues const &values);
+  /// @}
 };
 
+/**
+ * Get a series of documents from the storage engine. Implementations which are able to service
+ * multiple keys in a single request should override this method, by default the keys are looked up
+ * one at a time.
+ *
+ * @param keys The keys to be accessed
+ * @return The documents in the same order as the requested keys
+ */
+inline StorageInterface::Documents StorageInterface::GetBatch(Addresses const &keys) const
+{
+  Documents documents{};
+  documents.reserve(keys.size());
+
+  for (auto const &key : keys)
+  {
+    documents.emplace_back(Get(key));
+  }
+
+  return documents;
+}
+
+/**
+ * Set a series of values on the storage engine. Implementations which are able to service multiple
+ * keys in a single request should override this method, by default the keys are set one at a time.
+ *
+ * @param keys The keys to be updated
+ * @param values The values to be set (in the same order as the keys)
+ */
+inline void StorageInterface::SetBatch(Addresses const &keys, StateValues const &values)
+{
+  assert(keys.size() == values.size());
+
+  for (std::size_t i = 0, end = std::min(keys.size(), values.size()); i < end; ++i)
+  {
+    Set(keys[i], values[i]);
+  }
+}
+
 class StorageUnitInterface : public StorageInterface
 {
 public:
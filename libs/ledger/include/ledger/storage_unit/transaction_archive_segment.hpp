@@ -0,0 +1,120 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "core/digest.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * An immutable segment of archived transactions.
+ *
+ * The transactions in a segment are sorted by digest, using the same bit ordering as the key value
+ * index of the random access stores. As a result both the lookup of a single transaction and the
+ * pulling of a subtree map to a contiguous range of records. Each segment also contains a sparse
+ * index (one entry every INDEX_STRIDE records) and a bloom filter. Both of these are loaded into
+ * memory when the segment is opened, so that lookups for absent transactions rarely touch the
+ * disk and lookups for present transactions require a single seek.
+ *
+ *   ┌──────────┬──────────┬─────┬──────────┬──────────────┬──────────────┬──────────┐
+ *   │ Record 0 │ Record 1 │ ... │ Record N │ Sparse Index │ Bloom Filter │  Footer  │
+ *   └──────────┴──────────┴─────┴──────────┴──────────────┴──────────────┴──────────┘
+ *
+ * Segments are written to a temporary file which is synced to disk and then renamed, so a
+ * partially written segment is never opened. The file is only opened for the duration of each
+ * lookup, so idle segments do not hold a file descriptor. Once a segment has been replaced (for
+ * example by merging it with another) it can be marked as obsolete, in which case the file is
+ * removed when the last reference to the segment is released.
+ */
+class TransactionArchiveSegment
+{
+public:
+  using TxArray = std::vector<chain::Transaction>;
+
+  static constexpr std::size_t INDEX_STRIDE         = 64;
+  static constexpr std::size_t BLOOM_BITS_PER_ENTRY = 10;
+  static constexpr std::size_t BLOOM_NUM_HASHES     = 7;
+
+  // Construction / Destruction
+  TransactionArchiveSegment()                                  = default;
+  TransactionArchiveSegment(TransactionArchiveSegment const &) = delete;
+  TransactionArchiveSegment(TransactionArchiveSegment &&)      = delete;
+  ~TransactionArchiveSegment();
+
+  static bool Write(std::string const &filename, TxArray txs);
+  static bool Merge(std::string const &filename, TransactionArchiveSegment const &older,
+                    TransactionArchiveSegment const &newer);
+  static bool CommitFile(std::string const &tmp_filename, std::string const &filename);
+  static bool DigestLess(Digest const &a, Digest const &b);
+  static bool MatchesPrefix(Digest const &digest, Digest const &prefix, uint64_t bit_count);
+
+  bool Open(std::string const &filename);
+  void MarkObsolete();
+
+  /// @name Transaction Access
+  /// @{
+  bool     Has(Digest const &digest) const;
+  bool     Get(Digest const &digest, chain::Transaction &tx) const;
+  uint64_t PullSubtree(Digest const &partial_digest, uint64_t bit_count, uint64_t pull_limit,
+                       TxArray &txs) const;
+  uint64_t size() const;
+  /// @}
+
+  // Operators
+  TransactionArchiveSegment &operator=(TransactionArchiveSegment const &) = delete;
+  TransactionArchiveSegment &operator=(TransactionArchiveSegment &&) = delete;
+
+private:
+  class Writer;
+
+  struct IndexEntry
+  {
+    Digest   digest;
+    uint64_t offset{0};
+  };
+
+  using Index     = std::vector<IndexEntry>;
+  using BloomBits = std::vector<uint64_t>;
+
+  bool     MayContain(Digest const &digest) const;
+  uint64_t LocateRecords(Digest const &digest) const;
+  bool     OpenStream(std::ifstream &stream, uint64_t offset) const;
+  bool     Seek(std::ifstream &stream, Digest const &digest) const;
+  bool     ReadDigest(std::istream &stream, Digest &digest) const;
+  bool     ReadRecord(std::istream &stream, Digest &digest, byte_array::ByteArray &payload) const;
+
+  std::string       filename_{};
+  uint64_t          num_records_{0};
+  uint64_t          records_end_{0};
+  Index             index_{};
+  BloomBits         bloom_{};
+  std::atomic<bool> obsolete_{false};  ///< Remove the file once the segment is no longer referenced
+};
+
+}  // namespace ledger
+}  // namespace fetch
@@ -18,25 +18,51 @@
 //------------------------------------------------------------------------------
 
 #include "chain/transaction.hpp"
+#include "core/mutex.hpp"
 #include "ledger/storage_unit/transaction_store_interface.hpp"
 #include "storage/object_store.hpp"
 
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace fetch {
 namespace ledger {
 
+class TransactionArchiveSegment;
+
+/**
+ * Tiered transaction storage.
+ *
+ * Recently added transactions are kept in a (hot) object store. Once segment_size transactions
+ * have accumulated they are moved, by a background thread, into an immutable (cold) archive
+ * segment, which is a compact sorted file with an in memory sparse index and bloom filter. Lookups
+ * check the hot store first and then the segments from newest to oldest.
+ *
+ * Whenever the newest segment is at least as large as the one before it the two are merged, so
+ * that the number of segments (and therefore the number of bloom filters checked on a lookup)
+ * grows logarithmically with the number of archived transactions.
+ *
+ * The set of live segments is recorded in a manifest file which is replaced atomically. Segment
+ * ids are never reused, so a new segment never overwrites an existing file.
+ */
 class TransactionStore : public TransactionStoreInterface
 {
 public:
   using TxArray = std::vector<chain::Transaction>;
 
+  static constexpr std::size_t DEFAULT_SEGMENT_SIZE = 1u << 15u;
+
   // Construction / Destruction
-  TransactionStore()                         = default;
+  explicit TransactionStore(std::size_t segment_size = DEFAULT_SEGMENT_SIZE);
   TransactionStore(TransactionStore const &) = delete;
   TransactionStore(TransactionStore &&)      = delete;
-  ~TransactionStore() override               = default;
+  ~TransactionStore() override;
 
   // Database control
   void New(std::string const &doc_file, std::string const &index_file, bool create = true);
@@ -55,14 +81,55 @@ public:
   TxArray PullSubtree(Digest const &partial_digest, uint64_t bit_count, uint64_t pull_limit);
   /// @}
 
+  std::size_t GetSegmentCount() const;
+  void        WaitForArchive() const;
+
   // Operators
   TransactionStore &operator=(TransactionStore const &) = delete;
   TransactionStore &operator=(TransactionStore &&) = delete;
 
 private:
-  using Archive = storage::ObjectStore<chain::Transaction>;
+  struct Segment
+  {
+    uint64_t                                   id{0};
+    std::shared_ptr<TransactionArchiveSegment> segment{};
+  };
+
+  using Archive     = storage::ObjectStore<chain::Transaction>;
+  using Segments    = std::vector<Segment>;
+  using SegmentsPtr = std::shared_ptr<Segments const>;
+  using SegmentIds  = std::vector<uint64_t>;
+  using DigestArray = std::vector<Digest>;
+  using Condition   = std::condition_variable_any;
+  using ThreadPtr   = std::unique_ptr<std::thread>;
+
+  std::string SegmentFilename(uint64_t id) const;
+  std::string ManifestFilename() const;
+  bool        ReadManifest(SegmentIds &ids, uint64_t &next_id) const;
+  bool        WriteManifest(Segments const &segments, uint64_t next_id) const;
+  void        RemoveUnreferencedSegments(SegmentIds const &ids, uint64_t &next_id) const;
+  SegmentsPtr GetSegments() const;
+  bool        HasInSegments(Digest const &tx_digest) const;
+  static bool HasInSegments(Segments const &segments, Digest const &tx_digest);
+  void        RequestArchive();
+  void        ArchiveRecentTransactions();
+  void        MergeSegments();
+  void        ThreadEntryPoint();
+
+  std::size_t const segment_size_;
+  mutable Archive   archive_;  ///< The hot store of recent transactions
 
-  mutable Archive archive_;
+  mutable Mutex     lock_;                ///< Guards the members below
+  mutable Condition archive_wake_;        ///< Signals the archive thread, or waiters on it
+  std::string       doc_file_{};          ///< The base filename for the segments
+  SegmentsPtr       segments_{};          ///< The cold segments, oldest first
+  uint64_t          next_segment_id_{0};  ///< The id to be used for the next segment
+  uint64_t          num_archived_{0};     ///< The number of transactions in the segments
+  std::size_t       num_archiving_{0};    ///< The number of transactions being archived
+  DigestArray       recent_digests_{};    ///< The digests of the transactions in the hot store
+  bool              archiving_{false};    ///< Flag to signal the hot store is being archived
+  std::atomic<bool> running_{true};       ///< Flag to signal the archive thread to stop
+  ThreadPtr         archive_thread_{};
 };
 
 }  // namespace ledger
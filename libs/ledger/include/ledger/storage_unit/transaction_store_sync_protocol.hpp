@@ -19,6 +19,8 @@
 
 #include "chain/transaction.hpp"
 #include "core/digest.hpp"
+#include "ledger/protocols/rpc_compression.hpp"
+#include "ledger/storage_unit/invertible_bloom_lookup_table.hpp"
 #include "ledger/storage_unit/lane_connectivity_details.hpp"
 #include "ledger/storage_unit/transaction_sinks.hpp"
 #include "ledger/transaction_verifier.hpp"
@@ -49,10 +51,14 @@ class TransactionStoreSyncProtocol : public fetch::service::Protocol
 public:
   enum
   {
-    OBJECT_COUNT          = 1,
-    PULL_OBJECTS          = 2,
-    PULL_SUBTREE          = 3,
-    PULL_SPECIFIC_OBJECTS = 4
+    OBJECT_COUNT                     = 1,
+    PULL_OBJECTS                     = 2,
+    PULL_SUBTREE                     = 3,
+    PULL_SPECIFIC_OBJECTS            = 4,
+    PULL_OBJECTS_COMPRESSED          = 5,
+    PULL_SUBTREE_COMPRESSED          = 6,
+    PULL_SPECIFIC_OBJECTS_COMPRESSED = 7,
+    PULL_OBJECTS_DELTA               = 8
   };
 
   static constexpr char const *LOGGING_NAME = "ObjectStoreSyncProtocol";
@@ -63,8 +69,9 @@ public:
   TransactionStoreSyncProtocol(TransactionStoreSyncProtocol &&)      = delete;
   ~TransactionStoreSyncProtocol() override                           = default;
 
-  void OnNewTx(chain::Transaction const &tx);
-  void TrimCache();
+  void      OnNewTx(chain::Transaction const &tx);
+  void      TrimCache();
+  DigestSet GetRecentDigests();
 
   // Operators
   TransactionStoreSyncProtocol &operator=(TransactionStoreSyncProtocol const &) = delete;
@@ -88,15 +95,28 @@ private:
     Timepoint          created{Clock::now()};
   };
 
-  using Cache   = std::vector<CachedObject>;
-  using TxArray = std::vector<chain::Transaction>;
-  using TxStore = TransactionStorageEngineInterface;
+  using Cache             = std::vector<CachedObject>;
+  using TxArray           = std::vector<chain::Transaction>;
+  using TxStore           = TransactionStorageEngineInterface;
+  using CompressedPayload = core::CompressedPayload;
+  using CodecMask         = core::CompressionCodecMask;
 
   uint64_t ObjectCount();
   TxArray  PullObjects(service::CallContext const &call_context);
   TxArray  PullSubtree(byte_array::ConstByteArray const &rid, uint64_t bit_count);
   TxArray  PullSpecificObjects(DigestSet const &digests);
 
+  /// @name Compressed Variants
+  /// @{
+  CompressedPayload PullObjectsCompressed(service::CallContext const &call_context,
+                                          CodecMask                   accepted);
+  CompressedPayload PullSubtreeCompressed(byte_array::ConstByteArray const &rid, uint64_t bit_count,
+                                          CodecMask accepted);
+  CompressedPayload PullSpecificObjectsCompressed(DigestSet const &digests, CodecMask accepted);
+  CompressedPayload PullObjectsDelta(service::CallContext const &      call_context,
+                                     InvertibleBloomLookupTable const &remote, CodecMask accepted);
+  /// @}
+
   telemetry::CounterPtr   CreateCounter(char const *operation) const;
   telemetry::HistogramPtr CreateHistogram(char const *operation) const;
 
@@ -106,15 +126,20 @@ private:
   Mutex cache_mutex_;  ///< The mutex protecting cache_
   Cache cache_;
 
+  RpcResponseCompressor compressor_;
+
   // telemetry
   telemetry::CounterPtr   object_count_total_;
   telemetry::CounterPtr   pull_objects_total_;
   telemetry::CounterPtr   pull_subtree_total_;
   telemetry::CounterPtr   pull_specific_objects_total_;
+  telemetry::CounterPtr   pull_objects_delta_total_;
+  telemetry::CounterPtr   pull_objects_delta_fallback_total_;
   telemetry::HistogramPtr object_count_durations_;
   telemetry::HistogramPtr pull_objects_durations_;
   telemetry::HistogramPtr pull_subtree_durations_;
   telemetry::HistogramPtr pull_specific_objects_durations_;
+  telemetry::HistogramPtr pull_objects_delta_durations_;
 };
 
 }  // namespace ledger
@@ -24,6 +24,8 @@
 #include "core/future_timepoint.hpp"
 #include "core/service_ids.hpp"
 #include "core/state_machine.hpp"
+#include "ledger/protocols/rpc_compression.hpp"
+#include "ledger/storage_unit/invertible_bloom_lookup_table.hpp"
 #include "ledger/storage_unit/lane_controller.hpp"
 #include "ledger/storage_unit/transaction_sinks.hpp"
 #include "ledger/transaction_verifier.hpp"
@@ -80,6 +82,7 @@ public:
   using ResourceID            = storage::ResourceID;
   using EventNewTransaction   = std::function<void(chain::Transaction const &)>;
   using TrimCacheCallback     = std::function<void()>;
+  using RecentDigestsCallback = std::function<DigestSet()>;
   using State                 = tx_sync::State;
   using StateMachine          = core::StateMachine<State>;
   using LaneControllerPtr     = std::shared_ptr<LaneController>;
@@ -90,6 +93,7 @@ public:
   static constexpr std::size_t MAX_OBJECT_COUNT_RESOLUTION_PER_CYCLE = 128;
   static constexpr std::size_t MAX_SUBTREE_RESOLUTION_PER_CYCLE      = 128;
   static constexpr std::size_t MAX_OBJECT_RESOLUTION_PER_CYCLE       = 128;
+  static constexpr std::size_t MAX_RECENT_DIFFERENCE                 = 1000;
   // Limit the amount to be retrieved at once from the TxFinderProtocol
   static constexpr uint64_t TX_FINDER_PROTO_LIMIT = 1000;
   // Limit the amount a single rpc call will provide
@@ -107,7 +111,8 @@ public:
   TransactionStoreSyncService(Config const &cfg, MuddleEndpoint &muddle,
                               TransactionStorageEngineInterface &store,
                               TxFinderProtocol *                 tx_finder_protocol,
-                              TrimCacheCallback                  trim_cache_callback);
+                              TrimCacheCallback                  trim_cache_callback,
+                              RecentDigestsCallback              recent_digests_callback);
   ~TransactionStoreSyncService() override = default;
 
   void Start()
@@ -147,11 +152,19 @@ private:
   State OnResolvingObjects();
   State OnTrimCache();
 
+  template <typename... Args>
+  PromiseOfTxList PullTxList(Address const &peer, Client::FunctionId function,
+                             Client::FunctionId compressed_function, Args const &... args);
+  PromiseOfTxList PullRecentTxList(Address const &peer, InvertibleBloomLookupTable const &recent);
+
   TrimCacheCallback                  trim_cache_callback_;
+  RecentDigestsCallback              recent_digests_callback_;
   std::shared_ptr<StateMachine>      state_machine_;
   TxFinderProtocol *                 tx_finder_protocol_;
   Config const                       cfg_;
   MuddleEndpoint &                   muddle_;
+  RpcCompressionNegotiator           compression_;
+  RpcSupportTracker                  delta_support_;
   ClientPtr                          client_;
   TransactionStorageEngineInterface &store_;  ///< The pointer to the object store
   TransactionVerifier                verifier_;
@@ -164,6 +177,7 @@ private:
 
   RequestingSubTreeList pending_subtree_;
   RequestingTxList      pending_objects_;
+  std::size_t           recent_difference_{0};  ///< The last observed recent tx set difference
 
   std::queue<uint64_t>                                          roots_to_sync_;
   uint64_t                                                      root_size_ = 0;
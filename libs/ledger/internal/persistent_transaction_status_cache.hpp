@@ -17,13 +17,27 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/digest.hpp"
 #include "core/mutex.hpp"
 #include "ledger/transaction_status_cache.hpp"
 #include "storage/object_store.hpp"
 
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <thread>
+
 namespace fetch {
 namespace ledger {
 
+/**
+ * Transaction status cache which is backed by an object store on disk.
+ *
+ * Updates are not written to the store immediately. Instead they are buffered in memory and
+ * written in batches by a background thread, either periodically or as soon as enough updates have
+ * accumulated. Queries are served from the buffered updates first, and only fall back to the store
+ * when the transaction has no outstanding updates.
+ */
 class PersistentTransactionStatusCache : public TransactionStatusInterface
 {
 public:
@@ -37,7 +51,7 @@ public:
   explicit PersistentTransactionStatusCache(Mode mode);
   PersistentTransactionStatusCache(PersistentTransactionStatusCache const &) = delete;
   PersistentTransactionStatusCache(PersistentTransactionStatusCache &&)      = delete;
-  ~PersistentTransactionStatusCache() override                               = default;
+  ~PersistentTransactionStatusCache() override;
 
   /// @name Transaction Status Interface
   /// @{
@@ -46,19 +60,39 @@ public:
   void     Update(Digest digest, ContractExecutionResult exec_result) override;
   /// @}
 
+  void Flush();
+
   // Operators
   PersistentTransactionStatusCache &operator=(PersistentTransactionStatusCache const &) = delete;
   PersistentTransactionStatusCache &operator=(PersistentTransactionStatusCache &&) = delete;
 
 private:
-  using Mutex = fetch::Mutex;
-  using Store = storage::ObjectStore<TxStatus>;
+  struct PendingUpdate
+  {
+    TxStatus status{};
+    bool     has_exec_result{false};  ///< Flag to signal the execution result has been set
+  };
+
+  using Mutex      = fetch::Mutex;
+  using Store      = storage::ObjectStore<TxStatus>;
+  using PendingMap = DigestMap<PendingUpdate>;
+  using Condition  = std::condition_variable_any;
+  using ThreadPtr  = std::unique_ptr<std::thread>;
+  using Flag       = std::atomic<bool>;
 
-  TxStatus LookupStatus(Digest const &digest) const;
-  void     UpdateStatus(Digest const &digest, TxStatus const &status);
+  PendingUpdate &LookupPendingUpdate(Digest const &digest);
+  TxStatus       LookupStatus(Digest const &digest) const;
+  void           WriteBatch(PendingMap const &batch);
+  void           ThreadEntryPoint();
 
-  mutable Mutex lock_;
+  mutable Mutex lock_;               ///< Guards the pending and in flight updates
+  Condition     flush_wake_;         ///< Signals the flush thread
+  PendingMap    pending_updates_{};  ///< The updates still to be written
+  PendingMap    in_flight_updates_{};  ///< The updates currently being written
+  mutable Mutex store_lock_;         ///< Guards the store and serialises the writers
   mutable Store store_;
+  Flag          running_{true};
+  ThreadPtr     flush_thread_;
 };
 
 }  // namespace ledger
@@ -41,6 +41,7 @@
 #include "telemetry/histogram.hpp"
 #include "telemetry/registry.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <cstddef>
@@ -178,6 +179,18 @@ BlockCoordinator::BlockCoordinator(MainChain &chain, DAGPtr dag,
   , panic_search_total_{telemetry::Registry::Instance().CreateCounter(
         "ledger_block_coordinator_panic_search_total",
         "The total number of times that the main chain has been searched for a block")}
+  , lookahead_block_total_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_block_coordinator_lookahead_block_total",
+        "The total number of blocks which have been added to the lookahead window")}
+  , lookahead_hit_total_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_block_coordinator_lookahead_hit_total",
+        "The total number of blocks which were prepared in the lookahead window")}
+  , lookahead_rollback_total_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_block_coordinator_lookahead_rollback_total",
+        "The total number of times the lookahead window has been discarded")}
+  , lookahead_request_tx_total_{telemetry::Registry::Instance().CreateCounter(
+        "ledger_block_coordinator_lookahead_request_tx_total",
+        "The total number of requests for transactions made for the lookahead window")}
   , tx_sync_times_{telemetry::Registry::Instance().CreateHistogram(
         {0.001, 0.01, 0.1, 1, 10, 100}, "ledger_block_coordinator_tx_sync_times",
         "The histogram of the time it takes to sync transactions")}
@@ -731,8 +744,9 @@ BlockCoordinator::State BlockCoordinator::OnWaitForTransactions(State current, S
     dag_is_ready = dag_->SatisfyEpoch(current_block_->dag_epoch);
   }
 
-  // if the transaction digests have not been cached then do this now
-  if (!pending_txs_)
+  // if the transaction digests have not been cached then do this now (unless they have already
+  // been evaluated as part of the lookahead)
+  if (!pending_txs_ && !ConsumeLookahead())
   {
     pending_txs_ = std::make_unique<DigestSet>();
 
@@ -787,6 +801,9 @@ BlockCoordinator::State BlockCoordinator::OnWaitForTransactions(State current, S
     FETCH_LOG_INFO(LOGGING_NAME, "Waiting for DAG to sync");
   }
 
+  // while waiting make progress on the upcoming blocks
+  AdvanceLookahead();
+
   // signal the next execution of the state machine should be much later in the future
   state_machine_->Delay(std::chrono::milliseconds{200});
 
@@ -811,6 +828,7 @@ void BlockCoordinator::RemoveBlock(BlockPtrType &block)
   }
 
   blocks_to_common_ancestor_.clear();
+  ResetLookahead();
 }
 
 bool BlockCoordinator::RevertToBlock(Block const &block)
@@ -924,11 +942,182 @@ void BlockCoordinator::Panic()
     execution_manager_.SetLastProcessedBlock(genesis_digest);
   }
 
+  // the lookahead no longer relates to the reverted state
+  ResetLookahead();
+
   // delay the state machine in these error cases, to allow the network to catch up if the issue
   // is network related and if nothing else restrict logs being spammed
   state_machine_->Delay(std::chrono::seconds{5});
 }
 
+/**
+ * Construct a lookahead entry for an upcoming block
+ *
+ * @param b The upcoming block
+ */
+BlockCoordinator::LookaheadBlock::LookaheadBlock(BlockPtr b)
+  : block{std::move(b)}
+{
+  for (auto const &slice : block->slices)
+  {
+    for (auto const &tx : slice)
+    {
+      unchecked_txs.insert(tx.digest());
+    }
+  }
+}
+
+/**
+ * Make progress on the blocks which follow the current block. The lookahead window is validated and
+ * extended with the next blocks on the path being synchronised. The transactions for these blocks
+ * are then checked (subject to a per cycle limit) and requested from peers if they are missing.
+ */
+void BlockCoordinator::AdvanceLookahead()
+{
+  if ((pipeline_depth_ == 0) || !current_block_)
+  {
+    return;
+  }
+
+  // ensure the window still extends the current block, if this is no longer the case (typically
+  // because of a fork switch) then it is discarded
+  Digest parent = current_block_->hash;
+  for (auto const &entry : lookahead_)
+  {
+    if (entry.block->previous_hash != parent)
+    {
+      ResetLookahead();
+      break;
+    }
+
+    parent = entry.block->hash;
+  }
+
+  // extend the window with the next blocks on the path being synchronised
+  while (lookahead_.size() < pipeline_depth_)
+  {
+    Block const &tail = lookahead_.empty() ? *current_block_ : *lookahead_.back().block;
+
+    auto next = LookupUpcomingBlock(tail);
+    if (!next)
+    {
+      break;
+    }
+
+    lookahead_.emplace_back(std::move(next));
+    lookahead_block_total_->increment();
+  }
+
+  // check the transactions for the upcoming blocks in order
+  std::size_t num_checks{0};
+  for (auto &entry : lookahead_)
+  {
+    auto it = entry.unchecked_txs.begin();
+    while ((it != entry.unchecked_txs.end()) && (num_checks < MAX_LOOKAHEAD_TX_CHECKS))
+    {
+      if (!storage_unit_.HasTransaction(*it))
+      {
+        entry.missing_txs.insert(*it);
+      }
+
+      it = entry.unchecked_txs.erase(it);
+      ++num_checks;
+    }
+
+    // stop once the budget for this cycle has been exhausted
+    if (!entry.unchecked_txs.empty())
+    {
+      break;
+    }
+
+    if (!entry.missing_txs.empty() && !entry.requested_missing_txs)
+    {
+      FETCH_LOG_INFO(LOGGING_NAME, "Lookahead: Calling IssueCallForMissingTxs for ",
+                     entry.missing_txs.size(), " TXs (for block: ", entry.block->block_number,
+                     ", current block: ", current_block_->block_number, ")");
+
+      storage_unit_.IssueCallForMissingTxs(entry.missing_txs);
+      entry.requested_missing_txs = true;
+      lookahead_request_tx_total_->increment();
+    }
+  }
+}
+
+/**
+ * Discard the lookahead window
+ */
+void BlockCoordinator::ResetLookahead()
+{
+  if (!lookahead_.empty())
+  {
+    lookahead_.clear();
+    lookahead_rollback_total_->increment();
+  }
+}
+
+/**
+ * Lookup the block which follows the specified block on the path currently being synchronised
+ *
+ * @param block The block whose successor is requested
+ * @return The following block if available, otherwise a null pointer
+ */
+BlockPtr BlockCoordinator::LookupUpcomingBlock(Block const &block) const
+{
+  // the path is ordered from the heaviest block back to the block currently being executed so
+  // the successors are found towards the back
+  std::size_t const path_length = blocks_to_common_ancestor_.size();
+  std::size_t const limit       = std::min(path_length, pipeline_depth_ + 2);
+
+  for (std::size_t i = 1; i <= limit; ++i)
+  {
+    auto const &candidate = blocks_to_common_ancestor_[path_length - i];
+
+    if (candidate->previous_hash == block.hash)
+    {
+      return candidate;
+    }
+  }
+
+  return {};
+}
+
+/**
+ * Populate the pending transactions for the current block from the lookahead window
+ *
+ * @return true if the current block was present in the lookahead window, otherwise false
+ */
+bool BlockCoordinator::ConsumeLookahead()
+{
+  if (lookahead_.empty())
+  {
+    return false;
+  }
+
+  // the window is expected to begin with the current block, anything else is out of date
+  if (lookahead_.front().block->hash != current_block_->hash)
+  {
+    ResetLookahead();
+    return false;
+  }
+
+  auto &entry = lookahead_.front();
+
+  pending_txs_ = std::make_unique<DigestSet>(std::move(entry.unchecked_txs));
+  pending_txs_->insert(entry.missing_txs.begin(), entry.missing_txs.end());
+
+  // carry over the fact that the missing transactions have already been requested
+  if (entry.requested_missing_txs)
+  {
+    have_asked_for_missing_txs_ = true;
+    wait_for_tx_timeout_.Restart(WAIT_FOR_TX_TIMEOUT_INTERVAL);
+  }
+
+  lookahead_.pop_front();
+  lookahead_hit_total_->increment();
+
+  return true;
+}
+
 BlockCoordinator::State BlockCoordinator::OnScheduleBlockExecution()
 {
   MilliTimer const timer{"OnScheduleBlockExecution ", 1000};
@@ -971,6 +1160,9 @@ BlockCoordinator::State BlockCoordinator::OnWaitForExecution()
                      current_block_->hash.ToHex());
     }
 
+    // while the execution is in progress make progress on the upcoming blocks
+    AdvanceLookahead();
+
     // signal that the next execution should not happen immediately
     state_machine_->Delay(std::chrono::milliseconds{20});
     break;
@@ -60,6 +60,7 @@ ExecutionManager::ExecutionManager(std::size_t num_executors, uint32_t log2_num_
   : log2_num_lanes_{log2_num_lanes}
   , storage_{std::move(storage)}
   , thread_pool_{network::MakeThreadPool(num_executors, "Executor")}
+  , prefetch_pool_{network::MakeThreadPool(num_executors, "ExecPrefetch")}
   , tx_status_cache_{std::move(tx_status_cache)}
   , tx_executed_count_(Registry::Instance().CreateCounter(
         "ledger_exec_mgr_tx_executed_total", "The total number of executed transactions"))
@@ -69,6 +70,12 @@ ExecutionManager::ExecutionManager(std::size_t num_executors, uint32_t log2_num_
         "ledger_exec_mgr_fees_settled_total", "The total number of settle fees rounds"))
   , blocks_completed_count_(Registry::Instance().CreateCounter(
         "ledger_exec_mgr_blocks_completed_total", "The total number of settle fees rounds"))
+  , tx_prefetched_count_(Registry::Instance().CreateCounter(
+        "ledger_exec_mgr_tx_prefetched_total",
+        "The total number of transactions retrieved ahead of execution"))
+  , tx_prefetch_miss_count_(Registry::Instance().CreateCounter(
+        "ledger_exec_mgr_tx_prefetch_miss_total",
+        "The total number of transactions which were not available ahead of execution"))
   , execution_duration_(Registry::Instance().CreateHistogram(
         {0.000001, 0.000002, 0.000003, 0.000004, 0.000005, 0.000006, 0.000007, 0.000008, 0.000009,
          0.00001,  0.00002,  0.00003,  0.00004,  0.00005,  0.00006,  0.00007,  0.00008,  0.00009,
@@ -91,6 +98,13 @@ ExecutionManager::ExecutionManager(std::size_t num_executors, uint32_t log2_num_
        0.001,    0.01,     0.1,      1,        10.,      100.},
       "ledger_executor_tx_retrieve_duration",
       "The execution duration in seconds for retrieving the transaction");
+  Registry::Instance().CreateHistogram(
+      {0.000001, 0.000002, 0.000003, 0.000004, 0.000005, 0.000006, 0.000007, 0.000008, 0.000009,
+       0.00001,  0.00002,  0.00003,  0.00004,  0.00005,  0.00006,  0.00007,  0.00008,  0.00009,
+       0.0001,   0.0002,   0.0003,   0.0004,   0.0005,   0.0006,   0.0007,   0.0008,   0.0009,
+       0.001,    0.01,     0.1,      1,        10.,      100.},
+      "ledger_executor_state_prefetch_duration",
+      "The execution duration in seconds for prefetching the state of the transaction");
   Registry::Instance().CreateHistogram(
       {0.000001, 0.000002, 0.000003, 0.000004, 0.000005, 0.000006, 0.000007, 0.000008, 0.000009,
        0.00001,  0.00002,  0.00003,  0.00004,  0.00005,  0.00006,  0.00007,  0.00008,  0.00009,
@@ -183,6 +197,9 @@ ExecutionManager::ScheduleStatus ExecutionManager::Execute(Block const &block)
   });
   num_slices_ = block.slices.size();
 
+  // start retrieving the transactions for the block in the background
+  SchedulePrefetch();
+
   // trigger the monitor / dispatch thread
   {
     FETCH_LOCK(monitor_lock_);
@@ -221,7 +238,7 @@ bool ExecutionManager::PlanExecution(Block const &block)
 
       // insert the item into the execution plan
       slice_plan.emplace_back(
-          std::make_unique<ExecutionItem>(tx.digest(), block.block_number, slice_index, tx.mask()));
+          std::make_shared<ExecutionItem>(tx.digest(), block.block_number, slice_index, tx.mask()));
     }
 
     ++slice_index;
@@ -230,6 +247,53 @@ bool ExecutionManager::PlanExecution(Block const &block)
   return true;
 }
 
+/**
+ * Schedule the retrieval of all the transactions in the current execution plan. The transactions
+ * are requested in slice order so that the executors find them already available when each of the
+ * slices is dispatched.
+ */
+void ExecutionManager::SchedulePrefetch()
+{
+  FETCH_LOCK(execution_plan_lock_);
+
+  auto self = shared_from_this();
+  for (auto const &slice_plan : execution_plan_)
+  {
+    for (auto const &item : slice_plan)
+    {
+      std::weak_ptr<ExecutionItem> weak_item{item};
+
+      prefetch_pool_->Post([self, weak_item]() {
+        // the item will have expired if a new block has been scheduled in the meantime
+        auto item = weak_item.lock();
+        if (item)
+        {
+          self->PrefetchExecution(*item);
+        }
+      });
+    }
+  }
+}
+
+/**
+ * Retrieve the transaction for an execution item ahead of its execution
+ *
+ * This function should be called from a context of the prefetch thread pool
+ *
+ * @param item The execution item to prefetch
+ */
+void ExecutionManager::PrefetchExecution(ExecutionItem &item)
+{
+  if (item.Prefetch(*storage_))
+  {
+    tx_prefetched_count_->increment();
+  }
+  else
+  {
+    tx_prefetch_miss_count_->increment();
+  }
+}
+
 /**
  * Dispatches an execution item to the next available executor
  *
@@ -316,8 +380,9 @@ void ExecutionManager::Start()
     throw std::runtime_error("Failed waiting for the monitor to start");
   }
 
-  // fire up the main worker thread pool
+  // fire up the main worker and prefetch thread pools
   thread_pool_->Start();
+  prefetch_pool_->Start();
 }
 
 /**
@@ -342,7 +407,8 @@ void ExecutionManager::Stop()
     monitor_thread_.reset();
   }
 
-  // tear down the thread pool
+  // tear down the thread pools
+  prefetch_pool_->Stop();
   thread_pool_->Stop();
 }
 
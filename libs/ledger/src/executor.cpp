@@ -27,6 +27,7 @@
 #include "ledger/consensus/stake_update_interface.hpp"
 #include "ledger/executor.hpp"
 #include "ledger/fees/storage_fee.hpp"
+#include "ledger/state_adapter.hpp"
 #include "ledger/state_sentinel_adapter.hpp"
 #include "ledger/storage_unit/cached_storage_adapter.hpp"
 #include "telemetry/histogram.hpp"
@@ -60,6 +61,8 @@ Executor::Executor(StorageUnitPtr storage)
         "ledger_executor_overall_duration")}
   , tx_retrieve_duration_{Registry::Instance().LookupMeasurement<Histogram>(
         "ledger_executor_tx_retrieve_duration")}
+  , state_prefetch_duration_{Registry::Instance().LookupMeasurement<Histogram>(
+        "ledger_executor_state_prefetch_duration")}
   , validation_checks_duration_{Registry::Instance().LookupMeasurement<Histogram>(
         "ledger_executor_validation_checks_duration")}
   , contract_execution_duration_{Registry::Instance().LookupMeasurement<Histogram>(
@@ -81,6 +84,24 @@ Executor::Executor(StorageUnitPtr storage)
  */
 Executor::Result Executor::Execute(Digest const &digest, BlockIndex block, SliceIndex slice,
                                    BitVector const &shards)
+{
+  return ExecutePrefetched(digest, TransactionPtr{}, block, slice, shards);
+}
+
+/**
+ * Executes a given transaction across a series of lanes, making use of the transaction if it has
+ * already been retrieved from storage
+ *
+ * @param digest The transaction digest to be executed
+ * @param tx The prefetched transaction (can be null if it was not available)
+ * @param block The current block index
+ * @param slice The current slice index
+ * @param shards The bit vector outlining the shards in use by this transaction
+ * @return The status code for the operation
+ */
+Executor::Result Executor::ExecutePrefetched(Digest const &digest, TransactionPtr const &tx,
+                                             BlockIndex block, SliceIndex slice,
+                                             BitVector const &shards)
 {
   telemetry::FunctionTimer const timer{*overall_duration_};
 
@@ -94,8 +115,19 @@ Executor::Result Executor::Execute(Digest const &digest, BlockIndex block, Slice
   allowed_shards_ = shards;
   log2_num_lanes_ = shards.log2_size();
 
-  // attempt to retrieve the transaction from the storage
-  if (!RetrieveTransaction(digest))
+  // make use of the prefetched transaction if available, otherwise retrieve it from the storage
+  bool tx_available{false};
+  if (tx && (tx->digest() == digest))
+  {
+    current_tx_  = tx;
+    tx_available = true;
+  }
+  else
+  {
+    tx_available = RetrieveTransaction(digest);
+  }
+
+  if (!tx_available)
   {
     // signal that the contract failed to be executed
     result.status = Status::TX_LOOKUP_FAILURE;
@@ -109,6 +141,9 @@ Executor::Result Executor::Execute(Digest const &digest, BlockIndex block, Slice
     // create the storage cache
     storage_cache_ = std::make_shared<CachedStorageAdapter>(*storage_);
 
+    // request the state which is known to be needed in a single round trip to the lanes
+    PrefetchState();
+
     // follow the three step process for executing a transaction
     //
     // 0. Validation checks (does the originator have correct funds)
@@ -201,6 +236,49 @@ bool Executor::RetrieveTransaction(Digest const &digest)
   return success;
 }
 
+/**
+ * Prefetch the state records which the transaction is known to touch into the storage cache. This
+ * consists of the token records of the sender and the recipients of any transfers. Only the records
+ * which fall within the shards of the transaction are requested.
+ */
+void Executor::PrefetchState()
+{
+  telemetry::FunctionTimer const timer{*state_prefetch_duration_};
+
+  StorageInterface::Addresses keys{};
+  keys.reserve(current_tx_->transfers().size() + 1u);
+
+  auto const add_record = [this, &keys](chain::Address const &address) {
+    auto key = StateAdapter::CreateAddress("fetch.token", address.display());
+
+    // only the shards which are declared by the transaction can be accessed
+    if (allowed_shards_.bit(key.lane(log2_num_lanes_)) != 0u)
+    {
+      keys.emplace_back(std::move(key));
+    }
+  };
+
+  add_record(current_tx_->from());
+  for (auto const &transfer : current_tx_->transfers())
+  {
+    add_record(transfer.to);
+  }
+
+  // remove any duplicate records
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+  try
+  {
+    storage_cache_->Prefetch(keys);
+  }
+  catch (std::exception const &ex)
+  {
+    // prefetching is only an optimisation, the state will be looked up on demand
+    FETCH_LOG_WARN(LOGGING_NAME, "Exception caught when prefetching state: ", ex.what());
+  }
+}
+
 bool Executor::ValidationChecks(Result &result)
 {
   telemetry::FunctionTimer const timer{*validation_checks_duration_};
@@ -253,7 +331,8 @@ bool Executor::ExecuteTransactionContract(Result &result)
     }
 
     // create the cache and state sentinel (lock and unlock resources as well as sandbox)
-    StateSentinelAdapter storage_adapter{*storage_cache_, contract_id, allowed_shards_};
+    StateSentinelAdapter storage_adapter{*storage_cache_, contract_id, allowed_shards_,
+                                         address_cache_};
 
     // look up or create the instance of the contract as is needed
     bool const is_token_contract = (contract_id == "fetch.token");
@@ -347,7 +426,8 @@ bool Executor::ProcessTransfers(Result &result)
   if (!current_tx_->transfers().empty())
   {
     // attach the token contract to the storage engine
-    StateSentinelAdapter storage_adapter{*storage_cache_, "fetch.token", allowed_shards_};
+    StateSentinelAdapter storage_adapter{*storage_cache_, "fetch.token", allowed_shards_,
+                                         address_cache_};
 
     auto context = ContractContext::Builder{}
                        .SetTokenContract(&token_contract_)
@@ -19,8 +19,13 @@
 #include "persistent_transaction_status_cache.hpp"
 
 #include "core/serializers/main_serializer.hpp"
+#include "core/set_thread_name.hpp"
 #include "logging/logging.hpp"
 
+#include <chrono>
+#include <cstddef>
+#include <utility>
+
 namespace fetch {
 
 namespace serializers {
@@ -162,7 +167,7 @@ public:
   {
     // read the raw value
     uint8_t raw_enum_value{0};
-    map.ExpectKeyGetValue(EXECUTION_RESULT, raw_enum_value);
+    map.ExpectKeyGetValue(STATUS, raw_enum_value);
 
     // convert the raw value
     auto converted_value = static_cast<StatusEnum>(raw_enum_value);
@@ -189,6 +194,9 @@ namespace {
 
 constexpr char const *LOGGING_NAME = "PersistentTxCache";
 
+constexpr std::size_t               FLUSH_THRESHOLD = 1024;
+constexpr std::chrono::milliseconds FLUSH_INTERVAL{100};
+
 using TxStatus = PersistentTransactionStatusCache::TxStatus;
 
 storage::ResourceID CreateRID(Digest digest)
@@ -216,6 +224,30 @@ PersistentTransactionStatusCache::PersistentTransactionStatusCache(Mode mode)
     store_.Load("tx-status.db", "tx-status.index.db", true);
     break;
   }
+
+  flush_thread_ =
+      std::make_unique<std::thread>(&PersistentTransactionStatusCache::ThreadEntryPoint, this);
+}
+
+/**
+ * Stop the flush thread and write any outstanding updates to disk
+ */
+PersistentTransactionStatusCache::~PersistentTransactionStatusCache()
+{
+  running_ = false;
+
+  {
+    FETCH_LOCK(lock_);
+    flush_wake_.notify_all();
+  }
+
+  if (flush_thread_)
+  {
+    flush_thread_->join();
+    flush_thread_.reset();
+  }
+
+  Flush();
 }
 
 /**
@@ -226,8 +258,54 @@ PersistentTransactionStatusCache::PersistentTransactionStatusCache(Mode mode)
  */
 TxStatus PersistentTransactionStatusCache::Query(Digest digest) const
 {
-  FETCH_LOCK(lock_);
-  return LookupStatus(digest);
+  bool              has_pending_status{false};
+  TransactionStatus pending_status{TransactionStatus::UNKNOWN};
+
+  {
+    FETCH_LOCK(lock_);
+
+    // the most recent updates take precedence
+    for (auto const *updates : {&pending_updates_, &in_flight_updates_})
+    {
+      auto const it = updates->find(digest);
+      if (it == updates->end())
+      {
+        continue;
+      }
+
+      if (it->second.has_exec_result)
+      {
+        TxStatus status{it->second.status};
+
+        if (has_pending_status)
+        {
+          status.status = pending_status;
+        }
+
+        return status;
+      }
+
+      if (!has_pending_status)
+      {
+        has_pending_status = true;
+        pending_status     = it->second.status.status;
+      }
+    }
+  }
+
+  TxStatus status{};
+
+  {
+    FETCH_LOCK(store_lock_);
+    status = LookupStatus(digest);
+  }
+
+  if (has_pending_status)
+  {
+    status.status = pending_status;
+  }
+
+  return status;
 }
 
 /**
@@ -253,14 +331,8 @@ void PersistentTransactionStatusCache::Update(Digest digest, TransactionStatus s
 
   FETCH_LOCK(lock_);
 
-  // lookup the existing (if any status) for this transaction
-  auto retrieved_status = LookupStatus(digest);
-
-  // update the status
-  retrieved_status.status = status;
-
-  // flush the status changes down to disk
-  UpdateStatus(digest, retrieved_status);
+  // update the status, any execution result is merged when the update is written
+  LookupPendingUpdate(digest).status.status = status;
 }
 
 /**
@@ -273,19 +345,70 @@ void PersistentTransactionStatusCache::Update(Digest digest, ContractExecutionRe
 {
   FETCH_LOCK(lock_);
 
-  // lookup the existing (if any status) for this transaction
-  auto retrieved_status = LookupStatus(digest);
+  auto &update = LookupPendingUpdate(digest);
 
   // update the status
-  retrieved_status.status               = TransactionStatus::EXECUTED;
-  retrieved_status.contract_exec_result = exec_result;
+  update.status.status               = TransactionStatus::EXECUTED;
+  update.status.contract_exec_result = std::move(exec_result);
+  update.has_exec_result             = true;
+}
 
-  // flush the status changes down to disk
-  UpdateStatus(digest, retrieved_status);
+/**
+ * Write all of the outstanding updates to disk
+ */
+void PersistentTransactionStatusCache::Flush()
+{
+  // only a single batch can be written at any one time
+  FETCH_LOCK(store_lock_);
+
+  {
+    FETCH_LOCK(lock_);
+
+    if (pending_updates_.empty())
+    {
+      return;
+    }
+
+    std::swap(pending_updates_, in_flight_updates_);
+  }
+
+  WriteBatch(in_flight_updates_);
+
+  {
+    FETCH_LOCK(lock_);
+    in_flight_updates_.clear();
+  }
 }
 
 /**
- * Attempt to lookup a previously stored transaction status from the disk
+ * Lookup (creating if necessary) the pending update for a transaction. Must be called with the
+ * lock held.
+ *
+ * @param digest The digest of the transaction
+ * @return The reference to the pending update
+ */
+PersistentTransactionStatusCache::PendingUpdate &
+PersistentTransactionStatusCache::LookupPendingUpdate(Digest const &digest)
+{
+  auto it = pending_updates_.find(digest);
+
+  if (it == pending_updates_.end())
+  {
+    it = pending_updates_.emplace(digest, PendingUpdate{}).first;
+
+    // wake the flush thread early when enough updates have been accumulated
+    if (pending_updates_.size() >= FLUSH_THRESHOLD)
+    {
+      flush_wake_.notify_one();
+    }
+  }
+
+  return it->second;
+}
+
+/**
+ * Attempt to lookup a previously stored transaction status from the disk. Must be called with the
+ * store lock held.
  *
  * @param digest The digest to lookup
  * @return The returned status, or default if it fails
@@ -308,21 +431,62 @@ TxStatus PersistentTransactionStatusCache::LookupStatus(Digest const &digest) co
 }
 
 /**
- * Update the stored transaction status on disk
+ * Write a batch of updates to disk. Must be called with the store lock held.
  *
- * @param digest The digest of the transaction
- * @param status The status information
+ * @param batch The updates to be written
  */
-void PersistentTransactionStatusCache::UpdateStatus(Digest const &digest, TxStatus const &status)
+void PersistentTransactionStatusCache::WriteBatch(PendingMap const &batch)
 {
-  try
-  {
-    store_.Set(CreateRID(digest), status);
-  }
-  catch (std::exception const &ex)
+  store_.WithLock([this, &batch]() {
+    for (auto const &element : batch)
+    {
+      auto const &digest = element.first;
+      auto const &update = element.second;
+
+      try
+      {
+        auto const rid = CreateRID(digest);
+
+        if (update.has_exec_result)
+        {
+          store_.LocklessSet(rid, update.status);
+        }
+        else
+        {
+          // preserve any previously stored execution result
+          TxStatus status{};
+          store_.LocklessGet(rid, status);
+
+          status.status = update.status.status;
+          store_.LocklessSet(rid, status);
+        }
+      }
+      catch (std::exception const &ex)
+      {
+        FETCH_LOG_WARN(LOGGING_NAME, "Error saving status for tx: 0x", digest.ToHex(), " : ",
+                       ex.what());
+      }
+    }
+  });
+}
+
+/**
+ * The main loop of the flush thread
+ */
+void PersistentTransactionStatusCache::ThreadEntryPoint()
+{
+  SetThreadName("TxStatusFlush");
+
+  while (running_)
   {
-    FETCH_LOG_WARN(LOGGING_NAME, "Error saving status for tx: 0x", digest.ToHex(), " : ",
-                   ex.what());
+    {
+      std::unique_lock<Mutex> lock{lock_};
+      flush_wake_.wait_for(lock, FLUSH_INTERVAL, [this]() {
+        return !running_ || (pending_updates_.size() >= FLUSH_THRESHOLD);
+      });
+    }
+
+    Flush();
   }
 }
 
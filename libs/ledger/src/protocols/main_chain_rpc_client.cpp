@@ -30,7 +30,8 @@ using TraveloguePromise = MainChainRpcClient::TraveloguePromise;
 }  // namespace
 
 MainChainRpcClient::MainChainRpcClient(MuddleEndpoint &endpoint)
-  : rpc_client_{"R:MChain", endpoint, SERVICE_MAIN_CHAIN, CHANNEL_RPC}
+  : compression_{"ledger_main_chain_rpc_time_travel", byte_array::ConstByteArray{}}
+  , rpc_client_{"R:MChain", endpoint, SERVICE_MAIN_CHAIN, CHANNEL_RPC}
 {}
 
 BlocksPromise MainChainRpcClient::GetCommonSubChain(MuddleAddress peer, Digest start,
@@ -44,8 +45,19 @@ BlocksPromise MainChainRpcClient::GetCommonSubChain(MuddleAddress peer, Digest s
 
 TraveloguePromise MainChainRpcClient::TimeTravel(MuddleAddress peer, Digest start)
 {
-  auto promise =
-      rpc_client_.CallSpecificAddress(peer, RPC_MAIN_CHAIN, MainChainProtocol::TIME_TRAVEL, start);
+  // peers which are not able to serve compressed responses are sent the original request
+  if (!compression_.IsSupported(peer))
+  {
+    auto promise = rpc_client_.CallSpecificAddress(peer, RPC_MAIN_CHAIN,
+                                                   MainChainProtocol::TIME_TRAVEL, start);
+
+    return TraveloguePromise{promise};
+  }
+
+  auto promise = rpc_client_.CallSpecificAddressWithDecoder(
+      peer, compression_.CreateDecoder(), RPC_MAIN_CHAIN, MainChainProtocol::TIME_TRAVEL_COMPRESSED,
+      start, compression_.accepted_codecs());
+  compression_.Monitor(peer, promise);
 
   return TraveloguePromise{promise};
 }
@@ -147,7 +147,7 @@ MainChainRpcService::MainChainRpcService(MuddleEndpoint &             endpoint,
                                                 Address                transmitter) {
     telemetry::FunctionTimer timer{*new_block_duration_};
 
-    BlockSerializer serialiser(payload);
+    auto serialiser = BlockSerializer::View(payload);
 
     // deserialize the block
     Block block;
@@ -447,7 +447,7 @@ State MainChainRpcService::OnWaitForBlocks()
   // peer
   healthy_ = true;
   MainChainProtocol::Travelogue log{};
-  if (!current_request_->GetResult(log))
+  if (!current_request_->GetResultView(log))
   {
     // as soon as we get an invalid response from the peer we can simply conclude interacting with
     // them
@@ -0,0 +1,229 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/serializers/main_serializer.hpp"
+#include "ledger/protocols/rpc_compression.hpp"
+#include "logging/logging.hpp"
+#include "network/service/error_codes.hpp"
+#include "telemetry/counter.hpp"
+#include "telemetry/histogram.hpp"
+#include "telemetry/registry.hpp"
+#include "telemetry/utils/timer.hpp"
+
+#include <exception>
+#include <string>
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+using byte_array::ConstByteArray;
+
+using CodecMask = core::CompressionCodecMask;
+using Labels    = RpcResponseCompressor::Labels;
+
+telemetry::HistogramPtr CreateDurationHistogram(std::string const &name,
+                                                std::string const &description,
+                                                Labels const &     labels = Labels{})
+{
+  return telemetry::Registry::Instance().CreateHistogram(
+      {0.000001, 0.000002, 0.000003, 0.000004, 0.000005, 0.000006, 0.000007, 0.000008, 0.000009,
+       0.00001,  0.00002,  0.00003,  0.00004,  0.00005,  0.00006,  0.00007,  0.00008,  0.00009,
+       0.0001,   0.0002,   0.0003,   0.0004,   0.0005,   0.0006,   0.0007,   0.0008,   0.0009,
+       0.001,    0.01,     0.1,      1,        10.,      100.},
+      name, description, labels);
+}
+
+}  // namespace
+
+RpcResponseCompressor::RpcResponseCompressor(std::string const &prefix, ConstByteArray dictionary,
+                                             Labels const &labels)
+  : dictionary_{std::move(dictionary)}
+  , raw_bytes_total_{telemetry::Registry::Instance().CreateCounter(
+        prefix + "_raw_bytes_total", "The total number of response bytes before compression",
+        labels)}
+  , compressed_bytes_total_{telemetry::Registry::Instance().CreateCounter(
+        prefix + "_compressed_bytes_total", "The total number of response bytes after compression",
+        labels)}
+  , ratios_{telemetry::Registry::Instance().CreateHistogram(
+        {0.05, 0.1, 0.15, 0.2, 0.25, 0.3, 0.35, 0.4, 0.45, 0.5, 0.55, 0.6, 0.65, 0.7, 0.75, 0.8,
+         0.85, 0.9, 0.95, 1.0},
+        prefix + "_compression_ratio", "The histogram of compressed to raw response sizes",
+        labels)}
+  , durations_{CreateDurationHistogram(prefix + "_compression_duration",
+                                       "The histogram of response compression durations", labels)}
+{}
+
+/**
+ * Encode an already serialised response
+ *
+ * @param raw The serialised response
+ * @param accepted The set of codecs the caller is able to decode
+ * @return The encoded payload
+ */
+core::CompressedPayload RpcResponseCompressor::EncodeRaw(ConstByteArray const &raw,
+                                                         CodecMask             accepted)
+{
+  core::CompressedPayload payload{};
+
+  {
+    telemetry::FunctionTimer const timer{*durations_};
+    payload = core::Compress(raw, accepted, dictionary_);
+  }
+
+  raw_bytes_total_->add(raw.size());
+  compressed_bytes_total_->add(payload.data.size());
+
+  if (!raw.empty())
+  {
+    ratios_->Add(static_cast<double>(payload.data.size()) / static_cast<double>(raw.size()));
+  }
+
+  return payload;
+}
+
+RpcSupportTracker::RpcSupportTracker(std::string const &prefix, std::string feature)
+  : feature_{std::move(feature)}
+  , fallback_total_{telemetry::Registry::Instance().CreateCounter(
+        prefix + "_fallback_total", "The total number of peers which could not serve " + feature_)}
+{}
+
+/**
+ * Determine if the call should be made to the specified peer
+ *
+ * @param peer The address of the peer
+ * @return true if the call should be used, otherwise false
+ */
+bool RpcSupportTracker::IsSupported(Address const &peer) const
+{
+  FETCH_LOCK(legacy_peers_->lock);
+  return legacy_peers_->peers.find(peer) == legacy_peers_->peers.end();
+}
+
+/**
+ * Monitor a request to a peer, detecting if the peer is not able to serve it
+ *
+ * @param peer The address of the peer
+ * @param promise The promise for the request
+ */
+void RpcSupportTracker::Monitor(Address const &peer, Promise const &promise)
+{
+  std::weak_ptr<LegacyPeers> weak_legacy_peers = legacy_peers_;
+  auto const                 fallback_total    = fallback_total_;
+  auto const                 feature           = feature_;
+
+  // the callback is dispatched by the promise itself so this can not dangle
+  auto const *raw_promise = promise.get();
+
+  promise->WithHandlers().Catch([weak_legacy_peers, fallback_total, feature, raw_promise, peer]() {
+    if (!raw_promise->HasFailedWith(service::error::MEMBER_NOT_FOUND))
+    {
+      return;
+    }
+
+    auto legacy_peers = weak_legacy_peers.lock();
+    if (legacy_peers)
+    {
+      FETCH_LOCK(legacy_peers->lock);
+      if (legacy_peers->peers.emplace(peer).second)
+      {
+        FETCH_LOG_INFO(LOGGING_NAME, "Peer: ", peer.ToBase64(), " does not support ", feature,
+                       ", falling back");
+        fallback_total->increment();
+      }
+    }
+  });
+}
+
+RpcCompressionNegotiator::RpcCompressionNegotiator(std::string const &prefix,
+                                                   ConstByteArray     dictionary)
+  : dictionary_{std::move(dictionary)}
+  , support_{prefix + "_compression", "compressed responses"}
+  , durations_{CreateDurationHistogram(prefix + "_decompression_duration",
+                                       "The histogram of response decompression durations")}
+{}
+
+/**
+ * Determine if the compressed calls should be made to the specified peer
+ *
+ * @param peer The address of the peer
+ * @return true if the compressed calls should be used, otherwise false
+ */
+bool RpcCompressionNegotiator::IsSupported(Address const &peer) const
+{
+  return support_.IsSupported(peer);
+}
+
+/**
+ * Get the set of codecs that can be decoded by this node
+ *
+ * @return The codec mask
+ */
+CodecMask RpcCompressionNegotiator::accepted_codecs() const
+{
+  return core::SUPPORTED_COMPRESSION_CODECS;
+}
+
+/**
+ * Create a promise decoder which converts the compressed payload back into the original serialised
+ * response
+ *
+ * @return The decoder
+ */
+RpcCompressionNegotiator::Decoder RpcCompressionNegotiator::CreateDecoder() const
+{
+  auto const dictionary = dictionary_;
+  auto const durations  = durations_;
+
+  return [dictionary, durations](ConstByteArray const &encoded, ConstByteArray &decoded) {
+    telemetry::FunctionTimer const timer{*durations};
+
+    bool success{false};
+
+    try
+    {
+      core::CompressedPayload payload{};
+
+      auto serializer = serializers::MsgPackSerializer::View(encoded);
+      serializer >> payload;
+
+      success = core::Decompress(payload, decoded, dictionary);
+    }
+    catch (std::exception const &ex)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Unable to decode compressed response: ", ex.what());
+    }
+
+    return success;
+  };
+}
+
+/**
+ * Monitor a compressed request to a peer, detecting if the peer is not able to serve it
+ *
+ * @param peer The address of the peer
+ * @param promise The promise for the compressed request
+ */
+void RpcCompressionNegotiator::Monitor(Address const &peer, Promise const &promise)
+{
+  support_.Monitor(peer, promise);
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -0,0 +1,94 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/resource_address_cache.hpp"
+#include "ledger/state_adapter.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace fetch {
+namespace ledger {
+
+/**
+ * Construct a resource address cache
+ *
+ * @param max_entries The maximum number of addresses to be cached
+ */
+ResourceAddressCache::ResourceAddressCache(std::size_t max_entries)
+  : max_entries_{max_entries}
+{}
+
+/**
+ * Lookup (generating if necessary) the resource address for a scoped state key
+ *
+ * @param scope The contract context for the state variable
+ * @param key The state key
+ * @return The resource address, valid until the next call to Lookup or Clear
+ */
+ResourceAddressCache::ResourceAddress const &ResourceAddressCache::Lookup(
+    ConstByteArray const &scope, std::string const &key)
+{
+  auto scope_it = scopes_.find(scope);
+  if (scope_it != scopes_.end())
+  {
+    auto key_it = scope_it->second.find(key);
+    if (key_it != scope_it->second.end())
+    {
+      return key_it->second;
+    }
+  }
+
+  // make space for the new entry if required
+  if (num_entries_ >= max_entries_)
+  {
+    Clear();
+    scope_it = scopes_.end();
+  }
+
+  if (scope_it == scopes_.end())
+  {
+    scope_it = scopes_.emplace(scope, KeyMap{}).first;
+  }
+
+  ++num_entries_;
+
+  return scope_it->second.emplace(key, StateAdapter::CreateAddress(scope, key)).first->second;
+}
+
+/**
+ * Remove all the cached addresses
+ */
+void ResourceAddressCache::Clear()
+{
+  scopes_.clear();
+  num_entries_ = 0;
+}
+
+/**
+ * Get the number of cached addresses
+ *
+ * @return The number of addresses
+ */
+std::size_t ResourceAddressCache::size() const
+{
+  return num_entries_;
+}
+
+}  // namespace ledger
+}  // namespace fetch
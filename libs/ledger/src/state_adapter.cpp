@@ -42,10 +42,24 @@ StateAdapter::StateAdapter(StorageInterface &storage, ConstByteArray scope)
   : StateAdapter(storage, std::move(scope), Mode::READ_ONLY)
 {}
 
-StateAdapter::StateAdapter(StorageInterface &storage, ConstByteArray scope, Mode mode)
+/**
+ * Constructs a state adapter from a storage interface and a scope, using an external address cache
+ *
+ * @param storage The reference to the storage engine
+ * @param scope The reference to the scope
+ * @param cache The address cache to be used
+ */
+StateAdapter::StateAdapter(StorageInterface &storage, ConstByteArray scope,
+                           ResourceAddressCache &cache)
+  : StateAdapter(storage, std::move(scope), Mode::READ_ONLY, &cache)
+{}
+
+StateAdapter::StateAdapter(StorageInterface &storage, ConstByteArray scope, Mode mode,
+                           ResourceAddressCache *cache)
   : storage_{storage}
   , scope_{std::move(scope)}
   , mode_{mode}
+  , address_cache_{cache}
 {}
 
 /**
@@ -64,7 +78,7 @@ StateAdapter::Status StateAdapter::Read(std::string const &key, void *data, uint
   Status status{Status::ERROR};
 
   // make the request to the storage engine
-  auto const result = storage_.Get(CreateAddress(CurrentScope(), key));
+  auto const result = storage_.Get(LookupAddress(key));
 
   // ensure the check was not found
   if (!result.failed)
@@ -90,6 +104,30 @@ StateAdapter::Status StateAdapter::Read(std::string const &key, void *data, uint
   return status;
 }
 
+/**
+ * Read a value from the state store, sharing the buffer returned by the storage engine
+ *
+ * @param key The key to be accessed
+ * @param data The buffer to be populated with the value
+ * @return OK if the read was successful, PERMISSION_DENIED if the key is incorrect, otherwise ERROR
+ */
+StateAdapter::Status StateAdapter::ReadBuffer(std::string const &key, ConstByteArray &data)
+{
+  FETCH_LOG_DEBUG(LOGGING_NAME, "Read: ", key);
+
+  // make the request to the storage engine
+  auto const result = storage_.Get(LookupAddress(key));
+
+  if (result.failed)
+  {
+    return Status::ERROR;
+  }
+
+  data = result.document;
+
+  return Status::OK;
+}
+
 /**
  * Write a value to the state store
  *
@@ -112,7 +150,7 @@ StateAdapter::Status StateAdapter::Write(std::string const &key, void const *dat
   auto write_val = ConstByteArray{reinterpret_cast<uint8_t const *>(data), size};
 
   // set the value on the storage engine
-  storage_.Set(CreateAddress(CurrentScope(), key), write_val);
+  storage_.Set(LookupAddress(key), write_val);
 
   return Status::OK;
 }
@@ -127,7 +165,7 @@ StateAdapter::Status StateAdapter::Write(std::string const &key, void const *dat
 StateAdapter::Status StateAdapter::Exists(std::string const &key)
 {
   // request the result
-  auto const result = storage_.Get(CreateAddress(CurrentScope(), key));
+  auto const result = storage_.Get(LookupAddress(key));
 
   if (result.failed)
   {
@@ -161,10 +199,28 @@ void StateAdapter::PopContext()
   scope_.pop_back();
 }
 
-StateAdapter::ConstByteArray StateAdapter::CurrentScope() const
+StateAdapter::ConstByteArray const &StateAdapter::CurrentScope() const
 {
   return scope_.back();
 }
 
+/**
+ * Lookup the resource address for a key in the current scope
+ *
+ * @param key The input key to be converted
+ * @return The resource address for this key, valid until the next lookup
+ */
+storage::ResourceAddress const &StateAdapter::LookupAddress(std::string const &key)
+{
+  if (address_cache_ != nullptr)
+  {
+    return address_cache_->Lookup(CurrentScope(), key);
+  }
+
+  last_address_ = CreateAddress(CurrentScope(), key);
+
+  return last_address_;
+}
+
 }  // namespace ledger
 }  // namespace fetch
@@ -37,7 +37,25 @@ constexpr char const *LOGGING_NAME = "StateSentinelAdapter";
  */
 StateSentinelAdapter::StateSentinelAdapter(StorageInterface &storage, ConstByteArray scope,
                                            BitVector const &shards)
-  : StateAdapter(storage, std::move(scope), Mode::READ_WRITE)
+  : StateSentinelAdapter(storage, std::move(scope), shards, nullptr)
+{}
+
+/**
+ * Constructs a state adapter from a storage interface and a scope, using an external address cache
+ *
+ * @param storage The reference to the storage engine
+ * @param scope The reference to the scope
+ * @param shards The shards which are permitted to be accessed
+ * @param cache The address cache to be used
+ */
+StateSentinelAdapter::StateSentinelAdapter(StorageInterface &storage, ConstByteArray scope,
+                                           BitVector const &shards, ResourceAddressCache &cache)
+  : StateSentinelAdapter(storage, std::move(scope), shards, &cache)
+{}
+
+StateSentinelAdapter::StateSentinelAdapter(StorageInterface &storage, ConstByteArray scope,
+                                           BitVector const &shards, ResourceAddressCache *cache)
+  : StateAdapter(storage, std::move(scope), Mode::READ_WRITE, cache)
   , shards_{shards}
 {
   auto const num_shards = static_cast<uint32_t>(shards_.size());
@@ -93,6 +111,35 @@ StateSentinelAdapter::Status StateSentinelAdapter::Read(std::string const &key,
   return status;
 }
 
+/**
+ * Read a value from the state store into a shared buffer
+ *
+ * @param key The key to be accessed
+ * @param data The buffer to be populated with the value
+ * @return OK if the read was successful, PERMISSION_DENIED if the key is incorrect, otherwise ERROR
+ */
+StateSentinelAdapter::Status StateSentinelAdapter::ReadBuffer(std::string const &key,
+                                                              ConstByteArray &   data)
+{
+  if (!IsAllowedResource(key))
+  {
+    return Status::PERMISSION_DENIED;
+  }
+
+  // proxy the call the the state adapter
+  auto const status = StateAdapter::ReadBuffer(key, data);
+
+  // update the counters
+  if (Status::OK == status)
+  {
+    bytes_read_ += data.size();
+  }
+
+  ++lookups_;
+
+  return status;
+}
+
 /**
  * Write a value to the state store
  *
@@ -108,7 +155,7 @@ StateSentinelAdapter::Status StateSentinelAdapter::Write(std::string const &key,
   if (!IsAllowedResource(key))
   {
     FETCH_LOG_WARN(LOGGING_NAME,
-                   "Unable to write to resource: ", CreateAddress(CurrentScope(), key).address());
+                   "Unable to write to resource: ", LookupAddress(key).address());
     return Status::PERMISSION_DENIED;
   }
 
@@ -152,10 +199,10 @@ StateSentinelAdapter::Status StateSentinelAdapter::Exists(std::string const &key
  *
  * @return: whether it is allowed
  */
-bool StateSentinelAdapter::IsAllowedResource(std::string const &key) const
+bool StateSentinelAdapter::IsAllowedResource(std::string const &key)
 {
-  // build the associated resources address
-  auto const address = CreateAddress(CurrentScope(), key);
+  // lookup the associated resources address
+  auto const &address = LookupAddress(key);
 
   // determine which shard this resource is mapped to
   auto const mapped_shard = address.lane(shards_.log2_size());
@@ -18,7 +18,9 @@
 
 #include "ledger/storage_unit/cached_storage_adapter.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
 
 namespace fetch {
 namespace ledger {
@@ -37,23 +39,73 @@ CachedStorageAdapter::CachedStorageAdapter(StorageInterface &storage)
  */
 CachedStorageAdapter::~CachedStorageAdapter() = default;
 
+/**
+ * Populate the cache with a series of resources which are expected to be accessed in the near
+ * future. The resources which are not already cached are requested from the storage engine in a
+ * single batch.
+ *
+ * @param keys The keys to be prefetched
+ */
+void CachedStorageAdapter::Prefetch(Addresses const &keys)
+{
+  // determine which of the keys are not already present in the cache
+  Addresses missing{};
+  cache_.ApplyVoid([&keys, &missing](auto const &cache) {
+    for (auto const &key : keys)
+    {
+      if (cache.find(key) == cache.end())
+      {
+        missing.emplace_back(key);
+      }
+    }
+  });
+
+  if (missing.empty())
+  {
+    return;
+  }
+
+  // request all the missing resources at once
+  auto const docs = storage_.GetBatch(missing);
+
+  cache_.ApplyVoid([&missing, &docs](auto &cache) {
+    for (std::size_t i = 0, end = std::min(missing.size(), docs.size()); i < end; ++i)
+    {
+      if (!docs[i].failed)
+      {
+        // prefetched values mirror the storage engine and therefore do not need to be flushed
+        cache.emplace(missing[i], CacheEntry{docs[i].document, true});
+      }
+    }
+  });
+}
+
 /**
  * Trigger a flush of the cached entries to the storage engine
  */
 void CachedStorageAdapter::Flush()
 {
   cache_.ApplyVoid([this](auto &cache) {
+    Addresses   keys{};
+    StateValues values{};
+
     for (auto &entry : cache)
     {
       if (!entry.second.flushed)
       {
-        // set the value on the storage engine
-        storage_.Set(entry.first, entry.second.value);
+        keys.emplace_back(entry.first);
+        values.emplace_back(entry.second.value);
 
         // signal the entry as flushed
         entry.second.flushed = true;
       }
     }
+
+    if (!keys.empty())
+    {
+      // set the values on the storage engine
+      storage_.SetBatch(keys, values);
+    }
   });
 }
 
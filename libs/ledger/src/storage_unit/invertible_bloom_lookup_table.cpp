@@ -0,0 +1,364 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "ledger/storage_unit/invertible_bloom_lookup_table.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+using byte_array::ByteArray;
+using byte_array::ConstByteArray;
+
+using IBLT = InvertibleBloomLookupTable;
+
+std::size_t RoundToTableSize(std::size_t num_cells)
+{
+  std::size_t const min_cells  = IBLT::MIN_CELLS;
+  std::size_t const max_cells  = IBLT::MAX_CELLS;
+  std::size_t const num_hashes = IBLT::NUM_HASHES;
+
+  num_cells = std::min(std::max(num_cells, min_cells), max_cells);
+
+  // each hash function indexes its own equally sized partition of the table
+  return ((num_cells + num_hashes - 1) / num_hashes) * num_hashes;
+}
+
+}  // namespace
+
+/**
+ * Construct a table with the specified number of cells
+ *
+ * @param num_cells The requested number of cells (will be rounded into the supported range)
+ */
+InvertibleBloomLookupTable::InvertibleBloomLookupTable(std::size_t num_cells)
+  : cells_(RoundToTableSize(num_cells))
+{}
+
+/**
+ * Determine the number of cells required to reliably decode a given set difference
+ *
+ * @param expected_difference The expected size of the symmetric difference between the sets
+ * @return The number of cells to use
+ */
+std::size_t InvertibleBloomLookupTable::CellsForDifference(std::size_t expected_difference)
+{
+  return RoundToTableSize(expected_difference * 2);
+}
+
+std::size_t InvertibleBloomLookupTable::size() const
+{
+  return cells_.size();
+}
+
+bool InvertibleBloomLookupTable::empty() const
+{
+  return std::all_of(cells_.begin(), cells_.end(), [](Cell const &cell) { return cell.IsEmpty(); });
+}
+
+/**
+ * Add a digest to the table
+ *
+ * @param digest The digest to be added
+ * @return true if successful, otherwise false
+ */
+bool InvertibleBloomLookupTable::Insert(Digest const &digest)
+{
+  if (cells_.empty() || (digest.size() != DIGEST_SIZE))
+  {
+    return false;
+  }
+
+  KeySum key{};
+  std::memcpy(key.data(), digest.pointer(), DIGEST_SIZE);
+
+  return Toggle(key, 1);
+}
+
+/**
+ * Subtract the contents of another table (of the same size) from this one
+ *
+ * @param other The table to subtract
+ * @return true if successful, otherwise false (in which case this table is left unchanged)
+ */
+bool InvertibleBloomLookupTable::Subtract(InvertibleBloomLookupTable const &other)
+{
+  if (other.cells_.size() != cells_.size())
+  {
+    return false;
+  }
+
+  // check every cell before changing any of them, so that a failure leaves the table untouched
+  for (std::size_t i = 0; i < cells_.size(); ++i)
+  {
+    if (!cells_[i].CanToggle(-other.cells_[i].count))
+    {
+      return false;
+    }
+  }
+
+  for (std::size_t i = 0; i < cells_.size(); ++i)
+  {
+    auto const &rhs = other.cells_[i];
+    cells_[i].Toggle(rhs.key_sum, rhs.hash_sum, -rhs.count);
+  }
+
+  return true;
+}
+
+/**
+ * Recover the set difference from a subtracted table
+ *
+ * @param local_only The output set of digests only present in this (the minuend) table
+ * @param remote_only The output set of digests only present in the subtracted table
+ * @return true if the complete difference was recovered, otherwise false (including when the
+ *         table is malformed)
+ */
+bool InvertibleBloomLookupTable::Decode(DigestSet &local_only, DigestSet &remote_only) const
+{
+  InvertibleBloomLookupTable working{*this};
+
+  std::size_t const partition_size = cells_.size() / NUM_HASHES;
+
+  // the tables are supplied by peers, so the peeling must terminate whatever their contents. Every
+  // genuine peel empties a cell, which bounds the number of them by the size of the table.
+  DigestSet peeled{};
+
+  bool progress{true};
+  while (progress)
+  {
+    progress = false;
+
+    for (std::size_t index = 0; index < working.cells_.size(); ++index)
+    {
+      auto const &cell = working.cells_[index];
+      if (!cell.IsPure())
+      {
+        continue;
+      }
+
+      // take a copy since peeling the entry will update this cell
+      KeySum const  key   = cell.key_sum;
+      int32_t const count = cell.count;
+
+      // a genuine entry is only ever found in its own cells
+      if (working.CellIndex(key, index / partition_size) != index)
+      {
+        return false;
+      }
+
+      Digest digest{key.data(), key.size()};
+
+      // a valid table never yields the same entry twice
+      if ((peeled.size() >= cells_.size()) || !peeled.emplace(digest).second)
+      {
+        return false;
+      }
+
+      if (count > 0)
+      {
+        local_only.emplace(std::move(digest));
+      }
+      else
+      {
+        remote_only.emplace(std::move(digest));
+      }
+
+      if (!working.Toggle(key, -count))
+      {
+        return false;
+      }
+      progress = true;
+    }
+  }
+
+  return working.empty();
+}
+
+/**
+ * Generate the compact binary representation of the table
+ *
+ * @return The encoded table
+ */
+ConstByteArray InvertibleBloomLookupTable::ToBytes() const
+{
+  ByteArray buffer;
+  buffer.Resize(cells_.size() * CELL_SIZE);
+
+  uint8_t *out = buffer.pointer();
+  for (auto const &cell : cells_)
+  {
+    std::memcpy(out, &cell.count, sizeof(cell.count));
+    out += sizeof(cell.count);
+    std::memcpy(out, cell.key_sum.data(), cell.key_sum.size());
+    out += cell.key_sum.size();
+    std::memcpy(out, &cell.hash_sum, sizeof(cell.hash_sum));
+    out += sizeof(cell.hash_sum);
+  }
+
+  return {buffer};
+}
+
+/**
+ * Restore the table from its compact binary representation
+ *
+ * @param encoded The encoded table
+ * @return true if successful, otherwise false
+ */
+bool InvertibleBloomLookupTable::FromBytes(ConstByteArray const &encoded)
+{
+  if ((encoded.size() % CELL_SIZE) != 0)
+  {
+    return false;
+  }
+
+  std::size_t const num_cells = encoded.size() / CELL_SIZE;
+  if ((num_cells < MIN_CELLS) || (num_cells > MAX_CELLS) || ((num_cells % NUM_HASHES) != 0))
+  {
+    return false;
+  }
+
+  Cells cells(num_cells);
+
+  uint8_t const *in = encoded.pointer();
+  for (auto &cell : cells)
+  {
+    std::memcpy(&cell.count, in, sizeof(cell.count));
+    in += sizeof(cell.count);
+
+    // the counts are supplied by peers, reject values which arithmetic on them could overflow
+    if ((cell.count > MAX_COUNT) || (cell.count < -MAX_COUNT))
+    {
+      return false;
+    }
+
+    std::memcpy(cell.key_sum.data(), in, cell.key_sum.size());
+    in += cell.key_sum.size();
+    std::memcpy(&cell.hash_sum, in, sizeof(cell.hash_sum));
+    in += sizeof(cell.hash_sum);
+  }
+
+  cells_ = std::move(cells);
+
+  return true;
+}
+
+/**
+ * Add (or remove) a key to each of its cells
+ *
+ * @param key The key
+ * @param delta The change in count for each of the cells
+ * @return true if successful, false if a count would exceed MAX_COUNT (no cells are changed)
+ */
+bool InvertibleBloomLookupTable::Toggle(KeySum const &key, int32_t delta)
+{
+  for (std::size_t i = 0; i < NUM_HASHES; ++i)
+  {
+    if (!cells_[CellIndex(key, i)].CanToggle(delta))
+    {
+      return false;
+    }
+  }
+
+  uint64_t const hash = CheckHash(key);
+
+  for (std::size_t i = 0; i < NUM_HASHES; ++i)
+  {
+    cells_[CellIndex(key, i)].Toggle(key, hash, delta);
+  }
+
+  return true;
+}
+
+/**
+ * Determine the cell for a key in the partition of a given hash function
+ *
+ * Since the keys are cryptographic digests, non-overlapping sections of them are used directly as
+ * the independent hash functions
+ *
+ * @param key The key
+ * @param hash_index The index of the hash function
+ * @return The index of the cell
+ */
+std::size_t InvertibleBloomLookupTable::CellIndex(KeySum const &key, std::size_t hash_index) const
+{
+  std::size_t const partition_size = cells_.size() / NUM_HASHES;
+
+  uint64_t value{0};
+  std::memcpy(&value, key.data() + (hash_index * sizeof(uint64_t)), sizeof(uint64_t));
+
+  return (hash_index * partition_size) + static_cast<std::size_t>(value % partition_size);
+}
+
+/**
+ * Compute the check hash for a key, this is used to detect cells which contain a single key
+ *
+ * @param key The key
+ * @return The check hash
+ */
+uint64_t InvertibleBloomLookupTable::CheckHash(KeySum const &key)
+{
+  // the final section of the key is not used for indexing, mix it to generate the check value
+  uint64_t value{0};
+  std::memcpy(&value, key.data() + (NUM_HASHES * sizeof(uint64_t)), sizeof(uint64_t));
+
+  value ^= value >> 30u;
+  value *= 0xbf58476d1ce4e5b9ull;
+  value ^= value >> 27u;
+  value *= 0x94d049bb133111ebull;
+  value ^= value >> 31u;
+
+  return value;
+}
+
+bool InvertibleBloomLookupTable::Cell::IsEmpty() const
+{
+  return (count == 0) && (hash_sum == 0) &&
+         std::all_of(key_sum.begin(), key_sum.end(), [](uint8_t value) { return value == 0; });
+}
+
+bool InvertibleBloomLookupTable::Cell::IsPure() const
+{
+  return ((count == 1) || (count == -1)) && (hash_sum == CheckHash(key_sum));
+}
+
+bool InvertibleBloomLookupTable::Cell::CanToggle(int32_t delta) const
+{
+  int64_t const updated = static_cast<int64_t>(count) + static_cast<int64_t>(delta);
+
+  return (updated <= MAX_COUNT) && (updated >= -MAX_COUNT);
+}
+
+void InvertibleBloomLookupTable::Cell::Toggle(KeySum const &key, uint64_t hash, int32_t delta)
+{
+  count += delta;
+  hash_sum ^= hash;
+
+  for (std::size_t i = 0; i < key_sum.size(); ++i)
+  {
+    key_sum[i] ^= key[i];
+  }
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -108,7 +108,8 @@ LaneService::LaneService(NetworkManager const &nm, ShardConfig config, Mode mode
 
   tx_sync_service_ = std::make_shared<TransactionStoreSyncService>(
       sync_cfg, external_muddle_->GetEndpoint(), *tx_store_, tx_finder_protocol_.get(),
-      [this]() { tx_sync_protocol_->TrimCache(); });
+      [this]() { tx_sync_protocol_->TrimCache(); },
+      [this]() { return tx_sync_protocol_->GetRecentDigests(); });
 
   tx_store_->SetNewTransactionHandler(
       [this](chain::Transaction const &tx) { tx_sync_protocol_->OnNewTx(tx); });
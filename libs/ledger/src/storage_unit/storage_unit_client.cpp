@@ -336,6 +336,24 @@ bool StorageUnitClient::HashInStack(Hash const &hash, uint64_t index)
   return tree.root() == hash;
 }
 
+/**
+ * Group the indices of a set of keys by the lane to which they belong
+ *
+ * @param keys The keys to be grouped
+ * @return The indices of the keys for each of the lanes
+ */
+StorageUnitClient::LaneKeyIndices StorageUnitClient::GroupByLane(Addresses const &keys) const
+{
+  LaneKeyIndices lane_key_indices(num_lanes());
+
+  for (std::size_t index = 0; index < keys.size(); ++index)
+  {
+    lane_key_indices.at(keys[index].lane(log2_num_lanes_)).push_back(index);
+  }
+
+  return lane_key_indices;
+}
+
 StorageUnitClient::Address const &StorageUnitClient::LookupAddress(ShardIndex shard) const
 {
   return addresses_.at(shard);
@@ -511,6 +529,133 @@ void StorageUnitClient::Set(ResourceAddress const &key, StateValue const &value)
   }
 }
 
+/**
+ * Get a series of documents from the lanes. The keys are grouped by their owning lane and a single
+ * request is made to each of the lanes concurrently.
+ *
+ * @param keys The keys to be accessed
+ * @return The documents in the same order as the requested keys
+ */
+StorageUnitClient::Documents StorageUnitClient::GetBatch(Addresses const &keys) const
+{
+  Documents docs(keys.size());
+
+  auto const lane_key_indices = GroupByLane(keys);
+
+  // dispatch a single request to each of the lanes involved
+  std::vector<std::pair<LaneIndex, service::Promise>> promises;
+  for (LaneIndex lane = 0; lane < lane_key_indices.size(); ++lane)
+  {
+    auto const &key_indices = lane_key_indices[lane];
+
+    if (key_indices.empty())
+    {
+      continue;
+    }
+
+    std::vector<ResourceID> resources{};
+    resources.reserve(key_indices.size());
+    for (auto const index : key_indices)
+    {
+      resources.emplace_back(keys[index].as_resource_id());
+    }
+
+    // make the request to the RPC server
+    auto promise = rpc_client_->CallSpecificAddress(LookupAddress(lane), RPC_STATE,
+                                                    RevertibleDocumentStoreProtocol::GET_BATCH,
+                                                    resources);
+
+    promises.emplace_back(lane, std::move(promise));
+  }
+
+  // collect the responses, restoring the original key order
+  for (auto &element : promises)
+  {
+    auto const &key_indices = lane_key_indices[element.first];
+
+    Documents lane_docs{};
+    if (element.second->GetResult(lane_docs) && (lane_docs.size() == key_indices.size()))
+    {
+      for (std::size_t i = 0; i < key_indices.size(); ++i)
+      {
+        docs[key_indices[i]] = std::move(lane_docs[i]);
+      }
+    }
+    else
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Unable to get batch of documents from lane: ", element.first);
+
+      // signal the failure
+      for (auto const index : key_indices)
+      {
+        docs[index].failed = true;
+      }
+    }
+  }
+
+  return docs;
+}
+
+/**
+ * Set a series of values on the lanes. The keys are grouped by their owning lane and a single
+ * request is made to each of the lanes concurrently.
+ *
+ * @param keys The keys to be updated
+ * @param values The values to be set (in the same order as the keys)
+ */
+void StorageUnitClient::SetBatch(Addresses const &keys, StateValues const &values)
+{
+  if (keys.size() != values.size())
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Mismatched number of keys and values in batch set");
+    return;
+  }
+
+  try
+  {
+    auto const lane_key_indices = GroupByLane(keys);
+
+    // dispatch a single request to each of the lanes involved
+    std::vector<service::Promise> promises;
+    for (LaneIndex lane = 0; lane < lane_key_indices.size(); ++lane)
+    {
+      auto const &key_indices = lane_key_indices[lane];
+
+      if (key_indices.empty())
+      {
+        continue;
+      }
+
+      std::vector<ResourceID>     resources{};
+      std::vector<ConstByteArray> lane_values{};
+      resources.reserve(key_indices.size());
+      lane_values.reserve(key_indices.size());
+      for (auto const index : key_indices)
+      {
+        resources.emplace_back(keys[index].as_resource_id());
+        lane_values.emplace_back(values[index]);
+      }
+
+      // make the request to the RPC server
+      auto promise = rpc_client_->CallSpecificAddress(LookupAddress(lane), RPC_STATE,
+                                                      RevertibleDocumentStoreProtocol::SET_BATCH,
+                                                      resources, lane_values);
+
+      promises.emplace_back(std::move(promise));
+    }
+
+    // wait for all the lanes to respond
+    for (auto &promise : promises)
+    {
+      promise->Wait();
+    }
+  }
+  catch (std::exception const &e)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to call SET_BATCH (store documents), because: ", e.what());
+  }
+}
+
 bool StorageUnitClient::Lock(ShardIndex index)
 {
   bool success{false};
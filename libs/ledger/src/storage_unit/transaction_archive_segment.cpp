@@ -0,0 +1,914 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "chain/transaction_rpc_serializers.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "core/serializers/main_serializer.hpp"
+#include "ledger/storage_unit/transaction_archive_segment.hpp"
+#include "logging/logging.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <utility>
+
+namespace fetch {
+namespace ledger {
+namespace {
+
+constexpr char const *LOGGING_NAME = "TxArchiveSegment";
+
+constexpr uint64_t SEGMENT_MAGIC        = 0x3147455358544646ull;  // "FFTXSEG1"
+constexpr uint32_t MAX_FIELD_SIZE       = 1u << 26u;
+constexpr uint64_t MIN_RECORD_SIZE      = 2u * sizeof(uint32_t);
+constexpr uint64_t MIN_INDEX_ENTRY_SIZE = sizeof(uint32_t) + sizeof(uint64_t);
+
+using TxArray = TransactionArchiveSegment::TxArray;
+
+/**
+ * The segment footer which is stored at the very end of the file
+ */
+struct Footer
+{
+  uint64_t magic{SEGMENT_MAGIC};
+  uint64_t num_records{0};
+  uint64_t index_offset{0};
+  uint64_t num_index_entries{0};
+  uint64_t bloom_offset{0};
+  uint64_t num_bloom_words{0};
+};
+
+/**
+ * Check that the sections described by a footer are consistent with each other and with the size
+ * of the file, so that a corrupt footer can not cause excessive allocations or reads
+ *
+ * @param footer The footer to be checked
+ * @param file_size The size of the segment file in bytes
+ * @return true if the footer is valid, otherwise false
+ */
+bool IsValidFooter(Footer const &footer, uint64_t file_size)
+{
+  if ((footer.magic != SEGMENT_MAGIC) || (file_size < sizeof(Footer)))
+  {
+    return false;
+  }
+
+  uint64_t const footer_offset = file_size - sizeof(Footer);
+
+  if ((footer.index_offset > footer.bloom_offset) || (footer.bloom_offset > footer_offset))
+  {
+    return false;
+  }
+
+  uint64_t const index_bytes = footer.bloom_offset - footer.index_offset;
+  uint64_t const bloom_bytes = footer_offset - footer.bloom_offset;
+  uint64_t const stride      = TransactionArchiveSegment::INDEX_STRIDE;
+  uint64_t const expected_index_entries =
+      (footer.num_records / stride) + (((footer.num_records % stride) != 0) ? 1u : 0u);
+
+  return (footer.num_records <= (footer.index_offset / MIN_RECORD_SIZE)) &&
+         (footer.num_index_entries == expected_index_entries) &&
+         (footer.num_index_entries <= (index_bytes / MIN_INDEX_ENTRY_SIZE)) &&
+         (footer.num_bloom_words != 0) && ((bloom_bytes % sizeof(uint64_t)) == 0) &&
+         ((bloom_bytes / sizeof(uint64_t)) == footer.num_bloom_words);
+}
+
+template <typename T>
+void WriteValue(std::ostream &stream, T const &value)
+{
+  stream.write(reinterpret_cast<char const *>(&value), sizeof(T));
+}
+
+template <typename T>
+bool ReadValue(std::istream &stream, T &value)
+{
+  return static_cast<bool>(stream.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+
+void WriteField(std::ostream &stream, byte_array::ConstByteArray const &field)
+{
+  WriteValue(stream, static_cast<uint32_t>(field.size()));
+  stream.write(field.char_pointer(), static_cast<std::streamsize>(field.size()));
+}
+
+bool ReadField(std::istream &stream, byte_array::ByteArray &field)
+{
+  uint32_t size{0};
+  if (!ReadValue(stream, size) || (size > MAX_FIELD_SIZE))
+  {
+    return false;
+  }
+
+  field.Resize(size);
+  return static_cast<bool>(stream.read(field.char_pointer(), static_cast<std::streamsize>(size)));
+}
+
+bool SkipField(std::istream &stream)
+{
+  uint32_t size{0};
+  if (!ReadValue(stream, size))
+  {
+    return false;
+  }
+
+  return static_cast<bool>(stream.seekg(static_cast<std::streamoff>(size), std::ios::cur));
+}
+
+/**
+ * Flush the contents of a file (or directory) to disk
+ *
+ * @param path The path to be synced
+ * @return true if successful, otherwise false
+ */
+bool SyncPath(std::string const &path)
+{
+  int const fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    return false;
+  }
+
+  bool const success = ::fsync(fd) == 0;
+  ::close(fd);
+
+  return success;
+}
+
+/**
+ * Determine the directory which contains the specified file
+ *
+ * @param filename The filename
+ * @return The path to the parent directory
+ */
+std::string DirectoryOf(std::string const &filename)
+{
+  auto const pos = filename.rfind('/');
+
+  if (pos == std::string::npos)
+  {
+    return ".";
+  }
+
+  return (pos == 0) ? std::string{"/"} : filename.substr(0, pos);
+}
+
+/**
+ * Reverse the order of the bits in a byte. The key value index compares the bits of a key from the
+ * least significant bit of each byte upwards.
+ */
+uint8_t ReverseBits(uint8_t value)
+{
+  value = static_cast<uint8_t>(((value & 0xF0u) >> 4u) | ((value & 0x0Fu) << 4u));
+  value = static_cast<uint8_t>(((value & 0xCCu) >> 2u) | ((value & 0x33u) << 2u));
+  value = static_cast<uint8_t>(((value & 0xAAu) >> 1u) | ((value & 0x55u) << 1u));
+  return value;
+}
+
+/**
+ * Compute the bloom filter bit positions for a digest. Since digests are the output of a
+ * cryptographic hash function their contents are used directly with double hashing.
+ */
+template <typename Visitor>
+bool VisitBloomBits(Digest const &digest, uint64_t num_bits, Visitor &&visitor)
+{
+  if ((digest.size() < 2 * sizeof(uint64_t)) || (num_bits == 0))
+  {
+    return false;
+  }
+
+  uint64_t h1{0};
+  uint64_t h2{0};
+  std::memcpy(&h1, digest.pointer(), sizeof(uint64_t));
+  std::memcpy(&h2, digest.pointer() + sizeof(uint64_t), sizeof(uint64_t));
+  h2 |= 1u;
+
+  for (std::size_t i = 0; i < TransactionArchiveSegment::BLOOM_NUM_HASHES; ++i)
+  {
+    if (!visitor((h1 + (i * h2)) % num_bits))
+    {
+      break;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace
+
+/**
+ * Builds a new segment from records which are appended in digest order
+ */
+class TransactionArchiveSegment::Writer
+{
+public:
+  Writer(std::string filename, uint64_t max_records);
+  Writer(Writer const &) = delete;
+  Writer(Writer &&)      = delete;
+  ~Writer();
+
+  bool Append(Digest const &digest, byte_array::ConstByteArray const &payload);
+  bool Commit();
+
+  Writer &operator=(Writer const &) = delete;
+  Writer &operator=(Writer &&) = delete;
+
+private:
+  std::string   filename_;
+  std::string   tmp_filename_;
+  std::ofstream stream_;
+  Footer        footer_{};
+  Index         index_{};
+  BloomBits     bloom_;
+  bool          committed_{false};
+};
+
+/**
+ * Create a writer for a new segment
+ *
+ * @param filename The filename for the segment
+ * @param max_records The maximum number of records that will be appended, used to size the bloom
+ * filter
+ */
+TransactionArchiveSegment::Writer::Writer(std::string filename, uint64_t max_records)
+  : filename_{std::move(filename)}
+  , tmp_filename_{filename_ + ".tmp"}
+  , stream_{tmp_filename_, std::ios::out | std::ios::binary | std::ios::trunc}
+  , bloom_((std::max<uint64_t>(64u, max_records * BLOOM_BITS_PER_ENTRY) + 63u) / 64u, 0)
+{
+  if (!stream_.is_open())
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Unable to create segment: ", tmp_filename_);
+  }
+
+  index_.reserve((max_records / INDEX_STRIDE) + 1u);
+}
+
+TransactionArchiveSegment::Writer::~Writer()
+{
+  // clean up after an incomplete segment
+  if (!committed_)
+  {
+    stream_.close();
+    std::remove(tmp_filename_.c_str());
+  }
+}
+
+/**
+ * Append a record to the segment. Records must be appended in (strictly increasing) digest order.
+ *
+ * @param digest The digest of the transaction
+ * @param payload The serialised transaction
+ * @return true if successful, otherwise false
+ */
+bool TransactionArchiveSegment::Writer::Append(Digest const &digest,
+                                               byte_array::ConstByteArray const &payload)
+{
+  if ((footer_.num_records % INDEX_STRIDE) == 0)
+  {
+    index_.emplace_back(IndexEntry{digest, static_cast<uint64_t>(stream_.tellp())});
+  }
+
+  VisitBloomBits(digest, bloom_.size() * 64u, [this](uint64_t bit) {
+    bloom_[bit / 64u] |= 1ull << (bit % 64u);
+    return true;
+  });
+
+  WriteField(stream_, digest);
+  WriteField(stream_, payload);
+  ++footer_.num_records;
+
+  return stream_.good();
+}
+
+/**
+ * Complete the segment and move it into place
+ *
+ * @return true if successful, otherwise false
+ */
+bool TransactionArchiveSegment::Writer::Commit()
+{
+  if (!stream_.good())
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to write segment: ", tmp_filename_);
+    return false;
+  }
+
+  // write the sparse index
+  footer_.index_offset      = static_cast<uint64_t>(stream_.tellp());
+  footer_.num_index_entries = index_.size();
+
+  for (auto const &entry : index_)
+  {
+    WriteField(stream_, entry.digest);
+    WriteValue(stream_, entry.offset);
+  }
+
+  // write the bloom filter
+  footer_.bloom_offset    = static_cast<uint64_t>(stream_.tellp());
+  footer_.num_bloom_words = bloom_.size();
+  stream_.write(reinterpret_cast<char const *>(bloom_.data()),
+                static_cast<std::streamsize>(bloom_.size() * sizeof(uint64_t)));
+
+  WriteValue(stream_, footer_);
+  stream_.close();
+
+  if (stream_.fail())
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to write segment: ", tmp_filename_);
+    return false;
+  }
+
+  committed_ = CommitFile(tmp_filename_, filename_);
+
+  return committed_;
+}
+
+/**
+ * Remove the segment file if the segment has been marked as obsolete
+ */
+TransactionArchiveSegment::~TransactionArchiveSegment()
+{
+  if (obsolete_ && !filename_.empty())
+  {
+    std::remove(filename_.c_str());
+  }
+}
+
+/**
+ * Write a new segment containing the specified transactions
+ *
+ * @param filename The filename for the segment
+ * @param txs The transactions to be stored
+ * @return true if successful, otherwise false
+ */
+bool TransactionArchiveSegment::Write(std::string const &filename, TxArray txs)
+{
+  // sort and remove any duplicates
+  std::sort(txs.begin(), txs.end(), [](chain::Transaction const &a, chain::Transaction const &b) {
+    return DigestLess(a.digest(), b.digest());
+  });
+  txs.erase(std::unique(txs.begin(), txs.end(),
+                        [](chain::Transaction const &a, chain::Transaction const &b) {
+                          return a.digest() == b.digest();
+                        }),
+            txs.end());
+
+  try
+  {
+    Writer writer{filename, txs.size()};
+
+    for (auto const &tx : txs)
+    {
+      serializers::MsgPackSerializer buffer;
+      buffer << tx;
+
+      if (!writer.Append(tx.digest(), buffer.data()))
+      {
+        FETCH_LOG_WARN(LOGGING_NAME, "Failed to write segment: ", filename);
+        return false;
+      }
+    }
+
+    return writer.Commit();
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to write segment: ", filename, " : ", ex.what());
+  }
+
+  return false;
+}
+
+/**
+ * Write a new segment containing the transactions of two existing segments. The records of both
+ * segments are streamed in order, so the transactions are not decoded.
+ *
+ * @param filename The filename for the merged segment
+ * @param older The older of the two segments
+ * @param newer The newer of the two segments, whose copy is kept when both contain a transaction
+ * @return true if successful, otherwise false
+ */
+bool TransactionArchiveSegment::Merge(std::string const &filename,
+                                      TransactionArchiveSegment const &older,
+                                      TransactionArchiveSegment const &newer)
+{
+  std::ifstream older_stream{};
+  std::ifstream newer_stream{};
+  if (!older.OpenStream(older_stream, 0) || !newer.OpenStream(newer_stream, 0))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Unable to read segments to merge into: ", filename);
+    return false;
+  }
+
+  Digest                older_digest;
+  Digest                newer_digest;
+  byte_array::ByteArray older_payload;
+  byte_array::ByteArray newer_payload;
+  uint64_t              older_count{0};
+  uint64_t              newer_count{0};
+
+  bool has_older = older.ReadRecord(older_stream, older_digest, older_payload);
+  bool has_newer = newer.ReadRecord(newer_stream, newer_digest, newer_payload);
+
+  Writer writer{filename, older.size() + newer.size()};
+
+  while (has_older || has_newer)
+  {
+    bool success{false};
+
+    if (has_older && (!has_newer || DigestLess(older_digest, newer_digest)))
+    {
+      success   = writer.Append(older_digest, older_payload);
+      has_older = older.ReadRecord(older_stream, older_digest, older_payload);
+      ++older_count;
+    }
+    else
+    {
+      if (has_older && (older_digest == newer_digest))
+      {
+        has_older = older.ReadRecord(older_stream, older_digest, older_payload);
+        ++older_count;
+      }
+
+      success   = writer.Append(newer_digest, newer_payload);
+      has_newer = newer.ReadRecord(newer_stream, newer_digest, newer_payload);
+      ++newer_count;
+    }
+
+    if (!success)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Failed to write segment: ", filename);
+      return false;
+    }
+  }
+
+  // a read error part way through a segment must not silently drop the remaining records
+  if ((older_count != older.size()) || (newer_count != newer.size()))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to read all the records to merge into: ", filename);
+    return false;
+  }
+
+  return writer.Commit();
+}
+
+/**
+ * Durably move a completed file into place. The file is synced before it is renamed and the
+ * directory is synced afterwards, so that after a crash the file is either absent or complete.
+ *
+ * @param tmp_filename The completed (temporary) file
+ * @param filename The final filename
+ * @return true if successful, otherwise false
+ */
+bool TransactionArchiveSegment::CommitFile(std::string const &tmp_filename,
+                                           std::string const &filename)
+{
+  if (!SyncPath(tmp_filename) || (std::rename(tmp_filename.c_str(), filename.c_str()) != 0))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Unable to commit file: ", filename);
+    std::remove(tmp_filename.c_str());
+    return false;
+  }
+
+  if (!SyncPath(DirectoryOf(filename)))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Unable to sync the directory of: ", filename);
+    std::remove(filename.c_str());
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Compare two digests in the bit order of the key value index
+ *
+ * @param a The first digest
+ * @param b The second digest
+ * @return true if a is ordered before b, otherwise false
+ */
+bool TransactionArchiveSegment::DigestLess(Digest const &a, Digest const &b)
+{
+  std::size_t const length = std::min(a.size(), b.size());
+
+  for (std::size_t i = 0; i < length; ++i)
+  {
+    if (a[i] != b[i])
+    {
+      return ReverseBits(a[i]) < ReverseBits(b[i]);
+    }
+  }
+
+  return a.size() < b.size();
+}
+
+/**
+ * Determine if the first bits of a digest match the specified prefix
+ *
+ * @param digest The digest to be checked
+ * @param prefix The prefix to be matched
+ * @param bit_count The number of bits of the prefix to be matched
+ * @return true if there is a match, otherwise false
+ */
+bool TransactionArchiveSegment::MatchesPrefix(Digest const &digest, Digest const &prefix,
+                                              uint64_t bit_count)
+{
+  std::size_t const full_bytes = bit_count / 8u;
+  std::size_t const rem_bits   = bit_count % 8u;
+  std::size_t const required   = full_bytes + ((rem_bits != 0) ? 1u : 0u);
+
+  if ((digest.size() < required) || (prefix.size() < required))
+  {
+    return false;
+  }
+
+  for (std::size_t i = 0; i < full_bytes; ++i)
+  {
+    if (digest[i] != prefix[i])
+    {
+      return false;
+    }
+  }
+
+  if (rem_bits != 0)
+  {
+    auto const mask = static_cast<uint8_t>((1u << rem_bits) - 1u);
+    return ((digest[full_bytes] ^ prefix[full_bytes]) & mask) == 0;
+  }
+
+  return true;
+}
+
+/**
+ * Open an existing segment, loading its sparse index and bloom filter
+ *
+ * @param filename The filename of the segment
+ * @return true if successful, otherwise false
+ */
+bool TransactionArchiveSegment::Open(std::string const &filename)
+{
+  std::ifstream stream{filename, std::ios::in | std::ios::binary};
+  if (!stream.is_open())
+  {
+    return false;
+  }
+
+  stream.seekg(0, std::ios::end);
+  auto const file_size = static_cast<uint64_t>(stream.tellg());
+
+  Footer footer{};
+  if ((file_size < sizeof(Footer)) ||
+      !stream.seekg(static_cast<std::streamoff>(file_size - sizeof(Footer)), std::ios::beg) ||
+      !ReadValue(stream, footer) || !IsValidFooter(footer, file_size))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Invalid segment: ", filename);
+    return false;
+  }
+
+  // load the sparse index
+  Index index{};
+  index.reserve(footer.num_index_entries);
+
+  stream.seekg(static_cast<std::streamoff>(footer.index_offset), std::ios::beg);
+  for (uint64_t i = 0; i < footer.num_index_entries; ++i)
+  {
+    byte_array::ByteArray digest;
+    IndexEntry            entry{};
+
+    if (!ReadField(stream, digest) || !ReadValue(stream, entry.offset) ||
+        (entry.offset >= footer.index_offset) ||
+        (!index.empty() && (entry.offset <= index.back().offset)))
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Corrupt segment index: ", filename);
+      return false;
+    }
+
+    entry.digest = digest;
+    index.emplace_back(std::move(entry));
+  }
+
+  if (static_cast<uint64_t>(stream.tellg()) != footer.bloom_offset)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Corrupt segment index: ", filename);
+    return false;
+  }
+
+  // load the bloom filter
+  BloomBits bloom(footer.num_bloom_words, 0);
+
+  if (!stream.read(reinterpret_cast<char *>(bloom.data()),
+                   static_cast<std::streamsize>(bloom.size() * sizeof(uint64_t))))
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Corrupt segment bloom filter: ", filename);
+    return false;
+  }
+
+  filename_    = filename;
+  num_records_ = footer.num_records;
+  records_end_ = footer.index_offset;
+  index_       = std::move(index);
+  bloom_       = std::move(bloom);
+
+  return true;
+}
+
+/**
+ * Mark the segment as replaced, so that its file is removed once the segment is destroyed
+ */
+void TransactionArchiveSegment::MarkObsolete()
+{
+  obsolete_ = true;
+}
+
+/**
+ * Check to see if the segment contains the specified transaction
+ *
+ * @param digest The digest of the transaction
+ * @return true if present, otherwise false
+ */
+bool TransactionArchiveSegment::Has(Digest const &digest) const
+{
+  if (!MayContain(digest))
+  {
+    return false;
+  }
+
+  std::ifstream stream{};
+  return OpenStream(stream, LocateRecords(digest)) && Seek(stream, digest);
+}
+
+/**
+ * Lookup a transaction from the segment
+ *
+ * @param digest The digest of the transaction
+ * @param tx The output transaction to be populated
+ * @return true if successful, otherwise false
+ */
+bool TransactionArchiveSegment::Get(Digest const &digest, chain::Transaction &tx) const
+{
+  if (!MayContain(digest))
+  {
+    return false;
+  }
+
+  std::ifstream stream{};
+  if (!OpenStream(stream, LocateRecords(digest)) || !Seek(stream, digest))
+  {
+    return false;
+  }
+
+  byte_array::ByteArray payload;
+  if (!ReadField(stream, payload))
+  {
+    return false;
+  }
+
+  try
+  {
+    serializers::MsgPackSerializer buffer{payload};
+    buffer >> tx;
+
+    return true;
+  }
+  catch (std::exception const &ex)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to decode tx: 0x", digest.ToHex(), " : ", ex.what());
+  }
+
+  return false;
+}
+
+/**
+ * Pull the transactions from the segment whose digests begin with the specified prefix
+ *
+ * @param partial_digest The partial digest for the subtree
+ * @param bit_count The bit count of the partial digest for the subtree
+ * @param pull_limit The maximum number of transactions to be retrieved
+ * @param txs The output array of transactions to be appended to
+ * @return The number of transactions which were pulled
+ */
+uint64_t TransactionArchiveSegment::PullSubtree(Digest const &partial_digest, uint64_t bit_count,
+                                                uint64_t pull_limit, TxArray &txs) const
+{
+  // the first digest (in key order) which could be part of the subtree is the prefix with all the
+  // remaining bits cleared
+  byte_array::ByteArray lower_bound = partial_digest.Copy();
+  for (std::size_t i = 0; i < lower_bound.size(); ++i)
+  {
+    uint64_t const first_bit = i * 8u;
+    if (first_bit >= bit_count)
+    {
+      lower_bound[i] = 0;
+    }
+    else if ((bit_count - first_bit) < 8u)
+    {
+      lower_bound[i] &= static_cast<uint8_t>((1u << (bit_count - first_bit)) - 1u);
+    }
+  }
+
+  Digest const start{lower_bound};
+  uint64_t     count{0};
+
+  std::ifstream stream{};
+  if (!OpenStream(stream, LocateRecords(start)))
+  {
+    return count;
+  }
+
+  while (count < pull_limit)
+  {
+    Digest current;
+    if (!ReadDigest(stream, current))
+    {
+      break;
+    }
+
+    if (MatchesPrefix(current, partial_digest, bit_count))
+    {
+      byte_array::ByteArray payload;
+      if (!ReadField(stream, payload))
+      {
+        break;
+      }
+
+      try
+      {
+        chain::Transaction             tx;
+        serializers::MsgPackSerializer buffer{payload};
+        buffer >> tx;
+
+        txs.emplace_back(std::move(tx));
+        ++count;
+      }
+      catch (std::exception const &ex)
+      {
+        FETCH_LOG_WARN(LOGGING_NAME, "Failed to decode tx: 0x", current.ToHex(), " : ", ex.what());
+      }
+    }
+    else if (DigestLess(start, current))
+    {
+      // the records are sorted, so the end of the subtree has been reached
+      break;
+    }
+    else if (!SkipField(stream))
+    {
+      break;
+    }
+  }
+
+  return count;
+}
+
+/**
+ * Get the number of transactions in the segment
+ *
+ * @return The number of transactions
+ */
+uint64_t TransactionArchiveSegment::size() const
+{
+  return num_records_;
+}
+
+/**
+ * Check the bloom filter for the specified digest
+ *
+ * @param digest The digest to be checked
+ * @return false if the digest is definitely not present, otherwise true
+ */
+bool TransactionArchiveSegment::MayContain(Digest const &digest) const
+{
+  bool present{true};
+
+  VisitBloomBits(digest, bloom_.size() * 64u, [this, &present](uint64_t bit) {
+    present = (bloom_[bit / 64u] & (1ull << (bit % 64u))) != 0;
+    return present;
+  });
+
+  return present;
+}
+
+/**
+ * Determine the file offset from which the records should be scanned for the specified digest
+ *
+ * @param digest The digest being searched for
+ * @return The file offset
+ */
+uint64_t TransactionArchiveSegment::LocateRecords(Digest const &digest) const
+{
+  auto it = std::upper_bound(
+      index_.begin(), index_.end(), digest,
+      [](Digest const &value, IndexEntry const &entry) { return DigestLess(value, entry.digest); });
+
+  if (it == index_.begin())
+  {
+    return 0;
+  }
+
+  return std::prev(it)->offset;
+}
+
+/**
+ * Open a new stream on the segment file
+ *
+ * @param stream The stream to be opened
+ * @param offset The file offset at which the stream should be positioned
+ * @return true if successful, otherwise false
+ */
+bool TransactionArchiveSegment::OpenStream(std::ifstream &stream, uint64_t offset) const
+{
+  stream.open(filename_, std::ios::in | std::ios::binary);
+
+  return stream.is_open() &&
+         static_cast<bool>(stream.seekg(static_cast<std::streamoff>(offset), std::ios::beg));
+}
+
+/**
+ * Scan the records (from the current stream position) for the specified digest
+ *
+ * @param stream The stream positioned at the start of a record
+ * @param digest The digest being searched for
+ * @return true if the record was found, in which case the stream is positioned at its payload
+ */
+bool TransactionArchiveSegment::Seek(std::ifstream &stream, Digest const &digest) const
+{
+  for (std::size_t i = 0; i < INDEX_STRIDE; ++i)
+  {
+    Digest current;
+    if (!ReadDigest(stream, current) || DigestLess(digest, current))
+    {
+      break;
+    }
+
+    if (current == digest)
+    {
+      return true;
+    }
+
+    if (!SkipField(stream))
+    {
+      break;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Read the digest of the next record
+ *
+ * @param stream The stream positioned at the start of a record
+ * @param digest The output digest
+ * @return true if successful, otherwise false
+ */
+bool TransactionArchiveSegment::ReadDigest(std::istream &stream, Digest &digest) const
+{
+  if (static_cast<uint64_t>(stream.tellg()) >= records_end_)
+  {
+    return false;
+  }
+
+  byte_array::ByteArray buffer;
+  if (!ReadField(stream, buffer))
+  {
+    return false;
+  }
+
+  digest = buffer;
+  return true;
+}
+
+/**
+ * Read the next complete record
+ *
+ * @param stream The stream positioned at the start of a record
+ * @param digest The output digest
+ * @param payload The output (serialised) transaction
+ * @return true if successful, otherwise false
+ */
+bool TransactionArchiveSegment::ReadRecord(std::istream &stream, Digest &digest,
+                                           byte_array::ByteArray &payload) const
+{
+  return ReadDigest(stream, digest) && ReadField(stream, payload);
+}
+
+}  // namespace ledger
+}  // namespace fetch
@@ -17,8 +17,19 @@
 //------------------------------------------------------------------------------
 
 #include "chain/transaction_rpc_serializers.hpp"
+#include "core/set_thread_name.hpp"
+#include "ledger/storage_unit/transaction_archive_segment.hpp"
 #include "ledger/storage_unit/transaction_store.hpp"
 #include "logging/logging.hpp"
+#include "storage/storage_exception.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
 
 namespace fetch {
 namespace ledger {
@@ -26,7 +37,10 @@ namespace {
 
 constexpr char const *LOGGING_NAME = "TransactionStore";
 
+constexpr uint64_t MANIFEST_MAGIC = 0x314e414d58544646ull;  // "FFTXMAN1"
+
 using fetch::storage::ResourceID;
+using fetch::storage::StorageException;
 
 using TxArray = TransactionStore::TxArray;
 
@@ -35,16 +49,161 @@ ResourceID CreateResourceId(Digest const &digest)
   return ResourceID{digest};
 }
 
+bool FileExists(std::string const &filename)
+{
+  return std::ifstream{filename}.is_open();
+}
+
+template <typename T>
+bool ReadValue(std::istream &stream, T &value)
+{
+  return static_cast<bool>(stream.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+
+template <typename T>
+void WriteValue(std::ostream &stream, T const &value)
+{
+  stream.write(reinterpret_cast<char const *>(&value), sizeof(T));
+}
+
 }  // namespace
 
+/**
+ * Construct the transaction store
+ *
+ * @param segment_size The number of transactions to accumulate before they are archived
+ */
+TransactionStore::TransactionStore(std::size_t segment_size)
+  : segment_size_{std::max<std::size_t>(segment_size, 1u)}
+  , segments_{std::make_shared<Segments>()}
+{
+  archive_thread_ = std::make_unique<std::thread>(&TransactionStore::ThreadEntryPoint, this);
+}
+
+/**
+ * Destruct the transaction store, completing any pending archive
+ */
+TransactionStore::~TransactionStore()
+{
+  running_ = false;
+
+  {
+    FETCH_LOCK(lock_);
+    archive_wake_.notify_all();
+  }
+
+  if (archive_thread_)
+  {
+    archive_thread_->join();
+    archive_thread_.reset();
+  }
+}
+
 void TransactionStore::New(std::string const &doc_file, std::string const &index_file, bool create)
 {
+  WaitForArchive();
+
   archive_.New(doc_file, index_file, create);
+
+  FETCH_LOCK(lock_);
+
+  doc_file_ = doc_file;
+
+  // remove any previous segments
+  SegmentIds ids{};
+  uint64_t   next_id{0};
+  ReadManifest(ids, next_id);
+
+  for (auto const id : ids)
+  {
+    std::remove(SegmentFilename(id).c_str());
+  }
+
+  RemoveUnreferencedSegments(SegmentIds{}, next_id);
+  std::remove(ManifestFilename().c_str());
+
+  // all the previous segment files have been removed so the ids can start again
+  segments_        = std::make_shared<Segments>();
+  next_segment_id_ = 0;
+  num_archived_    = 0;
+  recent_digests_.clear();
 }
 
 void TransactionStore::Load(std::string const &doc_file, std::string const &index_file, bool create)
 {
+  WaitForArchive();
+
   archive_.Load(doc_file, index_file, create);
+
+  {
+    FETCH_LOCK(lock_);
+
+    doc_file_ = doc_file;
+
+    SegmentIds ids{};
+    uint64_t   next_id{0};
+    if (!ReadManifest(ids, next_id))
+    {
+      throw StorageException("Corrupt transaction archive manifest: " + ManifestFilename());
+    }
+
+    // open all the segments listed in the manifest, refusing to start if any of them is missing
+    auto     segments = std::make_shared<Segments>();
+    uint64_t num_archived{0};
+
+    for (auto const id : ids)
+    {
+      auto const filename = SegmentFilename(id);
+      auto       segment  = std::make_shared<TransactionArchiveSegment>();
+
+      if ((id >= next_id) || !segment->Open(filename))
+      {
+        throw StorageException("Unable to open transaction archive segment: " + filename);
+      }
+
+      num_archived += segment->size();
+      segments->emplace_back(Segment{id, std::move(segment)});
+    }
+
+    RemoveUnreferencedSegments(ids, next_id);
+
+    segments_        = std::move(segments);
+    next_segment_id_ = next_id;
+    num_archived_    = num_archived;
+    recent_digests_.clear();
+  }
+
+  // rebuild the list of transactions in the hot store. If the node stopped after writing a segment
+  // but before the hot store was trimmed then the archived transactions are removed here
+  DigestArray hot_digests{};
+  DigestArray archived_digests{};
+
+  auto const segments = GetSegments();
+
+  archive_.WithLock([this, &segments, &hot_digests, &archived_digests]() {
+    for (auto it = archive_.begin(), end = archive_.end(); it != end; ++it)
+    {
+      Digest const digest = it.GetKey().id();
+
+      if (HasInSegments(*segments, digest))
+      {
+        archived_digests.emplace_back(digest);
+      }
+      else
+      {
+        hot_digests.emplace_back(digest);
+      }
+    }
+  });
+
+  for (auto const &digest : archived_digests)
+  {
+    archive_.Erase(CreateResourceId(digest));
+  }
+
+  FETCH_LOCK(lock_);
+  recent_digests_ = std::move(hot_digests);
+  RequestArchive();
 }
 
 /**
@@ -58,9 +217,16 @@ void TransactionStore::Add(chain::Transaction const &tx)
 
   try
   {
-    if (!archive_.Has(rid))
+    // check and record the transaction under one lock, so that concurrent additions of it are
+    // only counted (and archived) once
+    FETCH_LOCK(lock_);
+
+    if (!archive_.Has(rid) && !HasInSegments(*segments_, tx.digest()))
     {
       archive_.Set(rid, tx);
+
+      recent_digests_.emplace_back(tx.digest());
+      RequestArchive();
     }
   }
   catch (std::exception const &ex)
@@ -79,7 +245,7 @@ void TransactionStore::Add(chain::Transaction const &tx)
 bool TransactionStore::Has(Digest const &tx_digest) const
 {
   auto const rid = CreateResourceId(tx_digest);
-  return archive_.Has(rid);
+  return archive_.Has(rid) || HasInSegments(tx_digest);
 }
 
 /**
@@ -95,7 +261,20 @@ bool TransactionStore::Get(Digest const &tx_digest, chain::Transaction &tx) cons
 
   try
   {
-    return archive_.Get(rid, tx);
+    if (archive_.Get(rid, tx))
+    {
+      return true;
+    }
+
+    // search the segments from the newest to the oldest
+    auto const segments = GetSegments();
+    for (auto it = segments->rbegin(); it != segments->rend(); ++it)
+    {
+      if (it->segment->Get(tx_digest, tx))
+      {
+        return true;
+      }
+    }
   }
   catch (std::exception const &ex)
   {
@@ -113,7 +292,8 @@ bool TransactionStore::Get(Digest const &tx_digest, chain::Transaction &tx) cons
  */
 uint64_t TransactionStore::GetCount() const
 {
-  return static_cast<uint64_t>(archive_.size());
+  FETCH_LOCK(lock_);
+  return static_cast<uint64_t>(recent_digests_.size() + num_archiving_) + num_archived_;
 }
 
 /**
@@ -136,15 +316,386 @@ TxArray TransactionStore::PullSubtree(Digest const &partial_digest, uint64_t bit
     // This is effectively saying get all objects whose ID begins rid & mask
     auto it = archive_.GetSubtree(ResourceID(partial_digest), bit_count);
 
-    while ((it != archive_.end()) && (counter++ < pull_limit))
+    while ((it != archive_.end()) && (counter < pull_limit))
     {
       ret.push_back(*it);
+      ++counter;
       ++it;
     }
   });
 
+  // continue the search in the archived segments
+  auto const segments = GetSegments();
+  for (auto it = segments->rbegin(); (it != segments->rend()) && (counter < pull_limit); ++it)
+  {
+    counter += it->segment->PullSubtree(partial_digest, bit_count, pull_limit - counter, ret);
+  }
+
   return ret;
 }
 
+/**
+ * Get the number of archive segments
+ *
+ * @return The number of segments
+ */
+std::size_t TransactionStore::GetSegmentCount() const
+{
+  return GetSegments()->size();
+}
+
+/**
+ * Block until any archiving (and merging) of the hot store which is in progress has completed
+ */
+void TransactionStore::WaitForArchive() const
+{
+  std::unique_lock<Mutex> lock{lock_};
+  archive_wake_.wait(lock, [this]() { return !archiving_; });
+}
+
+/**
+ * Build the filename for the specified segment. Must be called with the lock held.
+ *
+ * @param id The id of the segment
+ * @return The segment filename
+ */
+std::string TransactionStore::SegmentFilename(uint64_t id) const
+{
+  return doc_file_ + ".seg" + std::to_string(id);
+}
+
+/**
+ * Build the filename for the segment manifest. Must be called with the lock held.
+ *
+ * @return The manifest filename
+ */
+std::string TransactionStore::ManifestFilename() const
+{
+  return doc_file_ + ".segs";
+}
+
+/**
+ * Read the manifest of live segments. Must be called with the lock held.
+ *
+ * @param ids The output ids of the live segments, oldest first
+ * @param next_id The output id to be used for the next segment
+ * @return true if successful (or there is no manifest), false if the manifest is corrupt
+ */
+bool TransactionStore::ReadManifest(SegmentIds &ids, uint64_t &next_id) const
+{
+  ids.clear();
+  next_id = 0;
+
+  std::ifstream stream{ManifestFilename(), std::ios::in | std::ios::binary};
+  if (!stream.is_open())
+  {
+    return true;
+  }
+
+  uint64_t magic{0};
+  uint64_t count{0};
+  if (!ReadValue(stream, magic) || (magic != MANIFEST_MAGIC) || !ReadValue(stream, next_id) ||
+      !ReadValue(stream, count) || (count > next_id))
+  {
+    return false;
+  }
+
+  ids.resize(count);
+  for (auto &id : ids)
+  {
+    if (!ReadValue(stream, id))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Atomically replace the manifest of live segments. Must be called with the lock held.
+ *
+ * @param segments The live segments
+ * @param next_id The id to be used for the next segment
+ * @return true if successful, otherwise false
+ */
+bool TransactionStore::WriteManifest(Segments const &segments, uint64_t next_id) const
+{
+  std::string const filename     = ManifestFilename();
+  std::string const tmp_filename = filename + ".tmp";
+
+  {
+    std::ofstream stream{tmp_filename, std::ios::out | std::ios::binary | std::ios::trunc};
+
+    WriteValue(stream, MANIFEST_MAGIC);
+    WriteValue(stream, next_id);
+    WriteValue(stream, static_cast<uint64_t>(segments.size()));
+
+    for (auto const &segment : segments)
+    {
+      WriteValue(stream, segment.id);
+    }
+
+    stream.close();
+
+    if (stream.fail())
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Failed to write manifest: ", tmp_filename);
+      std::remove(tmp_filename.c_str());
+      return false;
+    }
+  }
+
+  return TransactionArchiveSegment::CommitFile(tmp_filename, filename);
+}
+
+/**
+ * Remove the segment files which are not listed in the manifest. These are left behind when the
+ * node stops part way through archiving or merging. The next segment id is advanced past any such
+ * file so that a filename is never reused. Must be called with the lock held.
+ *
+ * @param ids The ids of the live segments
+ * @param next_id The id to be used for the next segment, updated if required
+ */
+void TransactionStore::RemoveUnreferencedSegments(SegmentIds const &ids, uint64_t &next_id) const
+{
+  for (uint64_t id = 0; id < next_id; ++id)
+  {
+    if (std::find(ids.begin(), ids.end(), id) == ids.end())
+    {
+      std::remove(SegmentFilename(id).c_str());
+    }
+  }
+
+  for (; FileExists(SegmentFilename(next_id)); ++next_id)
+  {
+    std::remove(SegmentFilename(next_id).c_str());
+  }
+}
+
+/**
+ * Get a snapshot of the current set of segments
+ *
+ * @return The segments
+ */
+TransactionStore::SegmentsPtr TransactionStore::GetSegments() const
+{
+  FETCH_LOCK(lock_);
+  return segments_;
+}
+
+/**
+ * Check to see if any of the archived segments contain the specified transaction
+ *
+ * @param tx_digest The transaction digest to be searched for
+ * @return true if present, otherwise false
+ */
+bool TransactionStore::HasInSegments(Digest const &tx_digest) const
+{
+  return HasInSegments(*GetSegments(), tx_digest);
+}
+
+/**
+ * Check to see if any of the given segments contain the specified transaction
+ *
+ * @param segments The segments to be searched
+ * @param tx_digest The transaction digest to be searched for
+ * @return true if present, otherwise false
+ */
+bool TransactionStore::HasInSegments(Segments const &segments, Digest const &tx_digest)
+{
+  for (auto it = segments.rbegin(); it != segments.rend(); ++it)
+  {
+    if (it->segment->Has(tx_digest))
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Signal the archive thread if enough transactions have accumulated in the hot store. Must be
+ * called with the lock held.
+ */
+void TransactionStore::RequestArchive()
+{
+  if (!archiving_ && (recent_digests_.size() >= segment_size_))
+  {
+    archiving_ = true;
+    archive_wake_.notify_all();
+  }
+}
+
+/**
+ * Move the transactions in the hot store into a new archive segment.
+ *
+ * The segment is completely written and published before the transactions are removed from the
+ * hot store, so that they are always available to readers.
+ */
+void TransactionStore::ArchiveRecentTransactions()
+{
+  DigestArray digests{};
+  std::string filename{};
+  uint64_t    id{0};
+
+  {
+    FETCH_LOCK(lock_);
+    digests.swap(recent_digests_);
+    num_archiving_ = digests.size();
+    id             = next_segment_id_++;
+    filename       = SegmentFilename(id);
+  }
+
+  TxArray txs{};
+  txs.reserve(digests.size());
+
+  for (auto const &digest : digests)
+  {
+    chain::Transaction tx;
+    if (archive_.Get(CreateResourceId(digest), tx))
+    {
+      txs.emplace_back(std::move(tx));
+    }
+  }
+
+  auto segment = std::make_shared<TransactionArchiveSegment>();
+  bool success = TransactionArchiveSegment::Write(filename, std::move(txs)) &&
+                 segment->Open(filename);
+
+  if (success)
+  {
+    FETCH_LOCK(lock_);
+
+    auto next = std::make_shared<Segments>(*segments_);
+    next->emplace_back(Segment{id, segment});
+
+    success = WriteManifest(*next, next_segment_id_);
+    if (success)
+    {
+      segments_      = std::move(next);
+      num_archived_ += segment->size();
+      num_archiving_ = 0;
+    }
+  }
+
+  if (!success)
+  {
+    FETCH_LOG_WARN(LOGGING_NAME, "Failed to archive transactions to: ", filename);
+    std::remove(filename.c_str());
+
+    // the transactions remain in the hot store
+    FETCH_LOCK(lock_);
+    recent_digests_.insert(recent_digests_.begin(), digests.begin(), digests.end());
+    num_archiving_ = 0;
+
+    return;
+  }
+
+  for (auto const &digest : digests)
+  {
+    archive_.Erase(CreateResourceId(digest));
+  }
+
+  FETCH_LOG_DEBUG(LOGGING_NAME, "Archived ", digests.size(), " transactions to: ", filename);
+}
+
+/**
+ * Merge the newest segments while the newest is at least as large as the one before it. As a
+ * result the segment sizes decrease from the oldest to the newest and each transaction is
+ * rewritten a logarithmic number of times.
+ */
+void TransactionStore::MergeSegments()
+{
+  for (;;)
+  {
+    Segment     older{};
+    Segment     newer{};
+    uint64_t    id{0};
+    std::string filename{};
+
+    {
+      FETCH_LOCK(lock_);
+
+      std::size_t const count = segments_->size();
+      if ((count < 2) || ((*segments_)[count - 1].segment->size() <
+                          (*segments_)[count - 2].segment->size()))
+      {
+        return;
+      }
+
+      older    = (*segments_)[count - 2];
+      newer    = (*segments_)[count - 1];
+      id       = next_segment_id_++;
+      filename = SegmentFilename(id);
+    }
+
+    auto merged  = std::make_shared<TransactionArchiveSegment>();
+    bool success = TransactionArchiveSegment::Merge(filename, *older.segment, *newer.segment) &&
+                   merged->Open(filename);
+
+    if (success)
+    {
+      FETCH_LOCK(lock_);
+
+      // only the archive thread modifies the segments, so the two newest are still the inputs
+      auto next = std::make_shared<Segments>(segments_->begin(), segments_->end() - 2);
+      next->emplace_back(Segment{id, merged});
+
+      success = WriteManifest(*next, next_segment_id_);
+      if (success)
+      {
+        // duplicates across the inputs are only stored once in the merged segment
+        num_archived_ -= older.segment->size() + newer.segment->size() - merged->size();
+        segments_ = std::move(next);
+      }
+    }
+
+    if (!success)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Failed to merge segments into: ", filename);
+      std::remove(filename.c_str());
+      return;
+    }
+
+    // the files are removed once the last reader has released the segments
+    older.segment->MarkObsolete();
+    newer.segment->MarkObsolete();
+
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Merged segments ", older.id, " and ", newer.id,
+                    " into: ", filename);
+  }
+}
+
+void TransactionStore::ThreadEntryPoint()
+{
+  SetThreadName("TxStoreArchive");
+
+  for (;;)
+  {
+    {
+      std::unique_lock<Mutex> lock{lock_};
+      archive_wake_.wait(lock, [this]() { return archiving_ || !running_; });
+
+      // any pending archive is completed before the thread exits
+      if (!archiving_)
+      {
+        return;
+      }
+    }
+
+    ArchiveRecentTransactions();
+    MergeSegments();
+
+    FETCH_LOCK(lock_);
+    archiving_ = false;
+    archive_wake_.notify_all();
+
+    // more transactions might have accumulated while archiving
+    RequestArchive();
+  }
+}
+
 }  // namespace ledger
 }  // namespace fetch
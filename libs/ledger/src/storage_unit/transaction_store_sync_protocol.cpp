@@ -26,6 +26,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <utility>
 #include <vector>
 
 namespace fetch {
@@ -54,19 +55,31 @@ TransactionStoreSyncProtocol::TransactionStoreSyncProtocol(TransactionStorageEng
                                                            uint32_t lane_id)
   : lane_(lane_id)
   , store_(store)
+  , compressor_{"ledger_tx_sync_store", byte_array::ConstByteArray{},
+                {{"lane", std::to_string(lane_id)}}}
   , object_count_total_{CreateCounter("object_count")}
   , pull_objects_total_{CreateCounter("pull_objects")}
   , pull_subtree_total_{CreateCounter("pull_subtree")}
   , pull_specific_objects_total_{CreateCounter("pull_specific")}
+  , pull_objects_delta_total_{CreateCounter("pull_objects_delta")}
+  , pull_objects_delta_fallback_total_{CreateCounter("pull_objects_delta_fallback")}
   , object_count_durations_{CreateHistogram("object_count")}
   , pull_objects_durations_{CreateHistogram("pull_objects")}
   , pull_subtree_durations_{CreateHistogram("pull_subtree")}
   , pull_specific_objects_durations_{CreateHistogram("pull_specific")}
+  , pull_objects_delta_durations_{CreateHistogram("pull_objects_delta")}
 {
   Expose(OBJECT_COUNT, this, &TransactionStoreSyncProtocol::ObjectCount);
   ExposeWithClientContext(PULL_OBJECTS, this, &TransactionStoreSyncProtocol::PullObjects);
   Expose(PULL_SUBTREE, this, &TransactionStoreSyncProtocol::PullSubtree);
   Expose(PULL_SPECIFIC_OBJECTS, this, &TransactionStoreSyncProtocol::PullSpecificObjects);
+  ExposeWithClientContext(PULL_OBJECTS_COMPRESSED, this,
+                          &TransactionStoreSyncProtocol::PullObjectsCompressed);
+  Expose(PULL_SUBTREE_COMPRESSED, this, &TransactionStoreSyncProtocol::PullSubtreeCompressed);
+  Expose(PULL_SPECIFIC_OBJECTS_COMPRESSED, this,
+         &TransactionStoreSyncProtocol::PullSpecificObjectsCompressed);
+  ExposeWithClientContext(PULL_OBJECTS_DELTA, this,
+                          &TransactionStoreSyncProtocol::PullObjectsDelta);
 }
 
 /**
@@ -117,6 +130,26 @@ void TransactionStoreSyncProtocol::TrimCache()
   cache_ = std::move(next_cache);
 }
 
+/**
+ * Get the digests of all the recently seen transactions
+ *
+ * @return The set of recent digests
+ */
+DigestSet TransactionStoreSyncProtocol::GetRecentDigests()
+{
+  FETCH_LOCK(cache_mutex_);
+
+  DigestSet digests;
+  digests.reserve(cache_.size());
+
+  for (auto const &c : cache_)
+  {
+    digests.emplace(c.data.digest());
+  }
+
+  return digests;
+}
+
 /**
  * Query the count of transactiobs that are available
  *
@@ -214,6 +247,128 @@ TSSP::TxArray TransactionStoreSyncProtocol::PullSpecificObjects(DigestSet const
   return ret;
 }
 
+/**
+ * Pull recent transaction objects from peer, compressing the response
+ *
+ * @param call_context The calling context of the RPC call
+ * @param accepted The set of codecs that the caller is able to decode
+ * @return The (compressed) new transactions to sync
+ */
+TSSP::CompressedPayload TransactionStoreSyncProtocol::PullObjectsCompressed(
+    service::CallContext const &call_context, CodecMask accepted)
+{
+  return compressor_.Encode(PullObjects(call_context), accepted);
+}
+
+/**
+ * Pull a section of the subtree, compressing the response
+ *
+ * @param rid The prefix of the subtree
+ * @param bit_count The number of significant bits of the prefix
+ * @param accepted The set of codecs that the caller is able to decode
+ * @return The (compressed) subtree
+ */
+TSSP::CompressedPayload TransactionStoreSyncProtocol::PullSubtreeCompressed(
+    byte_array::ConstByteArray const &rid, uint64_t bit_count, CodecMask accepted)
+{
+  return compressor_.Encode(PullSubtree(rid, bit_count), accepted);
+}
+
+/**
+ * Pull a specific set of transactions, compressing the response
+ *
+ * @param digests The set of transactions to search for
+ * @param accepted The set of codecs that the caller is able to decode
+ * @return The (compressed) found transactions
+ */
+TSSP::CompressedPayload TransactionStoreSyncProtocol::PullSpecificObjectsCompressed(
+    DigestSet const &digests, CodecMask accepted)
+{
+  return compressor_.Encode(PullSpecificObjects(digests), accepted);
+}
+
+/**
+ * Pull only the recent transaction objects that the caller is missing
+ *
+ * The caller summarises its own set of recent transactions as an invertible bloom lookup table.
+ * Subtracting this from the equivalent table for our recent transactions yields the (small) set
+ * difference, which allows only the missing transactions to be sent. In the case where the
+ * difference is too large to be decoded, all the recent transactions are sent, as with
+ * PullObjects.
+ *
+ * @param call_context The calling context of the RPC call
+ * @param remote The table of the caller's recent transactions
+ * @param accepted The set of codecs that the caller is able to decode
+ * @return The (compressed) transactions that the caller is missing
+ */
+TSSP::CompressedPayload TransactionStoreSyncProtocol::PullObjectsDelta(
+    service::CallContext const &call_context, InvertibleBloomLookupTable const &remote,
+    CodecMask accepted)
+{
+  FETCH_UNUSED(call_context);
+
+  pull_objects_delta_total_->increment();
+
+  TxArray ret{};
+
+  {
+    telemetry::FunctionTimer telemetry_timer{*pull_objects_delta_durations_};
+    generics::MilliTimer     timer("ObjectSync:PullObjectsDelta", 500);
+
+    // take a copy of the recent transactions (the cache can contain duplicates), so that the
+    // table supplied by the peer is decoded without holding up the cache
+    TxArray   recent{};
+    DigestSet recent_digests{};
+    {
+      FETCH_LOCK(cache_mutex_);
+
+      recent.reserve(cache_.size());
+      for (auto const &c : cache_)
+      {
+        if (recent_digests.emplace(c.data.digest()).second)
+        {
+          recent.push_back(c.data);
+        }
+      }
+    }
+
+    // build the equivalent table for our recent transactions
+    InvertibleBloomLookupTable table{remote.size()};
+    for (auto const &tx : recent)
+    {
+      table.Insert(tx.digest());
+    }
+
+    DigestSet missing{};
+    DigestSet unused{};
+
+    bool const decoded = table.Subtract(remote) && table.Decode(missing, unused);
+    if (!decoded)
+    {
+      pull_objects_delta_fallback_total_->increment();
+      ret = std::move(recent);
+    }
+    else
+    {
+      for (auto &tx : recent)
+      {
+        if (missing.find(tx.digest()) != missing.end())
+        {
+          ret.push_back(std::move(tx));
+        }
+      }
+    }
+  }
+
+  if (!ret.empty())
+  {
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Lane ", lane_, ": PullObjectsDelta: Sending back ", ret.size(),
+                    " TXs");
+  }
+
+  return compressor_.Encode(ret, accepted);
+}
+
 /**
  * Create a total metric for a specified operation
  *
@@ -25,6 +25,7 @@
 #include "telemetry/gauge.hpp"
 #include "telemetry/registry.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <memory>
@@ -63,16 +64,19 @@ static char const *FETCH_MAYBE_UNUSED ToString(fetch::ledger::tx_sync::State sta
 namespace fetch {
 namespace ledger {
 
-TransactionStoreSyncService::TransactionStoreSyncService(Config const &cfg, MuddleEndpoint &muddle,
-                                                         TransactionStorageEngineInterface &store,
-                                                         TxFinderProtocol *tx_finder_protocol,
-                                                         TrimCacheCallback trim_cache_callback)
+TransactionStoreSyncService::TransactionStoreSyncService(
+    Config const &cfg, MuddleEndpoint &muddle, TransactionStorageEngineInterface &store,
+    TxFinderProtocol *tx_finder_protocol, TrimCacheCallback trim_cache_callback,
+    RecentDigestsCallback recent_digests_callback)
   : trim_cache_callback_(std::move(trim_cache_callback))
+  , recent_digests_callback_(std::move(recent_digests_callback))
   , state_machine_{std::make_shared<core::StateMachine<State>>("TransactionStoreSyncService",
                                                                State::INITIAL)}
   , tx_finder_protocol_(tx_finder_protocol)
   , cfg_{cfg}
   , muddle_(muddle)
+  , compression_{"ledger_tx_store_sync_service", byte_array::ConstByteArray{}}
+  , delta_support_{"ledger_tx_store_sync_service_delta", "recent transaction deltas"}
   , client_(std::make_shared<Client>("R:TxSync-L" + std::to_string(cfg_.lane_id), muddle,
                                      SERVICE_LANE, CHANNEL_RPC))
   , store_(store)
@@ -119,6 +123,61 @@ TransactionStoreSyncService::TransactionStoreSyncService(Config const &cfg, Mudd
   });
 }
 
+/**
+ * Request a list of transactions from a peer, using the compressed variant of the call when the
+ * peer supports it
+ *
+ * @param peer The address of the peer
+ * @param function The (uncompressed) protocol function
+ * @param compressed_function The compressed variant of the protocol function
+ * @param args The arguments to the call
+ * @return The promise of the transaction list
+ */
+template <typename... Args>
+TransactionStoreSyncService::PromiseOfTxList TransactionStoreSyncService::PullTxList(
+    Address const &peer, Client::FunctionId function, Client::FunctionId compressed_function,
+    Args const &... args)
+{
+  if (!compression_.IsSupported(peer))
+  {
+    return PromiseOfTxList(
+        client_->CallSpecificAddress(peer, RPC_TX_STORE_SYNC, function, args...));
+  }
+
+  auto promise = client_->CallSpecificAddressWithDecoder(
+      peer, compression_.CreateDecoder(), RPC_TX_STORE_SYNC, compressed_function, args...,
+      compression_.accepted_codecs());
+  compression_.Monitor(peer, promise);
+
+  return PromiseOfTxList(promise);
+}
+
+/**
+ * Request the recent transactions from a peer. Peers which support it are only asked for the
+ * transactions missing from our own recent set. Support for this is tracked separately from
+ * support for compression, since a peer can serve compressed responses without serving deltas.
+ *
+ * @param peer The address of the peer
+ * @param recent The table summarising our set of recent transactions
+ * @return The promise of the transaction list
+ */
+TransactionStoreSyncService::PromiseOfTxList TransactionStoreSyncService::PullRecentTxList(
+    Address const &peer, InvertibleBloomLookupTable const &recent)
+{
+  if (!compression_.IsSupported(peer) || !delta_support_.IsSupported(peer))
+  {
+    return PullTxList(peer, TransactionStoreSyncProtocol::PULL_OBJECTS,
+                      TransactionStoreSyncProtocol::PULL_OBJECTS_COMPRESSED);
+  }
+
+  auto promise = client_->CallSpecificAddressWithDecoder(
+      peer, compression_.CreateDecoder(), RPC_TX_STORE_SYNC,
+      TransactionStoreSyncProtocol::PULL_OBJECTS_DELTA, recent, compression_.accepted_codecs());
+  delta_support_.Monitor(peer, promise);
+
+  return PromiseOfTxList(promise);
+}
+
 TransactionStoreSyncService::State TransactionStoreSyncService::OnInitial()
 {
   current_tss_state_->set(static_cast<uint64_t>(state_machine_->state()));
@@ -256,9 +315,9 @@ TransactionStoreSyncService::State TransactionStoreSyncService::OnQuerySubtree()
     transactions_prefix.Resize(std::size_t{ResourceID::RESOURCE_ID_SIZE_IN_BYTES});
     *reinterpret_cast<decltype(root) *>(transactions_prefix.char_pointer()) = root;
 
-    auto promise = PromiseOfTxList(client_->CallSpecificAddress(
-        connection, RPC_TX_STORE_SYNC, TransactionStoreSyncProtocol::PULL_SUBTREE,
-        transactions_prefix, root_size_));
+    auto promise = PullTxList(connection, TransactionStoreSyncProtocol::PULL_SUBTREE,
+                              TransactionStoreSyncProtocol::PULL_SUBTREE_COMPRESSED,
+                              transactions_prefix, root_size_);
 
     promise_id_to_roots_[promise.id()] = root;
     pending_subtree_.Add(root, promise);
@@ -367,14 +426,32 @@ TransactionStoreSyncService::State TransactionStoreSyncService::OnQueryObjects()
     return State::QUERY_OBJECTS;
   }
 
+  // summarise our recent transactions, sized from the difference observed on the last pull. After
+  // a fallback this is the peer's entire recent set, so it is capped to keep the requests small
+  InvertibleBloomLookupTable recent{};
+  if (is_time_to_pull)
+  {
+    std::size_t const expected_difference =
+        (recent_difference_ < MAX_RECENT_DIFFERENCE) ? recent_difference_ : MAX_RECENT_DIFFERENCE;
+
+    recent = InvertibleBloomLookupTable{
+        InvertibleBloomLookupTable::CellsForDifference(expected_difference)};
+
+    for (auto const &recent_digest : recent_digests_callback_())
+    {
+      recent.Insert(recent_digest);
+    }
+
+    recent_difference_ = 0;
+  }
+
   // walk through all
   for (auto const &connection : muddle_.GetDirectlyConnectedPeers())
   {
     // if it is time to pull the recent transactions then pull them
     if (is_time_to_pull)
     {
-      auto p1 = PromiseOfTxList(client_->CallSpecificAddress(
-          connection, RPC_TX_STORE_SYNC, TransactionStoreSyncProtocol::PULL_OBJECTS));
+      auto p1 = PullRecentTxList(connection, recent);
       if (!pending_objects_.Add(connection, p1))
       {
         FETCH_LOG_WARN(LOGGING_NAME, "Failed to add promise of transactions to queue");
@@ -388,9 +465,8 @@ TransactionStoreSyncService::State TransactionStoreSyncService::OnQueryObjects()
       FETCH_LOG_WARN(LOGGING_NAME, "Lane ", cfg_.lane_id, ": Explicitly requesting ",
                      digests.size(), " TXs");
 
-      auto p2 = PromiseOfTxList(client_->CallSpecificAddress(
-          connection, RPC_TX_STORE_SYNC, TransactionStoreSyncProtocol::PULL_SPECIFIC_OBJECTS,
-          digests));
+      auto p2 = PullTxList(connection, TransactionStoreSyncProtocol::PULL_SPECIFIC_OBJECTS,
+                           TransactionStoreSyncProtocol::PULL_SPECIFIC_OBJECTS_COMPRESSED, digests);
       if (!pending_objects_.Add(connection, p2))
       {
         FETCH_LOG_WARN(LOGGING_NAME,
@@ -429,6 +505,8 @@ TransactionStoreSyncService::State TransactionStoreSyncService::OnResolvingObjec
       verifier_.AddTransaction(std::make_shared<chain::Transaction>(tx));
       ++synced_tx;
     }
+
+    recent_difference_ = std::max(recent_difference_, result.promised.size());
   }
 
   if (synced_tx != 0u)
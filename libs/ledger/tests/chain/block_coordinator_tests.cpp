@@ -43,6 +43,7 @@
 #include <cstdint>
 #include <memory>
 #include <ostream>
+#include <vector>
 
 namespace {
 
@@ -55,7 +56,9 @@ using fetch::ledger::testing::BlockGenerator;
 using ::testing::_;
 using ::testing::AnyNumber;
 using ::testing::InSequence;
+using ::testing::Invoke;
 using ::testing::NiceMock;
+using ::testing::Return;
 using ::testing::StrictMock;
 
 using BlockCoordinatorPtr = std::unique_ptr<BlockCoordinator>;
@@ -64,6 +67,7 @@ using ExecutionMgrPtr     = std::unique_ptr<MockExecutionManager>;
 using StorageUnitPtr      = std::unique_ptr<MockStorageUnit>;
 using BlockPackerPtr      = std::unique_ptr<MockBlockPacker>;
 using BlockPtr            = std::shared_ptr<Block>;
+using BlockPtrs           = std::vector<BlockPtr>;
 using ScheduleStatus      = fetch::ledger::ExecutionManagerInterface::ScheduleStatus;
 using BlockSinkPtr        = std::unique_ptr<FakeBlockSink>;
 using State               = fetch::ledger::BlockCoordinator::State;
@@ -1254,4 +1258,175 @@ TEST_F(NiceMockBlockCoordinatorTests, UnknownTransactionDoesNotBlockForever)
   Tock(State::WAIT_FOR_TRANSACTIONS, State::SYNCHRONISED);
 }
 
+class BlockCoordinatorLookaheadTests : public NiceMockBlockCoordinatorTests
+{
+protected:
+  // long enough for the coordinator to retain the path to the heaviest block while syncing
+  static constexpr std::size_t CHAIN_LENGTH = 104;
+
+  /**
+   * Generate the chain of blocks which the coordinator will catch up on
+   *
+   * @return The blocks of the chain, indexed by block number
+   */
+  BlockPtrs GenerateChain()
+  {
+    return block_generator_(CHAIN_LENGTH + 1);
+  }
+
+  /**
+   * Add the (non genesis) blocks to the main chain
+   *
+   * @param blocks The blocks to be added
+   */
+  void AddToChain(BlockPtrs const &blocks)
+  {
+    for (std::size_t i = 1; i < blocks.size(); ++i)
+    {
+      ASSERT_EQ(BlockStatus::ADDED, main_chain_->AddBlock(*blocks[i]));
+    }
+  }
+
+  /**
+   * Run the state machine until the specified condition is met, or times out
+   *
+   * @param condition The condition to be met
+   * @return true if the condition was met, otherwise false
+   */
+  template <typename Condition>
+  bool AdvanceUntil(Condition &&condition, uint64_t max_iterations = 2000)
+  {
+    for (; max_iterations > 0; --max_iterations)
+    {
+      if (condition())
+      {
+        return true;
+      }
+
+      block_coordinator_->GetRunnable().Execute();
+    }
+
+    return condition();
+  }
+
+  /**
+   * Add an unknown transaction to the specified block
+   *
+   * @param block The block to be updated
+   * @return The digest of the unknown transaction
+   */
+  static fetch::Digest AddUnknownTransaction(Block &block)
+  {
+    TransactionLayout layout{*fetch::testing::GenerateUniqueHashes(1u).begin(),
+                             fetch::BitVector{}, 0, 0, 1000};
+
+    block.slices.begin()->push_back(layout);
+
+    return layout.digest();
+  }
+
+  /**
+   * Determine the last executed block at the point when the missing transaction is requested
+   *
+   * @param depth The pipeline depth to be configured
+   * @param block_number The block containing the missing transaction
+   * @return The block number of the last executed block when the request was made
+   */
+  uint64_t BlockNumberWhenRequested(std::size_t depth, std::size_t block_number)
+  {
+    auto blocks = GenerateChain();
+    auto digest = AddUnknownTransaction(*blocks[block_number]);
+    AddToChain(blocks);
+
+    block_coordinator_->SetPipelineDepth(depth);
+
+    bool     requested{false};
+    uint64_t requested_at{0};
+    EXPECT_CALL(*storage_unit_, IssueCallForMissingTxs(_))
+        .WillRepeatedly(Invoke([&](fetch::DigestSet const &digests) {
+          if (!requested && (digests.find(digest) != digests.end()))
+          {
+            requested    = true;
+            requested_at = main_chain_->GetBlock(execution_manager_->fake.LastProcessedBlock())
+                               ->block_number;
+          }
+        }));
+
+    EXPECT_TRUE(AdvanceUntil([&requested]() { return requested; }));
+
+    return requested_at;
+  }
+};
+
+TEST_F(BlockCoordinatorLookaheadTests, LookaheadResultIsConsumed)
+{
+  auto blocks = GenerateChain();
+  auto digest = AddUnknownTransaction(*blocks[5]);
+  AddToChain(blocks);
+
+  // the missing transaction is requested once, from the lookahead window, when the first block is
+  // being executed
+  EXPECT_CALL(*storage_unit_, IssueCallForMissingTxs(_))
+      .WillOnce(Invoke([this](fetch::DigestSet const &) {
+        EXPECT_EQ(execution_manager_->fake.LastProcessedBlock(), fetch::chain::GetGenesisDigest());
+      }));
+
+  ASSERT_TRUE(AdvanceUntil([this, &blocks]() {
+    return execution_manager_->fake.LastProcessedBlock() == blocks[4]->hash;
+  }));
+  Tock(State::POST_EXEC_BLOCK_VALIDATION, State::WAIT_FOR_TRANSACTIONS);
+
+  // the request state is carried over so the coordinator does not ask for the transaction again
+  ASSERT_TRUE(RemainsOn(State::WAIT_FOR_TRANSACTIONS));
+
+  // the transaction arrives
+  ON_CALL(*storage_unit_, HasTransaction(digest)).WillByDefault(Return(true));
+
+  ASSERT_TRUE(AdvanceUntil([this, &blocks]() {
+    return execution_manager_->fake.LastProcessedBlock() == blocks[5]->hash;
+  }));
+}
+
+TEST_F(BlockCoordinatorLookaheadTests, LookaheadIsDiscardedOnFork)
+{
+  auto blocks = GenerateChain();
+  AddUnknownTransaction(*blocks[8]);
+  AddToChain(blocks);
+
+  // the fork is heavier than the whole of the original chain
+  auto fork = block_generator_(blocks[6], 1000u);
+
+  EXPECT_CALL(*execution_manager_, Execute(_)).Times(AnyNumber());
+  EXPECT_CALL(*execution_manager_, Execute(IsBlock(blocks[7]))).Times(0);
+  EXPECT_CALL(*storage_unit_, IssueCallForMissingTxs(_)).Times(1);
+
+  // once the path is no longer retained the window still contains the upcoming blocks
+  ASSERT_TRUE(AdvanceUntil([this, &blocks]() {
+    return execution_manager_->fake.LastProcessedBlock() == blocks[6]->hash;
+  }));
+
+  // the chain switches to the fork before the next block is executed
+  ASSERT_EQ(BlockStatus::ADDED, main_chain_->AddBlock(*fork));
+
+  // the blocks (and the missing transaction) from the original chain are not waited for
+  ASSERT_TRUE(AdvanceUntil(
+      [this]() { return State::SYNCHRONISED == block_coordinator_->GetStateMachine().state(); }));
+  EXPECT_EQ(execution_manager_->fake.LastProcessedBlock(), fork->hash);
+}
+
+TEST_F(BlockCoordinatorLookaheadTests, LookaheadUsesDefaultPipelineDepth)
+{
+  EXPECT_EQ(0u, BlockNumberWhenRequested(4, 5));
+}
+
+TEST_F(BlockCoordinatorLookaheadTests, LookaheadIsLimitedToConfiguredPipelineDepth)
+{
+  EXPECT_EQ(2u, BlockNumberWhenRequested(2, 5));
+}
+
+TEST_F(BlockCoordinatorLookaheadTests, LookaheadCanBeDisabled)
+{
+  EXPECT_EQ(4u, BlockNumberWhenRequested(0, 5));
+}
+
 }  // namespace
@@ -16,6 +16,7 @@
 //
 //------------------------------------------------------------------------------
 
+#include "persistent_transaction_status_cache.hpp"
 #include "time_based_transaction_status_cache.hpp"
 #include "transaction_status_cache_test.hpp"
 
@@ -28,6 +29,7 @@ namespace {
 using fetch::Digest;
 using fetch::ledger::ContractExecutionResult;
 using fetch::ledger::ContractExecutionStatus;
+using fetch::ledger::PersistentTransactionStatusCache;
 using fetch::ledger::TimeBasedTransactionStatusCache;
 using fetch::ledger::TransactionStatus;
 
@@ -92,4 +94,80 @@ TEST_F(PersistentTransactionStatusCacheTests, CheckUpdateForContractExecutionRes
   EXPECT_EQ(expected_result.charge, received_result.contract_exec_result.charge);
 }
 
+class BufferedPersistentTransactionStatusCacheTests : public TransactionStatusCacheTest
+{
+protected:
+  using CachePtr = std::unique_ptr<PersistentTransactionStatusCache>;
+  using Mode     = PersistentTransactionStatusCache::Mode;
+
+  void SetUp() override
+  {
+    cache_ = std::make_unique<PersistentTransactionStatusCache>(Mode::NEW_DATABASE);
+  }
+
+  void Reload()
+  {
+    cache_.reset();
+    cache_ = std::make_unique<PersistentTransactionStatusCache>(Mode::LOAD_EXISTING);
+  }
+
+  CachePtr cache_;
+};
+
+TEST_F(BufferedPersistentTransactionStatusCacheTests, CheckUpdatesAreVisibleBeforeFlush)
+{
+  auto tx1 = GenerateDigest();
+  auto tx2 = GenerateDigest();
+
+  cache_->Update(tx1, TransactionStatus::PENDING);
+  cache_->Update(tx2, ContractExecutionResult{ContractExecutionStatus::SUCCESS, 1, 2, 3, 4, 0});
+
+  EXPECT_EQ(TransactionStatus::PENDING, cache_->Query(tx1).status);
+  EXPECT_EQ(TransactionStatus::EXECUTED, cache_->Query(tx2).status);
+  EXPECT_EQ(4u, cache_->Query(tx2).contract_exec_result.fee);
+}
+
+TEST_F(BufferedPersistentTransactionStatusCacheTests, CheckUpdatesArePersisted)
+{
+  auto tx1 = GenerateDigest();
+  auto tx2 = GenerateDigest();
+
+  ContractExecutionResult const expected_result{
+      ContractExecutionStatus::INEXPLICABLE_FAILURE, 1, 2, 3, 4, -2};
+
+  cache_->Update(tx1, TransactionStatus::MINED);
+  cache_->Update(tx2, expected_result);
+
+  // destroying the cache writes all the outstanding updates
+  Reload();
+
+  EXPECT_EQ(TransactionStatus::MINED, cache_->Query(tx1).status);
+
+  auto const received_result{cache_->Query(tx2)};
+  EXPECT_EQ(TransactionStatus::EXECUTED, received_result.status);
+  EXPECT_EQ(expected_result.status, received_result.contract_exec_result.status);
+  EXPECT_EQ(expected_result.return_value, received_result.contract_exec_result.return_value);
+  EXPECT_EQ(expected_result.fee, received_result.contract_exec_result.fee);
+}
+
+TEST_F(BufferedPersistentTransactionStatusCacheTests, CheckStatusUpdatePreservesStoredResult)
+{
+  auto tx1 = GenerateDigest();
+
+  cache_->Update(tx1, ContractExecutionResult{ContractExecutionStatus::SUCCESS, 1, 2, 3, 4, 5});
+  cache_->Flush();
+
+  // a later status only update must not discard the execution result on disk
+  cache_->Update(tx1, TransactionStatus::SUBMITTED);
+  EXPECT_EQ(TransactionStatus::SUBMITTED, cache_->Query(tx1).status);
+  EXPECT_EQ(5, cache_->Query(tx1).contract_exec_result.return_value);
+
+  cache_->Flush();
+
+  auto const received_result{cache_->Query(tx1)};
+  EXPECT_EQ(TransactionStatus::SUBMITTED, received_result.status);
+  EXPECT_EQ(ContractExecutionStatus::SUCCESS, received_result.contract_exec_result.status);
+  EXPECT_EQ(5, received_result.contract_exec_result.return_value);
+}
+
 }  // namespace
@@ -0,0 +1,138 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "fake_executor.hpp"
+
+#include "chain/address.hpp"
+#include "chain/constants.hpp"
+#include "chain/transaction.hpp"
+#include "chain/transaction_builder.hpp"
+#include "core/bitvector.hpp"
+#include "crypto/ecdsa.hpp"
+#include "ledger/execution_item.hpp"
+#include "ledger/storage_unit/fake_storage_unit.hpp"
+
+#include "gmock/gmock.h"
+
+#include <memory>
+
+namespace {
+
+using fetch::BitVector;
+using fetch::chain::Address;
+using fetch::chain::TransactionBuilder;
+using fetch::crypto::ECDSASigner;
+using fetch::ledger::ExecutionItem;
+using fetch::ledger::FakeStorageUnit;
+
+using testing::_;
+using testing::Invoke;
+using testing::IsNull;
+using testing::NotNull;
+
+class MockPrefetchExecutor : public FakeExecutor
+{
+public:
+  MOCK_METHOD5(ExecutePrefetched, Result(Digest const &, TransactionPtr const &, BlockIndex,
+                                         SliceIndex, BitVector const &));
+};
+
+class ExecutionItemTests : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    fetch::chain::InitialiseTestConstants();
+  }
+
+  void SetUp() override
+  {
+    ECDSASigner signer{};
+
+    tx_ = TransactionBuilder()
+              .From(Address{signer.identity()})
+              .Signer(signer.identity())
+              .Seal()
+              .Sign(signer)
+              .Build();
+
+    item_ = std::make_unique<ExecutionItem>(tx_->digest(), 1, 0, BitVector{1});
+  }
+
+  FakeStorageUnit                           storage_{};
+  fetch::chain::TransactionPtr              tx_{};
+  std::unique_ptr<ExecutionItem>            item_{};
+  testing::StrictMock<MockPrefetchExecutor> executor_{};
+};
+
+TEST_F(ExecutionItemTests, CheckPrefetchOfAvailableTransaction)
+{
+  storage_.AddTransaction(*tx_);
+
+  EXPECT_TRUE(item_->Prefetch(storage_));
+  EXPECT_TRUE(item_->is_prefetched());
+}
+
+TEST_F(ExecutionItemTests, CheckPrefetchOfMissingTransaction)
+{
+  EXPECT_FALSE(item_->Prefetch(storage_));
+  EXPECT_FALSE(item_->is_prefetched());
+}
+
+TEST_F(ExecutionItemTests, CheckPrefetchedTransactionIsPassedToExecutor)
+{
+  storage_.AddTransaction(*tx_);
+  ASSERT_TRUE(item_->Prefetch(storage_));
+
+  EXPECT_CALL(executor_, ExecutePrefetched(tx_->digest(), NotNull(), 1, 0, _))
+      .WillOnce(Invoke([this](auto const &, auto const &tx, auto, auto, auto const &) {
+        EXPECT_EQ(tx->digest(), tx_->digest());
+        return ExecutionItem::Result{ExecutionItem::Status::SUCCESS};
+      }));
+
+  item_->Execute(executor_);
+
+  EXPECT_EQ(ExecutionItem::Status::SUCCESS, item_->result().status);
+}
+
+TEST_F(ExecutionItemTests, CheckExecutionWithoutPrefetch)
+{
+  EXPECT_CALL(executor_, ExecutePrefetched(tx_->digest(), IsNull(), 1, 0, _))
+      .WillOnce(Invoke([](auto const &, auto const &, auto, auto, auto const &) {
+        return ExecutionItem::Result{ExecutionItem::Status::SUCCESS};
+      }));
+
+  item_->Execute(executor_);
+}
+
+TEST_F(ExecutionItemTests, CheckPrefetchIsSkippedOnceExecutionHasStarted)
+{
+  storage_.AddTransaction(*tx_);
+
+  EXPECT_CALL(executor_, ExecutePrefetched(_, IsNull(), _, _, _))
+      .WillOnce(Invoke([](auto const &, auto const &, auto, auto, auto const &) {
+        return ExecutionItem::Result{ExecutionItem::Status::SUCCESS};
+      }));
+
+  item_->Execute(executor_);
+
+  EXPECT_FALSE(item_->Prefetch(storage_));
+  EXPECT_FALSE(item_->is_prefetched());
+}
+
+}  // namespace
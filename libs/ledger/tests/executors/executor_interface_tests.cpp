@@ -0,0 +1,63 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/serializers/counter.hpp"
+#include "core/serializers/main_serializer.hpp"
+#include "ledger/executor_interface.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <limits>
+
+namespace {
+
+using fetch::ledger::ExecutorInterface;
+using fetch::serializers::MsgPackSerializer;
+using fetch::serializers::SerializedSizeBound;
+using fetch::serializers::SizeCounter;
+
+TEST(ExecutionResultTests, CheckSerializedSizeBound)
+{
+  using Result = ExecutorInterface::Result;
+
+  static_assert(SerializedSizeBound<Result>::IS_BOUNDED, "");
+  uint64_t const bound = SerializedSizeBound<Result>::VALUE;
+
+  Result result{ExecutorInterface::Status::INEXPLICABLE_FAILURE};
+  result.charge      = std::numeric_limits<uint64_t>::max();
+  result.charge_rate = std::numeric_limits<uint64_t>::max();
+  result.fee         = std::numeric_limits<uint64_t>::max();
+
+  SizeCounter counter;
+  counter << result;
+  EXPECT_LE(counter.size(), bound);
+
+  // appending a result reserves its bound up front
+  MsgPackSerializer serializer;
+  serializer.Append(result);
+  EXPECT_EQ(serializer.capacity(), bound);
+
+  Result output{};
+  serializer.seek(0);
+  serializer >> output;
+  EXPECT_EQ(output.status, result.status);
+  EXPECT_EQ(output.fee, result.fee);
+}
+
+}  // namespace
@@ -30,6 +30,7 @@ using fetch::ledger::CachedStorageAdapter;
 using fetch::storage::Document;
 using fetch::storage::ResourceAddress;
 
+using testing::_;
 using testing::Return;
 
 class CachedStorageAdapterTests : public testing::Test
@@ -40,6 +41,7 @@ public:
   {}
 
   ResourceAddress key{"key"};
+  ResourceAddress other_key{"other_key"};
 
   MockStorage          mock_storage{};
   CachedStorageAdapter cached_storage_adapter;
@@ -89,4 +91,50 @@ TEST_F(CachedStorageAdapterTests, Get_does_not_cache_result_if_retrieval_from_st
   cached_storage_adapter.Get(key);
 }
 
+TEST_F(CachedStorageAdapterTests, Prefetch_caches_results_retrieved_from_storage)
+{
+  Document doc;
+  doc.failed = false;
+
+  EXPECT_CALL(mock_storage, Get(key)).WillOnce(Return(doc));
+  EXPECT_CALL(mock_storage, Get(other_key)).WillOnce(Return(doc));
+
+  cached_storage_adapter.Prefetch({key, other_key});
+  cached_storage_adapter.Prefetch({key, other_key});
+  cached_storage_adapter.Get(key);
+  cached_storage_adapter.GetOrCreate(other_key);
+}
+
+TEST_F(CachedStorageAdapterTests, Prefetch_does_not_cache_result_if_retrieval_from_storage_fails)
+{
+  Document doc;
+  doc.failed = true;
+
+  EXPECT_CALL(mock_storage, Get(key)).Times(2).WillRepeatedly(Return(doc));
+
+  cached_storage_adapter.Prefetch({key});
+  cached_storage_adapter.Get(key);
+}
+
+TEST_F(CachedStorageAdapterTests, Flush_does_not_write_back_prefetched_results)
+{
+  Document doc;
+  doc.failed = false;
+
+  EXPECT_CALL(mock_storage, Get(key)).WillOnce(Return(doc));
+  EXPECT_CALL(mock_storage, Set(_, _)).Times(0);
+
+  cached_storage_adapter.Prefetch({key});
+  cached_storage_adapter.Flush();
+}
+
+TEST_F(CachedStorageAdapterTests, Flush_writes_updated_values_once)
+{
+  EXPECT_CALL(mock_storage, Set(key, fetch::byte_array::ConstByteArray{"value"})).Times(1);
+
+  cached_storage_adapter.Set(key, "value");
+  cached_storage_adapter.Flush();
+  cached_storage_adapter.Flush();
+}
+
 }  // namespace
@@ -0,0 +1,81 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "ledger/resource_address_cache.hpp"
+#include "ledger/state_adapter.hpp"
+
+#include "gtest/gtest.h"
+
+#include <string>
+
+namespace {
+
+using fetch::ledger::ResourceAddressCache;
+using fetch::ledger::StateAdapter;
+
+TEST(ResourceAddressCacheTests, AddressesMatchGeneratedAddresses)
+{
+  ResourceAddressCache cache;
+
+  auto const &address = cache.Lookup("foo.bar", "balance");
+
+  EXPECT_EQ(address, StateAdapter::CreateAddress("foo.bar", "balance"));
+  EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST(ResourceAddressCacheTests, RepeatedLookupsAreInterned)
+{
+  ResourceAddressCache cache;
+
+  auto const *first  = &cache.Lookup("foo.bar", "balance");
+  auto const *second = &cache.Lookup("foo.bar", "balance");
+
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST(ResourceAddressCacheTests, KeysAreSeparatedByScope)
+{
+  ResourceAddressCache cache;
+
+  auto const first  = cache.Lookup("foo.bar", "balance");
+  auto const second = cache.Lookup("foo.baz", "balance");
+
+  EXPECT_FALSE(first == second);
+  EXPECT_EQ(second, StateAdapter::CreateAddress("foo.baz", "balance"));
+  EXPECT_EQ(cache.size(), 2u);
+}
+
+TEST(ResourceAddressCacheTests, CacheIsClearedWhenFull)
+{
+  ResourceAddressCache cache{4};
+
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    cache.Lookup("foo.bar", std::to_string(i));
+  }
+
+  EXPECT_EQ(cache.size(), 4u);
+
+  auto const &address = cache.Lookup("foo.bar", "4");
+
+  EXPECT_EQ(address, StateAdapter::CreateAddress("foo.bar", "4"));
+  EXPECT_EQ(cache.size(), 1u);
+}
+
+}  // namespace
@@ -0,0 +1,236 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/byte_array/byte_array.hpp"
+#include "core/digest.hpp"
+#include "core/serializers/main_serializer.hpp"
+#include "ledger/storage_unit/invertible_bloom_lookup_table.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+
+namespace {
+
+using fetch::Digest;
+using fetch::DigestSet;
+using fetch::byte_array::ByteArray;
+using fetch::ledger::InvertibleBloomLookupTable;
+using fetch::serializers::MsgPackSerializer;
+
+class InvertibleBloomLookupTableTests : public ::testing::Test
+{
+protected:
+  Digest GenerateDigest()
+  {
+    ByteArray digest;
+    digest.Resize(InvertibleBloomLookupTable::DIGEST_SIZE);
+    for (std::size_t i = 0; i < digest.size(); ++i)
+    {
+      digest[i] = static_cast<uint8_t>(rng_());
+    }
+
+    return {digest};
+  }
+
+  DigestSet GenerateDigests(std::size_t count)
+  {
+    DigestSet digests;
+    while (digests.size() < count)
+    {
+      digests.emplace(GenerateDigest());
+    }
+
+    return digests;
+  }
+
+  static InvertibleBloomLookupTable Build(DigestSet const &digests, std::size_t num_cells)
+  {
+    InvertibleBloomLookupTable table{num_cells};
+    for (auto const &digest : digests)
+    {
+      EXPECT_TRUE(table.Insert(digest));
+    }
+
+    return table;
+  }
+
+  std::mt19937_64 rng_{42};
+};
+
+TEST_F(InvertibleBloomLookupTableTests, CheckSymmetricDifferenceIsRecovered)
+{
+  auto const common      = GenerateDigests(5000);
+  auto const local_extra = GenerateDigests(40);
+  auto const peer_extra  = GenerateDigests(10);
+
+  DigestSet local{common};
+  local.insert(local_extra.begin(), local_extra.end());
+
+  DigestSet peer{common};
+  peer.insert(peer_extra.begin(), peer_extra.end());
+
+  auto const num_cells = InvertibleBloomLookupTable::CellsForDifference(50);
+
+  auto table = Build(local, num_cells);
+  ASSERT_TRUE(table.Subtract(Build(peer, num_cells)));
+
+  DigestSet local_only;
+  DigestSet peer_only;
+  ASSERT_TRUE(table.Decode(local_only, peer_only));
+
+  EXPECT_EQ(local_extra, local_only);
+  EXPECT_EQ(peer_extra, peer_only);
+}
+
+TEST_F(InvertibleBloomLookupTableTests, CheckIdenticalSetsCancel)
+{
+  auto const digests = GenerateDigests(1000);
+
+  auto table = Build(digests, InvertibleBloomLookupTable::MIN_CELLS);
+  EXPECT_FALSE(table.empty());
+
+  ASSERT_TRUE(table.Subtract(Build(digests, InvertibleBloomLookupTable::MIN_CELLS)));
+  EXPECT_TRUE(table.empty());
+}
+
+TEST_F(InvertibleBloomLookupTableTests, CheckOverloadedTableFailsToDecode)
+{
+  auto const num_cells = InvertibleBloomLookupTable::CellsForDifference(10);
+
+  auto table = Build(GenerateDigests(2000), num_cells);
+  ASSERT_TRUE(table.Subtract(Build(GenerateDigests(10), num_cells)));
+
+  DigestSet local_only;
+  DigestSet peer_only;
+  EXPECT_FALSE(table.Decode(local_only, peer_only));
+}
+
+TEST_F(InvertibleBloomLookupTableTests, CheckMisplacedEntryFailsToDecode)
+{
+  std::size_t const cell_size = InvertibleBloomLookupTable::CELL_SIZE;
+
+  auto const table = Build(GenerateDigests(1), InvertibleBloomLookupTable::MIN_CELLS);
+
+  // move the first occupied cell to another cell of the same partition, where peeling it can never
+  // empty it
+  ByteArray   encoded{table.ToBytes().Copy()};
+  std::size_t occupied{0};
+  while (encoded[occupied * cell_size] == 0)
+  {
+    ++occupied;
+  }
+
+  std::size_t const target = (occupied == 0) ? 1 : 0;
+  std::memcpy(encoded.pointer() + (target * cell_size), encoded.pointer() + (occupied * cell_size),
+              cell_size);
+  std::memset(encoded.pointer() + (occupied * cell_size), 0, cell_size);
+
+  InvertibleBloomLookupTable crafted;
+  ASSERT_TRUE(crafted.FromBytes(encoded));
+
+  DigestSet local_only;
+  DigestSet peer_only;
+  EXPECT_FALSE(crafted.Decode(local_only, peer_only));
+}
+
+TEST_F(InvertibleBloomLookupTableTests, CheckMismatchedSizesAreRejected)
+{
+  InvertibleBloomLookupTable small{InvertibleBloomLookupTable::MIN_CELLS};
+  InvertibleBloomLookupTable large{InvertibleBloomLookupTable::MIN_CELLS * 2};
+
+  EXPECT_FALSE(small.Subtract(large));
+  EXPECT_FALSE(small.Insert(Digest{"too short"}));
+}
+
+TEST_F(InvertibleBloomLookupTableTests, CheckSerialisation)
+{
+  auto const digests = GenerateDigests(20);
+  auto const table   = Build(digests, InvertibleBloomLookupTable::CellsForDifference(20));
+
+  MsgPackSerializer serializer;
+  serializer << table;
+  serializer.seek(0);
+
+  InvertibleBloomLookupTable recovered;
+  serializer >> recovered;
+  ASSERT_EQ(table.size(), recovered.size());
+
+  // subtracting an empty table leaves the original contents to be listed
+  ASSERT_TRUE(recovered.Subtract(InvertibleBloomLookupTable{recovered.size()}));
+
+  DigestSet local_only;
+  DigestSet peer_only;
+  ASSERT_TRUE(recovered.Decode(local_only, peer_only));
+  EXPECT_EQ(digests, local_only);
+  EXPECT_TRUE(peer_only.empty());
+
+  // invalid encodings are rejected
+  EXPECT_FALSE(recovered.FromBytes(table.ToBytes().SubArray(1)));
+}
+
+TEST_F(InvertibleBloomLookupTableTests, CheckOutOfRangeCountsAreRejected)
+{
+  InvertibleBloomLookupTable const empty{InvertibleBloomLookupTable::MIN_CELLS};
+
+  // overwrite the count of the first cell, which is at the start of the encoding
+  auto const encode = [&empty](int32_t count) {
+    ByteArray encoded{empty.ToBytes().Copy()};
+    std::memcpy(encoded.pointer(), &count, sizeof(count));
+    return encoded;
+  };
+
+  InvertibleBloomLookupTable table;
+  EXPECT_TRUE(table.FromBytes(encode(InvertibleBloomLookupTable::MAX_COUNT)));
+  EXPECT_TRUE(table.FromBytes(encode(-InvertibleBloomLookupTable::MAX_COUNT)));
+  EXPECT_FALSE(table.FromBytes(encode(InvertibleBloomLookupTable::MAX_COUNT + 1)));
+  EXPECT_FALSE(table.FromBytes(encode(std::numeric_limits<int32_t>::min())));
+  EXPECT_FALSE(table.FromBytes(encode(std::numeric_limits<int32_t>::max())));
+}
+
+TEST_F(InvertibleBloomLookupTableTests, CheckOverflowingSubtractionIsRejected)
+{
+  InvertibleBloomLookupTable const empty{InvertibleBloomLookupTable::MIN_CELLS};
+
+  ByteArray encoded{empty.ToBytes().Copy()};
+  int32_t   count{InvertibleBloomLookupTable::MAX_COUNT};
+  std::memcpy(encoded.pointer(), &count, sizeof(count));
+
+  InvertibleBloomLookupTable high;
+  ASSERT_TRUE(high.FromBytes(encoded));
+
+  count = -InvertibleBloomLookupTable::MAX_COUNT;
+  std::memcpy(encoded.pointer(), &count, sizeof(count));
+
+  InvertibleBloomLookupTable low;
+  ASSERT_TRUE(low.FromBytes(encoded));
+
+  // the subtraction is refused and the table is left unchanged
+  auto const before = high.ToBytes();
+  EXPECT_FALSE(high.Subtract(low));
+  EXPECT_EQ(before, high.ToBytes());
+
+  EXPECT_TRUE(low.Subtract(InvertibleBloomLookupTable{low}));
+  EXPECT_TRUE(low.empty());
+}
+
+}  // namespace
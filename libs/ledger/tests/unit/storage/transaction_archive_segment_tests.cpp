@@ -0,0 +1,218 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "transaction_generator.hpp"
+
+#include "chain/transaction.hpp"
+#include "core/byte_array/byte_array.hpp"
+#include "ledger/storage_unit/transaction_archive_segment.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+using fetch::ledger::TransactionArchiveSegment;
+using fetch::byte_array::ByteArray;
+using fetch::chain::Transaction;
+
+using TxArray = TransactionArchiveSegment::TxArray;
+
+class TransactionArchiveSegmentTests : public ::testing::Test
+{
+protected:
+  static constexpr char const *SEGMENT_FILENAME = "transaction_archive_segment_tests.seg";
+
+  TxArray GenerateTxs(std::size_t count)
+  {
+    TxArray txs{};
+    for (auto const &tx : tx_gen_.GenerateRandomTxs(count))
+    {
+      txs.emplace_back(*tx);
+    }
+
+    return txs;
+  }
+
+  TransactionGenerator tx_gen_;
+};
+
+TEST_F(TransactionArchiveSegmentTests, CheckLookup)
+{
+  auto const txs = GenerateTxs(300);
+
+  ASSERT_TRUE(TransactionArchiveSegment::Write(SEGMENT_FILENAME, txs));
+
+  TransactionArchiveSegment segment{};
+  ASSERT_TRUE(segment.Open(SEGMENT_FILENAME));
+  EXPECT_EQ(segment.size(), txs.size());
+
+  for (auto const &tx : txs)
+  {
+    Transaction retrieved{};
+
+    ASSERT_TRUE(segment.Has(tx.digest()));
+    ASSERT_TRUE(segment.Get(tx.digest(), retrieved));
+    EXPECT_EQ(retrieved.digest(), tx.digest());
+  }
+
+  for (auto const &tx : GenerateTxs(50))
+  {
+    Transaction retrieved{};
+
+    EXPECT_FALSE(segment.Has(tx.digest()));
+    EXPECT_FALSE(segment.Get(tx.digest(), retrieved));
+  }
+}
+
+TEST_F(TransactionArchiveSegmentTests, CheckPullSubtree)
+{
+  static constexpr uint64_t BIT_COUNT = 3;
+
+  auto const txs = GenerateTxs(200);
+
+  ASSERT_TRUE(TransactionArchiveSegment::Write(SEGMENT_FILENAME, txs));
+
+  TransactionArchiveSegment segment{};
+  ASSERT_TRUE(segment.Open(SEGMENT_FILENAME));
+
+  std::size_t total{0};
+  for (uint8_t prefix = 0; prefix < (1u << BIT_COUNT); ++prefix)
+  {
+    ByteArray partial;
+    partial.Resize(32);
+    std::fill(partial.pointer(), partial.pointer() + partial.size(), uint8_t{0});
+    partial[0] = prefix;
+
+    TxArray pulled{};
+    auto const count = segment.PullSubtree(partial, BIT_COUNT, txs.size(), pulled);
+
+    auto const expected = static_cast<std::size_t>(
+        std::count_if(txs.begin(), txs.end(), [&partial](Transaction const &tx) {
+          return TransactionArchiveSegment::MatchesPrefix(tx.digest(), partial, BIT_COUNT);
+        }));
+
+    EXPECT_EQ(count, expected);
+    ASSERT_EQ(pulled.size(), expected);
+
+    for (auto const &tx : pulled)
+    {
+      EXPECT_TRUE(TransactionArchiveSegment::MatchesPrefix(tx.digest(), partial, BIT_COUNT));
+    }
+
+    // check that the pull limit is respected
+    TxArray limited{};
+    EXPECT_EQ(segment.PullSubtree(partial, BIT_COUNT, 1, limited),
+              std::min<std::size_t>(1u, expected));
+
+    total += pulled.size();
+  }
+
+  EXPECT_EQ(total, txs.size());
+}
+
+TEST_F(TransactionArchiveSegmentTests, CheckMerge)
+{
+  static constexpr char const *OLDER_FILENAME = "transaction_archive_segment_tests.older.seg";
+  static constexpr char const *NEWER_FILENAME = "transaction_archive_segment_tests.newer.seg";
+
+  auto const older_txs = GenerateTxs(150);
+  auto       newer_txs = GenerateTxs(100);
+
+  // a transaction present in both segments must only be stored once
+  newer_txs.emplace_back(older_txs.front());
+
+  ASSERT_TRUE(TransactionArchiveSegment::Write(OLDER_FILENAME, older_txs));
+  ASSERT_TRUE(TransactionArchiveSegment::Write(NEWER_FILENAME, newer_txs));
+
+  TransactionArchiveSegment older{};
+  TransactionArchiveSegment newer{};
+  ASSERT_TRUE(older.Open(OLDER_FILENAME));
+  ASSERT_TRUE(newer.Open(NEWER_FILENAME));
+
+  ASSERT_TRUE(TransactionArchiveSegment::Merge(SEGMENT_FILENAME, older, newer));
+
+  TransactionArchiveSegment merged{};
+  ASSERT_TRUE(merged.Open(SEGMENT_FILENAME));
+  EXPECT_EQ(merged.size(), older_txs.size() + newer_txs.size() - 1);
+
+  TxArray all_txs{older_txs};
+  all_txs.insert(all_txs.end(), newer_txs.begin(), newer_txs.end());
+
+  for (auto const &tx : all_txs)
+  {
+    Transaction retrieved{};
+
+    ASSERT_TRUE(merged.Get(tx.digest(), retrieved));
+    EXPECT_EQ(retrieved.digest(), tx.digest());
+  }
+}
+
+TEST_F(TransactionArchiveSegmentTests, CheckCorruptFooter)
+{
+  ASSERT_TRUE(TransactionArchiveSegment::Write(SEGMENT_FILENAME, GenerateTxs(100)));
+
+  // overwrite the number of bloom filter words, which is the last field in the footer
+  {
+    std::fstream stream{SEGMENT_FILENAME, std::ios::in | std::ios::out | std::ios::binary};
+    ASSERT_TRUE(stream.is_open());
+
+    uint64_t const num_bloom_words = uint64_t{1} << 40u;
+    stream.seekp(-static_cast<std::streamoff>(sizeof(num_bloom_words)), std::ios::end);
+    stream.write(reinterpret_cast<char const *>(&num_bloom_words), sizeof(num_bloom_words));
+  }
+
+  TransactionArchiveSegment segment{};
+  EXPECT_FALSE(segment.Open(SEGMENT_FILENAME));
+}
+
+TEST_F(TransactionArchiveSegmentTests, CheckTruncatedSegment)
+{
+  auto const txs = GenerateTxs(100);
+
+  ASSERT_TRUE(TransactionArchiveSegment::Write(SEGMENT_FILENAME, txs));
+
+  std::string contents{};
+  {
+    std::ifstream stream{SEGMENT_FILENAME, std::ios::in | std::ios::binary};
+    contents.assign(std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{});
+  }
+
+  // drop a record from the start of the file, leaving the footer intact
+  {
+    std::ofstream stream{SEGMENT_FILENAME, std::ios::out | std::ios::binary | std::ios::trunc};
+    stream << contents.substr(contents.size() / 2);
+  }
+
+  TransactionArchiveSegment segment{};
+  EXPECT_FALSE(segment.Open(SEGMENT_FILENAME));
+}
+
+TEST_F(TransactionArchiveSegmentTests, CheckMissingSegment)
+{
+  TransactionArchiveSegment segment{};
+  EXPECT_FALSE(segment.Open("transaction_archive_segment_tests.missing.seg"));
+}
+
+}  // namespace
@@ -21,14 +21,34 @@
 #include "chain/transaction.hpp"
 #include "chain/transaction_builder.hpp"
 #include "ledger/storage_unit/transaction_store.hpp"
+#include "storage/storage_exception.hpp"
 
 #include "gtest/gtest.h"
 
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
 #include <vector>
 
 namespace {
 
 using fetch::ledger::TransactionStore;
+using fetch::storage::StorageException;
+
+constexpr char const *TIERED_DOC_FILE   = "transaction_store_tiered_tests.db";
+constexpr char const *TIERED_INDEX_FILE = "transaction_store_tiered_tests.index.db";
+
+bool FileExists(std::string const &filename)
+{
+  return std::ifstream{filename}.is_open();
+}
+
+std::string SegmentFilename(uint64_t id)
+{
+  return std::string{TIERED_DOC_FILE} + ".seg" + std::to_string(id);
+}
 
 class TransactionStoreTests : public ::testing::Test
 {
@@ -83,4 +103,185 @@ TEST_F(TransactionStoreTests, SimpleCheck)
   }
 }
 
+TEST_F(TransactionStoreTests, CheckArchivedTransactions)
+{
+  static constexpr std::size_t SEGMENT_SIZE = 10;
+
+  auto const txs = tx_gen_.GenerateRandomTxs(25);
+
+  {
+    TransactionStore store{SEGMENT_SIZE};
+    store.New(TIERED_DOC_FILE, TIERED_INDEX_FILE);
+
+    for (auto const &tx : txs)
+    {
+      store.Add(*tx);
+    }
+
+    store.WaitForArchive();
+
+    // adding an archived transaction a second time must not duplicate it
+    store.Add(*txs.front());
+
+    EXPECT_EQ(store.GetCount(), txs.size());
+  }
+
+  TransactionStore store{SEGMENT_SIZE};
+  store.Load(TIERED_DOC_FILE, TIERED_INDEX_FILE);
+
+  EXPECT_EQ(store.GetCount(), txs.size());
+
+  for (auto const &tx : txs)
+  {
+    fetch::chain::Transaction retrieved{};
+
+    ASSERT_TRUE(store.Has(tx->digest()));
+    ASSERT_TRUE(store.Get(tx->digest(), retrieved));
+    EXPECT_EQ(retrieved.digest(), tx->digest());
+  }
+
+  // pulling the complete tree must return every transaction exactly once
+  auto const pulled = store.PullSubtree(txs.front()->digest(), 0, txs.size() * 2);
+  EXPECT_EQ(pulled.size(), txs.size());
+}
+
+TEST_F(TransactionStoreTests, CheckConcurrentAddsAreCountedOnce)
+{
+  static constexpr std::size_t NUM_THREADS = 4;
+
+  auto const txs = tx_gen_.GenerateRandomTxs(200);
+
+  // every thread adds every transaction, starting together
+  std::atomic<bool>        start{false};
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < NUM_THREADS; ++i)
+  {
+    threads.emplace_back([this, &txs, &start]() {
+      while (!start)
+      {
+        std::this_thread::yield();
+      }
+
+      for (auto const &tx : txs)
+      {
+        store_.Add(*tx);
+      }
+    });
+  }
+
+  start = true;
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_EQ(store_.GetCount(), txs.size());
+}
+
+TEST_F(TransactionStoreTests, CheckArchivedSegmentsAreMerged)
+{
+  static constexpr std::size_t SEGMENT_SIZE = 10;
+  static constexpr std::size_t NUM_BATCHES  = 7;
+
+  auto const txs = tx_gen_.GenerateRandomTxs(SEGMENT_SIZE * NUM_BATCHES);
+
+  TransactionStore store{SEGMENT_SIZE};
+  store.New(TIERED_DOC_FILE, TIERED_INDEX_FILE);
+
+  for (std::size_t i = 0; i < txs.size(); ++i)
+  {
+    store.Add(*txs.at(i));
+
+    if (((i + 1) % SEGMENT_SIZE) == 0)
+    {
+      store.WaitForArchive();
+    }
+  }
+
+  // seven segments of ten transactions are merged into segments of 40, 20 and 10
+  EXPECT_EQ(store.GetSegmentCount(), 3u);
+  EXPECT_EQ(store.GetCount(), txs.size());
+
+  for (auto const &tx : txs)
+  {
+    fetch::chain::Transaction retrieved{};
+
+    ASSERT_TRUE(store.Get(tx->digest(), retrieved));
+    EXPECT_EQ(retrieved.digest(), tx->digest());
+  }
+
+  // the inputs of the merges are removed
+  EXPECT_FALSE(FileExists(SegmentFilename(0)));
+}
+
+TEST_F(TransactionStoreTests, CheckMissingSegmentIsRejected)
+{
+  static constexpr std::size_t SEGMENT_SIZE = 10;
+
+  auto const txs = tx_gen_.GenerateRandomTxs(SEGMENT_SIZE);
+
+  {
+    TransactionStore store{SEGMENT_SIZE};
+    store.New(TIERED_DOC_FILE, TIERED_INDEX_FILE);
+
+    for (auto const &tx : txs)
+    {
+      store.Add(*tx);
+    }
+
+    store.WaitForArchive();
+    EXPECT_EQ(store.GetSegmentCount(), 1u);
+  }
+
+  ASSERT_EQ(std::remove(SegmentFilename(0).c_str()), 0);
+
+  TransactionStore store{SEGMENT_SIZE};
+  EXPECT_THROW(store.Load(TIERED_DOC_FILE, TIERED_INDEX_FILE), StorageException);
+}
+
+TEST_F(TransactionStoreTests, CheckSegmentFilenamesAreNotReused)
+{
+  static constexpr std::size_t SEGMENT_SIZE = 10;
+
+  auto const txs = tx_gen_.GenerateRandomTxs(SEGMENT_SIZE * 2);
+
+  {
+    TransactionStore store{SEGMENT_SIZE};
+    store.New(TIERED_DOC_FILE, TIERED_INDEX_FILE);
+
+    for (std::size_t i = 0; i < SEGMENT_SIZE; ++i)
+    {
+      store.Add(*txs.at(i));
+    }
+
+    store.WaitForArchive();
+  }
+
+  // simulate a segment which was written but never added to the manifest
+  std::ofstream{SegmentFilename(1)} << "partial segment";
+
+  TransactionStore store{SEGMENT_SIZE};
+  store.Load(TIERED_DOC_FILE, TIERED_INDEX_FILE);
+
+  for (std::size_t i = SEGMENT_SIZE; i < txs.size(); ++i)
+  {
+    store.Add(*txs.at(i));
+  }
+
+  store.WaitForArchive();
+
+  // the new segment (2) is merged with the first (0) to form the final segment (3)
+  EXPECT_FALSE(FileExists(SegmentFilename(1)));
+  EXPECT_FALSE(FileExists(SegmentFilename(2)));
+  EXPECT_TRUE(FileExists(SegmentFilename(3)));
+
+  EXPECT_EQ(store.GetSegmentCount(), 1u);
+  EXPECT_EQ(store.GetCount(), txs.size());
+
+  for (auto const &tx : txs)
+  {
+    ASSERT_TRUE(store.Has(tx->digest()));
+  }
+}
+
 }  // namespace
@@ -0,0 +1,106 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/fixed_point/fixed_point.hpp"
+#include "vectorise/memory/shared_array.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <cstdint>
+#include <vector>
+
+// Sizes are deliberately not multiples of the register width so that the partially covered
+// blocks at either end of the range are part of what is measured
+template <class T>
+void BM_Dispatcher_Ranged_Apply(benchmark::State &state)
+{
+  using ArrayType = fetch::memory::SharedArray<T>;
+
+  auto const size = static_cast<std::size_t>(state.range(0));
+
+  ArrayType a(size);
+  ArrayType b(size);
+  ArrayType c(size);
+
+  fetch::memory::Range const range(1, size);
+
+  a.in_parallel().Assign(range, T{1});
+  b.in_parallel().Assign(range, T{1});
+
+  for (auto _ : state)
+  {
+    c.in_parallel().RangedApplyMultiple(
+        range, [](auto const &x, auto const &y, auto &z) { z = x + y; }, a, b);
+  }
+
+  benchmark::DoNotOptimize(c.pointer());
+}
+
+template <class T>
+void BM_Dispatcher_Sum_Reduce(benchmark::State &state)
+{
+  using ArrayType = fetch::memory::SharedArray<T>;
+
+  auto const size = static_cast<std::size_t>(state.range(0));
+
+  ArrayType a(size);
+  ArrayType b(size);
+
+  fetch::memory::Range const range(1, size);
+
+  a.in_parallel().Assign(range, T{1});
+  b.in_parallel().Assign(range, T{1});
+
+  T ret{0};
+  for (auto _ : state)
+  {
+    ret = a.in_parallel().SumReduce(
+        range, [](auto const &x, auto const &y) { return x * y; }, b);
+    benchmark::DoNotOptimize(ret);
+  }
+}
+
+static void DispatcherArguments(benchmark::internal::Benchmark *b)
+{
+  std::vector<std::int64_t> const sizes{3, 7, 17, 31, 100, 1000, 10007, 100003, 1000003};
+
+  for (auto const &size : sizes)
+  {
+    b->Arg(size);
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_Dispatcher_Ranged_Apply, float)
+    ->Apply(DispatcherArguments)
+    ->Unit(::benchmark::kNanosecond);
+BENCHMARK_TEMPLATE(BM_Dispatcher_Ranged_Apply, double)
+    ->Apply(DispatcherArguments)
+    ->Unit(::benchmark::kNanosecond);
+BENCHMARK_TEMPLATE(BM_Dispatcher_Ranged_Apply, fetch::fixed_point::fp32_t)
+    ->Apply(DispatcherArguments)
+    ->Unit(::benchmark::kNanosecond);
+
+BENCHMARK_TEMPLATE(BM_Dispatcher_Sum_Reduce, float)
+    ->Apply(DispatcherArguments)
+    ->Unit(::benchmark::kNanosecond);
+BENCHMARK_TEMPLATE(BM_Dispatcher_Sum_Reduce, double)
+    ->Apply(DispatcherArguments)
+    ->Unit(::benchmark::kNanosecond);
+BENCHMARK_TEMPLATE(BM_Dispatcher_Sum_Reduce, fetch::fixed_point::fp32_t)
+    ->Apply(DispatcherArguments)
+    ->Unit(::benchmark::kNanosecond);
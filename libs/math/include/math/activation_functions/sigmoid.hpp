@@ -23,38 +23,95 @@
 namespace fetch {
 namespace math {
 
+namespace details {
+
+template <typename Type>
+void SigmoidElement(Type const &x, Type &ret)
+{
+  if (x >= Type{0})
+  {
+    // f(x) = 1 / (1 + e^-x)
+    Exp(static_cast<Type>(-x), ret);
+    Divide(Type{1}, static_cast<Type>(1 + ret), ret);
+  }
+  else
+  {
+    Exp(x, ret);
+    Divide(ret, static_cast<Type>(ret + Type{1}), ret);
+  }
+}
+
 /**
- * The sigmoid function - numerically stable
- * @tparam ArrayType
- * @param t
- * @param ret
+ * Vectorised sigmoid which matches the scalar version bit for bit. Registers holding NaN or an
+ * infinity are handed to the scalar version, since the special cases differ between branches.
  */
+template <typename VectorRegisterType>
+VectorRegisterType VectorSigmoid(VectorRegisterType const &x)
+{
+  using Type = typename VectorRegisterType::type;
+
+  VectorRegisterType const one(Type{1});
+
+  if (any_equal_to(VectorRegisterType::MaskNaN(x) |
+                       (x == VectorRegisterType::MaskPosInf()) |
+                       (x == VectorRegisterType::MaskNegInf()),
+                   VectorRegisterType::MaskAllBits()))
+  {
+    alignas(VectorRegisterType::E_REGISTER_SIZE) Type values[VectorRegisterType::E_BLOCK_COUNT];
+    x.Store(values);
+    for (auto &value : values)
+    {
+      SigmoidElement(Type{value}, value);
+    }
+    return VectorRegisterType{values};
+  }
+
+  // e^-|x| is e^-x for the positive branch and e^x for the negative one
+  VectorRegisterType const e        = fetch::vectorise::Exp(-fetch::vectorise::Abs(x));
+  VectorRegisterType const negative = x < VectorRegisterType::_0();
+
+  return ((negative & e) | (~negative & one)) / (e + one);
+}
+
 template <typename ArrayType>
-void Sigmoid(ArrayType const &t, ArrayType &ret)
+void SigmoidImplementation(ArrayType const &t, ArrayType &ret, std::true_type /*exact_vector*/)
 {
   using Type = typename ArrayType::Type;
 
+  ApplyByColumn(
+      t, ret, [](auto const &x) { return VectorSigmoid(x); },
+      [](Type const &x, Type &y) { SigmoidElement(x, y); });
+}
+
+template <typename ArrayType>
+void SigmoidImplementation(ArrayType const &t, ArrayType &ret, std::false_type /*exact_vector*/)
+{
   auto array_it = t.cbegin();
   auto rit      = ret.begin();
 
   while (array_it.is_valid())
   {
-    if (*array_it >= Type{0})
-    {
-      // f(x) = 1 / (1 + e^-x)
-      Exp(static_cast<Type>(-*array_it), *rit);
-      Divide(Type{1}, static_cast<Type>(1 + *rit), *rit);
-    }
-    else
-    {
-      Exp(*array_it, *rit);
-      Divide(*rit, static_cast<Type>(*rit + Type{1}), *rit);
-    }
+    SigmoidElement(*array_it, *rit);
     ++array_it;
     ++rit;
   }
 }
 
+}  // namespace details
+
+/**
+ * The sigmoid function - numerically stable
+ * @tparam ArrayType
+ * @param t
+ * @param ret
+ */
+template <typename ArrayType>
+void Sigmoid(ArrayType const &t, ArrayType &ret)
+{
+  details::SigmoidImplementation(t, ret,
+                                 details::HasExactVectorFunctions<typename ArrayType::Type>{});
+}
+
 template <typename ArrayType>
 ArrayType Sigmoid(ArrayType const &t)
 {
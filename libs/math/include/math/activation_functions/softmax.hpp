@@ -47,15 +47,24 @@ void Softmax1DImplementation(ArrayType1 const &array, ArrayType2 &ret)
 
   auto it1 = array.begin();
   auto it2 = ret.begin();
-  auto sum = Type(0);
   while (it1.is_valid())
   {
-    *it2 = static_cast<Type>(Exp(*it1 - array_max));
-    sum  = static_cast<Type>(sum + *it2);
+    *it2 = static_cast<Type>(*it1 - array_max);
     ++it2;
     ++it1;
   }
 
+  // exponentiate in a separate pass so that the vectorised implementation can be used
+  Exp(ret, ret);
+
+  auto sum    = Type(0);
+  auto it_sum = ret.cbegin();
+  while (it_sum.is_valid())
+  {
+    sum = static_cast<Type>(sum + *it_sum);
+    ++it_sum;
+  }
+
   auto it3 = ret.begin();  // TODO (private 855): Fix implicitly deleted copy const. for iterator
   while (it3.is_valid())
   {
@@ -19,8 +19,7 @@
 
 #include "core/random.hpp"
 #include "core/vector.hpp"
-#include "math/distance/euclidean.hpp"
-#include "math/standard_functions/pow.hpp"
+#include "math/distance/pairwise_distance.hpp"
 #include "math/tensor/tensor.hpp"
 
 #include <algorithm>
@@ -63,12 +62,25 @@ class KMeansImplementation
   using ArrayOfSizeType = typename fetch::math::Tensor<SizeType>;
 
 public:
+  /**
+   * The constructor for the KMeans implementation object
+   * @param data the data itself in the format of a 2D array of n_points x n_dims
+   * @param n_clusters the number K of clusters to identify
+   * @param ret the return matrix of shape n_points x 1 with values in range 0 -> K-1
+   * @param r_seed a random seed for the data shuffling
+   * @param max_loops maximum number of loops before assuming convergence
+   * @param init_mode what type of initialisation to use
+   * @param max_no_change_convergence number of loops without change that counts as convergence
+   * @param batch_size number of data points per mini-batch update, 0 for full batch updates.
+   * Batches larger than the data set are clamped to its size
+   */
   KMeansImplementation(ArrayType const &data, SizeType const &n_clusters, ClusteringType &ret,
                        SizeType const &r_seed, SizeType const &max_loops, InitMode init_mode,
-                       SizeType max_no_change_convergence)
+                       SizeType max_no_change_convergence, SizeType batch_size = 0)
     : n_clusters_(n_clusters)
     , max_no_change_convergence_(max_no_change_convergence)
     , max_loops_(max_loops)
+    , batch_size_(batch_size)
     , init_mode_(init_mode)
   {
 
@@ -79,7 +91,16 @@ public:
 
     KMeansSetup(data, r_seed);
 
-    ComputeKMeans(data, ret);
+    if (batch_size_ > 0)
+    {
+      // a batch can not hold more than the whole data set
+      batch_size_ = std::min(batch_size_, n_points_);
+      ComputeMiniBatchKMeans(data);
+    }
+    else
+    {
+      ComputeKMeans(data, ret);
+    }
 
     // assign the final output
     ret = k_assignment_;
@@ -161,8 +182,6 @@ public:
     lfg_.Seed(uint32_t(r_seed));
     loop_counter_ = 0;
 
-    temp_k_ = ArrayType(data.shape());
-
     // instantiate counter with zeros
     InitialiseKMeans(data);
 
@@ -180,8 +199,6 @@ public:
       reassigned_k_.Set(j, -1);
     }
 
-    // initialise size of euclidean distance container
-    k_euclids_      = fetch::core::Vector<ArrayType>(n_clusters_);
     empty_clusters_ = fetch::core::Vector<SizeType>(n_clusters_);
   };
 
@@ -199,6 +216,57 @@ private:
     UnReassign();
   }
 
+  /**
+   * Mini-batch KMeans (Sculley, 2010): every loop assigns a random batch of data points to their
+   * nearest cluster centre and moves each of those centres towards its points with a per-centre
+   * learning rate of 1 / (number of points it has seen so far). A final assignment of the full
+   * data set produces the output.
+   */
+  void ComputeMiniBatchKMeans(ArrayType const &data)
+  {
+    fetch::core::Vector<SizeType> centre_count(n_clusters_, 0);
+
+    ArrayType batch({batch_size_, n_dimensions_});
+    SizeType  next_idx = 0;
+
+    for (loop_counter_ = 0; loop_counter_ < max_loops_; ++loop_counter_)
+    {
+      // draw the batch without replacement, reshuffling once every data point has been used
+      if (next_idx + batch_size_ > n_points_)
+      {
+        fetch::random::Shuffle(lfg_, data_idxs_, data_idxs_);
+        next_idx = 0;
+      }
+
+      for (SizeType j = 0; j < n_dimensions_; ++j)
+      {
+        for (SizeType i = 0; i < batch_size_; ++i)
+        {
+          batch(i, j) = data(data_idxs_[next_idx + i], j);
+        }
+      }
+
+      fetch::math::distance::PairWiseSquareEuclidean(batch, k_means_, k_distances_);
+
+      for (SizeType i = 0; i < batch_size_; ++i)
+      {
+        SizeType const cur_k = NearestCluster(i);
+
+        ++centre_count[cur_k];
+        auto const count = static_cast<DataType>(centre_count[cur_k]);
+        for (SizeType j = 0; j < n_dimensions_; ++j)
+        {
+          k_means_(cur_k, j) += (batch(i, j) - k_means_(cur_k, j)) / count;
+        }
+      }
+
+      next_idx += batch_size_;
+    }
+
+    Assign(data);
+    UnReassign();
+  }
+
   /**
    * kmeans cluster centre initialisation
    * This is very important for defining the behaviour of the clustering algorithm
@@ -440,61 +508,32 @@ private:
       k_means_.Set(0, j, data.At(data_idxs_[0], j));
     }
 
-    // assign remaining cluster centres
-    SizeType n_remaining_data_points = n_points_ - 1;
-    SizeType n_remaining_clusters    = n_clusters_ - 1;
+    // weight for choosing each data point, i.e. its squared distance to the nearest centre so far
+    fetch::core::Vector<DataType> weights(n_points_, numeric_max<DataType>());
+    fetch::core::Vector<DataType> interval(n_points_ + 1);  // interval for defining distribution
+    std::iota(std::begin(interval), std::end(interval), 0);  // fill interval with range
 
     fetch::core::Vector<SizeType> assigned_data_points{data_idxs_[0]};
-
-    fetch::core::Vector<ArrayType> cluster_distances(n_clusters_);
-    SizeType                       assigned_cluster = 0;
-
-    fetch::core::Vector<DataType> weights(n_points_);   // weight for choosing each data point
-    fetch::core::Vector<DataType> interval(n_points_);  // interval for defining random distribution
-    std::iota(std::begin(interval), std::end(interval), 0);  // fill interval with range
+    ArrayType                     centre({1, n_dimensions_});
 
     for (SizeType cur_cluster = 1; cur_cluster < n_clusters_; ++cur_cluster)
     {
-      // calculate distances to all clusters
-      for (SizeType i = 0; i < (n_clusters_ - n_remaining_clusters); ++i)
+      // only the distances to the latest centre are new, the others are kept in the weights
+      for (SizeType j = 0; j < n_dimensions_; ++j)
       {
-        for (SizeType l = 0; l < n_points_; ++l)
-        {
-          for (SizeType k = 0; k < n_dimensions_; ++k)
-          {
-            temp_k_.Set(l, k, k_means_.At(i, k));
-          }
-        }
-
-        cluster_distances.at(i) = fetch::math::distance::EuclideanMatrix(data, temp_k_, 1);
+        centre(0, j) = k_means_.At(cur_cluster - 1, j);
       }
+      fetch::math::distance::PairWiseSquareEuclidean(data, centre, k_distances_);
 
-      // select smallest distance to cluster for each data point and square
       for (SizeType m = 0; m < n_points_; ++m)
       {
-        // ignore already assigned data points
-        if (std::find(assigned_data_points.begin(), assigned_data_points.end(), m) ==
-            assigned_data_points.end())
-        {
-          running_mean_ = numeric_max<DataType>();
-          for (SizeType i = 0; i < (n_clusters_ - n_remaining_clusters); ++i)
-          {
-            if (cluster_distances[i][m] < running_mean_)
-            {
-              running_mean_    = cluster_distances[i][m];
-              assigned_cluster = i;
-            }
-          }
-          weights[m] = cluster_distances[assigned_cluster][m];
-        }
-        else
-        {
-          weights[m] = 0;
-        }
+        weights[m] = std::min(weights[m], k_distances_(m, 0));
       }
-      for (auto &val : weights)
+
+      // already assigned data points must not be chosen again
+      for (SizeType assigned_data_point : assigned_data_points)
       {
-        fetch::math::Square(val, val);
+        weights[assigned_data_point] = DataType{0};
       }
 
       // select point as new cluster centre
@@ -509,12 +548,8 @@ private:
 
       for (SizeType j = 0; j < n_dimensions_; ++j)
       {
-        k_means_.Set(cur_cluster, j, data.At(assigned_data_points.back(), j));
+        k_means_.Set(cur_cluster, j, data.At(tmp_rand, j));
       }
-
-      // update count of remaining data points and clusters
-      --n_remaining_data_points;
-      --n_remaining_clusters;
     }
   }
 
@@ -524,37 +559,17 @@ private:
    */
   void Assign(ArrayType const &data)
   {
-    // replicate kmeans which is 1 x n_dims into n_data x n_dims
-    // allows for easy call to Euclidean
-    for (SizeType i = 0; i < n_clusters_; ++i)
-    {
-      for (SizeType j = 0; j < n_points_; ++j)
-      {
-        for (SizeType k = 0; k < n_dimensions_; ++k)
-        {
-          temp_k_.Set(j, k, k_means_.At(i, k));
-        }
-      }
-      k_euclids_[i] = fetch::math::distance::EuclideanMatrix(data, temp_k_, 1);
-    }
+    // squared distances rank the clusters the same way as distances, without the square roots
+    fetch::math::distance::PairWiseSquareEuclidean(data, k_means_, k_distances_);
 
-    // now we have a vector of n_data x 1 Arrays
-    // we have to go through and compare which is smallest for each K and make the assignment
+    // compare which cluster is closest for each data point and make the assignment
     std::fill(k_count_.begin(), k_count_.end(), 0);
 
     for (SizeType i = 0; i < n_points_; ++i)
     {
-      running_mean_ = numeric_max<DataType>();
-      for (SizeType j = 0; j < n_clusters_; ++j)
-      {
-        if (k_euclids_[j][i] < running_mean_)
-        {
-          running_mean_ = k_euclids_[j][i];
-          assigned_k_   = static_cast<DataType>(j);
-        }
-      }
-      k_assignment_.Set(i, assigned_k_);
-      ++k_count_[static_cast<SizeType>(assigned_k_)];
+      SizeType const cur_k = NearestCluster(i);
+      k_assignment_.Set(i, static_cast<typename ClusteringType::Type>(cur_k));
+      ++k_count_[cur_k];
     }
 
     // sometimes we get an empty cluster - in these cases we should reassign one data point to that
@@ -562,6 +577,24 @@ private:
     Reassign();
   }
 
+  /**
+   * Finds the cluster with the smallest distance in row i of the current distance matrix
+   */
+  SizeType NearestCluster(SizeType i) const
+  {
+    SizeType nearest  = 0;
+    DataType smallest = numeric_max<DataType>();
+    for (SizeType j = 0; j < n_clusters_; ++j)
+    {
+      if (k_distances_(i, j) < smallest)
+      {
+        smallest = k_distances_(i, j);
+        nearest  = j;
+      }
+    }
+    return nearest;
+  }
+
   /**
    * Method assigns a random data point to each empty cluster
    */
@@ -731,10 +764,7 @@ private:
   SizeType max_no_change_convergence_ = INVALID;  // max no change k_assignment before convergence
   SizeType loop_counter_              = INVALID;
   SizeType max_loops_                 = INVALID;
-  DataType assigned_k_                = numeric_max<DataType>();  // current cluster to assign
-
-  // used to find the smallest distance out of K comparisons
-  DataType running_mean_ = numeric_max<DataType>();
+  SizeType batch_size_                = 0;  // data points per mini-batch, 0 for full batch
 
   fetch::random::LaggedFibonacciGenerator<> lfg_;
 
@@ -743,15 +773,14 @@ private:
 
   ArrayType k_means_;       // current cluster centres
   ArrayType prev_k_means_;  // previous cluster centres (for checking convergence)
-  ArrayType temp_k_;        // a container for ease of access to using Euclidean function
+  ArrayType k_distances_;   // squared distances of data points (rows) to cluster centres
 
   ClusteringType k_assignment_;  // current data to cluster assignment
   ClusteringType
                  prev_k_assignment_;  // previous data to cluster assignment (for checkign convergence)
   ClusteringType reassigned_k_;       // reassigned data to cluster assignment
 
-  fetch::core::Vector<SizeType>  k_count_;    // count of how many data points assigned per cluster
-  fetch::core::Vector<ArrayType> k_euclids_;  // container for current euclid distances
+  fetch::core::Vector<SizeType> k_count_;  // count of how many data points assigned per cluster
 
   // map previously assigned clusters to current clusters
   std::unordered_map<SizeType, SizeType>
@@ -808,6 +837,53 @@ ClusteringType KMeans(ArrayType const &data, typename ArrayType::SizeType const
   return ret;
 }
 
+/**
+ * Interface to mini-batch KMeans, which updates the cluster centres from a random batch of data
+ * points per loop rather than from the whole data set. This trades a little clustering quality
+ * for a cost per loop that does not depend on the number of data points.
+ * @tparam ArrayType    fetch library Array type
+ * @param data          input data to cluster in format n_data x n_dims
+ * @param r_seed        random seed
+ * @param K             number of clusters
+ * @param batch_size    number of data points per batch, clamped to the number of data points
+ * @param max_loops     number of batches to process
+ * @return              ArrayType of format n_data x 1 with values indicating cluster
+ */
+template <typename ArrayType>
+ClusteringType MiniBatchKMeans(ArrayType const &data, typename ArrayType::SizeType const &r_seed,
+                               typename ArrayType::SizeType const &K,
+                               typename ArrayType::SizeType const &batch_size,
+                               typename ArrayType::SizeType        max_loops = 100,
+                               InitMode                            init_mode = InitMode::KMeansPP)
+{
+  using SizeType = fetch::math::SizeType;
+  using DataType = typename ArrayType::Type;
+
+  SizeType n_points = data.shape()[0];
+
+  assert(K <= n_points);  // you can't have more clusters than data points
+  assert(K > 1);          // why would you run k means clustering with only one cluster?
+  assert(batch_size > 0);
+
+  ClusteringType ret{n_points};
+
+  if (n_points == K)  // very easy to cluster!
+  {
+    for (SizeType i = 0; i < n_points; ++i)
+    {
+      ret[i] = static_cast<DataType>(i);
+    }
+  }
+  else  // real work happens in these cases
+  {
+    // mini-batch loops do not test for convergence, all max_loops batches are processed
+    details::KMeansImplementation<ArrayType>(data, K, ret, r_seed, max_loops, init_mode, 0,
+                                             batch_size);
+  }
+
+  return ret;
+}
+
 /**
  * Interface to KMeans algorithm
  * @tparam ArrayType        fetch library Array type
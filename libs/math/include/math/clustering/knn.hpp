@@ -17,8 +17,14 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/macros.hpp"
 #include "math/distance/cosine.hpp"
+#include "math/distance/pairwise_distance.hpp"
+#include "math/fundamental_operators.hpp"
+#include "math/matrix_operations.hpp"
+#include "math/standard_functions/sqrt.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <utility>
 #include <vector>
@@ -28,14 +34,36 @@ namespace math {
 namespace clustering {
 namespace details {
 
-template <typename ArrayType,
-          typename ArrayType::Type (*Distance)(ArrayType const &, ArrayType const &)>
-std::vector<std::pair<typename ArrayType::SizeType, typename ArrayType::Type>> KNNImplementation(
-    ArrayType array, ArrayType vec, typename ArrayType::SizeType k)
+/**
+ * Returns the k entries with the smallest distance, sorted by ascending distance
+ */
+template <typename SizeType, typename DataType>
+std::vector<std::pair<SizeType, DataType>> NearestK(
+    std::vector<std::pair<SizeType, DataType>> similarities, SizeType k)
 {
-  using DataType = typename ArrayType::Type;
-  using SizeType = fetch::math::SizeType;
+  auto const closer = [](std::pair<SizeType, DataType> const &a,
+                         std::pair<SizeType, DataType> const &b) { return a.second < b.second; };
 
+  // partial sort first K values
+  std::nth_element(similarities.begin(), similarities.begin() + unsigned(k), similarities.end(),
+                   closer);
+
+  // fill the return container with the partial sort top k
+  std::vector<std::pair<SizeType, DataType>> ret(similarities.begin(),
+                                                 similarities.begin() + unsigned(k));
+
+  // sort the top k values
+  std::sort(ret.begin(), ret.end(), closer);
+
+  return ret;
+}
+
+/**
+ * Identifies the axis of array along which the features of the data points are laid out
+ */
+template <typename ArrayType>
+typename ArrayType::SizeType FeatureAxis(ArrayType const &array, ArrayType const &vec)
+{
   assert(vec.shape().size() == 2);
   assert(array.shape().size() == 2);
 
@@ -46,48 +74,98 @@ std::vector<std::pair<typename ArrayType::SizeType, typename ArrayType::Type>> K
   assert(((array.shape().at(1) == vec.shape().at(1)) && (vec.shape().at(0) == 1)) ||
          ((array.shape().at(0) == vec.shape().at(0)) && (vec.shape().at(1) == 1)));
 
-  SizeType feature_axis;
-  SizeType data_axis;
+  FETCH_UNUSED(array);
+
   if (vec.shape().at(0) == 1)
   {
-    feature_axis = 1;
+    return 1;
   }
-  else
-  {
-    feature_axis = 0;
-  }
-  data_axis = 1 - feature_axis;
+  return 0;
+}
 
-  std::vector<std::pair<SizeType, DataType>> similarities;
-  std::vector<std::pair<SizeType, DataType>> ret;
+template <typename ArrayType,
+          typename ArrayType::Type (*Distance)(ArrayType const &, ArrayType const &)>
+std::vector<std::pair<typename ArrayType::SizeType, typename ArrayType::Type>> KNNImplementation(
+    ArrayType array, ArrayType vec, typename ArrayType::SizeType k)
+{
+  using DataType = typename ArrayType::Type;
+  using SizeType = fetch::math::SizeType;
 
-  similarities.reserve(array.shape().at(data_axis));
+  SizeType const feature_axis = FeatureAxis(array, vec);
+  SizeType const data_axis    = 1 - feature_axis;
+  SizeType const n_points     = array.shape().at(data_axis);
+
+  std::vector<std::pair<SizeType, DataType>> similarities(n_points);
 
   // compute distances
-  for (SizeType i = 0; i < array.shape().at(data_axis); ++i)
+  auto const compute = [&array, &vec, &similarities, data_axis](SizeType begin, SizeType end) {
+    for (SizeType i = begin; i < end; ++i)
+    {
+      similarities[i] = std::make_pair(i, Distance(vec, array.Slice(i, data_axis).Copy()));
+    }
+  };
+
+  distance::details::ForEachRowBlock<DataType>(n_points, array.shape().at(feature_axis), compute);
+
+  return NearestK(std::move(similarities), k);
+}
+
+/**
+ * Cosine distances between vec and every data point of array, computed with a single matrix
+ * product instead of one call to the distance function per data point
+ */
+template <typename ArrayType>
+std::vector<std::pair<typename ArrayType::SizeType, typename ArrayType::Type>>
+KNNCosineImplementation(ArrayType const &array, ArrayType const &vec,
+                        typename ArrayType::SizeType k)
+{
+  using DataType = typename ArrayType::Type;
+  using SizeType = fetch::math::SizeType;
+
+  SizeType const feature_axis = FeatureAxis(array, vec);
+  SizeType const n_points     = array.shape().at(1 - feature_axis);
+
+  ArrayType products;
+  if (feature_axis == 1)
+  {
+    DotTranspose(array, vec, products);
+  }
+  else
   {
-    DataType d = Distance(vec, array.Slice(i, data_axis).Copy());
-    similarities.emplace_back(i, d);
+    TransposeDot(array, vec, products);
   }
 
-  // partial sort first K values
-  std::nth_element(similarities.begin(), similarities.begin() + unsigned(k), similarities.end(),
-                   [](std::pair<SizeType, DataType> const &a,
-                      std::pair<SizeType, DataType> const &b) { return a.second < b.second; });
+  std::vector<DataType> norms(n_points, DataType{0});
+  for (SizeType j = 0; j < array.shape().at(1); ++j)
+  {
+    for (SizeType i = 0; i < array.shape().at(0); ++i)
+    {
+      DataType const value = array(i, j);
+      norms[(feature_axis == 1) ? i : j] += value * value;
+    }
+  }
 
-  // fill the return container with the partial sort top k
-  for (SizeType i(0); i < k; ++i)
+  DataType vec_norm{0};
+  for (auto it = vec.cbegin(); it.is_valid(); ++it)
   {
-    ret.emplace_back(std::make_pair(similarities.at(i).first, similarities.at(i).second));
+    vec_norm += (*it) * (*it);
   }
+  fetch::math::Sqrt(vec_norm, vec_norm);
 
-  // sort the top k values
-  std::sort(ret.begin(), ret.end(),
-            [](std::pair<SizeType, DataType> const &a, std::pair<SizeType, DataType> const &b) {
-              return a.second < b.second;
-            });
+  std::vector<std::pair<SizeType, DataType>> similarities;
+  similarities.reserve(n_points);
 
-  return ret;
+  for (SizeType i = 0; i < n_points; ++i)
+  {
+    DataType norm;
+    DataType r;
+    fetch::math::Sqrt(norms[i], norm);
+    fetch::math::Multiply(norm, vec_norm, norm);
+    fetch::math::Divide(products(i, SizeType{0}), norm, r);
+    similarities.emplace_back(i, static_cast<DataType>(DataType{1} - r));
+  }
+
+  return NearestK(std::move(similarities), k);
 }
 
 }  // namespace details
@@ -105,7 +183,7 @@ template <typename ArrayType>
 std::vector<std::pair<typename ArrayType::SizeType, typename ArrayType::Type>> KNNCosine(
     ArrayType array, ArrayType vec, typename ArrayType::SizeType k)
 {
-  return details::KNNImplementation<ArrayType, fetch::math::distance::Cosine>(array, vec, k);
+  return details::KNNCosineImplementation(array, vec, k);
 }
 
 /**
@@ -121,7 +199,7 @@ std::vector<std::pair<typename ArrayType::SizeType, typename ArrayType::Type>> K
     ArrayType array, typename ArrayType::SizeType idx, typename ArrayType::SizeType k)
 {
   ArrayType vec = array.slice(idx);
-  return details::KNNImplementation<ArrayType, fetch::math::distance::Cosine>(array, vec, k);
+  return details::KNNCosineImplementation(array, vec, k);
 }
 
 /**
@@ -19,12 +19,76 @@
 
 #include "core/assert.hpp"
 #include "math/base_types.hpp"
+#include "math/matrix_operations.hpp"
 #include "math/meta/math_type_traits.hpp"
+#include "vectorise/memory/parallel_dispatcher.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
 
 namespace fetch {
 namespace math {
 namespace distance {
 
+namespace details {
+
+constexpr SizeType ROW_BLOCK_SIZE = 256;
+
+/**
+ * Calls function(begin, end) for consecutive blocks of rows covering [0, rows). The blocks are
+ * spread over the dispatch pool once the total work, estimated as rows * cost_per_row, reaches
+ * the pool threshold; otherwise the function is called once for the whole range.
+ */
+template <typename DataType, typename F>
+void ForEachRowBlock(SizeType rows, SizeType cost_per_row, F &&function)
+{
+  SizeType const blocks = (rows + ROW_BLOCK_SIZE - 1) / ROW_BLOCK_SIZE;
+
+  if ((blocks > 1) && (rows * cost_per_row >= memory::DispatchPool::threshold()))
+  {
+    memory::DispatchChunks<DataType>(blocks, [rows, &function](std::size_t block) {
+      SizeType const begin = block * ROW_BLOCK_SIZE;
+      function(begin, std::min(rows, begin + ROW_BLOCK_SIZE));
+    });
+  }
+  else
+  {
+    function(SizeType{0}, rows);
+  }
+}
+
+/**
+ * Squared euclidean norm of every row of a 2D array
+ */
+template <typename ArrayType>
+std::vector<typename ArrayType::Type> RowSquareNorms(ArrayType const &a)
+{
+  using DataType = typename ArrayType::Type;
+
+  std::vector<DataType> norms(a.shape(0), DataType{0});
+  for (SizeType j = 0; j < a.shape(1); ++j)
+  {
+    for (SizeType i = 0; i < a.shape(0); ++i)
+    {
+      DataType const value = a(i, j);
+      norms[i] += value * value;
+    }
+  }
+
+  return norms;
+}
+
+}  // namespace details
+
+/**
+ * Computes the metric between every pair of rows of a. The rows are spread over the dispatch
+ * pool for large inputs, in which case the metric is called concurrently and must not have side
+ * effects.
+ * @param a array of shape # data points x # feature dimensions
+ * @param metric function returning the distance between two rows
+ * @param ret condensed distance matrix of shape 1 x (n * (n - 1) / 2)
+ */
 template <typename ArrayType, typename F>
 meta::IfIsMathArray<ArrayType, ArrayType> &PairWiseDistance(ArrayType const &a, F &&metric,
                                                             ArrayType &ret)
@@ -33,17 +97,156 @@ meta::IfIsMathArray<ArrayType, ArrayType> &PairWiseDistance(ArrayType const &a,
   detailed_assert(ret.shape(1) == (a.shape(0) * (a.shape(0) - 1) / 2));
   detailed_assert(ret.shape().size() == 2);
 
-  SizeType k = 0;
+  using DataType = typename ArrayType::Type;
 
-  for (SizeType i = 0; i < a.shape(0); ++i)
-  {
-    // todo: #1320 Implement isiterable with math library and then the copies here can be removed.
-    ArrayType slice1 = a.Slice(i).Copy();
-    for (SizeType j = i + 1; j < a.shape(0); ++j)
+  SizeType const n_points = a.shape(0);
+
+  auto const compute = [&a, &metric, &ret, n_points](SizeType begin, SizeType end) {
+    for (SizeType i = begin; i < end; ++i)
+    {
+      // the pairs of all earlier rows precede the pairs of row i in the condensed matrix
+      SizeType k = (i * (2 * n_points - i - 1)) / 2;
+
+      // todo: #1320 Implement isiterable with math library and then the copies here can be
+      // removed.
+      ArrayType slice1 = a.Slice(i).Copy();
+      for (SizeType j = i + 1; j < n_points; ++j)
+      {
+        ArrayType slice2      = a.Slice(j).Copy();
+        ret(SizeType{0}, k++) = metric(slice1, slice2);
+      }
+    }
+  };
+
+  details::ForEachRowBlock<DataType>(n_points, n_points * a.shape(1) / 2, compute);
+
+  return ret;
+}
+
+namespace details {
+
+/**
+ * Squared euclidean distances as |x|^2 + |y|^2 - 2 x.y, so that the bulk of the work is a single
+ * matrix product through the vectorised Blas kernels
+ */
+template <typename ArrayType>
+void SquareEuclideanByNorms(ArrayType const &a, ArrayType const &b, ArrayType &ret)
+{
+  using DataType = typename ArrayType::Type;
+
+  SizeType const n_points     = a.shape(0);
+  SizeType const n_references = b.shape(0);
+  SizeType const n_dimensions = a.shape(1);
+
+  std::vector<DataType> const a_norms = RowSquareNorms(a);
+  std::vector<DataType> const b_norms = RowSquareNorms(b);
+
+  auto const compute = [&](SizeType begin, SizeType end) {
+    SizeType const rows = end - begin;
+
+    ArrayType products;
+    if (rows == n_points)
+    {
+      DotTranspose(a, b, products);
+    }
+    else
+    {
+      ArrayType block({rows, n_dimensions});
+      for (SizeType j = 0; j < n_dimensions; ++j)
+      {
+        for (SizeType i = 0; i < rows; ++i)
+        {
+          block(i, j) = a(begin + i, j);
+        }
+      }
+      DotTranspose(block, b, products);
+    }
+
+    for (SizeType j = 0; j < n_references; ++j)
+    {
+      for (SizeType i = 0; i < rows; ++i)
+      {
+        // rounding can take the distance between (nearly) identical points below zero
+        DataType const distance =
+            a_norms[begin + i] + b_norms[j] - static_cast<DataType>(2) * products(i, j);
+        ret(begin + i, j) = std::max(DataType{0}, distance);
+      }
+    }
+  };
+
+  ForEachRowBlock<DataType>(n_points, n_references * n_dimensions, compute);
+}
+
+/**
+ * Squared euclidean distances as the sum of (x - y)^2. The norms of fixed point rows saturate
+ * long before their distances do (an fp32 norm overflows once the coordinates exceed ~181), and
+ * the difference of two large norms loses the precision of nearby points.
+ */
+template <typename ArrayType>
+void SquareEuclideanByDifferences(ArrayType const &a, ArrayType const &b, ArrayType &ret)
+{
+  using DataType = typename ArrayType::Type;
+
+  SizeType const n_points     = a.shape(0);
+  SizeType const n_references = b.shape(0);
+  SizeType const n_dimensions = a.shape(1);
+
+  auto const compute = [&](SizeType begin, SizeType end) {
+    for (SizeType j = 0; j < n_references; ++j)
     {
-      ArrayType slice2      = a.Slice(j).Copy();
-      ret(SizeType{0}, k++) = metric(slice1, slice2);
+      for (SizeType i = begin; i < end; ++i)
+      {
+        DataType distance{0};
+        for (SizeType k = 0; k < n_dimensions; ++k)
+        {
+          DataType const difference = a(i, k) - b(j, k);
+          distance += difference * difference;
+        }
+        ret(i, j) = distance;
+      }
     }
+  };
+
+  ForEachRowBlock<DataType>(n_points, n_references * n_dimensions, compute);
+}
+
+}  // namespace details
+
+/**
+ * Computes the squared euclidean distance between every row of a and every row of b. Floating
+ * point types expand it as |x|^2 + |y|^2 - 2 x.y, so that the bulk of the work is a single matrix
+ * product; fixed point types sum (x - y)^2 directly, since their norms saturate. Blocks of rows of
+ * a are spread over the dispatch pool for large inputs.
+ * @param a array of shape # data points x # feature dimensions
+ * @param b array of shape # reference points x # feature dimensions
+ * @param ret array of shape # data points x # reference points, resized if necessary
+ */
+template <typename ArrayType>
+meta::IfIsMathArray<ArrayType, ArrayType> &PairWiseSquareEuclidean(ArrayType const &a,
+                                                                   ArrayType const &b,
+                                                                   ArrayType &      ret)
+{
+  using DataType = typename ArrayType::Type;
+
+  assert(a.shape().size() == 2);
+  assert(b.shape().size() == 2);
+  assert(a.shape(1) == b.shape(1));
+
+  SizeType const n_points     = a.shape(0);
+  SizeType const n_references = b.shape(0);
+
+  if (ret.shape() != std::vector<SizeType>({n_points, n_references}))
+  {
+    ret.Resize({n_points, n_references});
+  }
+
+  if (meta::IsFixedPoint<DataType>)
+  {
+    details::SquareEuclideanByDifferences(a, b, ret);
+  }
+  else
+  {
+    details::SquareEuclideanByNorms(a, b, ret);
   }
 
   return ret;
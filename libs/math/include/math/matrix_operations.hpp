@@ -1125,7 +1125,7 @@ fetch::math::meta::IfIsMathArray<ArrayType, void> DotTranspose(ArrayType const &
     throw exceptions::WrongShape("expected A and B to have same width.");
   }
 
-  if (ret.shape() != std::vector<SizeType>({aview.height(), bview.width()}))
+  if (ret.shape() != std::vector<SizeType>({aview.height(), bview.height()}))
   {
     ret.Resize({aview.height(), bview.height()});
   }
@@ -1176,7 +1176,7 @@ fetch::math::meta::IfIsMathArray<ArrayType, void> TransposeDot(ArrayType const &
     throw exceptions::WrongShape("expected A and B to have same height.");
   }
 
-  if (ret.shape() != std::vector<SizeType>({aview.height(), bview.width()}))
+  if (ret.shape() != std::vector<SizeType>({aview.width(), bview.width()}))
   {
     ret.Resize({aview.width(), bview.width()});
   }
@@ -17,11 +17,13 @@
 //
 //------------------------------------------------------------------------------
 
+#include "math/base_types.hpp"
 #include "math/meta/math_type_traits.hpp"
 #include "vectorise/fixed_point/fixed_point.hpp"
 #include "vectorise/math/standard_functions.hpp"
 
 #include <cassert>
+#include <type_traits>
 
 /**
  * e^x
@@ -59,20 +61,79 @@ meta::IfIsArithmetic<Type, Type> Exp(Type const &x)
   return ret;
 }
 
+namespace details {
+
+/**
+ * Types for which fetch::vectorise::Exp, Log, Sqrt and TanH give exactly the same results (and
+ * fp_state flags) as the scalar implementations, so that they can be used on tensors without
+ * affecting determinism
+ */
+template <typename T>
+struct HasExactVectorFunctions : std::false_type
+{
+};
+
+#ifdef __AVX2__
+template <>
+struct HasExactVectorFunctions<fixed_point::fp32_t> : std::true_type
+{
+};
+#endif
+
+/**
+ * Apply a vectorised kernel down each column of a tensor, using the scalar version for the rows
+ * which do not fill a whole register. The padding at the end of each column is left untouched.
+ * @param array the input tensor
+ * @param ret the output tensor, which has the same shape as array and may be array itself
+ */
+template <typename ArrayType, typename VectorFunction, typename ScalarFunction>
+void ApplyByColumn(ArrayType const &array, ArrayType &ret, VectorFunction const &vector_function,
+                   ScalarFunction const &scalar_function)
+{
+  using Type               = typename ArrayType::Type;
+  using VectorRegisterType = typename ArrayType::VectorRegisterType;
+
+  constexpr SizeType BLOCK_COUNT = VectorRegisterType::E_BLOCK_COUNT;
+
+  if (array.size() == 0)
+  {
+    return;
+  }
+
+  SizeType const height  = array.shape().front();
+  SizeType const columns = array.size() / height;
+  SizeType const blocked = height - (height % BLOCK_COUNT);
+
+  for (SizeType column = 0; column < columns; ++column)
+  {
+    Type const *in  = array.data().pointer() + (column * array.padded_height());
+    Type *      out = ret.data().pointer() + (column * ret.padded_height());
+
+    SizeType row = 0;
+    for (; row < blocked; row += BLOCK_COUNT)
+    {
+      vector_function(VectorRegisterType(in + row)).Store(out + row);
+    }
+    for (; row < height; ++row)
+    {
+      scalar_function(in[row], out[row]);
+    }
+  }
+}
+
 template <typename ArrayType>
-meta::IfIsMathArray<ArrayType, void> Exp(ArrayType const &array, ArrayType &ret)
+void ExpImplementation(ArrayType const &array, ArrayType &ret, std::true_type /*exact_vector*/)
 {
-  assert(ret.shape() == array.shape());
+  using Type = typename ArrayType::Type;
+
+  ApplyByColumn(
+      array, ret, [](auto const &x) { return fetch::vectorise::Exp(x); },
+      [](Type const &x, Type &y) { y = Type::Exp(x); });
+}
 
-  // TODO(ML-523); re-enable vectorisation only after replacing exp implementation
-  // with one that does not require expensive divisions
-  //  if (array.size() >= array.data().padded_size())
-  //  {
-  //    ret.data().in_parallel().Apply([](auto const &a, auto &c) { c = fetch::vectorise::Exp(a); },
-  //                                   array.data());
-  //  }
-  //  else
-  //  {
+template <typename ArrayType>
+void ExpImplementation(ArrayType const &array, ArrayType &ret, std::false_type /*exact_vector*/)
+{
   auto it1 = array.cbegin();
   auto rit = ret.begin();
   while (it1.is_valid())
@@ -81,7 +142,16 @@ meta::IfIsMathArray<ArrayType, void> Exp(ArrayType const &array, ArrayType &ret)
     ++it1;
     ++rit;
   }
-  //  }
+}
+
+}  // namespace details
+
+template <typename ArrayType>
+meta::IfIsMathArray<ArrayType, void> Exp(ArrayType const &array, ArrayType &ret)
+{
+  assert(ret.shape() == array.shape());
+  details::ExpImplementation(array, ret,
+                             details::HasExactVectorFunctions<typename ArrayType::Type>{});
 }
 
 template <typename ArrayType>
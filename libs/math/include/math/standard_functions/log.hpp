@@ -18,8 +18,10 @@
 //------------------------------------------------------------------------------
 
 #include "math/meta/math_type_traits.hpp"
+#include "math/standard_functions/exp.hpp"
 
 #include <cassert>
+#include <type_traits>
 
 /**
  * natural logarithm of x
@@ -84,10 +86,21 @@ meta::IfIsArithmetic<Type, Type> Log(Type const &x)
   return ret;
 }
 
+namespace details {
+
 template <typename ArrayType>
-meta::IfIsMathArray<ArrayType, void> Log(ArrayType const &array, ArrayType &ret)
+void LogImplementation(ArrayType const &array, ArrayType &ret, std::true_type /*exact_vector*/)
+{
+  using Type = typename ArrayType::Type;
+
+  ApplyByColumn(
+      array, ret, [](auto const &x) { return fetch::vectorise::Log(x); },
+      [](Type const &x, Type &y) { y = Type::Log(x); });
+}
+
+template <typename ArrayType>
+void LogImplementation(ArrayType const &array, ArrayType &ret, std::false_type /*exact_vector*/)
 {
-  assert(ret.shape() == array.shape());
   auto it1 = array.cbegin();
   auto rit = ret.begin();
   while (it1.is_valid())
@@ -98,6 +111,16 @@ meta::IfIsMathArray<ArrayType, void> Log(ArrayType const &array, ArrayType &ret)
   }
 }
 
+}  // namespace details
+
+template <typename ArrayType>
+meta::IfIsMathArray<ArrayType, void> Log(ArrayType const &array, ArrayType &ret)
+{
+  assert(ret.shape() == array.shape());
+  details::LogImplementation(array, ret,
+                             details::HasExactVectorFunctions<typename ArrayType::Type>{});
+}
+
 template <typename ArrayType>
 meta::IfIsMathArray<ArrayType, ArrayType> Log(ArrayType const &array)
 {
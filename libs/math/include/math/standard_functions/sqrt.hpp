@@ -18,8 +18,10 @@
 //------------------------------------------------------------------------------
 
 #include "math/meta/math_type_traits.hpp"
+#include "math/standard_functions/exp.hpp"
 
 #include <cassert>
+#include <type_traits>
 
 namespace fetch {
 namespace math {
@@ -54,10 +56,21 @@ meta::IfIsArithmetic<Type, Type> Sqrt(Type const &x)
   return ret;
 }
 
+namespace details {
+
 template <typename ArrayType>
-meta::IfIsMathArray<ArrayType, void> Sqrt(ArrayType const &array, ArrayType &ret)
+void SqrtImplementation(ArrayType const &array, ArrayType &ret, std::true_type /*exact_vector*/)
+{
+  using Type = typename ArrayType::Type;
+
+  ApplyByColumn(
+      array, ret, [](auto const &x) { return fetch::vectorise::Sqrt(x); },
+      [](Type const &x, Type &y) { y = Type::Sqrt(x); });
+}
+
+template <typename ArrayType>
+void SqrtImplementation(ArrayType const &array, ArrayType &ret, std::false_type /*exact_vector*/)
 {
-  assert(ret.shape() == array.shape());
   auto arr_it = array.cbegin();
   auto rit    = ret.begin();
 
@@ -69,6 +82,16 @@ meta::IfIsMathArray<ArrayType, void> Sqrt(ArrayType const &array, ArrayType &ret
   }
 }
 
+}  // namespace details
+
+template <typename ArrayType>
+meta::IfIsMathArray<ArrayType, void> Sqrt(ArrayType const &array, ArrayType &ret)
+{
+  assert(ret.shape() == array.shape());
+  details::SqrtImplementation(array, ret,
+                              details::HasExactVectorFunctions<typename ArrayType::Type>{});
+}
+
 template <typename ArrayType>
 meta::IfIsMathArray<ArrayType, ArrayType> Sqrt(ArrayType const &array)
 {
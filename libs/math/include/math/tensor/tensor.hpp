@@ -40,6 +40,9 @@
 namespace fetch {
 namespace math {
 
+template <typename Derived>
+class TensorExpression;
+
 template <typename T, typename C>
 class Tensor
 {
@@ -150,6 +153,12 @@ public:
   Tensor &operator=(ConstSliceType const &slice);
   Tensor &operator=(TensorSlice const &slice);
 
+  // Evaluation of lazy expressions (see tensor_expression.hpp)
+  template <typename Derived>
+  Tensor(TensorExpression<Derived> const &expression);  // NOLINT
+  template <typename Derived>
+  Tensor &operator=(TensorExpression<Derived> const &expression);
+
   void Fill(Type const &value, memory::Range const &&range);
   void Fill(Type const &value);
   void SetAllZero();
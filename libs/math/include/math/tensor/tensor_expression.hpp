@@ -0,0 +1,447 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "math/base_types.hpp"
+#include "math/exceptions/exceptions.hpp"
+#include "math/tensor/tensor.hpp"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace fetch {
+namespace math {
+
+/**
+ * Lazy element-wise arithmetic on tensors.
+ *
+ * Combining tensors with the usual operators allocates a temporary for every intermediate result
+ * and makes a separate pass over memory for each operation. Wrapping the operands with Lazy
+ * instead builds an expression which is only evaluated when it is assigned to a tensor, in a
+ * single pass and without any temporaries, e.g.
+ *
+ *   Tensor<double> d = Lazy(a) * Lazy(b) + Lazy(c);
+ *   Evaluate(Lazy(a) * 2.0 - Lazy(c), d);
+ *
+ * Operands of the same rank are broadcast along their dimensions of size 1. Every element is
+ * computed with the same operations, in the same order, as the equivalent chain of eager
+ * operations. Floating point tensors are evaluated with vector registers, while all other types
+ * (including fixed point) are evaluated element by element with their own operators, so that
+ * their results are bit for bit identical to the eager operations.
+ */
+template <typename Derived>
+class TensorExpression
+{
+public:
+  Derived const &self() const
+  {
+    return static_cast<Derived const &>(*this);
+  }
+};
+
+namespace details {
+
+template <typename V, typename T>
+std::enable_if_t<std::is_same<V, T>::value, V> LoadValue(T const *pointer)
+{
+  return *pointer;
+}
+
+template <typename V, typename T>
+std::enable_if_t<!std::is_same<V, T>::value, V> LoadValue(T const *pointer)
+{
+  return V(pointer);
+}
+
+template <typename T>
+constexpr bool IsVectorisable()
+{
+  return std::is_floating_point<T>::value;
+}
+
+/**
+ * Merge the shape of an operand into the shape of the result of an expression
+ */
+inline bool MergeBroadcastShape(SizeVector const &operand, SizeVector &shape)
+{
+  if (shape.empty())
+  {
+    shape = operand;
+    return true;
+  }
+
+  if (operand.size() != shape.size())
+  {
+    return false;
+  }
+
+  for (std::size_t i = 0; i < shape.size(); ++i)
+  {
+    if (shape[i] == 1)
+    {
+      shape[i] = operand[i];
+    }
+    else if ((operand[i] != 1) && (operand[i] != shape[i]))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace details
+
+/**
+ * A tensor operand of an expression. Holds a (shallow) copy of the tensor, so that the operand
+ * remains valid even when the result of the expression is written over the same tensor.
+ */
+template <typename T, typename C>
+class TensorTerminal : public TensorExpression<TensorTerminal<T, C>>
+{
+public:
+  using Type       = T;
+  using TensorType = Tensor<T, C>;
+
+  explicit TensorTerminal(TensorType const &tensor)
+    : tensor_{tensor}
+  {}
+
+  bool BroadcastShape(SizeVector &shape) const
+  {
+    return details::MergeBroadcastShape(tensor_.shape(), shape);
+  }
+
+  void Prepare(SizeVector const &shape)
+  {
+    data_ = tensor_.data().pointer();
+
+    // dimensions which are broadcast do not advance through the tensor
+    strides_ = tensor_.stride();
+    for (std::size_t i = 0; i < shape.size(); ++i)
+    {
+      if (tensor_.shape(i) != shape[i])
+      {
+        strides_[i] = 0;
+      }
+    }
+  }
+
+  void Seek(SizeVector const &index)
+  {
+    base_ = 0;
+    for (std::size_t i = 1; i < index.size(); ++i)
+    {
+      base_ += index[i] * strides_[i];
+    }
+  }
+
+  template <typename V>
+  V Load(SizeType row) const
+  {
+    if (strides_[0] == 0)
+    {
+      return V(data_[base_]);
+    }
+
+    return details::LoadValue<V>(data_ + base_ + row);
+  }
+
+private:
+  TensorType tensor_;
+  SizeVector strides_{};
+  T const *  data_{nullptr};
+  SizeType   base_{0};
+};
+
+/**
+ * A scalar operand of an expression, which applies to every element
+ */
+template <typename T>
+class ScalarTerminal : public TensorExpression<ScalarTerminal<T>>
+{
+public:
+  using Type = T;
+
+  explicit ScalarTerminal(T const &value)
+    : value_{value}
+  {}
+
+  bool BroadcastShape(SizeVector & /*shape*/) const
+  {
+    return true;
+  }
+
+  void Prepare(SizeVector const & /*shape*/)
+  {}
+
+  void Seek(SizeVector const & /*index*/)
+  {}
+
+  template <typename V>
+  V Load(SizeType /*row*/) const
+  {
+    return V(value_);
+  }
+
+private:
+  T value_;
+};
+
+/**
+ * The element-wise application of an operation to two expressions
+ */
+template <typename Op, typename L, typename R>
+class BinaryExpression : public TensorExpression<BinaryExpression<Op, L, R>>
+{
+public:
+  using Type = typename L::Type;
+
+  static_assert(std::is_same<Type, typename R::Type>::value,
+                "operands of an expression must have the same type");
+
+  BinaryExpression(L lhs, R rhs)
+    : lhs_{std::move(lhs)}
+    , rhs_{std::move(rhs)}
+  {}
+
+  bool BroadcastShape(SizeVector &shape) const
+  {
+    return lhs_.BroadcastShape(shape) && rhs_.BroadcastShape(shape);
+  }
+
+  void Prepare(SizeVector const &shape)
+  {
+    lhs_.Prepare(shape);
+    rhs_.Prepare(shape);
+  }
+
+  void Seek(SizeVector const &index)
+  {
+    lhs_.Seek(index);
+    rhs_.Seek(index);
+  }
+
+  template <typename V>
+  V Load(SizeType row) const
+  {
+    return Op::Apply(lhs_.template Load<V>(row), rhs_.template Load<V>(row));
+  }
+
+private:
+  L lhs_;
+  R rhs_;
+};
+
+struct ExpressionAdd
+{
+  template <typename V>
+  static V Apply(V const &x, V const &y)
+  {
+    return static_cast<V>(x + y);
+  }
+};
+
+struct ExpressionSubtract
+{
+  template <typename V>
+  static V Apply(V const &x, V const &y)
+  {
+    return static_cast<V>(x - y);
+  }
+};
+
+struct ExpressionMultiply
+{
+  template <typename V>
+  static V Apply(V const &x, V const &y)
+  {
+    return static_cast<V>(x * y);
+  }
+};
+
+struct ExpressionDivide
+{
+  template <typename V>
+  static V Apply(V const &x, V const &y)
+  {
+    return static_cast<V>(x / y);
+  }
+};
+
+/**
+ * Start a lazy expression from a tensor
+ */
+template <typename T, typename C>
+TensorTerminal<T, C> Lazy(Tensor<T, C> const &tensor)
+{
+  return TensorTerminal<T, C>{tensor};
+}
+
+// NOLINTNEXTLINE
+#define FETCH_TENSOR_EXPRESSION_OPERATOR(OP, OPERATION)                                         \
+  template <typename L, typename R>                                                            \
+  BinaryExpression<OPERATION, L, R> operator OP(TensorExpression<L> const &lhs,                \
+                                                TensorExpression<R> const &rhs)                \
+  {                                                                                            \
+    return {lhs.self(), rhs.self()};                                                           \
+  }                                                                                            \
+                                                                                               \
+  template <typename L>                                                                        \
+  BinaryExpression<OPERATION, L, ScalarTerminal<typename L::Type>> operator OP(                \
+      TensorExpression<L> const &lhs, typename L::Type const &rhs)                             \
+  {                                                                                            \
+    return {lhs.self(), ScalarTerminal<typename L::Type>{rhs}};                                \
+  }                                                                                            \
+                                                                                               \
+  template <typename R>                                                                        \
+  BinaryExpression<OPERATION, ScalarTerminal<typename R::Type>, R> operator OP(                \
+      typename R::Type const &lhs, TensorExpression<R> const &rhs)                             \
+  {                                                                                            \
+    return {ScalarTerminal<typename R::Type>{lhs}, rhs.self()};                                \
+  }
+
+FETCH_TENSOR_EXPRESSION_OPERATOR(+, ExpressionAdd)
+FETCH_TENSOR_EXPRESSION_OPERATOR(-, ExpressionSubtract)
+FETCH_TENSOR_EXPRESSION_OPERATOR(*, ExpressionMultiply)
+FETCH_TENSOR_EXPRESSION_OPERATOR(/, ExpressionDivide)
+
+#undef FETCH_TENSOR_EXPRESSION_OPERATOR
+
+namespace details {
+
+template <typename VectorRegisterType, typename E, typename T>
+std::enable_if_t<IsVectorisable<T>()> EvaluateColumn(E const &expression, T *ret, SizeType height)
+{
+  constexpr SizeType BLOCK_COUNT = VectorRegisterType::E_BLOCK_COUNT;
+
+  SizeType row = 0;
+  for (; row + BLOCK_COUNT <= height; row += BLOCK_COUNT)
+  {
+    expression.template Load<VectorRegisterType>(row).Store(ret + row);
+  }
+
+  for (; row < height; ++row)
+  {
+    ret[row] = expression.template Load<T>(row);
+  }
+}
+
+template <typename VectorRegisterType, typename E, typename T>
+std::enable_if_t<!IsVectorisable<T>()> EvaluateColumn(E const &expression, T *ret,
+                                                      SizeType height)
+{
+  for (SizeType row = 0; row < height; ++row)
+  {
+    ret[row] = expression.template Load<T>(row);
+  }
+}
+
+}  // namespace details
+
+/**
+ * Evaluate an expression into a tensor, which is reshaped to the shape of the result if needed.
+ * The tensor may also be an operand of the expression.
+ *
+ * @param expression The expression to evaluate
+ * @param ret The tensor in which to store the result
+ */
+template <typename E, typename T, typename C>
+void Evaluate(TensorExpression<E> const &expression, Tensor<T, C> &ret)
+{
+  static_assert(std::is_same<typename E::Type, T>::value,
+                "the result of an expression must have the same type as its operands");
+  static_assert((Tensor<T, C>::PADDING % Tensor<T, C>::VectorRegisterType::E_BLOCK_COUNT) == 0,
+                "columns must be aligned to vector registers");
+
+  E expr = expression.self();
+
+  SizeVector shape;
+  if (!expr.BroadcastShape(shape) || shape.empty())
+  {
+    throw exceptions::WrongShape("tensors not broadcastable for expression");
+  }
+
+  if (ret.shape() != shape)
+  {
+    ret.Reshape(shape);
+  }
+
+  SizeType const height  = shape[0];
+  SizeType       columns = 1;
+  for (std::size_t i = 1; i < shape.size(); ++i)
+  {
+    columns *= shape[i];
+  }
+
+  if ((height == 0) || (columns == 0))
+  {
+    return;
+  }
+
+  expr.Prepare(shape);
+
+  T *const   data = ret.data().pointer();
+  SizeVector index(shape.size(), 0);
+  for (SizeType column = 0; column < columns; ++column)
+  {
+    SizeType base = 0;
+    for (std::size_t i = 1; i < index.size(); ++i)
+    {
+      base += index[i] * ret.stride()[i];
+    }
+
+    expr.Seek(index);
+    details::EvaluateColumn<typename Tensor<T, C>::VectorRegisterType>(expr, data + base, height);
+
+    // advance to the next column, with the second dimension changing fastest
+    for (std::size_t i = 1; i < index.size(); ++i)
+    {
+      if (++index[i] < shape[i])
+      {
+        break;
+      }
+      index[i] = 0;
+    }
+  }
+}
+
+template <typename T, typename C>
+template <typename Derived>
+Tensor<T, C>::Tensor(TensorExpression<Derived> const &expression)
+  : Tensor()
+{
+  Evaluate(expression, *this);
+}
+
+/**
+ * Assign the result of an expression, which is always stored in a new buffer (as for the eager
+ * operators) so that no other tensor sharing the current buffer is affected
+ */
+template <typename T, typename C>
+template <typename Derived>
+Tensor<T, C> &Tensor<T, C>::operator=(TensorExpression<Derived> const &expression)
+{
+  Tensor ret{expression};
+  *this = std::move(ret);
+  return *this;
+}
+
+}  // namespace math
+}  // namespace fetch
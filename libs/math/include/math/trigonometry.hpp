@@ -19,8 +19,10 @@
 
 #include "math/kernels/trigonometry.hpp"
 #include "math/meta/math_type_traits.hpp"
+#include "math/standard_functions/exp.hpp"
 
 #include <cassert>
+#include <type_traits>
 
 namespace fetch {
 namespace math {
@@ -240,14 +242,22 @@ fetch::math::meta::IfIsMathArray<ArrayType, ArrayType> CosH(ArrayType const &x)
   return ret;
 }
 
-/**
- * maps every element of the array x to ret = TanH(x)
- * @param x - array
- */
+namespace details {
+
 template <typename ArrayType>
-fetch::math::meta::IfIsMathArray<ArrayType, void> TanH(ArrayType const &x, ArrayType &ret)
+void TanHImplementation(ArrayType const &x, ArrayType &ret, std::true_type /*exact_vector*/)
+{
+  using Type = typename ArrayType::Type;
+
+  assert(ret.shape() == x.shape());
+  ApplyByColumn(
+      x, ret, [](auto const &v) { return fetch::vectorise::TanH(v); },
+      [](Type const &v, Type &y) { y = Type::TanH(v); });
+}
+
+template <typename ArrayType>
+void TanHImplementation(ArrayType const &x, ArrayType &ret, std::false_type /*exact_vector*/)
 {
-  assert(ret.size() == x.size());
   kernels::TanH s;
   auto          x_it = x.cbegin();
   auto          rit  = ret.begin();
@@ -259,6 +269,19 @@ fetch::math::meta::IfIsMathArray<ArrayType, void> TanH(ArrayType const &x, Array
   }
 }
 
+}  // namespace details
+
+/**
+ * maps every element of the array x to ret = TanH(x)
+ * @param x - array
+ */
+template <typename ArrayType>
+fetch::math::meta::IfIsMathArray<ArrayType, void> TanH(ArrayType const &x, ArrayType &ret)
+{
+  assert(ret.size() == x.size());
+  details::TanHImplementation(x, ret, details::HasExactVectorFunctions<typename ArrayType::Type>{});
+}
+
 template <typename ArrayType>
 fetch::math::meta::IfIsMathArray<ArrayType, ArrayType> TanH(ArrayType const &x)
 {
@@ -192,6 +192,34 @@ TYPED_TEST(SigmoidTest, sigmoid_11)
   ASSERT_TRUE(output.AllClose(numpy_output, fetch::math::function_tolerance<DataType>()));
 }
 
+// The vectorised fixed point path must match the element-wise implementation bit for bit,
+// including the column tails and the special values
+TYPED_TEST(SigmoidTest, sigmoid_matches_element_wise)
+{
+  using SizeType = fetch::math::SizeType;
+  using DataType = typename TypeParam::Type;
+
+  TypeParam input({13, 3});
+  for (SizeType i = 0; i < input.size(); ++i)
+  {
+    input[i] = fetch::math::AsType<DataType>((static_cast<double>(i) - 20.0) * 0.5);
+  }
+  input[SizeType{0}] = DataType{0};
+  input[SizeType{1}] = fetch::math::numeric_max<DataType>();
+  input[SizeType{2}] = fetch::math::numeric_lowest<DataType>();
+  input[SizeType{3}] = fetch::math::numeric_inf<DataType>();
+  input[SizeType{4}] = fetch::math::numeric_negative_inf<DataType>();
+
+  TypeParam output = fetch::math::Sigmoid(input);
+
+  for (SizeType i = 0; i < input.size(); ++i)
+  {
+    DataType expected;
+    fetch::math::details::SigmoidElement(input[i], expected);
+    EXPECT_EQ(output[i], expected) << "at index " << i;
+  }
+}
+
 }  // namespace test
 }  // namespace math
 }  // namespace fetch
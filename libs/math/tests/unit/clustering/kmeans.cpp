@@ -24,6 +24,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <set>
 #include <vector>
 
 using namespace fetch::math;
@@ -85,6 +86,81 @@ TEST(clustering_test, kmeans_test_2d_4k)
   }
 }
 
+TEST(clustering_test, mini_batch_kmeans_test_2d_4k)
+{
+  TensorType A({100, 2});
+  TensorType ret({100, 1});
+  SizeType   K = 4;
+
+  for (SizeType i = 0; i < 25; ++i)
+  {
+    A.Set(SizeType{i}, SizeType{0}, -static_cast<DataType>(i) - 50);
+    A.Set(SizeType{i}, SizeType{1}, -static_cast<DataType>(i) - 50);
+  }
+  for (SizeType i = 25; i < 50; ++i)
+  {
+    A.Set(SizeType{i}, SizeType{0}, -static_cast<DataType>(i) - 50);
+    A.Set(SizeType{i}, SizeType{1}, static_cast<DataType>(i) + 50);
+  }
+  for (SizeType i = 50; i < 75; ++i)
+  {
+    A.Set(SizeType{i}, SizeType{0}, static_cast<DataType>(i) + 50);
+    A.Set(SizeType{i}, SizeType{1}, -static_cast<DataType>(i) - 50);
+  }
+  for (SizeType i = 75; i < 100; ++i)
+  {
+    A.Set(SizeType{i}, SizeType{0}, static_cast<DataType>(i) + 50);
+    A.Set(SizeType{i}, SizeType{1}, static_cast<DataType>(i) + 50);
+  }
+
+  SizeType       random_seed = 123456;
+  SizeType       batch_size  = 20;
+  ClusteringType clusters =
+      fetch::math::clustering::MiniBatchKMeans(A, random_seed, K, batch_size);
+
+  SizeType group_0 = static_cast<SizeType>(clusters[0]);
+  for (SizeType j = 0; j < 25; ++j)
+  {
+    ASSERT_EQ(group_0, static_cast<SizeType>(clusters[j]));
+  }
+  SizeType group_1 = static_cast<SizeType>(clusters[25]);
+  for (SizeType j = 25; j < 50; ++j)
+  {
+    ASSERT_EQ(group_1, static_cast<SizeType>(clusters[j]));
+  }
+  SizeType group_2 = static_cast<SizeType>(clusters[50]);
+  for (SizeType j = 50; j < 75; ++j)
+  {
+    ASSERT_EQ(group_2, static_cast<SizeType>(clusters[j]));
+  }
+  SizeType group_3 = static_cast<SizeType>(clusters[75]);
+  for (SizeType j = 75; j < 100; ++j)
+  {
+    ASSERT_EQ(group_3, static_cast<SizeType>(clusters[j]));
+  }
+
+  EXPECT_EQ(std::set<SizeType>({group_0, group_1, group_2, group_3}).size(), K);
+}
+
+TEST(clustering_test, mini_batch_kmeans_test_batch_larger_than_data)
+{
+  TensorType A = TensorType::FromString("-10, -10; -11, -10; -10, -11; -11, -11;"
+                                        "10, 10; 11, 10; 10, 11; 11, 11");
+  SizeType   K = 2;
+
+  for (SizeType batch_size : {4, 8, 20})
+  {
+    ClusteringType clusters = fetch::math::clustering::MiniBatchKMeans(A, 123456, K, batch_size);
+
+    for (SizeType j = 1; j < 4; ++j)
+    {
+      EXPECT_EQ(clusters[0], clusters[j]) << "batch size " << batch_size;
+      EXPECT_EQ(clusters[4], clusters[4 + j]) << "batch size " << batch_size;
+    }
+    EXPECT_NE(clusters[0], clusters[4]) << "batch size " << batch_size;
+  }
+}
+
 TEST(clustering_test, kmeans_test_previous_assignment)
 {
   SizeType n_points = 50;
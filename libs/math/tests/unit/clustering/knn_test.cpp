@@ -78,6 +78,22 @@ TYPED_TEST(ClusteringTest, knn_cosine_test)
   EXPECT_NEAR(double(output.at(3).second), double(1.99784), 1e-4);
 }
 
+TYPED_TEST(ClusteringTest, knn_cosine_feature_axis_0_test)
+{
+  using ArrayType = TypeParam;
+
+  ArrayType A = ArrayType::FromString("1, 2, -1, -2; 2, 3, -2, -3; 3, 4, -3, -4; 4, 5, -4, -5");
+  ArrayType v = ArrayType::FromString("3; 4; 5; 6");
+
+  auto output = clustering::KNNCosine(A, v, 2);
+
+  ASSERT_EQ(output.size(), SizeType(2));
+  EXPECT_EQ(output.at(0).first, SizeType(1));
+  EXPECT_NEAR(double(output.at(0).second), double(0.00215564), 1e-4);
+  EXPECT_EQ(output.at(1).first, SizeType(0));
+  EXPECT_NEAR(double(output.at(1).second), double(0.015626), 1e-4);
+}
+
 }  // namespace test
 }  // namespace math
 }  // namespace fetch
@@ -20,6 +20,7 @@
 
 #include "math/distance/pairwise_distance.hpp"
 #include "math/matrix_operations.hpp"
+#include "vectorise/memory/dispatch_pool.hpp"
 
 #include "gtest/gtest.h"
 
@@ -78,6 +79,99 @@ TYPED_TEST(PairWiseDistanceTest, simple_test)
 
   EXPECT_TRUE(R.AllClose(gt));
 }
+
+TYPED_TEST(PairWiseDistanceTest, threaded_rows_match_serial_rows)
+{
+  using DataType = typename TypeParam::Type;
+
+  SizeType const n_points = 300;
+  TypeParam      data({n_points, 2});
+  for (SizeType i = 0; i < n_points; ++i)
+  {
+    data(i, 0) = static_cast<DataType>(i % 7);
+    data(i, 1) = static_cast<DataType>(i % 5);
+  }
+
+  auto const metric = [](TypeParam x, TypeParam y) -> DataType {
+    TypeParam z = x - y;
+    return fetch::math::Sum(z);
+  };
+
+  TypeParam serial({1, n_points * (n_points - 1) / 2});
+  TypeParam threaded({1, n_points * (n_points - 1) / 2});
+
+  distance::PairWiseDistance(data, metric, serial);
+
+  memory::DispatchPool::SetThreshold(0);
+  distance::PairWiseDistance(data, metric, threaded);
+  memory::DispatchPool::SetThreshold(memory::DispatchPool::DEFAULT_THRESHOLD);
+
+  EXPECT_TRUE(threaded.AllClose(serial));
+  EXPECT_EQ(serial(0, 0), static_cast<DataType>(-2));
+  EXPECT_EQ(serial(0, serial.shape(1) - 1), static_cast<DataType>(-2));
+}
+
+TYPED_TEST(PairWiseDistanceTest, square_euclidean_test)
+{
+  TypeParam a   = TypeParam::FromString("0, 1, 2; 3, 4, 5; -1, 0, 2");
+  TypeParam b   = TypeParam::FromString("0, 1, 2; 1, 1, 1");
+  TypeParam gt  = TypeParam::FromString("0, 2; 27, 29; 2, 6");
+  TypeParam ret = TypeParam({3, 2});
+
+  distance::PairWiseSquareEuclidean(a, b, ret);
+
+  EXPECT_TRUE(ret.AllClose(gt));
+}
+
+TYPED_TEST(PairWiseDistanceTest, square_euclidean_large_magnitude_test)
+{
+  // the squared norms of these points are far beyond the range of fp32, although their
+  // distances are small (and exact in every type)
+  TypeParam a   = TypeParam::FromString("200, 300; 200.5, 299; 199, 301.5");
+  TypeParam b   = TypeParam::FromString("201, 300; 200, 300");
+  TypeParam gt  = TypeParam::FromString("1, 0; 1.25, 1.25; 6.25, 3.25");
+  TypeParam ret = TypeParam({3, 2});
+
+  distance::PairWiseSquareEuclidean(a, b, ret);
+
+  EXPECT_TRUE(ret.AllClose(gt));
+}
+
+TYPED_TEST(PairWiseDistanceTest, threaded_square_euclidean_test)
+{
+  using DataType = typename TypeParam::Type;
+
+  SizeType const n_points = 600;
+  TypeParam      a({n_points, 3});
+  TypeParam      b = TypeParam::FromString("0, 1, 2; 1, 1, 1; -2, 0, 1");
+  for (SizeType i = 0; i < n_points; ++i)
+  {
+    a(i, 0) = static_cast<DataType>(i % 7);
+    a(i, 1) = static_cast<DataType>(i % 5);
+    a(i, 2) = -static_cast<DataType>(i % 3);
+  }
+
+  TypeParam ret;
+  memory::DispatchPool::SetThreshold(0);
+  distance::PairWiseSquareEuclidean(a, b, ret);
+  memory::DispatchPool::SetThreshold(memory::DispatchPool::DEFAULT_THRESHOLD);
+
+  ASSERT_EQ(ret.shape(), std::vector<SizeType>({n_points, b.shape(0)}));
+  for (SizeType i = 0; i < n_points; ++i)
+  {
+    for (SizeType j = 0; j < b.shape(0); ++j)
+    {
+      DataType expected{0};
+      for (SizeType k = 0; k < a.shape(1); ++k)
+      {
+        DataType const difference = a(i, k) - b(j, k);
+        expected += difference * difference;
+      }
+      EXPECT_EQ(ret(i, j), expected);
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace math
 }  // namespace fetch
@@ -0,0 +1,156 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "test_types.hpp"
+
+#include "math/exceptions/exceptions.hpp"
+#include "math/fundamental_operators.hpp"
+#include "math/tensor/tensor.hpp"
+#include "math/tensor/tensor_expression.hpp"
+#include "vectorise/fixed_point/fixed_point.hpp"
+
+#include "gtest/gtest.h"
+
+namespace {
+
+using fetch::math::Lazy;
+using fetch::math::SizeVector;
+
+template <typename T>
+class TensorExpressionTest : public ::testing::Test
+{
+};
+
+TYPED_TEST_SUITE(TensorExpressionTest, fetch::math::test::FloatIntAndUIntTypes, );
+
+template <typename T>
+fetch::math::Tensor<T> MakeTensor(SizeVector const &shape, int offset)
+{
+  fetch::math::Tensor<T> tensor(shape);
+
+  int value = offset;
+  for (auto &element : tensor)
+  {
+    element = static_cast<T>((value % 7) + 1);
+    ++value;
+  }
+
+  return tensor;
+}
+
+TYPED_TEST(TensorExpressionTest, chained_operations_match_eager_operations)
+{
+  // heights which are not a multiple of the vector width exercise the remainder of each column
+  for (auto const &shape : {SizeVector{13}, SizeVector{13, 5}, SizeVector{32, 3, 2}})
+  {
+    auto const a = MakeTensor<TypeParam>(shape, 0);
+    auto const b = MakeTensor<TypeParam>(shape, 3);
+    auto const c = MakeTensor<TypeParam>(shape, 5);
+
+    fetch::math::Tensor<TypeParam> expected(shape);
+    fetch::math::Multiply(a, b, expected);
+    fetch::math::Add(expected, c, expected);
+    fetch::math::Divide(expected, b, expected);
+    fetch::math::Subtract(expected, a, expected);
+
+    fetch::math::Tensor<TypeParam> result = (Lazy(a) * Lazy(b) + Lazy(c)) / Lazy(b) - Lazy(a);
+
+    EXPECT_EQ(result.shape(), shape);
+    EXPECT_TRUE(result == expected);
+  }
+}
+
+TYPED_TEST(TensorExpressionTest, scalar_operands_match_eager_operations)
+{
+  auto const a = MakeTensor<TypeParam>({17, 4}, 2);
+  auto const b = MakeTensor<TypeParam>({17, 4}, 4);
+
+  fetch::math::Tensor<TypeParam> expected(a.shape());
+  fetch::math::Multiply(a, TypeParam{2}, expected);
+  fetch::math::Add(expected, b, expected);
+  fetch::math::Subtract(TypeParam{40}, expected, expected);
+
+  fetch::math::Tensor<TypeParam> result;
+  fetch::math::Evaluate(TypeParam{40} - (Lazy(a) * TypeParam{2} + Lazy(b)), result);
+
+  EXPECT_TRUE(result == expected);
+}
+
+TYPED_TEST(TensorExpressionTest, dimensions_of_size_one_are_broadcast)
+{
+  auto const column = MakeTensor<TypeParam>({11, 1}, 1);
+  auto const row    = MakeTensor<TypeParam>({1, 6}, 2);
+  auto const matrix = MakeTensor<TypeParam>({11, 6}, 3);
+
+  fetch::math::Tensor<TypeParam> expected(matrix.shape());
+  fetch::math::Add(column, matrix, expected);
+  fetch::math::Multiply(expected, row, expected);
+
+  fetch::math::Tensor<TypeParam> result = (Lazy(column) + Lazy(matrix)) * Lazy(row);
+
+  EXPECT_EQ(result.shape(), matrix.shape());
+  EXPECT_TRUE(result == expected);
+}
+
+TYPED_TEST(TensorExpressionTest, result_may_be_an_operand)
+{
+  auto       a = MakeTensor<TypeParam>({9, 4}, 0);
+  auto const b = MakeTensor<TypeParam>({9, 4}, 1);
+
+  fetch::math::Tensor<TypeParam> expected(a.shape());
+  fetch::math::Multiply(a, a, expected);
+  fetch::math::Add(expected, b, expected);
+
+  fetch::math::Evaluate(Lazy(a) * Lazy(a) + Lazy(b), a);
+  EXPECT_TRUE(a == expected);
+
+  // a broadcast operand which is reshaped by the evaluation keeps its original values
+  auto column = MakeTensor<TypeParam>({9, 1}, 0);
+  expected    = fetch::math::Tensor<TypeParam>(b.shape());
+  fetch::math::Add(column, b, expected);
+
+  fetch::math::Evaluate(Lazy(column) + Lazy(b), column);
+  EXPECT_TRUE(column == expected);
+}
+
+TYPED_TEST(TensorExpressionTest, assignment_does_not_modify_shared_buffers)
+{
+  auto       a      = MakeTensor<TypeParam>({8, 3}, 0);
+  auto const shared = a;
+  auto const copy   = a.Copy();
+
+  a = Lazy(a) + Lazy(a);
+
+  EXPECT_TRUE(shared == copy);
+  EXPECT_FALSE(a == copy);
+}
+
+TYPED_TEST(TensorExpressionTest, incompatible_shapes_throw)
+{
+  auto const a = MakeTensor<TypeParam>({4, 3}, 0);
+  auto const b = MakeTensor<TypeParam>({3, 3}, 0);
+  auto const c = MakeTensor<TypeParam>({4, 3, 1}, 0);
+
+  fetch::math::Tensor<TypeParam> result;
+  EXPECT_THROW(fetch::math::Evaluate(Lazy(a) + Lazy(b), result),
+               fetch::math::exceptions::WrongShape);
+  EXPECT_THROW(fetch::math::Evaluate(Lazy(a) + Lazy(c), result),
+               fetch::math::exceptions::WrongShape);
+}
+
+}  // namespace
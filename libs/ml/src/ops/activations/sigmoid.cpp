@@ -19,6 +19,7 @@
 #include "math/activation_functions/sigmoid.hpp"
 #include "math/fundamental_operators.hpp"
 #include "math/standard_functions/clamp.hpp"
+#include "math/tensor/tensor_expression.hpp"
 #include "ml/ops/activations/sigmoid.hpp"
 
 namespace fetch {
@@ -75,13 +76,11 @@ std::vector<TensorType> Sigmoid<TensorType>::Backward(VecTensorType const &input
   TensorType return_signal{error_signal.shape()};
   TensorType t{inputs.front()->shape()};
 
-  // gradient of sigmoid function is s(x)(1 - s(x))
+  // gradient of sigmoid function is s(x)(1 - s(x)), multiplied by error_signal (chain rule)
   Forward(inputs, t);
-  fetch::math::Subtract(DataType{1}, t, return_signal);
-  fetch::math::Multiply(t, return_signal, return_signal);
-
-  // multiply by error_signal (chain rule)
-  fetch::math::Multiply(error_signal, return_signal, return_signal);
+  fetch::math::Evaluate(fetch::math::Lazy(error_signal) *
+                            (fetch::math::Lazy(t) * (DataType{1} - fetch::math::Lazy(t))),
+                        return_signal);
 
   return {return_signal};
 }
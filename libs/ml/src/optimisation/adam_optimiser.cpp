@@ -18,6 +18,7 @@
 
 #include "math/standard_functions/pow.hpp"
 #include "math/standard_functions/sqrt.hpp"
+#include "math/tensor/tensor_expression.hpp"
 #include "ml/charge_estimation/constants.hpp"
 #include "ml/charge_estimation/optimisation/constants.hpp"
 #include "ml/core/graph.hpp"
@@ -98,24 +99,23 @@ void AdamOptimiser<T>::ApplyGradients(SizeType batch_size)
     if (!(*trainable_it)->GetFrozenState())
     {
 
+      auto const gradients = fetch::math::Lazy((*trainable_it)->GetGradientsReferences());
+
       // cache[i] = (beta1_t_ * cache[i]) + ((1.0 - beta1_t_) * (input_gradients[i]/batch_size));
-      fetch::math::Multiply((*trainable_it)->GetGradientsReferences(),
-                            (DataType{1} - beta1_t_) / static_cast<DataType>(batch_size),
-                            *gradient_it);
-      fetch::math::Multiply(*cached_weight_it, beta1_t_, *cached_weight_it);
-      fetch::math::Add(*cached_weight_it, *gradient_it, *cached_weight_it);
+      fetch::math::Evaluate(fetch::math::Lazy(*cached_weight_it) * beta1_t_ +
+                                gradients * ((DataType{1} - beta1_t_) /
+                                             static_cast<DataType>(batch_size)),
+                            *cached_weight_it);
 
       // mt   = cache[i] / (1.0 - beta1_t_);
       fetch::math::Divide(*cached_weight_it, (DataType{1} - beta1_t_), *mt_it);
 
       // momentum[i] = (beta2_t_ * momentum[i]) + ((1.0 - beta2_t_) *
       // ((input_gradients[i]/batch_size)^2));
-      fetch::math::Divide((*trainable_it)->GetGradientsReferences(),
-                          static_cast<DataType>(batch_size), *vt_it);
-      fetch::math::Square(*vt_it, *vt_it);
-      fetch::math::Multiply(*vt_it, (DataType{1} - beta2_t_), *vt_it);
-      fetch::math::Multiply(*momentum_it, beta2_t_, *momentum_it);
-      fetch::math::Add(*momentum_it, *vt_it, *momentum_it);
+      auto const batch_gradients = gradients / static_cast<DataType>(batch_size);
+      fetch::math::Evaluate(fetch::math::Lazy(*momentum_it) * beta2_t_ +
+                                batch_gradients * batch_gradients * (DataType{1} - beta2_t_),
+                            *momentum_it);
 
       // vt   = momentum[i] / (1.0 - beta2_t_);
       fetch::math::Divide(*momentum_it, (DataType{1} - beta2_t_), *vt_it);
@@ -79,6 +79,7 @@ public:
   using Address    = byte_array::ConstByteArray;
   using Payload    = byte_array::ConstByteArray;
   using Stamp      = byte_array::ConstByteArray;
+  using WireBuffer = byte_array::ByteArray;
 
   struct RoutingHeader
   {
@@ -156,6 +157,9 @@ public:
   // Binary
   static bool ToBuffer(Packet const &packet, void *buffer, std::size_t length);
   static bool FromBuffer(Packet &packet, void const *buffer, std::size_t length);
+  static bool FromBuffer(Packet &packet, WireBuffer const &buffer);
+
+  WireBuffer GetWireBuffer() const;
 
   void Sign(crypto::Prover const &prover);
   bool Verify() const;
@@ -170,7 +174,12 @@ private:
   mutable Address target_;
   mutable Address sender_;
 
+  ///< Cached serialised version of the packet, shared between all the outgoing connections
+  mutable WireBuffer wire_buffer_;
+  mutable bool       wire_buffer_shared_{false};
+
   void         SetStamped(bool set = true) noexcept;
+  void         ClearWireBuffer() noexcept;
   BinaryHeader StaticHeader() const noexcept;
 
   template <typename V, typename D>
@@ -326,6 +335,22 @@ inline void Packet::SetTTL(uint8_t ttl) noexcept
 {
   header_.ttl = (ttl & 0x7f);
   // stamps are not invalidated
+
+  FETCH_LOCK(lock_);
+
+  if (!wire_buffer_.empty())
+  {
+    if (wire_buffer_shared_)
+    {
+      // the buffer might be queued on one or more connections, it must not be modified
+      wire_buffer_ = WireBuffer{};
+    }
+    else
+    {
+      // patch the header of the buffer in place
+      std::memcpy(wire_buffer_.pointer(), &header_, sizeof(header_));
+    }
+  }
 }
 
 inline void Packet::SetService(uint16_t service_num) noexcept
@@ -374,6 +399,14 @@ inline void Packet::SetPayload(Payload const &payload)
 inline void Packet::SetStamped(bool set) noexcept
 {
   header_.stamped = static_cast<uint32_t>(set);
+  ClearWireBuffer();
+}
+
+inline void Packet::ClearWireBuffer() noexcept
+{
+  FETCH_LOCK(lock_);
+  wire_buffer_        = WireBuffer{};
+  wire_buffer_shared_ = false;
 }
 
 inline Packet::BinaryHeader Packet::StaticHeader() const noexcept
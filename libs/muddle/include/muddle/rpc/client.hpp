@@ -42,6 +42,7 @@ public:
   using FunctionId    = service::FunctionHandlerType;
   using Serializer    = service::SerializerType;
   using Promise       = service::Promise;
+  using Decoder       = service::details::PromiseImplementation::Decoder;
   using Handler       = std::function<void(Promise)>;
   using SharedHandler = std::shared_ptr<Handler>;
   using WeakHandler   = std::weak_ptr<Handler>;
@@ -58,10 +59,47 @@ public:
   Promise CallSpecificAddress(Address const &address, ProtocolId const &protocol,
                               FunctionId const &function, Args &&... args)
   {
-    FETCH_LOG_DEBUG(LOGGING_NAME, "Service Client Calling ", protocol, ":", function);
+    return Call(address, service::MakePromise(protocol, function), protocol, function,
+                std::forward<Args>(args)...);
+  }
 
-    // create and register the promise to this callback
+  /**
+   * Call a remote function, passing the response through the specified decoder before it is made
+   * available through the promise. This is used for responses which are encoded on the wire (for
+   * example compressed) but should be consumed as the original type.
+   */
+  template <typename... Args>
+  Promise CallSpecificAddressWithDecoder(Address const &address, Decoder decoder,
+                                         ProtocolId const &protocol, FunctionId const &function,
+                                         Args &&... args)
+  {
     Promise prom = service::MakePromise(protocol, function);
+    prom->SetDecoder(std::move(decoder));
+
+    return Call(address, std::move(prom), protocol, function, std::forward<Args>(args)...);
+  }
+
+  // Operators
+  Client &operator=(Client const &) = delete;
+  Client &operator=(Client &&) = delete;
+
+protected:
+  bool DeliverRequest(muddle::Address const &address, network::MessageBuffer const &data);
+
+private:
+  using Flag            = std::atomic<bool>;
+  using PromiseQueue    = std::list<MuddleEndpoint::Response>;
+  using SubscriptionPtr = MuddleEndpoint::SubscriptionPtr;
+
+  void OnMessage(Packet const &packet, Address const &last_hop);
+
+  template <typename... Args>
+  Promise Call(Address const &address, Promise prom, ProtocolId const &protocol,
+               FunctionId const &function, Args &&... args)
+  {
+    FETCH_LOG_DEBUG(LOGGING_NAME, "Service Client Calling ", protocol, ":", function);
+
+    // register the promise to this callback
     AddPromise(prom);
 
     // determine the required serial size
@@ -93,20 +131,6 @@ public:
     return prom;
   }
 
-  // Operators
-  Client &operator=(Client const &) = delete;
-  Client &operator=(Client &&) = delete;
-
-protected:
-  bool DeliverRequest(muddle::Address const &address, network::MessageBuffer const &data);
-
-private:
-  using Flag            = std::atomic<bool>;
-  using PromiseQueue    = std::list<MuddleEndpoint::Response>;
-  using SubscriptionPtr = MuddleEndpoint::SubscriptionPtr;
-
-  void OnMessage(Packet const &packet, Address const &last_hop);
-
   static std::size_t const NUM_THREADS = 1;
 
   std::string const name_;
@@ -21,6 +21,7 @@
 #include "core/mutex.hpp"
 #include "muddle/address.hpp"
 #include "network/management/abstract_connection_register.hpp"
+#include "network/message.hpp"
 #include "telemetry/telemetry.hpp"
 
 #include <atomic>
@@ -52,6 +53,7 @@ public:
   using ConnectionMap          = std::unordered_map<ConnectionHandle, WeakConnectionPtr>;
   using ConnectionMapCallback  = std::function<void(ConnectionMap const &)>;
   using ConstByteArray         = byte_array::ConstByteArray;
+  using MessageBuffer          = network::MessageBuffer;
   using Handle                 = ConnectionHandleType;
   using ConnectionLeftCallback = std::function<void(Handle)>;
   using Connections            = std::vector<WeakConnectionPtr>;
@@ -88,7 +90,7 @@ public:
   MuddleRegister &operator=(MuddleRegister &&) = delete;
 
   void              OnConnectionLeft(ConnectionLeftCallback cb);
-  void              Broadcast(ConstByteArray const &data) const;
+  void              Broadcast(MessageBuffer const &data) const;
   WeakConnectionPtr LookupConnection(ConnectionHandle handle) const;
   WeakConnectionPtr LookupConnection(Address const &address) const;
   Connections       LookupConnections(Address const &address) const;
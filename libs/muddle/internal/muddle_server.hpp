@@ -87,7 +87,7 @@ private:
     try
     {
       auto packet = std::make_shared<Packet>();
-      if (Packet::FromBuffer(*packet, msg.pointer(), msg.size()))
+      if (Packet::FromBuffer(*packet, msg))
       {
         // dispatch the message to router
         router_.Route(client, packet);
@@ -731,7 +731,7 @@ void Muddle::CreateTcpClient(Uri const &peer)
       {
         auto packet = std::make_shared<Packet>();
 
-        if (Packet::FromBuffer(*packet, msg.pointer(), msg.size()))
+        if (Packet::FromBuffer(*packet, msg))
         {
           // dispatch the message to router
           router_.Route(conn_handle, packet);
@@ -54,9 +54,11 @@ void MuddleRegister::OnConnectionLeft(ConnectionLeftCallback cb)
 /**
  * Broadcast data to all active connections
  *
+ * The same buffer is queued on every connection, therefore it must not be modified afterwards.
+ *
  * @param data The data to be broadcast
  */
-void MuddleRegister::Broadcast(ConstByteArray const &data) const
+void MuddleRegister::Broadcast(MessageBuffer const &data) const
 {
   using ConnectionPtr  = std::shared_ptr<network::AbstractConnection>;
   using ConnectionPtrs = std::vector<ConnectionPtr>;
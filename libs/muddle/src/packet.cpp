@@ -115,8 +115,104 @@ bool Packet::FromBuffer(Packet &packet, void const *buffer, std::size_t length)
     packet.stamp_ = std::move(signature);
   }
 
+  packet.ClearWireBuffer();
+
+  return true;
+}
+
+/**
+ * Read in a packet from a specified packet buffer without copying the payload
+ *
+ * The payload and stamp of the packet are views into the input buffer, which is also retained as
+ * the wire representation of the packet. This means relaying the packet to other peers does not
+ * require it to be serialised again.
+ *
+ * @param packet The packet to be populated
+ * @param buffer The input buffer
+ * @return true if successful, otherwise false
+ */
+bool Packet::FromBuffer(Packet &packet, WireBuffer const &buffer)
+{
+  if (buffer.size() < sizeof(packet.header_))
+  {
+    return false;
+  }
+
+  // read the header
+  std::memcpy(&packet.header_, buffer.pointer(), sizeof(packet.header_));
+
+  std::size_t payload_length = buffer.size() - sizeof(packet.header_);
+  if (packet.IsStamped())
+  {
+    if (payload_length < SIGNATURE_SIZE)
+    {
+      return false;
+    }
+
+    payload_length -= SIGNATURE_SIZE;
+  }
+
+  std::size_t const payload_offset = sizeof(packet.header_);
+
+  // reference the payload
+  if (payload_length != 0u)
+  {
+    packet.payload_ = buffer.SubArray(payload_offset, payload_length);
+  }
+  else
+  {
+    packet.payload_ = Payload{};
+  }
+
+  // reference the signature
+  if (packet.IsStamped())
+  {
+    packet.stamp_ = buffer.SubArray(payload_offset + payload_length, SIGNATURE_SIZE);
+  }
+  else
+  {
+    packet.stamp_ = Stamp{};
+  }
+
+  // retain the original buffer as the wire representation
+  FETCH_LOCK(packet.lock_);
+  packet.wire_buffer_        = buffer;
+  packet.wire_buffer_shared_ = false;
+
   return true;
 }
 
+/**
+ * Get the serialised version of this packet.
+ *
+ * The buffer is generated once and then cached, so that it can be shared between all the
+ * connections that the packet is sent to. Once returned the buffer must be treated as immutable by
+ * the caller.
+ *
+ * @return The serialised packet or an empty buffer on failure
+ */
+Packet::WireBuffer Packet::GetWireBuffer() const
+{
+  FETCH_LOCK(lock_);
+
+  if (wire_buffer_.empty())
+  {
+    WireBuffer buffer{};
+    buffer.Resize(GetPacketSize());
+
+    if (!ToBuffer(*this, buffer.pointer(), buffer.size()))
+    {
+      return {};
+    }
+
+    wire_buffer_ = std::move(buffer);
+  }
+
+  // from this point on the buffer can no longer be updated in place
+  wire_buffer_shared_ = true;
+
+  return wire_buffer_;
+}
+
 }  // namespace muddle
 }  // namespace fetch
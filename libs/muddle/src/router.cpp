@@ -51,7 +51,6 @@
 
 static constexpr uint8_t DEFAULT_TTL = 40;
 
-using fetch::byte_array::ByteArray;
 using fetch::byte_array::ConstByteArray;
 using fetch::byte_array::ToBase64;
 
@@ -619,10 +618,9 @@ void Router::SendToConnection(Handle handle, PacketPtr const &packet, bool exter
   auto conn = register_.LookupConnection(handle).lock();
   if (conn)
   {
-    // serialize the packet to the buffer
-    ByteArray buffer;
-    buffer.Resize(packet->GetPacketSize());
-    if (Packet::ToBuffer(*packet, buffer.pointer(), buffer.size()))
+    // retrieve the (shared) serialised version of the packet
+    auto const buffer = packet->GetWireBuffer();
+    if (!buffer.empty())
     {
       FETCH_LOG_TRACE(logging_name_, "TX: (conn: ", handle, ") ", DescribePacket(*packet));
 
@@ -699,10 +697,9 @@ void Router::RoutePacket(PacketPtr const &packet, bool external)
       DispatchPacket(packet, address_);
     }
 
-    // serialize the packet to the buffer
-    ByteArray buffer{};
-    buffer.Resize(packet->GetPacketSize());
-    if (Packet::ToBuffer(*packet, buffer.pointer(), buffer.size()))
+    // retrieve the serialised version of the packet, which is shared between all connections
+    auto const buffer = packet->GetWireBuffer();
+    if (!buffer.empty())
     {
       FETCH_LOG_TRACE(logging_name_, "BX:           ", DescribePacket(*packet));
 
@@ -145,3 +145,67 @@ TEST_F(PacketTests, CheckIndifference)
   EXPECT_TRUE(packet_->IsStamped());
   EXPECT_TRUE(packet_->Verify());
 }
+
+TEST_F(PacketTests, CheckWireBufferRoundTrip)
+{
+  packet_->Sign(*prover_);
+
+  auto const buffer = packet_->GetWireBuffer();
+  ASSERT_EQ(buffer.size(), packet_->GetPacketSize());
+
+  // the buffer is generated once and shared from then on
+  EXPECT_EQ(buffer.pointer(), packet_->GetWireBuffer().pointer());
+
+  Packet received;
+  ASSERT_TRUE(Packet::FromBuffer(received, buffer));
+  EXPECT_EQ(received.GetPayload(), response_);
+  EXPECT_EQ(received.GetSender(), packet_->GetSender());
+  EXPECT_TRUE(received.Verify());
+
+  // the received packet reuses the input buffer rather than serialising again
+  EXPECT_EQ(buffer.pointer(), received.GetWireBuffer().pointer());
+}
+
+TEST_F(PacketTests, CheckWireBufferTTLUpdate)
+{
+  packet_->Sign(*prover_);
+  packet_->SetTTL(40);
+
+  Packet received;
+  ASSERT_TRUE(Packet::FromBuffer(received, packet_->GetWireBuffer().Copy()));
+
+  // buffer has not been shared yet, the TTL is patched in place
+  received.SetTTL(39);
+  auto const patched = received.GetWireBuffer();
+
+  Packet relayed;
+  ASSERT_TRUE(Packet::FromBuffer(relayed, patched));
+  EXPECT_EQ(relayed.GetTTL(), 39);
+  EXPECT_TRUE(relayed.Verify());
+
+  // once shared the buffer must not be modified, a new one is generated instead
+  received.SetTTL(38);
+  auto const updated = received.GetWireBuffer();
+  EXPECT_NE(patched.pointer(), updated.pointer());
+
+  Packet original;
+  ASSERT_TRUE(Packet::FromBuffer(original, patched));
+  EXPECT_EQ(original.GetTTL(), 39);
+
+  Packet modified;
+  ASSERT_TRUE(Packet::FromBuffer(modified, updated));
+  EXPECT_EQ(modified.GetTTL(), 38);
+  EXPECT_TRUE(modified.Verify());
+}
+
+TEST_F(PacketTests, CheckWireBufferInvalidation)
+{
+  auto const before = packet_->GetWireBuffer();
+
+  packet_->SetPayload(Payload{"Bye!"});
+
+  Packet received;
+  ASSERT_TRUE(Packet::FromBuffer(received, packet_->GetWireBuffer()));
+  EXPECT_EQ(received.GetPayload(), Payload{"Bye!"});
+  EXPECT_NE(before.pointer(), packet_->GetWireBuffer().pointer());
+}
@@ -132,3 +132,36 @@ TEST(PromiseTests, CheckImmediateFailure)
   EXPECT_TRUE(failure);
   EXPECT_TRUE(complete);
 }
+
+TEST(PromiseTests, CheckDecoderIsAppliedOnFulfillment)
+{
+  using fetch::byte_array::ConstByteArray;
+
+  auto prom = fetch::service::MakePromise();
+  prom->SetDecoder([](ConstByteArray const &encoded, ConstByteArray &decoded) {
+    decoded = encoded.SubArray(1);
+    return true;
+  });
+
+  prom->Fulfill(ConstByteArray{"xpayload"});
+
+  EXPECT_TRUE(prom->IsSuccessful());
+  EXPECT_EQ(ConstByteArray{"payload"}, prom->value());
+}
+
+TEST(PromiseTests, CheckDecoderFailureFailsPromise)
+{
+  using fetch::byte_array::ConstByteArray;
+
+  auto prom = fetch::service::MakePromise();
+  prom->SetDecoder([](ConstByteArray const &, ConstByteArray &) { return false; });
+
+  bool failure = false;
+  prom->WithHandlers().Catch([&failure]() { failure = true; });
+
+  prom->Fulfill(ConstByteArray{"payload"});
+
+  EXPECT_TRUE(prom->IsFailed());
+  EXPECT_TRUE(failure);
+  EXPECT_TRUE(prom->HasFailedWith(fetch::serializers::error::TYPE_ERROR));
+}
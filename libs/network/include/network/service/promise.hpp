@@ -58,6 +58,7 @@ public:
   using ConstByteArray = byte_array::ConstByteArray;
   using ExceptionPtr   = std::unique_ptr<serializers::SerializableException>;
   using Callback       = std::function<void()>;
+  using Decoder        = std::function<bool(ConstByteArray const &, ConstByteArray &)>;
   using Clock          = std::chrono::steady_clock;
   using Timepoint      = Clock::time_point;
   using Duration       = Clock::duration;
@@ -98,8 +99,11 @@ public:
   bool IsWaiting() const;
   bool IsSuccessful() const;
   bool IsFailed() const;
+  bool HasFailedWith(serializers::error::ErrorType error_code) const;
   /// @}
 
+  void SetDecoder(Decoder decoder);
+
   // Handler building
   PromiseBuilder WithHandlers();
 
@@ -117,6 +121,9 @@ public:
 
   template <typename T>
   bool GetResult(T &ret, uint64_t extend_wait_by = 0) const;
+
+  template <typename T>
+  bool GetResultView(T &ret, uint64_t extend_wait_by = 0) const;
   /// @}
 
   // Operators
@@ -150,6 +157,7 @@ private:
   mutable AtomicState state_{State::WAITING};
   ConstByteArray      value_;
   ExceptionPtr        exception_;
+  Decoder             decoder_;
   std::string         name_;
 
   mutable Mutex    callback_lock_;
@@ -235,6 +243,41 @@ bool details::PromiseImplementation::GetResult(T &ret, uint64_t extend_wait_by)
   return success;
 }
 
+/**
+ * Extract the result of the promise without copying the underlying response buffer.
+ *
+ * Any byte arrays that are part of the result reference the response buffer directly, this is
+ * intended for large responses where the extra copy would be significant.
+ *
+ * @tparam T The type of the result
+ * @param ret The output result
+ * @param extend_wait_by The additional time to wait for the promise
+ * @return true if successful, otherwise false
+ */
+template <typename T>
+bool details::PromiseImplementation::GetResultView(T &ret, uint64_t extend_wait_by) const
+{
+  bool success{false};
+
+  try
+  {
+    if (Wait(true, extend_wait_by))
+    {
+      auto ser = SerializerType::View(value_);
+      ser >> ret;
+
+      success = true;
+    }
+  }
+  catch (std::exception const &ex)
+  {
+    PromiseError const error{*this};
+    FETCH_LOG_WARN("Promise", error.what(), " : ", ex.what());
+  }
+
+  return success;
+}
+
 using PromiseCounter = details::PromiseImplementation::Counter;
 using PromiseState   = details::PromiseImplementation::State;
 using Promise        = std::shared_ptr<details::PromiseImplementation>;
@@ -20,6 +20,7 @@
 #include "network/service/promise.hpp"
 
 #include <chrono>
+#include <utility>
 
 namespace fetch {
 namespace service {
@@ -117,6 +118,28 @@ bool PromiseImplementation::IsFailed() const
   return (State::FAILED == state());
 }
 
+/**
+ * Determine if the promise has failed with a specific (remote) error code
+ *
+ * @param error_code The error code to check for
+ * @return true if the promise has failed with the specified error, otherwise false
+ */
+bool PromiseImplementation::HasFailedWith(serializers::error::ErrorType error_code) const
+{
+  return IsFailed() && exception_ && (exception_->error_code() == error_code);
+}
+
+/**
+ * Set a decoder which will be applied to the response before it is made available as the value of
+ * the promise, for example to decompress it. This must be set before the request is sent.
+ *
+ * @param decoder The decoder to be used
+ */
+void PromiseImplementation::SetDecoder(Decoder decoder)
+{
+  decoder_ = std::move(decoder);
+}
+
 PromiseBuilder PromiseImplementation::WithHandlers()
 {
   return PromiseBuilder{*this};
@@ -124,7 +147,18 @@ PromiseBuilder PromiseImplementation::WithHandlers()
 
 void PromiseImplementation::Fulfill(ConstByteArray const &value)
 {
-  value_ = value;
+  if (decoder_)
+  {
+    if (!decoder_(value, value_))
+    {
+      Fail(SerializableException{serializers::error::TYPE_ERROR, "Unable to decode response"});
+      return;
+    }
+  }
+  else
+  {
+    value_ = value;
+  }
 
   UpdateState(State::SUCCESS);
 }
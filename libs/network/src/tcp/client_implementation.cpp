@@ -156,7 +156,7 @@ void TCPClientImplementation::Send(MessageBuffer const &omsg, Callback const &su
                                    Callback const &fail)
 {
   MessageType msg;
-  msg.buffer  = omsg.Copy();
+  msg.buffer  = omsg;
   msg.success = success;
   msg.failure = fail;
 
@@ -18,6 +18,7 @@
 //------------------------------------------------------------------------------
 
 #include "core/serializers/group_definitions.hpp"
+#include "core/serializers/serialized_size.hpp"
 
 #include <cstdint>
 #include <limits>
@@ -111,6 +112,13 @@ public:
   }
 };
 
+/// The type is encoded as a uint8_t, followed by the instance
+template <>
+struct SerializedSizeBound<shards::ServiceIdentifier>
+  : MapLayoutSizeBound<uint8_t, uint8_t, uint32_t>
+{
+};
+
 }  // namespace serializers
 }  // namespace fetch
 
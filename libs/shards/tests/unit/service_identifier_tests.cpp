@@ -16,10 +16,16 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/serializers/counter.hpp"
+#include "core/serializers/main_serializer.hpp"
 #include "shards/service_identifier.hpp"
 
 #include "gtest/gtest.h"
 
+#include <limits>
+
+using fetch::serializers::SerializedSizeBound;
+using fetch::serializers::SizeCounter;
 using fetch::shards::ServiceIdentifier;
 
 TEST(ServiceIdentifierTests, CheckDefaultConstruction)
@@ -87,3 +93,16 @@ TEST(ServiceIdentifierTests, CheckEquality)
 
   EXPECT_TRUE(id1 == id2);
 }
+
+TEST(ServiceIdentifierTests, CheckSerializedSizeBound)
+{
+  static_assert(SerializedSizeBound<ServiceIdentifier>::IS_BOUNDED, "");
+  uint64_t const bound = SerializedSizeBound<ServiceIdentifier>::VALUE;
+
+  ServiceIdentifier id{ServiceIdentifier::Type::LANE, std::numeric_limits<uint32_t>::max() - 1};
+
+  SizeCounter counter;
+  counter << id;
+
+  EXPECT_LE(counter.size(), bound);
+}
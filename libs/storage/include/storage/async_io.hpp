@@ -0,0 +1,184 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+#include "telemetry/telemetry.hpp"
+
+#include <sys/uio.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fetch {
+namespace storage {
+
+/**
+ * An asynchronous I/O engine for the storage layer.
+ *
+ * Requests are gathered into batches which are submitted together and then waited upon, so that
+ * many independent reads (for example the pages touched by a trie walk or a prefetch) are in flight
+ * on the device at the same time rather than being issued one after another at a queue depth of 1.
+ *
+ * On Linux the engine uses io_uring when the kernel supports it. Otherwise it falls back to a pool
+ * of threads performing blocking pread / pwrite calls, which still keeps up to one request per
+ * thread in flight. Both backends complete requests through the same path, so callers do not need
+ * to know which one is in use.
+ */
+class AsyncIo
+{
+public:
+  enum class Backend
+  {
+    IO_URING,
+    THREAD_POOL
+  };
+
+  enum class Operation
+  {
+    READ,
+    WRITE
+  };
+
+  class Batch;
+
+  /**
+   * A single read or write of a contiguous range of a file
+   */
+  struct Request
+  {
+    Operation   operation{Operation::READ};
+    int         fd{-1};
+    uint64_t    offset{0};
+    uint8_t *   buffer{nullptr};
+    std::size_t length{0};
+    int64_t     result{0};  ///< The number of bytes transferred, or a negative errno on failure
+
+    // Internal state while the request is in flight
+    Batch *     batch{nullptr};
+    std::size_t transferred{0};
+    iovec       vector{};
+  };
+
+  /**
+   * A set of requests which are submitted and completed together. The batch (and the buffers of its
+   * requests) must outlive the call to Wait.
+   */
+  class Batch
+  {
+  public:
+    void AddRead(int fd, uint64_t offset, void *buffer, std::size_t length);
+    void AddWrite(int fd, uint64_t offset, void const *buffer, std::size_t length);
+    void Clear();
+
+    std::size_t    size() const;
+    bool           empty() const;
+    bool           Succeeded() const;
+    Request const &operator[](std::size_t index) const;
+
+  private:
+    using Requests = std::vector<Request>;
+
+    Requests    requests_{};
+    std::size_t outstanding_{0};  ///< Guarded by the engine lock
+
+    friend class AsyncIo;
+  };
+
+  /**
+   * An owned raw file descriptor, for issuing requests against a file which is otherwise accessed
+   * through a stream
+   */
+  class File
+  {
+  public:
+    File() = default;
+    File(File const &) = delete;
+    File(File &&other) noexcept;
+    ~File();
+
+    void Open(std::string const &filename, bool writable = false);
+    void Close();
+
+    bool is_open() const;
+    int  fd() const;
+
+    File &operator=(File const &) = delete;
+    File &operator=(File &&other) noexcept;
+
+  private:
+    int fd_{-1};
+  };
+
+  static constexpr std::size_t DEFAULT_QUEUE_DEPTH = 128;
+  static constexpr std::size_t DEFAULT_NUM_THREADS = 4;
+
+  static AsyncIo &Instance();
+
+  // Construction / Destruction
+  explicit AsyncIo(std::string const &name, Backend preferred = Backend::IO_URING,
+                   std::size_t queue_depth = DEFAULT_QUEUE_DEPTH,
+                   std::size_t num_threads = DEFAULT_NUM_THREADS);
+  AsyncIo(AsyncIo const &) = delete;
+  AsyncIo(AsyncIo &&)      = delete;
+  ~AsyncIo();
+
+  /// @name Batch Operations
+  /// @{
+  void Submit(Batch &batch);
+  void Wait(Batch &batch);
+  void Execute(Batch &batch);
+  /// @}
+
+  Backend     backend() const;
+  std::size_t queue_depth() const;
+
+  // Operators
+  AsyncIo &operator=(AsyncIo const &) = delete;
+  AsyncIo &operator=(AsyncIo &&) = delete;
+
+private:
+  class Engine;
+  class UringEngine;
+  class ThreadPoolEngine;
+
+  using EnginePtr = std::unique_ptr<Engine>;
+  using Condition = std::condition_variable_any;
+  using Pending   = std::deque<Request *>;
+
+  void Complete(Request &request, int64_t result);
+  void Finish(Request &request, int64_t result);
+
+  mutable Mutex lock_;
+  Condition     batch_complete_;
+  Pending       pending_{};  ///< The requests waiting to be handed to the backend
+  EnginePtr     engine_{};
+
+  // Telemetry
+  telemetry::CounterPtr batch_count_;
+  telemetry::CounterPtr request_count_;
+  telemetry::CounterPtr error_count_;
+};
+
+}  // namespace storage
+}  // namespace fetch
@@ -0,0 +1,187 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/mutex.hpp"
+#include "telemetry/telemetry.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace fetch {
+namespace storage {
+
+/**
+ * A pool of cached storage pages which is shared between the caching random access stacks.
+ *
+ * The stacks keep their cached pages locally, but each page is accounted for in a buffer pool. The
+ * pool enforces a single memory limit across all the stacks that use it, so many stacks can be
+ * sized against the available RAM together rather than individually.
+ *
+ * Pages are selected for eviction with the CLOCK algorithm. Each page has a reference bit which is
+ * set on access and cleared as the clock hand passes, so a page is only evicted once it has not
+ * been accessed for a full revolution of the hand. Dirty pages are written back periodically by
+ * the pool's write back thread, so that eviction seldom has to wait for a disk write.
+ *
+ * The pool never holds its own lock while calling into a client, and clients are only ever
+ * called through non-blocking entry points. This allows a client to call the pool while holding
+ * its own lock without any risk of deadlock.
+ */
+class BufferPool
+{
+public:
+  using PageId   = uint64_t;
+  using Clock    = std::chrono::steady_clock;
+  using Duration = Clock::duration;
+
+  static constexpr std::size_t DEFAULT_MEMORY_LIMIT = std::size_t{1} << 30u;  // 1GB
+  static constexpr Duration    WRITE_BACK_INTERVAL  = std::chrono::seconds{1};
+
+  /**
+   * The interface implemented by a cache whose pages are managed by the pool
+   */
+  class Client
+  {
+  public:
+    virtual ~Client() = default;
+
+    /**
+     * Evict a page from the cache, writing it back to disk first if it is dirty. The client must
+     * call Release (or Resize) on the pool for the page it has evicted.
+     *
+     * @param id The id of the page to be evicted
+     * @return false if the client is busy and the page could not be evicted, otherwise true
+     */
+    virtual bool TryEvictPage(PageId id) = 0;
+
+    /**
+     * Write a dirty page back to disk, leaving it in the cache
+     *
+     * @param id The id of the page to be written back
+     * @return false if the client is busy or the page could not be written, otherwise true
+     */
+    virtual bool TryWriteBackPage(PageId id) = 0;
+  };
+
+  class Page;
+  using PagePtr = std::shared_ptr<Page>;
+
+  /**
+   * The state of a cached page which is shared between the client and the pool
+   */
+  class Page
+  {
+  public:
+    Page(Client &client, PageId id, std::size_t bytes);
+
+    Client &client() const;
+    PageId  id() const;
+    bool    dirty() const;
+
+  private:
+    using Frames = std::list<PagePtr>;
+
+    Client &          client_;
+    PageId const      id_;
+    std::atomic<bool> referenced_{true};
+    std::atomic<bool> dirty_{false};
+    std::size_t       bytes_{0};        ///< Guarded by the pool lock
+    bool              busy_{false};     ///< Guarded by the pool lock
+    bool              in_pool_{false};  ///< Guarded by the pool lock
+    Frames::iterator  frame_{};         ///< Guarded by the pool lock
+
+    friend class BufferPool;
+  };
+
+  static BufferPool &Instance();
+
+  // Construction / Destruction
+  explicit BufferPool(std::string const &name, std::size_t memory_limit = DEFAULT_MEMORY_LIMIT);
+  BufferPool(BufferPool const &) = delete;
+  BufferPool(BufferPool &&)      = delete;
+  ~BufferPool();
+
+  /// @name Page Management
+  /// @{
+  PagePtr Admit(Client &client, PageId id, std::size_t bytes);
+  void    Resize(PagePtr const &page, std::size_t bytes);
+  void    Release(PagePtr const &page);
+  void    Touch(Page &page);
+  void    MarkDirty(Page &page);
+  void    MarkClean(Page &page);
+  void    RemoveClient(Client &client);
+  /// @}
+
+  /// @name Memory Management
+  /// @{
+  void        Reclaim(std::size_t required = 0);
+  void        WriteBack();
+  void        SetMemoryLimit(std::size_t bytes);
+  std::size_t memory_limit() const;
+  std::size_t memory_usage() const;
+  std::size_t num_pages() const;
+  /// @}
+
+  // Operators
+  BufferPool &operator=(BufferPool const &) = delete;
+  BufferPool &operator=(BufferPool &&) = delete;
+
+private:
+  using Frames      = Page::Frames;
+  using ClientCalls = std::unordered_map<Client const *, std::size_t>;
+  using Condition   = std::condition_variable_any;
+  using ThreadPtr   = std::unique_ptr<std::thread>;
+  using PageArray   = std::vector<PagePtr>;
+  using GaugePtr    = telemetry::GaugePtr<uint64_t>;
+
+  PagePtr SelectVictim(std::size_t required, std::size_t &steps);
+  void    RemoveFrame(Page &page);
+  void    CompleteCall(Page &page);
+  void    ThreadEntryPoint();
+
+  mutable Mutex     lock_;
+  Condition         calls_complete_;
+  Condition         write_back_wake_;
+  std::size_t       memory_limit_;
+  std::size_t       memory_usage_{0};
+  Frames            frames_{};
+  Frames::iterator  hand_{frames_.end()};
+  ClientCalls       client_calls_{};  ///< The number of calls in flight for each client
+  std::atomic<bool> running_{true};
+  ThreadPtr         write_back_thread_{};
+
+  // Telemetry
+  telemetry::CounterPtr hit_count_;
+  telemetry::CounterPtr miss_count_;
+  telemetry::CounterPtr eviction_count_;
+  telemetry::CounterPtr eviction_failure_count_;
+  telemetry::CounterPtr write_back_count_;
+  GaugePtr              memory_usage_gauge_;
+};
+
+}  // namespace storage
+}  // namespace fetch
@@ -18,12 +18,14 @@
 //------------------------------------------------------------------------------
 
 #include "core/assert.hpp"
+#include "storage/buffer_pool.hpp"
 #include "storage/random_access_stack.hpp"
 
 #include <algorithm>
 #include <array>
 #include <fstream>
 #include <map>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -41,9 +43,12 @@ namespace storage {
  * small and guard against loss of data in the event of system failure. Sets and gets will fill
  * this map.
  *
+ * In addition to its own memory limit, every cache line is accounted for in a (by default process
+ * wide) BufferPool. The pool may evict lines or write dirty lines back to disk from other threads
+ * in order to keep the total memory used by all the stacks within its limit.
  */
 template <typename T, typename D = uint64_t>
-class CacheLineRandomAccessStack
+class CacheLineRandomAccessStack : public BufferPool::Client
 {
 public:
   using EventHandlerType = std::function<void()>;
@@ -51,10 +56,13 @@ public:
   using HeaderExtraType  = D;
   using type             = T;
 
-  CacheLineRandomAccessStack() = default;
+  CacheLineRandomAccessStack()                                   = default;
+  CacheLineRandomAccessStack(CacheLineRandomAccessStack const &) = delete;
+  CacheLineRandomAccessStack(CacheLineRandomAccessStack &&)      = delete;
 
-  ~CacheLineRandomAccessStack()
+  ~CacheLineRandomAccessStack() override
   {
+    pool_->RemoveClient(*this);
     Flush(false);
   }
 
@@ -72,6 +80,7 @@ public:
 
   void Load(std::string const &filename, bool const &create_if_not_exists = true)
   {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
     stack_.Load(filename, create_if_not_exists);
     this->objects_ = stack_.size();
     this->SignalFileLoaded();
@@ -79,6 +88,7 @@ public:
 
   void New(std::string const &filename)
   {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
     stack_.New(filename);
     this->objects_ = 0;
     this->SignalFileLoaded();
@@ -104,6 +114,8 @@ public:
   {
     assert(i < objects_);
 
+    std::lock_guard<std::recursive_mutex> guard(lock_);
+
     uint64_t cache_lookup   = i >> cache_line_ln2;              // Upper N bits
     uint64_t cache_subindex = i & ((1 << cache_line_ln2) - 1);  // Lower total - N bits
 
@@ -113,15 +125,16 @@ public:
     if (iter != data_.end())
     {
       ++((*iter).second.reads);
+      pool_->Touch(*iter->second.page);
       object = iter->second.elements[cache_subindex];
     }
     else
     {
       // Case where item isn't found, load it into the cache, then access
-      LoadCacheLine(i);
+      auto &line = LoadCacheLine(i);
 
-      data_[cache_lookup].reads++;
-      object = data_[cache_lookup].elements[cache_subindex];
+      line.reads++;
+      object = line.elements[cache_subindex];
     }
   }
 
@@ -135,6 +148,8 @@ public:
   {
     assert(i < objects_);
 
+    std::lock_guard<std::recursive_mutex> guard(lock_);
+
     uint64_t cache_lookup   = i >> cache_line_ln2;              // Upper N bits
     uint64_t cache_subindex = i & ((1 << cache_line_ln2) - 1);  // Lower total - N bits
 
@@ -144,36 +159,43 @@ public:
     if (iter != data_.end())
     {
       ++iter->second.writes;
+      pool_->MarkDirty(*iter->second.page);
       iter->second.elements[cache_subindex] = object;
     }
     else
     {
       // Case where item isn't found, load it into the cache, then access
-      LoadCacheLine(i);
+      auto &line = LoadCacheLine(i);
 
-      data_[cache_lookup].writes++;
-      data_[cache_lookup].elements[cache_subindex] = object;
+      line.writes++;
+      pool_->MarkDirty(*line.page);
+      line.elements[cache_subindex] = object;
     }
   }
 
   void Close()
   {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
     Flush(false);
     stack_.Close(false);
   }
 
   void SetExtraHeader(HeaderExtraType const &he)
   {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
     stack_.SetExtraHeader(he);
   }
 
   HeaderExtraType const &header_extra() const
   {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
     return stack_.header_extra();
   }
 
   uint64_t Push(type const &object)
   {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
+
     uint64_t ret = objects_;
 
     ++objects_;
@@ -190,11 +212,14 @@ public:
    */
   void Pop()
   {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
     --objects_;
   }
 
   type Top()
   {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
+
     type ret;
     Get(objects_ - 1, ret);
     return ret;
@@ -207,48 +232,43 @@ public:
       return;
     }
 
-    uint64_t cache_lookup_i = i >> cache_line_ln2;
-    uint64_t cache_lookup_j = j >> cache_line_ln2;
-
-    uint64_t cache_subindex_i = i & ((1 << cache_line_ln2) - 1);
-    uint64_t cache_subindex_j = j & ((1 << cache_line_ln2) - 1);
+    std::lock_guard<std::recursive_mutex> guard(lock_);
 
-    // make sure both items are in the cache
-    if (data_.find(cache_lookup_i) == data_.end())
-    {
-      LoadCacheLine(cache_lookup_i);
-    }
-
-    if (data_.find(cache_lookup_j) == data_.end())
-    {
-      LoadCacheLine(cache_lookup_j);
-    }
+    // the elements are swapped one at a time, since loading the second cache line may cause the
+    // first to be evicted
+    type object_i;
+    type object_j;
 
-    // If this assertion fails, there might not be enough memory for two cache lines
-    assert(data_.find(cache_lookup_i) != data_.end());
-    assert(data_.find(cache_lookup_j) != data_.end());
-
-    data_[cache_lookup_i].reads++;
-    data_[cache_lookup_j].reads++;
-
-    std::swap(data_[cache_lookup_i].elements[cache_subindex_i],
-              data_[cache_lookup_j].elements[cache_subindex_j]);
+    Get(i, object_i);
+    Get(j, object_j);
+    Set(i, object_j);
+    Set(j, object_i);
   }
 
   std::size_t size() const
   {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
     return objects_;
   }
 
   std::size_t empty() const
   {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
     return objects_ == 0;
   }
 
   void Clear()
   {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
+
     stack_.Clear();
     objects_ = 0;
+
+    for (auto const &line : data_)
+    {
+      pool_->Release(line.second.page);
+    }
+
     data_.clear();
   }
 
@@ -259,7 +279,9 @@ public:
   {
     if (!lazy)
     {
-      for (auto const &i : data_)
+      std::lock_guard<std::recursive_mutex> guard(lock_);
+
+      for (auto &i : data_)
       {
         FlushLine(i.first << cache_line_ln2, i.second);
       }
@@ -279,6 +301,7 @@ public:
 
   bool is_open() const
   {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
     return stack_.is_open();
   }
 
@@ -293,6 +316,84 @@ public:
     memory_limit_bytes_ = bytes;
   }
 
+  /**
+   * Move the cache lines of this stack to a different buffer pool
+   *
+   * @param: pool The buffer pool to be used
+   */
+  void SetBufferPool(BufferPool &pool)
+  {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
+
+    pool_->RemoveClient(*this);
+    pool_ = &pool;
+
+    for (auto &line : data_)
+    {
+      bool const dirty = line.second.page->dirty();
+
+      line.second.page = pool_->Admit(*this, line.first, sizeof(CachedDataItem));
+      if (dirty)
+      {
+        pool_->MarkDirty(*line.second.page);
+      }
+    }
+  }
+
+  /// @name Buffer Pool Client
+  /// @{
+
+  /**
+   * Evict a cache line at the request of the buffer pool
+   *
+   * @param: id The index of the cache line
+   * @return: false if the stack is busy on another thread or the line is not cached, otherwise
+   *          true
+   */
+  bool TryEvictPage(BufferPool::PageId id) override
+  {
+    std::unique_lock<std::recursive_mutex> guard(lock_, std::try_to_lock);
+    if (!guard.owns_lock())
+    {
+      return false;
+    }
+
+    auto it = data_.find(id);
+    if (it == data_.end())
+    {
+      return false;
+    }
+
+    EvictLine(it);
+
+    return true;
+  }
+
+  /**
+   * Write back a dirty cache line at the request of the buffer pool
+   *
+   * @param: id The index of the cache line
+   * @return: false if the stack is busy on another thread, otherwise true
+   */
+  bool TryWriteBackPage(BufferPool::PageId id) override
+  {
+    std::unique_lock<std::recursive_mutex> guard(lock_, std::try_to_lock);
+    if (!guard.owns_lock())
+    {
+      return false;
+    }
+
+    auto it = data_.find(id);
+    if (it != data_.end())
+    {
+      FlushLine(it->first << cache_line_ln2, it->second);
+    }
+
+    return true;
+  }
+
+  /// @}
+
 private:
   // Cached items
   static constexpr std::size_t cache_line_ln2 = 13;  // Default cache lines 8192 * sizeof(T)
@@ -310,14 +411,19 @@ private:
   {
     uint64_t                              reads  = 0;
     uint64_t                              writes = 0;
+    BufferPool::PagePtr                   page{};
     std::array<type, 1 << cache_line_ln2> elements{};
   };
 
-  mutable std::map<uint64_t, CachedDataItem> data_;
-  mutable uint64_t                           last_removed_index_ = 0;
-  uint64_t                                   objects_            = 0;
+  using LineMap = std::map<uint64_t, CachedDataItem>;
+
+  mutable std::recursive_mutex lock_;
+  mutable LineMap              data_;
+  mutable uint64_t             last_removed_index_ = 0;
+  uint64_t                     objects_            = 0;
+  BufferPool *                 pool_               = &BufferPool::Instance();
 
-  void FlushLine(uint64_t line, CachedDataItem const &items) const
+  void FlushLine(uint64_t line, CachedDataItem &items) const
   {
     if (items.writes == 0)
     {
@@ -330,6 +436,21 @@ private:
     }
 
     stack_.SetBulk(line, 1ull << cache_line_ln2, items.elements.data());
+
+    items.writes = 0;
+    pool_->MarkClean(*items.page);
+  }
+
+  /**
+   * Write back a cache line if required, and remove it from the cache
+   *
+   * @param: it The iterator to the cache line
+   */
+  void EvictLine(typename LineMap::iterator it) const
+  {
+    FlushLine(it->first << cache_line_ln2, it->second);
+    pool_->Release(it->second.page);
+    data_.erase(it);
   }
 
   void GetLine(uint64_t line, CachedDataItem &items) const
@@ -355,25 +476,22 @@ private:
     // Find and remove next index up from the last one we removed
     auto next_to_remove = data_.upper_bound(last_removed_index_);
 
-    if (next_to_remove->first > last_removed_index_ && next_to_remove != data_.end())
+    if (next_to_remove != data_.end() && next_to_remove->first > last_removed_index_)
     {
       last_removed_index_ = next_to_remove->first;
-      FlushLine(next_to_remove->first << cache_line_ln2, next_to_remove->second);
-      data_.erase(next_to_remove);
+      EvictLine(next_to_remove);
     }
     else
     {
-      next_to_remove = data_.begin();  // Get min element
-      FlushLine(next_to_remove->first << cache_line_ln2, next_to_remove->second);
+      next_to_remove      = data_.begin();  // Get min element
       last_removed_index_ = next_to_remove->first;
-
-      data_.erase(next_to_remove);
+      EvictLine(next_to_remove);
     }
 
     return true;
   }
 
-  void LoadCacheLine(uint64_t line) const
+  CachedDataItem &LoadCacheLine(uint64_t line) const
   {
     // Cull memory usage to max allowed
     for (;;)
@@ -384,9 +502,19 @@ private:
       }
     }
 
+    // Make room in the buffer pool, which may evict lines from this or other stacks
+    pool_->Reclaim(sizeof(CachedDataItem));
+
     // Load in the cache line (memory usage now slightly over)
-    uint64_t cache_index = (line >> cache_line_ln2) << cache_line_ln2;
-    GetLine(cache_index, data_[cache_index >> cache_line_ln2]);
+    uint64_t cache_lookup = line >> cache_line_ln2;
+    uint64_t cache_index  = cache_lookup << cache_line_ln2;
+    auto &   items        = data_[cache_lookup];
+
+    GetLine(cache_index, items);
+    items.page = pool_->Admit(*const_cast<CacheLineRandomAccessStack *>(this), cache_lookup,
+                              sizeof(CachedDataItem));
+
+    return items;
   }
 
   void SignalFileLoaded()
@@ -25,10 +25,12 @@
 //  └──────┴───────────┴───────────┴───────────┴───────────┘
 
 #include "core/assert.hpp"
+#include "storage/buffer_pool.hpp"
 #include "storage/random_access_stack.hpp"
 
 #include <fstream>
 #include <map>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -45,9 +47,12 @@ namespace storage {
  * small and guard against loss of data in the event of system failure. Sets and gets will fill
  * this map.
  *
+ * The cached elements are grouped into pages which are accounted for in a (by default process
+ * wide) BufferPool. Since writes must not reach the underlying stack before the user flushes, the
+ * pool is only able to evict elements which have not been updated.
  */
 template <typename T, typename D = uint64_t, typename STACK = RandomAccessStack<T, D>>
-class CachedRandomAccessStack
+class CachedRandomAccessStack : public BufferPool::Client
 {
 public:
   using EventHandlerType = std::function<void()>;
@@ -64,8 +69,12 @@ public:
     stack_.OnBeforeFlush([this]() { SignalBeforeFlush(); });
   }
 
-  ~CachedRandomAccessStack()
+  CachedRandomAccessStack(CachedRandomAccessStack const &) = delete;
+  CachedRandomAccessStack(CachedRandomAccessStack &&)      = delete;
+
+  ~CachedRandomAccessStack() override
   {
+    pool_->RemoveClient(*this);
     stack_.ClearEventHandlers();
   }
 
@@ -97,12 +106,14 @@ public:
 
   void Load(std::string const &filename, bool const &create_if_not_exists = true)
   {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
     stack_.Load(filename, create_if_not_exists);
     this->SignalFileLoaded();
   }
 
   void New(std::string const &filename)
   {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
     stack_.New(filename);
     Clear();
     this->SignalFileLoaded();
@@ -112,12 +123,15 @@ public:
   {
     assert(i < objects_);
 
+    std::lock_guard<std::recursive_mutex> guard(lock_);
+
     auto iter = data_.find(i);
 
     // Found the item via local map
     if (iter != data_.end())
     {
       ++iter->second.reads;
+      pool_->Touch(*iter->second.page);
       object = iter->second.data;
     }
     else
@@ -126,6 +140,7 @@ public:
       stack_.Get(i, object);
       CachedDataItem itm;
       itm.data = object;
+      itm.page = AddToPage(i);
       data_.insert(std::pair<uint64_t, CachedDataItem>(i, itm));
     }
   }
@@ -140,6 +155,8 @@ public:
   {
     assert(i < objects_);
 
+    std::lock_guard<std::recursive_mutex> guard(lock_);
+
     auto iter = data_.find(i);
     if (iter != data_.end())
     {
@@ -147,6 +164,7 @@ public:
       cached_element.writes++;
       cached_element.updated = true;
       cached_element.data    = object;
+      pool_->Touch(*cached_element.page);
     }
     else
     {
@@ -154,12 +172,14 @@ public:
       itm.data    = object;
       itm.updated = true;
       itm.writes  = 1;
+      itm.page    = AddToPage(i);
       data_.insert(std::pair<uint64_t, CachedDataItem>(i, itm));
     }
   }
 
   void Close()
   {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
     Flush();
 
     stack_.Close(true);
@@ -172,15 +192,19 @@ public:
 
   HeaderExtraType const &header_extra() const
   {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
     return stack_.header_extra();
   }
 
   uint64_t Push(type const &object)
   {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
+
     uint64_t       ret = objects_;
     CachedDataItem itm;
     itm.data    = object;
     itm.updated = true;
+    itm.page    = AddToPage(ret);
     data_.insert(std::pair<uint64_t, CachedDataItem>(ret, itm));
     ++objects_;
 
@@ -189,12 +213,19 @@ public:
 
   void Pop()
   {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
+
     --objects_;
-    data_.erase(objects_);
+    if (data_.erase(objects_) != 0)
+    {
+      RemoveFromPage(objects_);
+    }
   }
 
   type Top() const
   {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
+
     type ret;
     Get(objects_ - 1, ret);
     return ret;
@@ -208,25 +239,44 @@ public:
       return;
     }
 
-    data_.find(i)->second.updated = true;
-    data_.find(j)->second.updated = true;
-    std::swap(data_[i], data_[j]);
+    std::lock_guard<std::recursive_mutex> guard(lock_);
+
+    // either of the elements may have been evicted from the cache, so they are swapped through
+    // the regular accessors
+    type object_i;
+    type object_j;
+
+    Get(i, object_i);
+    Get(j, object_j);
+    Set(i, object_j);
+    Set(j, object_i);
   }
 
   std::size_t size() const
   {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
     return objects_;
   }
   std::size_t empty() const
   {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
     return objects_ == 0;
   }
 
   void Clear()
   {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
+
     stack_.Clear();
     objects_ = 0;
     data_.clear();
+
+    for (auto const &page : pages_)
+    {
+      pool_->Release(page.second.page);
+    }
+
+    pages_.clear();
   }
 
   /**
@@ -234,6 +284,8 @@ public:
    */
   void Flush(bool /*lazy*/ = true)
   {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
+
     this->SignalBeforeFlush();
 
     for (auto &item : data_)
@@ -280,6 +332,83 @@ public:
     return stack_;
   }
 
+  /**
+   * Move the cached elements of this stack to a different buffer pool
+   *
+   * @param: pool The buffer pool to be used
+   */
+  void SetBufferPool(BufferPool &pool)
+  {
+    std::lock_guard<std::recursive_mutex> guard(lock_);
+
+    pool_->RemoveClient(*this);
+    pool_ = &pool;
+
+    for (auto &page : pages_)
+    {
+      page.second.page = pool_->Admit(*this, page.first, page.second.count * ITEM_BYTES);
+    }
+
+    for (auto &item : data_)
+    {
+      item.second.page = pages_[item.first >> PAGE_SIZE_LN2].page.get();
+    }
+  }
+
+  /// @name Buffer Pool Client
+  /// @{
+
+  /**
+   * Evict the elements of a page which have not been updated, at the request of the buffer pool
+   *
+   * @param: id The index of the page
+   * @return: false if the stack is busy on another thread or no element could be evicted,
+   *          otherwise true
+   */
+  bool TryEvictPage(BufferPool::PageId id) override
+  {
+    std::unique_lock<std::recursive_mutex> guard(lock_, std::try_to_lock);
+    if (!guard.owns_lock())
+    {
+      return false;
+    }
+
+    auto       it  = data_.lower_bound(id << PAGE_SIZE_LN2);
+    auto const end = data_.lower_bound((id + 1) << PAGE_SIZE_LN2);
+
+    bool evicted{false};
+    while (it != end)
+    {
+      if (it->second.updated)
+      {
+        ++it;
+      }
+      else
+      {
+        uint64_t const index = it->first;
+
+        it = data_.erase(it);
+        RemoveFromPage(index);
+
+        evicted = true;
+      }
+    }
+
+    return evicted;
+  }
+
+  /**
+   * Updated elements are only written to the underlying stack when the user flushes
+   *
+   * @return: false
+   */
+  bool TryWriteBackPage(BufferPool::PageId /*id*/) override
+  {
+    return false;
+  }
+
+  /// @}
+
 private:
   static constexpr std::size_t MAX_SIZE_BYTES = 10000;
   EventHandlerType             on_file_loaded_;
@@ -291,14 +420,84 @@ private:
   // Cached items
   struct CachedDataItem
   {
-    uint64_t reads   = 0;
-    uint64_t writes  = 0;
-    bool     updated = false;
-    type     data{};
+    uint64_t           reads   = 0;
+    uint64_t           writes  = 0;
+    bool               updated = false;
+    BufferPool::Page * page    = nullptr;
+    type               data{};
   };
 
-  mutable std::map<uint64_t, CachedDataItem> data_;
-  uint64_t                                   objects_ = 0;
+  // Buffer pool pages, which are accounted for by the number of elements actually cached
+  static constexpr uint64_t    PAGE_SIZE_LN2 = 8;
+  static constexpr std::size_t ITEM_BYTES    = sizeof(CachedDataItem);
+
+  struct PageEntry
+  {
+    BufferPool::PagePtr page{};
+    std::size_t         count = 0;
+  };
+
+  mutable std::recursive_mutex                    lock_;
+  mutable std::map<uint64_t, CachedDataItem>      data_;
+  mutable std::unordered_map<uint64_t, PageEntry> pages_;
+  uint64_t                                        objects_ = 0;
+  BufferPool *                                    pool_    = &BufferPool::Instance();
+
+  /**
+   * Account for an element which is about to be added to the cache
+   *
+   * @param: index The index of the element
+   * @return: The page which the element belongs to
+   */
+  BufferPool::Page *AddToPage(uint64_t index) const
+  {
+    uint64_t const id = index >> PAGE_SIZE_LN2;
+
+    // make room in the buffer pool, which may evict elements from this or other stacks
+    pool_->Reclaim(ITEM_BYTES);
+
+    auto it = pages_.find(id);
+    if (it == pages_.end())
+    {
+      PageEntry entry{};
+      entry.page = pool_->Admit(*const_cast<CachedRandomAccessStack *>(this), id, ITEM_BYTES);
+
+      it = pages_.emplace(id, std::move(entry)).first;
+    }
+    else
+    {
+      pool_->Resize(it->second.page, (it->second.count + 1) * ITEM_BYTES);
+      pool_->Touch(*it->second.page);
+    }
+
+    ++it->second.count;
+
+    return it->second.page.get();
+  }
+
+  /**
+   * Account for an element which has been removed from the cache
+   *
+   * @param: index The index of the element
+   */
+  void RemoveFromPage(uint64_t index) const
+  {
+    auto it = pages_.find(index >> PAGE_SIZE_LN2);
+    if (it == pages_.end())
+    {
+      return;
+    }
+
+    if (--it->second.count == 0)
+    {
+      pool_->Release(it->second.page);
+      pages_.erase(it);
+    }
+    else
+    {
+      pool_->Resize(it->second.page, it->second.count * ITEM_BYTES);
+    }
+  }
 
   // TODO(issue 13): Move private or protected
   void SignalFileLoaded()
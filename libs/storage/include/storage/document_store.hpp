@@ -28,6 +28,7 @@
 #include <cassert>
 #include <fstream>
 #include <memory>
+#include <vector>
 
 namespace fetch {
 namespace storage {
@@ -130,6 +131,48 @@ public:
     return GetOrCreate(rid, false);
   }
 
+  /**
+   * Get a set of documents, reading them from the file store as a single batch
+   *
+   * @param: rids The resources to be read
+   * @return: The documents, one for each resource. Missing documents are marked as failed
+   */
+  std::vector<Document> GetBatch(std::vector<ResourceID> const &rids)
+  {
+    std::vector<Document>    documents(rids.size());
+    std::vector<std::size_t> indices{};
+    std::vector<std::size_t> positions{};
+
+    indices.reserve(rids.size());
+    positions.reserve(rids.size());
+
+    FETCH_LOCK(mutex_);
+
+    for (std::size_t i = 0; i < rids.size(); ++i)
+    {
+      IndexType index = 0;
+
+      if (key_index_.GetIfExists(rids[i].id(), index))
+      {
+        indices.push_back(index);
+        positions.push_back(i);
+      }
+      else
+      {
+        documents[i].failed = true;
+      }
+    }
+
+    auto found = file_object_.GetDocuments(indices);
+
+    for (std::size_t i = 0; i < found.size(); ++i)
+    {
+      documents[positions[i]] = std::move(found[i]);
+    }
+
+    return documents;
+  }
+
   void Set(ResourceID const &rid, byte_array::ConstByteArray const &value)
   {
     byte_array::ConstByteArray const &address = rid.id();
@@ -30,7 +30,10 @@
 #include "telemetry/registry.hpp"
 #include "telemetry/utils/timer.hpp"
 
+#include <cstddef>
 #include <map>
+#include <string>
+#include <vector>
 
 namespace fetch {
 namespace storage {
@@ -57,6 +60,8 @@ public:
     CURRENT_HASH,
     HASH_EXISTS,
     RESET,
+    GET_BATCH,
+    SET_BATCH,
 
     LOCK = 20,
     UNLOCK,
@@ -76,6 +81,10 @@ public:
     , hash_exists_count_(
           CreateCounter(lane, "ledger_statedb_hash_exist_total", "The total no. hash_exists ops"))
     , reset_count_(CreateCounter(lane, "ledger_statedb_reset_total", "The total no. reset ops"))
+    , get_batch_count_(
+          CreateCounter(lane, "ledger_statedb_get_batch_total", "The total no. batched get ops"))
+    , set_batch_count_(
+          CreateCounter(lane, "ledger_statedb_set_batch_total", "The total no. batched set ops"))
     , lock_count_(CreateCounter(lane, "ledger_statedb_lock_total", "The total no. lock ops"))
     , unlock_count_(CreateCounter(lane, "ledger_statedb_unlock_total", "The total no. unlock ops"))
     , has_lock_count_(
@@ -88,10 +97,16 @@ public:
                                       "The histogram of lock request durations"))
     , unlock_durations_(CreateHistogram(lane, "ledger_statedb_unlock_request_seconds",
                                         "The histogram of unlock request durations"))
+    , get_batch_durations_(CreateHistogram(lane, "ledger_statedb_get_batch_request_seconds",
+                                           "The histogram of batched get request durations"))
+    , set_batch_durations_(CreateHistogram(lane, "ledger_statedb_set_batch_request_seconds",
+                                           "The histogram of batched set request durations"))
   {
     this->Expose(GET, this, &RevertibleDocumentStoreProtocol::Get);
     this->Expose(GET_OR_CREATE, this, &RevertibleDocumentStoreProtocol::GetOrCreate);
     this->Expose(SET, this, &RevertibleDocumentStoreProtocol::Set);
+    this->Expose(GET_BATCH, this, &RevertibleDocumentStoreProtocol::GetBatch);
+    this->Expose(SET_BATCH, this, &RevertibleDocumentStoreProtocol::SetBatch);
 
     // Functionality for hashing/state
     this->Expose(COMMIT, this, &RevertibleDocumentStoreProtocol::Commit);
@@ -247,6 +262,35 @@ private:
     set_count_->increment();
   }
 
+  std::vector<Document> GetBatch(std::vector<ResourceID> const &rids)
+  {
+    telemetry::FunctionTimer const timer{*get_batch_durations_};
+
+    auto docs = doc_store_->GetBatch(rids);
+
+    get_batch_count_->increment();
+    return docs;
+  }
+
+  void SetBatch(std::vector<ResourceID> const &                rids,
+                std::vector<byte_array::ConstByteArray> const &data)
+  {
+    telemetry::FunctionTimer const timer{*set_batch_durations_};
+
+    if (rids.size() != data.size())
+    {
+      throw serializers::SerializableException(  // TODO(issue 11): set exception number
+          0, ByteArrayType(std::string("Mismatched number of keys and values in batch set.")));
+    }
+
+    for (std::size_t i = 0; i < rids.size(); ++i)
+    {
+      doc_store_->Set(rids[i], data[i]);
+    }
+
+    set_batch_count_->increment();
+  }
+
   NewRevertibleDocumentStore::Hash Commit()
   {
     auto const hash = doc_store_->Commit();
@@ -306,6 +350,8 @@ private:
   telemetry::CounterPtr   current_hash_count_;
   telemetry::CounterPtr   hash_exists_count_;
   telemetry::CounterPtr   reset_count_;
+  telemetry::CounterPtr   get_batch_count_;
+  telemetry::CounterPtr   set_batch_count_;
   telemetry::CounterPtr   lock_count_;
   telemetry::CounterPtr   unlock_count_;
   telemetry::CounterPtr   has_lock_count_;
@@ -313,6 +359,8 @@ private:
   telemetry::HistogramPtr set_durations_;
   telemetry::HistogramPtr lock_durations_;
   telemetry::HistogramPtr unlock_durations_;
+  telemetry::HistogramPtr get_batch_durations_;
+  telemetry::HistogramPtr set_batch_durations_;
 };
 
 }  // namespace storage
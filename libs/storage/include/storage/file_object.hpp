@@ -15,21 +15,14 @@
 //   See the License for the specific language governing permissions and
 //   limitations under the License.
 //
-//------------------------------------------------------------------------------
 
-//    ┌────────────────────────────────────────────────┐
-//    │      ┌──────┬────────────────────┐             │
-//    │      │      │                    │             │
-//    ▼      │      │                    ▼             │
-// ┌──────┬──────┬──────┬──────┬──────┬──────┬──────┬──────┐
-// │ FREE │Obj1.1│Obj1.2│ FREE │Obj2.1│Obj1.3│Obj2.2│ FREE │
-// │  LL  │      │      │      │      │      │      │      │
-// └──────┴──────┴──────┴──────┴──────┴──────┴──────┴──────┘
-//    │                    ▲      │             ▲      ▲
-//    │                    │      │             │      │
-//    │                    │      └─────────────┘      │
-//    │                    │                           │
-//    └────────────────────┴───────────────────────────┘
+// ┌──────┬──────┬──────┬──────┬──────┬──────┬──────┬──────┬──────┐
+// │ FREE │ Obj1 │ Obj1 │ Obj1 │ FREE │ FREE │ Obj2 │ Obj2 │ Obj1 │
+// │ MAP  │ Ext1 │      │      │ Run  │      │ Ext1 │      │ Ext2 │
+// └──────┴──────┴──────┴──────┴──────┴──────┴──────┴──────┴──────┘
+//    │      │                    ▲                           ▲
+//    │      └────────────────────┼───────────────────────────┘
+//    └───────────────────────────┘
 
 #include "core/byte_array/const_byte_array.hpp"
 #include "crypto/sha256.hpp"
@@ -39,7 +32,9 @@
 #include "storage/versioned_random_access_stack.hpp"
 #include "vectorise/platform.hpp"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <vector>
 
 namespace fetch {
@@ -66,10 +61,10 @@ struct FileBlockType
 
   // Metadata
   uint64_t next     = UNDEFINED;
-  uint64_t previous = UNDEFINED;  // For the free block, this points to the end of the LL.
+  uint64_t previous = UNDEFINED;  // For the first block of an extent or free run, its length.
 
   // Either the size of the file object, or in the case this block is
-  // used as the 'free linked list', this is the number of free blocks.
+  // used as the free space map, this is the number of free blocks.
   // this is only valid for the first block.
   union
   {
@@ -83,18 +78,27 @@ struct FileBlockType
 
 /**
  * FileObject represents 'files' (objects) of varying length in a filesystem. Given the user knows
- * the starting index of their file, it can be recovered by traversing the stack.
- *
- * The file is stored on the stack as a doubly linked list, where each list element contains some
- * number of bytes of the file. This means that a high block size will increase wasted space and a
- * small block size will increase the file recovery time.
+ * the starting index of their file, it can be recovered by reading its extent table.
  *
- * In order to support deletion of blocks, the first block in the stack represents a doubly linked
- * list of all the free blocks. If there are free blocks this will be used when getting new blocks.
+ * Each file is stored on the stack as a small number of extents, which are contiguous runs of
+ * blocks. The first block of each extent records the length of the extent and the location of the
+ * next extent, so the extent table of a file is recovered with one read per extent rather than one
+ * read per block. The first block of the first extent is the id of the file and also records its
+ * size. Files are allocated as a single extent, and when a file that already has MAX_EXTENTS
+ * extents grows its trailing extents are relocated into a single run, so reading a file requires at
+ * most two sequential runs of reads. Each run is read and written in bulk. When a file grows into a
+ * new extent its capacity is (at least) doubled, so the cost of relocation is amortised, and it
+ * only shrinks once less than half of its blocks are needed.
  *
- * The free block list is ordered, and files are ordered, to be incrementing in memory. This is
- * in order to reduce programmer error.
+ * The first block in the stack is the free space map. Free runs of blocks are kept in doubly
+ * linked lists by size class (the power of two of their length), the heads of which are stored in
+ * the data of the first block. The first and last blocks of each free run are tagged with its
+ * length, so a released run is coalesced with the free runs on either side of it. Allocations take
+ * the front of the first free run which is large enough, returning the remainder to the map, and
+ * otherwise extend the stack.
  *
+ * Stacks in the original format, where each file is a linked list of single blocks, are converted
+ * to this format when they are loaded.
  */
 template <typename S = VersionedRandomAccessStack<FileBlockType<>>>
 class FileObject
@@ -159,6 +163,8 @@ public:
 
   Document AsDocument();
 
+  std::vector<Document> GetDocuments(std::vector<std::size_t> const &ids);
+
   void Erase();
 
   bool VerifyConsistency(std::vector<uint64_t> const &ids);
@@ -168,30 +174,44 @@ public:
 
   void UpdateVariables()
   {
-    block_index_ = 0;
-    id_          = 0;
+    id_                = 0;
+    byte_index_global_ = 0;
+    length_            = 0;
+    extents_.clear();
   }
 
 private:
-  StackType stack_;
+  struct Extent
+  {
+    uint64_t start  = 0;
+    uint64_t length = 0;
+  };
+
+  using Extents = std::vector<Extent>;
+
+  static constexpr uint64_t FORMAT_TAG       = 0x32544e4554584546ull;  // "FEXTENT2"
+  static constexpr uint64_t FREE_HEAD_TAG    = BlockType::UNDEFINED - 1;
+  static constexpr uint64_t FREE_TAIL_TAG    = BlockType::UNDEFINED - 2;
+  static constexpr uint64_t MAX_EXTENTS      = 2;
+  static constexpr uint64_t MAX_FIT_SEARCH   = 8;
+  static constexpr uint64_t MAX_BULK_BLOCKS  = 64;
+  static constexpr uint64_t NUM_SIZE_CLASSES = std::min<uint64_t>(
+      (BlockType::CAPACITY / sizeof(uint64_t)) - 1, 8 * sizeof(uint64_t));
 
-  std::vector<std::vector<std::tuple<uint64_t, uint64_t, uint64_t>>> linked_lists;
+  static_assert(NUM_SIZE_CLASSES > 0, "Block size is too small for the free space map");
+
+  StackType stack_;
 
   // tracking variables relating to current file object
   uint64_t id_                = 0;  // Location on stack of first block of file
-  uint64_t block_number_      = 0;  // Nth block in file we are looking at
-  uint64_t block_index_       = 0;  // index of block_number_ on the stack
-  uint64_t byte_index_        = 0;  // index of current byte within BLOCK
   uint64_t byte_index_global_ = 0;  // index of current byte within file
   uint64_t length_            = 0;  // length in bytes of file.
-                                    // can be found from Get(id) right - any point in keeping?
+  Extents  extents_{};              // the extent table of the file
 
-  // TODO(private 1067): BlockType -> BlockType etc.
-  // TODO(private 1067): possibly some performance benefits by caching blocks like the free block
-  // here
-  static constexpr uint64_t free_block_index_ = 0;  // Location of the meta 'free block'
+  static constexpr uint64_t free_block_index_ = 0;  // Location of the free space map
 
   void Initalise();
+  void ConvertLinkedListFormat(BlockType const &old_free_block);
 
   enum class Action
   {
@@ -199,17 +219,41 @@ private:
     WRITE
   };
 
-  uint64_t GetFreeBlocks(uint64_t min_index, uint64_t num);
-
   uint64_t FreeBlocks();
 
-  void FreeBlocksInList(uint64_t remove_index);
-
   void ReadWriteHelper(uint8_t const *bytes, uint64_t num, Action action);
 
+  /// @name Extent Table
+  /// @{
+  void     LoadExtents();
+  void     StoreExtents();
+  uint64_t NumBlocks() const;
+  uint64_t BlockIndex(uint64_t block_number, uint64_t &run_length) const;
+  void     Grow(uint64_t num);
+  void     Shrink(uint64_t num);
+  /// @}
+
+  /// @name Free Space Map
+  /// @{
+  static BlockType NewFreeSpaceMap();
+  static uint64_t  SizeClass(uint64_t length);
+  static uint64_t ReadWord(BlockType const &block, uint64_t word);
+  static void     WriteWord(BlockType &block, uint64_t word, uint64_t value);
+
+  Extent Allocate(uint64_t num);
+  bool   TakeFreeRun(uint64_t num, Extent &extent);
+  void   FreeRun(uint64_t start, uint64_t length);
+  bool   FindFreeRunBefore(uint64_t index, Extent &extent);
+  bool   FindFreeRunAt(uint64_t index, Extent &extent);
+  void   LinkFreeRun(BlockType &free_block, uint64_t start, uint64_t length);
+  void   UnlinkFreeRun(BlockType &free_block, uint64_t start);
+  /// @}
+
   void Get(uint64_t index, BlockType &block);
+  void GetBulk(uint64_t index, uint64_t num, BlockType *blocks);
 
   void Set(uint64_t index, BlockType const &block);
+  void SetBulk(uint64_t index, uint64_t num, BlockType const *blocks);
 };
 
 template <typename S>
@@ -229,38 +273,7 @@ void FileObject<S>::Flush(bool lazy)
 template <typename S>
 void FileObject<S>::Seek(uint64_t index)
 {
-  byte_index_global_   = index;
-  byte_index_          = index % BlockType::CAPACITY;
-  uint64_t  desired_bn = index / BlockType::CAPACITY;
-  BlockType block;
-
-  // Optionally start seeking from the first block if that's faster
-  if (desired_bn < block_number_ && block_number_ - desired_bn < desired_bn)
-  {
-    block_number_ = 0;
-  }
-
-  // need to find index of this block on stack
-  while (block_number_ != desired_bn)
-  {
-    if (block_number_ == BlockType::UNDEFINED)
-    {
-      throw StorageException("Attempt to seek to an invalid block");
-    }
-
-    Get(block_index_, block);
-
-    if (desired_bn < block_number_)
-    {
-      block_index_ = block.previous;
-      block_number_--;
-    }
-    else
-    {
-      block_index_ = block.next;
-      block_number_++;
-    }
-  }
+  byte_index_global_ = index;
 }
 
 // TODO(private 1067): make sure everything is const correct
@@ -275,62 +288,25 @@ void FileObject<S>::Resize(uint64_t size)
 {
   // Reset variables which might otherwise point to invalid locations
   Seek(0);
-  BlockType block;
 
-  // Update block 0 with new size
-  {
-    Get(id_, block);
-
-    block.file_object_size = size;
-    Set(id_, block);
-    length_ = size;
-  }
-
-  // Traverse the blocks until the target blocks criteria is fulfilled.
   auto target_blocks = platform::DivideCeil<uint64_t>(size, BlockType::CAPACITY);
 
   // corner case when size is 0 - we need at least one block per file
   target_blocks = target_blocks == 0 ? 1 : target_blocks;
 
-  uint64_t block_number = 1;
-  uint64_t block_index  = id_;
+  uint64_t const current_blocks = NumBlocks();
 
-  for (;;)
+  if (target_blocks > current_blocks)
   {
-    Get(block_index, block);
-
-    uint64_t block_index_tmp = block_index;
-    block_index              = block.next;
-
-    // if we reach the end of the LL, append as many blocks as we need
-    if (block.next == BlockType::UNDEFINED && block_number != target_blocks)
-    {
-      block.next = GetFreeBlocks(block_index_tmp, target_blocks - block_number);
-      Set(block_index_tmp, block);
-
-      uint64_t next_tmp = block.next;
-
-      // need to update the new blocks' backward references too
-      Get(next_tmp, block);
-      block.previous = block_index_tmp;
-      Set(next_tmp, block);
-      break;
-    }
-
-    // If we reach as many blocks we actually need, free the rest
-    if (block_number == target_blocks)
-    {
-      FreeBlocksInList(block_index);
-
-      // Update last block to terminate correctly
-      Get(block_index_tmp, block);
-      block.next = BlockType::UNDEFINED;
-      Set(block_index_tmp, block);
-      break;
-    }
-
-    block_number++;
+    Grow(target_blocks - current_blocks);
   }
+  else if ((target_blocks * 2) < current_blocks)
+  {
+    Shrink(current_blocks - target_blocks);
+  }
+
+  length_ = size;
+  StoreExtents();
 }
 
 template <typename S>
@@ -340,12 +316,13 @@ void FileObject<S>::Write(byte_array::ConstByteArray const &arr)
 }
 
 /**
- * Write bytes to file object, ensuring that the size of the file object is extended if
- * necessary.
- *
- * @param: bytes The bytes to write
- * @param: num The number of bytes to write
+ * Read or write bytes of the file object, starting at the current position. Since the extent
+ * table is held in memory, the blocks of each extent are located directly and read (or written) as
+ * a single contiguous run.
  *
+ * @param: bytes The bytes to read into or write from
+ * @param: num The number of bytes to read or write
+ * @param: action Whether to read or write
  */
 template <typename S>
 void FileObject<S>::ReadWriteHelper(uint8_t const *bytes, uint64_t num, Action action)
@@ -354,42 +331,50 @@ void FileObject<S>::ReadWriteHelper(uint8_t const *bytes, uint64_t num, Action a
          "Attempt to write to the free block as if it were a file is a programmer error in "
          "FileObject");
 
-  uint64_t bytes_left_to_write = num;
-  uint64_t bytes_to_write_in_block =
-      std::min(BlockType::CAPACITY - byte_index_, bytes_left_to_write);
-  BlockType block_being_written;
-  uint64_t  block_index_being_written = block_index_;
-  uint64_t  bytes_offset              = 0;
+  std::vector<BlockType> blocks{};
+  uint64_t               offset       = byte_index_global_;
+  uint64_t               bytes_offset = 0;
 
-  assert(bytes_to_write_in_block <= BlockType::CAPACITY);
-
-  while (bytes_left_to_write > 0)
+  while (bytes_offset < num)
   {
-    // TODO(private 1067): use max size type
-    assert(block_index_being_written != uint64_t(-1) && "Invalid block index during writing");
-    // Get block, write data to it
-    Get(block_index_being_written, block_being_written);
+    uint64_t       byte_index = offset % BlockType::CAPACITY;
+    uint64_t       run_length{0};
+    uint64_t const block_index = BlockIndex(offset / BlockType::CAPACITY, run_length);
+
+    // the blocks remaining in this extent which hold the requested bytes
+    uint64_t const num_blocks = std::min(
+        {run_length, MAX_BULK_BLOCKS,
+         platform::DivideCeil<uint64_t>(byte_index + (num - bytes_offset), BlockType::CAPACITY)});
 
-    switch (action)
+    // the complete blocks are read before writing, since the metadata must be preserved
+    blocks.resize(num_blocks);
+    GetBulk(block_index, num_blocks, blocks.data());
+
+    for (auto &block : blocks)
     {
-    case Action::READ:
-      // NOLINTNEXTLINE
-      memcpy((uint8_t *)(bytes + bytes_offset), block_being_written.data + byte_index_,
-             bytes_to_write_in_block);
-      break;
-    case Action::WRITE:
-      memcpy(block_being_written.data + byte_index_, bytes + bytes_offset, bytes_to_write_in_block);
-      break;
-    }
+      uint64_t const bytes_in_block =
+          std::min(BlockType::CAPACITY - byte_index, num - bytes_offset);
 
-    // Write block back
-    byte_index_ = 0;
-    Set(block_index_being_written, block_being_written);
-    block_index_being_written = block_being_written.next;
+      switch (action)
+      {
+      case Action::READ:
+        // NOLINTNEXTLINE
+        memcpy((uint8_t *)(bytes + bytes_offset), block.data + byte_index, bytes_in_block);
+        break;
+      case Action::WRITE:
+        memcpy(block.data + byte_index, bytes + bytes_offset, bytes_in_block);
+        break;
+      }
+
+      offset += bytes_in_block;
+      bytes_offset += bytes_in_block;
+      byte_index = 0;
+    }
 
-    bytes_offset += bytes_to_write_in_block;
-    bytes_left_to_write -= bytes_to_write_in_block;
-    bytes_to_write_in_block = std::min(BlockType::CAPACITY - byte_index_, bytes_left_to_write);
+    if (action == Action::WRITE)
+    {
+      SetBulk(block_index, num_blocks, blocks.data());
+    }
   }
 }
 
@@ -443,9 +428,6 @@ void FileObject<S>::UpdateHash(HasherType &hasher)
   arr.Resize(length_);
   Read(arr);
 
-  std::string thing = std::string{arr};
-  FETCH_UNUSED(thing);
-
   hasher.Update(arr.pointer(), length_);
 }
 
@@ -457,16 +439,11 @@ bool FileObject<S>::SeekFile(std::size_t position)
     throw StorageException("Attempt to seek file past stack end");
   }
 
-  block_index_ = id_ = position;
-  block_number_      = 0;
-  byte_index_        = 0;
+  id_                = position;
   byte_index_global_ = 0;
 
-  // Need to retrieve the block to determine length
-  BlockType block;
-  Get(id_, block);
-
-  length_ = block.file_object_size;
+  // Need to retrieve the extent table to determine the length and block locations
+  LoadExtents();
 
   return true;
 }
@@ -474,8 +451,6 @@ bool FileObject<S>::SeekFile(std::size_t position)
 template <typename S>
 void FileObject<S>::CreateNewFile(uint64_t size)
 {
-  block_number_      = 0;
-  byte_index_        = 0;
   byte_index_global_ = 0;
   length_            = size;
   auto target_blocks = platform::DivideCeil<uint64_t>(size, BlockType::CAPACITY);
@@ -483,12 +458,11 @@ void FileObject<S>::CreateNewFile(uint64_t size)
   // corner case when size is 0 - we need at least one block per file
   target_blocks = target_blocks == 0 ? 1 : target_blocks;
 
-  block_index_ = id_ = GetFreeBlocks(1, target_blocks);
+  extents_.clear();
+  extents_.push_back(Allocate(target_blocks));
 
-  BlockType block;
-  Get(id_, block);
-  block.file_object_size = size;
-  Set(id_, block);
+  id_ = extents_.front().start;
+  StoreExtents();
 }
 
 /**
@@ -512,10 +486,58 @@ Document FileObject<S>::AsDocument()
   return ret;
 }
 
+/**
+ * Read a set of complete files as documents. The first block of every file is read in a single
+ * batch, with all of the reads in flight at the same time, so a file which fits in its first block
+ * needs no further access to the stack. Larger files are read individually.
+ *
+ * @param: ids The ids of the files to be read
+ * @return: The documents, one for each id
+ */
+template <typename S>
+std::vector<Document> FileObject<S>::GetDocuments(std::vector<std::size_t> const &ids)
+{
+  for (auto const id : ids)
+  {
+    if ((id == free_block_index_) || (id >= stack_.size()))
+    {
+      throw StorageException("Attempt to read file past stack end");
+    }
+  }
+
+  std::vector<BlockType> blocks(ids.size());
+  stack_.GetBatch(ids, blocks.data());
+
+  std::vector<Document> documents(ids.size());
+
+  for (std::size_t i = 0; i < ids.size(); ++i)
+  {
+    uint64_t const length = blocks[i].file_object_size;
+
+    if (length > BlockType::CAPACITY)
+    {
+      SeekFile(ids[i]);
+      documents[i] = AsDocument();
+    }
+    else if (length != 0)
+    {
+      documents[i].document.Resize(length);
+      std::memcpy(documents[i].document.pointer(), blocks[i].data, length);
+    }
+  }
+
+  return documents;
+}
+
 template <typename S>
 void FileObject<S>::Erase()
 {
-  FreeBlocksInList(id_);
+  for (auto const &extent : extents_)
+  {
+    FreeRun(extent.start, extent.length);
+  }
+
+  extents_.clear();
   id_     = std::numeric_limits<uint64_t>::max();
   length_ = 0;
 }
@@ -548,377 +570,818 @@ uint64_t FileObject<S>::FreeBlocks()
 }
 
 /**
- * Initialise by looking for the block that's the beginning of our free blocks linked list. If
- * the stack is empty this means we set our own. Note: this is only immediately after file loading.
+ * Initialise by looking for the free space map at the beginning of the stack. If the stack is
+ * empty this means we set our own. Note: this is only immediately after file loading.
  */
 template <typename S>
 void FileObject<S>::Initalise()
 {
-  BlockType free_block;
-  free_block.free_blocks = 0;
-  free_block.next        = 0;
-  free_block.previous    = 0;
-  block_index_           = 0;
-  id_                    = 0;
+  UpdateVariables();
 
   if (stack_.size() == 0)
   {
-    stack_.Push(free_block);
+    stack_.Push(NewFreeSpaceMap());
+  }
+  else
+  {
+    BlockType free_block;
+    Get(free_block_index_, free_block);
+
+    uint64_t const tag = ReadWord(free_block, 0);
+
+    // the data of the free block is unused, and so zeroed, in the original format
+    if (tag == 0)
+    {
+      ConvertLinkedListFormat(free_block);
+    }
+    else if (tag != FORMAT_TAG)
+    {
+      throw StorageException("Unsupported file object format, the database must be recreated");
+    }
   }
 }
 
 /**
- * Get free block from stack, write block to that location
+ * Convert a stack from the original format, in which each file is a doubly linked list of blocks
+ * and the free blocks form a single ordered list from the first block, to the extent format.
  *
- * @param: block Block to write
- * @param: min_index Lower bound on index
+ * The id of every file is unchanged. Each run of consecutive blocks in the list of a file becomes
+ * one of its extents, so a fragmented file may have more than MAX_EXTENTS extents until it next
+ * grows. Each run of consecutive free blocks becomes a free run. The links of every block are read
+ * before anything is written, and the free space map, which carries the format tag, is written
+ * last.
  *
- * @return: Location on the stack of the free block
+ * @param: old_free_block The first block of the stack, in the original format
  */
 template <typename S>
-uint64_t FileObject<S>::GetFreeBlocks(uint64_t min_index, uint64_t num)
+void FileObject<S>::ConvertLinkedListFormat(BlockType const &old_free_block)
 {
-  if (num == 0)
+  uint64_t const num_blocks = stack_.size();
+
+  std::vector<uint64_t>  next(num_blocks, BlockType::UNDEFINED);
+  std::vector<BlockType> blocks{};
+
+  for (uint64_t index = 0; index < num_blocks; index += MAX_BULK_BLOCKS)
   {
-    throw StorageException("Attempt to get 0 free blocks is invalid");
+    blocks.resize(std::min(uint64_t{MAX_BULK_BLOCKS}, num_blocks - index));
+    GetBulk(index, blocks.size(), blocks.data());
+
+    for (std::size_t i = 0; i < blocks.size(); ++i)
+    {
+      next[index + i] = blocks[i].next;
+    }
   }
 
-  auto DefaultFreeAllocation = [this](uint64_t num) {
-    if (num == 0)
+  // the free list is circular, ending back at the free block
+  std::vector<bool> is_free(num_blocks, false);
+
+  uint64_t index = old_free_block.next;
+  while (index != free_block_index_)
+  {
+    if ((index >= num_blocks) || is_free[index])
     {
-      throw StorageException("Attempt to allocate 0 free blocks is invalid");
+      throw StorageException("Invalid free list in the original file object format");
     }
 
-    BlockType block;
-    uint64_t  first_block_index = stack_.size();
+    is_free[index] = true;
+    index          = next[index];
+  }
 
-    for (uint64_t i = 0; i < num; ++i)
+  // the first block of each file is the one which no other block of a file links to
+  std::vector<bool> is_linked(num_blocks, false);
+  for (uint64_t i = free_block_index_ + 1; i < num_blocks; ++i)
+  {
+    if (is_free[i] || (next[i] == BlockType::UNDEFINED))
     {
-      block.previous = (i == 0) ? BlockType::UNDEFINED : first_block_index + i - 1;
-      block.next     = (i == num - 1) ? BlockType::UNDEFINED : first_block_index + i + 1;
-      stack_.Push(block);
+      continue;
     }
 
-    return first_block_index;
-  };
+    if ((next[i] == free_block_index_) || (next[i] >= num_blocks) || is_free[next[i]])
+    {
+      throw StorageException("Invalid file in the original file object format");
+    }
+
+    is_linked[next[i]] = true;
+  }
+
+  // blocks which are not reached from the first block of any file are released
+  std::vector<bool> is_used(num_blocks, false);
+  std::size_t       num_files{0};
 
-  BlockType free_block;
   BlockType block;
-  Get(free_block_index_, free_block);
+  for (uint64_t id = free_block_index_ + 1; id < num_blocks; ++id)
+  {
+    if (is_free[id] || is_linked[id])
+    {
+      continue;
+    }
+
+    extents_.clear();
+
+    for (index = id; index != BlockType::UNDEFINED; index = next[index])
+    {
+      if (is_used[index])
+      {
+        throw StorageException("Invalid file in the original file object format");
+      }
+
+      is_used[index] = true;
+
+      if (!extents_.empty() && (index == (extents_.back().start + extents_.back().length)))
+      {
+        ++extents_.back().length;
+      }
+      else
+      {
+        extents_.push_back(Extent{index, 1});
+      }
+    }
+
+    Get(id, block);
+
+    id_     = id;
+    length_ = block.file_object_size;
+    StoreExtents();
+
+    ++num_files;
+  }
+
+  BlockType free_block = NewFreeSpaceMap();
 
-  // Only allow free blocks to be taken from the free LL in the scenario that there are enough
-  // blocks in the LL above min_index. This way it is easier to traverse from the end of the stack
-  // backwards, then 'cut' the LL at that point. Check here for easy exit.
-  if (free_block.free_blocks == 0 || free_block.previous < min_index ||
-      free_block.free_blocks < num)
+  uint64_t start = free_block_index_ + 1;
+  while (start < num_blocks)
   {
-    return DefaultFreeAllocation(num);
+    uint64_t end = start;
+    while ((end < num_blocks) && !is_used[end])
+    {
+      ++end;
+    }
+
+    if (end != start)
+    {
+      LinkFreeRun(free_block, start, end - start);
+      free_block.free_blocks += end - start;
+    }
+
+    start = end + 1;
   }
 
-  uint64_t index             = free_block.previous;  // Index of block in LL we wish to free
-  uint64_t free_blocks_in_ll = 0;
+  Set(free_block_index_, free_block);
+  UpdateVariables();
 
-  // Traverse backwards in the stack
-  for (;;)
+  FETCH_LOG_INFO(LOGGING_NAME, "Converted ", num_files,
+                 " files from the original file object format");
+}
+
+/**
+ * Recover the extent table of the current file by following the first block of each extent
+ */
+template <typename S>
+void FileObject<S>::LoadExtents()
+{
+  BlockType block;
+
+  extents_.clear();
+
+  uint64_t index = id_;
+  while (index != BlockType::UNDEFINED)
   {
+    if ((index == free_block_index_) || (index >= stack_.size()) ||
+        (extents_.size() >= stack_.size()))
+    {
+      throw StorageException("Invalid extent table for file object");
+    }
+
     Get(index, block);
-    free_blocks_in_ll++;
 
-    if (index < min_index)
+    if (extents_.empty())
     {
-      break;
+      length_ = block.file_object_size;
     }
 
-    if (index == free_block_index_)
+    extents_.push_back(Extent{index, block.previous});
+    index = block.next;
+  }
+}
+
+/**
+ * Write the extent table (and size) of the current file to the first block of each extent
+ */
+template <typename S>
+void FileObject<S>::StoreExtents()
+{
+  BlockType block;
+
+  for (std::size_t i = 0; i < extents_.size(); ++i)
+  {
+    auto const &extent = extents_[i];
+
+    Get(extent.start, block);
+    block.previous         = extent.length;
+    block.next = ((i + 1) < extents_.size()) ? extents_[i + 1].start : BlockType::UNDEFINED;
+    block.file_object_size = (i == 0) ? length_ : BlockType::UNDEFINED;
+    Set(extent.start, block);
+  }
+}
+
+template <typename S>
+uint64_t FileObject<S>::NumBlocks() const
+{
+  uint64_t num_blocks{0};
+  for (auto const &extent : extents_)
+  {
+    num_blocks += extent.length;
+  }
+
+  return num_blocks;
+}
+
+/**
+ * Determine the location on the stack of a block of the current file
+ *
+ * @param: block_number The Nth block of the file
+ * @param: run_length The number of contiguous blocks of the file from this block onwards
+ * @return: The index of the block on the stack
+ */
+template <typename S>
+uint64_t FileObject<S>::BlockIndex(uint64_t block_number, uint64_t &run_length) const
+{
+  for (auto const &extent : extents_)
+  {
+    if (block_number < extent.length)
     {
-      break;
+      run_length = extent.length - block_number;
+      return extent.start + block_number;
     }
 
-    // This case has found it successfully
-    if (free_blocks_in_ll == num)
+    block_number -= extent.length;
+  }
+
+  throw StorageException("Attempt to access past the end of the file object");
+}
+
+/**
+ * Add blocks to the end of the current file. Unless the file can be extended in place at the end
+ * of the stack, its capacity is at least doubled so that repeated growth is amortised.
+ *
+ * @param: num The minimum number of blocks to add
+ */
+template <typename S>
+void FileObject<S>::Grow(uint64_t num)
+{
+  assert(!extents_.empty());
+
+  // if the file is at the end of the stack it can be extended in place
+  if ((extents_.back().start + extents_.back().length) == stack_.size())
+  {
+    BlockType block;
+    for (uint64_t i = 0; i < num; ++i)
     {
-      // Point end of LL back to free block
-      uint64_t index_prev = block.previous;
-      uint64_t old_ll_end = free_block.previous;
+      stack_.Push(block);
+    }
+
+    extents_.back().length += num;
+    return;
+  }
 
-      // For debugging - terminate this block
+  uint64_t const current_blocks = NumBlocks();
+  uint64_t const target_blocks  = std::max(current_blocks + num, current_blocks * 2);
+
+  Extent extension{};
+
+  if (extents_.size() < MAX_EXTENTS)
+  {
+    extension = Allocate(target_blocks - current_blocks);
+  }
+  else
+  {
+    // relocate the trailing extents into a single run, so the number of extents remains bounded
+    extension = Allocate(target_blocks - extents_.front().length);
+
+    std::vector<BlockType> blocks{};
+    uint64_t               destination = extension.start;
+
+    for (std::size_t i = 1; i < extents_.size(); ++i)
+    {
+      for (uint64_t j = 0; j < extents_[i].length; j += MAX_BULK_BLOCKS)
       {
-        block.previous = BlockType::UNDEFINED;
-        Set(index, block);
+        blocks.resize(std::min(uint64_t{MAX_BULK_BLOCKS}, extents_[i].length - j));
+
+        GetBulk(extents_[i].start + j, blocks.size(), blocks.data());
+        SetBulk(destination, blocks.size(), blocks.data());
+
+        destination += blocks.size();
       }
 
-      Get(index_prev, block);
-      block.next = free_block_index_;
-      Set(index_prev, block);
+      FreeRun(extents_[i].start, extents_[i].length);
+    }
 
-      // Update free block - NEED get here as index_prev might be free block
-      assert(free_block.free_blocks >= num);
-      Get(free_block_index_, free_block);
-      free_block.free_blocks -= num;
-      free_block.previous = index_prev;
-      Set(free_block_index_, free_block);
+    extents_.resize(1);
+  }
 
-      // Last block in the free LL needs to terminate as it's now a file object
-      Get(old_ll_end, block);
-      block.next = BlockType::UNDEFINED;
-      Set(old_ll_end, block);
+  auto &last = extents_.back();
+  if (extension.start == (last.start + last.length))
+  {
+    last.length += extension.length;
+  }
+  else
+  {
+    extents_.push_back(extension);
+  }
+}
+
+/**
+ * Remove blocks from the end of the current file, returning them to the free space map
+ *
+ * @param: num The number of blocks to remove
+ */
+template <typename S>
+void FileObject<S>::Shrink(uint64_t num)
+{
+  while (num != 0)
+  {
+    assert(!extents_.empty());
+    auto &last = extents_.back();
 
-      return index;
+    if ((num >= last.length) && (extents_.size() > 1))
+    {
+      num -= last.length;
+      FreeRun(last.start, last.length);
+      extents_.pop_back();
     }
+    else
+    {
+      assert(num < last.length);
+
+      last.length -= num;
+      FreeRun(last.start + last.length, num);
+      num = 0;
+    }
+  }
+}
+
+/**
+ * Create an empty free space map, tagged with the format of the stack
+ */
+template <typename S>
+typename FileObject<S>::BlockType FileObject<S>::NewFreeSpaceMap()
+{
+  BlockType free_block;
+  free_block.free_blocks = 0;
 
-    index = block.previous;
+  WriteWord(free_block, 0, FORMAT_TAG);
+  for (uint64_t i = 0; i < NUM_SIZE_CLASSES; ++i)
+  {
+    WriteWord(free_block, i + 1, BlockType::UNDEFINED);
+  }
+
+  return free_block;
+}
+
+/**
+ * Determine the size class of a run of blocks, the power of two of its length
+ *
+ * @param: length The length of the run
+ * @return: The size class
+ */
+template <typename S>
+uint64_t FileObject<S>::SizeClass(uint64_t length)
+{
+  uint64_t size_class{0};
+  while (((length >> (size_class + 1)) != 0) && ((size_class + 1) < NUM_SIZE_CLASSES))
+  {
+    ++size_class;
   }
 
-  // Failed to cut the stack.
-  return DefaultFreeAllocation(num);
+  return size_class;
+}
+
+template <typename S>
+uint64_t FileObject<S>::ReadWord(BlockType const &block, uint64_t word)
+{
+  uint64_t value{0};
+  std::memcpy(&value, block.data + (word * sizeof(uint64_t)), sizeof(uint64_t));
+  return value;
+}
+
+template <typename S>
+void FileObject<S>::WriteWord(BlockType &block, uint64_t word, uint64_t value)
+{
+  std::memcpy(block.data + (word * sizeof(uint64_t)), &value, sizeof(uint64_t));
 }
 
 /**
- * Free blocks starting at index. We can't just append to the end of the free LL as we want to
- * maintain ordering.
- * Note that the block at remove_index must point to a valid LL, the last block of which points to
- * 'invalid'
+ * Allocate a contiguous run of blocks, either from the free space map or by extending the stack
  *
+ * @param: num The number of blocks required
+ * @return: The allocated extent
+ */
+template <typename S>
+typename FileObject<S>::Extent FileObject<S>::Allocate(uint64_t num)
+{
+  if (num == 0)
+  {
+    throw StorageException("Attempt to get 0 free blocks is invalid");
+  }
+
+  Extent extent{};
+  if (TakeFreeRun(num, extent))
+  {
+    return extent;
+  }
+
+  BlockType block;
+
+  extent.start  = stack_.size();
+  extent.length = num;
+
+  for (uint64_t i = 0; i < num; ++i)
+  {
+    stack_.Push(block);
+  }
+
+  return extent;
+}
+
+/**
+ * Take the front of the first free run which is large enough from the free space map. Only the
+ * first few runs of each size class are considered, to bound the cost of the search.
  *
- * @param: remove_index Index of starting block to free
+ * @param: num The number of blocks required
+ * @param: extent The allocated extent
+ * @return: true if successful, otherwise false
  */
 template <typename S>
-void FileObject<S>::FreeBlocksInList(uint64_t remove_index)
+bool FileObject<S>::TakeFreeRun(uint64_t num, Extent &extent)
 {
-  // Maintain two 'pointers' to the first free block and the next. Advance these two pointers,
-  // considering remove_index for insertion between them at each step. If we reach the end of
-  // the LL, append all of the remove blocks to the free LL.
-  BlockType remove_block;
   BlockType free_block;
-  BlockType free_block_next;
+  BlockType run;
 
   Get(free_block_index_, free_block);
 
-  uint64_t free_block_index      = free_block_index_;
-  uint64_t free_block_next_index = free_block.next;
-  uint64_t free_blocks_added     = 0;
-
-  bool insert_mode = true;
+  if (free_block.free_blocks < num)
+  {
+    return false;
+  }
 
-  while (remove_index != BlockType::UNDEFINED)
+  for (uint64_t size_class = SizeClass(num); size_class < NUM_SIZE_CLASSES; ++size_class)
   {
-    Get(free_block_index, free_block);
-    Get(free_block_next_index, free_block_next);
-    Get(remove_index, remove_block);
+    uint64_t index = ReadWord(free_block, size_class + 1);
 
-    if (insert_mode)
+    for (uint64_t i = 0; (i < MAX_FIT_SEARCH) && (index != BlockType::UNDEFINED); ++i)
     {
-      // Reached the end of the LL and wrapped around
-      if (free_block_next_index == 0)
-      {
-        insert_mode = false;
-        continue;
-      }
+      Get(index, run);
 
-      // Insert the remove block iff it sits between the pointers
-      if (remove_index > free_block_index && remove_index < free_block_next_index)
+      if (run.previous >= num)
       {
-        uint64_t next_remove_index = remove_block.next;
+        UnlinkFreeRun(free_block, index);
+        free_block.free_blocks -= run.previous;
 
-        // Zero the removed block
-        remove_block = BlockType{};
+        // return the remainder of the run to the map, its neighbours are not free
+        if (run.previous > num)
+        {
+          LinkFreeRun(free_block, index + num, run.previous - num);
+          free_block.free_blocks += run.previous - num;
+        }
 
-        // Adjust remove block references
-        remove_block.previous = free_block_index;
-        remove_block.next     = free_block_next_index;
-        Set(remove_index, remove_block);
+        Set(free_block_index_, free_block);
 
-        // Adjust 'prev' block to this
-        free_block.next = remove_index;
-        Set(free_block_index, free_block);
+        // clear the tag of the allocated run
+        Set(index, BlockType{});
 
-        // Adjust 'next' block to this
-        free_block_next.previous = remove_index;
-        Set(free_block_next_index, free_block_next);
+        extent.start  = index;
+        extent.length = num;
 
-        // Update - removed block is now next
-        free_block_next_index = remove_index;
-        remove_index          = next_remove_index;
-        free_blocks_added++;
-      }
-      else
-      {
-        free_block_index      = free_block_next_index;
-        free_block_next_index = free_block_next.next;
+        return true;
       }
+
+      index = run.next;
     }
-    else
-    {
-      // In this case we are appending to the end of our free blocks LL. free_block should
-      // always be the last block in the LL.
-      free_block.next = remove_index;
-      Set(free_block_index, free_block);
+  }
 
-      // Free LL is circular
-      {
-        Get(free_block_index_, free_block);
-        free_block.previous = remove_index;
-        Set(free_block_index_, free_block);
-      }
+  return false;
+}
 
-      uint64_t next_remove_index = remove_block.next;
+/**
+ * Return a run of blocks to the free space map, coalescing it with any adjacent free runs
+ *
+ * @param: start The first block of the run
+ * @param: length The number of blocks in the run
+ */
+template <typename S>
+void FileObject<S>::FreeRun(uint64_t start, uint64_t length)
+{
+  if (length == 0)
+  {
+    return;
+  }
 
-      remove_block          = BlockType{};
-      remove_block.previous = free_block_index;
-      remove_block.next     = free_block_index_;  // note here member variable
-      Set(remove_index, remove_block);
+  Extent before{};
+  Extent after{};
 
-      free_block_index = remove_index;
-      free_blocks_added++;
-      remove_index = next_remove_index;
-    }
-  }
+  bool const merge_before = FindFreeRunBefore(start, before);
+  bool const merge_after  = FindFreeRunAt(start + length, after);
 
-  // Finally update the free block with the new amount of free blocks added
+  BlockType free_block;
   Get(free_block_index_, free_block);
-  free_block.free_blocks += free_blocks_added;
+
+  free_block.free_blocks += length;
+
+  if (merge_before)
+  {
+    UnlinkFreeRun(free_block, before.start);
+
+    start = before.start;
+    length += before.length;
+  }
+
+  if (merge_after)
+  {
+    UnlinkFreeRun(free_block, after.start);
+
+    // the first block of the following run is now in the middle of the merged run
+    Set(after.start, BlockType{});
+
+    length += after.length;
+  }
+
+  LinkFreeRun(free_block, start, length);
   Set(free_block_index_, free_block);
 }
 
 /**
- * Verify that the file is consistent, given a list of all of the IDs
+ * Find the free run which ends immediately before the specified block, if there is one. The tag
+ * in the last block of a free run is only trusted if the first block of the run agrees with it.
  *
- * @param: remove_index Index of starting block to free
+ * @param: index The block following the run
+ * @param: extent The free run
+ * @return: true if there is a free run, otherwise false
  */
 template <typename S>
-bool FileObject<S>::VerifyConsistency(std::vector<uint64_t> const &ids)
+bool FileObject<S>::FindFreeRunBefore(uint64_t index, Extent &extent)
 {
-  if (stack_.size() == 0)
+  if (index <= (free_block_index_ + 1))
   {
-    if (!ids.empty())
+    return false;
+  }
+
+  BlockType block;
+  Get(index - 1, block);
+
+  if (block.file_object_size == FREE_HEAD_TAG)
+  {
+    // a free run of a single block
+    if (block.previous != 1)
     {
-      FETCH_LOG_ERROR(LOGGING_NAME, "Stack size is 0 but attempting to verify with ids");
       return false;
     }
 
+    extent = Extent{index - 1, 1};
     return true;
   }
 
-  std::vector<uint64_t> fake_stack(stack_.size(), std::numeric_limits<uint64_t>::max());
+  if ((block.file_object_size != FREE_TAIL_TAG) || (block.previous < 2) ||
+      (block.previous >= index))
+  {
+    return false;
+  }
+
+  uint64_t const length = block.previous;
+  if (!FindFreeRunAt(index - length, extent) || (extent.length != length))
+  {
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Find the free run which starts at the specified block, if there is one
+ *
+ * @param: index The block to be checked
+ * @param: extent The free run
+ * @return: true if there is a free run, otherwise false
+ */
+template <typename S>
+bool FileObject<S>::FindFreeRunAt(uint64_t index, Extent &extent)
+{
+  if ((index == free_block_index_) || (index >= stack_.size()))
+  {
+    return false;
+  }
 
   BlockType block;
-  uint64_t  index = free_block_index_;
+  Get(index, block);
 
-  // Verify our linked lists. Tuple = (index, prev, next)
-  std::vector<std::tuple<uint64_t, uint64_t, uint64_t>> linked_list;
+  if (block.file_object_size != FREE_HEAD_TAG)
+  {
+    return false;
+  }
 
-  auto VerifyLL = [](std::vector<std::tuple<uint64_t, uint64_t, uint64_t>> const &ll,
-                     bool circular) -> bool {
-    for (std::size_t i = 0; i < ll.size(); ++i)
-    {
-      uint64_t indx = std::get<0>(ll[i]);
-      uint64_t prev = std::get<1>(ll[i]);
-      uint64_t next = std::get<2>(ll[i]);
+  extent = Extent{index, block.previous};
+  return true;
+}
 
-      uint64_t next_in_ll = std::get<0>(ll[(i + 1) % ll.size()]);
-      uint64_t prev_in_ll = std::get<0>(ll[(i + ll.size() - 1) % ll.size()]);
+/**
+ * Tag a run of blocks as free and add it to the front of the list for its size class. The caller
+ * is responsible for storing the free space map and its count of free blocks.
+ *
+ * @param: free_block The free space map
+ * @param: start The first block of the run
+ * @param: length The number of blocks in the run
+ */
+template <typename S>
+void FileObject<S>::LinkFreeRun(BlockType &free_block, uint64_t start, uint64_t length)
+{
+  uint64_t const size_class = SizeClass(length);
+  uint64_t const next       = ReadWord(free_block, size_class + 1);
 
-      if (indx == BlockType::UNDEFINED)
-      {
-        return false;
-      }
+  BlockType run;
+  run.previous         = length;
+  run.next             = next;
+  run.file_object_size = FREE_HEAD_TAG;
+  WriteWord(run, 0, BlockType::UNDEFINED);
+  Set(start, run);
 
-      // Check LL consistently increments except at the boundaries.
-      if (!(next > indx))
-      {
-        // Corner case at end of list
-        if (!(i == ll.size() - 1))
-        {
-          return false;
-        }
-      }
+  if (length > 1)
+  {
+    BlockType tail;
+    tail.previous         = length;
+    tail.file_object_size = FREE_TAIL_TAG;
+    Set(start + length - 1, tail);
+  }
 
-      if (!(prev < indx))
-      {
-        // Corner case at beginning of list
-        if (!(i == 0))
-        {
-          return false;
-        }
-      }
+  if (next != BlockType::UNDEFINED)
+  {
+    BlockType next_run;
+    Get(next, next_run);
+    WriteWord(next_run, 0, start);
+    Set(next, next_run);
+  }
 
-      if (!circular)
-      {
-        next_in_ll = (i == ll.size() - 1) ? BlockType::UNDEFINED : next_in_ll;
-        prev_in_ll = (i == 0) ? BlockType::UNDEFINED : prev_in_ll;
-      }
+  WriteWord(free_block, size_class + 1, start);
+}
+
+/**
+ * Remove a free run from the list for its size class. The caller is responsible for storing the
+ * free space map and its count of free blocks.
+ *
+ * @param: free_block The free space map
+ * @param: start The first block of the run
+ */
+template <typename S>
+void FileObject<S>::UnlinkFreeRun(BlockType &free_block, uint64_t start)
+{
+  BlockType run;
+  Get(start, run);
+
+  uint64_t const previous = ReadWord(run, 0);
+
+  if (previous == BlockType::UNDEFINED)
+  {
+    WriteWord(free_block, SizeClass(run.previous) + 1, run.next);
+  }
+  else
+  {
+    BlockType previous_run;
+    Get(previous, previous_run);
+    previous_run.next = run.next;
+    Set(previous, previous_run);
+  }
+
+  if (run.next != BlockType::UNDEFINED)
+  {
+    BlockType next_run;
+    Get(run.next, next_run);
+    WriteWord(next_run, 0, previous);
+    Set(run.next, next_run);
+  }
+}
+
+/**
+ * Verify that the file is consistent, given a list of all of the IDs
+ *
+ * @param: ids The ids of all the files in the stack
+ */
+template <typename S>
+bool FileObject<S>::VerifyConsistency(std::vector<uint64_t> const &ids)
+{
+  if (stack_.size() == 0)
+  {
+    if (!ids.empty())
+    {
+      FETCH_LOG_ERROR(LOGGING_NAME, "Stack size is 0 but attempting to verify with ids");
+      return false;
+    }
+
+    return true;
+  }
 
-      if (prev != prev_in_ll || next != next_in_ll)
+  std::vector<uint64_t> fake_stack(stack_.size(), std::numeric_limits<uint64_t>::max());
+
+  // Mark a run of blocks as owned, failing if any of them are already owned
+  auto Claim = [&fake_stack](uint64_t start, uint64_t length, uint64_t owner) -> bool {
+    if ((start == free_block_index_) || (length == 0) || (start >= fake_stack.size()) ||
+        (length > (fake_stack.size() - start)))
+    {
+      return false;
+    }
+
+    for (uint64_t i = start; i < start + length; ++i)
+    {
+      if (fake_stack[i] != std::numeric_limits<uint64_t>::max())
       {
         return false;
       }
+
+      fake_stack[i] = owner;
     }
 
     return true;
   };
 
-  // First traverse the free LL, ensure it is correct etc.
-  Get(index, block);
-  fake_stack[index] = 0;
+  BlockType free_block;
+  BlockType block;
 
-  if (block.free_blocks == 0)
+  Get(free_block_index_, free_block);
+  fake_stack[free_block_index_] = 0;
+
+  if (ReadWord(free_block, 0) != FORMAT_TAG)
   {
-    if (block.next != index || block.previous != index)
-    {
-      FETCH_LOG_ERROR(LOGGING_NAME,
-                      "Free block is malformed - size is 0 but prev and next pointers don't refer "
-                      "back to itself.");
-      return false;
-    }
+    FETCH_LOG_ERROR(LOGGING_NAME, "Free space map is malformed");
+    return false;
   }
-  else
+
+  // First traverse the free runs of each size class
+  uint64_t free_blocks{0};
+  for (uint64_t size_class = 0; size_class < NUM_SIZE_CLASSES; ++size_class)
   {
-    uint64_t free_blocks = block.free_blocks;
+    uint64_t index = ReadWord(free_block, size_class + 1);
 
-    // Plus one for free block
-    for (uint64_t i = 0; i < free_blocks + 1; ++i)
+    while (index != BlockType::UNDEFINED)
     {
-      fake_stack[index] = 0;
-      linked_list.push_back({index, block.previous, block.next});
-      index = block.next;
+      if (index >= stack_.size())
+      {
+        FETCH_LOG_ERROR(LOGGING_NAME, "Free run outside of the stack. Location: ", index);
+        return false;
+      }
+
       Get(index, block);
-    }
 
-    linked_lists.push_back(linked_list);
+      if ((block.file_object_size != FREE_HEAD_TAG) || (SizeClass(block.previous) != size_class) ||
+          !Claim(index, block.previous, 0))
+      {
+        FETCH_LOG_ERROR(LOGGING_NAME, "Failed to verify free run. Location: ", index);
+        return false;
+      }
 
-    if (!VerifyLL(linked_list, true))
-    {
-      FETCH_LOG_ERROR(LOGGING_NAME, "Failed to verify free LL");
-      return false;
+      free_blocks += block.previous;
+      index = block.next;
     }
   }
 
-  for (auto const &id : ids)
+  if (free_blocks != free_block.free_blocks)
   {
-    linked_list.clear();
-    index = id;
+    FETCH_LOG_ERROR(LOGGING_NAME, "Free block count mismatch. Expected: ", free_block.free_blocks,
+                    " Actual: ", free_blocks);
+    return false;
+  }
 
-    Get(index, block);
+  for (auto const &id : ids)
+  {
+    Get(id, block);
 
     uint64_t file_bytes      = block.file_object_size;
     auto     expected_blocks = platform::DivideCeil<uint64_t>(file_bytes, BlockType::CAPACITY);
     expected_blocks          = expected_blocks == 0 ? 1 : expected_blocks;
 
-    for (uint64_t i = 0; i < expected_blocks; ++i)
+    uint64_t num_blocks{0};
+    uint64_t index = id;
+
+    while (index != BlockType::UNDEFINED)
     {
-      fake_stack[index] = id;
-      linked_list.push_back({index, block.previous, block.next});
-      index = block.next;
+      if (index >= stack_.size())
+      {
+        FETCH_LOG_ERROR(LOGGING_NAME, "Extent outside of the stack for ID: ", id);
+        return false;
+      }
+
+      Get(index, block);
 
-      if (i + 1 < expected_blocks)
+      if (!Claim(index, block.previous, id))
       {
-        Get(index, block);
+        FETCH_LOG_ERROR(LOGGING_NAME, "Failed to verify extents for ID: ", id);
+        return false;
       }
+
+      num_blocks += block.previous;
+      index = block.next;
     }
 
-    if (!VerifyLL(linked_list, false))
+    // files keep up to twice the capacity they require, see Grow and Resize
+    if ((num_blocks < expected_blocks) || (num_blocks > (2 * expected_blocks)))
     {
-      FETCH_LOG_ERROR(LOGGING_NAME, "Failed to verify LL for ID: ", id);
+      FETCH_LOG_ERROR(LOGGING_NAME, "Unexpected number of blocks for ID: ", id);
       return false;
     }
   }
@@ -946,6 +1409,17 @@ void FileObject<S>::Get(uint64_t index, BlockType &block)
   stack_.Get(index, block);
 }
 
+template <typename S>
+void FileObject<S>::GetBulk(uint64_t index, uint64_t num, BlockType *blocks)
+{
+  if ((index >= stack_.size()) || (num > (stack_.size() - index)))
+  {
+    throw StorageException("Attempt to GetBulk invalid location");
+  }
+
+  stack_.GetBulk(index, num, blocks);
+}
+
 template <typename S>
 void FileObject<S>::Set(uint64_t index, BlockType const &block)
 {
@@ -957,5 +1431,16 @@ void FileObject<S>::Set(uint64_t index, BlockType const &block)
   stack_.Set(index, block);
 }
 
+template <typename S>
+void FileObject<S>::SetBulk(uint64_t index, uint64_t num, BlockType const *blocks)
+{
+  if ((index >= stack_.size()) || (num > (stack_.size() - index)))
+  {
+    throw StorageException("Attempt to SetBulk invalid location");
+  }
+
+  stack_.SetBulk(index, num, blocks);
+}
+
 }  // namespace storage
 }  // namespace fetch
@@ -22,6 +22,7 @@
 
 #include <cstddef>
 #include <string>
+#include <vector>
 
 namespace fetch {
 namespace storage {
@@ -41,10 +42,11 @@ public:
   bool Load(std::string const &state, std::string const &state_history, std::string const &index,
             std::string const &index_history, bool create);
 
-  UnderlyingType Get(ResourceID const &rid);
-  UnderlyingType GetOrCreate(ResourceID const &rid);
-  void           Set(ResourceID const &rid, ByteArray const &value);
-  void           Erase(ResourceID const &rid);
+  UnderlyingType              Get(ResourceID const &rid);
+  std::vector<UnderlyingType> GetBatch(Keys const &rids);
+  UnderlyingType              GetOrCreate(ResourceID const &rid);
+  void                        Set(ResourceID const &rid, ByteArray const &value);
+  void                        Erase(ResourceID const &rid);
 
   Hash Commit();
   bool RevertToHash(Hash const &state);
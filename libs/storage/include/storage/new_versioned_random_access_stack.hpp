@@ -36,6 +36,7 @@
 //       │      │      │      │      │      │
 //       └──────┴──────┴──────┴──────┴──────┘
 
+#include "core/byte_array/const_byte_array.hpp"
 #include "core/byte_array/encoders.hpp"
 #include "storage/cached_random_access_stack.hpp"
 #include "storage/key.hpp"
@@ -44,6 +45,9 @@
 #include "storage/variant_stack.hpp"
 
 #include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace fetch {
 namespace storage {
@@ -70,6 +74,13 @@ struct NewBookmarkHeader
  * The history is a variant stack so as to allow different operations to be saved. However note that
  * the stack itself has elements of constant width, so no dynamically allocated memory.
  *
+ * Elements are copied on write: between two bookmarks only the first change to an element (or to
+ * the header) records its previous value in the history. Reverting to the preceding bookmark
+ * restores that value directly, so the work done during a revert is bounded by the number of
+ * distinct elements changed rather than the number of operations made. The bookmarks present in
+ * the history are additionally reference counted in memory so that checking for the existence of
+ * a hash does not require a scan of the history.
+ *
  */
 template <typename T, typename S = RandomAccessStack<T, NewBookmarkHeader>>
 class NewVersionedRandomAccessStack
@@ -319,6 +330,9 @@ public:
 
     hash_history_.Load("hash_history_" + history, create_if_not_exist);
     internal_bookmark_index_ = stack_.header_extra().bookmark;
+
+    ResetWriteTracking();
+    IndexBookmarks();
   }
 
   void New(std::string const &filename, std::string const &history)
@@ -327,6 +341,9 @@ public:
     history_.New(history);
     hash_history_.New("hash_history_" + history);
     internal_bookmark_index_ = stack_.header_extra().bookmark;
+
+    ResetWriteTracking();
+    bookmarks_.clear();
   }
 
   void Clear()
@@ -336,6 +353,9 @@ public:
     hash_history_.Clear();
 
     internal_bookmark_index_ = stack_.header_extra().bookmark;
+
+    ResetWriteTracking();
+    bookmarks_.clear();
   }
 
   type Get(std::size_t i) const
@@ -350,15 +370,68 @@ public:
     stack_.Get(i, object);
   }
 
+  void GetBatch(std::vector<std::size_t> const &indices, type *objects) const
+  {
+    stack_.GetBatch(indices, objects);
+  }
+
   void Set(std::size_t i, type const &object)
   {
+    // the original value of the element has already been recorded since the last bookmark
+    if (written_.find(i) != written_.end())
+    {
+      stack_.Set(i, object);
+      return;
+    }
+
     type old_data;
     stack_.Get(i, old_data);
     if (0 != memcmp(&object, &old_data, sizeof(type)))
     {
       history_.Push(HistorySet{i, old_data}, HistorySet::value);
       stack_.Set(i, object);
+      written_.insert(i);
+    }
+  }
+
+  /**
+   * Read a contiguous run of objects from the stack
+   *
+   * @param: i Location of the first object to be read
+   * @param: elements Number of elements to read
+   * @param: objects Pointer to array of elements
+   */
+  void GetBulk(std::size_t i, std::size_t elements, type *objects)
+  {
+    stack_.GetBulk(i, elements, objects);
+  }
+
+  /**
+   * Overwrite a contiguous run of existing objects on the stack. The history is recorded exactly
+   * as it would be for a series of Sets, but the run is read and written in bulk.
+   *
+   * @param: i Location of the first object to be written
+   * @param: elements Number of elements to write, which must already exist on the stack
+   * @param: objects Pointer to array of elements
+   */
+  void SetBulk(std::size_t i, std::size_t elements, type const *objects)
+  {
+    assert((i + elements) <= stack_.size());
+
+    std::vector<type> old_data(elements);
+    stack_.GetBulk(i, elements, old_data.data());
+
+    for (std::size_t j = 0; j < elements; ++j)
+    {
+      if ((written_.find(i + j) == written_.end()) &&
+          (0 != memcmp(&objects[j], &old_data[j], sizeof(type))))
+      {
+        history_.Push(HistorySet{i + j, old_data[j]}, HistorySet::value);
+        written_.insert(i + j);
+      }
     }
+
+    stack_.SetBulk(i, elements, objects);
   }
 
   uint64_t Push(type const &object)
@@ -371,6 +444,7 @@ public:
   {
     type old_data = stack_.Top();
     history_.Push(HistoryPop{old_data}, HistoryPop::value);
+    written_.erase(stack_.size() - 1);
     stack_.Pop();
   }
 
@@ -381,14 +455,22 @@ public:
 
   void Swap(std::size_t i, std::size_t j)
   {
+    // the recorded values no longer relate to the element positions
     history_.Push(HistorySwap{i, j}, HistorySwap::value);
+    written_.erase(i);
+    written_.erase(j);
     stack_.Swap(i, j);
   }
 
   void SetExtraHeader(HeaderExtraType const &b)
   {
     HeaderType h = stack_.header_extra();
-    history_.Push(HistoryHeader{h.header}, HistoryHeader::value);
+
+    if (!header_written_)
+    {
+      history_.Push(HistoryHeader{h.header}, HistoryHeader::value);
+      header_written_ = true;
+    }
 
     h.header = b;
     stack_.SetExtraHeader(h);
@@ -411,6 +493,8 @@ public:
 
     history_.Push(history_bookmark, HistoryBookmark::value);
     hash_history_.Push(history_bookmark);
+    ++bookmarks_[key.ToByteArray()];
+    ResetWriteTracking();
 
     // Update our header with this information (the bookmark index)
     HeaderType h = stack_.header_extra();
@@ -433,21 +517,7 @@ public:
       return false;
     }
 
-    uint64_t        hash_history_size = hash_history_.size();
-    HistoryBookmark book;
-
-    for (std::size_t i = 0; i < hash_history_size; ++i)
-    {
-      uint64_t reverse_index = hash_history_size - i - 1;
-      hash_history_.Get(reverse_index, book);
-
-      if (book.key == key)
-      {
-        return true;
-      }
-    }
-
-    return false;
+    return bookmarks_.find(key.ToByteArray()) != bookmarks_.end();
   }
 
   /**
@@ -497,6 +567,8 @@ public:
         throw StorageException("Undefined type found when reverting in versioned history");
       }
     }
+
+    ResetWriteTracking();
   }
 
   void Flush(bool lazy = true)
@@ -523,15 +595,39 @@ public:
   }
 
 private:
+  using BookmarkCounts = std::unordered_map<byte_array::ConstByteArray, uint64_t>;
+  using ElementIndices = std::unordered_set<uint64_t>;
+
   VariantStack                       history_;
   RandomAccessStack<HistoryBookmark> hash_history_;
   uint64_t                           internal_bookmark_index_{0};
+  BookmarkCounts                     bookmarks_{};  ///< The keys present in the hash history
+  ElementIndices                     written_{};    ///< The elements recorded since the bookmark
+  bool                               header_written_{false};
 
   EventHandlerType on_file_loaded_;
   EventHandlerType on_before_flush_;
 
   StackType stack_;
 
+  void ResetWriteTracking()
+  {
+    written_.clear();
+    header_written_ = false;
+  }
+
+  void IndexBookmarks()
+  {
+    bookmarks_.clear();
+
+    HistoryBookmark book;
+    for (uint64_t i = 0, end = hash_history_.size(); i < end; ++i)
+    {
+      hash_history_.Get(i, book);
+      ++bookmarks_[book.key.ToByteArray()];
+    }
+  }
+
   bool RevertBookmark(DefaultKey const &key_to_compare)
   {
     // Get bookmark from history
@@ -558,6 +654,13 @@ private:
       }
 
       hash_history_.Pop();
+
+      // release the reference to the removed bookmark
+      auto it = bookmarks_.find(book.key.ToByteArray());
+      if ((it != bookmarks_.end()) && (--it->second == 0))
+      {
+        bookmarks_.erase(it);
+      }
     }
 
     return key_to_compare == book.key;
@@ -25,6 +25,7 @@
 //  └──────┴───────────┴───────────┴───────────┴───────────┘
 
 #include "core/assert.hpp"
+#include "storage/async_io.hpp"
 #include "storage/storage_exception.hpp"
 
 #include <algorithm>
@@ -32,6 +33,7 @@
 #include <fstream>
 #include <functional>
 #include <string>
+#include <vector>
 
 namespace fetch {
 namespace platform {
@@ -164,10 +166,12 @@ public:
       Flush();
     }
     file_handle_.close();
+    async_file_.Close();
   }
 
   void Load(std::string const &filename, bool const &create_if_not_exist = false)
   {
+    async_file_.Close();
 
     filename_    = filename;
     file_handle_ = std::fstream(filename_, std::ios::in | std::ios::out | std::ios::binary);
@@ -208,6 +212,8 @@ public:
 
   void New(std::string const &filename)
   {
+    async_file_.Close();
+
     filename_ = filename;
     Clear();
     file_handle_ = std::fstream(filename_, std::ios::in | std::ios::out | std::ios::binary);
@@ -329,6 +335,47 @@ public:
                       std::streamsize(sizeof(type)) * std::streamsize(elements));
   }
 
+  /**
+   * Get a set of (not necessarily contiguous) objects from the stack, with all of the reads in
+   * flight on the device at the same time. Not safe when any index >= objects.
+   *
+   * @param: indices The locations of the objects to be read
+   * @param: objects Pointer to array of elements, one for each index
+   */
+  void GetBatch(std::vector<std::size_t> const &indices, type *objects) const
+  {
+    assert(!filename_.empty());
+
+    if (indices.empty())
+    {
+      return;
+    }
+
+    // Ensure any buffered writes are visible to the reads
+    file_handle_.flush();
+
+    if (!async_file_.is_open())
+    {
+      async_file_.Open(filename_);
+    }
+
+    AsyncIo::Batch batch;
+    for (std::size_t j = 0; j < indices.size(); ++j)
+    {
+      assert(indices[j] < size());
+
+      batch.AddRead(async_file_.fd(), (indices[j] * sizeof(type)) + header_.size(), &objects[j],
+                    sizeof(type));
+    }
+
+    AsyncIo::Instance().Execute(batch);
+
+    if (!batch.Succeeded())
+    {
+      throw StorageException("Failed to read batch of objects from the stack");
+    }
+  }
+
   void SetExtraHeader(HeaderExtraType const &he)
   {
     assert(!filename_.empty());
@@ -489,11 +536,12 @@ public:
   }
 
 private:
-  EventHandlerType     on_file_loaded_;
-  EventHandlerType     on_before_flush_;
-  mutable std::fstream file_handle_;
-  std::string          filename_ = "";
-  Header               header_;
+  EventHandlerType      on_file_loaded_;
+  EventHandlerType      on_before_flush_;
+  mutable std::fstream  file_handle_;
+  mutable AsyncIo::File async_file_;  ///< Raw file handle for batched reads, opened on demand
+  std::string           filename_ = "";
+  Header                header_;
 
   /**
    * Write the header to disk. Not usually necessary since we can just refer to our local one
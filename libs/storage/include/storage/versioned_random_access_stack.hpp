@@ -42,6 +42,7 @@
 #include "storage/variant_stack.hpp"
 
 #include <cstring>
+#include <vector>
 
 namespace fetch {
 namespace storage {
@@ -340,6 +341,11 @@ public:
     stack_.Get(i, object);
   }
 
+  void GetBatch(std::vector<std::size_t> const &indices, type *objects) const
+  {
+    stack_.GetBatch(indices, objects);
+  }
+
   void Set(std::size_t i, type const &object)
   {
     type old_data;
@@ -348,6 +354,41 @@ public:
     stack_.Set(i, object);
   }
 
+  /**
+   * Read a contiguous run of objects from the stack
+   *
+   * @param: i Location of the first object to be read
+   * @param: elements Number of elements to read
+   * @param: objects Pointer to array of elements
+   */
+  void GetBulk(std::size_t i, std::size_t elements, type *objects)
+  {
+    stack_.GetBulk(i, elements, objects);
+  }
+
+  /**
+   * Overwrite a contiguous run of existing objects on the stack. The previous values are recorded
+   * in the history one element at a time, so the run is reverted exactly as a series of Sets.
+   *
+   * @param: i Location of the first object to be written
+   * @param: elements Number of elements to write, which must already exist on the stack
+   * @param: objects Pointer to array of elements
+   */
+  void SetBulk(std::size_t i, std::size_t elements, type const *objects)
+  {
+    assert((i + elements) <= stack_.size());
+
+    std::vector<type> old_data(elements);
+    stack_.GetBulk(i, elements, old_data.data());
+
+    for (std::size_t j = 0; j < elements; ++j)
+    {
+      history_.Push(HistorySet{i + j, old_data[j]}, HistorySet::value);
+    }
+
+    stack_.SetBulk(i, elements, objects);
+  }
+
   uint64_t Push(type const &object)
   {
     history_.Push(HistoryPush{}, HistoryPush::value);
@@ -0,0 +1,918 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/macros.hpp"
+#include "core/set_thread_name.hpp"
+#include "logging/logging.hpp"
+#include "storage/async_io.hpp"
+#include "storage/storage_exception.hpp"
+#include "telemetry/counter.hpp"
+#include "telemetry/registry.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define FETCH_STORAGE_IO_URING
+#endif
+#endif
+#endif
+
+namespace fetch {
+namespace storage {
+namespace {
+
+using telemetry::Registry;
+
+using Labels = telemetry::Measurement::Labels;
+
+constexpr char const *LOGGING_NAME = "AsyncIo";
+
+/**
+ * Perform the remainder of a request with a single blocking system call
+ *
+ * @param request The request to perform
+ * @return The number of bytes transferred, or a negative errno on failure
+ */
+int64_t Transfer(AsyncIo::Request const &request)
+{
+  auto const offset = static_cast<off_t>(request.offset + request.transferred);
+  auto const length = request.length - request.transferred;
+
+  for (;;)
+  {
+    ssize_t result{0};
+
+    if (request.operation == AsyncIo::Operation::READ)
+    {
+      result = ::pread(request.fd, request.buffer + request.transferred, length, offset);
+    }
+    else
+    {
+      result = ::pwrite(request.fd, request.buffer + request.transferred, length, offset);
+    }
+
+    if (result >= 0)
+    {
+      return static_cast<int64_t>(result);
+    }
+
+    if (errno != EINTR)
+    {
+      return -static_cast<int64_t>(errno);
+    }
+  }
+}
+
+}  // namespace
+
+constexpr std::size_t AsyncIo::DEFAULT_QUEUE_DEPTH;
+constexpr std::size_t AsyncIo::DEFAULT_NUM_THREADS;
+
+/**
+ * The interface to the backend which performs the requests
+ */
+class AsyncIo::Engine
+{
+public:
+  explicit Engine(AsyncIo &io)
+    : io_{io}
+  {}
+  virtual ~Engine() = default;
+
+  virtual Backend     type() const        = 0;
+  virtual std::size_t queue_depth() const = 0;
+
+  /**
+   * Hand pending requests to the backend. Called with the engine lock held.
+   */
+  virtual void Dispatch() = 0;
+
+protected:
+  AsyncIo &io_;
+};
+
+/**
+ * The fallback backend, a pool of threads performing blocking system calls
+ */
+class AsyncIo::ThreadPoolEngine : public AsyncIo::Engine
+{
+public:
+  ThreadPoolEngine(AsyncIo &io, std::size_t num_threads)
+    : Engine{io}
+  {
+    num_threads = std::max<std::size_t>(num_threads, 1);
+
+    for (std::size_t i = 0; i < num_threads; ++i)
+    {
+      threads_.emplace_back(
+          std::make_unique<std::thread>(&ThreadPoolEngine::ThreadEntryPoint, this));
+    }
+  }
+
+  ~ThreadPoolEngine() override
+  {
+    {
+      FETCH_LOCK(io_.lock_);
+      running_ = false;
+      work_available_.notify_all();
+    }
+
+    for (auto &thread : threads_)
+    {
+      thread->join();
+    }
+  }
+
+  Backend type() const override
+  {
+    return Backend::THREAD_POOL;
+  }
+
+  std::size_t queue_depth() const override
+  {
+    return threads_.size();
+  }
+
+  void Dispatch() override
+  {
+    work_available_.notify_all();
+  }
+
+private:
+  using ThreadPtr = std::unique_ptr<std::thread>;
+  using Threads   = std::vector<ThreadPtr>;
+
+  void ThreadEntryPoint()
+  {
+    SetThreadName("AsyncIo");
+
+    std::unique_lock<Mutex> lock{io_.lock_};
+
+    for (;;)
+    {
+      work_available_.wait(lock, [this]() { return !running_ || !io_.pending_.empty(); });
+
+      // complete any outstanding requests before stopping
+      if (io_.pending_.empty())
+      {
+        break;
+      }
+
+      Request *request = io_.pending_.front();
+      io_.pending_.pop_front();
+
+      lock.unlock();
+      io_.Complete(*request, Transfer(*request));
+      lock.lock();
+    }
+  }
+
+  Condition work_available_;
+  bool      running_{true};  ///< Guarded by the engine lock
+  Threads   threads_{};
+};
+
+#ifdef FETCH_STORAGE_IO_URING
+
+/**
+ * The io_uring backend. Requests are placed directly in the submission ring, and a reaper thread
+ * waits on the completion ring.
+ */
+class AsyncIo::UringEngine : public AsyncIo::Engine
+{
+public:
+  UringEngine(AsyncIo &io, std::size_t queue_depth)
+    : Engine{io}
+  {
+    io_uring_params params{};
+
+    ring_fd_ = static_cast<int>(
+        ::syscall(__NR_io_uring_setup, static_cast<unsigned>(queue_depth), &params));
+    if (ring_fd_ < 0)
+    {
+      throw std::runtime_error(std::string{"io_uring_setup failed: "} + std::strerror(errno));
+    }
+
+    entries_ = params.sq_entries;
+
+#ifdef IORING_FEAT_EXT_ARG
+    can_time_out_ = (params.features & IORING_FEAT_EXT_ARG) != 0;
+#endif
+
+    sq_ring_size_ = params.sq_off.array + (params.sq_entries * sizeof(uint32_t));
+    cq_ring_size_ = params.cq_off.cqes + (params.cq_entries * sizeof(io_uring_cqe));
+    sqes_size_    = params.sq_entries * sizeof(io_uring_sqe);
+
+    bool const single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap)
+    {
+      sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+    }
+
+    sq_ring_ = Map(sq_ring_size_, IORING_OFF_SQ_RING);
+    cq_ring_ = single_mmap ? sq_ring_ : Map(cq_ring_size_, IORING_OFF_CQ_RING);
+    sqes_    = static_cast<io_uring_sqe *>(Map(sqes_size_, IORING_OFF_SQES));
+
+    if ((sq_ring_ == nullptr) || (cq_ring_ == nullptr) || (sqes_ == nullptr))
+    {
+      Release();
+      throw std::runtime_error("Unable to map the io_uring rings");
+    }
+
+    auto *sq = static_cast<uint8_t *>(sq_ring_);
+    auto *cq = static_cast<uint8_t *>(cq_ring_);
+
+    sq_head_  = reinterpret_cast<uint32_t *>(sq + params.sq_off.head);
+    sq_tail_  = reinterpret_cast<uint32_t *>(sq + params.sq_off.tail);
+    sq_mask_  = *reinterpret_cast<uint32_t *>(sq + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<uint32_t *>(sq + params.sq_off.array);
+    cq_head_  = reinterpret_cast<uint32_t *>(cq + params.cq_off.head);
+    cq_tail_  = reinterpret_cast<uint32_t *>(cq + params.cq_off.tail);
+    cq_mask_  = *reinterpret_cast<uint32_t *>(cq + params.cq_off.ring_mask);
+    cqes_     = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+
+    reaper_thread_ = std::make_unique<std::thread>(&UringEngine::ThreadEntryPoint, this);
+  }
+
+  ~UringEngine() override
+  {
+    {
+      FETCH_LOCK(io_.lock_);
+      running_ = false;
+
+      // wake the reaper thread with a no-op (which has no associated request). If the ring is full
+      // the reaper thread will instead be woken by an existing completion
+      PushEntry(IORING_OP_NOP, nullptr);
+
+      int const error = Enter(Unsubmitted(), 0, 0);
+      if (error != 0)
+      {
+        Fail(error);
+      }
+    }
+
+    reaper_thread_->join();
+    Release();
+  }
+
+  Backend type() const override
+  {
+    return Backend::IO_URING;
+  }
+
+  std::size_t queue_depth() const override
+  {
+    return entries_;
+  }
+
+  void Dispatch() override
+  {
+    if (error_ != 0)
+    {
+      FailPending();
+      return;
+    }
+
+    // The number of requests in flight is bounded by the submission ring size, which guarantees the
+    // (larger) completion ring can never overflow
+    bool pushed{false};
+    while (!io_.pending_.empty() && (in_flight_ < entries_))
+    {
+      Request *request = io_.pending_.front();
+
+      request->vector.iov_base = request->buffer + request->transferred;
+      request->vector.iov_len  = request->length - request->transferred;
+
+      auto const opcode =
+          (request->operation == Operation::READ) ? IORING_OP_READV : IORING_OP_WRITEV;
+
+      if (!PushEntry(opcode, request))
+      {
+        break;
+      }
+
+      io_.pending_.pop_front();
+      ++in_flight_;
+      pushed = true;
+    }
+
+    if (pushed)
+    {
+      int const error = Enter(Unsubmitted(), 0, 0);
+      if (error != 0)
+      {
+        Fail(error);
+      }
+    }
+  }
+
+private:
+  using ThreadPtr   = std::unique_ptr<std::thread>;
+  using Completion  = std::pair<Request *, int64_t>;
+  using Completions = std::vector<Completion>;
+
+  static constexpr long long WAIT_TIMEOUT_NS = 100000000;
+
+  void *Map(std::size_t size, off_t offset)
+  {
+    void *address =
+        ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, offset);
+    return (address == MAP_FAILED) ? nullptr : address;
+  }
+
+  void Release()
+  {
+    if (sqes_ != nullptr)
+    {
+      ::munmap(sqes_, sqes_size_);
+    }
+
+    if ((cq_ring_ != nullptr) && (cq_ring_ != sq_ring_))
+    {
+      ::munmap(cq_ring_, cq_ring_size_);
+    }
+
+    if (sq_ring_ != nullptr)
+    {
+      ::munmap(sq_ring_, sq_ring_size_);
+    }
+
+    ::close(ring_fd_);
+  }
+
+  /**
+   * Place an entry in the submission ring. Called with the engine lock held.
+   *
+   * @param opcode The io_uring operation
+   * @param request The associated request, if any
+   * @return false if the submission ring is full, otherwise true
+   */
+  bool PushEntry(uint8_t opcode, Request *request)
+  {
+    uint32_t const head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    uint32_t const tail = *sq_tail_;
+
+    if ((tail - head) >= entries_)
+    {
+      return false;
+    }
+
+    uint32_t const index = tail & sq_mask_;
+    io_uring_sqe & entry = sqes_[index];
+
+    std::memset(&entry, 0, sizeof(entry));
+    entry.opcode    = opcode;
+    entry.fd        = -1;
+    entry.user_data = reinterpret_cast<uintptr_t>(request);
+
+    if (request != nullptr)
+    {
+      entry.fd   = request->fd;
+      entry.off  = request->offset + request->transferred;
+      entry.addr = reinterpret_cast<uintptr_t>(&request->vector);
+      entry.len  = 1;
+    }
+
+    sq_array_[index] = index;
+    __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+
+    return true;
+  }
+
+  uint32_t Unsubmitted() const
+  {
+    return *sq_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+  }
+
+  /**
+   * Submit entries to and/or wait for completions from the kernel
+   *
+   * @return 0 if successful (or the wait timed out), otherwise the errno of the failed system call
+   */
+  int Enter(uint32_t to_submit, uint32_t min_complete, uint32_t flags, void const *arg = nullptr,
+            std::size_t arg_size = 0)
+  {
+    if ((to_submit == 0) && (min_complete == 0))
+    {
+      return 0;
+    }
+
+    while (::syscall(__NR_io_uring_enter, ring_fd_, to_submit, min_complete, flags, arg,
+                     arg_size) < 0)
+    {
+      if (errno == ETIME)
+      {
+        break;
+      }
+
+      if ((errno != EINTR) && (errno != EAGAIN))
+      {
+        int const error = errno;
+        FETCH_LOG_ERROR(LOGGING_NAME, "io_uring_enter failed: ", std::strerror(error));
+        return error;
+      }
+    }
+
+    return 0;
+  }
+
+  /**
+   * Wait for at least one completion. Where the kernel supports it the wait is bounded, so that the
+   * reaper thread notices that the engine is stopping even if the no-op which should wake it could
+   * not be submitted.
+   *
+   * @return 0 if successful (or the wait timed out), otherwise the errno of the failed system call
+   */
+  int Wait()
+  {
+#ifdef IORING_FEAT_EXT_ARG
+    if (can_time_out_)
+    {
+      __kernel_timespec      timeout{0, WAIT_TIMEOUT_NS};
+      io_uring_getevents_arg arg{};
+      arg.ts = reinterpret_cast<uintptr_t>(&timeout);
+
+      return Enter(0, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+    }
+#endif
+
+    return Enter(0, 1, IORING_ENTER_GETEVENTS);
+  }
+
+  /**
+   * Stop submitting to the ring after a failed system call. The requests the kernel has not taken
+   * from the submission ring, and every later one, fail with the error. Requests already in flight
+   * own their buffers until the kernel completes them, so they are still reaped. Called with the
+   * engine lock held.
+   *
+   * @param error The errno of the failed system call
+   */
+  void Fail(int error)
+  {
+    if (error_ == 0)
+    {
+      error_ = error;
+    }
+
+    uint32_t const head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    for (uint32_t index = head; index != *sq_tail_; ++index)
+    {
+      io_uring_sqe const &entry = sqes_[sq_array_[index & sq_mask_]];
+
+      auto *request = reinterpret_cast<Request *>(static_cast<uintptr_t>(entry.user_data));
+      if (request != nullptr)
+      {
+        io_.Finish(*request, -static_cast<int64_t>(error_));
+        --in_flight_;
+      }
+    }
+    __atomic_store_n(sq_tail_, head, __ATOMIC_RELEASE);
+
+    FailPending();
+  }
+
+  /**
+   * Fail the requests waiting to be handed to the ring. Called with the engine lock held.
+   */
+  void FailPending()
+  {
+    while (!io_.pending_.empty())
+    {
+      io_.Finish(*io_.pending_.front(), -static_cast<int64_t>(error_));
+      io_.pending_.pop_front();
+    }
+  }
+
+  void ThreadEntryPoint()
+  {
+    SetThreadName("AsyncIoReaper");
+
+    Completions completions{};
+    bool        waiting{true};
+
+    for (;;)
+    {
+      if (waiting)
+      {
+        int const error = Wait();
+        if (error != 0)
+        {
+          FETCH_LOCK(io_.lock_);
+          Fail(error);
+          waiting = false;
+        }
+      }
+      else
+      {
+        // the ring can no longer be waited on, so poll it for the requests still in flight
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+      }
+
+      // drain the completion ring
+      uint32_t       head = *cq_head_;
+      uint32_t const tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+
+      for (; head != tail; ++head)
+      {
+        io_uring_cqe const &entry = cqes_[head & cq_mask_];
+
+        auto *request = reinterpret_cast<Request *>(static_cast<uintptr_t>(entry.user_data));
+        if (request != nullptr)
+        {
+          completions.emplace_back(request, static_cast<int64_t>(entry.res));
+        }
+      }
+
+      __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+
+      for (auto const &completion : completions)
+      {
+        io_.Complete(*completion.first, completion.second);
+      }
+
+      FETCH_LOCK(io_.lock_);
+      in_flight_ -= completions.size();
+      completions.clear();
+
+      if (!running_ && (in_flight_ == 0))
+      {
+        break;
+      }
+
+      // make use of the space freed in the ring
+      Dispatch();
+    }
+  }
+
+  int           ring_fd_{-1};
+  bool          can_time_out_{false};
+  uint32_t      entries_{0};
+  std::size_t   sq_ring_size_{0};
+  std::size_t   cq_ring_size_{0};
+  std::size_t   sqes_size_{0};
+  void *        sq_ring_{nullptr};
+  void *        cq_ring_{nullptr};
+  io_uring_sqe *sqes_{nullptr};
+  uint32_t *    sq_head_{nullptr};
+  uint32_t *    sq_tail_{nullptr};
+  uint32_t      sq_mask_{0};
+  uint32_t *    sq_array_{nullptr};
+  uint32_t *    cq_head_{nullptr};
+  uint32_t *    cq_tail_{nullptr};
+  uint32_t      cq_mask_{0};
+  io_uring_cqe *cqes_{nullptr};
+  std::size_t   in_flight_{0};   ///< Guarded by the engine lock
+  bool          running_{true};  ///< Guarded by the engine lock
+  int           error_{0};       ///< The errno which stopped the ring, guarded by the engine lock
+  ThreadPtr     reaper_thread_{};
+};
+
+#endif  // FETCH_STORAGE_IO_URING
+
+/**
+ * Queue a read of a range of a file
+ *
+ * @param fd The file descriptor
+ * @param offset The offset in the file of the first byte to be read
+ * @param buffer The buffer to be filled
+ * @param length The number of bytes to be read
+ */
+void AsyncIo::Batch::AddRead(int fd, uint64_t offset, void *buffer, std::size_t length)
+{
+  Request request{};
+  request.operation = Operation::READ;
+  request.fd        = fd;
+  request.offset    = offset;
+  request.buffer    = static_cast<uint8_t *>(buffer);
+  request.length    = length;
+
+  requests_.push_back(request);
+}
+
+/**
+ * Queue a write of a range of a file
+ *
+ * @param fd The file descriptor
+ * @param offset The offset in the file of the first byte to be written
+ * @param buffer The bytes to be written
+ * @param length The number of bytes to be written
+ */
+void AsyncIo::Batch::AddWrite(int fd, uint64_t offset, void const *buffer, std::size_t length)
+{
+  Request request{};
+  request.operation = Operation::WRITE;
+  request.fd        = fd;
+  request.offset    = offset;
+  request.buffer    = static_cast<uint8_t *>(const_cast<void *>(buffer));
+  request.length    = length;
+
+  requests_.push_back(request);
+}
+
+void AsyncIo::Batch::Clear()
+{
+  assert(outstanding_ == 0);
+  requests_.clear();
+}
+
+std::size_t AsyncIo::Batch::size() const
+{
+  return requests_.size();
+}
+
+bool AsyncIo::Batch::empty() const
+{
+  return requests_.empty();
+}
+
+/**
+ * Determine if every request in a completed batch transferred all of its bytes
+ *
+ * @return true if successful, otherwise false
+ */
+bool AsyncIo::Batch::Succeeded() const
+{
+  return std::all_of(requests_.begin(), requests_.end(), [](Request const &request) {
+    return request.result == static_cast<int64_t>(request.length);
+  });
+}
+
+AsyncIo::Request const &AsyncIo::Batch::operator[](std::size_t index) const
+{
+  return requests_[index];
+}
+
+AsyncIo::File::File(File &&other) noexcept
+  : fd_{other.fd_}
+{
+  other.fd_ = -1;
+}
+
+AsyncIo::File::~File()
+{
+  Close();
+}
+
+/**
+ * Open a file for use in requests
+ *
+ * @param filename The path of the file
+ * @param writable Whether the file will be written to
+ */
+void AsyncIo::File::Open(std::string const &filename, bool writable)
+{
+  Close();
+
+  fd_ = ::open(filename.c_str(), (writable ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+  if (fd_ < 0)
+  {
+    throw StorageException("Unable to open file for asynchronous I/O: " + filename);
+  }
+}
+
+void AsyncIo::File::Close()
+{
+  if (fd_ >= 0)
+  {
+    ::close(fd_);
+    fd_ = -1;
+  }
+}
+
+bool AsyncIo::File::is_open() const
+{
+  return fd_ >= 0;
+}
+
+int AsyncIo::File::fd() const
+{
+  return fd_;
+}
+
+AsyncIo::File &AsyncIo::File::operator=(File &&other) noexcept
+{
+  if (this != &other)
+  {
+    Close();
+    std::swap(fd_, other.fd_);
+  }
+
+  return *this;
+}
+
+/**
+ * Get the process wide asynchronous I/O engine
+ *
+ * @return The reference to the engine
+ */
+AsyncIo &AsyncIo::Instance()
+{
+  static AsyncIo instance{"global"};
+  return instance;
+}
+
+/**
+ * Construct an asynchronous I/O engine
+ *
+ * @param name The name of the engine, used to label its telemetry
+ * @param preferred The preferred backend, io_uring falls back to the thread pool if it is
+ * unavailable
+ * @param queue_depth The maximum number of requests in flight for the io_uring backend
+ * @param num_threads The number of threads for the thread pool backend
+ */
+AsyncIo::AsyncIo(std::string const &name, Backend preferred, std::size_t queue_depth,
+                 std::size_t num_threads)
+  : batch_count_{Registry::Instance().CreateCounter("storage_async_io_batches_total",
+                                                    "The total number of submitted I/O batches",
+                                                    Labels{{"engine", name}})}
+  , request_count_{Registry::Instance().CreateCounter("storage_async_io_requests_total",
+                                                      "The total number of submitted I/O requests",
+                                                      Labels{{"engine", name}})}
+  , error_count_{Registry::Instance().CreateCounter("storage_async_io_errors_total",
+                                                    "The total number of failed I/O requests",
+                                                    Labels{{"engine", name}})}
+{
+#ifdef FETCH_STORAGE_IO_URING
+  if (preferred == Backend::IO_URING)
+  {
+    try
+    {
+      engine_ = std::make_unique<UringEngine>(*this, queue_depth);
+    }
+    catch (std::exception const &ex)
+    {
+      FETCH_LOG_WARN(LOGGING_NAME, "Falling back to the thread pool backend. ", ex.what());
+    }
+  }
+#else
+  FETCH_UNUSED(preferred);
+  FETCH_UNUSED(queue_depth);
+#endif
+
+  if (!engine_)
+  {
+    engine_ = std::make_unique<ThreadPoolEngine>(*this, num_threads);
+  }
+}
+
+AsyncIo::~AsyncIo()
+{
+  // stop the backend while the state it refers to is still valid
+  engine_.reset();
+}
+
+/**
+ * Submit a batch of requests without waiting for them to complete
+ *
+ * @param batch The batch to be submitted
+ */
+void AsyncIo::Submit(Batch &batch)
+{
+  FETCH_LOCK(lock_);
+
+  if (batch.outstanding_ != 0)
+  {
+    throw StorageException("Attempt to submit an I/O batch which is already in flight");
+  }
+
+  batch_count_->increment();
+
+  for (auto &request : batch.requests_)
+  {
+    request.batch       = &batch;
+    request.result      = 0;
+    request.transferred = 0;
+
+    if (request.length != 0)
+    {
+      ++batch.outstanding_;
+      pending_.push_back(&request);
+      request_count_->increment();
+    }
+  }
+
+  engine_->Dispatch();
+}
+
+/**
+ * Wait for all the requests of a submitted batch to complete
+ *
+ * @param batch The batch to wait for
+ */
+void AsyncIo::Wait(Batch &batch)
+{
+  std::unique_lock<Mutex> lock{lock_};
+  batch_complete_.wait(lock, [&batch]() { return batch.outstanding_ == 0; });
+}
+
+/**
+ * Submit a batch of requests and wait for them to complete
+ *
+ * @param batch The batch to be executed
+ */
+void AsyncIo::Execute(Batch &batch)
+{
+  Submit(batch);
+  Wait(batch);
+}
+
+AsyncIo::Backend AsyncIo::backend() const
+{
+  return engine_->type();
+}
+
+std::size_t AsyncIo::queue_depth() const
+{
+  return engine_->queue_depth();
+}
+
+/**
+ * Record the outcome of a transfer performed by the backend. Short transfers are requeued for the
+ * remaining bytes.
+ *
+ * @param request The request which was performed
+ * @param result The number of bytes transferred, or a negative errno on failure
+ */
+void AsyncIo::Complete(Request &request, int64_t result)
+{
+  FETCH_LOCK(lock_);
+
+  if (result > 0)
+  {
+    request.transferred += static_cast<std::size_t>(result);
+
+    if (request.transferred < request.length)
+    {
+      pending_.push_back(&request);
+      engine_->Dispatch();
+      return;
+    }
+
+    Finish(request, static_cast<int64_t>(request.transferred));
+  }
+  else if (result == 0)
+  {
+    // end of file
+    Finish(request, static_cast<int64_t>(request.transferred));
+  }
+  else
+  {
+    Finish(request, result);
+  }
+}
+
+/**
+ * Record the final result of a request and wake the waiters once its batch is complete. Called
+ * with the engine lock held.
+ *
+ * @param request The request which has finished
+ * @param result The number of bytes transferred, or a negative errno on failure
+ */
+void AsyncIo::Finish(Request &request, int64_t result)
+{
+  request.result = result;
+  if (result < 0)
+  {
+    error_count_->increment();
+  }
+
+  if (--request.batch->outstanding_ == 0)
+  {
+    batch_complete_.notify_all();
+  }
+}
+
+}  // namespace storage
+}  // namespace fetch
@@ -0,0 +1,460 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/set_thread_name.hpp"
+#include "storage/buffer_pool.hpp"
+#include "telemetry/counter.hpp"
+#include "telemetry/gauge.hpp"
+#include "telemetry/registry.hpp"
+
+#include <iterator>
+#include <mutex>
+#include <utility>
+
+namespace fetch {
+namespace storage {
+namespace {
+
+using telemetry::Registry;
+
+using Labels = telemetry::Measurement::Labels;
+
+}  // namespace
+
+constexpr std::size_t          BufferPool::DEFAULT_MEMORY_LIMIT;
+constexpr BufferPool::Duration BufferPool::WRITE_BACK_INTERVAL;
+
+BufferPool::Page::Page(Client &client, PageId id, std::size_t bytes)
+  : client_{client}
+  , id_{id}
+  , bytes_{bytes}
+{}
+
+BufferPool::Client &BufferPool::Page::client() const
+{
+  return client_;
+}
+
+BufferPool::PageId BufferPool::Page::id() const
+{
+  return id_;
+}
+
+bool BufferPool::Page::dirty() const
+{
+  return dirty_;
+}
+
+/**
+ * Get the process wide buffer pool
+ *
+ * @return The reference to the buffer pool
+ */
+BufferPool &BufferPool::Instance()
+{
+  static BufferPool instance{"global"};
+  return instance;
+}
+
+/**
+ * Construct a buffer pool
+ *
+ * @param name The name of the pool, used to label its telemetry
+ * @param memory_limit The maximum number of bytes of cached pages
+ */
+BufferPool::BufferPool(std::string const &name, std::size_t memory_limit)
+  : memory_limit_{memory_limit}
+  , hit_count_{Registry::Instance().CreateCounter("storage_buffer_pool_hits_total",
+                                                  "The total number of cached page hits",
+                                                  Labels{{"pool", name}})}
+  , miss_count_{Registry::Instance().CreateCounter("storage_buffer_pool_misses_total",
+                                                   "The total number of cached page misses",
+                                                   Labels{{"pool", name}})}
+  , eviction_count_{Registry::Instance().CreateCounter("storage_buffer_pool_evictions_total",
+                                                       "The total number of evicted pages",
+                                                       Labels{{"pool", name}})}
+  , eviction_failure_count_{Registry::Instance().CreateCounter(
+        "storage_buffer_pool_eviction_failures_total",
+        "The total number of pages which could not be evicted because the client was busy",
+        Labels{{"pool", name}})}
+  , write_back_count_{Registry::Instance().CreateCounter(
+        "storage_buffer_pool_write_backs_total",
+        "The total number of dirty pages written back in the background", Labels{{"pool", name}})}
+  , memory_usage_gauge_{Registry::Instance().CreateGauge<uint64_t>(
+        "storage_buffer_pool_memory_usage", "The number of bytes of cached pages",
+        Labels{{"pool", name}})}
+{
+  write_back_thread_ = std::make_unique<std::thread>(&BufferPool::ThreadEntryPoint, this);
+}
+
+BufferPool::~BufferPool()
+{
+  running_ = false;
+
+  {
+    FETCH_LOCK(lock_);
+    write_back_wake_.notify_all();
+  }
+
+  if (write_back_thread_)
+  {
+    write_back_thread_->join();
+    write_back_thread_.reset();
+  }
+}
+
+/**
+ * Add a newly loaded page to the pool. The caller should make room for the page beforehand by
+ * calling Reclaim.
+ *
+ * @param client The client which owns the page
+ * @param id The client specific id of the page
+ * @param bytes The size of the page in bytes
+ * @return The shared page state
+ */
+BufferPool::PagePtr BufferPool::Admit(Client &client, PageId id, std::size_t bytes)
+{
+  miss_count_->increment();
+
+  auto page = std::make_shared<Page>(client, id, bytes);
+
+  FETCH_LOCK(lock_);
+
+  client_calls_.emplace(&client, 0);
+
+  // new pages are placed just behind the hand, so they are the last to be considered
+  page->frame_   = frames_.insert(hand_, page);
+  page->in_pool_ = true;
+  memory_usage_ += bytes;
+  memory_usage_gauge_->set(memory_usage_);
+
+  return page;
+}
+
+/**
+ * Update the size of a page
+ *
+ * @param page The page to be updated
+ * @param bytes The new size of the page in bytes
+ */
+void BufferPool::Resize(PagePtr const &page, std::size_t bytes)
+{
+  FETCH_LOCK(lock_);
+
+  if (page->in_pool_)
+  {
+    memory_usage_ = (memory_usage_ - page->bytes_) + bytes;
+    memory_usage_gauge_->set(memory_usage_);
+  }
+
+  page->bytes_ = bytes;
+}
+
+/**
+ * Remove a page from the pool, once the client has dropped it from its cache
+ *
+ * @param page The page to be removed
+ */
+void BufferPool::Release(PagePtr const &page)
+{
+  FETCH_LOCK(lock_);
+  RemoveFrame(*page);
+}
+
+/**
+ * Signal that a cached page has been accessed
+ *
+ * @param page The page which has been accessed
+ */
+void BufferPool::Touch(Page &page)
+{
+  page.referenced_.store(true, std::memory_order_relaxed);
+  hit_count_->increment();
+}
+
+/**
+ * Signal that a cached page has been modified and must be written back
+ *
+ * @param page The page which has been modified
+ */
+void BufferPool::MarkDirty(Page &page)
+{
+  page.referenced_.store(true, std::memory_order_relaxed);
+  page.dirty_.store(true, std::memory_order_relaxed);
+}
+
+/**
+ * Signal that a cached page has been written back
+ *
+ * @param page The page which has been written back
+ */
+void BufferPool::MarkClean(Page &page)
+{
+  page.dirty_.store(false, std::memory_order_relaxed);
+}
+
+/**
+ * Remove all the pages of a client from the pool, waiting for any calls which are in flight to the
+ * client to complete. Must be called before the client is destroyed.
+ *
+ * @param client The client to be removed
+ */
+void BufferPool::RemoveClient(Client &client)
+{
+  std::unique_lock<Mutex> lock{lock_};
+
+  for (auto it = frames_.begin(); it != frames_.end();)
+  {
+    auto &page = **it;
+    ++it;
+
+    if (&page.client_ == &client)
+    {
+      RemoveFrame(page);
+    }
+  }
+
+  calls_complete_.wait(lock, [this, &client]() {
+    auto const it = client_calls_.find(&client);
+    return (it == client_calls_.end()) || (it->second == 0);
+  });
+
+  client_calls_.erase(&client);
+}
+
+/**
+ * Evict pages until the pool has room for the specified number of bytes. Clients should call this
+ * before loading a new page, at a point where they do not hold references into any of their own
+ * cached pages.
+ *
+ * @param required The number of bytes which are about to be admitted
+ */
+void BufferPool::Reclaim(std::size_t required)
+{
+  std::size_t steps{0};
+
+  for (;;)
+  {
+    PagePtr victim{};
+
+    {
+      FETCH_LOCK(lock_);
+      victim = SelectVictim(required, steps);
+    }
+
+    if (!victim)
+    {
+      break;
+    }
+
+    bool const evicted = victim->client_.TryEvictPage(victim->id_);
+
+    {
+      FETCH_LOCK(lock_);
+      CompleteCall(*victim);
+
+      // the hand only needs to make another two revolutions if the page was actually removed
+      if (!victim->in_pool_)
+      {
+        steps = 0;
+      }
+    }
+
+    if (evicted)
+    {
+      eviction_count_->increment();
+    }
+    else
+    {
+      eviction_failure_count_->increment();
+    }
+  }
+}
+
+/**
+ * Write back all the dirty pages in the pool
+ */
+void BufferPool::WriteBack()
+{
+  PageArray dirty_pages{};
+
+  {
+    FETCH_LOCK(lock_);
+
+    for (auto const &page : frames_)
+    {
+      if (!page->busy_ && page->dirty_)
+      {
+        page->busy_ = true;
+        ++client_calls_[&page->client_];
+
+        dirty_pages.emplace_back(page);
+      }
+    }
+  }
+
+  for (auto const &page : dirty_pages)
+  {
+    if (page->client_.TryWriteBackPage(page->id_))
+    {
+      write_back_count_->increment();
+    }
+
+    FETCH_LOCK(lock_);
+    CompleteCall(*page);
+  }
+}
+
+/**
+ * Set the maximum number of bytes of cached pages. If the pool is over the new limit then pages
+ * will be evicted as other pages are loaded.
+ *
+ * @param bytes The new memory limit
+ */
+void BufferPool::SetMemoryLimit(std::size_t bytes)
+{
+  FETCH_LOCK(lock_);
+  memory_limit_ = bytes;
+}
+
+std::size_t BufferPool::memory_limit() const
+{
+  FETCH_LOCK(lock_);
+  return memory_limit_;
+}
+
+std::size_t BufferPool::memory_usage() const
+{
+  FETCH_LOCK(lock_);
+  return memory_usage_;
+}
+
+std::size_t BufferPool::num_pages() const
+{
+  FETCH_LOCK(lock_);
+  return frames_.size();
+}
+
+/**
+ * Advance the clock hand to find the next page to be evicted. Must be called with the lock held.
+ *
+ * @param required The number of bytes which are about to be admitted
+ * @param steps The number of steps the hand has taken so far during this reclaim
+ * @return The page to be evicted, or a nullptr if no more pages need to be (or can be) evicted
+ */
+BufferPool::PagePtr BufferPool::SelectVictim(std::size_t required, std::size_t &steps)
+{
+  // give up after two complete revolutions, since all remaining pages must be busy
+  while (((memory_usage_ + required) > memory_limit_) && (steps < (2u * frames_.size())))
+  {
+    ++steps;
+
+    if (hand_ == frames_.end())
+    {
+      hand_ = frames_.begin();
+    }
+
+    PagePtr page = *hand_;
+    ++hand_;
+
+    if (page->busy_)
+    {
+      continue;
+    }
+
+    // the page has been accessed since the hand last passed so give it a second chance
+    if (page->referenced_.exchange(false))
+    {
+      continue;
+    }
+
+    page->busy_ = true;
+    ++client_calls_[&page->client_];
+
+    return page;
+  }
+
+  return {};
+}
+
+/**
+ * Remove a page from the clock. Must be called with the lock held.
+ *
+ * @param page The page to be removed
+ */
+void BufferPool::RemoveFrame(Page &page)
+{
+  if (!page.in_pool_)
+  {
+    return;
+  }
+
+  if (hand_ == page.frame_)
+  {
+    ++hand_;
+  }
+
+  frames_.erase(page.frame_);
+  page.frame_   = frames_.end();
+  page.in_pool_ = false;
+
+  memory_usage_ -= page.bytes_;
+  memory_usage_gauge_->set(memory_usage_);
+}
+
+/**
+ * Mark a call to a client as complete. Must be called with the lock held.
+ *
+ * @param page The page for which the client was called
+ */
+void BufferPool::CompleteCall(Page &page)
+{
+  page.busy_ = false;
+
+  auto it = client_calls_.find(&page.client_);
+  if ((it != client_calls_.end()) && (it->second > 0))
+  {
+    --it->second;
+  }
+
+  calls_complete_.notify_all();
+}
+
+/**
+ * The main loop of the write back thread
+ */
+void BufferPool::ThreadEntryPoint()
+{
+  SetThreadName("BufferPoolWB");
+
+  while (running_)
+  {
+    {
+      std::unique_lock<Mutex> lock{lock_};
+      write_back_wake_.wait_for(lock, WRITE_BACK_INTERVAL, [this]() { return !running_; });
+    }
+
+    if (running_)
+    {
+      WriteBack();
+    }
+  }
+}
+
+}  // namespace storage
+}  // namespace fetch
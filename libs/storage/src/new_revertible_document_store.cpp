@@ -88,6 +88,11 @@ UnderlyingType NewRevertibleDocumentStore::Get(ResourceID const &rid)
   return storage_.Get(rid);
 }
 
+std::vector<UnderlyingType> NewRevertibleDocumentStore::GetBatch(Keys const &rids)
+{
+  return storage_.GetBatch(rids);
+}
+
 UnderlyingType NewRevertibleDocumentStore::GetOrCreate(ResourceID const &rid)
 {
   return storage_.GetOrCreate(rid);
@@ -0,0 +1,133 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "storage/async_io.hpp"
+#include "storage/random_access_stack.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace {
+
+using namespace fetch::storage;
+
+using Backend = AsyncIo::Backend;
+using Stack   = RandomAccessStack<uint64_t>;
+
+class AsyncIoTests : public ::testing::TestWithParam<Backend>
+{
+};
+
+TEST_P(AsyncIoTests, CheckBatchedWritesAndReads)
+{
+  AsyncIo io{"async_io_test", GetParam(), 16, 3};
+
+  AsyncIo::File file;
+  Stack         stack;
+  stack.New("async_io_test.db");
+  stack.Push(0);
+  stack.Flush();
+  file.Open("async_io_test.db", true);
+
+  // more requests than the queue depth, in a scattered order
+  constexpr std::size_t NUM_BLOCKS = 100;
+  constexpr std::size_t BLOCK_SIZE = 4096;
+
+  std::vector<uint8_t> written(NUM_BLOCKS * BLOCK_SIZE);
+  std::iota(written.begin(), written.end(), uint8_t{0});
+
+  AsyncIo::Batch writes;
+  for (std::size_t i = 0; i < NUM_BLOCKS; ++i)
+  {
+    std::size_t const block = (i * 37) % NUM_BLOCKS;
+    writes.AddWrite(file.fd(), block * BLOCK_SIZE, &written[block * BLOCK_SIZE], BLOCK_SIZE);
+  }
+
+  io.Execute(writes);
+  ASSERT_TRUE(writes.Succeeded());
+
+  std::vector<uint8_t> read(written.size());
+
+  AsyncIo::Batch reads;
+  for (std::size_t i = 0; i < NUM_BLOCKS; ++i)
+  {
+    std::size_t const block = (i * 13) % NUM_BLOCKS;
+    reads.AddRead(file.fd(), block * BLOCK_SIZE, &read[block * BLOCK_SIZE], BLOCK_SIZE);
+  }
+
+  // a read past the end of the file is reported as a short read
+  uint8_t past_end{0};
+  reads.AddRead(file.fd(), written.size(), &past_end, 1);
+
+  io.Submit(reads);
+  io.Wait(reads);
+
+  EXPECT_FALSE(reads.Succeeded());
+  EXPECT_EQ(reads[reads.size() - 1].result, 0);
+  EXPECT_EQ(read, written);
+}
+
+TEST_P(AsyncIoTests, CheckFailedRequestsAreReported)
+{
+  AsyncIo io{"async_io_test", GetParam()};
+
+  uint8_t        value{0};
+  AsyncIo::Batch batch;
+  batch.AddRead(-1, 0, &value, 1);
+
+  io.Execute(batch);
+
+  EXPECT_FALSE(batch.Succeeded());
+  EXPECT_LT(batch[0].result, 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, AsyncIoTests,
+                         ::testing::Values(Backend::IO_URING, Backend::THREAD_POOL));
+
+TEST(AsyncIoStackTests, CheckGetBatchMatchesGet)
+{
+  Stack stack;
+  stack.New("async_io_stack_test.db");
+
+  for (uint64_t i = 0; i < 1000; ++i)
+  {
+    stack.Push(i * i);
+  }
+
+  std::vector<std::size_t> indices;
+  for (std::size_t i = 0; i < 1000; i += 7)
+  {
+    indices.push_back(999 - i);
+  }
+
+  std::vector<uint64_t> objects(indices.size());
+  stack.GetBatch(indices, objects.data());
+
+  for (std::size_t i = 0; i < indices.size(); ++i)
+  {
+    uint64_t expected{0};
+    stack.Get(indices[i], expected);
+
+    EXPECT_EQ(objects[i], expected);
+  }
+}
+
+}  // namespace
@@ -0,0 +1,175 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "storage/buffer_pool.hpp"
+#include "storage/cache_line_random_access_stack.hpp"
+#include "storage/cached_random_access_stack.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using namespace fetch::storage;
+
+using Stack       = CacheLineRandomAccessStack<uint64_t>;
+using CachedStack = CachedRandomAccessStack<uint64_t>;
+
+// The size of a single cache line of the stack, which holds 8192 elements
+constexpr std::size_t LINE_ELEMENTS = 8192;
+constexpr std::size_t LINE_SIZE     = LINE_ELEMENTS * sizeof(uint64_t);
+
+TEST(BufferPoolTests, CheckMemoryLimitIsSharedBetweenStacks)
+{
+  BufferPool pool{"shared_limit_test", 4 * LINE_SIZE};
+
+  Stack stack1;
+  Stack stack2;
+  stack1.SetBufferPool(pool);
+  stack2.SetBufferPool(pool);
+  stack1.New("buffer_pool_test_1.db");
+  stack2.New("buffer_pool_test_2.db");
+
+  // each stack on its own would be allowed 10 cache lines
+  uint64_t const num_elements = 5 * LINE_ELEMENTS;
+  for (uint64_t i = 0; i < num_elements; ++i)
+  {
+    stack1.Push(i);
+    stack2.Push(num_elements - i);
+
+    // there is some overhead for each cache line, but never more than one line over the limit
+    ASSERT_LE(pool.memory_usage(), pool.memory_limit() + (2 * LINE_SIZE));
+  }
+
+  // all the evicted lines must have been written back to disk
+  for (uint64_t i = 0; i < num_elements; ++i)
+  {
+    uint64_t value1{0};
+    uint64_t value2{0};
+
+    stack1.Get(i, value1);
+    stack2.Get(i, value2);
+
+    ASSERT_EQ(value1, i);
+    ASSERT_EQ(value2, num_elements - i);
+  }
+}
+
+TEST(BufferPoolTests, CheckDirtyPagesAreWrittenBack)
+{
+  BufferPool pool{"write_back_test"};
+
+  Stack stack;
+  stack.SetBufferPool(pool);
+  stack.New("buffer_pool_test_3.db");
+
+  for (uint64_t i = 0; i < 2 * LINE_ELEMENTS; ++i)
+  {
+    stack.Push(i);
+  }
+
+  EXPECT_EQ(pool.num_pages(), 2u);
+
+  pool.WriteBack();
+
+  // once written back the lines can be evicted without touching the disk
+  pool.SetMemoryLimit(0);
+  pool.Reclaim();
+
+  EXPECT_EQ(pool.num_pages(), 0u);
+  EXPECT_EQ(pool.memory_usage(), 0u);
+
+  for (uint64_t i = 0; i < 2 * LINE_ELEMENTS; ++i)
+  {
+    uint64_t value{0};
+    stack.Get(i, value);
+
+    ASSERT_EQ(value, i);
+  }
+}
+
+TEST(BufferPoolTests, CheckUpdatedElementsAreNotEvictedBeforeFlush)
+{
+  BufferPool pool{"cached_stack_test"};
+
+  CachedStack stack;
+  stack.SetBufferPool(pool);
+  stack.New("buffer_pool_test_4.db");
+
+  for (uint64_t i = 0; i < 1000; ++i)
+  {
+    stack.Push(i);
+  }
+
+  std::size_t const usage = pool.memory_usage();
+  EXPECT_GT(usage, 0u);
+
+  // none of the elements have been flushed so none of them can be evicted
+  pool.SetMemoryLimit(0);
+  pool.Reclaim();
+  EXPECT_EQ(pool.memory_usage(), usage);
+
+  // after the flush the elements can be evicted and are read back from disk
+  stack.Flush();
+  pool.Reclaim();
+  EXPECT_EQ(pool.memory_usage(), 0u);
+
+  for (uint64_t i = 0; i < 1000; ++i)
+  {
+    uint64_t value{0};
+    stack.Get(i, value);
+
+    ASSERT_EQ(value, i);
+  }
+}
+
+TEST(BufferPoolTests, CheckCachedElementsAreChargedIndividually)
+{
+  BufferPool pool{"cached_stack_usage_test"};
+
+  CachedStack stack;
+  stack.SetBufferPool(pool);
+  stack.New("buffer_pool_test_5.db");
+
+  stack.Push(0);
+  std::size_t const element_usage = pool.memory_usage();
+  EXPECT_GT(element_usage, 0u);
+
+  // a partially filled page is only charged for the elements which it holds
+  for (uint64_t i = 1; i < 10; ++i)
+  {
+    stack.Push(i);
+  }
+
+  EXPECT_EQ(pool.num_pages(), 1u);
+  EXPECT_EQ(pool.memory_usage(), 10 * element_usage);
+
+  stack.Pop();
+  EXPECT_EQ(pool.memory_usage(), 9 * element_usage);
+
+  // a page which only holds updated elements can not be evicted
+  EXPECT_FALSE(stack.TryEvictPage(0));
+
+  stack.Flush();
+  EXPECT_TRUE(stack.TryEvictPage(0));
+  EXPECT_EQ(pool.memory_usage(), 0u);
+}
+
+}  // namespace
@@ -58,6 +58,7 @@ public:
   {
     ThrowOnBadAccess(i, "Set");
     (*stack_).elements[i] = object;
+    ++num_writes_;
   }
 
   void SetBulk(std::size_t i, std::size_t elements, STACK_ELEMENTS const *objects)
@@ -65,7 +66,7 @@ public:
     for (std::size_t increment = 0; increment < elements; ++increment)
     {
       ThrowOnBadAccess(i + increment, "SetBulk");
-      Set(i + increment, objects[i]);
+      Set(i + increment, objects[increment]);
     }
   }
 
@@ -81,7 +82,7 @@ public:
     for (std::size_t increment = 0; increment < elements; ++increment)
     {
       ThrowOnBadAccess(i + increment, "GetBulk");
-      Set(i + increment, objects[i]);
+      Get(i + increment, objects[increment]);
     }
   }
 
@@ -137,6 +138,14 @@ public:
     return is_open_;
   }
 
+  /**
+   * The number of elements which have been overwritten (by Set or SetBulk) in this fake
+   */
+  std::size_t num_writes() const
+  {
+    return num_writes_;
+  }
+
   void Swap(std::size_t i, std::size_t j)
   {
     ThrowOnBadAccess(i, "Swap");
@@ -203,7 +212,8 @@ private:
     }
   }
 
-  bool is_open_ = false;
+  bool        is_open_    = false;
+  std::size_t num_writes_ = 0;
 
   template <typename T>
   struct FakeStack
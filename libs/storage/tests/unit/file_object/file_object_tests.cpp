@@ -25,9 +25,12 @@
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <random>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 using namespace fetch;
@@ -258,6 +261,214 @@ TEST_F(FileObjectTests, EraseFiles)
   }
 }
 
+TEST_F(FileObjectTests, ErasedSpaceIsReusedAndGrownFilesStayReadable)
+{
+  file_object_->New("test");
+
+  std::vector<std::string> strings_to_set;
+  std::vector<uint64_t>    ids;
+
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    strings_to_set.push_back(GetStringForTesting());
+
+    file_object_->CreateNewFile(strings_to_set.back().size());
+    file_object_->Write(strings_to_set.back());
+    ids.push_back(file_object_->id());
+  }
+
+  auto const stack_size = file_object_->underlying_stack().size();
+
+  // Erasing and recreating files of the same size must not grow the stack
+  for (std::size_t i = 0; i < ids.size(); i += 2)
+  {
+    file_object_->SeekFile(ids[i]);
+    file_object_->Erase();
+
+    file_object_->CreateNewFile(strings_to_set[i].size());
+    file_object_->Write(strings_to_set[i]);
+    ids[i] = file_object_->id();
+  }
+
+  EXPECT_EQ(file_object_->underlying_stack().size(), stack_size);
+  ASSERT_TRUE(file_object_->VerifyConsistency(ids));
+
+  // Repeatedly grow files which are not at the end of the stack
+  for (std::size_t round = 0; round < 4; ++round)
+  {
+    for (std::size_t i = 0; i < ids.size(); ++i)
+    {
+      std::string extra = GetStringForTesting();
+
+      file_object_->SeekFile(ids[i]);
+      file_object_->Resize(strings_to_set[i].size() + extra.size());
+      file_object_->Seek(strings_to_set[i].size());
+      file_object_->Write(extra);
+      strings_to_set[i] += extra;
+
+      ASSERT_TRUE(file_object_->VerifyConsistency(ids));
+    }
+  }
+
+  for (std::size_t i = 0; i < ids.size(); ++i)
+  {
+    file_object_->SeekFile(ids[i]);
+    auto doc = file_object_->AsDocument();
+
+    EXPECT_EQ(std::string{doc.document}, strings_to_set[i]);
+  }
+}
+
+TEST_F(FileObjectTests, AdjacentFreeRunsAreCoalesced)
+{
+  file_object_->New("test");
+
+  uint64_t const file_size = 10 * FileBlockType<>::CAPACITY;
+
+  std::vector<uint64_t> ids;
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    file_object_->CreateNewFile(file_size);
+    ids.push_back(file_object_->id());
+  }
+
+  auto const stack_size = file_object_->underlying_stack().size();
+
+  // release the first three files, the middle one last so it is merged on both sides
+  for (std::size_t i : {0, 2, 1})
+  {
+    file_object_->SeekFile(ids[i]);
+    file_object_->Erase();
+  }
+
+  std::vector<uint64_t> remaining{ids[3]};
+  ASSERT_TRUE(file_object_->VerifyConsistency(remaining));
+
+  // a file the size of all three fits in the merged run
+  file_object_->CreateNewFile(3 * file_size);
+  EXPECT_EQ(file_object_->id(), ids[0]);
+  EXPECT_EQ(file_object_->underlying_stack().size(), stack_size);
+
+  remaining.push_back(file_object_->id());
+  ASSERT_TRUE(file_object_->VerifyConsistency(remaining));
+}
+
+TEST_F(FileObjectTests, GrowingFilesAreAmortised)
+{
+  file_object_->New("test");
+
+  std::string contents = "a";
+
+  file_object_->CreateNewFile(contents.size());
+  file_object_->Write(contents);
+  uint64_t const id = file_object_->id();
+
+  // keep the file away from the end of the stack, so it can not be extended in place
+  file_object_->CreateNewFile(1);
+  std::vector<uint64_t> ids{id, file_object_->id()};
+
+  for (std::size_t i = 0; i < 64; ++i)
+  {
+    std::string const extra(FileBlockType<>::CAPACITY, static_cast<char>('b' + (i % 16)));
+
+    file_object_->SeekFile(id);
+    file_object_->Resize(contents.size() + extra.size());
+    file_object_->Seek(contents.size());
+    file_object_->Write(extra);
+    contents += extra;
+
+    // a file which is relocated to the end of the stack is blocked in again, by a file which is
+    // too large to fit in any of the released space
+    file_object_->CreateNewFile(4 * contents.size());
+    ids.push_back(file_object_->id());
+
+    ASSERT_TRUE(file_object_->VerifyConsistency(ids));
+  }
+
+  // doubling the capacity bounds the number of blocks copied by relocation, rather than the
+  // whole file being copied each time it grows
+  EXPECT_LT(file_object_->underlying_stack().num_writes(), 16u * 64u);
+
+  file_object_->SeekFile(id);
+  EXPECT_EQ(std::string{file_object_->AsDocument().document}, contents);
+}
+
+TEST_F(FileObjectTests, OriginalFormatFilesAreConverted)
+{
+  using BlockType = FileBlockType<>;
+
+  uint64_t const capacity  = BlockType::CAPACITY;
+  uint64_t const undefined = BlockType::UNDEFINED;
+
+  // the layout of the original format, where each file is a linked list of blocks:
+  //   0: free list 5 -> 7, 1 -> 2 -> 4: file A, 3: file B, 8 -> 6: file C
+  std::vector<uint64_t> const next{5, 2, 4, undefined, undefined, 7, undefined, 0, 6};
+  std::vector<uint64_t> const previous{7, undefined, 1, undefined, 2, 0, 8, 5, undefined};
+  std::unordered_map<uint64_t, std::string> const files{
+      {1, std::string(2 * capacity + 10, 'a')}, {3, "b"}, {8, std::string(capacity + 3, 'c')}};
+
+  std::vector<BlockType> blocks(next.size());
+  for (std::size_t i = 0; i < blocks.size(); ++i)
+  {
+    blocks[i].next     = next[i];
+    blocks[i].previous = previous[i];
+  }
+  blocks[0].free_blocks = 2;
+
+  for (auto const &file : files)
+  {
+    blocks[file.first].file_object_size = file.second.size();
+
+    uint64_t index = file.first;
+    for (uint64_t offset = 0; offset < file.second.size(); offset += capacity)
+    {
+      std::memcpy(blocks[index].data, file.second.data() + offset,
+                  std::min(capacity, file.second.size() - offset));
+      index = next[index];
+    }
+  }
+
+  auto &stack = file_object_->underlying_stack();
+  stack.New("original");
+  for (auto const &block : blocks)
+  {
+    stack.Push(block);
+  }
+
+  file_object_->Load("original");
+
+  std::vector<uint64_t> ids{1, 3, 8};
+  ASSERT_TRUE(file_object_->VerifyConsistency(ids));
+
+  for (auto const &file : files)
+  {
+    file_object_->SeekFile(file.first);
+    EXPECT_EQ(std::string{file_object_->AsDocument().document}, file.second);
+  }
+
+  // the free blocks are reused
+  file_object_->CreateNewFile(1);
+  EXPECT_TRUE((file_object_->id() == 5) || (file_object_->id() == 7));
+  EXPECT_EQ(stack.size(), blocks.size());
+  ids.push_back(file_object_->id());
+
+  // a fragmented file can still grow
+  std::string const grown(5 * capacity, 'd');
+  file_object_->SeekFile(1);
+  file_object_->Resize(grown.size());
+  file_object_->Write(grown);
+  ASSERT_TRUE(file_object_->VerifyConsistency(ids));
+
+  // the conversion is only made once
+  file_object_->Load("original");
+  ASSERT_TRUE(file_object_->VerifyConsistency(ids));
+
+  file_object_->SeekFile(1);
+  EXPECT_EQ(std::string{file_object_->AsDocument().document}, grown);
+  file_object_->SeekFile(8);
+  EXPECT_EQ(std::string{file_object_->AsDocument().document}, files.at(8));
+}
+
 TEST_F(FileObjectTests, SeekAndTellFiles)
 {
   file_object_->New("test");
@@ -145,6 +145,53 @@ TEST(new_revertible_store_test, basic_example_of_commit_revert1)
   }
 }
 
+TEST(new_revertible_store_test, get_batch_matches_get)
+{
+  NewRevertibleDocumentStore store;
+  store.New("a_14.db", "b_14.db", "c_14.db", "d_14.db", true);
+
+  // sizes either side of the capacity of a single block
+  std::vector<std::size_t> const sizes{0, 1, 100, 2023, 2024, 2025, 5000};
+
+  NewRevertibleDocumentStore::Keys keys;
+  for (std::size_t i = 0; i < sizes.size(); ++i)
+  {
+    keys.emplace_back(storage::ResourceAddress(std::to_string(i)));
+    store.Set(keys.back(), std::string(sizes[i], static_cast<char>('a' + i)));
+
+    // interleave keys which are not present
+    keys.emplace_back(storage::ResourceAddress(std::to_string(10000 + i)));
+  }
+
+  auto const check_batch = [&store, &keys]() {
+    auto const documents = store.GetBatch(keys);
+    ASSERT_EQ(documents.size(), keys.size());
+
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+      auto const expected = store.Get(keys[i]);
+
+      EXPECT_EQ(documents[i].failed, expected.failed);
+      EXPECT_EQ(ConstByteArray(documents[i]), ConstByteArray(expected));
+    }
+  };
+
+  check_batch();
+
+  auto const hash = store.Commit();
+
+  for (std::size_t i = 0; i < sizes.size(); ++i)
+  {
+    store.Set(storage::ResourceAddress(std::to_string(i)), std::string(sizes.back() - i, 'z'));
+  }
+
+  check_batch();
+
+  // the batch must also see the reverted state
+  store.RevertToHash(hash);
+  check_batch();
+}
+
 TEST(new_revertible_store_test, more_involved_commit_revert)
 {
   NewRevertibleDocumentStore store;
@@ -205,4 +205,100 @@ TEST(versioned_random_access_stack_gtest, loading_file)
   }
 }
 
+TEST(versioned_random_access_stack_gtest, repeated_writes_revert_to_original_values)
+{
+  NewVersionedRandomAccessStack<StringProxy> stack;
+  stack.New("d_main.db", "d_history.db");
+
+  std::vector<ByteArray> hashes;
+  for (std::size_t i = 0; i < 3; ++i)
+  {
+    hashes.push_back(Hash<crypto::SHA256>(std::to_string(i)));
+  }
+
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    stack.Push(StringProxy(std::to_string(i)));
+  }
+
+  stack.Commit(DefaultKey(hashes[0]));
+
+  // repeatedly modify the same elements, interleaved with swaps, pops and pushes
+  for (std::size_t round = 0; round < 10; ++round)
+  {
+    stack.Set(0, StringProxy(std::to_string(100 + round)));
+    stack.Set(7, StringProxy(std::to_string(200 + round)));
+    stack.Swap(0, 3);
+    stack.Set(3, StringProxy(std::to_string(300 + round)));
+    stack.Pop();
+    stack.Push(StringProxy(std::to_string(400 + round)));
+    stack.Set(7, StringProxy(std::to_string(500 + round)));
+  }
+
+  stack.Commit(DefaultKey(hashes[1]));
+
+  for (std::size_t round = 0; round < 10; ++round)
+  {
+    stack.Set(5, StringProxy(std::to_string(600 + round)));
+    stack.SetExtraHeader(round);
+  }
+
+  stack.Commit(DefaultKey(hashes[2]));
+
+  // revert past both sets of changes
+  stack.RevertToHash(DefaultKey(hashes[0]));
+
+  ASSERT_EQ(stack.size(), 8);
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    EXPECT_EQ(stack.Get(i), StringProxy(std::to_string(i)));
+  }
+
+  EXPECT_EQ(stack.header_extra(), 0);
+}
+
+TEST(versioned_random_access_stack_gtest, hash_exists_tracks_reverted_bookmarks)
+{
+  std::vector<ByteArray> hashes;
+  for (std::size_t i = 0; i < 3; ++i)
+  {
+    hashes.push_back(Hash<crypto::SHA256>(std::to_string(i)));
+  }
+
+  {
+    NewVersionedRandomAccessStack<StringProxy> stack;
+    stack.New("e_main.db", "e_history.db");
+
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+      stack.Push(StringProxy(std::to_string(i)));
+      stack.Commit(DefaultKey(hashes[i]));
+    }
+
+    for (auto const &hash : hashes)
+    {
+      EXPECT_TRUE(stack.HashExists(DefaultKey(hash)));
+    }
+
+    // reverting removes the later bookmarks
+    stack.RevertToHash(DefaultKey(hashes[1]));
+
+    EXPECT_TRUE(stack.HashExists(DefaultKey(hashes[0])));
+    EXPECT_TRUE(stack.HashExists(DefaultKey(hashes[1])));
+    EXPECT_FALSE(stack.HashExists(DefaultKey(hashes[2])));
+
+    stack.Flush(false);
+  }
+
+  {
+    // the bookmarks are recovered when the stack is loaded
+    NewVersionedRandomAccessStack<StringProxy> stack;
+    stack.Load("e_main.db", "e_history.db");
+
+    EXPECT_TRUE(stack.HashExists(DefaultKey(hashes[0])));
+    EXPECT_TRUE(stack.HashExists(DefaultKey(hashes[1])));
+    EXPECT_FALSE(stack.HashExists(DefaultKey(hashes[2])));
+  }
+}
+
 }  // namespace
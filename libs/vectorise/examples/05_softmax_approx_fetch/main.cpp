@@ -32,15 +32,9 @@ using vector_type = typename array_type::VectorRegisterType;
 
 void SoftMax(array_type const &A, array_type &B)
 {
-  type sum{0};
+  B.in_parallel().Apply([](auto const &a, auto &b) { b = approx_exp(a); }, A);
 
-  B.in_parallel().Apply(
-      [&sum](auto const &a, auto &b) {
-        decltype(a) e = approx_exp(a);
-        sum           = sum + reduce(e);
-        b             = e;
-      },
-      A);
+  type sum = B.in_parallel().SumReduce([](auto const &b) { return b; });
 
   auto scale(type(1.0 / sum));
   B.in_parallel().Apply([scale](auto const &a, auto &b) { b = a * decltype(a)(scale); }, B);
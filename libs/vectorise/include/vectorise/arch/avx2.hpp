@@ -34,6 +34,8 @@
 #include "vectorise/arch/avx2/register_int64.hpp"
 #include "vectorise/arch/avx2/register_int8.hpp"
 
+#include "vectorise/arch/avx512.hpp"
+
 #undef ADD_REGISTER_SIZE
 
 #endif
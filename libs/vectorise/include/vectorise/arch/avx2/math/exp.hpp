@@ -17,210 +17,120 @@
 //
 //------------------------------------------------------------------------------
 
+#include "vectorise/arch/avx2/register_fixed32.hpp"
 #include "vectorise/fixed_point/fixed_point.hpp"
 
 #include <emmintrin.h>
+#include <immintrin.h>
 
 #include <limits>
 
 namespace fetch {
 namespace vectorise {
 
-static const fixed_point::fp64_t Exp_P01(0, 0x80000000);  //  1 / 2
-static const fixed_point::fp64_t Exp_P02(0, 0x1C71C71C);  //  1 / 9
-static const fixed_point::fp64_t Exp_P03(0, 0x038E38E3);  //  1 / 72
-static const fixed_point::fp64_t Exp_P04(0, 0x00410410);  //  1 / 1008
-static const fixed_point::fp64_t Exp_P05(0, 0x00022ACD);  //  1 / 30240
-
-static const fixed_point::fp64_t integer_mask(0xffffffff, nullptr);  //  1 / 30240
-
-static const fixed_point::fp64_t one_over_LN2{fixed_point::fp64_t::_1 /
-                                              fixed_point::fp64_t::CONST_LN2};  //  1 / CONST_LN2
-
-static const VectorRegister<fixed_point::fp32_t, 128> FP32_128_INTEGER_MASK(
-    static_cast<fixed_point::fp32_t>(integer_mask));
-static const VectorRegister<fixed_point::fp32_t, 256> FP32_256_INTEGER_MASK(
-    static_cast<fixed_point::fp32_t>(integer_mask));
-// TODO (ML-522) ; implement fp64 exp vectorisation
-// static const VectorRegister<fixed_point::fp64_t, 128> FP64_128_INTEGER_MASK{integer_mask};
-// static const VectorRegister<fixed_point::fp64_t, 256> FP64_256_INTEGER_MASK{integer_mask};
-
-static const VectorRegister<fixed_point::fp32_t, 128> FP32_128_CONST_LN2(
-    fixed_point::fp32_t::CONST_LN2);
-static const VectorRegister<fixed_point::fp32_t, 128> FP32_128_ONE_CONST_LN2(
-    static_cast<fixed_point::fp32_t>(one_over_LN2));
-
-static const VectorRegister<fixed_point::fp32_t, 256> FP32_256_CONST_LN2(
-    fixed_point::fp32_t::CONST_LN2);
-static const VectorRegister<fixed_point::fp32_t, 256> FP32_256_ONE_CONST_LN2(
-    static_cast<fixed_point::fp32_t>(one_over_LN2));
-
-static const VectorRegister<fixed_point::fp32_t, 128> FP32_128_EXP_P01(
-    static_cast<fixed_point::fp32_t>(Exp_P01));
-static const VectorRegister<fixed_point::fp32_t, 128> FP32_128_EXP_P02(
-    static_cast<fixed_point::fp32_t>(Exp_P02));
-static const VectorRegister<fixed_point::fp32_t, 128> FP32_128_EXP_P03(
-    static_cast<fixed_point::fp32_t>(Exp_P03));
-static const VectorRegister<fixed_point::fp32_t, 128> FP32_128_EXP_P04(
-    static_cast<fixed_point::fp32_t>(Exp_P04));
-static const VectorRegister<fixed_point::fp32_t, 128> FP32_128_EXP_P05(
-    static_cast<fixed_point::fp32_t>(Exp_P05));
-
-static const VectorRegister<fixed_point::fp32_t, 256> FP32_256_EXP_P01(
-    static_cast<fixed_point::fp32_t>(Exp_P01));
-static const VectorRegister<fixed_point::fp32_t, 256> FP32_256_EXP_P02(
-    static_cast<fixed_point::fp32_t>(Exp_P02));
-static const VectorRegister<fixed_point::fp32_t, 256> FP32_256_EXP_P03(
-    static_cast<fixed_point::fp32_t>(Exp_P03));
-static const VectorRegister<fixed_point::fp32_t, 256> FP32_256_EXP_P04(
-    static_cast<fixed_point::fp32_t>(Exp_P04));
-static const VectorRegister<fixed_point::fp32_t, 256> FP32_256_EXP_P05(
-    static_cast<fixed_point::fp32_t>(Exp_P05));
-
-static const VectorRegister<fixed_point::fp32_t, 128> FP32_128_ONE(fixed_point::fp32_t::_1);
-static const VectorRegister<fixed_point::fp32_t, 256> FP32_256_ONE(fixed_point::fp32_t::_1);
-
-static const VectorRegister<fixed_point::fp32_t, 128> FP32_128_MAX_EXP(
-    fixed_point::fp32_t::MAX_EXP);
-static const VectorRegister<fixed_point::fp32_t, 128> FP32_128_MIN_EXP(
-    fixed_point::fp32_t::MIN_EXP);
-static const VectorRegister<fixed_point::fp32_t, 256> FP32_256_MAX_EXP(
-    fixed_point::fp32_t::MAX_EXP);
-static const VectorRegister<fixed_point::fp32_t, 256> FP32_256_MIN_EXP(
-    fixed_point::fp32_t::MIN_EXP);
-
-inline VectorRegister<fixed_point::fp32_t, 128> Exp(
-    VectorRegister<fixed_point::fp32_t, 128> const &x)
-{
-  // Now find out which of the initial elements are +inf, -inf, NaN to fill in the final result
-  auto mask_pos_inf = (x == VectorRegister<fixed_point::fp32_t, 128>::MaskPosInf());
-  auto mask_neg_inf = (x == VectorRegister<fixed_point::fp32_t, 128>::MaskNegInf());
-  auto mask_nan     = VectorRegister<fixed_point::fp32_t, 128>::MaskNaN(x);
-
-  // Handle Overflows and Underflows
-  // compute masks for overflow and underflow
-  auto mask_overflow  = (x > FP32_128_MAX_EXP);
-  auto mask_underflow = (FP32_128_MIN_EXP > x);
-
-  VectorRegister<fixed_point::fp32_t, 128> k;
-  k = multiply_unsafe(x, FP32_128_ONE_CONST_LN2);
-  k = k & FP32_128_INTEGER_MASK;
-
-  VectorRegister<fixed_point::fp32_t, 128> r = x - multiply_unsafe(k, FP32_128_CONST_LN2);
-
-  __m128i                                  shift_indexes = _mm_srli_epi32(k.data(), 16);
-  VectorRegister<fixed_point::fp32_t, 128> e1 =
-      VectorRegister<fixed_point::fp32_t, 128>(_mm_sllv_epi32(FP32_128_ONE.data(), shift_indexes));
-
-  VectorRegister<fixed_point::fp32_t, 128> r2 = multiply_unsafe(r, r);
-  VectorRegister<fixed_point::fp32_t, 128> r3 = multiply_unsafe(r2, r);
-  VectorRegister<fixed_point::fp32_t, 128> r4 = multiply_unsafe(r3, r);
-  VectorRegister<fixed_point::fp32_t, 128> r5 = multiply_unsafe(r4, r);
-  r                                           = multiply_unsafe(r, FP32_128_EXP_P01);
-  r2                                          = multiply_unsafe(r2, FP32_128_EXP_P02);
-  r3                                          = multiply_unsafe(r3, FP32_128_EXP_P03);
-  r4                                          = multiply_unsafe(r4, FP32_128_EXP_P04);
-  r5                                          = multiply_unsafe(r5, FP32_128_EXP_P05);
-
-  VectorRegister<fixed_point::fp32_t, 128> P  = FP32_128_ONE + r + r2 + r3 + r4 + r5;
-  VectorRegister<fixed_point::fp32_t, 128> Q  = FP32_128_ONE - r + r2 - r3 + r4 - r5;
-  VectorRegister<fixed_point::fp32_t, 128> e2 = P / Q;
-  VectorRegister<fixed_point::fp32_t, 128> e  = e1 * e2;
-
-  // Replace +inf in the final product using the mask
-  e.data() = _mm_blendv_epi8(
-      e.data(), VectorRegister<fixed_point::fp32_t, 128>::MaskPosInf().data(), mask_pos_inf.data());
-  // Replace -inf in the final product using the mask
-  e.data() = _mm_blendv_epi8(e.data(), VectorRegister<fixed_point::fp32_t, 128>::_0().data(),
-                             (mask_neg_inf | mask_underflow).data());
-  // Replace NaN in the final product using the mask
-  e.data() = _mm_blendv_epi8(
-      e.data(), VectorRegister<fixed_point::fp32_t, 128>(fixed_point::fp32_t::NaN).data(),
-      mask_nan.data());
-
-  // Remove NaN/Inf elements from Overflow/Underflow mask
-  mask_overflow.data() =
-      _mm_blendv_epi8(mask_overflow.data(), _mm_setzero_si128(), (mask_nan | mask_pos_inf).data());
-  mask_underflow.data() =
-      _mm_blendv_epi8(mask_underflow.data(), _mm_setzero_si128(), (mask_nan | mask_neg_inf).data());
-  bool is_overflow = _mm_movemask_epi8(mask_overflow.data() | mask_underflow.data()) != 0;
-  bool is_infinity = any_equal_to(mask_pos_inf | mask_neg_inf,
-                                  VectorRegister<fixed_point::fp32_t, 128>::MaskAllBits());
-  bool is_nan = any_equal_to(mask_nan, VectorRegister<fixed_point::fp32_t, 128>::MaskAllBits());
-  fixed_point::fp32_t::fp_state |=
-      fixed_point::fp32_t::STATE_INFINITY * static_cast<uint32_t>(is_infinity);
-  fixed_point::fp32_t::fp_state |= fixed_point::fp32_t::STATE_NAN * static_cast<uint32_t>(is_nan);
-  fixed_point::fp32_t::fp_state |=
-      fixed_point::fp32_t::STATE_OVERFLOW * static_cast<uint32_t>(is_overflow);
-
-  return e;
-}
-
+/**
+ * Vectorised e^x for fp32, which is bit for bit identical to FixedPoint<16, 16>::Exp, including the
+ * special cases and the fp_state flags raised, so that it can be used where results must be
+ * deterministic.
+ *
+ * The same range reduction and Pade approximant are evaluated on |x| in every lane. Negative lanes
+ * then take the reciprocal, as the scalar version does, and the special cases are blended in last.
+ */
 inline VectorRegister<fixed_point::fp32_t, 256> Exp(
     VectorRegister<fixed_point::fp32_t, 256> const &x)
 {
-  // Now find out which of the initial elements are +inf, -inf, NaN to fill in the final result
-  auto mask_pos_inf = (x == VectorRegister<fixed_point::fp32_t, 256>::MaskPosInf());
-  auto mask_neg_inf = (x == VectorRegister<fixed_point::fp32_t, 256>::MaskNegInf());
-  auto mask_nan     = VectorRegister<fixed_point::fp32_t, 256>::MaskNaN(x);
-
-  // Handle Overflows and Underflows
-  // compute masks for overflow and underflow
-  auto mask_overflow  = (x > FP32_256_MAX_EXP);
-  auto mask_underflow = (FP32_256_MIN_EXP > x);
-
-  VectorRegister<fixed_point::fp32_t, 256> k;
-  k = multiply_unsafe(x, FP32_256_ONE_CONST_LN2);
-  k = k & FP32_256_INTEGER_MASK;
-
-  VectorRegister<fixed_point::fp32_t, 256> r = x - multiply_unsafe(k, FP32_256_CONST_LN2);
-
-  __m256i                                  shift_indexes = _mm256_srli_epi32(k.data(), 16);
-  VectorRegister<fixed_point::fp32_t, 256> e1            = VectorRegister<fixed_point::fp32_t, 256>(
-      _mm256_sllv_epi32(FP32_256_ONE.data(), shift_indexes));
-
-  VectorRegister<fixed_point::fp32_t, 256> r2 = multiply_unsafe(r, r);
-  VectorRegister<fixed_point::fp32_t, 256> r3 = multiply_unsafe(r2, r);
-  VectorRegister<fixed_point::fp32_t, 256> r4 = multiply_unsafe(r3, r);
-  VectorRegister<fixed_point::fp32_t, 256> r5 = multiply_unsafe(r4, r);
-  r                                           = multiply_unsafe(r, FP32_256_EXP_P01);
-  r2                                          = multiply_unsafe(r2, FP32_256_EXP_P02);
-  r3                                          = multiply_unsafe(r3, FP32_256_EXP_P03);
-  r4                                          = multiply_unsafe(r4, FP32_256_EXP_P04);
-  r5                                          = multiply_unsafe(r5, FP32_256_EXP_P05);
-
-  VectorRegister<fixed_point::fp32_t, 256> P  = FP32_256_ONE + r + r2 + r3 + r4 + r5;
-  VectorRegister<fixed_point::fp32_t, 256> Q  = FP32_256_ONE - r + r2 - r3 + r4 - r5;
-  VectorRegister<fixed_point::fp32_t, 256> e2 = P / Q;
-  VectorRegister<fixed_point::fp32_t, 256> e  = e1 * e2;
-
-  // Replace +inf in the final product using the mask
-  e.data() = _mm256_blendv_epi8(
-      e.data(), VectorRegister<fixed_point::fp32_t, 256>::MaskPosInf().data(), mask_pos_inf.data());
-  // Replace -inf in the final product using the mask
-  e.data() = _mm256_blendv_epi8(e.data(), VectorRegister<fixed_point::fp32_t, 256>::_0().data(),
-                                (mask_neg_inf | mask_underflow).data());
-  // Replace NaN in the final product using the mask
-  e.data() = _mm256_blendv_epi8(
-      e.data(), VectorRegister<fixed_point::fp32_t, 256>(fixed_point::fp32_t::NaN).data(),
-      mask_nan.data());
-
-  // Remove NaN/Inf elements from Overflow/Underflow mask
-  mask_overflow.data()  = _mm256_blendv_epi8(mask_overflow.data(), _mm256_setzero_si256(),
-                                            (mask_nan | mask_pos_inf).data());
-  mask_underflow.data() = _mm256_blendv_epi8(mask_underflow.data(), _mm256_setzero_si256(),
-                                             (mask_nan | mask_neg_inf).data());
-  bool is_overflow      = _mm256_movemask_epi8(mask_overflow.data() | mask_underflow.data()) != 0;
-  bool is_infinity      = any_equal_to(mask_pos_inf | mask_neg_inf,
-                                  VectorRegister<fixed_point::fp32_t, 256>::MaskAllBits());
-  bool is_nan = any_equal_to(mask_nan, VectorRegister<fixed_point::fp32_t, 256>::MaskAllBits());
-  fixed_point::fp32_t::fp_state |=
-      fixed_point::fp32_t::STATE_INFINITY * static_cast<uint32_t>(is_infinity);
-  fixed_point::fp32_t::fp_state |= fixed_point::fp32_t::STATE_NAN * static_cast<uint32_t>(is_nan);
-  fixed_point::fp32_t::fp_state |=
-      fixed_point::fp32_t::STATE_OVERFLOW * static_cast<uint32_t>(is_overflow);
+  using Type = fixed_point::fp32_t;
+
+  __m256i const zero = _mm256_setzero_si256();
+  __m256i const one  = _mm256_set1_epi32(Type::_1.Data());
+  __m256i const ln2  = _mm256_set1_epi32(Type::CONST_LN2.Data());
+
+  __m256i const nan     = _mm256_set1_epi32(Type::NaN.Data());
+  __m256i const pos_inf = _mm256_set1_epi32(Type::POSITIVE_INFINITY.Data());
+
+  __m256i const is_nan      = _mm256_cmpeq_epi32(x.data(), nan);
+  __m256i const is_pos_inf  = _mm256_cmpeq_epi32(x.data(), pos_inf);
+  __m256i const is_zero     = _mm256_cmpeq_epi32(x.data(), zero);
+  __m256i const is_negative = _mm256_cmpgt_epi32(zero, x.data());
+
+  // Covers -inf as well as the values whose exponent rounds to 0
+  __m256i const is_underflow =
+      _mm256_cmpgt_epi32(_mm256_set1_epi32(Type::MIN_EXP.Data()), x.data());
+
+  // e^x = 1 / e^-x for negative x, so the exponent is computed for |x|
+  __m256i const abs_x       = _mm256_abs_epi32(x.data());
+  __m256i const is_e        = _mm256_cmpeq_epi32(abs_x, one);
+  __m256i const is_overflow =
+      _mm256_cmpgt_epi32(abs_x, _mm256_set1_epi32(Type::MAX_EXP.Data() - 1));
+
+  // Find integer k and r ∈ [0, ln2) such as: |x| = k*ln2 + r, then e^|x| = 2^k * e^r
+  __m256i       unused{};
+  __m256i const k  = _mm256_and_si256(details::DivideByPositiveFixed32(abs_x, ln2),
+                                     _mm256_set1_epi32(Type::INTEGER_MASK));
+  __m256i const r  = _mm256_sub_epi32(abs_x, details::MultiplyFixed32(k, ln2, unused));
+  __m256i const e1 = _mm256_sllv_epi32(one, _mm256_srli_epi32(k, Type::FRACTIONAL_BITS));
+
+  // The powers of r are below 1, so none of these products saturate
+  __m256i const r2 = details::MultiplyFixed32(r, r, unused);
+  __m256i const r3 = details::MultiplyFixed32(r2, r, unused);
+  __m256i const r4 = details::MultiplyFixed32(r3, r, unused);
+  __m256i const r5 = details::MultiplyFixed32(r4, r, unused);
+  __m256i const c1 = details::MultiplyFixed32(
+      r, _mm256_set1_epi32(static_cast<Type>(fixed_point::Exp_P01).Data()), unused);
+  __m256i const c2 = details::MultiplyFixed32(
+      r2, _mm256_set1_epi32(static_cast<Type>(fixed_point::Exp_P02).Data()), unused);
+  __m256i const c3 = details::MultiplyFixed32(
+      r3, _mm256_set1_epi32(static_cast<Type>(fixed_point::Exp_P03).Data()), unused);
+  __m256i const c4 = details::MultiplyFixed32(
+      r4, _mm256_set1_epi32(static_cast<Type>(fixed_point::Exp_P04).Data()), unused);
+  __m256i const c5 = details::MultiplyFixed32(
+      r5, _mm256_set1_epi32(static_cast<Type>(fixed_point::Exp_P05).Data()), unused);
+
+  __m256i P = _mm256_add_epi32(one, c1);
+  P         = _mm256_add_epi32(P, c2);
+  P         = _mm256_add_epi32(P, c3);
+  P         = _mm256_add_epi32(P, c4);
+  P         = _mm256_add_epi32(P, c5);
+  __m256i Q = _mm256_sub_epi32(one, c1);
+  Q         = _mm256_add_epi32(Q, c2);
+  Q         = _mm256_sub_epi32(Q, c3);
+  Q         = _mm256_add_epi32(Q, c4);
+  Q         = _mm256_sub_epi32(Q, c5);
+
+  __m256i       saturated{};
+  __m256i const e2 = details::DivideByPositiveFixed32(P, Q);
+  __m256i       e  = details::MultiplyFixed32(e1, e2, saturated);
+  e                = _mm256_blendv_epi8(e, _mm256_set1_epi32(Type::CONST_E.Data()), is_e);
+  e                = _mm256_blendv_epi8(e, _mm256_set1_epi32(Type::MAX), is_overflow);
+
+  __m256i ret = _mm256_blendv_epi8(e, details::DivideByPositiveFixed32(one, e), is_negative);
+
+  // Fill in the special cases, in reverse order of precedence
+  ret = _mm256_blendv_epi8(ret, zero, is_underflow);
+  ret = _mm256_blendv_epi8(ret, one, is_zero);
+  ret = _mm256_blendv_epi8(ret, pos_inf, is_pos_inf);
+  ret = _mm256_blendv_epi8(ret, nan, is_nan);
+
+  __m256i const is_special =
+      _mm256_or_si256(_mm256_or_si256(is_nan, is_pos_inf), _mm256_or_si256(is_zero, is_underflow));
+  __m256i const overflowed =
+      _mm256_andnot_si256(is_special, _mm256_or_si256(saturated, is_overflow));
+
+  bool is_nan_state      = _mm256_movemask_epi8(is_nan) != 0;
+  bool is_infinity_state = _mm256_movemask_epi8(is_pos_inf) != 0;
+  bool is_overflow_state = _mm256_movemask_epi8(overflowed) != 0;
+  Type::fp_state |= Type::STATE_NAN * static_cast<uint32_t>(is_nan_state);
+  Type::fp_state |= Type::STATE_INFINITY * static_cast<uint32_t>(is_infinity_state);
+  Type::fp_state |= Type::STATE_OVERFLOW * static_cast<uint32_t>(is_overflow_state);
+
+  return {ret};
+}
 
-  return e;
+inline VectorRegister<fixed_point::fp32_t, 128> Exp(
+    VectorRegister<fixed_point::fp32_t, 128> const &x)
+{
+  VectorRegister<fixed_point::fp32_t, 256> const wide(_mm256_set_m128i(x.data(), x.data()));
+  return {_mm256_castsi256_si128(Exp(wide).data())};
 }
 
 inline VectorRegister<fixed_point::fp64_t, 128> Exp(
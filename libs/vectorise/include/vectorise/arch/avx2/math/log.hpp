@@ -0,0 +1,124 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/arch/avx2/register_fixed32.hpp"
+#include "vectorise/fixed_point/fixed_point.hpp"
+
+#include <immintrin.h>
+
+namespace fetch {
+namespace vectorise {
+
+/**
+ * Vectorised natural logarithm for fp32, which is bit for bit identical to FixedPoint<16, 16>::Log,
+ * i.e. Log2(x) / log2(e), including the fp_state flags raised.
+ *
+ * Lanes with 2^-14 < x < 2^14 (raw values between 4 and 2^30) follow the scalar algorithm step by
+ * step: x (or 1/x when x < 1) is reduced to r ∈ [0.5, 1) by a power of two of at most 2^14, and
+ * log2(r) is evaluated with the same Pade approximant. None of these steps can overflow for such
+ * inputs. The remaining lanes are handed to the scalar function. Outside that range the scalar
+ * range reduction wraps around in 32 bits, which is not worth reproducing.
+ */
+inline VectorRegister<fixed_point::fp32_t, 256> Log(
+    VectorRegister<fixed_point::fp32_t, 256> const &x)
+{
+  using Type = fixed_point::fp32_t;
+
+  __m256i const zero = _mm256_setzero_si256();
+  __m256i const one  = _mm256_set1_epi32(Type::_1.Data());
+
+  __m256i const in_range =
+      _mm256_and_si256(_mm256_cmpgt_epi32(x.data(), _mm256_set1_epi32(4)),
+                       _mm256_cmpgt_epi32(_mm256_set1_epi32(int32_t{1} << 30), x.data()));
+  __m256i const value = _mm256_blendv_epi8(one, x.data(), in_range);
+
+  // sign = Sign(x - 1)
+  __m256i const difference = _mm256_sub_epi32(value, one);
+  __m256i const sign =
+      _mm256_sub_epi32(_mm256_and_si256(_mm256_cmpgt_epi32(difference, zero), one),
+                       _mm256_and_si256(_mm256_cmpgt_epi32(zero, difference), one));
+
+  // y = x, or 1 / x when x < 1, so that y >= 1
+  __m256i const y = _mm256_blendv_epi8(value, details::DivideByPositiveFixed32(one, value),
+                                       _mm256_cmpgt_epi32(one, value));
+
+  // The highest set bit of y, from the exponent of its conversion to float. The conversion rounds,
+  // which can carry into the next power of two, so that case is corrected.
+  __m256i highest_bit = _mm256_sub_epi32(
+      _mm256_srli_epi32(_mm256_castps_si256(_mm256_cvtepi32_ps(y)), 23), _mm256_set1_epi32(127));
+  highest_bit = _mm256_add_epi32(
+      highest_bit,
+      _mm256_cmpgt_epi32(_mm256_sllv_epi32(_mm256_set1_epi32(1), highest_bit), y));
+
+  // k = HighestSetBit(y) - 16, where HighestSetBit counts from 1, and r = y / 2^k ∈ [0.5, 1)
+  __m256i const k =
+      _mm256_sub_epi32(highest_bit, _mm256_set1_epi32(Type::FRACTIONAL_BITS - 1));
+  __m256i const r = details::DivideByPositiveFixed32(y, _mm256_sllv_epi32(one, k));
+
+  auto const multiply = [](__m256i const &a, __m256i const &b) {
+    __m256i unused{};
+    return details::MultiplyFixed32(a, b, unused);
+  };
+
+  __m256i const p00 = _mm256_set1_epi32(Type{137}.Data());
+  __m256i const p01 = _mm256_set1_epi32(Type{1762}.Data());
+  __m256i const p02 = _mm256_set1_epi32(Type{3762}.Data());
+  __m256i const p04 = _mm256_set1_epi32(Type{137}.Data());
+  __m256i const q0  = _mm256_set1_epi32(Type{30}.Data());
+  __m256i const q01 = _mm256_set1_epi32(Type{24}.Data());
+  __m256i const q02 = _mm256_set1_epi32(Type{76}.Data());
+
+  __m256i P = _mm256_add_epi32(p01, multiply(r, p04));
+  P         = _mm256_add_epi32(p02, multiply(r, P));
+  P         = _mm256_add_epi32(p01, multiply(r, P));
+  P         = _mm256_add_epi32(p00, multiply(r, P));
+  P         = multiply(_mm256_sub_epi32(r, one), P);
+  __m256i Q = _mm256_add_epi32(q01, r);
+  Q         = _mm256_add_epi32(q02, multiply(r, Q));
+  Q         = _mm256_add_epi32(q01, multiply(r, Q));
+  Q         = _mm256_add_epi32(one, multiply(r, Q));
+  Q         = multiply(multiply(q0, _mm256_add_epi32(one, r)), Q);
+  Q         = multiply(Q, _mm256_set1_epi32(Type::CONST_LN2.Data()));
+
+  __m256i const R = details::DivideByPositiveFixed32(P, Q);
+
+  // log2(x) = sign * (k + R) and log(x) = log2(x) / log2(e)
+  __m256i const log2 = multiply(
+      sign, _mm256_add_epi32(_mm256_slli_epi32(k, Type::FRACTIONAL_BITS), R));
+  __m256i ret = details::DivideByPositiveFixed32(log2, _mm256_set1_epi32(Type::CONST_LOG2E.Data()));
+
+  int const scalar_lanes = ~_mm256_movemask_ps(_mm256_castsi256_ps(in_range)) & 0xFF;
+  if (scalar_lanes != 0)
+  {
+    ret = details::ApplyScalarFixed32(x.data(), ret, scalar_lanes,
+                                      [](Type const &value) { return Type::Log(value); });
+  }
+
+  return {ret};
+}
+
+inline VectorRegister<fixed_point::fp32_t, 128> Log(
+    VectorRegister<fixed_point::fp32_t, 128> const &x)
+{
+  VectorRegister<fixed_point::fp32_t, 256> const wide(_mm256_set_m128i(x.data(), x.data()));
+  return {_mm256_castsi256_si128(Log(wide).data())};
+}
+
+}  // namespace vectorise
+}  // namespace fetch
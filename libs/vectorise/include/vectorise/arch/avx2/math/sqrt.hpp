@@ -17,6 +17,11 @@
 //
 //------------------------------------------------------------------------------
 
+#include "vectorise/arch/avx2/register_fixed32.hpp"
+#include "vectorise/fixed_point/fixed_point.hpp"
+
+#include <immintrin.h>
+
 namespace fetch {
 namespace vectorise {
 
@@ -40,5 +45,100 @@ inline VectorRegister<double, 256> sqrt(VectorRegister<double, 256> const &a)
   return {_mm256_sqrt_pd(a.data())};
 }
 
+/**
+ * Vectorised square root for fp32, which is bit for bit identical to FixedPoint<16, 16>::Sqrt,
+ * including the fp_state flags raised.
+ *
+ * Positive finite lanes follow the scalar algorithm step by step: x is reduced to r ∈ [1, 4] with
+ * x = 4^k * r, a Pade approximant of sqrt(r) is refined by two iterations of Goldschmidt's
+ * algorithm, and the result is scaled by 2^k. None of these steps can overflow for such inputs. The
+ * remaining lanes (zero, negative, NaN and the infinities) are handed to the scalar function.
+ */
+inline VectorRegister<fixed_point::fp32_t, 256> Sqrt(
+    VectorRegister<fixed_point::fp32_t, 256> const &x)
+{
+  using Type = fixed_point::fp32_t;
+
+  __m256i const zero = _mm256_setzero_si256();
+  __m256i const one  = _mm256_set1_epi32(Type::_1.Data());
+  __m256i const four = _mm256_set1_epi32(Type{4}.Data());
+  __m256i const half = _mm256_set1_epi32(Type::_half.Data());
+
+  __m256i const is_finite_positive =
+      _mm256_and_si256(_mm256_cmpgt_epi32(x.data(), zero),
+                       _mm256_cmpgt_epi32(_mm256_set1_epi32(Type::MAX + 1), x.data()));
+
+  // Find k and r ∈ [1, 4] such that x = 4^k * r, as ReduceSqrt does one step at a time
+  __m256i r = _mm256_blendv_epi8(one, x.data(), is_finite_positive);
+  __m256i k = zero;
+  for (int i = 0; i < 8; ++i)
+  {
+    __m256i const above = _mm256_cmpgt_epi32(r, four);
+    r                   = _mm256_blendv_epi8(r, _mm256_srai_epi32(r, 2), above);
+    k                   = _mm256_sub_epi32(k, above);
+  }
+  for (int i = 0; i < 8; ++i)
+  {
+    __m256i const below = _mm256_cmpgt_epi32(one, r);
+    r                   = _mm256_blendv_epi8(r, _mm256_slli_epi32(r, 2), below);
+    k                   = _mm256_add_epi32(k, below);
+  }
+
+  auto const multiply = [](__m256i const &a, __m256i const &b) {
+    __m256i unused{};
+    return details::MultiplyFixed32(a, b, unused);
+  };
+
+  // Pade approximant, 4th order around 1
+  __m256i const p01 = _mm256_set1_epi32(Type{3}.Data());
+  __m256i const p02 = _mm256_set1_epi32(Type{11}.Data());
+  __m256i const p03 = _mm256_set1_epi32(Type{9}.Data());
+  __m256i const q01 = _mm256_set1_epi32(Type{3}.Data());
+  __m256i const q02 = _mm256_set1_epi32(Type{27}.Data());
+  __m256i const q03 = _mm256_set1_epi32(Type{33}.Data());
+
+  __m256i P = multiply(r, _mm256_add_epi32(p03, r));
+  P         = multiply(multiply(p01, r), _mm256_add_epi32(p02, P));
+  P         = multiply(_mm256_add_epi32(one, multiply(p01, r)), _mm256_add_epi32(one, P));
+  __m256i Q = multiply(r, _mm256_add_epi32(q03, r));
+  Q         = multiply(r, _mm256_add_epi32(q02, Q));
+  Q         = multiply(_mm256_add_epi32(q01, r), _mm256_add_epi32(q01, Q));
+
+  __m256i const R = details::DivideByPositiveFixed32(P, Q);
+
+  // Two iterations of Goldschmidt's algorithm
+  __m256i const y_n = details::DivideByPositiveFixed32(one, R);
+  __m256i       x_n = multiply(r, y_n);
+  __m256i       h_n = multiply(half, y_n);
+  __m256i       r_n = _mm256_sub_epi32(half, multiply(x_n, h_n));
+  x_n               = _mm256_add_epi32(x_n, multiply(x_n, r_n));
+  h_n               = _mm256_add_epi32(h_n, multiply(h_n, r_n));
+  r_n               = _mm256_sub_epi32(half, multiply(x_n, h_n));
+  x_n               = _mm256_add_epi32(x_n, multiply(x_n, r_n));
+
+  r = _mm256_blendv_epi8(x_n, r, _mm256_cmpeq_epi32(r, one));
+
+  // Scale by 2^k, where only one of the two shifts has a count below 32
+  __m256i const two_k =
+      _mm256_or_si256(_mm256_sllv_epi32(one, k), _mm256_srlv_epi32(one, _mm256_sub_epi32(zero, k)));
+  __m256i ret = multiply(two_k, r);
+
+  int const scalar_lanes = ~_mm256_movemask_ps(_mm256_castsi256_ps(is_finite_positive)) & 0xFF;
+  if (scalar_lanes != 0)
+  {
+    ret = details::ApplyScalarFixed32(x.data(), ret, scalar_lanes,
+                                      [](Type const &value) { return Type::Sqrt(value); });
+  }
+
+  return {ret};
+}
+
+inline VectorRegister<fixed_point::fp32_t, 128> Sqrt(
+    VectorRegister<fixed_point::fp32_t, 128> const &x)
+{
+  VectorRegister<fixed_point::fp32_t, 256> const wide(_mm256_set_m128i(x.data(), x.data()));
+  return {_mm256_castsi256_si128(Sqrt(wide).data())};
+}
+
 }  // namespace vectorise
 }  // namespace fetch
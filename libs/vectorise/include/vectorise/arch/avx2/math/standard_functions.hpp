@@ -21,5 +21,7 @@
 #include "vectorise/arch/avx2/math/approx_exp.hpp"
 #include "vectorise/arch/avx2/math/approx_log.hpp"
 #include "vectorise/arch/avx2/math/exp.hpp"
+#include "vectorise/arch/avx2/math/log.hpp"
 #include "vectorise/arch/avx2/math/pow.hpp"
 #include "vectorise/arch/avx2/math/sqrt.hpp"
+#include "vectorise/arch/avx2/math/tanh.hpp"
@@ -0,0 +1,77 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/arch/avx2/math/exp.hpp"
+#include "vectorise/arch/avx2/register_fixed32.hpp"
+#include "vectorise/fixed_point/fixed_point.hpp"
+
+#include <immintrin.h>
+
+namespace fetch {
+namespace vectorise {
+
+/**
+ * Vectorised hyperbolic tangent for fp32, which is bit for bit identical to
+ * FixedPoint<16, 16>::TanH, including the fp_state flags raised.
+ *
+ * Lanes in (MIN_EXP, MAX_EXP) compute (e^x - e^-x) / (e^x + e^-x) with the exact vector Exp, as the
+ * scalar code does. Both exponents are then finite and positive, so only the sum can overflow. The
+ * lanes outside that range, and those whose sum overflows, are handed to the scalar function.
+ */
+inline VectorRegister<fixed_point::fp32_t, 256> TanH(
+    VectorRegister<fixed_point::fp32_t, 256> const &x)
+{
+  using Type = fixed_point::fp32_t;
+
+  __m256i const zero = _mm256_setzero_si256();
+
+  __m256i const in_range =
+      _mm256_and_si256(_mm256_cmpgt_epi32(x.data(), _mm256_set1_epi32(Type::MIN_EXP.Data())),
+                       _mm256_cmpgt_epi32(_mm256_set1_epi32(Type::MAX_EXP.Data()), x.data()));
+  __m256i const value = _mm256_blendv_epi8(zero, x.data(), in_range);
+
+  __m256i const e1 = Exp(VectorRegister<Type, 256>(value)).data();
+  __m256i const e2 = Exp(VectorRegister<Type, 256>(_mm256_sub_epi32(zero, value))).data();
+
+  __m256i const sum = _mm256_add_epi32(e1, e2);
+  __m256i const overflow =
+      _mm256_or_si256(_mm256_cmpgt_epi32(sum, _mm256_set1_epi32(Type::MAX)),
+                      _mm256_cmpgt_epi32(zero, sum));
+  __m256i ret = details::DivideByPositiveFixed32(_mm256_sub_epi32(e1, e2), sum);
+
+  __m256i const scalar = _mm256_or_si256(_mm256_cmpeq_epi32(in_range, zero), overflow);
+  int const     scalar_lanes = _mm256_movemask_ps(_mm256_castsi256_ps(scalar));
+  if (scalar_lanes != 0)
+  {
+    ret = details::ApplyScalarFixed32(x.data(), ret, scalar_lanes,
+                                      [](Type const &value) { return Type::TanH(value); });
+  }
+
+  return {ret};
+}
+
+inline VectorRegister<fixed_point::fp32_t, 128> TanH(
+    VectorRegister<fixed_point::fp32_t, 128> const &x)
+{
+  VectorRegister<fixed_point::fp32_t, 256> const wide(_mm256_set_m128i(x.data(), x.data()));
+  return {_mm256_castsi256_si128(TanH(wide).data())};
+}
+
+}  // namespace vectorise
+}  // namespace fetch
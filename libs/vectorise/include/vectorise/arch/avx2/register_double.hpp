@@ -33,7 +33,9 @@
 namespace fetch {
 namespace vectorise {
 
+#ifndef __AVX512F__
 ADD_REGISTER_SIZE(double, 256);
+#endif
 
 template <>
 class VectorRegister<double, 128> : public BaseVectorRegisterType
@@ -747,11 +747,136 @@ inline VectorRegister<fixed_point::fp32_t, 256> operator*(
   return prod;
 }
 
+namespace details {
+
+/**
+ * Divide the fp32 values of a by those of b in double precision. For finite operands whose quotient
+ * is in range this is exactly FixedPoint<16, 16>::operator/, since the shifted numerator is below
+ * 2^53 and so the correctly rounded quotient cannot cross an integer before being truncated.
+ * @return a bit mask of the lanes for which this holds
+ */
+inline int DivideFixed32(__m128i const &a, __m128i const &b, __m128i &quotient)
+{
+  using Type = fixed_point::fp32_t;
+
+  __m256d const scale = _mm256_set1_pd(static_cast<double>(Type::ONE_MASK));
+  __m256d const upper = _mm256_set1_pd(static_cast<double>(Type::MAX) + 1.0);
+  __m256d const lower = _mm256_set1_pd(static_cast<double>(Type::MIN) - 1.0);
+
+  __m256d const q =
+      _mm256_div_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(a), scale), _mm256_cvtepi32_pd(b));
+  quotient = _mm256_cvttpd_epi32(q);
+
+  // Division by zero gives an infinite or NaN quotient, which fails both comparisons
+  __m256d const in_range =
+      _mm256_and_pd(_mm256_cmp_pd(q, upper, _CMP_LT_OQ), _mm256_cmp_pd(q, lower, _CMP_GT_OQ));
+
+  // NaN and the infinities (along with the other patterns outside [MIN, MAX]) are left to the
+  // scalar division
+  __m128i const max       = _mm_set1_epi32(Type::MAX);
+  __m128i const min       = _mm_set1_epi32(Type::MIN);
+  __m128i const special_a = _mm_or_si128(_mm_cmpgt_epi32(a, max), _mm_cmpgt_epi32(min, a));
+  __m128i const special_b = _mm_or_si128(_mm_cmpgt_epi32(b, max), _mm_cmpgt_epi32(min, b));
+  __m128i const special   = _mm_or_si128(special_a, special_b);
+
+  return _mm256_movemask_pd(in_range) & ~_mm_movemask_ps(_mm_castsi128_ps(special));
+}
+
+/**
+ * Multiply the fp32 values in each lane exactly as FixedPoint<16, 16>::operator* does for finite
+ * operands: the 64 bit product is shifted right by the fractional bits and saturated to MAX / MIN.
+ * Lanes which saturated are set in overflow.
+ */
+inline __m256i MultiplyFixed32(__m256i const &a, __m256i const &b, __m256i &overflow)
+{
+  using Type = fixed_point::fp32_t;
+
+  constexpr int64_t ONE = int64_t{1} << Type::FRACTIONAL_BITS;
+
+  __m256i const even = _mm256_mul_epi32(a, b);
+  __m256i const odd  = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+
+  // (prod >> 16) > MAX  <=>  prod >= (MAX + 1) << 16 and (prod >> 16) < MIN  <=>  prod < MIN << 16
+  __m256i const upper = _mm256_set1_epi64x(((int64_t{Type::MAX} + 1) * ONE) - 1);
+  __m256i const lower = _mm256_set1_epi64x(int64_t{Type::MIN} * ONE);
+  __m256i const above =
+      _mm256_blend_epi32(_mm256_cmpgt_epi64(even, upper), _mm256_cmpgt_epi64(odd, upper), 0xAA);
+  __m256i const below =
+      _mm256_blend_epi32(_mm256_cmpgt_epi64(lower, even), _mm256_cmpgt_epi64(lower, odd), 0xAA);
+
+  // The low 32 bits of the shifted product are the same for a logical and an arithmetic shift
+  __m256i prod = _mm256_blend_epi32(_mm256_srli_epi64(even, Type::FRACTIONAL_BITS),
+                                    _mm256_slli_epi64(odd, 32 - Type::FRACTIONAL_BITS), 0xAA);
+  prod         = _mm256_blendv_epi8(prod, _mm256_set1_epi32(Type::MAX), above);
+  prod         = _mm256_blendv_epi8(prod, _mm256_set1_epi32(Type::MIN), below);
+
+  overflow = _mm256_or_si256(above, below);
+  return prod;
+}
+
+/**
+ * Divide fp32 values by positive denominators exactly as FixedPoint<16, 16>::operator/ does, i.e.
+ * truncate the quotient (numerator << 16) / denominator towards zero, for quotients which fit in 32
+ * bits. The division is performed in double precision, which cannot round across an integer because
+ * the shifted numerator is below 2^53.
+ */
+inline __m256i DivideByPositiveFixed32(__m256i const &numerator, __m256i const &denominator)
+{
+  using Type = fixed_point::fp32_t;
+
+  __m256d const scale = _mm256_set1_pd(static_cast<double>(Type::ONE_MASK));
+  __m256d const num_lo =
+      _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(numerator)), scale);
+  __m256d const num_hi =
+      _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(numerator, 1)), scale);
+  __m256d const den_lo = _mm256_cvtepi32_pd(_mm256_castsi256_si128(denominator));
+  __m256d const den_hi = _mm256_cvtepi32_pd(_mm256_extracti128_si256(denominator, 1));
+
+  return _mm256_set_m128i(_mm256_cvttpd_epi32(_mm256_div_pd(num_hi, den_hi)),
+                          _mm256_cvttpd_epi32(_mm256_div_pd(num_lo, den_lo)));
+}
+
+/**
+ * Replace the lanes of result selected by lanes (a movemask of 32 bit lanes) with the scalar
+ * function applied to the corresponding lanes of x. The vector kernels use this for the inputs on
+ * which they do not reproduce the scalar code, which also raises the fp_state flags of those
+ * inputs.
+ */
+template <typename Function>
+inline __m256i ApplyScalarFixed32(__m256i const &x, __m256i const &result, int lanes,
+                                  Function const &function)
+{
+  using Type = fixed_point::fp32_t;
+
+  alignas(32) Type input[8];
+  alignas(32) Type output[8];
+  _mm256_store_si256(reinterpret_cast<__m256i *>(input), x);
+  _mm256_store_si256(reinterpret_cast<__m256i *>(output), result);
+
+  for (int i = 0; i < 8; ++i)
+  {
+    if ((lanes & (1 << i)) != 0)
+    {
+      output[i] = function(input[i]);
+    }
+  }
+
+  return _mm256_load_si256(reinterpret_cast<__m256i const *>(output));
+}
+
+}  // namespace details
+
 inline VectorRegister<fixed_point::fp32_t, 128> operator/(
     VectorRegister<fixed_point::fp32_t, 128> const &a,
     VectorRegister<fixed_point::fp32_t, 128> const &b)
 {
-  // TODO(private 440): AVX implementation required
+  __m128i quotient{};
+  if (details::DivideFixed32(a.data(), b.data(), quotient) == 0xF)
+  {
+    return {quotient};
+  }
+
+  // Otherwise some lane needs the special case handling (and state flags) of the scalar division
   alignas(VectorRegister<fixed_point::fp32_t, 128>::E_REGISTER_SIZE) fixed_point::fp32_t d1[4];
   a.Store(d1);
 
@@ -760,8 +885,6 @@ inline VectorRegister<fixed_point::fp32_t, 128> operator/(
 
   alignas(VectorRegister<fixed_point::fp32_t, 128>::E_REGISTER_SIZE) fixed_point::fp32_t ret[4];
 
-  // don't divide by zero
-  // set each of the 4 values in the vector register to either the solution of the division or 0
   ret[0] = d1[0] / d2[0];
   ret[1] = d1[1] / d2[1];
   ret[2] = d1[2] / d2[2];
@@ -774,7 +897,18 @@ inline VectorRegister<fixed_point::fp32_t, 256> operator/(
     VectorRegister<fixed_point::fp32_t, 256> const &a,
     VectorRegister<fixed_point::fp32_t, 256> const &b)
 {
-  // TODO(private 440): SSE implementation required
+  __m128i quotient_lo{};
+  __m128i quotient_hi{};
+  int     exact_lo = details::DivideFixed32(_mm256_castsi256_si128(a.data()),
+                                        _mm256_castsi256_si128(b.data()), quotient_lo);
+  int     exact_hi = details::DivideFixed32(_mm256_extracti128_si256(a.data(), 1),
+                                        _mm256_extracti128_si256(b.data(), 1), quotient_hi);
+  if ((exact_lo & exact_hi) == 0xF)
+  {
+    return {_mm256_set_m128i(quotient_hi, quotient_lo)};
+  }
+
+  // Otherwise some lane needs the special case handling (and state flags) of the scalar division
   alignas(VectorRegister<fixed_point::fp32_t, 256>::E_REGISTER_SIZE) fixed_point::fp32_t d1[8];
   a.Store(d1);
 
@@ -783,8 +917,6 @@ inline VectorRegister<fixed_point::fp32_t, 256> operator/(
 
   alignas(VectorRegister<fixed_point::fp32_t, 256>::E_REGISTER_SIZE) fixed_point::fp32_t ret[8];
 
-  // don't divide by zero
-  // set each of the 4 values in the vector register to either the solution of the division or 0
   for (std::size_t i = 0; i < 8; i++)
   {
     ret[i] = d1[i] / d2[i];
@@ -33,7 +33,9 @@
 namespace fetch {
 namespace vectorise {
 
+#ifndef __AVX512F__
 ADD_REGISTER_SIZE(float, 256);
+#endif
 
 template <>
 class VectorRegister<float, 128> : public BaseVectorRegisterType
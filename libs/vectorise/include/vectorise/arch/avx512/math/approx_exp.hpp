@@ -0,0 +1,82 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <immintrin.h>
+
+#include <cmath>
+#include <cstdint>
+
+// see ../register_float.hpp
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+namespace fetch {
+namespace vectorise {
+
+inline VectorRegister<float, 512> approx_exp(VectorRegister<float, 512> const &x)
+{
+  enum
+  {
+    mantissa = 23,
+    exponent = 8
+  };
+
+  constexpr auto                   multiplier      = float(1ull << mantissa);
+  constexpr float                  exponent_offset = (float(((1ull << (exponent - 1)) - 1)));
+  const VectorRegister<float, 512> a(float(multiplier / M_LN2));
+  const VectorRegister<float, 512> b(float(exponent_offset * multiplier - 60801));
+
+  VectorRegister<float, 512> y    = a * x + b;
+  __m512i                    conv = _mm512_cvtps_epi32(y.data());
+
+  auto const ret = VectorRegister<float, 512>(_mm512_castsi512_ps(conv));
+  return ret;
+}
+
+inline VectorRegister<double, 512> approx_exp(VectorRegister<double, 512> const &x)
+{
+  enum
+  {
+    mantissa = 20,
+    exponent = 11
+  };
+
+  constexpr auto                    multiplier      = double(1ull << mantissa);
+  constexpr double                  exponent_offset = (double(((1ull << (exponent - 1)) - 1)));
+  const VectorRegister<double, 512> a(double(multiplier / M_LN2));
+  const VectorRegister<double, 512> b(double(exponent_offset * multiplier - 60801));
+
+  // The approximation is built in the upper 32 bits of each double, leaving the lower bits clear
+  VectorRegister<double, 512> y    = a * x + b;
+  __m256i                     conv = _mm512_cvtpd_epi32(y.data());
+  __m512i                     bits = _mm512_slli_epi64(_mm512_cvtepi32_epi64(conv), 32);
+
+  auto const ret = VectorRegister<double, 512>(_mm512_castsi512_pd(bits));
+  return ret;
+}
+
+}  // namespace vectorise
+}  // namespace fetch
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
@@ -0,0 +1,70 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <immintrin.h>
+
+#include <cmath>
+#include <cstdint>
+
+namespace fetch {
+namespace vectorise {
+
+inline VectorRegister<float, 512> approx_log(VectorRegister<float, 512> const &x)
+{
+  enum
+  {
+    mantissa = 23,
+    exponent = 8,
+  };
+
+  constexpr auto                   multiplier      = float(1ull << mantissa);
+  constexpr float                  exponent_offset = (float(((1ull << (exponent - 1)) - 1)));
+  const VectorRegister<float, 512> a(float(M_LN2 / multiplier));
+  const VectorRegister<float, 512> b(float(exponent_offset * multiplier - 60801));
+
+  __m512i conv = _mm512_castps_si512(x.data());
+
+  VectorRegister<float, 512> y(_mm512_cvtepi32_ps(conv));
+
+  return a * (y - b);
+}
+
+inline VectorRegister<double, 512> approx_log(VectorRegister<double, 512> const &x)
+{
+  enum
+  {
+    mantissa = 20,
+    exponent = 11,
+  };
+
+  constexpr auto                    multiplier      = double(1ull << mantissa);
+  constexpr double                  exponent_offset = (double(((1ull << (exponent - 1)) - 1)));
+  const VectorRegister<double, 512> a(double(M_LN2 / multiplier));
+  const VectorRegister<double, 512> b(double(exponent_offset * multiplier - 60801));
+
+  // Inverse of approx_exp: read back the upper 32 bits of each double
+  __m512i conv = _mm512_srli_epi64(_mm512_castpd_si512(x.data()), 32);
+
+  VectorRegister<double, 512> y(_mm512_cvtepi32_pd(_mm512_cvtepi64_epi32(conv)));
+
+  return a * (y - b);
+}
+
+}  // namespace vectorise
+}  // namespace fetch
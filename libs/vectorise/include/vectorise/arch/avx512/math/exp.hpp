@@ -0,0 +1,53 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <immintrin.h>
+
+#include <cmath>
+#include <cstddef>
+
+namespace fetch {
+namespace vectorise {
+
+inline VectorRegister<float, 512> Exp(VectorRegister<float, 512> const &x)
+{
+  constexpr std::size_t size = VectorRegister<float, 512>::E_BLOCK_COUNT;
+  alignas(64) float     A[size];
+  x.Store(A);
+  for (auto &val : A)
+  {
+    val = static_cast<float>(std::exp(static_cast<double>(val)));
+  }
+  return {A};
+}
+
+inline VectorRegister<double, 512> Exp(VectorRegister<double, 512> const &x)
+{
+  constexpr std::size_t size = VectorRegister<double, 512>::E_BLOCK_COUNT;
+  alignas(64) double    A[size];
+  x.Store(A);
+  for (auto &val : A)
+  {
+    val = std::exp(val);
+  }
+  return {A};
+}
+
+}  // namespace vectorise
+}  // namespace fetch
@@ -0,0 +1,25 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/arch/avx512/math/abs.hpp"
+#include "vectorise/arch/avx512/math/approx_exp.hpp"
+#include "vectorise/arch/avx512/math/approx_log.hpp"
+#include "vectorise/arch/avx512/math/approx_reciprocal.hpp"
+#include "vectorise/arch/avx512/math/exp.hpp"
+#include "vectorise/arch/avx512/math/sqrt.hpp"
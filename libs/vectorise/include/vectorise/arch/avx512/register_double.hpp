@@ -0,0 +1,242 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <immintrin.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+
+// see register_float.hpp
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+namespace fetch {
+namespace vectorise {
+
+ADD_REGISTER_SIZE(double, 512);
+
+template <>
+class VectorRegister<double, 512> : public BaseVectorRegisterType
+{
+public:
+  using type           = double;
+  using MMRegisterType = __m512d;
+  using MaskType       = __mmask8;
+
+  enum
+  {
+    E_VECTOR_SIZE   = 512,
+    E_REGISTER_SIZE = sizeof(MMRegisterType),
+    E_BLOCK_COUNT   = E_REGISTER_SIZE / sizeof(type)
+  };
+
+  static_assert((E_BLOCK_COUNT * sizeof(type)) == E_REGISTER_SIZE,
+                "type cannot be contained in the given register size.");
+
+  VectorRegister() = default;
+  VectorRegister(type const *d)  // NOLINT
+  {
+    data_ = _mm512_load_pd(d);
+  }
+  VectorRegister(std::initializer_list<type> const &list)
+  {
+    data_ = _mm512_loadu_pd(reinterpret_cast<type const *>(list.begin()));
+  }
+  VectorRegister(MMRegisterType const &d)  // NOLINT
+    : data_(d)
+  {}
+  VectorRegister(MMRegisterType &&d)  // NOLINT
+    : data_(d)
+  {}
+  VectorRegister(type const &c)  // NOLINT
+  {
+    data_ = _mm512_set1_pd(c);
+  }
+
+  explicit operator MMRegisterType()
+  {
+    return data_;
+  }
+
+  /**
+   * Returns the mask selecting the lanes in the half open interval [from, to)
+   */
+  static MaskType LaneMask(std::size_t from, std::size_t to)
+  {
+    return static_cast<MaskType>(((1u << to) - 1u) & ~((1u << from) - 1u));
+  }
+
+  /**
+   * Loads the lanes selected by the mask, zeroing the others. Memory behind unselected lanes is
+   * never accessed.
+   */
+  void Load(type const *ptr, MaskType mask)
+  {
+    data_ = _mm512_maskz_loadu_pd(mask, ptr);
+  }
+
+  void Store(type *ptr) const
+  {
+    _mm512_store_pd(ptr, data_);
+  }
+  void Store(type *ptr, MaskType mask) const
+  {
+    _mm512_mask_storeu_pd(ptr, mask, data_);
+  }
+  void Stream(type *ptr) const
+  {
+    _mm512_stream_pd(ptr, data_);
+  }
+
+  MMRegisterType const &data() const
+  {
+    return data_;
+  }
+  MMRegisterType &data()
+  {
+    return data_;
+  }
+
+private:
+  MMRegisterType data_;
+};
+
+template <>
+struct HasMaskedAccess<VectorRegister<double, 512>> : std::true_type
+{
+};
+
+template <>
+inline std::ostream &operator<<(std::ostream &s, VectorRegister<double, 512> const &n)
+{
+  alignas(64) double out[8];
+  n.Store(out);
+  s << std::setprecision(std::numeric_limits<double>::digits10);
+  s << out[0];
+  for (std::size_t i = 1; i < 8; ++i)
+  {
+    s << ", " << out[i];
+  }
+
+  return s;
+}
+
+inline VectorRegister<double, 512> operator-(VectorRegister<double, 512> const &x)
+{
+  return {_mm512_sub_pd(_mm512_setzero_pd(), x.data())};
+}
+
+#define FETCH_ADD_OPERATOR(op, type, size, L, fnc)                                   \
+  inline VectorRegister<type, size> operator op(VectorRegister<type, size> const &a, \
+                                                VectorRegister<type, size> const &b) \
+  {                                                                                  \
+    L ret = fnc(a.data(), b.data());                                                 \
+    return {ret};                                                                    \
+  }
+
+FETCH_ADD_OPERATOR(*, double, 512, __m512d, _mm512_mul_pd)
+FETCH_ADD_OPERATOR(-, double, 512, __m512d, _mm512_sub_pd)
+FETCH_ADD_OPERATOR(/, double, 512, __m512d, _mm512_div_pd)
+FETCH_ADD_OPERATOR(+, double, 512, __m512d, _mm512_add_pd)
+
+#undef FETCH_ADD_OPERATOR
+
+// AVX-512 comparisons produce a bit mask, which is expanded back to a register of all ones / all
+// zeros lanes to match the other register types
+#define FETCH_ADD_OPERATOR(op, type, fnc)                                              \
+  inline VectorRegister<type, 512> operator op(VectorRegister<type, 512> const &a,     \
+                                               VectorRegister<type, 512> const &b)     \
+  {                                                                                    \
+    __mmask8 mask = _mm512_cmp_pd_mask(a.data(), b.data(), fnc);                       \
+    return {_mm512_castsi512_pd(_mm512_maskz_mov_epi64(mask, _mm512_set1_epi64(-1)))}; \
+  }
+
+FETCH_ADD_OPERATOR(==, double, _CMP_EQ_OQ)
+FETCH_ADD_OPERATOR(!=, double, _CMP_NEQ_UQ)
+FETCH_ADD_OPERATOR(>=, double, _CMP_GE_OQ)
+FETCH_ADD_OPERATOR(>, double, _CMP_GT_OQ)
+FETCH_ADD_OPERATOR(<=, double, _CMP_LE_OQ)
+FETCH_ADD_OPERATOR(<, double, _CMP_LT_OQ)
+
+#undef FETCH_ADD_OPERATOR
+
+/**
+ * Selects the lanes of b where the mask is set and the lanes of a elsewhere
+ */
+inline VectorRegister<double, 512> Blend(__mmask8 mask, VectorRegister<double, 512> const &a,
+                                         VectorRegister<double, 512> const &b)
+{
+  return {_mm512_mask_blend_pd(mask, a.data(), b.data())};
+}
+
+template <int32_t elements>
+VectorRegister<double, 512> rotate_elements_left(VectorRegister<double, 512> const &x)
+{
+  __m512i n = _mm512_castpd_si512(x.data());
+  n         = _mm512_alignr_epi64(n, n, elements & 7);
+  return {_mm512_castsi512_pd(n)};
+}
+
+inline double first_element(VectorRegister<double, 512> const &x)
+{
+  return _mm_cvtsd_f64(_mm512_castpd512_pd128(x.data()));
+}
+
+inline double reduce(VectorRegister<double, 512> const &x)
+{
+  VectorRegister<double, 256> hi{_mm512_extractf64x4_pd(x.data(), 1)};
+  VectorRegister<double, 256> lo{_mm512_castpd512_pd256(x.data())};
+  hi = hi + lo;
+  return reduce(hi);
+}
+
+inline bool all_less_than(VectorRegister<double, 512> const &x,
+                          VectorRegister<double, 512> const &y)
+{
+  return _mm512_cmp_pd_mask(x.data(), y.data(), _CMP_LT_OQ) == 0xFF;
+}
+
+inline bool any_less_than(VectorRegister<double, 512> const &x,
+                          VectorRegister<double, 512> const &y)
+{
+  return _mm512_cmp_pd_mask(x.data(), y.data(), _CMP_LT_OQ) != 0;
+}
+
+inline bool all_equal_to(VectorRegister<double, 512> const &x, VectorRegister<double, 512> const &y)
+{
+  return _mm512_cmp_pd_mask(x.data(), y.data(), _CMP_EQ_OQ) == 0xFF;
+}
+
+inline bool any_equal_to(VectorRegister<double, 512> const &x, VectorRegister<double, 512> const &y)
+{
+  return _mm512_cmp_pd_mask(x.data(), y.data(), _CMP_EQ_OQ) != 0;
+}
+
+}  // namespace vectorise
+}  // namespace fetch
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
@@ -0,0 +1,242 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <immintrin.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+
+// GCC passes _mm512_undefined_* (a self-initialised value) as the pass-through operand of the
+// unmasked intrinsics, which -W(maybe-)uninitialized reports wherever they are inlined
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+namespace fetch {
+namespace vectorise {
+
+ADD_REGISTER_SIZE(float, 512);
+
+template <>
+class VectorRegister<float, 512> : public BaseVectorRegisterType
+{
+public:
+  using type           = float;
+  using MMRegisterType = __m512;
+  using MaskType       = __mmask16;
+
+  enum
+  {
+    E_VECTOR_SIZE   = 512,
+    E_REGISTER_SIZE = sizeof(MMRegisterType),
+    E_BLOCK_COUNT   = E_REGISTER_SIZE / sizeof(type)
+  };
+
+  static_assert((E_BLOCK_COUNT * sizeof(type)) == E_REGISTER_SIZE,
+                "type cannot be contained in the given register size.");
+
+  VectorRegister() = default;
+  VectorRegister(type const *d)  // NOLINT
+  {
+    data_ = _mm512_load_ps(d);
+  }
+  VectorRegister(std::initializer_list<type> const &list)
+  {
+    data_ = _mm512_loadu_ps(reinterpret_cast<type const *>(list.begin()));
+  }
+  VectorRegister(MMRegisterType const &d)  // NOLINT
+    : data_(d)
+  {}
+  VectorRegister(MMRegisterType &&d)  // NOLINT
+    : data_(d)
+  {}
+  VectorRegister(type const &c)  // NOLINT
+  {
+    data_ = _mm512_set1_ps(c);
+  }
+
+  explicit operator MMRegisterType()
+  {
+    return data_;
+  }
+
+  /**
+   * Returns the mask selecting the lanes in the half open interval [from, to)
+   */
+  static MaskType LaneMask(std::size_t from, std::size_t to)
+  {
+    return static_cast<MaskType>(((1u << to) - 1u) & ~((1u << from) - 1u));
+  }
+
+  /**
+   * Loads the lanes selected by the mask, zeroing the others. Memory behind unselected lanes is
+   * never accessed.
+   */
+  void Load(type const *ptr, MaskType mask)
+  {
+    data_ = _mm512_maskz_loadu_ps(mask, ptr);
+  }
+
+  void Store(type *ptr) const
+  {
+    _mm512_store_ps(ptr, data_);
+  }
+  void Store(type *ptr, MaskType mask) const
+  {
+    _mm512_mask_storeu_ps(ptr, mask, data_);
+  }
+  void Stream(type *ptr) const
+  {
+    _mm512_stream_ps(ptr, data_);
+  }
+
+  MMRegisterType const &data() const
+  {
+    return data_;
+  }
+  MMRegisterType &data()
+  {
+    return data_;
+  }
+
+private:
+  MMRegisterType data_;
+};
+
+template <>
+struct HasMaskedAccess<VectorRegister<float, 512>> : std::true_type
+{
+};
+
+template <>
+inline std::ostream &operator<<(std::ostream &s, VectorRegister<float, 512> const &n)
+{
+  alignas(64) float out[16];
+  n.Store(out);
+  s << std::setprecision(std::numeric_limits<float>::digits10);
+  s << out[0];
+  for (std::size_t i = 1; i < 16; ++i)
+  {
+    s << ", " << out[i];
+  }
+
+  return s;
+}
+
+inline VectorRegister<float, 512> operator-(VectorRegister<float, 512> const &x)
+{
+  return {_mm512_sub_ps(_mm512_setzero_ps(), x.data())};
+}
+
+#define FETCH_ADD_OPERATOR(op, type, size, L, fnc)                                   \
+  inline VectorRegister<type, size> operator op(VectorRegister<type, size> const &a, \
+                                                VectorRegister<type, size> const &b) \
+  {                                                                                  \
+    L ret = fnc(a.data(), b.data());                                                 \
+    return {ret};                                                                    \
+  }
+
+FETCH_ADD_OPERATOR(*, float, 512, __m512, _mm512_mul_ps)
+FETCH_ADD_OPERATOR(-, float, 512, __m512, _mm512_sub_ps)
+FETCH_ADD_OPERATOR(/, float, 512, __m512, _mm512_div_ps)
+FETCH_ADD_OPERATOR(+, float, 512, __m512, _mm512_add_ps)
+
+#undef FETCH_ADD_OPERATOR
+
+// AVX-512 comparisons produce a bit mask, which is expanded back to a register of all ones / all
+// zeros lanes to match the other register types
+#define FETCH_ADD_OPERATOR(op, type, fnc)                                              \
+  inline VectorRegister<type, 512> operator op(VectorRegister<type, 512> const &a,     \
+                                               VectorRegister<type, 512> const &b)     \
+  {                                                                                    \
+    __mmask16 mask = _mm512_cmp_ps_mask(a.data(), b.data(), fnc);                      \
+    return {_mm512_castsi512_ps(_mm512_maskz_mov_epi32(mask, _mm512_set1_epi32(-1)))}; \
+  }
+
+FETCH_ADD_OPERATOR(==, float, _CMP_EQ_OQ)
+FETCH_ADD_OPERATOR(!=, float, _CMP_NEQ_UQ)
+FETCH_ADD_OPERATOR(>=, float, _CMP_GE_OQ)
+FETCH_ADD_OPERATOR(>, float, _CMP_GT_OQ)
+FETCH_ADD_OPERATOR(<=, float, _CMP_LE_OQ)
+FETCH_ADD_OPERATOR(<, float, _CMP_LT_OQ)
+
+#undef FETCH_ADD_OPERATOR
+
+/**
+ * Selects the lanes of b where the mask is set and the lanes of a elsewhere
+ */
+inline VectorRegister<float, 512> Blend(__mmask16 mask, VectorRegister<float, 512> const &a,
+                                        VectorRegister<float, 512> const &b)
+{
+  return {_mm512_mask_blend_ps(mask, a.data(), b.data())};
+}
+
+template <int32_t elements>
+VectorRegister<float, 512> rotate_elements_left(VectorRegister<float, 512> const &x)
+{
+  __m512i n = _mm512_castps_si512(x.data());
+  n         = _mm512_alignr_epi32(n, n, elements & 15);
+  return {_mm512_castsi512_ps(n)};
+}
+
+inline float first_element(VectorRegister<float, 512> const &x)
+{
+  return _mm_cvtss_f32(_mm512_castps512_ps128(x.data()));
+}
+
+inline float reduce(VectorRegister<float, 512> const &x)
+{
+  VectorRegister<float, 256> hi{
+      _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(x.data()), 1))};
+  VectorRegister<float, 256> lo{_mm512_castps512_ps256(x.data())};
+  hi = hi + lo;
+  return reduce(hi);
+}
+
+inline bool all_less_than(VectorRegister<float, 512> const &x, VectorRegister<float, 512> const &y)
+{
+  return _mm512_cmp_ps_mask(x.data(), y.data(), _CMP_LT_OQ) == 0xFFFF;
+}
+
+inline bool any_less_than(VectorRegister<float, 512> const &x, VectorRegister<float, 512> const &y)
+{
+  return _mm512_cmp_ps_mask(x.data(), y.data(), _CMP_LT_OQ) != 0;
+}
+
+inline bool all_equal_to(VectorRegister<float, 512> const &x, VectorRegister<float, 512> const &y)
+{
+  return _mm512_cmp_ps_mask(x.data(), y.data(), _CMP_EQ_OQ) == 0xFFFF;
+}
+
+inline bool any_equal_to(VectorRegister<float, 512> const &x, VectorRegister<float, 512> const &y)
+{
+  return _mm512_cmp_ps_mask(x.data(), y.data(), _CMP_EQ_OQ) != 0;
+}
+
+}  // namespace vectorise
+}  // namespace fetch
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
@@ -240,7 +240,8 @@ public:
     STATE_OVERFLOW         = 1 << 3,
     STATE_INFINITY         = 1 << 4,
   };
-  static uint32_t fp_state;
+  /// Accumulated state of the operations performed by the current thread
+  static thread_local uint32_t fp_state;
 
   static constexpr void StateClear();
   static constexpr bool IsState(uint32_t state);
@@ -603,7 +604,7 @@ std::function<FixedPoint<I, F>(FixedPoint<I, F> const &x)>
         [](FixedPoint<I, F> const &x) { return FixedPoint<I, F>::SinPi2(x); }};
 
 template <uint16_t I, uint16_t F>
-uint32_t FixedPoint<I, F>::fp_state{FixedPoint<I, F>::STATE_OK};
+thread_local uint32_t FixedPoint<I, F>::fp_state{FixedPoint<I, F>::STATE_OK};
 
 template <>
 constexpr FixedPoint<64, 64> &FixedPoint<64, 64>::operator*=(FixedPoint<64, 64> const &n);
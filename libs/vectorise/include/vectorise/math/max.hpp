@@ -21,6 +21,9 @@
 #ifdef __AVX2__
 #include "vectorise/arch/avx2/math/max.hpp"
 #endif
+#ifdef __AVX512F__
+#include "vectorise/arch/avx512/math/max.hpp"
+#endif
 
 #include <cmath>
 #include <cstddef>
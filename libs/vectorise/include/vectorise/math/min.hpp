@@ -21,6 +21,9 @@
 #ifdef __AVX2__
 #include "vectorise/arch/avx2/math/min.hpp"
 #endif
+#ifdef __AVX512F__
+#include "vectorise/arch/avx512/math/min.hpp"
+#endif
 
 #include <cmath>
 #include <cstddef>
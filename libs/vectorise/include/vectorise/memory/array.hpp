@@ -55,7 +55,7 @@ public:
 
     if (n > 0)
     {
-      this->pointer_ = reinterpret_cast<type *>(_mm_malloc(this->padded_size() * sizeof(type), 32));
+      this->pointer_ = reinterpret_cast<type *>(_mm_malloc(this->padded_size() * sizeof(type), 64));
     }
   }
 
@@ -99,7 +99,7 @@ public:
 
     if (this->size_ > 0)
     {
-      this->pointer_ = reinterpret_cast<type *>(_mm_malloc(this->padded_size() * sizeof(type), 32));
+      this->pointer_ = reinterpret_cast<type *>(_mm_malloc(this->padded_size() * sizeof(type), 64));
     }
 
     for (std::size_t i = 0; i < this->size_; ++i)
@@ -0,0 +1,67 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+#include <functional>
+
+namespace fetch {
+namespace memory {
+
+/**
+ * Worker pool shared by all parallel dispatchers. Operations over ranges of at least threshold()
+ * elements are split into chunks of CHUNK_SIZE elements which are processed by the calling thread
+ * together with the workers of the pool.
+ *
+ * Chunk boundaries are multiples of CHUNK_SIZE, independent of the number of threads, so that
+ * reductions which combine the chunks in order give the same result on every machine.
+ */
+class DispatchPool
+{
+public:
+  static constexpr std::size_t CHUNK_SIZE        = std::size_t{1} << 15;
+  static constexpr std::size_t DEFAULT_THRESHOLD = std::size_t{1} << 18;
+
+  using ChunkFunction = std::function<void(std::size_t)>;
+
+  /**
+   * The minimum number of elements for an operation to be split across threads
+   */
+  static std::size_t threshold();
+
+  /**
+   * Sets the minimum number of elements for an operation to be split across threads. Passing
+   * std::numeric_limits<std::size_t>::max() keeps every operation on the calling thread.
+   */
+  static void SetThreshold(std::size_t elements);
+
+  /**
+   * The number of threads an operation is split across, including the calling thread
+   */
+  static std::size_t concurrency();
+
+  /**
+   * Calls the function once for every chunk index in [0, count) and returns when all calls have
+   * completed. Calls made from one of the workers run on that worker alone, so that nested
+   * operations can not exhaust the pool. The first exception thrown by the function is rethrown.
+   */
+  static void Run(std::size_t count, ChunkFunction const &function);
+};
+
+}  // namespace memory
+}  // namespace fetch
@@ -18,14 +18,77 @@
 //------------------------------------------------------------------------------
 
 #include "vectorise/memory/details.hpp"
+#include "vectorise/memory/dispatch_pool.hpp"
 #include "vectorise/memory/range.hpp"
 #include "vectorise/platform.hpp"
 #include "vectorise/vectorise.hpp"
 
+#include <algorithm>
+#include <cstdint>
 #include <type_traits>
+#include <vector>
 
 namespace fetch {
 namespace memory {
+namespace details {
+
+/**
+ * Fixed point operations record overflow, infinity and NaN in a thread local state. Chunks which
+ * are processed by the dispatch pool take their state with them, so that it can be handed back to
+ * the calling thread.
+ */
+template <typename T, typename = void>
+struct ThreadState
+{
+  static uint32_t Take()
+  {
+    return 0;
+  }
+
+  static void Merge(uint32_t /*state*/)
+  {}
+};
+
+template <typename T>
+struct ThreadState<T, math::meta::IfIsFixedPoint<T>>
+{
+  static uint32_t Take()
+  {
+    uint32_t const state = T::fp_state;
+    T::StateClear();
+    return state;
+  }
+
+  static void Merge(uint32_t state)
+  {
+    T::fp_state |= state;
+  }
+};
+
+}  // namespace details
+
+/**
+ * Calls the function for every index in [0, count) on the dispatch pool. The fixed point state of
+ * type T which the calls record is handed back to the calling thread.
+ */
+template <typename T, typename F>
+void DispatchChunks(std::size_t count, F &&function)
+{
+  using State = details::ThreadState<T>;
+
+  std::vector<uint32_t> states(count);
+  DispatchPool::Run(count, [&function, &states](std::size_t index) {
+    uint32_t const previous = State::Take();
+    function(index);
+    states[index] = State::Take();
+    State::Merge(previous);
+  });
+
+  for (uint32_t const state : states)
+  {
+    State::Merge(state);
+  }
+}
 
 template <typename T>
 class ConstParallelDispatcher
@@ -43,6 +106,10 @@ public:
   using ScalarRegisterType         = typename vectorise::VectorRegister<type, scalar_size>;
   using ScalarRegisterIteratorType = vectorise::VectorRegisterIterator<type, scalar_size>;
 
+  /// Whether partially covered blocks are processed with masked register operations rather than
+  /// with a scalar head and tail
+  using MaskedTailType = typename vectorise::HasMaskedAccess<VectorRegisterType>::type;
+
   template <std::size_t S>
   using vector_kernel_signature_type = std::function<vectorise::VectorRegister<type, S>(
       vectorise::VectorRegister<type, S> const, vectorise::VectorRegister<type, S> const)>;
@@ -99,14 +166,169 @@ public:
                           VectorRegisterIteratorType * /*iters*/)
   {}
 
+  /**
+   * Invokes the function for each of the (at most two) register blocks which the range covers only
+   * partially, passing the offset of the block and the mask of its lanes inside the range. The
+   * range must not be empty.
+   */
+  template <typename F>
+  static void ForEachPartialBlock(Range const &range, F &&function)
+  {
+    std::size_t const block = VectorRegisterType::E_BLOCK_COUNT;
+    std::size_t const first = range.SIMDFromLower<VectorRegisterType::E_BLOCK_COUNT>();
+    std::size_t const last  = range.SIMDToUpper<VectorRegisterType::E_BLOCK_COUNT>() - block;
+
+    if ((first < range.from()) || (first + block > range.to()))
+    {
+      function(first, VectorRegisterType::LaneMask(range.from() - first,
+                                                   std::min(range.to(), first + block) - first));
+    }
+
+    if ((last != first) && (last + block > range.to()))
+    {
+      function(last, VectorRegisterType::LaneMask(0, range.to() - last));
+    }
+  }
+
+  /**
+   * A range which lies inside a single block has no aligned part. The bounds of the aligned part
+   * are then moved to the end of the range, so that the scalar head covers all of it.
+   */
+  static void ClampBlockBounds(Range const &range, std::size_t &SF, std::size_t &ST)
+  {
+    if (SF > ST)
+    {
+      SF = ST = range.to();
+    }
+  }
+
+  static std::size_t ChunkCount(Range const &range)
+  {
+    if (range.from() >= range.to())
+    {
+      return 0;
+    }
+
+    return ((range.to() - 1) / DispatchPool::CHUNK_SIZE) -
+           (range.from() / DispatchPool::CHUNK_SIZE) + 1;
+  }
+
+  /**
+   * Invokes the function with the index and the subrange of every chunk the range covers. Ranges
+   * of at least DispatchPool::threshold() elements are processed on the threads of the dispatch
+   * pool, in which case the function is called concurrently for different chunks.
+   */
+  template <typename F>
+  static void ForEachChunk(Range const &range, F &&function)
+  {
+    std::size_t const count = ChunkCount(range);
+    std::size_t const first = range.from() / DispatchPool::CHUNK_SIZE;
+
+    auto const invoke = [&range, &function, first](std::size_t index) {
+      std::size_t const offset = (first + index) * DispatchPool::CHUNK_SIZE;
+      function(index, Range(std::max(range.from(), offset),
+                            std::min(range.to(), offset + DispatchPool::CHUNK_SIZE)));
+    };
+
+    if ((count > 1) && (range.to() - range.from() >= DispatchPool::threshold()))
+    {
+      DispatchChunks<type>(count, invoke);
+      return;
+    }
+
+    for (std::size_t index = 0; index < count; ++index)
+    {
+      invoke(index);
+    }
+  }
+
+  /**
+   * Reduces every chunk of the range and combines the partial results in chunk order. The chunks
+   * do not depend on the threshold or on the number of threads, and neither does the result.
+   */
+  template <typename R, typename C>
+  static type ChunkedReduce(Range const &range, R &&reduction, C &&combine)
+  {
+    if (ChunkCount(range) <= 1)
+    {
+      return reduction(range);
+    }
+
+    std::vector<type> partials(ChunkCount(range));
+    ForEachChunk(range, [&partials, &reduction](std::size_t index, Range const &chunk) {
+      partials[index] = reduction(chunk);
+    });
+
+    type ret = partials.front();
+    for (std::size_t i = 1; i < partials.size(); ++i)
+    {
+      ret = combine(ret, partials[i]);
+    }
+
+    return ret;
+  }
+
+  template <typename M>
+  static void LoadMasked(std::size_t offset, M const &mask, type const *const *pointers,
+                         VectorRegisterType *regs, std::size_t count)
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      regs[i].Load(pointers[i] + offset, mask);
+    }
+  }
+
   template <class OP, class F1, class F2>
   type GenericRangedOpReduce(Range const &range, type const initial_value, OP &&op,
                              F1 const &&kernel, F2 &&hkernel)
+  {
+    return ChunkedReduce(
+        range,
+        [&](Range const &chunk) {
+          return GenericRangedOpReduce(chunk, initial_value, op, std::move(kernel), hkernel,
+                                       MaskedTailType{});
+        },
+        [&op](type const &a, type const &b) { return static_cast<type>(op(a, b)); });
+  }
+
+  template <class OP, class F1, class F2>
+  type GenericRangedOpReduce(Range const &range, type const initial_value, OP &&op,
+                             F1 const &&kernel, F2 &&hkernel, std::true_type /*masked_tail*/)
+  {
+    std::size_t SF = range.SIMDFromUpper<VectorRegisterType::E_BLOCK_COUNT>();
+    std::size_t ST = range.SIMDToLower<VectorRegisterType::E_BLOCK_COUNT>();
+
+    type ret{initial_value};
+    if (range.from() >= range.to())
+    {
+      return ret;
+    }
+
+    VectorRegisterType va, vc(initial_value);
+    for (std::size_t i = SF; i < ST; i += VectorRegisterType::E_BLOCK_COUNT)
+    {
+      va = VectorRegisterType(this->pointer() + i);
+      vc = op(vc, kernel(va));
+    }
+
+    ForEachPartialBlock(range, [&](std::size_t offset, auto const &mask) {
+      va.Load(this->pointer() + offset, mask);
+      vc = Blend(mask, vc, op(vc, kernel(va)));
+    });
+
+    return static_cast<type>(ret + hkernel(vc));
+  }
+
+  template <class OP, class F1, class F2>
+  type GenericRangedOpReduce(Range const &range, type const initial_value, OP &&op,
+                             F1 const &&kernel, F2 &&hkernel, std::false_type /*masked_tail*/)
   {
     std::size_t SF  = range.SIMDFromUpper<VectorRegisterType::E_BLOCK_COUNT>();
     std::size_t ST  = range.SIMDToLower<VectorRegisterType::E_BLOCK_COUNT>();
     std::size_t STU = range.SIMDToUpper<VectorRegisterType::E_BLOCK_COUNT>();
 
+    ClampBlockBounds(range, SF, ST);
+
     type                       ret{initial_value};
     VectorRegisterType         va, vc(initial_value);
     VectorRegisterIteratorType iter(this->pointer() + SF, STU);
@@ -114,7 +336,7 @@ public:
 
     if (SF != range.from())
     {
-      ScalarRegisterIteratorType scalar_iter(this->pointer() + range.from(), SF);
+      ScalarRegisterIteratorType scalar_iter(this->pointer() + range.from(), SF - range.from());
       ScalarRegisterType         a, tmp;
 
       while (static_cast<void const *>(scalar_iter.pointer()) <
@@ -181,16 +403,73 @@ public:
   template <class F1, class F2, class OP, typename... Args>
   type GenericRangedReduceMultiple(Range const &range, type const c, OP const &&op,
                                    F1 const &&kernel, F2 &&hkernel, Args &&... args)
+  {
+    return ChunkedReduce(
+        range,
+        [&](Range const &chunk) {
+          return GenericRangedReduceMultiple(chunk, c, std::move(op), std::move(kernel), hkernel,
+                                             MaskedTailType{}, args...);
+        },
+        [&op](type const &a, type const &b) { return static_cast<type>(op(a, b)); });
+  }
+
+  template <class F1, class F2, class OP, typename... Args>
+  type GenericRangedReduceMultiple(Range const &range, type const c, OP const &&op,
+                                   F1 const &&kernel, F2 &&hkernel, std::true_type /*masked_tail*/,
+                                   Args &&... args)
+  {
+    std::size_t SF = range.SIMDFromUpper<VectorRegisterType::E_BLOCK_COUNT>();
+    std::size_t ST = range.SIMDToLower<VectorRegisterType::E_BLOCK_COUNT>();
+
+    type ret{0};
+    if (range.from() >= range.to())
+    {
+      return ret;
+    }
+
+    VectorRegisterType regs[sizeof...(args)];
+    type const *       pointers[sizeof...(args)];
+    VectorRegisterType vc(c), self;
+    SetPointers(0, range.to(), pointers, std::forward<Args>(args)...);
+
+    for (std::size_t i = SF; i < ST; i += VectorRegisterType::E_BLOCK_COUNT)
+    {
+      for (std::size_t j = 0; j < sizeof...(args); ++j)
+      {
+        regs[j] = VectorRegisterType(pointers[j] + i);
+      }
+      self = VectorRegisterType(this->pointer() + i);
+      vc   = op(vc, details::MatrixReduceFreeFunction<VectorRegisterType>::template Unroll<
+                        Args...>::Apply(self, regs, kernel));
+    }
+
+    ForEachPartialBlock(range, [&](std::size_t offset, auto const &mask) {
+      LoadMasked(offset, mask, pointers, regs, sizeof...(args));
+      self.Load(this->pointer() + offset, mask);
+      vc = Blend(mask, vc,
+                 op(vc, details::MatrixReduceFreeFunction<VectorRegisterType>::template Unroll<
+                            Args...>::Apply(self, regs, kernel)));
+    });
+
+    return static_cast<type>(ret + hkernel(vc));
+  }
+
+  template <class F1, class F2, class OP, typename... Args>
+  type GenericRangedReduceMultiple(Range const &range, type const c, OP const &&op,
+                                   F1 const &&kernel, F2 &&hkernel, std::false_type /*masked_tail*/,
+                                   Args &&... args)
   {
     std::size_t SF  = range.SIMDFromUpper<VectorRegisterType::E_BLOCK_COUNT>();
     std::size_t ST  = range.SIMDToLower<VectorRegisterType::E_BLOCK_COUNT>();
     std::size_t STU = range.SIMDToUpper<VectorRegisterType::E_BLOCK_COUNT>();
 
+    ClampBlockBounds(range, SF, ST);
+
     VectorRegisterType         regs[sizeof...(args)];
     VectorRegisterIteratorType iters[sizeof...(args)];
-    VectorRegisterIteratorType self_iter(this->pointer() + SF, ST);
+    VectorRegisterIteratorType self_iter(this->pointer() + SF, ST - SF);
     VectorRegisterType         vc(c), tmp, self;
-    InitializeVectorIterators<vector_size>(SF, ST, iters, std::forward<Args>(args)...);
+    InitializeVectorIterators<vector_size>(SF, ST - SF, iters, std::forward<Args>(args)...);
 
     // Taking care of head
     type ret{0};
@@ -198,9 +477,10 @@ public:
     {
       ScalarRegisterType         scalar_regs[sizeof...(args)];
       ScalarRegisterIteratorType scalar_iters[sizeof...(args)];
-      ScalarRegisterIteratorType scalar_self_iter(this->pointer() + range.from(), SF);
+      ScalarRegisterIteratorType scalar_self_iter(this->pointer() + range.from(),
+                                                  SF - range.from());
       ScalarRegisterType         scalar_self, scalar_tmp;
-      InitializeVectorIterators<scalar_size>(range.from(), SF, scalar_iters,
+      InitializeVectorIterators<scalar_size>(range.from(), SF - range.from(), scalar_iters,
                                              std::forward<Args>(args)...);
 
       while (static_cast<void const *>(scalar_self_iter.pointer()) <
@@ -282,21 +562,86 @@ public:
         [](VectorRegisterType const &a) -> type { return reduce(a); }, std::forward<Args>(args)...);
   }
 
+  /**
+   * Reduces the range with kernel(element, accumulator) and folds the lanes of the accumulator
+   * with hkernel. The partial results of the chunks of a large range are combined with the kernel
+   * as well, so the kernel must be commutative and associative (e.g. a + b or Max(a, b)). Kernels
+   * which treat their arguments differently, such as acc + x * x, must use the overload taking a
+   * combine function.
+   */
   template <class F1, class F2>
   type Reduce(Range const &range, F1 const &&kernel, F2 &&hkernel,
               type const initial_value = type(0))
+  {
+    return Reduce(range, std::move(kernel), hkernel,
+                  [&kernel](type const &a, type const &b) {
+                    return static_cast<type>(
+                        kernel(ScalarRegisterType(b), ScalarRegisterType(a)).data());
+                  },
+                  initial_value);
+  }
+
+  /**
+   * As above, with combine(a, b) merging the partial results of consecutive chunks. The initial
+   * value is broadcast to every lane, so it must be neutral for the kernel and each chunk can
+   * start from it.
+   */
+  template <class F1, class F2, class F3>
+  type Reduce(Range const &range, F1 const &&kernel, F2 &&hkernel, F3 &&combine,
+              type const initial_value)
+  {
+    return ChunkedReduce(
+        range,
+        [&](Range const &chunk) {
+          return Reduce(chunk, std::move(kernel), hkernel, initial_value, MaskedTailType{});
+        },
+        std::forward<F3>(combine));
+  }
+
+  template <class F1, class F2>
+  type Reduce(Range const &range, F1 const &&kernel, F2 &&hkernel, type const initial_value,
+              std::true_type /*masked_tail*/)
+  {
+    std::size_t SF = range.SIMDFromUpper<VectorRegisterType::E_BLOCK_COUNT>();
+    std::size_t ST = range.SIMDToLower<VectorRegisterType::E_BLOCK_COUNT>();
+
+    if (range.from() >= range.to())
+    {
+      return initial_value;
+    }
+
+    VectorRegisterType va, vc(initial_value);
+    for (std::size_t i = SF; i < ST; i += VectorRegisterType::E_BLOCK_COUNT)
+    {
+      va = VectorRegisterType(this->pointer() + i);
+      vc = kernel(va, vc);
+    }
+
+    ForEachPartialBlock(range, [&](std::size_t offset, auto const &mask) {
+      va.Load(this->pointer() + offset, mask);
+      vc = Blend(mask, vc, kernel(va, vc));
+    });
+
+    return hkernel(vc);
+  }
+
+  template <class F1, class F2>
+  type Reduce(Range const &range, F1 const &&kernel, F2 &&hkernel, type const initial_value,
+              std::false_type /*masked_tail*/)
   {
     std::size_t SF  = range.SIMDFromUpper<VectorRegisterType::E_BLOCK_COUNT>();
     std::size_t ST  = range.SIMDToLower<VectorRegisterType::E_BLOCK_COUNT>();
     std::size_t STU = range.SIMDToUpper<VectorRegisterType::E_BLOCK_COUNT>();
 
+    ClampBlockBounds(range, SF, ST);
+
     VectorRegisterType         va, vc(initial_value);
     VectorRegisterIteratorType iter(this->pointer() + SF, range.to() - SF);
     ScalarRegisterType         c(initial_value);
 
     if (SF != range.from())
     {
-      ScalarRegisterIteratorType scalar_iter(this->pointer() + range.from(), SF);
+      ScalarRegisterIteratorType scalar_iter(this->pointer() + range.from(), SF - range.from());
       ScalarRegisterType         a;
 
       while (static_cast<void const *>(scalar_iter.pointer()) <
@@ -305,7 +650,12 @@ public:
         scalar_iter.Next(a);
         c = kernel(a, c);
       }
-      vc = VectorRegisterType(c.data());
+
+      // the head goes into a single lane, so that hkernel counts it once
+      alignas(VectorRegisterType::E_REGISTER_SIZE) type lanes[VectorRegisterType::E_BLOCK_COUNT];
+      std::fill(lanes, lanes + VectorRegisterType::E_BLOCK_COUNT, initial_value);
+      lanes[0] = c.data();
+      vc       = VectorRegisterType(lanes);
     }
     if (ST >= VectorRegisterType::E_BLOCK_COUNT)
     {
@@ -341,27 +691,29 @@ public:
     return Reduce(range, std::move(kernel), hkernel, initial_value);
   }
 
+  /**
+   * Folds the elements with register_reduction(accumulator, element), starting from zero. The
+   * partial results of the chunks of a large range are folded with it as well, so it must be
+   * associative and commutative, with zero as its identity.
+   */
   type Reduce(type (*register_reduction)(type const &, type const &)) const
   {
-    type        ret = 0;
-    std::size_t N   = this->size();
-
-    for (std::size_t i = 0; i < N; ++i)
-    {
-      ret = register_reduction(ret, pointer_[i]);
-    }
-
-    return ret;
+    Range range(0, this->size());
+    return Reduce(range, register_reduction);
   }
 
   type Reduce(Range const &range, type (*register_reduction)(type const &, type const &)) const
   {
-    type ret = 0;
-    for (std::size_t i = range.from(); i < range.to(); ++i)
-    {
-      ret = register_reduction(ret, pointer_[i]);
-    }
-    return ret;
+    return ChunkedReduce(range,
+                         [this, register_reduction](Range const &chunk) {
+                           type ret = 0;
+                           for (std::size_t i = chunk.from(); i < chunk.to(); ++i)
+                           {
+                             ret = register_reduction(ret, pointer_[i]);
+                           }
+                           return ret;
+                         },
+                         register_reduction);
   }
 
   type const *pointer() const
@@ -406,6 +758,7 @@ public:
   using ScalarRegisterIteratorType = vectorise::VectorRegisterIterator<type, scalar_size>;
   using VectorRegisterType         = typename vectorise::VectorRegister<type, vector_size>;
   using VectorRegisterIteratorType = vectorise::VectorRegisterIterator<type, vector_size>;
+  using MaskedTailType             = typename SuperType::MaskedTailType;
 
   ParallelDispatcher(type *ptr, std::size_t size)
     : SuperType(ptr, size)
@@ -413,9 +766,44 @@ public:
 
   template <class F>
   void RangedApply(Range const &range, F const &&apply)
+  {
+    SuperType::ForEachChunk(range, [this, &apply](std::size_t /*index*/, Range const &chunk) {
+      RangedApply(chunk, std::move(apply), MaskedTailType{});
+    });
+  }
+
+  template <class F>
+  void RangedApply(Range const &range, F const &&apply, std::true_type /*masked_tail*/)
   {
     std::size_t        SF = range.SIMDFromUpper<VectorRegisterType::E_BLOCK_COUNT>();
     std::size_t        ST = range.SIMDToLower<VectorRegisterType::E_BLOCK_COUNT>();
+    VectorRegisterType vc(type(0));
+
+    if (range.from() >= range.to())
+    {
+      return;
+    }
+
+    for (std::size_t i = SF; i < ST; i += VectorRegisterType::E_BLOCK_COUNT)
+    {
+      apply(vc);
+      vc.Store(this->pointer() + i);
+    }
+
+    SuperType::ForEachPartialBlock(range, [&](std::size_t offset, auto const &mask) {
+      apply(vc);
+      vc.Store(this->pointer() + offset, mask);
+    });
+  }
+
+  template <class F>
+  void RangedApply(Range const &range, F const &&apply, std::false_type /*masked_tail*/)
+  {
+    std::size_t SF = range.SIMDFromUpper<VectorRegisterType::E_BLOCK_COUNT>();
+    std::size_t ST = range.SIMDToLower<VectorRegisterType::E_BLOCK_COUNT>();
+
+    SuperType::ClampBlockBounds(range, SF, ST);
+
     VectorRegisterType vc(type(0));
     ScalarRegisterType c(type(0));
 
@@ -447,11 +835,57 @@ public:
 
   template <class F, typename... Args>
   void RangedApplyMultiple(Range const &range, F const &&apply, Args &&... args)
+  {
+    SuperType::ForEachChunk(range, [&](std::size_t /*index*/, Range const &chunk) {
+      RangedApplyMultiple(chunk, std::move(apply), MaskedTailType{}, args...);
+    });
+  }
+
+  template <class F, typename... Args>
+  void RangedApplyMultiple(Range const &range, F const &&apply, std::true_type /*masked_tail*/,
+                           Args &&... args)
+  {
+    std::size_t SF = range.SIMDFromUpper<VectorRegisterType::E_BLOCK_COUNT>();
+    std::size_t ST = range.SIMDToLower<VectorRegisterType::E_BLOCK_COUNT>();
+
+    if (range.from() >= range.to())
+    {
+      return;
+    }
+
+    VectorRegisterType regs[sizeof...(args)], vc(type(0));
+    type const *       pointers[sizeof...(args)];
+    SuperType::SetPointers(0, range.to(), pointers, std::forward<Args>(args)...);
+
+    for (std::size_t i = SF; i < ST; i += VectorRegisterType::E_BLOCK_COUNT)
+    {
+      for (std::size_t j = 0; j < sizeof...(args); ++j)
+      {
+        regs[j] = VectorRegisterType(pointers[j] + i);
+      }
+      details::MatrixApplyFreeFunction<VectorRegisterType, void>::template Unroll<Args...>::Apply(
+          regs, apply, vc);
+      vc.Store(this->pointer() + i);
+    }
+
+    SuperType::ForEachPartialBlock(range, [&](std::size_t offset, auto const &mask) {
+      SuperType::LoadMasked(offset, mask, pointers, regs, sizeof...(args));
+      details::MatrixApplyFreeFunction<VectorRegisterType, void>::template Unroll<Args...>::Apply(
+          regs, apply, vc);
+      vc.Store(this->pointer() + offset, mask);
+    });
+  }
+
+  template <class F, typename... Args>
+  void RangedApplyMultiple(Range const &range, F const &&apply, std::false_type /*masked_tail*/,
+                           Args &&... args)
   {
     std::size_t SF  = range.SIMDFromUpper<VectorRegisterType::E_BLOCK_COUNT>();
     std::size_t ST  = range.SIMDToLower<VectorRegisterType::E_BLOCK_COUNT>();
     std::size_t STU = range.SIMDToUpper<VectorRegisterType::E_BLOCK_COUNT>();
 
+    SuperType::ClampBlockBounds(range, SF, ST);
+
     VectorRegisterType         regs[sizeof...(args)], vc(type(0));
     VectorRegisterIteratorType iters[sizeof...(args)];
     SuperType::template InitializeVectorIterators<vector_size>(SF, ST - SF, iters,
@@ -462,8 +896,8 @@ public:
       ScalarRegisterType         c(type(0));
       ScalarRegisterType         scalar_regs[sizeof...(args)];
       ScalarRegisterIteratorType scalar_iters[sizeof...(args)];
-      SuperType::template InitializeVectorIterators<scalar_size>(range.from(), SF, scalar_iters,
-                                                                 std::forward<Args>(args)...);
+      SuperType::template InitializeVectorIterators<scalar_size>(
+          range.from(), SF - range.from(), scalar_iters, std::forward<Args>(args)...);
 
       for (std::size_t i = range.from(); i < SF; i += ScalarRegisterType::E_BLOCK_COUNT)
       {
@@ -196,6 +196,15 @@ constexpr bool has_avx2()
 #endif
 }
 
+constexpr bool has_avx512()
+{
+#ifdef __AVX512F__
+  return true;
+#else
+  return false;
+#endif
+}
+
 #define FETCH_ASM_LABEL(Label) __asm__("#" Label)
 
 // Allow the option of specifying our platform endianness
@@ -24,6 +24,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <ostream>
+#include <type_traits>
 
 namespace fetch {
 
@@ -48,6 +49,15 @@ struct VectorRegisterSize
     };                                \
   }
 
+/**
+ * Registers which support loading and storing a subset of their lanes, so that loops can
+ * process the ends of a range without falling back to scalar code
+ */
+template <typename T>
+struct HasMaskedAccess : std::false_type
+{
+};
+
 #include <cmath>
 #include <cstddef>
 #include <ostream>
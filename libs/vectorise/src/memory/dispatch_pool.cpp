@@ -0,0 +1,240 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/memory/dispatch_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fetch {
+namespace memory {
+namespace {
+
+/**
+ * A call to DispatchPool::Run whose chunks are claimed one at a time by the calling thread and by
+ * the workers. Fields without an atomic type are guarded by the mutex of the workers.
+ */
+struct Job
+{
+  Job(std::size_t chunk_count, DispatchPool::ChunkFunction const &chunk_function)
+    : count{chunk_count}
+    , function{chunk_function}
+  {}
+
+  std::size_t const                  count;
+  DispatchPool::ChunkFunction const &function;
+  std::atomic<std::size_t>           next{0};
+  std::size_t                        finished{0};
+  std::size_t                        users{0};
+  std::exception_ptr                 error{};
+};
+
+thread_local bool        is_worker{false};
+std::atomic<std::size_t> threshold_elements{DispatchPool::DEFAULT_THRESHOLD};
+
+/**
+ * Processes chunks of the job until all of them have been claimed, returning how many were
+ * processed by this thread
+ */
+std::size_t Drain(Job &job, std::exception_ptr &error)
+{
+  std::size_t processed{0};
+  for (std::size_t index = job.next++; index < job.count; index = job.next++)
+  {
+    try
+    {
+      job.function(index);
+    }
+    catch (...)
+    {
+      if (!error)
+      {
+        error = std::current_exception();
+      }
+    }
+
+    ++processed;
+  }
+
+  return processed;
+}
+
+class Workers
+{
+public:
+  static Workers &Instance()
+  {
+    static Workers instance;
+    return instance;
+  }
+
+  Workers(Workers const &) = delete;
+  Workers &operator=(Workers const &) = delete;
+
+  ~Workers()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    work_.notify_all();
+
+    for (auto &thread : threads_)
+    {
+      thread.join();
+    }
+  }
+
+  std::size_t size() const
+  {
+    return threads_.size();
+  }
+
+  void Run(Job &job)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      jobs_.push_back(&job);
+    }
+    work_.notify_all();
+
+    std::exception_ptr error;
+    std::size_t const  processed = Drain(job, error);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    Finish(job, processed, error);
+
+    // workers which picked up the job may still be processing their last chunk
+    done_.wait(lock, [&job] { return (job.finished == job.count) && (job.users == 0); });
+
+    if (job.error)
+    {
+      std::rethrow_exception(job.error);
+    }
+  }
+
+private:
+  Workers()
+  {
+    // the calling thread takes part in every job, so one core is left for it
+    std::size_t const hardware = std::thread::hardware_concurrency();
+    std::size_t const count    = (hardware > 1) ? hardware - 1 : 0;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      threads_.emplace_back([this]() { Work(); });
+    }
+  }
+
+  void Work()
+  {
+    is_worker = true;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;)
+    {
+      work_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+      if (stopping_)
+      {
+        return;
+      }
+
+      Job &job = *jobs_.front();
+      ++job.users;
+      lock.unlock();
+
+      std::exception_ptr error;
+      std::size_t const  processed = Drain(job, error);
+
+      lock.lock();
+      Finish(job, processed, error);
+      --job.users;
+      done_.notify_all();
+    }
+  }
+
+  /**
+   * Records the chunks a thread has processed. Once a thread has drained the job every chunk has
+   * been claimed, so the job is removed from the queue. Must be called with the mutex held.
+   */
+  void Finish(Job &job, std::size_t processed, std::exception_ptr const &error)
+  {
+    job.finished += processed;
+    if (error && !job.error)
+    {
+      job.error = error;
+    }
+
+    auto const it = std::find(jobs_.begin(), jobs_.end(), &job);
+    if (it != jobs_.end())
+    {
+      jobs_.erase(it);
+    }
+  }
+
+  std::mutex               mutex_;
+  std::condition_variable  work_;
+  std::condition_variable  done_;
+  std::deque<Job *>        jobs_;
+  bool                     stopping_{false};
+  std::vector<std::thread> threads_;
+};
+
+}  // namespace
+
+constexpr std::size_t DispatchPool::CHUNK_SIZE;
+constexpr std::size_t DispatchPool::DEFAULT_THRESHOLD;
+
+std::size_t DispatchPool::threshold()
+{
+  return threshold_elements;
+}
+
+void DispatchPool::SetThreshold(std::size_t elements)
+{
+  threshold_elements = elements;
+}
+
+std::size_t DispatchPool::concurrency()
+{
+  return Workers::Instance().size() + 1;
+}
+
+void DispatchPool::Run(std::size_t count, ChunkFunction const &function)
+{
+  if ((count > 1) && !is_worker && (Workers::Instance().size() > 0))
+  {
+    Job job{count, function};
+    Workers::Instance().Run(job);
+    return;
+  }
+
+  for (std::size_t index = 0; index < count; ++index)
+  {
+    function(index);
+  }
+}
+
+}  // namespace memory
+}  // namespace fetch
@@ -0,0 +1,231 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/fixed_point/fixed_point.hpp"
+#include "vectorise/math/max.hpp"
+#include "vectorise/memory/dispatch_pool.hpp"
+#include "vectorise/memory/shared_array.hpp"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+
+using fetch::memory::DispatchPool;
+using fetch::memory::Range;
+
+TEST(DispatchPoolTests, run_calls_the_function_once_for_every_chunk)
+{
+  std::size_t const                          count = 1000;
+  std::unique_ptr<std::atomic<std::size_t>[]> calls{new std::atomic<std::size_t>[count]};
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    calls[i] = 0;
+  }
+
+  DispatchPool::Run(count, [&calls](std::size_t index) { ++calls[index]; });
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    EXPECT_EQ(calls[i], 1) << "at " << i;
+  }
+}
+
+TEST(DispatchPoolTests, nested_runs_complete)
+{
+  std::atomic<std::size_t> calls{0};
+
+  DispatchPool::Run(64, [&calls](std::size_t /*index*/) {
+    DispatchPool::Run(64, [&calls](std::size_t /*index*/) { ++calls; });
+  });
+
+  EXPECT_EQ(calls, 64 * 64);
+}
+
+TEST(DispatchPoolTests, exceptions_are_rethrown_to_the_caller)
+{
+  EXPECT_THROW(DispatchPool::Run(100,
+                                 [](std::size_t index) {
+                                   if (index == 42)
+                                   {
+                                     throw std::runtime_error("chunk failed");
+                                   }
+                                 }),
+               std::runtime_error);
+}
+
+template <typename T>
+class ThreadedDispatcherTests : public ::testing::Test
+{
+protected:
+  using ArrayType = fetch::memory::SharedArray<T>;
+
+  static constexpr std::size_t N = 4 * DispatchPool::CHUNK_SIZE + 123;
+
+  void SetUp() override
+  {
+    for (std::size_t i = 0; i < a_.padded_size(); ++i)
+    {
+      a_[i] = T(static_cast<int>(i % 7)) / T(16);
+      b_[i] = T(static_cast<int>(i % 5)) / T(16);
+    }
+  }
+
+  void TearDown() override
+  {
+    DispatchPool::SetThreshold(DispatchPool::DEFAULT_THRESHOLD);
+  }
+
+  template <typename F>
+  static auto Threaded(F &&function)
+  {
+    DispatchPool::SetThreshold(0);
+    return function();
+  }
+
+  template <typename F>
+  static auto Serial(F &&function)
+  {
+    DispatchPool::SetThreshold(std::numeric_limits<std::size_t>::max());
+    return function();
+  }
+
+  // Starts and ends inside a register block, and covers several chunks
+  Range const range_{17, N - 5};
+
+  ArrayType a_{N};
+  ArrayType b_{N};
+  ArrayType c_{N};
+};
+
+template <typename T>
+constexpr std::size_t ThreadedDispatcherTests<T>::N;
+
+using ThreadedTypes =
+    ::testing::Types<float, double, fetch::fixed_point::fp32_t, fetch::fixed_point::fp64_t>;
+TYPED_TEST_SUITE(ThreadedDispatcherTests, ThreadedTypes, );
+
+TYPED_TEST(ThreadedDispatcherTests, ranged_apply_only_writes_inside_the_range)
+{
+  TypeParam const sentinel{-3};
+  for (std::size_t i = 0; i < this->c_.padded_size(); ++i)
+  {
+    this->c_[i] = sentinel;
+  }
+
+  TestFixture::Threaded([this] {
+    this->c_.in_parallel().RangedApplyMultiple(
+        this->range_, [](auto const &a, auto const &b, auto &c) { c = a + b; }, this->a_,
+        this->b_);
+  });
+
+  for (std::size_t i = 0; i < this->c_.padded_size(); ++i)
+  {
+    bool const inside = (this->range_.from() <= i) && (i < this->range_.to());
+    ASSERT_EQ(this->c_[i], inside ? TypeParam(this->a_[i] + this->b_[i]) : sentinel) << "at " << i;
+  }
+}
+
+TYPED_TEST(ThreadedDispatcherTests, sum_reduce_does_not_depend_on_threading)
+{
+  auto const sum = [this] {
+    return this->a_.in_parallel().SumReduce(
+        this->range_, [](auto const &a, auto const &b) { return a * b; }, this->b_);
+  };
+
+  TypeParam const threaded = TestFixture::Threaded(sum);
+  TypeParam const serial   = TestFixture::Serial(sum);
+
+  EXPECT_EQ(threaded, serial);
+
+  TypeParam expected{0};
+  for (std::size_t i = this->range_.from(); i < this->range_.to(); ++i)
+  {
+    expected += this->a_[i] * this->b_[i];
+  }
+  EXPECT_NEAR(static_cast<double>(threaded), static_cast<double>(expected),
+              1e-4 * static_cast<double>(expected));
+}
+
+TYPED_TEST(ThreadedDispatcherTests, max_reduce_does_not_depend_on_threading)
+{
+  this->a_[3 * DispatchPool::CHUNK_SIZE + 1] = TypeParam{100};
+
+  auto const max = [this] {
+    return this->a_.in_parallel().Reduce(
+        this->range_, [](auto const &a, auto const &b) { return fetch::vectorise::Max(a, b); },
+        [](auto const &a) { return fetch::vectorise::Max(a); });
+  };
+
+  TypeParam const threaded = TestFixture::Threaded(max);
+
+  EXPECT_EQ(threaded, TestFixture::Serial(max));
+  EXPECT_EQ(threaded, TypeParam{100});
+}
+
+TYPED_TEST(ThreadedDispatcherTests, reduce_combines_chunks_with_the_combine_function)
+{
+  // the kernel accumulates squares, so it cannot be used to combine the partial results
+  auto const sum_of_squares = [this] {
+    return this->a_.in_parallel().Reduce(
+        this->range_, [](auto const &x, auto const &acc) { return acc + (x * x); },
+        [](auto const &a) { return reduce(a); },
+        [](TypeParam const &a, TypeParam const &b) { return static_cast<TypeParam>(a + b); },
+        TypeParam{0});
+  };
+
+  TypeParam const threaded = TestFixture::Threaded(sum_of_squares);
+
+  EXPECT_EQ(threaded, TestFixture::Serial(sum_of_squares));
+
+  TypeParam expected{0};
+  for (std::size_t i = this->range_.from(); i < this->range_.to(); ++i)
+  {
+    expected += this->a_[i] * this->a_[i];
+  }
+  EXPECT_NEAR(static_cast<double>(threaded), static_cast<double>(expected),
+              1e-4 * static_cast<double>(expected));
+}
+
+TEST(ThreadedFixedPointTests, overflow_in_any_chunk_is_reported_to_the_calling_thread)
+{
+  using fetch::fixed_point::fp32_t;
+
+  std::size_t const                  n = 4 * DispatchPool::CHUNK_SIZE;
+  fetch::memory::SharedArray<fp32_t> a(n);
+  fetch::memory::SharedArray<fp32_t> c(n);
+  a.in_parallel().Assign(fp32_t{1});
+  a[3 * DispatchPool::CHUNK_SIZE + 7] = fp32_t{30000};
+
+  DispatchPool::SetThreshold(0);
+  fp32_t::StateClear();
+
+  c.in_parallel().Apply([](auto const &x, auto &y) { y = x + x; }, a);
+
+  EXPECT_TRUE(fp32_t::IsStateOverflow());
+
+  fp32_t::StateClear();
+  DispatchPool::SetThreshold(DispatchPool::DEFAULT_THRESHOLD);
+}
+
+}  // namespace
@@ -0,0 +1,156 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/fixed_point/fixed_point.hpp"
+#include "vectorise/math/max.hpp"
+#include "vectorise/memory/shared_array.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+
+namespace {
+
+using fetch::memory::Range;
+
+template <typename T>
+class ParallelDispatcherTests : public ::testing::Test
+{
+protected:
+  using ArrayType = fetch::memory::SharedArray<T>;
+
+  static constexpr std::size_t N = 53;
+
+  void SetUp() override
+  {
+    for (std::size_t i = 0; i < a_.padded_size(); ++i)
+    {
+      a_[i] = T(static_cast<int>(i % 7));
+      b_[i] = T(static_cast<int>(i % 5));
+    }
+  }
+
+  void ResetOutput()
+  {
+    for (std::size_t i = 0; i < c_.padded_size(); ++i)
+    {
+      c_[i] = SENTINEL;
+    }
+  }
+
+  // Every non empty sub range of [0, N), covering ranges which start and end inside, at the edge
+  // of, and in different register blocks
+  template <typename F>
+  static void ForEachRange(F &&function)
+  {
+    for (std::size_t from = 0; from < N; ++from)
+    {
+      for (std::size_t to = from + 1; to <= N; ++to)
+      {
+        function(Range(from, to));
+      }
+    }
+  }
+
+  T const SENTINEL{-3};
+
+  ArrayType a_{N};
+  ArrayType b_{N};
+  ArrayType c_{N};
+};
+
+template <typename T>
+constexpr std::size_t ParallelDispatcherTests<T>::N;
+
+using DispatcherTypes =
+    ::testing::Types<float, double, fetch::fixed_point::fp32_t, fetch::fixed_point::fp64_t>;
+TYPED_TEST_SUITE(ParallelDispatcherTests, DispatcherTypes, );
+
+TYPED_TEST(ParallelDispatcherTests, ranged_apply_only_writes_inside_the_range)
+{
+  TestFixture::ForEachRange([this](Range const &range) {
+    this->ResetOutput();
+    this->c_.in_parallel().RangedApplyMultiple(
+        range, [](auto const &a, auto const &b, auto &c) { c = a + b; }, this->a_, this->b_);
+
+    for (std::size_t i = 0; i < this->c_.padded_size(); ++i)
+    {
+      bool const inside = (range.from() <= i) && (i < range.to());
+      EXPECT_EQ(this->c_[i], inside ? TypeParam(this->a_[i] + this->b_[i]) : this->SENTINEL)
+          << "at " << i << " for range [" << range.from() << ", " << range.to() << ")";
+    }
+  });
+}
+
+TYPED_TEST(ParallelDispatcherTests, assign_only_writes_inside_the_range)
+{
+  TypeParam const value{7};
+
+  TestFixture::ForEachRange([this, value](Range const &range) {
+    this->ResetOutput();
+    this->c_.in_parallel().Assign(range, value);
+
+    for (std::size_t i = 0; i < this->c_.padded_size(); ++i)
+    {
+      bool const inside = (range.from() <= i) && (i < range.to());
+      EXPECT_EQ(this->c_[i], inside ? value : this->SENTINEL)
+          << "at " << i << " for range [" << range.from() << ", " << range.to() << ")";
+    }
+  });
+}
+
+TYPED_TEST(ParallelDispatcherTests, sum_reduce_ignores_elements_outside_the_range)
+{
+  TestFixture::ForEachRange([this](Range const &range) {
+    TypeParam expected{0};
+    for (std::size_t i = range.from(); i < range.to(); ++i)
+    {
+      expected += this->a_[i] * this->b_[i];
+    }
+
+    TypeParam const ret = this->a_.in_parallel().SumReduce(
+        range, [](auto const &a, auto const &b) { return a * b; }, this->b_);
+
+    EXPECT_EQ(ret, expected) << "for range [" << range.from() << ", " << range.to() << ")";
+  });
+}
+
+TYPED_TEST(ParallelDispatcherTests, max_reduce_ignores_elements_outside_the_range)
+{
+  // Make the elements outside of any sub range the largest in the array
+  for (std::size_t i = TestFixture::N; i < this->a_.padded_size(); ++i)
+  {
+    this->a_[i] = TypeParam{100};
+  }
+
+  TestFixture::ForEachRange([this](Range const &range) {
+    TypeParam expected{0};
+    for (std::size_t i = range.from(); i < range.to(); ++i)
+    {
+      expected = fetch::vectorise::Max(expected, this->a_[i]);
+    }
+
+    TypeParam const ret = this->a_.in_parallel().Reduce(
+        range, [](auto const &a, auto const &b) { return fetch::vectorise::Max(a, b); },
+        [](auto const &a) { return fetch::vectorise::Max(a); });
+
+    EXPECT_EQ(ret, expected) << "for range [" << range.from() << ", " << range.to() << ")";
+  });
+}
+
+}  // namespace
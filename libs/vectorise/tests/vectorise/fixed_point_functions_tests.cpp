@@ -0,0 +1,251 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vectorise/fixed_point/fixed_point.hpp"
+#include "vectorise/math/standard_functions.hpp"
+#include "vectorise/vectorise.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace {
+
+using fetch::fixed_point::fp32_t;
+
+template <std::size_t S>
+using Register = fetch::vectorise::VectorRegister<fp32_t, S>;
+
+int32_t const ONE     = fp32_t::_1.Data();
+int32_t const NAN_    = fp32_t::NaN.Data();
+int32_t const POS_INF = fp32_t::POSITIVE_INFINITY.Data();
+int32_t const NEG_INF = fp32_t::NEGATIVE_INFINITY.Data();
+int32_t const MAX_EXP = fp32_t::MAX_EXP.Data();
+int32_t const MIN_EXP = fp32_t::MIN_EXP.Data();
+
+struct ExpFunction
+{
+  template <std::size_t S>
+  static Register<S> Vector(Register<S> const &x)
+  {
+    return fetch::vectorise::Exp(x);
+  }
+
+  static fp32_t Scalar(fp32_t const &x)
+  {
+    return fp32_t::Exp(x);
+  }
+
+  // Every value from just below MIN_EXP to just above MAX_EXP
+  static constexpr int64_t DENSE_FIRST = int64_t{-0x000a65ad} - 0x10000;
+  static constexpr int64_t DENSE_LAST  = int64_t{0x000a65ad} + 0x10000;
+
+  static std::vector<int32_t> Boundaries()
+  {
+    return {MAX_EXP - 1, MAX_EXP, MAX_EXP + 1, MIN_EXP - 1, MIN_EXP, MIN_EXP + 1,
+            -MAX_EXP + 1, -MAX_EXP, ONE - 1, ONE, ONE + 1, -ONE};
+  }
+};
+
+struct LogFunction
+{
+  template <std::size_t S>
+  static Register<S> Vector(Register<S> const &x)
+  {
+    return fetch::vectorise::Log(x);
+  }
+
+  static fp32_t Scalar(fp32_t const &x)
+  {
+    return fp32_t::Log(x);
+  }
+
+  // Every value up to 32, which covers all of the values below 1
+  static constexpr int64_t DENSE_FIRST = -0x10000;
+  static constexpr int64_t DENSE_LAST  = 0x200000;
+
+  static std::vector<int32_t> Boundaries()
+  {
+    return {1,           2,           3,           4,           5,       6,
+            ONE - 1,     ONE,         ONE + 1,     2 * ONE,     -ONE,    (1 << 30) - 1,
+            (1 << 30),   (1 << 30) + 1};
+  }
+};
+
+struct SqrtFunction
+{
+  template <std::size_t S>
+  static Register<S> Vector(Register<S> const &x)
+  {
+    return fetch::vectorise::Sqrt(x);
+  }
+
+  static fp32_t Scalar(fp32_t const &x)
+  {
+    return fp32_t::Sqrt(x);
+  }
+
+  // Every value up to 32, which covers all of the values below 1
+  static constexpr int64_t DENSE_FIRST = -0x10000;
+  static constexpr int64_t DENSE_LAST  = 0x200000;
+
+  static std::vector<int32_t> Boundaries()
+  {
+    return {1,       2,       3,       4,           5,           ONE - 1,
+            ONE,     ONE + 1, 4 * ONE, 4 * ONE + 1, fp32_t::MAX, fp32_t::MAX + 1,
+            -1,      -ONE};
+  }
+};
+
+struct TanHFunction
+{
+  template <std::size_t S>
+  static Register<S> Vector(Register<S> const &x)
+  {
+    return fetch::vectorise::TanH(x);
+  }
+
+  static fp32_t Scalar(fp32_t const &x)
+  {
+    return fp32_t::TanH(x);
+  }
+
+  // Every value from just below MIN_EXP to just above MAX_EXP
+  static constexpr int64_t DENSE_FIRST = int64_t{-0x000a65ad} - 0x10000;
+  static constexpr int64_t DENSE_LAST  = int64_t{0x000a65ad} + 0x10000;
+
+  static std::vector<int32_t> Boundaries()
+  {
+    return ExpFunction::Boundaries();
+  }
+};
+
+/**
+ * Compare the vector function of a block of values with the scalar function, lane by lane,
+ * including the fp_state flags which each raises
+ */
+template <typename Function, std::size_t S>
+void CheckBlock(std::vector<int32_t> raw)
+{
+  constexpr std::size_t N = Register<S>::E_BLOCK_COUNT;
+  raw.resize(N, 0);
+
+  alignas(32) fp32_t input[N];
+  alignas(32) fp32_t output[N];
+  fp32_t             expected[N];
+
+  fp32_t::StateClear();
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    input[i]    = fp32_t::FromBase(raw[i]);
+    expected[i] = Function::Scalar(input[i]);
+  }
+  uint32_t const expected_state = fp32_t::fp_state;
+
+  fp32_t::StateClear();
+  Register<S> const x(input);
+  Function::Vector(x).Store(output);
+  uint32_t const state = fp32_t::fp_state;
+
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    EXPECT_EQ(output[i].Data(), expected[i].Data()) << "x = " << input[i] << " (" << raw[i] << ")";
+  }
+  EXPECT_EQ(state, expected_state) << "x = " << input[0] << " (" << raw[0] << ") ...";
+}
+
+/**
+ * Check every value in [first, last] which is a multiple of stride away from first
+ */
+template <typename Function, std::size_t S>
+void CheckRange(int64_t first, int64_t last, int64_t stride)
+{
+  constexpr std::size_t N = Register<S>::E_BLOCK_COUNT;
+
+  std::vector<int32_t> block;
+  for (int64_t value = first; value <= last; value += stride)
+  {
+    block.push_back(static_cast<int32_t>(value));
+
+    if (block.size() == N)
+    {
+      CheckBlock<Function, S>(block);
+      block.clear();
+
+      if (::testing::Test::HasFailure())
+      {
+        return;
+      }
+    }
+  }
+
+  if (!block.empty())
+  {
+    CheckBlock<Function, S>(block);
+  }
+}
+
+template <typename Function>
+class FixedPointFunctionsTest : public ::testing::Test
+{
+};
+
+using Functions = ::testing::Types<ExpFunction, LogFunction, SqrtFunction, TanHFunction>;
+TYPED_TEST_CASE(FixedPointFunctionsTest, Functions);
+
+TYPED_TEST(FixedPointFunctionsTest, dense_sweep_matches_scalar)
+{
+  CheckRange<TypeParam, 256>(TypeParam::DENSE_FIRST, TypeParam::DENSE_LAST, 1);
+}
+
+TYPED_TEST(FixedPointFunctionsTest, full_range_matches_scalar)
+{
+  int64_t const first = std::numeric_limits<int32_t>::min();
+  int64_t const last  = std::numeric_limits<int32_t>::max();
+
+  CheckRange<TypeParam, 256>(first, last, 65521);
+  CheckRange<TypeParam, 128>(first, last, 65521);
+}
+
+TYPED_TEST(FixedPointFunctionsTest, boundaries_match_scalar)
+{
+  // one value at a time, so that the flags each raises are compared in isolation
+  for (int32_t const value : TypeParam::Boundaries())
+  {
+    CheckBlock<TypeParam, 256>({value, value, value, value, value, value, value, value});
+    CheckBlock<TypeParam, 128>({value, ONE, value, ONE});
+  }
+}
+
+TYPED_TEST(FixedPointFunctionsTest, special_values_match_scalar)
+{
+  for (int32_t const special : {NAN_, POS_INF, NEG_INF, 0})
+  {
+    CheckBlock<TypeParam, 256>({special, special, special, special, special, special, special,
+                                special});
+    CheckBlock<TypeParam, 256>({special, 0, 1, -1, ONE, 3 * ONE, -3 * ONE, MAX_EXP});
+    CheckBlock<TypeParam, 128>({special, 0, ONE, -ONE});
+  }
+
+  CheckBlock<TypeParam, 256>({NAN_, POS_INF, NEG_INF, MAX_EXP, 0, 0, 0, 0});
+}
+
+}  // namespace
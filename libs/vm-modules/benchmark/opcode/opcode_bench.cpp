@@ -73,11 +73,11 @@ namespace {
 // Benchmark parameters (change as desired)
 const uint32_t max_array_len = 16384, n_array_lens = 33, max_str_len = 16384, n_str_lens = 17,
                max_tensor_size = 531441, n_tensor_sizes = 17, n_dim_sizes = n_tensor_sizes * 3,
-               max_crypto_len = 16384, n_crypto_lens = 17;
+               max_crypto_len = 16384, n_crypto_lens = 17, max_map_size = 4096, n_map_sizes = 17;
 
 // Number of benchmarks in each category
 const uint32_t n_basic_bms = 15, n_object_bms = 10, n_prim_bms = 25, n_math_bms = 16,
-               n_array_bms = 10, n_tensor_bms = 5, n_crypto_bms = 6;
+               n_array_bms = 10, n_tensor_bms = 5, n_crypto_bms = 6, n_map_bms = 8;
 
 // Number of total (including int) and decimal (fixed or float) primitives
 const uint32_t n_primitives = 13, n_dec_primitives = 5;
@@ -91,6 +91,7 @@ const uint32_t array_begin = math_end, array_end = array_begin + n_array_bms * n
 const uint32_t tensor_begin = array_end, tensor_end = tensor_begin + n_tensor_bms * n_dim_sizes;
 const uint32_t crypto_begin = tensor_end,
                crypto_end   = crypto_begin + 1 + (n_crypto_bms - 1) * n_crypto_lens;
+const uint32_t map_begin = crypto_end, map_end = map_begin + n_map_bms * n_map_sizes;
 
 /**
  * Main benchmark function - compiles and runs Etch code snippets and saves opcodes to file
@@ -808,6 +809,64 @@ void CryptoBenchmarks(benchmark::State &state)
                     baseline_map[etch_codes[etch_ind].first], bm_ind);
 }
 
+void MapBenchmarks(benchmark::State &state)
+{
+  auto bm_ind = static_cast<uint32_t>(state.range(0));
+
+  // Generate the map sizes from benchmark parameters
+  std::vector<uint32_t> map_sizes = LinearRangeVector<uint32_t>(max_map_size, n_map_sizes);
+
+  // Size and etch-code indices corresponding to benchmark range variable
+  const uint32_t size_ind = (bm_ind - map_begin) / n_map_bms;
+  const uint32_t etch_ind = (bm_ind - map_begin) % n_map_bms;
+
+  std::string const size = std::to_string(map_sizes[size_ind]);
+
+  // Declarations and operations, keyed by primitive (Int32) and object (UInt256) values
+  const static std::string DEC("var m = Map<Int32, Int32>();\n"),
+      OBJ_DEC("var m = Map<UInt256, Int32>();\n"), OBJ_KEY("UInt256(toUInt64(i))"),
+      SET("m[i] = i;\n"), GET("m[i];\n"), UPDATE("m[i] = m[i] + 1;\n"), COUNT("m.count();\n"),
+      OBJ_SET("m[" + OBJ_KEY + "] = i;\n"), OBJ_GET("m[" + OBJ_KEY + "];\n");
+
+  const BenchmarkPair MAP_DEC("DeclareMap_" + size, FunMain(DEC + For("", size)));
+  const BenchmarkPair MAP_FILL("FillMap_" + size, FunMain(DEC + For(SET, size)));
+  const BenchmarkPair MAP_LOOKUP("LookupMap_" + size,
+                                 FunMain(DEC + For(SET, size) + For(GET, size)));
+  const BenchmarkPair MAP_UPDATE("UpdateMap_" + size,
+                                 FunMain(DEC + For(SET, size) + For(UPDATE, size)));
+  const BenchmarkPair MAP_COUNT("CountMap_" + size, FunMain(DEC + For(SET, size) + COUNT));
+  const BenchmarkPair OBJ_MAP_DEC("DeclareObjKeyMap_" + size,
+                                  FunMain(OBJ_DEC + For(OBJ_KEY + ";\n", size)));
+  const BenchmarkPair OBJ_MAP_FILL("FillObjKeyMap_" + size, FunMain(OBJ_DEC + For(OBJ_SET, size)));
+  const BenchmarkPair OBJ_MAP_LOOKUP(
+      "LookupObjKeyMap_" + size,
+      FunMain(OBJ_DEC + For(OBJ_SET, size) + For(OBJ_GET, size)));
+
+  // Define {benchmark,baseline} pairs
+  std::unordered_map<std::string, std::string> baseline_map(
+      {{"DeclareMap_" + size, "Return"},
+       {"FillMap_" + size, "DeclareMap_" + size},
+       {"LookupMap_" + size, "FillMap_" + size},
+       {"UpdateMap_" + size, "FillMap_" + size},
+       {"CountMap_" + size, "FillMap_" + size},
+       {"DeclareObjKeyMap_" + size, "Return"},
+       {"FillObjKeyMap_" + size, "DeclareObjKeyMap_" + size},
+       {"LookupObjKeyMap_" + size, "FillObjKeyMap_" + size}});
+
+  std::vector<BenchmarkPair> const etch_codes = {
+      MAP_DEC,   MAP_FILL,    MAP_LOOKUP,   MAP_UPDATE,
+      MAP_COUNT, OBJ_MAP_DEC, OBJ_MAP_FILL, OBJ_MAP_LOOKUP};
+
+  if (etch_ind >= etch_codes.size())
+  {
+    std::cout << "Skipping benchmark (index out of range of benchmark category)" << std::endl;
+    return;
+  }
+
+  EtchCodeBenchmark(state, etch_codes[etch_ind].first, etch_codes[etch_ind].second,
+                    baseline_map[etch_codes[etch_ind].first], bm_ind);
+}
+
 bool RegisterBenchmarks()
 {
   BENCHMARK(BasicBenchmarks)->DenseRange(basic_begin, basic_end - 1, 1);
@@ -817,6 +876,7 @@ bool RegisterBenchmarks()
   BENCHMARK(ArrayBenchmarks)->DenseRange(array_begin, array_end - 1, 1);
   BENCHMARK(TensorBenchmarks)->DenseRange(tensor_begin, tensor_end - 1, 1);
   BENCHMARK(CryptoBenchmarks)->DenseRange(crypto_begin, crypto_end - 1, 1);
+  BENCHMARK(MapBenchmarks)->DenseRange(map_begin, map_end - 1, 1);
   return true;
 }
 
@@ -48,6 +48,7 @@ public:
   fetch::vm::Ptr<vm::String>       ToBase58();
   bool                             FromBase58(fetch::vm::Ptr<vm::String> const &value_b58);
 
+  std::size_t GetHashCode() override;
   bool IsEqual(fetch::vm::Ptr<Object> const &lhso, fetch::vm::Ptr<Object> const &rhso) override;
   bool IsNotEqual(fetch::vm::Ptr<Object> const &lhso, fetch::vm::Ptr<Object> const &rhso) override;
   bool IsLessThan(fetch::vm::Ptr<Object> const &lhso, fetch::vm::Ptr<Object> const &rhso) override;
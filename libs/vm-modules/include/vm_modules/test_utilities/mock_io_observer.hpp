@@ -32,11 +32,13 @@ public:
     using ::testing::Invoke;
 
     ON_CALL(*this, Read(_, _, _)).WillByDefault(Invoke(&fake_, &FakeIoObserver::Read));
+    ON_CALL(*this, ReadBuffer(_, _)).WillByDefault(Invoke(&fake_, &FakeIoObserver::ReadBuffer));
     ON_CALL(*this, Write(_, _, _)).WillByDefault(Invoke(&fake_, &FakeIoObserver::Write));
     ON_CALL(*this, Exists(_)).WillByDefault(Invoke(&fake_, &FakeIoObserver::Exists));
   }
 
   MOCK_METHOD3(Read, Status(std::string const &, void *, uint64_t &));
+  MOCK_METHOD2(ReadBuffer, Status(std::string const &, fetch::byte_array::ConstByteArray &));
   MOCK_METHOD3(Write, Status(std::string const &, void const *, uint64_t));
   MOCK_METHOD1(Exists, Status(std::string const &));
 
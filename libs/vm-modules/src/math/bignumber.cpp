@@ -23,7 +23,9 @@
 #include "vm_modules/core/byte_array_wrapper.hpp"
 #include "vm_modules/math/bignumber.hpp"
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <stdexcept>
 #include <utility>
 
@@ -338,6 +340,17 @@ void UInt256Wrapper::InplaceDivide(Ptr<Object> const &lhso, Ptr<Object> const &r
   }
 }
 
+std::size_t UInt256Wrapper::GetHashCode()
+{
+  uint64_t hash{0};
+  for (std::size_t i = 0; i < UInt256::WIDE_ELEMENTS; ++i)
+  {
+    hash = (hash * 0x100000001B3ull) ^ number_.ElementAt(i);
+  }
+
+  return std::hash<uint64_t>{}(hash);
+}
+
 bool UInt256Wrapper::IsEqual(Ptr<Object> const &lhso, Ptr<Object> const &rhso)
 {
   auto &lhs = static_cast<Ptr<UInt256Wrapper> const &>(lhso);
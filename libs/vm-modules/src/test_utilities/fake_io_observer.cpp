@@ -52,6 +52,26 @@ FakeIoObserver::Status FakeIoObserver::Read(std::string const &key, void *data,
   return Status::OK;
 }
 
+FakeIoObserver::Status FakeIoObserver::ReadBuffer(std::string const &key, ConstByteArray &data)
+{
+  // check to see if the key is permitted
+  if (!IsPermittedKey(key))
+  {
+    return Status::PERMISSION_DENIED;
+  }
+
+  // check to see if the key exists
+  auto it = data_.find(key);
+  if (it == data_.end())
+  {
+    return Status::ERROR;
+  }
+
+  data = it->second;
+
+  return Status::OK;
+}
+
 FakeIoObserver::Status FakeIoObserver::Write(std::string const &key, void const *data,
                                              uint64_t size)
 {
@@ -70,8 +70,7 @@ TEST_F(StateTests, AddressSerialisationTest)
     endfunction
   )";
 
-  EXPECT_CALL(toolkit.observer(), Exists("addr"));
-  EXPECT_CALL(toolkit.observer(), Read("addr", _, _));
+  EXPECT_CALL(toolkit.observer(), ReadBuffer("addr", _));
 
   ASSERT_TRUE(toolkit.Compile(deser_src));
 
@@ -104,8 +103,7 @@ TEST_F(StateTests, MapDeserializeTest)
     endfunction
   )";
 
-  EXPECT_CALL(toolkit.observer(), Exists("map"));
-  EXPECT_CALL(toolkit.observer(), Read("map", _, _));
+  EXPECT_CALL(toolkit.observer(), ReadBuffer("map", _));
 
   ASSERT_TRUE(toolkit.Compile(deser_src));
   Variant ret;
@@ -138,8 +136,7 @@ TEST_F(StateTests, PairDeserializeBothTest)
     endfunction
   )";
 
-  EXPECT_CALL(toolkit.observer(), Exists("pair"));
-  EXPECT_CALL(toolkit.observer(), Read("pair", _, _));
+  EXPECT_CALL(toolkit.observer(), ReadBuffer("pair", _));
 
   ASSERT_TRUE(toolkit.Compile(deser_src));
   Variant ret;
@@ -171,8 +168,7 @@ TEST_F(StateTests, PairDeserializeFirstOnlyTest)
     endfunction
   )";
 
-  EXPECT_CALL(toolkit.observer(), Exists("pair"));
-  EXPECT_CALL(toolkit.observer(), Read("pair", _, _));
+  EXPECT_CALL(toolkit.observer(), ReadBuffer("pair", _));
 
   ASSERT_TRUE(toolkit.Compile(deser_src));
   Variant ret;
@@ -204,8 +200,7 @@ TEST_F(StateTests, PairDeserializeSecondOnlyTest)
     endfunction
   )";
 
-  EXPECT_CALL(toolkit.observer(), Exists("pair"));
-  EXPECT_CALL(toolkit.observer(), Read("pair", _, _));
+  EXPECT_CALL(toolkit.observer(), ReadBuffer("pair", _));
 
   ASSERT_TRUE(toolkit.Compile(deser_src));
   Variant ret;
@@ -236,8 +231,7 @@ TEST_F(StateTests, PairDeserializeNoneTest)
     endfunction
   )";
 
-  EXPECT_CALL(toolkit.observer(), Exists("pair"));
-  EXPECT_CALL(toolkit.observer(), Read("pair", _, _));
+  EXPECT_CALL(toolkit.observer(), ReadBuffer("pair", _));
 
   ASSERT_TRUE(toolkit.Compile(deser_src));
   Variant ret;
@@ -271,8 +265,7 @@ TEST_F(StateTests, ArrayDeserializeTest)
     endfunction
   )";
 
-  EXPECT_CALL(toolkit.observer(), Exists("state"));
-  EXPECT_CALL(toolkit.observer(), Read("state", _, _));
+  EXPECT_CALL(toolkit.observer(), ReadBuffer("state", _));
 
   ASSERT_TRUE(toolkit.Compile(deser_src));
 
@@ -359,8 +352,7 @@ TEST_F(StateTests, test_serialisation_of_complex_type)
     endfunction
   )";
 
-  EXPECT_CALL(toolkit.observer(), Exists(state_name));
-  EXPECT_CALL(toolkit.observer(), Read(state_name, _, _));
+  EXPECT_CALL(toolkit.observer(), ReadBuffer(state_name, _));
 
   ASSERT_TRUE(toolkit.Compile(deser_src));
 
@@ -434,8 +426,7 @@ TEST_F(StateTests, test_serialisation_of_complex_type_2)
     endfunction
   )";
 
-  EXPECT_CALL(toolkit.observer(), Exists(state_name));
-  EXPECT_CALL(toolkit.observer(), Read(state_name, _, _)).Times(1);
+  EXPECT_CALL(toolkit.observer(), ReadBuffer(state_name, _));
 
   ASSERT_TRUE(toolkit.Compile(deser_src));
 
@@ -554,8 +545,7 @@ TEST_F(StateTests, test_serialisation_of_structured_data)
   )";
 
   toolkit.setStdout(std::cout);
-  EXPECT_CALL(toolkit.observer(), Exists(state_name));
-  EXPECT_CALL(toolkit.observer(), Read(state_name, _, _)).Times(2);
+  EXPECT_CALL(toolkit.observer(), ReadBuffer(state_name, _));
 
   ASSERT_TRUE(toolkit.Compile(deser_src));
 
@@ -586,7 +576,6 @@ TEST_F(StateTests,
 
   EXPECT_CALL(toolkit.observer(), Write("account", _, _)).Times(2);
   EXPECT_CALL(toolkit.observer(), Read("account", _, _)).Times(2);
-  EXPECT_CALL(toolkit.observer(), Exists("account")).Times(2);
 
   ASSERT_TRUE(toolkit.Compile(TEXT));
   ASSERT_TRUE(toolkit.Run());
@@ -610,8 +599,7 @@ TEST_F(StateTests,
   )";
 
   EXPECT_CALL(toolkit.observer(), Write("name", _, _)).Times(2);
-  EXPECT_CALL(toolkit.observer(), Read("name", _, _)).Times(2);
-  EXPECT_CALL(toolkit.observer(), Exists("name")).Times(2);
+  EXPECT_CALL(toolkit.observer(), ReadBuffer("name", _)).Times(2);
 
   ASSERT_TRUE(toolkit.Compile(TEXT));
   ASSERT_TRUE(toolkit.Run());
@@ -637,7 +625,6 @@ TEST_F(
 
   EXPECT_CALL(toolkit.observer(), Write("account.balance", _, _)).Times(2);
   EXPECT_CALL(toolkit.observer(), Read("account.balance", _, _)).Times(2);
-  EXPECT_CALL(toolkit.observer(), Exists("account.balance")).Times(2);
 
   ASSERT_TRUE(toolkit.Compile(TEXT));
   ASSERT_TRUE(toolkit.Run());
@@ -662,8 +649,7 @@ TEST_F(
   )";
 
   EXPECT_CALL(toolkit.observer(), Write("personal_info.name", _, _)).Times(2);
-  EXPECT_CALL(toolkit.observer(), Read("personal_info.name", _, _)).Times(2);
-  EXPECT_CALL(toolkit.observer(), Exists("personal_info.name")).Times(2);
+  EXPECT_CALL(toolkit.observer(), ReadBuffer("personal_info.name", _)).Times(2);
 
   ASSERT_TRUE(toolkit.Compile(TEXT));
   ASSERT_TRUE(toolkit.Run());
@@ -698,8 +684,7 @@ TEST_F(StateTests, test_serialisation_of_fixed_point32)
     endfunction
   )";
 
-  EXPECT_CALL(toolkit.observer(), Exists(state_name));
-  EXPECT_CALL(toolkit.observer(), Read(state_name, _, _));
+  EXPECT_CALL(toolkit.observer(), ReadBuffer(state_name, _));
 
   ASSERT_TRUE(toolkit.Compile(deser_src));
 
@@ -744,8 +729,7 @@ TEST_F(StateTests, test_serialisation_of_fixed_point64)
       return retrieved_state.get(Array<Fixed64>(0));
     endfunction
   )";
-  EXPECT_CALL(toolkit.observer(), Exists(state_name));
-  EXPECT_CALL(toolkit.observer(), Read(state_name, _, _));
+  EXPECT_CALL(toolkit.observer(), ReadBuffer(state_name, _));
 
   ASSERT_TRUE(toolkit.Compile(deser_src));
 
@@ -789,8 +773,7 @@ TEST_F(StateTests, test_serialisation_of_fixed_point128)
       return retrieved_state.get(Array<Fixed128>(0));
     endfunction
   )";
-  EXPECT_CALL(toolkit.observer(), Exists(state_name));
-  EXPECT_CALL(toolkit.observer(), Read(state_name, _, _));
+  EXPECT_CALL(toolkit.observer(), ReadBuffer(state_name, _));
 
   ASSERT_TRUE(toolkit.Compile(deser_src));
 
@@ -44,6 +44,8 @@ struct Fixed128 : public Object
 
   Ptr<Fixed128> Copy() const;
 
+  std::size_t GetHashCode() override;
+
   bool IsEqual(Ptr<Object> const &lhso, Ptr<Object> const &rhso) override;
   bool IsNotEqual(Ptr<Object> const &lhso, Ptr<Object> const &rhso) override;
   bool IsLessThan(Ptr<Object> const &lhso, Ptr<Object> const &rhso) override;
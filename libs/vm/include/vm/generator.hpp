@@ -493,6 +493,8 @@ private:
                                         IRExpressionNodePtr const &operand);
   void     ScopeEnter();
   void     ScopeLeave(IRBlockNodePtr const &block_node);
+  void     FuseSuperinstructions();
+  void     FuseSuperinstructions(Executable::Function &function);
   uint16_t AddConstant(Variant const &c);
   uint16_t AddLargeConstant(Executable::LargeConstant const &c);
   uint16_t GetInplaceArithmeticOpcode(bool is_primitive, TypeId lhs_type_id, TypeId rhs_type_id,
@@ -17,6 +17,10 @@
 //
 //------------------------------------------------------------------------------
 
+#include "core/byte_array/byte_array.hpp"
+#include "core/byte_array/const_byte_array.hpp"
+
+#include <cstddef>
 #include <cstdint>
 #include <string>
 
@@ -56,6 +60,41 @@ public:
    */
   virtual Status Read(std::string const &key, void *data, uint64_t &size) = 0;
 
+  /**
+   * Read a value from the state store into a shared buffer with a single call
+   *
+   * The default implementation is built on the buffer based Read above. Implementations which
+   * already hold the value in a shared buffer should override it to avoid the copy.
+   *
+   * @param key The key to be accessed
+   * @param data The buffer to be populated with the value
+   * @return OK if the read was successful, PERMISSION_DENIED if the key is incorrect, otherwise
+   * ERROR
+   */
+  virtual Status ReadBuffer(std::string const &key, byte_array::ConstByteArray &data)
+  {
+    byte_array::ByteArray buffer;
+    buffer.Resize(std::size_t{DEFAULT_BUFFER_SIZE});
+
+    uint64_t buffer_size = buffer.size();
+    auto     status      = Read(key, buffer.pointer(), buffer_size);
+
+    // in the case where the initial buffer is too small the value needs to be requested again
+    if (Status::BUFFER_TOO_SMALL == status)
+    {
+      buffer.Resize(buffer_size);
+      status = Read(key, buffer.pointer(), buffer_size);
+    }
+
+    if (Status::OK == status)
+    {
+      buffer.Resize(buffer_size);
+      data = buffer;
+    }
+
+    return status;
+  }
+
   /**
    * Write a value to the state store
    *
@@ -77,6 +116,9 @@ public:
   virtual Status Exists(std::string const &key) = 0;
 
   /// @}
+
+protected:
+  static constexpr std::size_t DEFAULT_BUFFER_SIZE = 256;
 };
 
 }  // namespace vm
@@ -18,11 +18,15 @@
 //------------------------------------------------------------------------------
 
 #include "vectorise/fixed_point/fixed_point.hpp"
+#include "vm/open_hash_map.hpp"
 #include "vm/vm.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
-#include <map>
+#include <cstring>
+#include <functional>
+#include <vector>
 
 namespace fetch {
 namespace vm {
@@ -71,9 +75,76 @@ struct MapComparator<T, IfIsPtr<T>>
   }
 };
 
+template <typename T, typename = void>
+struct MapHasher;
+
+template <typename T>
+struct MapHasher<T, IfIsPrimitive<T>>
+{
+  std::size_t operator()(fetch::vm::TemplateParameter1 const &key) const
+  {
+    static_assert(sizeof(T) <= sizeof(uint64_t), "Primitive keys must fit in 64 bits");
+
+    // hash the bit pattern, which identifies integers and fixed point values alike
+    uint64_t bits{0};
+    T const  value = key.primitive.Get<T>();
+    std::memcpy(&bits, &value, sizeof(T));
+
+    return std::hash<uint64_t>{}(bits);
+  }
+};
+
+template <typename T>
+struct MapHasher<T, IfIsPtr<T>>
+{
+  std::size_t operator()(fetch::vm::TemplateParameter1 const &key) const
+  {
+    return key.object->GetHashCode();
+  }
+};
+
+template <typename T, typename = void>
+struct MapKeyEqual;
+
+template <typename T>
+struct MapKeyEqual<T, IfIsPrimitive<T>>
+{
+  bool operator()(fetch::vm::TemplateParameter1 const &lhs,
+                  fetch::vm::TemplateParameter1 const &rhs) const
+  {
+    T const lhs_value = lhs.primitive.Get<T>();
+    T const rhs_value = rhs.primitive.Get<T>();
+    return std::memcmp(&lhs_value, &rhs_value, sizeof(T)) == 0;
+  }
+};
+
+template <typename T>
+struct MapKeyEqual<T, IfIsPtr<T>>
+{
+  bool operator()(fetch::vm::TemplateParameter1 const &lhs,
+                  fetch::vm::TemplateParameter1 const &rhs) const
+  {
+    return lhs.object->IsEqual(lhs.object, rhs.object);
+  }
+};
+
+/**
+ * The Etch Map type.
+ *
+ * Entries are held in an insertion ordered open addressing hash table, so that lookups and stores
+ * do not walk (or allocate) tree nodes. When a map is serialised its entries are written in
+ * ascending key order, which is the order that the stored representation has always used.
+ *
+ * @tparam Key The key type
+ * @tparam Value The value type
+ */
 template <typename Key, typename Value>
 struct Map : public IMap
 {
+  using Container = OpenHashMap<TemplateParameter1, TemplateParameter2, MapHasher<Key>,
+                                MapKeyEqual<Key>>;
+  using Entry     = typename Container::Entry;
+
   Map(VM *vm, TypeId type_id)
     : IMap(vm, type_id)
   {}
@@ -148,17 +219,30 @@ struct Map : public IMap
 
   bool SerializeTo(MsgPackSerializer &buffer) override
   {
+    // the serialised form lists the entries in key order, independent of their insertion order
+    std::vector<Entry const *> entries;
+    entries.reserve(map.size());
+    for (auto const &entry : map)
+    {
+      entries.push_back(&entry);
+    }
+
+    MapComparator<Key> const comparator{};
+    std::stable_sort(entries.begin(), entries.end(), [&comparator](Entry const *a, Entry const *b) {
+      return comparator(a->first, b->first);
+    });
+
     auto constructor = buffer.NewMapConstructor();
     auto map_ser     = constructor(map.size());
 
-    for (auto const &v : map)
+    for (Entry const *v : entries)
     {
-      auto f1 = [&v, this](MsgPackSerializer &serializer) {
-        return SerializeElement<Key>(serializer, v.first);
+      auto f1 = [v, this](MsgPackSerializer &serializer) {
+        return SerializeElement<Key>(serializer, v->first);
       };
 
-      auto f2 = [&v, this](MsgPackSerializer &serializer) {
-        return SerializeElement<Value>(serializer, v.second);
+      auto f2 = [v, this](MsgPackSerializer &serializer) {
+        return SerializeElement<Value>(serializer, v->second);
       };
 
       if (!map_ser.AppendUsingFunction(f1, f2))
@@ -201,7 +285,7 @@ struct Map : public IMap
     return true;
   }
 
-  std::map<TemplateParameter1, TemplateParameter2, MapComparator<Key>> map;
+  Container map;
 
 private:
   template <typename U, typename TemplateParameterType>
@@ -0,0 +1,122 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/common.hpp"
+#include "vm/generator.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__linux__) || defined(__APPLE__))
+#define FETCH_VM_NATIVE_CODE_SUPPORTED 1
+#else
+#define FETCH_VM_NATIVE_CODE_SUPPORTED 0
+#endif
+
+namespace fetch {
+namespace vm {
+
+class VM;
+
+/**
+ * The state which is passed between the VM and a native function
+ */
+struct NativeFrame
+{
+  void *       variables{nullptr};  ///< The first variable of the frame on the stack
+  void *       loops{nullptr};      ///< The first free entry of the range loop stack
+  ChargeAmount charge_total{0};
+  ChargeAmount charge_limit{0};  ///< The charge limit, where no limit is the maximum charge amount
+};
+
+/**
+ * A function of an executable which has been compiled to native code.
+ *
+ * The native code is entered at the first instruction of the function and runs until it reaches
+ * an instruction it does not execute itself, which is either a return or an instruction that needs
+ * the interpreter to reproduce its exact behaviour (for example one which raises a runtime error,
+ * or one which would reach the charge limit). It then returns the index of that instruction, with
+ * the stack, the range loops and the charge total in exactly the state in which the interpreter
+ * would have reached it, so that the interpreter can simply continue from there.
+ *
+ * The depths of the operand stack and of the range loop stack are the same every time an
+ * instruction is reached, so they are recorded for each instruction at compile time rather than
+ * being tracked by the native code.
+ */
+class NativeFunction
+{
+public:
+  using Depths = std::vector<uint16_t>;
+
+  // Construction / Destruction
+  NativeFunction(std::vector<uint8_t> const &code, Depths stack_depths, Depths loop_depths);
+  NativeFunction(NativeFunction const &) = delete;
+  NativeFunction(NativeFunction &&)      = delete;
+  ~NativeFunction();
+
+  bool     IsValid() const;
+  uint16_t Run(NativeFrame &frame) const;
+
+  int stack_depth(uint16_t pc) const;
+  int loop_depth(uint16_t pc) const;
+  int max_stack_depth() const;
+  int max_loop_depth() const;
+
+  // Operators
+  NativeFunction &operator=(NativeFunction const &) = delete;
+  NativeFunction &operator=(NativeFunction &&) = delete;
+
+private:
+  using Entry = uint32_t (*)(NativeFrame *);
+
+  void *      code_{nullptr};
+  std::size_t size_{0};
+  Depths      stack_depths_;
+  Depths      loop_depths_;
+  int         max_stack_depth_{0};
+  int         max_loop_depth_{0};
+};
+
+using NativeFunctionPtr = std::unique_ptr<NativeFunction>;
+
+/**
+ * Compiles the functions of an executable to x86-64 machine code.
+ *
+ * Only functions which contain a loop, and which operate purely on the Bool, Int32, UInt32, Int64
+ * and UInt64 types with local variables, constants, arithmetic, comparisons, branches and range
+ * loops are compiled. Anything else (objects, strings, fixed point, function calls, member access)
+ * is left to the interpreter.
+ *
+ * Charges are made once at the entry to each basic block for all of its instructions. A block is
+ * only entered when it cannot reach the charge limit, otherwise the native code returns to the
+ * interpreter at the start of the block so that the limit is reached at exactly the same
+ * instruction. An instruction which leaves a block early refunds the charge for the instructions
+ * which have not been executed.
+ */
+class NativeCompiler
+{
+public:
+  static NativeFunctionPtr Compile(VM const &vm, Executable const &executable,
+                                   Executable::Function const &function);
+};
+
+}  // namespace vm
+}  // namespace fetch
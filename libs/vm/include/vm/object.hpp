@@ -22,6 +22,7 @@
 #include "variant/variant.hpp"
 #include "vectorise/fixed_point/fixed_point.hpp"
 #include "vm/common.hpp"
+#include "vm/object_pool.hpp"
 
 #include <type_traits>
 
@@ -149,6 +150,19 @@ public:
     , ref_count_(1)
   {}
 
+  /// @name Allocation
+  /// @{
+  static void *operator new(std::size_t size)
+  {
+    return ObjectPool::Allocate(size);
+  }
+
+  static void operator delete(void *ptr) noexcept
+  {
+    ObjectPool::Deallocate(ptr);
+  }
+  /// @}
+
   virtual std::size_t GetHashCode();
   virtual bool        IsEqual(Ptr<Object> const &lhso, Ptr<Object> const &rhso);
   virtual bool        IsNotEqual(Ptr<Object> const &lhso, Ptr<Object> const &rhso);
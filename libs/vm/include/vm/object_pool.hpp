@@ -0,0 +1,115 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace fetch {
+namespace vm {
+
+/**
+ * A pool allocator for the VM objects created during an execution.
+ *
+ * Every VM owns a pool, which is made the active pool of the calling thread for the duration of
+ * VM::Execute. Objects allocated while a pool is active are carved from large chunks with a bump
+ * pointer, and when they are released their blocks are kept on per size class free lists for
+ * reuse by later allocations rather than being returned to the heap. Chunks which no longer hold
+ * any live objects are released at the end of every execution, and the rest are released
+ * together when the pool is destroyed.
+ *
+ * Objects can outlive the execution (and the VM) which created them, for example when they are
+ * returned as the output of a function or kept by the host. When the pool is destroyed any chunk
+ * which still holds live objects is orphaned instead of being released, and it is freed by the
+ * release of its last object. Objects which are allocated while no pool is active, or which are
+ * too large to be pooled, fall back to the heap.
+ *
+ * The pool follows the same threading rules as the reference counts of vm::Ptr: an object must
+ * not be released concurrently with the execution of the VM which created it.
+ */
+class ObjectPool
+{
+public:
+  /**
+   * Makes a pool the active pool of the calling thread for the lifetime of the scope
+   */
+  class Scope
+  {
+  public:
+    explicit Scope(ObjectPool &pool);
+    Scope(Scope const &) = delete;
+    Scope(Scope &&)      = delete;
+    ~Scope();
+
+    Scope &operator=(Scope const &) = delete;
+    Scope &operator=(Scope &&) = delete;
+
+  private:
+    ObjectPool *previous_;
+  };
+
+  static constexpr std::size_t GRANULARITY     = 16;
+  static constexpr std::size_t MAX_POOLED_SIZE = 256;
+  static constexpr std::size_t CHUNK_SIZE      = 64 * 1024;
+
+  // Construction / Destruction
+  ObjectPool() = default;
+  ObjectPool(ObjectPool const &) = delete;
+  ObjectPool(ObjectPool &&)      = delete;
+  ~ObjectPool();
+
+  /// @name Allocation
+  /// @{
+  static void *Allocate(std::size_t size);
+  static void  Deallocate(void *ptr) noexcept;
+  /// @}
+
+  void        ReleaseFreeChunks();
+  std::size_t chunk_count() const;
+
+  // Operators
+  ObjectPool &operator=(ObjectPool const &) = delete;
+  ObjectPool &operator=(ObjectPool &&) = delete;
+
+private:
+  static constexpr std::size_t NUM_SIZE_CLASSES = MAX_POOLED_SIZE / GRANULARITY;
+
+  struct Chunk;
+  struct Header;
+
+  struct FreeBlock
+  {
+    FreeBlock *next;
+  };
+
+  using FreeLists = std::array<FreeBlock *, NUM_SIZE_CLASSES>;
+  using Chunks    = std::vector<Chunk *>;
+
+  void *AllocateBlock(std::size_t size_class);
+  void  NewChunk();
+
+  static thread_local ObjectPool *active_;
+
+  FreeLists   free_lists_{};
+  Chunks      chunks_{};
+  std::size_t chunk_offset_{CHUNK_SIZE};  ///< The bump offset into the newest chunk
+};
+
+}  // namespace vm
+}  // namespace fetch
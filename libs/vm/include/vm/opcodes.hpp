@@ -127,7 +127,9 @@ static constexpr uint16_t MemberVariablePrimitiveInplaceModulo     = 100;
 static constexpr uint16_t PushSelf                                 = 101;
 static constexpr uint16_t InvokeUserDefinedConstructor             = 102;
 static constexpr uint16_t InvokeUserDefinedMemberFunction          = 103;
-static constexpr uint16_t NumReserved                              = 104;
+static constexpr uint16_t FusedPushLocalVariable                   = 104;
+static constexpr uint16_t FusedPushConstant                        = 105;
+static constexpr uint16_t NumReserved                              = 106;
 }  // namespace Opcodes
 
 }  // namespace vm
@@ -0,0 +1,346 @@
+#pragma once
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace vm {
+
+/**
+ * An insertion ordered hash map using open addressing.
+ *
+ * The entries are stored densely in the order in which they were first inserted, and a separate
+ * power of two sized table of slots maps each hash to the index of its entry, resolving collisions
+ * by linear probing. A lookup is therefore a hash, a short scan of adjacent slots and a single key
+ * comparison, rather than a walk of a node allocated tree. Because iteration visits the dense
+ * entries its order only depends on the sequence of insertions, never on the hash values, which
+ * keeps it identical on every node.
+ *
+ * Entries can not be erased, which matches the operations available to Etch maps.
+ *
+ * @tparam Key The key type
+ * @tparam Value The value type
+ * @tparam Hash The hash functor for the key
+ * @tparam Equal The equality functor for the key
+ */
+template <typename Key, typename Value, typename Hash, typename Equal>
+class OpenHashMap
+{
+public:
+  using Entry          = std::pair<Key, Value>;
+  using Entries        = std::vector<Entry>;
+  using iterator       = typename Entries::iterator;
+  using const_iterator = typename Entries::const_iterator;
+
+  // Construction / Destruction
+  OpenHashMap()                        = default;
+  OpenHashMap(OpenHashMap const &)     = default;
+  OpenHashMap(OpenHashMap &&) noexcept = default;
+  ~OpenHashMap()                       = default;
+
+  /// @name Iteration
+  /// @{
+  iterator       begin();
+  iterator       end();
+  const_iterator begin() const;
+  const_iterator end() const;
+  /// @}
+
+  std::size_t size() const;
+  bool        empty() const;
+
+  iterator       find(Key const &key);
+  const_iterator find(Key const &key) const;
+
+  std::pair<iterator, bool> insert(Entry const &entry);
+  Value &                   operator[](Key const &key);
+
+  void reserve(std::size_t count);
+  void clear();
+
+  // Operators
+  OpenHashMap &operator=(OpenHashMap const &) = default;
+  OpenHashMap &operator=(OpenHashMap &&) noexcept = default;
+
+private:
+  /**
+   * A slot in the probe table. The hash is cached so that probing only compares keys whose hashes
+   * match, and so that the table can be rebuilt without hashing the keys again.
+   */
+  struct Slot
+  {
+    uint32_t index{EMPTY};  ///< The index of the entry, or EMPTY
+    uint32_t hash{0};       ///< The (truncated) hash of the entry's key
+  };
+
+  using Slots = std::vector<Slot>;
+
+  static constexpr uint32_t    EMPTY     = std::numeric_limits<uint32_t>::max();
+  static constexpr std::size_t MIN_SLOTS = 8;
+
+  static uint32_t Mix(std::size_t hash);
+
+  uint32_t    IndexOf(Key const &key) const;
+  std::size_t Locate(Key const &key, uint32_t hash) const;
+  void        Rehash(std::size_t slot_count);
+
+  Entries     entries_{};
+  Slots       slots_{};
+  std::size_t mask_{0};
+  Hash        hash_{};
+  Equal       equal_{};
+};
+
+template <typename K, typename V, typename H, typename E>
+typename OpenHashMap<K, V, H, E>::iterator OpenHashMap<K, V, H, E>::begin()
+{
+  return entries_.begin();
+}
+
+template <typename K, typename V, typename H, typename E>
+typename OpenHashMap<K, V, H, E>::iterator OpenHashMap<K, V, H, E>::end()
+{
+  return entries_.end();
+}
+
+template <typename K, typename V, typename H, typename E>
+typename OpenHashMap<K, V, H, E>::const_iterator OpenHashMap<K, V, H, E>::begin() const
+{
+  return entries_.begin();
+}
+
+template <typename K, typename V, typename H, typename E>
+typename OpenHashMap<K, V, H, E>::const_iterator OpenHashMap<K, V, H, E>::end() const
+{
+  return entries_.end();
+}
+
+template <typename K, typename V, typename H, typename E>
+std::size_t OpenHashMap<K, V, H, E>::size() const
+{
+  return entries_.size();
+}
+
+template <typename K, typename V, typename H, typename E>
+bool OpenHashMap<K, V, H, E>::empty() const
+{
+  return entries_.empty();
+}
+
+/**
+ * Look up the entry for a key
+ *
+ * @param key The key to search for
+ * @return The iterator to the entry, or end() if the key is not present
+ */
+template <typename K, typename V, typename H, typename E>
+typename OpenHashMap<K, V, H, E>::iterator OpenHashMap<K, V, H, E>::find(K const &key)
+{
+  uint32_t const index = IndexOf(key);
+  return (index == EMPTY) ? entries_.end() : entries_.begin() + index;
+}
+
+template <typename K, typename V, typename H, typename E>
+typename OpenHashMap<K, V, H, E>::const_iterator OpenHashMap<K, V, H, E>::find(K const &key) const
+{
+  uint32_t const index = IndexOf(key);
+  return (index == EMPTY) ? entries_.end() : entries_.begin() + index;
+}
+
+/**
+ * Insert an entry if its key is not already present
+ *
+ * @param entry The key and value to insert
+ * @return The iterator to the entry for the key, and true if the entry was inserted
+ */
+template <typename K, typename V, typename H, typename E>
+std::pair<typename OpenHashMap<K, V, H, E>::iterator, bool> OpenHashMap<K, V, H, E>::insert(
+    Entry const &entry)
+{
+  // keep the load factor at or below 3/4 so that probe sequences stay short
+  if ((entries_.size() + 1) * 4 > slots_.size() * 3)
+  {
+    Rehash(std::max(std::size_t{MIN_SLOTS}, slots_.size() * 2));
+  }
+
+  uint32_t const hash = Mix(hash_(entry.first));
+  Slot &         slot = slots_[Locate(entry.first, hash)];
+
+  if (slot.index != EMPTY)
+  {
+    return {entries_.begin() + slot.index, false};
+  }
+
+  assert(entries_.size() < EMPTY);
+
+  slot.index = static_cast<uint32_t>(entries_.size());
+  slot.hash  = hash;
+  entries_.push_back(entry);
+
+  return {entries_.end() - 1, true};
+}
+
+/**
+ * Access the value for a key, inserting a default constructed value if it is not present
+ *
+ * @param key The key to look up
+ * @return The reference to the value
+ */
+template <typename K, typename V, typename H, typename E>
+V &OpenHashMap<K, V, H, E>::operator[](K const &key)
+{
+  auto it = find(key);
+  if (it == entries_.end())
+  {
+    it = insert({key, V{}}).first;
+  }
+
+  return it->second;
+}
+
+/**
+ * Size the table so that the specified number of entries can be held without rehashing
+ *
+ * @param count The number of entries
+ */
+template <typename K, typename V, typename H, typename E>
+void OpenHashMap<K, V, H, E>::reserve(std::size_t count)
+{
+  std::size_t slot_count{MIN_SLOTS};
+  while (count * 4 > slot_count * 3)
+  {
+    slot_count *= 2;
+  }
+
+  if (slot_count > slots_.size())
+  {
+    Rehash(slot_count);
+  }
+
+  entries_.reserve(count);
+}
+
+template <typename K, typename V, typename H, typename E>
+void OpenHashMap<K, V, H, E>::clear()
+{
+  entries_.clear();
+  slots_.clear();
+  mask_ = 0;
+}
+
+/**
+ * Spread the bits of a key hash so that keys with regular patterns (for example consecutive,
+ * aligned or high bit only integers, which std::hash maps to themselves) still occupy distinct
+ * slots. This is the splitmix64 finaliser, after which every bit of the result (and so every slot
+ * index taken from its low bits) depends on every bit of the hash.
+ */
+template <typename K, typename V, typename H, typename E>
+uint32_t OpenHashMap<K, V, H, E>::Mix(std::size_t hash)
+{
+  auto value = static_cast<uint64_t>(hash);
+
+  value ^= value >> 30u;
+  value *= 0xbf58476d1ce4e5b9ull;
+  value ^= value >> 27u;
+  value *= 0x94d049bb133111ebull;
+  value ^= value >> 31u;
+
+  return static_cast<uint32_t>(value);
+}
+
+/**
+ * Determine the index of the entry for a key
+ *
+ * @param key The key to search for
+ * @return The index of the entry, or EMPTY if the key is not present
+ */
+template <typename K, typename V, typename H, typename E>
+uint32_t OpenHashMap<K, V, H, E>::IndexOf(K const &key) const
+{
+  if (entries_.empty())
+  {
+    return EMPTY;
+  }
+
+  return slots_[Locate(key, Mix(hash_(key)))].index;
+}
+
+/**
+ * Find the slot holding a key, or the empty slot at which it would be inserted. The table must
+ * contain at least one empty slot.
+ *
+ * @param key The key to search for
+ * @param hash The mixed hash of the key
+ * @return The index of the slot
+ */
+template <typename K, typename V, typename H, typename E>
+std::size_t OpenHashMap<K, V, H, E>::Locate(K const &key, uint32_t hash) const
+{
+  std::size_t position = hash & mask_;
+
+  for (;;)
+  {
+    Slot const &slot = slots_[position];
+
+    if ((slot.index == EMPTY) ||
+        ((slot.hash == hash) && equal_(entries_[slot.index].first, key)))
+    {
+      return position;
+    }
+
+    position = (position + 1) & mask_;
+  }
+}
+
+/**
+ * Rebuild the probe table with a new number of slots
+ *
+ * @param slot_count The new number of slots, which must be a power of two
+ */
+template <typename K, typename V, typename H, typename E>
+void OpenHashMap<K, V, H, E>::Rehash(std::size_t slot_count)
+{
+  Slots previous{std::move(slots_)};
+
+  slots_.assign(slot_count, Slot{});
+  mask_ = slot_count - 1;
+
+  for (Slot const &slot : previous)
+  {
+    if (slot.index != EMPTY)
+    {
+      std::size_t position = slot.hash & mask_;
+      while (slots_[position].index != EMPTY)
+      {
+        position = (position + 1) & mask_;
+      }
+
+      slots_[position] = slot;
+    }
+  }
+}
+
+}  // namespace vm
+}  // namespace fetch
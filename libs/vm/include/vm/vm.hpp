@@ -20,7 +20,9 @@
 #include "math/arithmetic/comparison.hpp"
 #include "vm/common.hpp"
 #include "vm/generator.hpp"
+#include "vm/native_code.hpp"
 #include "vm/object.hpp"
+#include "vm/object_pool.hpp"
 #include "vm/opcode_charges.hpp"
 #include "vm/opcodes.hpp"
 #include "vm/string.hpp"
@@ -493,6 +495,7 @@ public:
     }
 
     executable_ = nullptr;
+    native_functions_.clear();
   }
 
   TypeInfo const &GetTypeInfo(TypeId type_id) const
@@ -594,6 +597,12 @@ public:
 
   void UpdateCharges(std::unordered_map<std::string, ChargeAmount> const &opcode_static_charges);
 
+  /**
+   * Enable or disable the compilation of suitable functions to native code. Disabled by default.
+   */
+  void SetNativeCodeEnabled(bool enabled);
+  bool IsNativeCodeEnabled() const;
+
 private:
   static const int FRAME_STACK_SIZE = 50;
   static const int STACK_SIZE       = 1024;
@@ -643,6 +652,9 @@ private:
   template <int, typename, typename, typename>
   friend struct VmMemberFunctionInvoker;
 
+  using NativeFunctionMap = std::unordered_map<Executable::Function const *, NativeFunctionPtr>;
+
+  ObjectPool                     object_pool_;  ///< Declared first so that it is destroyed last
   TypeInfoArray                  type_info_array_;
   TypeInfoMap                    type_info_map_;
   RegisteredTypes                registered_types_;
@@ -681,6 +693,12 @@ private:
   ChargeAmount charge_total_{0};
   /// @}
 
+  /// @name Native Code
+  /// @{
+  bool              native_code_enabled_{false};
+  NativeFunctionMap native_functions_;  ///< Compiled functions, or nullptr if not compilable
+  /// @}
+
   void AddOpcodeInfo(uint16_t opcode, std::string unique_name, Handler handler,
                      ChargeAmount static_charge = 1)
   {
@@ -688,8 +706,12 @@ private:
         OpcodeInfo(std::move(unique_name), std::move(handler), static_charge);
   }
 
-  bool Execute(std::string &error, Variant &output);
-  void Destruct(uint16_t scope_number);
+  bool         Execute(std::string &error, Variant &output);
+  bool         ExecuteFusedBinaryOp(Variant const &lhs_operand);
+  ChargeAmount StaticCharge(uint16_t opcode) const;
+  void         SynchroniseFusedCharges();
+  void         ExecuteNativeCode();
+  void         Destruct(uint16_t scope_number);
 
   TypeId FindType(std::string const &name) const
   {
@@ -1985,10 +2007,13 @@ private:
   void Handler__PushSelf();
   void Handler__InvokeUserDefinedConstructor();
   void Handler__InvokeUserDefinedMemberFunction();
+  void Handler__FusedPushLocalVariable();
+  void Handler__FusedPushConstant();
 
   friend class Object;
   friend class Module;
   friend class Generator;
+  friend class NativeCompiler;
 };
 
 template <typename T>
@@ -20,6 +20,9 @@
 #include "vm/opcode_charges.hpp"
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 
 namespace fetch {
 namespace vm {
@@ -44,6 +47,12 @@ Ptr<Fixed128> Fixed128::Copy() const
   return Ptr<Fixed128>{new Fixed128{this->vm_, this->data_}};
 }
 
+std::size_t Fixed128::GetHashCode()
+{
+  auto const bits = static_cast<uint128_t>(data_.Data());
+  return std::hash<uint64_t>{}(static_cast<uint64_t>(bits) ^ static_cast<uint64_t>(bits >> 64u));
+}
+
 bool Fixed128::IsEqual(Ptr<Object> const &lhso, Ptr<Object> const &rhso)
 {
   Ptr<Fixed128> lhs = lhso;
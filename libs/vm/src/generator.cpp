@@ -29,6 +29,61 @@
 
 namespace fetch {
 namespace vm {
+namespace {
+
+/**
+ * Get the opcode of the superinstruction headed by an operand push
+ *
+ * @param opcode The opcode of the head instruction
+ * @return The superinstruction opcode, or Opcodes::Unknown if the instruction can not be a head
+ */
+uint16_t FusedOpcode(uint16_t opcode)
+{
+  switch (opcode)
+  {
+  case Opcodes::PushLocalVariable:
+    return Opcodes::FusedPushLocalVariable;
+  case Opcodes::PushConstant:
+    return Opcodes::FusedPushConstant;
+  default:
+    return Opcodes::Unknown;
+  }
+}
+
+bool IsOperandPush(uint16_t opcode)
+{
+  return (opcode == Opcodes::PushLocalVariable) || (opcode == Opcodes::PushConstant);
+}
+
+/**
+ * Determine if a primitive binary op and the instruction which consumes its result can complete a
+ * superinstruction.
+ *
+ * NOTE: Must be kept in step with VM::ExecuteFusedBinaryOp
+ */
+bool IsFusableBinaryOp(uint16_t opcode, uint16_t consumer_opcode)
+{
+  switch (opcode)
+  {
+  case Opcodes::PrimitiveAdd:
+  case Opcodes::PrimitiveSubtract:
+  case Opcodes::PrimitiveMultiply:
+  case Opcodes::PrimitiveDivide:
+  case Opcodes::PrimitiveModulo:
+    return consumer_opcode == Opcodes::PopToLocalVariable;
+  case Opcodes::PrimitiveEqual:
+  case Opcodes::PrimitiveNotEqual:
+  case Opcodes::PrimitiveLessThan:
+  case Opcodes::PrimitiveLessThanOrEqual:
+  case Opcodes::PrimitiveGreaterThan:
+  case Opcodes::PrimitiveGreaterThanOrEqual:
+    return (consumer_opcode == Opcodes::JumpIfFalse) || (consumer_opcode == Opcodes::JumpIfTrue);
+  default:
+    return false;
+  }
+}
+
+}  // namespace
 
 void Generator::Initialise(VM *vm, uint16_t num_system_types)
 {
@@ -88,6 +143,11 @@ bool Generator::GenerateExecutable(IR const &ir, std::string const &executable_n
     errors_.emplace_back(e.message);
   }
 
+  if (errors_.empty())
+  {
+    FuseSuperinstructions();
+  }
+
   scopes_.clear();
   loops_.clear();
   strings_map_.clear();
@@ -2106,6 +2166,63 @@ void Generator::ScopeLeave(IRBlockNodePtr const &block_node)
   scopes_.pop_back();
 }
 
+void Generator::FuseSuperinstructions()
+{
+  for (auto &function : executable_.functions)
+  {
+    FuseSuperinstructions(function);
+  }
+
+  for (auto &contract : executable_.contracts)
+  {
+    for (auto &function : contract.functions)
+    {
+      FuseSuperinstructions(function);
+    }
+  }
+
+  for (auto &type : executable_.user_defined_types)
+  {
+    for (auto &function : type.functions)
+    {
+      FuseSuperinstructions(function);
+    }
+  }
+}
+
+/**
+ * Fuse the common sequence of two operand pushes, a primitive binary op and the instruction which
+ * consumes its result (a store to a local variable, or a conditional jump) into a superinstruction
+ * which the VM executes with a single dispatch and without using the stack.
+ *
+ * Only the opcode of the head push is replaced. The other three instructions are left in place, so
+ * the instruction layout, jump targets and line numbers are all unchanged, a jump into the middle
+ * of the sequence executes the original instructions from that point, and the VM can fall back to
+ * executing the head as a plain push whenever fusion could change the outcome.
+ *
+ * @param function The function to optimise
+ */
+void Generator::FuseSuperinstructions(Executable::Function &function)
+{
+  auto &instructions = function.instructions;
+
+  std::size_t pc = 0;
+  while ((pc + 3) < instructions.size())
+  {
+    auto &head = instructions[pc];
+
+    if (IsOperandPush(head.opcode) && IsOperandPush(instructions[pc + 1].opcode) &&
+        IsFusableBinaryOp(instructions[pc + 2].opcode, instructions[pc + 3].opcode))
+    {
+      head.opcode = FusedOpcode(head.opcode);
+      pc += 4;
+      continue;
+    }
+
+    ++pc;
+  }
+}
+
 uint16_t Generator::AddConstant(Variant const &c)
 {
   uint16_t index;
@@ -0,0 +1,1419 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/native_code.hpp"
+#include "vm/opcodes.hpp"
+#include "vm/variant.hpp"
+#include "vm/vm.hpp"
+
+#if FETCH_VM_NATIVE_CODE_SUPPORTED
+#include <sys/mman.h>
+#endif
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace fetch {
+namespace vm {
+namespace {
+
+using Instruction = Executable::Instruction;
+using Charges     = std::vector<ChargeAmount>;
+
+enum Register : uint8_t
+{
+  RAX = 0,
+  RCX = 1,
+  RDX = 2,
+  RSI = 6,
+  RDI = 7,
+  R8  = 8,
+  R9  = 9,
+  R10 = 10,
+  R11 = 11
+};
+
+enum class Width
+{
+  BYTE,
+  WORD,
+  DWORD,
+  QWORD
+};
+
+enum Condition : uint8_t
+{
+  BELOW            = 0x2,
+  ABOVE_OR_EQUAL   = 0x3,
+  EQUAL            = 0x4,
+  NOT_EQUAL        = 0x5,
+  BELOW_OR_EQUAL   = 0x6,
+  ABOVE            = 0x7,
+  LESS             = 0xC,
+  GREATER_OR_EQUAL = 0xD,
+  LESS_OR_EQUAL    = 0xE,
+  GREATER          = 0xF
+};
+
+enum Operation : uint8_t
+{
+  ADD = 0,
+  SUB = 5,
+  CMP = 7
+};
+
+constexpr std::size_t UNBOUND = std::numeric_limits<std::size_t>::max();
+
+/**
+ * A minimal x86-64 assembler for the instructions emitted by the native compiler. Memory operands
+ * are always of the form [base + disp32].
+ */
+class Assembler
+{
+public:
+  using Label = std::size_t;
+
+  Label NewLabel()
+  {
+    labels_.push_back(UNBOUND);
+    return labels_.size() - 1;
+  }
+
+  void Bind(Label label)
+  {
+    labels_[label] = code_.size();
+  }
+
+  void Jump(Label label)
+  {
+    Byte(0xE9);
+    Fixup(label);
+  }
+
+  void JumpIf(Condition condition, Label label)
+  {
+    Byte(0x0F);
+    Byte(uint8_t(0x80 | condition));
+    Fixup(label);
+  }
+
+  /**
+   * Load a value from memory into a register, zero extending bytes and words
+   */
+  void Load(Width width, Register dst, Register base, int32_t disp)
+  {
+    Rex(width == Width::QWORD, dst, base);
+    if (width == Width::BYTE)
+    {
+      Byte(0x0F);
+      Byte(0xB6);
+    }
+    else if (width == Width::WORD)
+    {
+      Byte(0x0F);
+      Byte(0xB7);
+    }
+    else
+    {
+      Byte(0x8B);
+    }
+    Memory(dst, base, disp);
+  }
+
+  void Store(Width width, Register base, int32_t disp, Register src)
+  {
+    if (width == Width::WORD)
+    {
+      Byte(0x66);
+    }
+    Rex(width == Width::QWORD, src, base, (width == Width::BYTE) && (src >= 4));
+    Byte((width == Width::BYTE) ? 0x88 : 0x89);
+    Memory(src, base, disp);
+  }
+
+  void StoreImmediate(Width width, Register base, int32_t disp, int32_t value)
+  {
+    if (width == Width::WORD)
+    {
+      Byte(0x66);
+    }
+    Rex(width == Width::QWORD, 0, base);
+    Byte((width == Width::BYTE) ? 0xC6 : 0xC7);
+    Memory(0, base, disp);
+
+    std::size_t const size = (width == Width::BYTE) ? 1u : (width == Width::WORD) ? 2u : 4u;
+    Immediate(static_cast<uint32_t>(value), size);
+  }
+
+  void LoadImmediate(Register dst, uint64_t value)
+  {
+    // a 32 bit move is zero extended into the full register
+    bool const wide = value > std::numeric_limits<uint32_t>::max();
+    Rex(wide, 0, dst);
+    Byte(uint8_t(0xB8 | (dst & 7)));
+    Immediate(value, wide ? 8u : 4u);
+  }
+
+  void Move(Register dst, Register src)
+  {
+    Rex(true, dst, src);
+    Byte(0x8B);
+    Direct(dst, src);
+  }
+
+  void Arithmetic(Operation operation, Width width, Register dst, Register base, int32_t disp)
+  {
+    Rex(width == Width::QWORD, dst, base);
+    Byte(uint8_t((operation << 3) | 0x03));
+    Memory(dst, base, disp);
+  }
+
+  void Arithmetic(Operation operation, Width width, Register dst, Register src)
+  {
+    Rex(width == Width::QWORD, dst, src);
+    Byte(uint8_t((operation << 3) | 0x03));
+    Direct(dst, src);
+  }
+
+  void ArithmeticImmediate(Operation operation, Width width, Register dst, int32_t value)
+  {
+    Rex(width == Width::QWORD, 0, dst);
+    Byte(0x81);
+    Direct(operation, dst);
+    Immediate(static_cast<uint32_t>(value), 4);
+  }
+
+  void Multiply(Width width, Register dst, Register base, int32_t disp)
+  {
+    Rex(width == Width::QWORD, dst, base);
+    Byte(0x0F);
+    Byte(0xAF);
+    Memory(dst, base, disp);
+  }
+
+  void Negate(Width width, Register reg)
+  {
+    Rex(width == Width::QWORD, 0, reg);
+    Byte(0xF7);
+    Direct(3, reg);
+  }
+
+  /**
+   * Divide rax by a register, leaving the quotient in rax and the remainder in rdx
+   */
+  void Divide(bool is_signed, Width width, Register divisor)
+  {
+    bool const wide = width == Width::QWORD;
+    if (is_signed)
+    {
+      // cdq / cqo
+      Rex(wide, 0, 0);
+      Byte(0x99);
+    }
+    else
+    {
+      // xor edx, edx
+      Byte(0x33);
+      Direct(RDX, RDX);
+    }
+    Rex(wide, 0, divisor);
+    Byte(0xF7);
+    Direct(is_signed ? 7 : 6, divisor);
+  }
+
+  void Test(Width width, Register lhs, Register rhs)
+  {
+    Rex(width == Width::QWORD, rhs, lhs);
+    Byte(0x85);
+    Direct(rhs, lhs);
+  }
+
+  void SetIf(Condition condition, Register dst)
+  {
+    Rex(false, 0, dst, dst >= 4);
+    Byte(0x0F);
+    Byte(uint8_t(0x90 | condition));
+    Direct(0, dst);
+  }
+
+  void Return()
+  {
+    Byte(0xC3);
+  }
+
+  std::vector<uint8_t> Finish()
+  {
+    for (auto const &fixup : fixups_)
+    {
+      std::size_t const target = labels_[fixup.second];
+      assert(target != UNBOUND);
+
+      auto const offset = static_cast<int32_t>(static_cast<int64_t>(target) -
+                                               static_cast<int64_t>(fixup.first + 4));
+      std::memcpy(&code_[fixup.first], &offset, sizeof(offset));
+    }
+
+    return std::move(code_);
+  }
+
+private:
+  using Fixups = std::vector<std::pair<std::size_t, Label>>;
+
+  void Byte(uint8_t value)
+  {
+    code_.push_back(value);
+  }
+
+  void Immediate(uint64_t value, std::size_t size)
+  {
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      Byte(uint8_t(value >> (8u * i)));
+    }
+  }
+
+  void Rex(bool wide, uint8_t reg, uint8_t rm, bool force = false)
+  {
+    auto const rex = uint8_t(0x40 | (wide ? 0x08 : 0x00) | ((reg & 8) >> 1) | ((rm & 8) >> 3));
+    if ((rex != 0x40) || force)
+    {
+      Byte(rex);
+    }
+  }
+
+  void Direct(uint8_t reg, uint8_t rm)
+  {
+    Byte(uint8_t(0xC0 | ((reg & 7) << 3) | (rm & 7)));
+  }
+
+  void Memory(uint8_t reg, Register base, int32_t disp)
+  {
+    // rsp and r12 would need a SIB byte and are never used as a base
+    assert((base & 7) != 4);
+    Byte(uint8_t(0x80 | ((reg & 7) << 3) | (base & 7)));
+    Immediate(static_cast<uint32_t>(disp), 4);
+  }
+
+  void Fixup(Label label)
+  {
+    fixups_.emplace_back(code_.size(), label);
+    Immediate(0, 4);
+  }
+
+  std::vector<uint8_t>     code_;
+  std::vector<std::size_t> labels_;
+  Fixups                   fixups_;
+};
+
+bool IsIntegral(TypeId type_id)
+{
+  return (type_id == TypeIds::Int32) || (type_id == TypeIds::UInt32) ||
+         (type_id == TypeIds::Int64) || (type_id == TypeIds::UInt64);
+}
+
+bool IsSupportedType(TypeId type_id)
+{
+  return (type_id == TypeIds::Bool) || IsIntegral(type_id);
+}
+
+bool IsSigned(TypeId type_id)
+{
+  return (type_id == TypeIds::Int32) || (type_id == TypeIds::Int64);
+}
+
+Width WidthOf(TypeId type_id)
+{
+  if (type_id == TypeIds::Bool)
+  {
+    return Width::BYTE;
+  }
+
+  return ((type_id == TypeIds::Int32) || (type_id == TypeIds::UInt32)) ? Width::DWORD
+                                                                       : Width::QWORD;
+}
+
+bool IsBranch(uint16_t opcode)
+{
+  switch (opcode)
+  {
+  case Opcodes::Break:
+  case Opcodes::Continue:
+  case Opcodes::Jump:
+  case Opcodes::JumpIfFalse:
+  case Opcodes::JumpIfTrue:
+  case Opcodes::JumpIfFalseOrPop:
+  case Opcodes::JumpIfTrueOrPop:
+  case Opcodes::ForRangeIterate:
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool IsReturn(uint16_t opcode)
+{
+  return (opcode == Opcodes::Return) || (opcode == Opcodes::ReturnValue);
+}
+
+ChargeAmount AddCharge(ChargeAmount total, ChargeAmount amount)
+{
+  if ((std::numeric_limits<ChargeAmount>::max() - total) < amount)
+  {
+    return std::numeric_limits<ChargeAmount>::max();
+  }
+
+  return total + amount;
+}
+
+/**
+ * The offsets of the fields of the VM structures accessed by the native code
+ */
+struct Layout
+{
+  int32_t variant_size{};
+  int32_t primitive{};
+  int32_t type_id{};
+  int32_t loop_size{};
+  int32_t loop_variable_index{};
+  int32_t loop_current{};
+  int32_t loop_target{};
+  int32_t loop_delta{};
+};
+
+/**
+ * The range loop which is active at an instruction
+ */
+struct LoopInfo
+{
+  TypeId   type_id;
+  uint16_t variable_index;
+  uint16_t arity;
+
+  bool operator==(LoopInfo const &other) const
+  {
+    return (type_id == other.type_id) && (variable_index == other.variable_index) &&
+           (arity == other.arity);
+  }
+};
+
+/**
+ * The static state of the VM when an instruction is reached
+ */
+struct State
+{
+  bool                  reached{false};
+  int                   stack_depth{0};
+  std::vector<LoopInfo> loops;
+};
+
+/**
+ * Translates a single function into machine code. Registers are allocated as follows:
+ *
+ *   rdi  the native frame
+ *   rsi  the variables of the frame
+ *   r8   the range loops of the frame
+ *   r9   the charge total
+ *   r10  the charge limit
+ *
+ * with rax, rcx, rdx and r11 as scratch registers. Only caller saved registers are used, so the
+ * code needs no stack frame of its own.
+ */
+class Translator
+{
+public:
+  Translator(Executable const &executable, Executable::Function const &function, Charges charges,
+             Layout const &layout)
+    : executable_{executable}
+    , function_{function}
+    , instructions_{function.instructions}
+    , charges_{std::move(charges)}
+    , layout_{layout}
+  {}
+
+  bool Translate()
+  {
+    if (!IsSupported() || !Analyse())
+    {
+      return false;
+    }
+
+    FindBlocks();
+    Emit();
+
+    return true;
+  }
+
+  std::vector<uint8_t> const &code() const
+  {
+    return code_;
+  }
+
+  NativeFunction::Depths StackDepths() const
+  {
+    NativeFunction::Depths depths(states_.size(), 0);
+    for (std::size_t pc = 0; pc < states_.size(); ++pc)
+    {
+      depths[pc] = static_cast<uint16_t>(states_[pc].stack_depth);
+    }
+
+    return depths;
+  }
+
+  NativeFunction::Depths LoopDepths() const
+  {
+    NativeFunction::Depths depths(states_.size(), 0);
+    for (std::size_t pc = 0; pc < states_.size(); ++pc)
+    {
+      depths[pc] = static_cast<uint16_t>(states_[pc].loops.size());
+    }
+
+    return depths;
+  }
+
+private:
+  using Label  = Assembler::Label;
+  using Labels = std::vector<Label>;
+  using States = std::vector<State>;
+
+  /**
+   * Determine if every instruction of the function can be translated, and if the function contains
+   * a loop, without which it would not run for long enough to benefit from being compiled
+   */
+  bool IsSupported() const
+  {
+    for (auto const &variable : function_.variables)
+    {
+      if (!IsSupportedType(variable.type_id))
+      {
+        return false;
+      }
+    }
+
+    bool has_loop{false};
+    for (std::size_t pc = 0; pc < instructions_.size(); ++pc)
+    {
+      Instruction const &instruction = instructions_[pc];
+
+      if (!IsSupported(instruction))
+      {
+        return false;
+      }
+
+      has_loop |= IsBranch(instruction.opcode) && (instruction.index <= pc);
+    }
+
+    return has_loop;
+  }
+
+  bool IsSupported(Instruction const &instruction) const
+  {
+    switch (instruction.opcode)
+    {
+    case Opcodes::PushFalse:
+    case Opcodes::PushTrue:
+    case Opcodes::PushLocalVariable:
+    case Opcodes::FusedPushLocalVariable:
+    case Opcodes::PopToLocalVariable:
+    case Opcodes::Discard:
+    case Opcodes::Destruct:
+    case Opcodes::Break:
+    case Opcodes::Continue:
+    case Opcodes::Jump:
+    case Opcodes::JumpIfFalse:
+    case Opcodes::JumpIfTrue:
+    case Opcodes::JumpIfFalseOrPop:
+    case Opcodes::JumpIfTrueOrPop:
+    case Opcodes::Return:
+    case Opcodes::ReturnValue:
+    case Opcodes::ForRangeIterate:
+    case Opcodes::ForRangeTerminate:
+    case Opcodes::Not:
+      return true;
+    case Opcodes::LocalVariableDeclare:
+    case Opcodes::LocalVariableDeclareAssign:
+    case Opcodes::PrimitiveEqual:
+    case Opcodes::PrimitiveNotEqual:
+    case Opcodes::PrimitiveLessThan:
+    case Opcodes::PrimitiveLessThanOrEqual:
+    case Opcodes::PrimitiveGreaterThan:
+    case Opcodes::PrimitiveGreaterThanOrEqual:
+      return IsSupportedType(instruction.type_id);
+    case Opcodes::PushConstant:
+    case Opcodes::FusedPushConstant:
+      return (instruction.index < executable_.constants.size()) &&
+             IsSupportedType(executable_.constants[instruction.index].type_id);
+    case Opcodes::ForRangeInit:
+      return IsIntegral(instruction.type_id) &&
+             ((instruction.data == 2) || (instruction.data == 3));
+    case Opcodes::Inc:
+    case Opcodes::Dec:
+    case Opcodes::PrimitiveNegate:
+    case Opcodes::PrimitiveAdd:
+    case Opcodes::PrimitiveSubtract:
+    case Opcodes::PrimitiveMultiply:
+    case Opcodes::PrimitiveDivide:
+    case Opcodes::PrimitiveModulo:
+    case Opcodes::LocalVariablePrimitiveInplaceAdd:
+    case Opcodes::LocalVariablePrimitiveInplaceSubtract:
+    case Opcodes::LocalVariablePrimitiveInplaceMultiply:
+    case Opcodes::LocalVariablePrimitiveInplaceDivide:
+    case Opcodes::LocalVariablePrimitiveInplaceModulo:
+    case Opcodes::LocalVariablePrefixInc:
+    case Opcodes::LocalVariablePrefixDec:
+    case Opcodes::LocalVariablePostfixInc:
+    case Opcodes::LocalVariablePostfixDec:
+      return IsIntegral(instruction.type_id);
+    default:
+      return false;
+    }
+  }
+
+  /**
+   * Determine the depth of the operand stack and the active range loops at every reachable
+   * instruction. These must be the same along every path to an instruction.
+   */
+  bool Analyse()
+  {
+    states_ = States(instructions_.size());
+    states_[0].reached = true;
+
+    std::vector<uint16_t> pending{0};
+    while (!pending.empty())
+    {
+      uint16_t const pc = pending.back();
+      pending.pop_back();
+
+      Instruction const &instruction = instructions_[pc];
+      State              state       = states_[pc];
+      State              branch_state;
+      bool               branches      = false;
+      bool               falls_through = true;
+      int                pops          = 0;
+      int                pushes        = 0;
+
+      switch (instruction.opcode)
+      {
+      case Opcodes::PushFalse:
+      case Opcodes::PushTrue:
+      case Opcodes::PushConstant:
+      case Opcodes::FusedPushConstant:
+      case Opcodes::PushLocalVariable:
+      case Opcodes::FusedPushLocalVariable:
+      case Opcodes::LocalVariablePrefixInc:
+      case Opcodes::LocalVariablePrefixDec:
+      case Opcodes::LocalVariablePostfixInc:
+      case Opcodes::LocalVariablePostfixDec:
+        pushes = 1;
+        break;
+      case Opcodes::LocalVariableDeclareAssign:
+      case Opcodes::PopToLocalVariable:
+      case Opcodes::Discard:
+      case Opcodes::LocalVariablePrimitiveInplaceAdd:
+      case Opcodes::LocalVariablePrimitiveInplaceSubtract:
+      case Opcodes::LocalVariablePrimitiveInplaceMultiply:
+      case Opcodes::LocalVariablePrimitiveInplaceDivide:
+      case Opcodes::LocalVariablePrimitiveInplaceModulo:
+        pops = 1;
+        break;
+      case Opcodes::PrimitiveEqual:
+      case Opcodes::PrimitiveNotEqual:
+      case Opcodes::PrimitiveLessThan:
+      case Opcodes::PrimitiveLessThanOrEqual:
+      case Opcodes::PrimitiveGreaterThan:
+      case Opcodes::PrimitiveGreaterThanOrEqual:
+      case Opcodes::PrimitiveAdd:
+      case Opcodes::PrimitiveSubtract:
+      case Opcodes::PrimitiveMultiply:
+      case Opcodes::PrimitiveDivide:
+      case Opcodes::PrimitiveModulo:
+        pops   = 2;
+        pushes = 1;
+        break;
+      case Opcodes::Inc:
+      case Opcodes::Dec:
+      case Opcodes::Not:
+      case Opcodes::PrimitiveNegate:
+        pops   = 1;
+        pushes = 1;
+        break;
+      case Opcodes::Break:
+      case Opcodes::Continue:
+      case Opcodes::Jump:
+        branches      = true;
+        falls_through = false;
+        break;
+      case Opcodes::JumpIfFalse:
+      case Opcodes::JumpIfTrue:
+        pops     = 1;
+        branches = true;
+        break;
+      case Opcodes::JumpIfFalseOrPop:
+      case Opcodes::JumpIfTrueOrPop:
+        // the condition is only popped when the branch is not taken
+        pops         = 1;
+        branches     = true;
+        branch_state = state;
+        break;
+      case Opcodes::Return:
+      case Opcodes::ReturnValue:
+        falls_through = false;
+        break;
+      case Opcodes::ForRangeInit:
+        pops = instruction.data;
+        state.loops.push_back({instruction.type_id, instruction.index, instruction.data});
+        break;
+      case Opcodes::ForRangeIterate:
+        if (state.loops.empty() || (state.loops.back().arity != instruction.data))
+        {
+          return false;
+        }
+        branches = true;
+        break;
+      case Opcodes::ForRangeTerminate:
+        if (state.loops.empty())
+        {
+          return false;
+        }
+        state.loops.pop_back();
+        break;
+      default:
+        break;
+      }
+
+      if (state.stack_depth < pops)
+      {
+        return false;
+      }
+      state.stack_depth += pushes - pops;
+
+      if (branches)
+      {
+        if (!branch_state.reached)
+        {
+          branch_state = state;
+        }
+        if (!Reach(instruction.index, branch_state, pending))
+        {
+          return false;
+        }
+      }
+
+      if (falls_through && !Reach(static_cast<uint16_t>(pc + 1u), state, pending))
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  bool Reach(uint16_t pc, State const &state, std::vector<uint16_t> &pending)
+  {
+    if (pc >= states_.size())
+    {
+      return false;
+    }
+
+    State &target = states_[pc];
+    if (!target.reached)
+    {
+      target = state;
+      pending.push_back(pc);
+      return true;
+    }
+
+    return (target.stack_depth == state.stack_depth) && (target.loops == state.loops);
+  }
+
+  /**
+   * Split the function into basic blocks, and calculate the charge for each block and the refund
+   * due when it is left early at each of its instructions. Returns are charged by the interpreter.
+   */
+  void FindBlocks()
+  {
+    std::size_t const size = instructions_.size();
+
+    leaders_ = std::vector<bool>(size, false);
+    leaders_[0] = true;
+    for (std::size_t pc = 0; pc < size; ++pc)
+    {
+      Instruction const &instruction = instructions_[pc];
+
+      if (IsBranch(instruction.opcode) && (instruction.index < size))
+      {
+        leaders_[instruction.index] = true;
+      }
+
+      if ((IsBranch(instruction.opcode) || IsReturn(instruction.opcode)) && (pc + 1 < size))
+      {
+        leaders_[pc + 1] = true;
+      }
+    }
+
+    refunds_ = Charges(size, 0);
+    std::size_t end = size;
+    for (std::size_t pc = size; pc-- > 0;)
+    {
+      ChargeAmount const charge = IsReturn(instructions_[pc].opcode) ? 0 : charges_[pc];
+      refunds_[pc] = AddCharge(charge, (pc + 1 < end) ? refunds_[pc + 1] : 0);
+
+      if (leaders_[pc])
+      {
+        end = pc;
+      }
+    }
+  }
+
+  void Emit()
+  {
+    std::size_t const size = instructions_.size();
+
+    labels_      = Labels(size, UNBOUND);
+    exits_       = Labels(size, UNBOUND);
+    early_exits_ = Labels(size, UNBOUND);
+    for (std::size_t pc = 0; pc < size; ++pc)
+    {
+      if (leaders_[pc])
+      {
+        labels_[pc] = assembler_.NewLabel();
+      }
+    }
+
+    assembler_.Load(Width::QWORD, RSI, RDI, offsetof(NativeFrame, variables));
+    assembler_.Load(Width::QWORD, R8, RDI, offsetof(NativeFrame, loops));
+    assembler_.Load(Width::QWORD, R9, RDI, offsetof(NativeFrame, charge_total));
+    assembler_.Load(Width::QWORD, R10, RDI, offsetof(NativeFrame, charge_limit));
+
+    for (std::size_t pc = 0; pc < size; ++pc)
+    {
+      if (!states_[pc].reached)
+      {
+        continue;
+      }
+
+      auto const instruction_pc = static_cast<uint16_t>(pc);
+      if (leaders_[pc])
+      {
+        assembler_.Bind(labels_[pc]);
+        EmitCharge(instruction_pc);
+      }
+
+      EmitInstruction(instruction_pc);
+    }
+
+    for (std::size_t pc = 0; pc < size; ++pc)
+    {
+      auto const instruction_pc = static_cast<uint16_t>(pc);
+      if (exits_[pc] != UNBOUND)
+      {
+        assembler_.Bind(exits_[pc]);
+        EmitExit(instruction_pc);
+      }
+
+      if (early_exits_[pc] != UNBOUND)
+      {
+        assembler_.Bind(early_exits_[pc]);
+        assembler_.LoadImmediate(R11, refunds_[pc]);
+        assembler_.Arithmetic(SUB, Width::QWORD, R9, R11);
+        EmitExit(instruction_pc);
+      }
+    }
+
+    code_ = assembler_.Finish();
+  }
+
+  /**
+   * Charge for a block when it is entered, or leave it to the interpreter when the charge would
+   * reach the limit (or overflow)
+   */
+  void EmitCharge(uint16_t pc)
+  {
+    ChargeAmount const charge = refunds_[pc];
+    if (charge == 0)
+    {
+      return;
+    }
+
+    assembler_.Move(RAX, R9);
+    if (charge <= static_cast<ChargeAmount>(std::numeric_limits<int32_t>::max()))
+    {
+      assembler_.ArithmeticImmediate(ADD, Width::QWORD, RAX, static_cast<int32_t>(charge));
+    }
+    else
+    {
+      assembler_.LoadImmediate(R11, charge);
+      assembler_.Arithmetic(ADD, Width::QWORD, RAX, R11);
+    }
+    assembler_.JumpIf(BELOW, Exit(pc));
+    assembler_.Arithmetic(CMP, Width::QWORD, RAX, R10);
+    assembler_.JumpIf(ABOVE_OR_EQUAL, Exit(pc));
+    assembler_.Move(R9, RAX);
+  }
+
+  void EmitExit(uint16_t pc)
+  {
+    assembler_.Store(Width::QWORD, RDI, offsetof(NativeFrame, charge_total), R9);
+    assembler_.LoadImmediate(RAX, pc);
+    assembler_.Return();
+  }
+
+  Label Exit(uint16_t pc)
+  {
+    if (exits_[pc] == UNBOUND)
+    {
+      exits_[pc] = assembler_.NewLabel();
+    }
+
+    return exits_[pc];
+  }
+
+  Label EarlyExit(uint16_t pc)
+  {
+    if (early_exits_[pc] == UNBOUND)
+    {
+      early_exits_[pc] = assembler_.NewLabel();
+    }
+
+    return early_exits_[pc];
+  }
+
+  void EmitInstruction(uint16_t pc)
+  {
+    Instruction const &instruction = instructions_[pc];
+    int const          depth       = states_[pc].stack_depth;
+
+    switch (instruction.opcode)
+    {
+    case Opcodes::LocalVariableDeclare:
+      assembler_.StoreImmediate(Width::QWORD, RSI, Variable(instruction.index) + layout_.primitive,
+                                0);
+      SetType(Variable(instruction.index), instruction.type_id);
+      break;
+    case Opcodes::LocalVariableDeclareAssign:
+    case Opcodes::PopToLocalVariable:
+      Copy(Operand(depth), Variable(instruction.index));
+      SetType(Operand(depth), TypeIds::Unknown);
+      break;
+    case Opcodes::PushFalse:
+    case Opcodes::PushTrue:
+      assembler_.StoreImmediate(Width::BYTE, RSI, Operand(depth + 1) + layout_.primitive,
+                                (instruction.opcode == Opcodes::PushTrue) ? 1 : 0);
+      SetType(Operand(depth + 1), TypeIds::Bool);
+      break;
+    case Opcodes::PushConstant:
+    case Opcodes::FusedPushConstant:
+    {
+      Variant const &constant = executable_.constants[instruction.index];
+      assembler_.LoadImmediate(RAX, constant.primitive.ui64);
+      assembler_.Store(Width::QWORD, RSI, Operand(depth + 1) + layout_.primitive, RAX);
+      SetType(Operand(depth + 1), constant.type_id);
+      break;
+    }
+    case Opcodes::PushLocalVariable:
+    case Opcodes::FusedPushLocalVariable:
+      Copy(Variable(instruction.index), Operand(depth + 1));
+      break;
+    case Opcodes::Inc:
+    case Opcodes::Dec:
+    {
+      Width const   width = WidthOf(instruction.type_id);
+      int32_t const top   = Operand(depth) + layout_.primitive;
+      assembler_.Load(width, RAX, RSI, top);
+      assembler_.ArithmeticImmediate((instruction.opcode == Opcodes::Inc) ? ADD : SUB, width, RAX,
+                                     1);
+      assembler_.Store(width, RSI, top, RAX);
+      break;
+    }
+    case Opcodes::Discard:
+      SetType(Operand(depth), TypeIds::Unknown);
+      break;
+    case Opcodes::Destruct:
+    case Opcodes::ForRangeTerminate:
+      // primitives need no destruction, and the range loops are tracked statically
+      break;
+    case Opcodes::Break:
+    case Opcodes::Continue:
+    case Opcodes::Jump:
+      assembler_.Jump(labels_[instruction.index]);
+      break;
+    case Opcodes::JumpIfFalse:
+    case Opcodes::JumpIfTrue:
+      assembler_.Load(Width::BYTE, RAX, RSI, Operand(depth) + layout_.primitive);
+      SetType(Operand(depth), TypeIds::Unknown);
+      assembler_.Test(Width::DWORD, RAX, RAX);
+      assembler_.JumpIf((instruction.opcode == Opcodes::JumpIfFalse) ? EQUAL : NOT_EQUAL,
+                        labels_[instruction.index]);
+      break;
+    case Opcodes::JumpIfFalseOrPop:
+    case Opcodes::JumpIfTrueOrPop:
+      assembler_.Load(Width::BYTE, RAX, RSI, Operand(depth) + layout_.primitive);
+      assembler_.Test(Width::DWORD, RAX, RAX);
+      assembler_.JumpIf((instruction.opcode == Opcodes::JumpIfFalseOrPop) ? EQUAL : NOT_EQUAL,
+                        labels_[instruction.index]);
+      SetType(Operand(depth), TypeIds::Unknown);
+      break;
+    case Opcodes::Return:
+    case Opcodes::ReturnValue:
+      EmitExit(pc);
+      break;
+    case Opcodes::ForRangeInit:
+      EmitForRangeInit(pc);
+      break;
+    case Opcodes::ForRangeIterate:
+      EmitForRangeIterate(pc);
+      break;
+    case Opcodes::Not:
+      assembler_.Load(Width::BYTE, RAX, RSI, Operand(depth) + layout_.primitive);
+      assembler_.Test(Width::DWORD, RAX, RAX);
+      assembler_.SetIf(EQUAL, RAX);
+      assembler_.Store(Width::BYTE, RSI, Operand(depth) + layout_.primitive, RAX);
+      break;
+    case Opcodes::PrimitiveEqual:
+    case Opcodes::PrimitiveNotEqual:
+    case Opcodes::PrimitiveLessThan:
+    case Opcodes::PrimitiveLessThanOrEqual:
+    case Opcodes::PrimitiveGreaterThan:
+    case Opcodes::PrimitiveGreaterThanOrEqual:
+      EmitComparison(instruction, Operand(depth - 1), Operand(depth));
+      break;
+    case Opcodes::PrimitiveNegate:
+    {
+      Width const   width = WidthOf(instruction.type_id);
+      int32_t const top   = Operand(depth) + layout_.primitive;
+      assembler_.Load(width, RAX, RSI, top);
+      assembler_.Negate(width, RAX);
+      assembler_.Store(width, RSI, top, RAX);
+      break;
+    }
+    case Opcodes::PrimitiveAdd:
+    case Opcodes::PrimitiveSubtract:
+    case Opcodes::PrimitiveMultiply:
+    case Opcodes::PrimitiveDivide:
+    case Opcodes::PrimitiveModulo:
+      EmitArithmetic(pc, Operand(depth - 1), Operand(depth));
+      break;
+    case Opcodes::LocalVariablePrimitiveInplaceAdd:
+    case Opcodes::LocalVariablePrimitiveInplaceSubtract:
+    case Opcodes::LocalVariablePrimitiveInplaceMultiply:
+    case Opcodes::LocalVariablePrimitiveInplaceDivide:
+    case Opcodes::LocalVariablePrimitiveInplaceModulo:
+      EmitArithmetic(pc, Variable(instruction.index), Operand(depth));
+      break;
+    case Opcodes::LocalVariablePrefixInc:
+    case Opcodes::LocalVariablePrefixDec:
+    case Opcodes::LocalVariablePostfixInc:
+    case Opcodes::LocalVariablePostfixDec:
+      EmitIncrement(instruction, Operand(depth + 1));
+      break;
+    default:
+      assert(false);
+      break;
+    }
+  }
+
+  void EmitForRangeInit(uint16_t pc)
+  {
+    Instruction const &instruction = instructions_[pc];
+    int const          depth       = states_[pc].stack_depth;
+    int32_t const      loop        = Loop(states_[pc].loops.size());
+    int const          first       = depth - instruction.data + 1;
+
+    SetType(Variable(instruction.index), instruction.type_id);
+    assembler_.StoreImmediate(Width::WORD, R8, loop + layout_.loop_variable_index,
+                              instruction.index);
+
+    assembler_.Load(Width::QWORD, RAX, RSI, Operand(first) + layout_.primitive);
+    assembler_.Store(Width::QWORD, R8, loop + layout_.loop_current, RAX);
+    assembler_.Load(Width::QWORD, RAX, RSI, Operand(first + 1) + layout_.primitive);
+    assembler_.Store(Width::QWORD, R8, loop + layout_.loop_target, RAX);
+    if (instruction.data == 3)
+    {
+      assembler_.Load(Width::QWORD, RAX, RSI, Operand(first + 2) + layout_.primitive);
+      assembler_.Store(Width::QWORD, R8, loop + layout_.loop_delta, RAX);
+    }
+    else
+    {
+      assembler_.StoreImmediate(Width::QWORD, R8, loop + layout_.loop_delta, 0);
+    }
+
+    for (int operand = first; operand <= depth; ++operand)
+    {
+      SetType(Operand(operand), TypeIds::Unknown);
+    }
+  }
+
+  void EmitForRangeIterate(uint16_t pc)
+  {
+    Instruction const &instruction = instructions_[pc];
+    LoopInfo const &   info        = states_[pc].loops.back();
+    int32_t const      loop        = Loop(states_[pc].loops.size() - 1);
+    Width const        width       = WidthOf(info.type_id);
+
+    assembler_.Load(width, RAX, R8, loop + layout_.loop_current);
+    assembler_.Store(width, RSI, Variable(info.variable_index) + layout_.primitive, RAX);
+    assembler_.Move(RCX, RAX);
+    if (info.arity == 2)
+    {
+      assembler_.ArithmeticImmediate(ADD, width, RCX, 1);
+    }
+    else
+    {
+      assembler_.Arithmetic(ADD, width, RCX, R8, loop + layout_.loop_delta);
+    }
+    assembler_.Store(width, R8, loop + layout_.loop_current, RCX);
+    assembler_.Arithmetic(CMP, width, RAX, R8, loop + layout_.loop_target);
+    assembler_.JumpIf(IsSigned(info.type_id) ? GREATER_OR_EQUAL : ABOVE_OR_EQUAL,
+                      labels_[instruction.index]);
+  }
+
+  void EmitComparison(Instruction const &instruction, int32_t lhs, int32_t rhs)
+  {
+    Width const width     = WidthOf(instruction.type_id);
+    bool const  is_signed = IsSigned(instruction.type_id);
+
+    if (width == Width::BYTE)
+    {
+      assembler_.Load(Width::BYTE, RAX, RSI, lhs + layout_.primitive);
+      assembler_.Load(Width::BYTE, RCX, RSI, rhs + layout_.primitive);
+      assembler_.Arithmetic(CMP, Width::DWORD, RAX, RCX);
+    }
+    else
+    {
+      assembler_.Load(width, RAX, RSI, lhs + layout_.primitive);
+      assembler_.Arithmetic(CMP, width, RAX, RSI, rhs + layout_.primitive);
+    }
+
+    Condition condition{EQUAL};
+    switch (instruction.opcode)
+    {
+    case Opcodes::PrimitiveNotEqual:
+      condition = NOT_EQUAL;
+      break;
+    case Opcodes::PrimitiveLessThan:
+      condition = is_signed ? LESS : BELOW;
+      break;
+    case Opcodes::PrimitiveLessThanOrEqual:
+      condition = is_signed ? LESS_OR_EQUAL : BELOW_OR_EQUAL;
+      break;
+    case Opcodes::PrimitiveGreaterThan:
+      condition = is_signed ? GREATER : ABOVE;
+      break;
+    case Opcodes::PrimitiveGreaterThanOrEqual:
+      condition = is_signed ? GREATER_OR_EQUAL : ABOVE_OR_EQUAL;
+      break;
+    default:
+      break;
+    }
+
+    assembler_.SetIf(condition, RAX);
+    assembler_.Store(Width::BYTE, RSI, lhs + layout_.primitive, RAX);
+    SetType(lhs, TypeIds::Bool);
+    SetType(rhs, TypeIds::Unknown);
+  }
+
+  void EmitArithmetic(uint16_t pc, int32_t lhs, int32_t rhs)
+  {
+    Instruction const &instruction = instructions_[pc];
+    Width const        width       = WidthOf(instruction.type_id);
+    bool const         is_signed   = IsSigned(instruction.type_id);
+
+    switch (instruction.opcode)
+    {
+    case Opcodes::PrimitiveAdd:
+    case Opcodes::LocalVariablePrimitiveInplaceAdd:
+      assembler_.Load(width, RAX, RSI, lhs + layout_.primitive);
+      assembler_.Arithmetic(ADD, width, RAX, RSI, rhs + layout_.primitive);
+      assembler_.Store(width, RSI, lhs + layout_.primitive, RAX);
+      break;
+    case Opcodes::PrimitiveSubtract:
+    case Opcodes::LocalVariablePrimitiveInplaceSubtract:
+      assembler_.Load(width, RAX, RSI, lhs + layout_.primitive);
+      assembler_.Arithmetic(SUB, width, RAX, RSI, rhs + layout_.primitive);
+      assembler_.Store(width, RSI, lhs + layout_.primitive, RAX);
+      break;
+    case Opcodes::PrimitiveMultiply:
+    case Opcodes::LocalVariablePrimitiveInplaceMultiply:
+      assembler_.Load(width, RAX, RSI, lhs + layout_.primitive);
+      assembler_.Multiply(width, RAX, RSI, rhs + layout_.primitive);
+      assembler_.Store(width, RSI, lhs + layout_.primitive, RAX);
+      break;
+    default:
+    {
+      // Division by zero is left to the interpreter to report, as is the signed division of the
+      // minimum value by -1 which is undefined
+      bool const is_divide = (instruction.opcode == Opcodes::PrimitiveDivide) ||
+                             (instruction.opcode == Opcodes::LocalVariablePrimitiveInplaceDivide);
+
+      assembler_.Load(width, RCX, RSI, rhs + layout_.primitive);
+      assembler_.Test(width, RCX, RCX);
+      assembler_.JumpIf(EQUAL, EarlyExit(pc));
+      assembler_.Load(width, RAX, RSI, lhs + layout_.primitive);
+      if (is_signed)
+      {
+        Label const valid = assembler_.NewLabel();
+        assembler_.ArithmeticImmediate(CMP, width, RCX, -1);
+        assembler_.JumpIf(NOT_EQUAL, valid);
+        assembler_.LoadImmediate(R11, (width == Width::DWORD) ? 0x80000000ull
+                                                                : 0x8000000000000000ull);
+        assembler_.Arithmetic(CMP, width, RAX, R11);
+        assembler_.JumpIf(EQUAL, EarlyExit(pc));
+        assembler_.Bind(valid);
+      }
+      assembler_.Divide(is_signed, width, RCX);
+      assembler_.Store(width, RSI, lhs + layout_.primitive, is_divide ? RAX : RDX);
+      break;
+    }
+    }
+
+    SetType(rhs, TypeIds::Unknown);
+  }
+
+  void EmitIncrement(Instruction const &instruction, int32_t pushed)
+  {
+    Width const     width    = WidthOf(instruction.type_id);
+    int32_t const   variable = Variable(instruction.index) + layout_.primitive;
+    Operation const operation =
+        ((instruction.opcode == Opcodes::LocalVariablePrefixInc) ||
+         (instruction.opcode == Opcodes::LocalVariablePostfixInc))
+            ? ADD
+            : SUB;
+    bool const is_prefix = (instruction.opcode == Opcodes::LocalVariablePrefixInc) ||
+                           (instruction.opcode == Opcodes::LocalVariablePrefixDec);
+
+    assembler_.Load(width, RAX, RSI, variable);
+    if (is_prefix)
+    {
+      assembler_.ArithmeticImmediate(operation, width, RAX, 1);
+      assembler_.Store(width, RSI, variable, RAX);
+      assembler_.Store(width, RSI, pushed + layout_.primitive, RAX);
+    }
+    else
+    {
+      assembler_.Store(width, RSI, pushed + layout_.primitive, RAX);
+      assembler_.ArithmeticImmediate(operation, width, RAX, 1);
+      assembler_.Store(width, RSI, variable, RAX);
+    }
+    SetType(pushed, instruction.type_id);
+  }
+
+  void Copy(int32_t from, int32_t to)
+  {
+    assembler_.Load(Width::QWORD, RAX, RSI, from + layout_.primitive);
+    assembler_.Store(Width::QWORD, RSI, to + layout_.primitive, RAX);
+    assembler_.Load(Width::WORD, RAX, RSI, from + layout_.type_id);
+    assembler_.Store(Width::WORD, RSI, to + layout_.type_id, RAX);
+  }
+
+  void SetType(int32_t variant, TypeId type_id)
+  {
+    assembler_.StoreImmediate(Width::WORD, RSI, variant + layout_.type_id, type_id);
+  }
+
+  int32_t Variable(int index) const
+  {
+    return index * layout_.variant_size;
+  }
+
+  int32_t Operand(int depth) const
+  {
+    return (function_.num_variables - 1 + depth) * layout_.variant_size;
+  }
+
+  int32_t Loop(std::size_t index) const
+  {
+    return static_cast<int32_t>(index) * layout_.loop_size;
+  }
+
+  Executable const &          executable_;
+  Executable::Function const &function_;
+  Executable::InstructionArray const &instructions_;
+  Charges                     charges_;
+  Layout                      layout_;
+  States                      states_;
+  std::vector<bool>           leaders_;
+  Charges                     refunds_;
+  Labels                      labels_;
+  Labels                      exits_;
+  Labels                      early_exits_;
+  Assembler                   assembler_;
+  std::vector<uint8_t>        code_;
+};
+
+}  // namespace
+
+NativeFunction::NativeFunction(std::vector<uint8_t> const &code, Depths stack_depths,
+                               Depths loop_depths)
+  : stack_depths_{std::move(stack_depths)}
+  , loop_depths_{std::move(loop_depths)}
+{
+  if (!stack_depths_.empty())
+  {
+    max_stack_depth_ = *std::max_element(stack_depths_.begin(), stack_depths_.end());
+    max_loop_depth_  = *std::max_element(loop_depths_.begin(), loop_depths_.end());
+  }
+
+#if FETCH_VM_NATIVE_CODE_SUPPORTED
+  // the code is written to writable memory which is then made executable, but never both at once
+  void *memory =
+      mmap(nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (memory == MAP_FAILED)
+  {
+    return;
+  }
+
+  std::memcpy(memory, code.data(), code.size());
+  if (mprotect(memory, code.size(), PROT_READ | PROT_EXEC) != 0)
+  {
+    munmap(memory, code.size());
+    return;
+  }
+
+  code_ = memory;
+  size_ = code.size();
+#else
+  (void)code;
+#endif
+}
+
+NativeFunction::~NativeFunction()
+{
+#if FETCH_VM_NATIVE_CODE_SUPPORTED
+  if (code_ != nullptr)
+  {
+    munmap(code_, size_);
+  }
+#endif
+}
+
+bool NativeFunction::IsValid() const
+{
+  return code_ != nullptr;
+}
+
+/**
+ * Run the function from its first instruction
+ *
+ * @param frame The frame of the function, whose charge total is updated
+ * @return The index of the instruction at which the interpreter should continue
+ */
+uint16_t NativeFunction::Run(NativeFrame &frame) const
+{
+  assert(IsValid());
+
+  auto const entry = reinterpret_cast<Entry>(code_);
+  return static_cast<uint16_t>(entry(&frame));
+}
+
+int NativeFunction::stack_depth(uint16_t pc) const
+{
+  return stack_depths_[pc];
+}
+
+int NativeFunction::loop_depth(uint16_t pc) const
+{
+  return loop_depths_[pc];
+}
+
+int NativeFunction::max_stack_depth() const
+{
+  return max_stack_depth_;
+}
+
+int NativeFunction::max_loop_depth() const
+{
+  return max_loop_depth_;
+}
+
+/**
+ * Compile a function to native code
+ *
+ * @param vm The VM which will execute the function, which determines the charges
+ * @param executable The executable containing the function
+ * @param function The function to compile
+ * @return The compiled function, or nullptr if it is not suitable for compilation
+ */
+NativeFunctionPtr NativeCompiler::Compile(VM const &vm, Executable const &executable,
+                                          Executable::Function const &function)
+{
+#if FETCH_VM_NATIVE_CODE_SUPPORTED
+  if (function.instructions.empty())
+  {
+    return {};
+  }
+
+  Variant const          variant;
+  VM::ForRangeLoop const loop{};
+  auto const             address = [](void const *field) {
+    return reinterpret_cast<uintptr_t>(field);
+  };
+
+  Layout layout;
+  layout.variant_size = static_cast<int32_t>(sizeof(Variant));
+  layout.primitive    = static_cast<int32_t>(address(&variant.primitive) - address(&variant));
+  layout.type_id      = static_cast<int32_t>(address(&variant.type_id) - address(&variant));
+  layout.loop_size    = static_cast<int32_t>(sizeof(VM::ForRangeLoop));
+  layout.loop_variable_index =
+      static_cast<int32_t>(address(&loop.variable_index) - address(&loop));
+  layout.loop_current = static_cast<int32_t>(address(&loop.current) - address(&loop));
+  layout.loop_target  = static_cast<int32_t>(address(&loop.target) - address(&loop));
+  layout.loop_delta   = static_cast<int32_t>(address(&loop.delta) - address(&loop));
+
+  // charge each instruction as the interpreter does
+  Charges charges;
+  charges.reserve(function.instructions.size());
+  for (auto const &instruction : function.instructions)
+  {
+    if (instruction.opcode >= vm.opcode_info_array_.size())
+    {
+      return {};
+    }
+
+    ChargeAmount const charge = vm.opcode_info_array_[instruction.opcode].static_charge;
+    charges.push_back((charge == 0) ? 1u : charge);
+  }
+
+  Translator translator{executable, function, std::move(charges), layout};
+  if (!translator.Translate())
+  {
+    return {};
+  }
+
+  auto native = std::make_unique<NativeFunction>(translator.code(), translator.StackDepths(),
+                                                 translator.LoopDepths());
+  if (!native->IsValid())
+  {
+    return {};
+  }
+
+  return native;
+#else
+  (void)vm;
+  (void)executable;
+  (void)function;
+  return {};
+#endif
+}
+
+}  // namespace vm
+}  // namespace fetch
@@ -0,0 +1,247 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/object_pool.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+namespace fetch {
+namespace vm {
+
+/**
+ * The bookkeeping at the start of each chunk
+ */
+struct alignas(ObjectPool::GRANULARITY) ObjectPool::Chunk
+{
+  ObjectPool *owner;  ///< The owning pool, or null once the chunk has been orphaned
+  std::size_t live;   ///< The number of blocks in the chunk which are in use
+};
+
+/**
+ * The bookkeeping which precedes every allocated block
+ */
+struct alignas(ObjectPool::GRANULARITY) ObjectPool::Header
+{
+  Chunk *     chunk;       ///< The chunk holding the block, or null for heap allocations
+  std::size_t size_class;  ///< The size class of the block
+};
+
+thread_local ObjectPool *ObjectPool::active_{nullptr};
+
+ObjectPool::Scope::Scope(ObjectPool &pool)
+  : previous_{active_}
+{
+  active_ = &pool;
+}
+
+ObjectPool::Scope::~Scope()
+{
+  active_ = previous_;
+}
+
+/**
+ * Release every chunk without live objects, and orphan the rest
+ */
+ObjectPool::~ObjectPool()
+{
+  for (Chunk *chunk : chunks_)
+  {
+    if (chunk->live == 0)
+    {
+      ::operator delete(chunk);
+    }
+    else
+    {
+      chunk->owner = nullptr;
+    }
+  }
+}
+
+/**
+ * Allocate the memory for an object, from the active pool when there is one
+ *
+ * @param size The size of the object in bytes
+ * @return The pointer to the memory
+ */
+void *ObjectPool::Allocate(std::size_t size)
+{
+  ObjectPool *pool = active_;
+
+  if ((pool != nullptr) && (size != 0) && (size <= MAX_POOLED_SIZE))
+  {
+    return pool->AllocateBlock((size - 1) / GRANULARITY);
+  }
+
+  auto *header  = static_cast<Header *>(::operator new(sizeof(Header) + size));
+  header->chunk = nullptr;
+
+  return header + 1;
+}
+
+/**
+ * Release the memory of an object, returning it to the pool from which it was allocated
+ *
+ * @param ptr The pointer returned from Allocate (or null)
+ */
+void ObjectPool::Deallocate(void *ptr) noexcept
+{
+  if (ptr == nullptr)
+  {
+    return;
+  }
+
+  Header *header = static_cast<Header *>(ptr) - 1;
+  Chunk * chunk  = header->chunk;
+
+  if (chunk == nullptr)
+  {
+    ::operator delete(header);
+    return;
+  }
+
+  assert(chunk->live > 0);
+  --chunk->live;
+
+  if (chunk->owner != nullptr)
+  {
+    auto *block = static_cast<FreeBlock *>(ptr);
+
+    block->next                                  = chunk->owner->free_lists_[header->size_class];
+    chunk->owner->free_lists_[header->size_class] = block;
+  }
+  else if (chunk->live == 0)
+  {
+    // the last object of an orphaned chunk
+    ::operator delete(chunk);
+  }
+}
+
+/**
+ * Release every chunk which holds no live objects, apart from the chunk currently being carved,
+ * which is kept so that the next execution does not have to allocate a chunk straight away
+ */
+void ObjectPool::ReleaseFreeChunks()
+{
+  Chunk *const current = chunks_.empty() ? nullptr : chunks_.back();
+
+  auto const is_releasable = [current](Chunk const *chunk) {
+    return (chunk->live == 0) && (chunk != current);
+  };
+
+  // unlink the free blocks of the chunks which are about to be released
+  for (FreeBlock *&free_list : free_lists_)
+  {
+    FreeBlock **link = &free_list;
+
+    while (*link != nullptr)
+    {
+      Header const *header = static_cast<Header *>(static_cast<void *>(*link)) - 1;
+
+      if (is_releasable(header->chunk))
+      {
+        *link = (*link)->next;
+      }
+      else
+      {
+        link = &(*link)->next;
+      }
+    }
+  }
+
+  std::size_t retained{0};
+  for (Chunk *chunk : chunks_)
+  {
+    if (is_releasable(chunk))
+    {
+      ::operator delete(chunk);
+    }
+    else
+    {
+      chunks_[retained++] = chunk;
+    }
+  }
+
+  chunks_.resize(retained);
+}
+
+std::size_t ObjectPool::chunk_count() const
+{
+  return chunks_.size();
+}
+
+void *ObjectPool::AllocateBlock(std::size_t size_class)
+{
+  assert(size_class < NUM_SIZE_CLASSES);
+
+  FreeBlock *&free_list = free_lists_[size_class];
+
+  if (free_list != nullptr)
+  {
+    FreeBlock *block  = free_list;
+    Header *   header = static_cast<Header *>(static_cast<void *>(block)) - 1;
+
+    free_list = block->next;
+    ++header->chunk->live;
+
+    return block;
+  }
+
+  std::size_t const block_size = sizeof(Header) + ((size_class + 1) * GRANULARITY);
+  if (chunk_offset_ + block_size > CHUNK_SIZE)
+  {
+    NewChunk();
+  }
+
+  Chunk *chunk  = chunks_.back();
+  auto * header = reinterpret_cast<Header *>(reinterpret_cast<uint8_t *>(chunk) + chunk_offset_);
+
+  chunk_offset_ += block_size;
+
+  header->chunk      = chunk;
+  header->size_class = size_class;
+  ++chunk->live;
+
+  return header + 1;
+}
+
+void ObjectPool::NewChunk()
+{
+  struct ChunkDeleter
+  {
+    void operator()(Chunk *chunk) const
+    {
+      ::operator delete(chunk);
+    }
+  };
+
+  // the chunk is released again if it cannot be recorded
+  std::unique_ptr<Chunk, ChunkDeleter> chunk{static_cast<Chunk *>(::operator new(CHUNK_SIZE))};
+  chunk->owner = this;
+  chunk->live  = 0;
+
+  chunks_.push_back(chunk.get());
+  chunk.release();
+
+  chunk_offset_ = sizeof(Chunk);
+}
+
+}  // namespace vm
+}  // namespace fetch
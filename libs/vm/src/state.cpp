@@ -24,17 +24,41 @@ namespace vm {
 
 namespace {
 
+using fetch::byte_array::ConstByteArray;
+
+enum class eReadStatus : uint8_t
+{
+  ok,
+  not_found,
+  failed,
+};
+
+eReadStatus ToReadStatus(IoObserverInterface::Status status)
+{
+  switch (status)
+  {
+  case IoObserverInterface::Status::OK:
+    return eReadStatus::ok;
+  case IoObserverInterface::Status::ERROR:
+  case IoObserverInterface::Status::PERMISSION_DENIED:
+    break;
+  case IoObserverInterface::Status::BUFFER_TOO_SMALL:
+    return eReadStatus::failed;
+  }
+
+  return eReadStatus::not_found;
+}
+
 template <typename T, typename = std::enable_if_t<IsPrimitive<T>>>
-bool ReadHelper(TypeId /*type_id*/, std::string const &name, T &val, VM *vm)
+eReadStatus ReadHelper(TypeId /*type_id*/, std::string const &name, T &val, VM *vm)
 {
   if (!vm->HasIoObserver())
   {
-    return true;
+    return eReadStatus::not_found;
   }
 
-  uint64_t   buffer_size = sizeof(T);
-  auto const result      = vm->GetIOObserver().Read(name, &val, buffer_size);
-  return result == IoObserverInterface::Status::OK;
+  uint64_t buffer_size = sizeof(T);
+  return ToReadStatus(vm->GetIOObserver().Read(name, &val, buffer_size));
 }
 
 template <typename T, typename = std::enable_if_t<IsPrimitive<T>>>
@@ -49,13 +73,20 @@ bool WriteHelper(std::string const &name, T const &val, VM *vm)
   return result == IoObserverInterface::Status::OK;
 }
 
-bool ReadHelper(TypeId type_id, std::string const &name, Ptr<Object> &val, VM *vm)
+eReadStatus ReadHelper(TypeId type_id, std::string const &name, Ptr<Object> &val, VM *vm)
 {
-  using fetch::byte_array::ByteArray;
-
   if (!vm->HasIoObserver())
   {
-    return true;
+    return eReadStatus::not_found;
+  }
+
+  // a single call to the observer both checks for the value and retrieves it, without copying it
+  ConstByteArray buffer;
+
+  auto const status = ToReadStatus(vm->GetIOObserver().ReadBuffer(name, buffer));
+  if (eReadStatus::ok != status)
+  {
+    return status;
   }
 
   if (!vm->IsDefaultSerializeConstructable(type_id))
@@ -63,52 +94,25 @@ bool ReadHelper(TypeId type_id, std::string const &name, Ptr<Object> &val, VM *v
     vm->RuntimeError("Cannot deserialise object of type " + vm->GetTypeName(type_id) +
                      " for which no serialisation constructor exists.");
 
-    return false;
+    return eReadStatus::failed;
   }
 
   val = vm->DefaultSerializeConstruct(type_id);
 
-  // create an initial buffer size
-  ByteArray buffer;
-  buffer.Resize(256);
+  // deserialise directly from the shared buffer rather than a copy of it
+  auto byte_buffer = MsgPackSerializer::View(buffer);
 
-  IoObserverInterface &io{vm->GetIOObserver()};
-
-  uint64_t buffer_size = buffer.size();
-  auto     result      = io.Read(name, buffer.pointer(), buffer_size);
-
-  if (IoObserverInterface::Status::OK == result)
-  {
-    // chop down the size of the buffer
-    buffer.Resize(buffer_size);
-  }
-  else if (IoObserverInterface::Status::BUFFER_TOO_SMALL == result)
-  {
-    // increase the buffer size
-    buffer.Resize(buffer_size);
-
-    // make the second call to the io observer
-    result = io.Read(name, buffer.pointer(), buffer_size);
-  }
-
-  bool retval = false;
-
-  // if we successfully extracted the data
-  if (IoObserverInterface::Status::OK == result)
+  if (!val->DeserializeFrom(byte_buffer))
   {
-    MsgPackSerializer byte_buffer{buffer};
-
-    retval = val->DeserializeFrom(byte_buffer);
-    if (!retval)
+    if (!vm->HasError())
     {
-      if (!vm->HasError())
-      {
-        vm->RuntimeError("Object deserialisation failed");
-      }
+      vm->RuntimeError("Object deserialisation failed");
     }
+
+    return eReadStatus::failed;
   }
 
-  return retval;
+  return eReadStatus::ok;
 }
 
 bool WriteHelper(std::string const &name, Ptr<Object> const &val, VM *vm)
@@ -213,17 +217,21 @@ private:
     {
       return {value_, template_param_type_id_};
     }
-    if (Existed())
+
+    // a single read both checks for the existence of the value and retrieves it
+    switch (ReadHelper(template_param_type_id_, name_, value_, vm_))
     {
-      if (ReadHelper(template_param_type_id_, name_, value_, vm_))
+    case eReadStatus::ok:
+      mod_status_ = eModifStatus::deserialised;
+      return {value_, template_param_type_id_};
+    case eReadStatus::not_found:
+      if (default_value != nullptr)
       {
-        mod_status_ = eModifStatus::deserialised;
-        return {value_, template_param_type_id_};
+        return *default_value;
       }
-    }
-    else if (default_value != nullptr)
-    {
-      return *default_value;
+      break;
+    case eReadStatus::failed:
+      break;
     }
 
     vm_->RuntimeError(
@@ -334,6 +334,11 @@ VM::VM(Module *module)
   AddOpcodeInfo(Opcodes::InvokeUserDefinedMemberFunction, "InvokeUserDefinedMemberFunction",
                 [](VM *vm) { vm->Handler__InvokeUserDefinedMemberFunction(); },
                 OpcodeCharges::CHARGE_INVOKE_USER_DEFINED_MEMBER_FUNCTION);
+  AddOpcodeInfo(Opcodes::FusedPushLocalVariable, "FusedPushLocalVariable",
+                [](VM *vm) { vm->Handler__FusedPushLocalVariable(); });
+  AddOpcodeInfo(Opcodes::FusedPushConstant, "FusedPushConstant",
+                [](VM *vm) { vm->Handler__FusedPushConstant(); });
+  SynchroniseFusedCharges();
 
   opcode_map_.clear();
   for (uint16_t i = 0; i < num_functions; ++i)
@@ -355,6 +360,9 @@ bool VM::GenerateExecutable(IR const &ir, std::string const &name, Executable &e
 
 bool VM::Execute(std::string &error, Variant &output)
 {
+  // objects created by the execution are allocated from this VM's pool
+  ObjectPool::Scope const pool_scope{object_pool_};
+
   frame_sp_       = -1;
   bsp_            = 0;
   sp_             = function_->num_variables - 1;
@@ -372,6 +380,8 @@ bool VM::Execute(std::string &error, Variant &output)
   {
     if (sp_ < STACK_SIZE)
     {
+      ExecuteNativeCode();
+
       do
       {
         instruction_pc_ = pc_;
@@ -421,6 +431,8 @@ bool VM::Execute(std::string &error, Variant &output)
       output          = std::move(result);
     }
 
+    object_pool_.ReleaseFreeChunks();
+
     // Success
     return true;
   }
@@ -440,10 +452,202 @@ bool VM::Execute(std::string &error, Variant &output)
 
   self_.Reset();
 
+  object_pool_.ReleaseFreeChunks();
+
   error = error_;
   return false;
 }
 
+/**
+ * Run the current function as native code from its first instruction, if native code is enabled
+ * and the function can be compiled. The interpreter then continues from the instruction at which
+ * the native code stopped, with the stack, range loops and charges exactly as if it had executed
+ * the preceding instructions itself.
+ */
+void VM::ExecuteNativeCode()
+{
+  if (!native_code_enabled_)
+  {
+    return;
+  }
+
+  auto it = native_functions_.find(function_);
+  if (it == native_functions_.end())
+  {
+    it = native_functions_
+             .emplace(function_, NativeCompiler::Compile(*this, *executable_, *function_))
+             .first;
+  }
+
+  NativeFunction const *native = it->second.get();
+  if ((native == nullptr) || (sp_ + native->max_stack_depth() >= STACK_SIZE) ||
+      (range_loop_sp_ + native->max_loop_depth() >= MAX_RANGE_LOOPS))
+  {
+    // overflows are left to the interpreter to report
+    return;
+  }
+
+  NativeFrame frame;
+  frame.variables    = &stack_[bsp_];
+  frame.loops        = &range_loop_stack_[range_loop_sp_ + 1];
+  frame.charge_total = charge_total_;
+  frame.charge_limit = (charge_limit_ == 0u) ? std::numeric_limits<ChargeAmount>::max()
+                                             : charge_limit_;
+
+  pc_           = native->Run(frame);
+  charge_total_ = frame.charge_total;
+
+  sp_            += native->stack_depth(pc_);
+  range_loop_sp_ += native->loop_depth(pc_);
+}
+
+/**
+ * Execute the three instructions which follow the head of a superinstruction: the push of the
+ * second operand, a primitive binary op and the instruction which consumes its result. The operands
+ * are read in place, rather than being pushed onto the stack and popped again.
+ *
+ * Each instruction is charged exactly as it would be by the main loop. If the charge limit could be
+ * reached, or the stack could overflow, part way through the sequence then nothing is executed and
+ * the caller falls back to executing the head as a plain push, leaving the rest of the sequence to
+ * the main loop.
+ *
+ * NOTE: Must be kept in step with the fusable binary ops in the generator
+ *
+ * @param lhs_operand The operand pushed by the head instruction
+ * @return true if the sequence was executed, otherwise false
+ */
+bool VM::ExecuteFusedBinaryOp(Variant const &lhs_operand)
+{
+  Executable::Instruction const *const push     = instruction_ + 1;
+  Executable::Instruction const *const op       = instruction_ + 2;
+  Executable::Instruction const *const consumer = instruction_ + 3;
+
+  ChargeAmount const push_charge     = StaticCharge(push->opcode);
+  ChargeAmount const op_charge       = StaticCharge(op->opcode);
+  ChargeAmount const consumer_charge = StaticCharge(consumer->opcode);
+
+  if (charge_limit_ != 0u)
+  {
+    // the main loop has already checked the charge of the head against the limit
+    ChargeAmount const headroom = charge_limit_ - charge_total_;
+    if ((push_charge >= headroom) || (op_charge >= (headroom - push_charge)) ||
+        (consumer_charge >= (headroom - push_charge - op_charge)))
+    {
+      return false;
+    }
+  }
+
+  if ((sp_ + 2) >= STACK_SIZE)
+  {
+    return false;
+  }
+
+  Variant lhsv{lhs_operand};
+  Variant rhsv{(push->opcode == Opcodes::PushLocalVariable)
+                   ? GetLocalVariable(push->index)
+                   : executable_->constants[push->index]};
+  IncreaseChargeTotal(push_charge);
+  ++pc_;
+
+  instruction_pc_ = pc_++;
+  instruction_    = op;
+  IncreaseChargeTotal(op_charge);
+
+  switch (op->opcode)
+  {
+  case Opcodes::PrimitiveAdd:
+    ExecuteNumericOp<PrimitiveAdd>(op->type_id, lhsv, rhsv);
+    break;
+  case Opcodes::PrimitiveSubtract:
+    ExecuteNumericOp<PrimitiveSubtract>(op->type_id, lhsv, rhsv);
+    break;
+  case Opcodes::PrimitiveMultiply:
+    ExecuteNumericOp<PrimitiveMultiply>(op->type_id, lhsv, rhsv);
+    break;
+  case Opcodes::PrimitiveDivide:
+    ExecuteNumericOp<PrimitiveDivide>(op->type_id, lhsv, rhsv);
+    break;
+  case Opcodes::PrimitiveModulo:
+    ExecuteIntegralOp<PrimitiveModulo>(op->type_id, lhsv, rhsv);
+    break;
+  case Opcodes::PrimitiveEqual:
+    ExecutePrimitiveRelationalOp<PrimitiveEqual>(op->type_id, lhsv, rhsv);
+    break;
+  case Opcodes::PrimitiveNotEqual:
+    ExecutePrimitiveRelationalOp<PrimitiveNotEqual>(op->type_id, lhsv, rhsv);
+    break;
+  case Opcodes::PrimitiveLessThan:
+    ExecutePrimitiveRelationalOp<PrimitiveLessThan>(op->type_id, lhsv, rhsv);
+    break;
+  case Opcodes::PrimitiveLessThanOrEqual:
+    ExecutePrimitiveRelationalOp<PrimitiveLessThanOrEqual>(op->type_id, lhsv, rhsv);
+    break;
+  case Opcodes::PrimitiveGreaterThan:
+    ExecutePrimitiveRelationalOp<PrimitiveGreaterThan>(op->type_id, lhsv, rhsv);
+    break;
+  case Opcodes::PrimitiveGreaterThanOrEqual:
+    ExecutePrimitiveRelationalOp<PrimitiveGreaterThanOrEqual>(op->type_id, lhsv, rhsv);
+    break;
+  default:
+    RuntimeError("invalid fused instruction");
+    break;
+  }
+
+  // a runtime error in the op stops execution before its result is consumed
+  if (stop_)
+  {
+    return true;
+  }
+
+  instruction_pc_ = pc_++;
+  instruction_    = consumer;
+  IncreaseChargeTotal(consumer_charge);
+
+  switch (consumer->opcode)
+  {
+  case Opcodes::PopToLocalVariable:
+    GetLocalVariable(consumer->index) = std::move(lhsv);
+    break;
+  case Opcodes::JumpIfFalse:
+    if (lhsv.primitive.ui8 == 0)
+    {
+      pc_ = consumer->index;
+    }
+    break;
+  case Opcodes::JumpIfTrue:
+    if (lhsv.primitive.ui8 != 0)
+    {
+      pc_ = consumer->index;
+    }
+    break;
+  default:
+    RuntimeError("invalid fused instruction");
+    break;
+  }
+
+  return true;
+}
+
+/**
+ * Get the charge made by the main loop for executing an instruction
+ */
+ChargeAmount VM::StaticCharge(uint16_t opcode) const
+{
+  ChargeAmount const charge = opcode_info_array_[opcode].static_charge;
+  return (charge == 0) ? 1u : charge;
+}
+
+/**
+ * The head of a superinstruction is charged as the push it replaces
+ */
+void VM::SynchroniseFusedCharges()
+{
+  opcode_info_array_[Opcodes::FusedPushLocalVariable].static_charge =
+      opcode_info_array_[Opcodes::PushLocalVariable].static_charge;
+  opcode_info_array_[Opcodes::FusedPushConstant].static_charge =
+      opcode_info_array_[Opcodes::PushConstant].static_charge;
+}
+
 void VM::RuntimeError(std::string const &message)
 {
   uint16_t const    line = function_->FindLineNumber(instruction_pc_);
@@ -531,6 +735,21 @@ void VM::UpdateCharges(std::unordered_map<std::string, ChargeAmount> const &opco
       it->static_charge = entry.second;
     }
   }
+
+  SynchroniseFusedCharges();
+
+  // the charges are compiled into the native code
+  native_functions_.clear();
+}
+
+void VM::SetNativeCodeEnabled(bool enabled)
+{
+  native_code_enabled_ = enabled;
+}
+
+bool VM::IsNativeCodeEnabled() const
+{
+  return native_code_enabled_;
 }
 
 }  // namespace vm
@@ -493,6 +493,7 @@ void VM::Handler__InvokeUserDefinedFreeFunction()
   sp_ += num_locals;
   if (sp_ < STACK_SIZE)
   {
+    ExecuteNativeCode();
     return;
   }
   sp_ -= num_locals;
@@ -1092,5 +1093,21 @@ void VM::Handler__InvokeUserDefinedMemberFunction()
   RuntimeError("null reference");
 }
 
+void VM::Handler__FusedPushLocalVariable()
+{
+  if (!ExecuteFusedBinaryOp(GetLocalVariable(instruction_->index)))
+  {
+    Handler__PushLocalVariable();
+  }
+}
+
+void VM::Handler__FusedPushConstant()
+{
+  if (!ExecuteFusedBinaryOp(executable_->constants[instruction_->index]))
+  {
+    Handler__PushConstant();
+  }
+}
+
 }  // namespace vm
 }  // namespace fetch
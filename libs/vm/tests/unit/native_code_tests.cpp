@@ -0,0 +1,284 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/compiler.hpp"
+#include "vm/generator.hpp"
+#include "vm/ir.hpp"
+#include "vm/module.hpp"
+#include "vm/native_code.hpp"
+#include "vm/vm.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace fetch::vm;
+
+class NativeCodeTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    module_ = std::make_unique<Module>();
+  }
+
+  bool Generate(std::string const &source, Executable &executable)
+  {
+    Compiler                 compiler{module_.get()};
+    IR                       ir;
+    std::vector<std::string> errors;
+
+    if (!compiler.Compile({{"default.etch", source}}, "default_ir", ir, errors))
+    {
+      return false;
+    }
+
+    VM vm{module_.get()};
+    return vm.GenerateExecutable(ir, "default_exe", executable, errors);
+  }
+
+  bool IsCompiled(Executable const &executable, std::string const &name)
+  {
+    VM vm{module_.get()};
+    return static_cast<bool>(
+        NativeCompiler::Compile(vm, executable, *executable.FindFunction(name)));
+  }
+
+  struct Result
+  {
+    bool         success{false};
+    std::string  error;
+    Variant      output;
+    ChargeAmount charge{0};
+  };
+
+  Result Run(Executable const &executable, bool native, ChargeAmount charge_limit = 0)
+  {
+    Result result;
+
+    VM vm{module_.get()};
+    vm.SetNativeCodeEnabled(native);
+    vm.SetChargeLimit(charge_limit);
+    result.success = vm.Execute(executable, "main", result.error, result.output);
+    result.charge  = vm.GetChargeTotal();
+
+    return result;
+  }
+
+  void ExpectSameResult(Executable const &executable, ChargeAmount charge_limit = 0)
+  {
+    auto const native      = Run(executable, true, charge_limit);
+    auto const interpreted = Run(executable, false, charge_limit);
+
+    EXPECT_EQ(native.success, interpreted.success);
+    EXPECT_EQ(native.error, interpreted.error);
+    EXPECT_EQ(native.output.type_id, interpreted.output.type_id);
+    EXPECT_EQ(native.output.primitive.ui64, interpreted.output.primitive.ui64);
+    EXPECT_EQ(native.charge, interpreted.charge);
+  }
+
+  std::unique_ptr<Module> module_;
+};
+
+TEST_F(NativeCodeTests, while_loops_match_the_interpreter)
+{
+  static char const *TEXT = R"(
+    function main() : Int64
+      var total = 0i64;
+      var i = 0i64;
+      while (i < 1000i64)
+        if (i % 3i64 == 0i64 && !(i == 300i64))
+          total = total + i * 2i64;
+        else
+          total -= 1i64;
+        endif
+        i = i + 1i64;
+      endwhile
+      return total;
+    endfunction
+  )";
+
+  Executable executable;
+  ASSERT_TRUE(Generate(TEXT, executable));
+  EXPECT_EQ(IsCompiled(executable, "main"), FETCH_VM_NATIVE_CODE_SUPPORTED == 1);
+
+  auto const native = Run(executable, true);
+  ASSERT_TRUE(native.success);
+  EXPECT_EQ(native.output.primitive.i64, 332399);
+
+  ExpectSameResult(executable);
+}
+
+TEST_F(NativeCodeTests, range_loops_of_each_integral_type_match_the_interpreter)
+{
+  static char const *TEXT = R"(
+    function int32() : Int32
+      var a = 0;
+      for (i in -50:50)
+        a += i * i - 7 / 2;
+      endfor
+      return a;
+    endfunction
+
+    function uint32() : UInt32
+      var b = 0u32;
+      for (i in 0u32:100u32:3u32)
+        b = b + i % 7u32;
+        ++b;
+      endfor
+      return b;
+    endfunction
+
+    function int64() : Int64
+      var c = 1i64;
+      for (i in 1i64:11i64:2i64)
+        c *= -i;
+        c--;
+      endfor
+      return c;
+    endfunction
+
+    function uint64() : UInt64
+      var d = 0u64;
+      for (i in 0u64:64u64)
+        for (j in 0u64:i)
+          if (j >= i / 2u64)
+            break;
+          endif
+          if (j == 3u64)
+            continue;
+          endif
+          d += j;
+        endfor
+      endfor
+      return d;
+    endfunction
+
+    function main() : UInt64
+      return toUInt64(int32()) + toUInt64(uint32()) + toUInt64(int64()) + uint64();
+    endfunction
+  )";
+
+  Executable executable;
+  ASSERT_TRUE(Generate(TEXT, executable));
+  for (auto const &name : {"int32", "uint32", "int64", "uint64"})
+  {
+    EXPECT_EQ(IsCompiled(executable, name), FETCH_VM_NATIVE_CODE_SUPPORTED == 1) << name;
+  }
+
+  ExpectSameResult(executable);
+}
+
+TEST_F(NativeCodeTests, division_by_zero_is_reported_by_the_interpreter)
+{
+  static char const *TEXT = R"(
+    function main() : Int32
+      var total = 0;
+      for (i in 0:10)
+        total += 100 / (5 - i);
+      endfor
+      return total;
+    endfunction
+  )";
+
+  Executable executable;
+  ASSERT_TRUE(Generate(TEXT, executable));
+
+  auto const native = Run(executable, true);
+  EXPECT_FALSE(native.success);
+  EXPECT_NE(native.error.find("division by zero"), std::string::npos);
+
+  ExpectSameResult(executable);
+}
+
+TEST_F(NativeCodeTests, charge_limit_is_reached_at_the_same_instruction)
+{
+  static char const *TEXT = R"(
+    function main() : Int64
+      var total = 0i64;
+      for (i in 0i64:100000i64)
+        total = total + i * 2i64 - 1i64;
+      endfor
+      return total;
+    endfunction
+  )";
+
+  Executable executable;
+  ASSERT_TRUE(Generate(TEXT, executable));
+
+  for (ChargeAmount limit : {1u, 10u, 1000u, 12345u, 54321u, 10000000u})
+  {
+    ExpectSameResult(executable, limit);
+  }
+}
+
+TEST_F(NativeCodeTests, called_functions_are_compiled)
+{
+  static char const *TEXT = R"(
+    function sum(n : Int32) : Int32
+      var total = 0;
+      var i = 0;
+      while (i < n)
+        total += i;
+        i++;
+      endwhile
+      return total;
+    endfunction
+
+    function main() : Int32
+      var total = 0;
+      for (n in 0:20)
+        total += sum(n);
+      endfor
+      return total;
+    endfunction
+  )";
+
+  Executable executable;
+  ASSERT_TRUE(Generate(TEXT, executable));
+  EXPECT_EQ(IsCompiled(executable, "sum"), FETCH_VM_NATIVE_CODE_SUPPORTED == 1);
+  EXPECT_FALSE(IsCompiled(executable, "main"));
+
+  ExpectSameResult(executable);
+}
+
+TEST_F(NativeCodeTests, unsupported_functions_are_interpreted)
+{
+  static char const *TEXT = R"(
+    function main() : Fixed64
+      var total = 0.0fp64;
+      for (i in 0:100)
+        total += 0.5fp64;
+      endfor
+      return total;
+    endfunction
+  )";
+
+  Executable executable;
+  ASSERT_TRUE(Generate(TEXT, executable));
+  EXPECT_FALSE(IsCompiled(executable, "main"));
+
+  ExpectSameResult(executable);
+}
+
+}  // namespace
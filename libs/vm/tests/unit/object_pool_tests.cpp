@@ -0,0 +1,197 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/array.hpp"
+#include "vm/compiler.hpp"
+#include "vm/ir.hpp"
+#include "vm/module.hpp"
+#include "vm/object_pool.hpp"
+#include "vm/vm.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace fetch::vm;
+
+TEST(ObjectPoolTests, released_blocks_are_reused)
+{
+  ObjectPool        pool;
+  ObjectPool::Scope scope{pool};
+
+  void *first = ObjectPool::Allocate(40);
+  void *other = ObjectPool::Allocate(200);
+  ObjectPool::Deallocate(first);
+
+  void *reused = ObjectPool::Allocate(48);
+  void *fresh  = ObjectPool::Allocate(40);
+
+  EXPECT_EQ(reused, first);
+  EXPECT_NE(fresh, first);
+  EXPECT_EQ(pool.chunk_count(), 1);
+
+  ObjectPool::Deallocate(reused);
+  ObjectPool::Deallocate(fresh);
+  ObjectPool::Deallocate(other);
+}
+
+TEST(ObjectPoolTests, allocations_without_an_active_pool_use_the_heap)
+{
+  ObjectPool pool;
+
+  void *block = ObjectPool::Allocate(32);
+  std::memset(block, 0xAB, 32);
+  ObjectPool::Deallocate(block);
+
+  {
+    ObjectPool::Scope scope{pool};
+
+    void *large = ObjectPool::Allocate(ObjectPool::MAX_POOLED_SIZE + 1);
+    std::memset(large, 0xCD, ObjectPool::MAX_POOLED_SIZE + 1);
+    ObjectPool::Deallocate(large);
+  }
+
+  EXPECT_EQ(pool.chunk_count(), 0);
+}
+
+TEST(ObjectPoolTests, scopes_restore_the_previous_pool)
+{
+  ObjectPool outer;
+  ObjectPool inner;
+
+  ObjectPool::Scope outer_scope{outer};
+  {
+    ObjectPool::Scope inner_scope{inner};
+    ObjectPool::Deallocate(ObjectPool::Allocate(16));
+  }
+  ObjectPool::Deallocate(ObjectPool::Allocate(16));
+
+  EXPECT_EQ(outer.chunk_count(), 1);
+  EXPECT_EQ(inner.chunk_count(), 1);
+}
+
+TEST(ObjectPoolTests, blocks_can_outlive_their_pool)
+{
+  std::vector<void *> blocks;
+
+  {
+    ObjectPool        pool;
+    ObjectPool::Scope scope{pool};
+
+    // span several chunks
+    for (std::size_t i = 0; i < 2 * ObjectPool::CHUNK_SIZE / 64; ++i)
+    {
+      blocks.push_back(ObjectPool::Allocate(48));
+      std::memset(blocks.back(), 0xEF, 48);
+    }
+
+    EXPECT_GT(pool.chunk_count(), 1);
+  }
+
+  for (void *block : blocks)
+  {
+    ObjectPool::Deallocate(block);
+  }
+}
+
+TEST(ObjectPoolTests, free_chunks_are_released)
+{
+  ObjectPool        pool;
+  ObjectPool::Scope scope{pool};
+
+  std::vector<void *> blocks;
+  for (std::size_t i = 0; i < 3 * ObjectPool::CHUNK_SIZE / 64; ++i)
+  {
+    blocks.push_back(ObjectPool::Allocate(48));
+  }
+
+  ASSERT_GT(pool.chunk_count(), 2);
+
+  // keep one block of the first chunk alive
+  for (std::size_t i = 1; i < blocks.size(); ++i)
+  {
+    ObjectPool::Deallocate(blocks[i]);
+  }
+
+  pool.ReleaseFreeChunks();
+
+  // the chunk with the live block and the chunk being carved are kept
+  EXPECT_EQ(pool.chunk_count(), 2);
+
+  // the free blocks of the released chunks are no longer handed out, so new chunks are needed
+  for (std::size_t i = 1; i < blocks.size(); ++i)
+  {
+    blocks[i] = ObjectPool::Allocate(48);
+    std::memset(blocks[i], 0xAB, 48);
+  }
+
+  EXPECT_GT(pool.chunk_count(), 2);
+
+  for (void *block : blocks)
+  {
+    ObjectPool::Deallocate(block);
+  }
+}
+
+TEST(ObjectPoolTests, objects_returned_from_an_execution_outlive_the_vm)
+{
+  static char const *TEXT = R"(
+    function main() : Array<String>
+      var strings = Array<String>(0);
+      for (i in 0:5000)
+        var s = "value";
+        if (i % 1000 == 0)
+          strings.append(s + "!");
+        endif
+      endfor
+      return strings;
+    endfunction
+  )";
+
+  Module                   module;
+  Compiler                 compiler{&module};
+  IR                       ir;
+  Executable               executable;
+  std::vector<std::string> errors;
+
+  ASSERT_TRUE(compiler.Compile({{"default.etch", TEXT}}, "default_ir", ir, errors));
+
+  Variant output;
+  {
+    VM vm{&module};
+    ASSERT_TRUE(vm.GenerateExecutable(ir, "default_exe", executable, errors));
+
+    std::string error;
+    ASSERT_TRUE(vm.Execute(executable, "main", error, output));
+  }
+
+  auto strings = output.Get<Ptr<IArray>>();
+  ASSERT_TRUE(static_cast<bool>(strings));
+  EXPECT_EQ(strings->Count(), 5);
+
+  auto const first = strings->PopFrontOne().Get<Ptr<String>>();
+  EXPECT_EQ(first->string(), "value!");
+}
+
+}  // namespace
@@ -0,0 +1,301 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "core/serializers/main_serializer.hpp"
+#include "vm/compiler.hpp"
+#include "vm/ir.hpp"
+#include "vm/map.hpp"
+#include "vm/module.hpp"
+#include "vm/open_hash_map.hpp"
+#include "vm/vm.hpp"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using namespace fetch::vm;
+
+struct IdentityHash
+{
+  std::size_t operator()(uint64_t value) const
+  {
+    return static_cast<std::size_t>(value);
+  }
+};
+
+// Forces every key onto the same probe sequence
+struct ConstantHash
+{
+  std::size_t operator()(uint64_t /*value*/) const
+  {
+    return 42;
+  }
+};
+
+using IntMap          = OpenHashMap<uint64_t, uint64_t, IdentityHash, std::equal_to<uint64_t>>;
+using CollidingIntMap = OpenHashMap<uint64_t, uint64_t, ConstantHash, std::equal_to<uint64_t>>;
+
+template <typename MapType>
+void CheckInsertAndFind(MapType &map, std::size_t count)
+{
+  for (uint64_t i = 0; i < count; ++i)
+  {
+    auto const result = map.insert({i * 1024u, i});
+    ASSERT_TRUE(result.second);
+    ASSERT_EQ(result.first->second, i);
+  }
+
+  ASSERT_EQ(map.size(), count);
+
+  for (uint64_t i = 0; i < count; ++i)
+  {
+    auto it = map.find(i * 1024u);
+    ASSERT_NE(it, map.end());
+    EXPECT_EQ(it->second, i);
+
+    EXPECT_EQ(map.find((i * 1024u) + 1u), map.end());
+  }
+}
+
+TEST(OpenHashMapTests, inserted_entries_are_found)
+{
+  IntMap map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.find(0), map.end());
+
+  CheckInsertAndFind(map, 10000);
+}
+
+TEST(OpenHashMapTests, colliding_entries_are_found)
+{
+  CollidingIntMap map;
+  CheckInsertAndFind(map, 500);
+}
+
+TEST(OpenHashMapTests, keys_differing_in_their_high_bits_do_not_cluster)
+{
+  // std::hash maps integers to themselves, so these keys only differ in their top 16 bits. If they
+  // shared a probe sequence, inserting them would be quadratic in their number.
+  std::size_t const count = 40000;
+
+  auto const time_inserts = [count](unsigned shift) {
+    IntMap map;
+
+    auto const start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < count; ++i)
+    {
+      map.insert({i << shift, i});
+    }
+    auto const elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(map.size(), count);
+    for (uint64_t i = 0; i < count; i += 97)
+    {
+      auto it = map.find(i << shift);
+      EXPECT_NE(it, map.end());
+      EXPECT_EQ(it->second, i);
+    }
+
+    return elapsed;
+  };
+
+  auto const low_bits  = time_inserts(0);
+  auto const high_bits = time_inserts(48);
+
+  EXPECT_LT(high_bits, (low_bits * 20) + std::chrono::milliseconds{100});
+}
+
+TEST(OpenHashMapTests, duplicate_inserts_keep_the_first_value)
+{
+  IntMap map;
+
+  EXPECT_TRUE(map.insert({7, 1}).second);
+  auto const result = map.insert({7, 2});
+
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(result.first->second, 1);
+  EXPECT_EQ(map.size(), 1);
+}
+
+TEST(OpenHashMapTests, index_operator_inserts_default_values)
+{
+  IntMap map;
+
+  EXPECT_EQ(map[5], 0);
+  map[5] = 10;
+  map[6] += 3;
+
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_EQ(map[5], 10);
+  EXPECT_EQ(map[6], 3);
+}
+
+TEST(OpenHashMapTests, iteration_follows_insertion_order)
+{
+  std::vector<uint64_t> const keys{99, 3, 1u << 20u, 42, 0, 7, 1000000007};
+
+  IntMap          map;
+  CollidingIntMap colliding;
+  map.reserve(keys.size());
+
+  for (auto key : keys)
+  {
+    map[key]       = key;
+    colliding[key] = key;
+  }
+
+  std::vector<uint64_t> visited;
+  std::vector<uint64_t> visited_colliding;
+  for (auto const &entry : map)
+  {
+    visited.push_back(entry.first);
+  }
+  for (auto const &entry : colliding)
+  {
+    visited_colliding.push_back(entry.first);
+  }
+
+  EXPECT_EQ(visited, keys);
+  EXPECT_EQ(visited_colliding, keys);
+}
+
+class EtchMapTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    module_ = std::make_unique<Module>();
+  }
+
+  bool Run(std::string const &source, Variant &output)
+  {
+    Compiler                 compiler{module_.get()};
+    IR                       ir;
+    Executable               executable;
+    std::vector<std::string> errors;
+
+    if (!compiler.Compile({{"default.etch", source}}, "default_ir", ir, errors))
+    {
+      return false;
+    }
+
+    vm_ = std::make_unique<VM>(module_.get());
+    if (!vm_->GenerateExecutable(ir, "default_exe", executable, errors))
+    {
+      return false;
+    }
+
+    std::string error;
+    return vm_->Execute(executable, "main", error, output);
+  }
+
+  fetch::serializers::MsgPackSerializer Serialise(std::string const &source)
+  {
+    fetch::serializers::MsgPackSerializer buffer;
+
+    Variant output;
+    EXPECT_TRUE(Run(source, output));
+    EXPECT_TRUE(output.Get<Ptr<IMap>>()->SerializeTo(buffer));
+
+    return buffer;
+  }
+
+  std::unique_ptr<Module> module_;
+  std::unique_ptr<VM>     vm_;
+};
+
+TEST_F(EtchMapTests, lookups_and_stores_with_many_keys)
+{
+  static char const *TEXT = R"(
+    function main() : Int64
+      var map = Map<Int64, Int64>();
+      for (i in 0i64:5000i64)
+        map[i * 4096i64] = i;
+      endfor
+      for (i in 0i64:5000i64)
+        map[i * 4096i64] = map[i * 4096i64] + 1i64;
+      endfor
+      var total = 0i64;
+      for (i in 0i64:5000i64)
+        total += map[i * 4096i64];
+      endfor
+      return total + toInt64(map.count());
+    endfunction
+  )";
+
+  Variant output;
+  ASSERT_TRUE(Run(TEXT, output));
+  EXPECT_EQ(output.primitive.i64, 12502500 + 5000);
+}
+
+TEST_F(EtchMapTests, string_keys_compare_by_value)
+{
+  static char const *TEXT = R"(
+    function main() : Int32
+      var map = Map<String, Int32>();
+      map["alice"] = 1;
+      map["bob"] = 2;
+      map["al" + "ice"] = 3;
+      return map["alice"] * 10 + map.count();
+    endfunction
+  )";
+
+  Variant output;
+  ASSERT_TRUE(Run(TEXT, output));
+  EXPECT_EQ(output.primitive.i32, 32);
+}
+
+TEST_F(EtchMapTests, serialisation_is_independent_of_insertion_order)
+{
+  static char const *FORWARD = R"(
+    function main() : Map<String, Int32>
+      var map = Map<String, Int32>();
+      map["alpha"] = 1;
+      map["bravo"] = 2;
+      map["charlie"] = 3;
+      map["delta"] = 4;
+      return map;
+    endfunction
+  )";
+
+  static char const *REVERSE = R"(
+    function main() : Map<String, Int32>
+      var map = Map<String, Int32>();
+      map["delta"] = 4;
+      map["charlie"] = 3;
+      map["bravo"] = 2;
+      map["alpha"] = 1;
+      return map;
+    endfunction
+  )";
+
+  auto const forward = Serialise(FORWARD);
+  auto const reverse = Serialise(REVERSE);
+
+  EXPECT_EQ(forward.data(), reverse.data());
+}
+
+}  // namespace
@@ -0,0 +1,255 @@
+//------------------------------------------------------------------------------
+//
+//   Copyright 2018-2020 Fetch.AI Limited
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//   Unless required by applicable law or agreed to in writing, software
+//   distributed under the License is distributed on an "AS IS" BASIS,
+//   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//   See the License for the specific language governing permissions and
+//   limitations under the License.
+//
+//------------------------------------------------------------------------------
+
+#include "vm/compiler.hpp"
+#include "vm/generator.hpp"
+#include "vm/ir.hpp"
+#include "vm/module.hpp"
+#include "vm/opcodes.hpp"
+#include "vm/vm.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using namespace fetch::vm;
+
+using Charges = std::unordered_map<std::string, ChargeAmount>;
+
+class SuperinstructionTests : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    module_ = std::make_unique<Module>();
+  }
+
+  bool Generate(std::string const &source, Executable &executable)
+  {
+    Compiler                 compiler{module_.get()};
+    IR                       ir;
+    std::vector<std::string> errors;
+
+    if (!compiler.Compile({{"default.etch", source}}, "default_ir", ir, errors))
+    {
+      return false;
+    }
+
+    VM vm{module_.get()};
+    return vm.GenerateExecutable(ir, "default_exe", executable, errors);
+  }
+
+  // Restore the original instructions of any superinstructions
+  static Executable Unfuse(Executable executable)
+  {
+    for (auto &function : executable.functions)
+    {
+      for (auto &instruction : function.instructions)
+      {
+        if (instruction.opcode == Opcodes::FusedPushLocalVariable)
+        {
+          instruction.opcode = Opcodes::PushLocalVariable;
+        }
+        else if (instruction.opcode == Opcodes::FusedPushConstant)
+        {
+          instruction.opcode = Opcodes::PushConstant;
+        }
+      }
+    }
+
+    return executable;
+  }
+
+  struct Result
+  {
+    bool         success{false};
+    std::string  error;
+    Variant      output;
+    ChargeAmount charge{0};
+  };
+
+  Result Run(Executable const &executable, ChargeAmount charge_limit = 0,
+             Charges const &charges = {})
+  {
+    Result result;
+
+    VM vm{module_.get()};
+    vm.UpdateCharges(charges);
+    vm.SetChargeLimit(charge_limit);
+    result.success = vm.Execute(executable, "main", result.error, result.output);
+    result.charge  = vm.GetChargeTotal();
+
+    return result;
+  }
+
+  void ExpectSameResult(Executable const &executable, ChargeAmount charge_limit = 0,
+                        Charges const &charges = {})
+  {
+    auto const fused   = Run(executable, charge_limit, charges);
+    auto const unfused = Run(Unfuse(executable), charge_limit, charges);
+
+    EXPECT_EQ(fused.success, unfused.success) << "limit " << charge_limit;
+    EXPECT_EQ(fused.error, unfused.error) << "limit " << charge_limit;
+    EXPECT_EQ(fused.output.type_id, unfused.output.type_id) << "limit " << charge_limit;
+    EXPECT_EQ(fused.output.primitive.ui64, unfused.output.primitive.ui64)
+        << "limit " << charge_limit;
+    EXPECT_EQ(fused.charge, unfused.charge) << "limit " << charge_limit;
+  }
+
+  static std::size_t CountFused(Executable const &executable)
+  {
+    std::size_t count{0};
+    for (auto const &instruction : executable.FindFunction("main")->instructions)
+    {
+      if ((instruction.opcode == Opcodes::FusedPushLocalVariable) ||
+          (instruction.opcode == Opcodes::FusedPushConstant))
+      {
+        ++count;
+      }
+    }
+
+    return count;
+  }
+
+  std::unique_ptr<Module> module_;
+};
+
+TEST_F(SuperinstructionTests, loops_are_fused_with_identical_results_and_charges)
+{
+  static char const *TEXT = R"(
+    function main() : Int64
+      var total = 0i64;
+      var i = 0i64;
+      var j = 0i64;
+      while (i < 1000i64)
+        if (i % 3i64 == 0i64)
+          j = i * 2i64;
+          total = total + j;
+        else
+          total = total - 1i64;
+        endif
+        if (500i64 <= i)
+          total = 7i64 - total;
+        endif
+        i = i + 1i64;
+      endwhile
+      return total;
+    endfunction
+  )";
+
+  Executable executable;
+  ASSERT_TRUE(Generate(TEXT, executable));
+  EXPECT_EQ(CountFused(executable), 7);
+
+  auto const fused = Run(executable);
+  ASSERT_TRUE(fused.success);
+  EXPECT_EQ(fused.output.primitive.i64, 81332);
+
+  ExpectSameResult(executable);
+}
+
+TEST_F(SuperinstructionTests, updated_charges_are_applied_to_superinstructions)
+{
+  static char const *TEXT = R"(
+    function main() : Int32
+      var total = 0;
+      var i = 0;
+      while (i < 100)
+        total = total + i;
+        i = i + 1;
+      endwhile
+      return total;
+    endfunction
+  )";
+
+  Executable executable;
+  ASSERT_TRUE(Generate(TEXT, executable));
+  EXPECT_EQ(CountFused(executable), 3);
+
+  Charges const charges{{"PushLocalVariable", 20},
+                        {"PushConstant", 0},
+                        {"PrimitiveAdd", 1000},
+                        {"PrimitiveLessThan", 3},
+                        {"PopToLocalVariable", 0}};
+
+  auto const fused = Run(executable, 0, charges);
+  ASSERT_TRUE(fused.success);
+  EXPECT_EQ(fused.output.primitive.i32, 4950);
+  EXPECT_GT(fused.charge, Run(executable).charge);
+
+  ExpectSameResult(executable, 0, charges);
+}
+
+TEST_F(SuperinstructionTests, charge_limit_is_reached_at_the_same_instruction)
+{
+  static char const *TEXT = R"(
+    function main() : Int64
+      var total = 0i64;
+      var i = 0i64;
+      while (i < 100i64)
+        total = total + i;
+        i = i + 1i64;
+      endwhile
+      return total;
+    endfunction
+  )";
+
+  Executable executable;
+  ASSERT_TRUE(Generate(TEXT, executable));
+  EXPECT_EQ(CountFused(executable), 3);
+
+  // every limit up to a few iterations of the loop, so that each instruction of each
+  // superinstruction reaches it
+  for (ChargeAmount limit = 1; limit < 500; ++limit)
+  {
+    ExpectSameResult(executable, limit);
+  }
+}
+
+TEST_F(SuperinstructionTests, runtime_errors_report_the_original_line)
+{
+  static char const *TEXT = R"(
+    function main() : Int32
+      var a = 7;
+      var b = 0;
+      var c = 0;
+      c = a + 1;
+      c = c / b;
+      return c;
+    endfunction
+  )";
+
+  Executable executable;
+  ASSERT_TRUE(Generate(TEXT, executable));
+  EXPECT_EQ(CountFused(executable), 2);
+
+  auto const fused = Run(executable);
+  EXPECT_FALSE(fused.success);
+  EXPECT_NE(fused.error.find("line 7"), std::string::npos);
+
+  ExpectSameResult(executable);
+}
+
+}  // namespace
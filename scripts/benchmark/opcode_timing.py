@@ -23,7 +23,7 @@ output_path = 'results/' + date.today().strftime("%Y-%m-%d") + '/'
 n_reps = 100
 
 # Benchmark categories to run
-bm_filter = 'Basic|Prim|Math|Object|Array|Tensor|Crypto'
+bm_filter = 'Basic|Prim|Math|Object|Array|Tensor|Crypto|Map'
 
 run_benchmarks = True
 make_plots = True
@@ -109,9 +109,9 @@ means = {index(row): float(row[3]) for row in bm_rows if 'mean' in row[0]}
 medians = {index(row): float(row[3]) for row in bm_rows if 'median' in row[0]}
 stddevs = {index(row): float(row[3]) for row in bm_rows if 'stddev' in row[0]}
 
-bm_classes = ['Basic', 'String', 'Prim', 'Math', 'Array', 'Tensor', 'Sha256']
+bm_classes = ['Basic', 'String', 'Prim', 'Math', 'Array', 'Tensor', 'Sha256', 'Map']
 prim_bm_classes = ['Prim', 'Math']
-param_bm_classes = ['String', 'Array', 'Sha256', 'Tensor']
+param_bm_classes = ['String', 'Array', 'Sha256', 'Tensor', 'Map']
 
 # Primitives used in primitive operation benchmarks
 op_prims = {'Int8', 'Int16', 'Int32', 'Int64', 'UInt8', 'UInt16', 'UInt32', 'UInt64',